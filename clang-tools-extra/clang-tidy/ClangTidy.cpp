@@ -15,6 +15,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "ClangTidy.h"
+#include "ClangTidyCache.h"
 #include "ClangTidyCheck.h"
 #include "ClangTidyDiagnosticConsumer.h"
 #include "ClangTidyModuleRegistry.h"
@@ -534,10 +535,7 @@ runClangTidy(clang::tidy::ClangTidyContext &Context,
              ArrayRef<std::string> InputFiles,
              llvm::IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> BaseFS,
              bool ApplyAnyFix, bool EnableCheckProfile,
-             llvm::StringRef StoreCheckProfile) {
-  ClangTool Tool(Compilations, InputFiles,
-                 std::make_shared<PCHContainerOperations>(), BaseFS);
-
+             llvm::StringRef StoreCheckProfile, llvm::StringRef CacheDirectory) {
   // Add extra arguments passed by the clang-tidy command-line.
   ArgumentsAdjuster PerFileExtraArgumentsInserter =
       [&Context](const CommandLineArguments &Args, StringRef Filename) {
@@ -556,26 +554,23 @@ runClangTidy(clang::tidy::ClangTidyContext &Context,
         return AdjustedArgs;
       };
 
-  Tool.appendArgumentsAdjuster(PerFileExtraArgumentsInserter);
-  Tool.appendArgumentsAdjuster(getStripPluginsAdjuster());
   Context.setEnableProfiling(EnableCheckProfile);
   Context.setProfileStoragePrefix(StoreCheckProfile);
 
-  ClangTidyDiagnosticConsumer DiagConsumer(Context, nullptr, true, ApplyAnyFix);
-  DiagnosticsEngine DE(new DiagnosticIDs(), new DiagnosticOptions(),
-                       &DiagConsumer, /*ShouldOwnClient=*/false);
-  Context.setDiagnosticsEngine(&DE);
-  Tool.setDiagnosticConsumer(&DiagConsumer);
-
+  using Dependencies = std::optional<std::vector<ClangTidyCache::Dependency>>;
   class ActionFactory : public FrontendActionFactory {
   public:
     ActionFactory(ClangTidyContext &Context,
                   IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> BaseFS)
         : ConsumerFactory(Context, std::move(BaseFS)) {}
     std::unique_ptr<FrontendAction> create() override {
-      return std::make_unique<Action>(&ConsumerFactory);
+      return std::make_unique<Action>(&ConsumerFactory, Deps);
     }
 
+    /// If set, the files read by each action are appended to *Deps. It is
+    /// reset if they can't be tracked.
+    Dependencies *Deps = nullptr;
+
     bool runInvocation(std::shared_ptr<CompilerInvocation> Invocation,
                        FileManager *Files,
                        std::shared_ptr<PCHContainerOperations> PCHContainerOps,
@@ -589,22 +584,72 @@ runClangTidy(clang::tidy::ClangTidyContext &Context,
   private:
     class Action : public ASTFrontendAction {
     public:
-      Action(ClangTidyASTConsumerFactory *Factory) : Factory(Factory) {}
+      Action(ClangTidyASTConsumerFactory *Factory, Dependencies *Deps)
+          : Factory(Factory), Deps(Deps) {}
       std::unique_ptr<ASTConsumer> CreateASTConsumer(CompilerInstance &Compiler,
                                                      StringRef File) override {
         return Factory->createASTConsumer(Compiler, File);
       }
 
+      void EndSourceFileAction() override {
+        if (Deps && *Deps &&
+            !ClangTidyCache::collectDependencies(getCompilerInstance(), **Deps))
+          Deps->reset();
+      }
+
     private:
       ClangTidyASTConsumerFactory *Factory;
+      Dependencies *Deps;
     };
 
     ClangTidyASTConsumerFactory ConsumerFactory;
   };
 
-  ActionFactory Factory(Context, std::move(BaseFS));
-  Tool.run(&Factory);
-  return DiagConsumer.take();
+  ActionFactory Factory(Context, BaseFS);
+  auto Run = [&](ArrayRef<std::string> Files) {
+    ClangTool Tool(Compilations, Files,
+                   std::make_shared<PCHContainerOperations>(), BaseFS);
+    Tool.appendArgumentsAdjuster(PerFileExtraArgumentsInserter);
+    Tool.appendArgumentsAdjuster(getStripPluginsAdjuster());
+
+    ClangTidyDiagnosticConsumer DiagConsumer(Context, nullptr, true,
+                                             ApplyAnyFix);
+    DiagnosticsEngine DE(new DiagnosticIDs(), new DiagnosticOptions(),
+                         &DiagConsumer, /*ShouldOwnClient=*/false);
+    Context.setDiagnosticsEngine(&DE);
+    Tool.setDiagnosticConsumer(&DiagConsumer);
+    Tool.run(&Factory);
+    return DiagConsumer.take();
+  };
+
+  // Check profiles are only produced by actually running the checks.
+  if (CacheDirectory.empty() || EnableCheckProfile)
+    return Run(InputFiles);
+
+  // With a cache, run each file on its own so that its diagnostics can be
+  // stored separately.
+  ClangTidyCache Cache(CacheDirectory, BaseFS);
+  std::vector<ClangTidyError> Errors;
+  for (const std::string &File : InputFiles) {
+    std::string Key = ClangTidyCache::getKey(
+        Compilations.getCompileCommands(File), Context, File, ApplyAnyFix);
+    if (std::optional<std::vector<ClangTidyError>> Cached = Cache.lookup(Key)) {
+      Errors.insert(Errors.end(), std::make_move_iterator(Cached->begin()),
+                    std::make_move_iterator(Cached->end()));
+      continue;
+    }
+    Dependencies Deps(std::in_place);
+    Factory.Deps = &Deps;
+    std::vector<ClangTidyError> FileErrors = Run(File);
+    Factory.Deps = nullptr;
+    // Nothing was read if the file could not be compiled at all, e.g. for a
+    // lack of compile commands. Don't cache that.
+    if (Deps && !Deps->empty())
+      Cache.store(Key, *Deps, FileErrors);
+    Errors.insert(Errors.end(), std::make_move_iterator(FileErrors.begin()),
+                  std::make_move_iterator(FileErrors.end()));
+  }
+  return Errors;
 }
 
 void handleErrors(llvm::ArrayRef<ClangTidyError> Errors,
@@ -0,0 +1,200 @@
+//===--- ClangTidyCache.cpp - clang-tidy ----------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "ClangTidyCache.h"
+#include "ClangTidyOptions.h"
+#include "clang/Basic/SourceManager.h"
+#include "clang/Basic/Version.h"
+#include "clang/Frontend/CompilerInstance.h"
+#include "clang/Tooling/CompilationDatabase.h"
+#include "clang/Tooling/DiagnosticsYaml.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/YAMLTraits.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+namespace clang::tidy {
+namespace {
+
+// Bump when the format of the entries or the meaning of the key changes.
+constexpr unsigned CacheVersion = 1;
+
+// A ClangTidyError that can be default-constructed by the YAML reader.
+struct CachedError : tooling::Diagnostic {
+  bool IsWarningAsError = false;
+  std::vector<std::string> EnabledDiagnosticAliases;
+};
+
+struct CacheEntry {
+  unsigned Version = 0;
+  std::vector<ClangTidyCache::Dependency> Files;
+  std::vector<CachedError> Diagnostics;
+};
+
+} // namespace
+} // namespace clang::tidy
+
+LLVM_YAML_IS_SEQUENCE_VECTOR(clang::tidy::ClangTidyCache::Dependency)
+LLVM_YAML_IS_SEQUENCE_VECTOR(clang::tidy::CachedError)
+
+namespace llvm::yaml {
+
+template <> struct MappingTraits<clang::tidy::ClangTidyCache::Dependency> {
+  static void mapping(IO &IO, clang::tidy::ClangTidyCache::Dependency &D) {
+    IO.mapRequired("Path", D.Path);
+    IO.mapRequired("Size", D.Size);
+    IO.mapRequired("Hash", D.Hash);
+  }
+};
+
+template <> struct MappingTraits<clang::tidy::CachedError> {
+  static void mapping(IO &IO, clang::tidy::CachedError &E) {
+    MappingTraits<clang::tooling::Diagnostic>::mapping(IO, E);
+    IO.mapOptional("IsWarningAsError", E.IsWarningAsError, false);
+    IO.mapOptional("EnabledDiagnosticAliases", E.EnabledDiagnosticAliases);
+  }
+};
+
+template <> struct MappingTraits<clang::tidy::CacheEntry> {
+  static void mapping(IO &IO, clang::tidy::CacheEntry &E) {
+    IO.mapRequired("Version", E.Version);
+    IO.mapRequired("Files", E.Files);
+    IO.mapRequired("Diagnostics", E.Diagnostics);
+  }
+};
+
+} // namespace llvm::yaml
+
+namespace clang::tidy {
+
+std::string
+ClangTidyCache::getKey(llvm::ArrayRef<tooling::CompileCommand> Commands,
+                       const ClangTidyContext &Context, llvm::StringRef File,
+                       bool ApplyAnyFix) {
+  std::string S = getClangFullVersion();
+  auto Add = [&](const llvm::Twine &Part) {
+    S += '\0';
+    S += Part.str();
+  };
+  Add(File);
+  for (const tooling::CompileCommand &Command : Commands) {
+    Add(Command.Directory);
+    for (const std::string &Arg : Command.CommandLine)
+      Add(Arg);
+  }
+  // The effective options include the checks, their options, the header
+  // filter and the extra arguments, wherever they were configured.
+  Add(configurationAsText(Context.getOptionsForFile(File)));
+  for (const FileFilter &Filter : Context.getGlobalOptions().LineFilter) {
+    Add(Filter.Name);
+    for (const FileFilter::LineRange &Range : Filter.LineRanges)
+      Add(llvm::Twine(Range.first) + "-" + llvm::Twine(Range.second));
+  }
+  Add(ApplyAnyFix ? "fix-notes" : "");
+  Add(Context.canEnableAnalyzerAlphaCheckers() ? "alpha" : "");
+  Add(Context.canEnableModuleHeadersParsing() ? "module-headers" : "");
+  llvm::XXH128_hash_t Hash = llvm::xxh3_128bits(llvm::arrayRefFromStringRef(S));
+  return llvm::utohexstr(Hash.high64, /*LowerCase=*/true, /*Width=*/16) +
+         llvm::utohexstr(Hash.low64, /*LowerCase=*/true, /*Width=*/16);
+}
+
+bool ClangTidyCache::collectDependencies(const CompilerInstance &CI,
+                                         std::vector<Dependency> &Deps) {
+  // Declarations from a PCH or a module are read from its AST file, which is
+  // not tracked by the source manager.
+  if (CI.getASTReader())
+    return false;
+  const SourceManager &SM = CI.getSourceManager();
+  FileManager &FM = CI.getFileManager();
+  for (auto It = SM.fileinfo_begin(), E = SM.fileinfo_end(); It != E; ++It) {
+    std::optional<llvm::MemoryBufferRef> Buffer =
+        It->second->getBufferIfLoaded();
+    std::unique_ptr<llvm::MemoryBuffer> Owned;
+    if (!Buffer) {
+      auto BufferOrErr = FM.getBufferForFile(It->first);
+      if (!BufferOrErr)
+        return false;
+      Owned = std::move(*BufferOrErr);
+      Buffer = Owned->getMemBufferRef();
+    }
+    llvm::SmallString<256> Path(It->first.getName());
+    FM.makeAbsolutePath(Path);
+    Deps.push_back({std::string(Path), Buffer->getBufferSize(),
+                    llvm::xxh3_64bits(Buffer->getBuffer())});
+  }
+  return true;
+}
+
+std::string ClangTidyCache::getEntryPath(llvm::StringRef Key) const {
+  llvm::SmallString<256> Path(Directory);
+  llvm::sys::path::append(Path, Key + ".yaml");
+  return std::string(Path);
+}
+
+std::optional<std::vector<ClangTidyError>>
+ClangTidyCache::lookup(llvm::StringRef Key) const {
+  auto Buffer = llvm::MemoryBuffer::getFile(getEntryPath(Key), /*IsText=*/true);
+  if (!Buffer)
+    return std::nullopt;
+  CacheEntry Entry;
+  llvm::yaml::Input YIn((*Buffer)->getBuffer());
+  YIn >> Entry;
+  if (YIn.error() || Entry.Version != CacheVersion)
+    return std::nullopt;
+
+  for (const Dependency &D : Entry.Files) {
+    llvm::ErrorOr<llvm::vfs::Status> Status = FS->status(D.Path);
+    if (!Status || Status->getSize() != D.Size)
+      return std::nullopt;
+    auto Contents = FS->getBufferForFile(D.Path, /*FileSize=*/-1,
+                                         /*RequiresNullTerminator=*/false);
+    if (!Contents || llvm::xxh3_64bits((*Contents)->getBuffer()) != D.Hash)
+      return std::nullopt;
+  }
+
+  std::vector<ClangTidyError> Errors;
+  Errors.reserve(Entry.Diagnostics.size());
+  for (CachedError &E : Entry.Diagnostics) {
+    ClangTidyError &Error = Errors.emplace_back(
+        E.DiagnosticName, E.DiagLevel, E.BuildDirectory, E.IsWarningAsError);
+    static_cast<tooling::Diagnostic &>(Error) =
+        std::move(static_cast<tooling::Diagnostic &>(E));
+    Error.EnabledDiagnosticAliases = std::move(E.EnabledDiagnosticAliases);
+  }
+  return Errors;
+}
+
+void ClangTidyCache::store(llvm::StringRef Key, llvm::ArrayRef<Dependency> Deps,
+                           llvm::ArrayRef<ClangTidyError> Errors) const {
+  CacheEntry Entry;
+  Entry.Version = CacheVersion;
+  Entry.Files = Deps.vec();
+  for (const ClangTidyError &Error : Errors) {
+    CachedError &E = Entry.Diagnostics.emplace_back();
+    static_cast<tooling::Diagnostic &>(E) = Error;
+    E.IsWarningAsError = Error.IsWarningAsError;
+    E.EnabledDiagnosticAliases = Error.EnabledDiagnosticAliases;
+  }
+
+  if (llvm::sys::fs::create_directories(Directory))
+    return;
+  // writeToOutput renames a temporary file into place, so concurrent runs
+  // never see a partially written entry.
+  llvm::consumeError(llvm::writeToOutput(
+      getEntryPath(Key), [&](llvm::raw_ostream &OS) -> llvm::Error {
+        llvm::yaml::Output YOut(OS);
+        YOut << Entry;
+        return llvm::Error::success();
+      }));
+}
+
+} // namespace clang::tidy
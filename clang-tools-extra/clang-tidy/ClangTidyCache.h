@@ -0,0 +1,76 @@
+//===--- ClangTidyCache.h - clang-tidy --------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_TOOLS_EXTRA_CLANG_TIDY_CLANGTIDYCACHE_H
+#define LLVM_CLANG_TOOLS_EXTRA_CLANG_TIDY_CLANGTIDYCACHE_H
+
+#include "ClangTidyDiagnosticConsumer.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/VirtualFileSystem.h"
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace clang {
+class CompilerInstance;
+namespace tooling {
+struct CompileCommand;
+} // namespace tooling
+
+namespace tidy {
+
+/// An on-disk cache of the diagnostics clang-tidy produced for a file.
+///
+/// An entry is keyed by everything other than file contents that affects the
+/// result: the clang-tidy version, the compile commands and the options in
+/// effect for the file. It records the size and hash of every file read while
+/// analyzing the file, and is only used if none of them changed.
+class ClangTidyCache {
+public:
+  struct Dependency {
+    std::string Path;
+    uint64_t Size = 0;
+    uint64_t Hash = 0;
+  };
+
+  ClangTidyCache(llvm::StringRef Directory,
+                 llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS)
+      : Directory(Directory), FS(std::move(FS)) {}
+
+  /// Returns the key of the results of running on \p Commands.
+  static std::string getKey(llvm::ArrayRef<tooling::CompileCommand> Commands,
+                            const ClangTidyContext &Context,
+                            llvm::StringRef File, bool ApplyAnyFix);
+
+  /// Appends the files in \p CI's source manager to \p Deps. Returns false if
+  /// the inputs can't be tracked, e.g. because a PCH or module was loaded.
+  static bool collectDependencies(const CompilerInstance &CI,
+                                  std::vector<Dependency> &Deps);
+
+  /// Returns the stored diagnostics for \p Key, unless there are none or any
+  /// dependency changed.
+  std::optional<std::vector<ClangTidyError>> lookup(llvm::StringRef Key) const;
+
+  /// Stores \p Errors for \p Key. Failures are ignored, as the cache is only
+  /// an optimization.
+  void store(llvm::StringRef Key, llvm::ArrayRef<Dependency> Deps,
+             llvm::ArrayRef<ClangTidyError> Errors) const;
+
+private:
+  std::string getEntryPath(llvm::StringRef Key) const;
+
+  std::string Directory;
+  llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS;
+};
+
+} // namespace tidy
+} // namespace clang
+
+#endif // LLVM_CLANG_TOOLS_EXTRA_CLANG_TIDY_CLANGTIDYCACHE_H
@@ -188,12 +188,13 @@ bool FuzzyMatcher::init(llvm::StringRef NewWord) {
   for (int I = 0; I < WordN; ++I)
     LowWord[I] = lower(Word[I]);
 
-  // Cheap subsequence check.
+  // Cheap subsequence check. Matching greedily also finds where the match of
+  // each pattern character can start.
   for (int W = 0, P = 0; P != PatN; ++W) {
     if (W == WordN)
       return false;
     if (LowWord[W] == LowPat[P])
-      ++P;
+      FirstMatch[P++] = W;
   }
 
   // FIXME: some words are hard to tokenize algorithmically.
@@ -220,7 +221,11 @@ void FuzzyMatcher::buildGraph() {
     Scores[0][W + 1][Match] = {AwfulScore, Miss};
   }
   for (int P = 0; P < PatN; ++P) {
-    for (int W = P; W < WordN; ++W) {
+    // Pat[..P] can't all be matched before Word[FirstMatch[P]], so neither
+    // Action is possible there.
+    for (int W = P + 1; W <= FirstMatch[P]; ++W)
+      Scores[P + 1][W][Miss] = Scores[P + 1][W][Match] = {AwfulScore, Miss};
+    for (int W = FirstMatch[P]; W < WordN; ++W) {
       auto &Score = Scores[P + 1][W + 1], &PreMiss = Scores[P + 1][W];
 
       auto MatchMissScore = PreMiss[Match].Score;
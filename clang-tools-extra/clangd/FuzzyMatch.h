@@ -118,6 +118,7 @@ private:
   char LowWord[MaxWord];      // Word in lowercase
   CharRole WordRole[MaxWord]; // Word segmentation info
   CharTypeSet WordTypeSet;    // Bitmask of 1<<CharType for all Word characters
+  int FirstMatch[MaxPat];     // Earliest position Pat[P] can match in Word
   bool WordContainsPattern;   // Simple substring check
 
   // Cumulative best-match score table.
@@ -64,6 +64,10 @@ struct ASTRetentionPolicy {
   /// Maximum number of ASTs to be retained in memory when there are no pending
   /// requests for them.
   unsigned MaxRetainedASTs = 3;
+  /// If nonzero, the least recently used ASTs are also evicted while the total
+  /// size of the retained ASTs exceeds this many bytes. The most recently used
+  /// AST is always retained, even if it is larger than the budget.
+  size_t MaxRetainedBytes = 0;
 };
 
 /// Clangd may wait after an update to see if another one comes along.
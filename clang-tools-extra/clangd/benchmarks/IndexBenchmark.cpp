@@ -8,6 +8,8 @@
 
 #include "../index/Serialization.h"
 #include "../index/dex/Dex.h"
+#include "../index/dex/Iterator.h"
+#include "../index/dex/PostingList.h"
 #include "benchmark/benchmark.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
@@ -97,6 +99,25 @@ static void dexBuild(benchmark::State &State) {
 }
 BENCHMARK(dexBuild);
 
+// Intersects a sparse posting list with a dense one, as for a query combining
+// a rare trigram with a common scope. Range(0) is the ratio of their sizes.
+static void postingListIntersection(benchmark::State &State) {
+  constexpr dex::DocID Size = 1 << 20;
+  std::vector<dex::DocID> Dense, Sparse;
+  for (dex::DocID I = 0; I < Size; I += 2)
+    Dense.push_back(I);
+  for (dex::DocID I = 0; I < Size; I += 2 * State.range(0))
+    Sparse.push_back(I);
+  const dex::PostingList DenseList(Dense), SparseList(Sparse);
+  const dex::Corpus Corpus(Size);
+  for (auto _ : State) {
+    auto It = Corpus.intersect(DenseList.iterator(), SparseList.iterator());
+    for (; !It->reachedEnd(); It->advance())
+      benchmark::DoNotOptimize(It->peek());
+  }
+}
+BENCHMARK(postingListIntersection)->RangeMultiplier(8)->Range(1, 4096);
+
 } // namespace
 } // namespace clangd
 } // namespace clang
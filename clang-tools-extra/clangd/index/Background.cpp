@@ -37,6 +37,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Threading.h"
@@ -157,6 +158,7 @@ static llvm::StringRef filenameWithoutExtension(llvm::StringRef Path) {
 
 BackgroundQueue::Task BackgroundIndex::indexFileTask(std::string Path) {
   std::string Tag = filenameWithoutExtension(Path).str();
+  std::string GroupTag = llvm::sys::path::parent_path(Path).str();
   uint64_t Key = llvm::xxh3_64bits(Path);
   BackgroundQueue::Task T([this, Path(std::move(Path))] {
     std::optional<WithContext> WithProvidedContext;
@@ -171,6 +173,7 @@ BackgroundQueue::Task BackgroundIndex::indexFileTask(std::string Path) {
   T.QueuePri = IndexFile;
   T.ThreadPri = IndexingPriority;
   T.Tag = std::move(Tag);
+  T.GroupTag = std::move(GroupTag);
   T.Key = Key;
   return T;
 }
@@ -178,6 +181,9 @@ BackgroundQueue::Task BackgroundIndex::indexFileTask(std::string Path) {
 void BackgroundIndex::boostRelated(llvm::StringRef Path) {
   if (isHeaderFile(Path))
     Queue.boost(filenameWithoutExtension(Path), IndexBoostedFile);
+  // Files next to the one being edited are the most likely to be looked at
+  // next, so index their TUs before the rest of the project.
+  Queue.boost(llvm::sys::path::parent_path(Path), IndexNearbyFile);
 }
 
 /// Given index results from a TU, only update symbols coming from files that
@@ -365,9 +371,17 @@ BackgroundIndex::loadProject(std::vector<std::string> MainFiles) {
              Config::BackgroundPolicy::Skip;
     });
   Rebuilder.startLoading();
-  // Load shards for all of the mainfiles.
-  const std::vector<LoadedShard> Result =
-      loadIndexShards(MainFiles, IndexStorageFactory, CDB);
+  auto FS = TFS.view(/*CWD=*/std::nullopt);
+  // Load shards for all of the mainfiles. TUs that are stale are reindexed
+  // anyway, so the loader makes them the DependentTU of their includes.
+  llvm::StringSet<> StaleTUs;
+  const std::vector<LoadedShard> Result = loadIndexShards(
+      MainFiles, IndexStorageFactory, CDB, [&](const LoadedShard &LS) {
+        if (!shardIsStale(LS, FS.get()))
+          return false;
+        StaleTUs.insert(LS.AbsolutePath);
+        return true;
+      });
   size_t LoadedShards = 0;
   {
     // Update in-memory state.
@@ -399,19 +413,22 @@ BackgroundIndex::loadProject(std::vector<std::string> MainFiles) {
   Rebuilder.loadedShard(LoadedShards);
   Rebuilder.doneLoading();
 
-  auto FS = TFS.view(/*CWD=*/std::nullopt);
   llvm::DenseSet<PathRef> TUsToIndex;
   // We'll accept data from stale shards, but ensure the files get reindexed
   // soon.
   for (auto &LS : Result) {
-    if (!shardIsStale(LS, FS.get()))
-      continue;
     PathRef TUForFile = LS.DependentTU;
     assert(!TUForFile.empty() && "File without a TU!");
+    bool Stale = LS.AbsolutePath == TUForFile
+                     ? StaleTUs.contains(LS.AbsolutePath)
+                     : shardIsStale(LS, FS.get());
+    if (!Stale)
+      continue;
 
-    // FIXME: Currently, we simply schedule indexing on a TU whenever any of
-    // its dependencies needs re-indexing. We might do it smarter by figuring
-    // out a minimal set of TUs that will cover all the stale dependencies.
+    // Schedule indexing on a TU whenever any of its dependencies needs
+    // re-indexing. As stale TUs were loaded first, a stale header is covered
+    // by a TU that is reindexed anyway when one includes it, so e.g. a header
+    // and the source files that changed along with it cost no extra TUs.
     // FIXME: Try looking at other TUs if no compile commands are available
     // for this TU, i.e TU was deleted after we performed indexing.
     TUsToIndex.insert(TUForFile);
@@ -13,6 +13,7 @@
 #include "support/Path.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Path.h"
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
@@ -30,6 +31,10 @@ public:
   /// Load the shards for \p MainFile and all of its dependencies.
   void load(PathRef MainFile);
 
+  /// Load only the shard for \p MainFile. Its dependencies are loaded by a
+  /// later call to load().
+  const LoadedShard &loadMainFile(PathRef MainFile);
+
   /// Consumes the loader and returns all shards.
   std::vector<LoadedShard> takeResult() &&;
 
@@ -42,6 +47,8 @@ private:
 
   /// Cache for Storage lookups.
   llvm::StringMap<LoadedShard> LoadedShards;
+  /// Dependencies of the shards loaded by loadMainFile(), to visit in load().
+  llvm::StringMap<std::vector<Path>> PendingEdges;
 
   BackgroundIndexStorage::Factory &IndexStorageFactory;
 };
@@ -87,6 +94,13 @@ BackgroundIndexLoader::loadShard(PathRef StartSourceFile, PathRef DependentTU) {
   return {LS, Edges};
 }
 
+const LoadedShard &BackgroundIndexLoader::loadMainFile(PathRef MainFile) {
+  auto ShardAndEdges = loadShard(MainFile, MainFile);
+  if (!ShardAndEdges.second.empty())
+    PendingEdges[MainFile] = std::move(ShardAndEdges.second);
+  return ShardAndEdges.first;
+}
+
 void BackgroundIndexLoader::load(PathRef MainFile) {
   llvm::StringSet<> InQueue;
   // Following containers points to strings inside InQueue.
@@ -99,6 +113,13 @@ void BackgroundIndexLoader::load(PathRef MainFile) {
     ToVisit.pop();
 
     auto ShardAndEdges = loadShard(SourceFile, MainFile);
+    if (SourceFile == MainFile) {
+      auto It = PendingEdges.find(MainFile);
+      if (It != PendingEdges.end()) {
+        ShardAndEdges.second = std::move(It->second);
+        PendingEdges.erase(It);
+      }
+    }
     for (PathRef Edge : ShardAndEdges.second) {
       auto It = InQueue.insert(Edge);
       if (It.second)
@@ -119,9 +140,15 @@ std::vector<LoadedShard> BackgroundIndexLoader::takeResult() && {
 std::vector<LoadedShard>
 loadIndexShards(llvm::ArrayRef<Path> MainFiles,
                 BackgroundIndexStorage::Factory &IndexStorageFactory,
-                const GlobalCompilationDatabase &CDB) {
+                const GlobalCompilationDatabase &CDB,
+                llvm::function_ref<bool(const LoadedShard &)> Prefer) {
   BackgroundIndexLoader Loader(IndexStorageFactory);
-  for (llvm::StringRef MainFile : MainFiles) {
+  std::vector<llvm::StringRef> Order(MainFiles.begin(), MainFiles.end());
+  if (Prefer)
+    std::stable_partition(Order.begin(), Order.end(), [&](PathRef MainFile) {
+      return Prefer(Loader.loadMainFile(MainFile));
+    });
+  for (llvm::StringRef MainFile : Order) {
     assert(llvm::sys::path::is_absolute(MainFile));
     Loader.load(MainFile);
   }
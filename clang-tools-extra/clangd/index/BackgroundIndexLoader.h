@@ -12,6 +12,7 @@
 #include "index/Background.h"
 #include "support/Path.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
 #include <memory>
 #include <vector>
 
@@ -38,10 +39,15 @@ struct LoadedShard {
 };
 
 /// Loads all shards for the TU \p MainFile from \p Storage.
+///
+/// Each shard's DependentTU is the first TU that included it. If \p Prefer is
+/// provided, it is called with the shard of each TU before any dependencies
+/// are loaded, and the TUs it returns true for are visited first.
 std::vector<LoadedShard>
 loadIndexShards(llvm::ArrayRef<Path> MainFiles,
                 BackgroundIndexStorage::Factory &IndexStorageFactory,
-                const GlobalCompilationDatabase &CDB);
+                const GlobalCompilationDatabase &CDB,
+                llvm::function_ref<bool(const LoadedShard &)> Prefer = nullptr);
 
 } // namespace clangd
 } // namespace clang
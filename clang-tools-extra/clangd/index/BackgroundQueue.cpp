@@ -82,7 +82,8 @@ bool BackgroundQueue::adjust(Task &T) {
   //  - reindexing on compile flags is often a poor use of CPU in practice
   if (T.Key && !SeenKeys.insert(T.Key).second)
     return false;
-  T.QueuePri = std::max(T.QueuePri, Boosts.lookup(T.Tag));
+  T.QueuePri =
+      std::max({T.QueuePri, Boosts.lookup(T.Tag), Boosts.lookup(T.GroupTag)});
   return true;
 }
 
@@ -124,7 +125,7 @@ void BackgroundQueue::boost(llvm::StringRef Tag, unsigned NewPriority) {
 
   unsigned Changes = 0;
   for (Task &T : Queue)
-    if (Tag == T.Tag && NewPriority > T.QueuePri) {
+    if ((Tag == T.Tag || Tag == T.GroupTag) && NewPriority > T.QueuePri) {
       T.QueuePri = NewPriority;
       ++Changes;
     }
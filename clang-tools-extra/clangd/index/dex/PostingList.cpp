@@ -25,7 +25,7 @@ public:
   explicit ChunkIterator(const Token *Tok, llvm::ArrayRef<Chunk> Chunks)
       : Tok(Tok), Chunks(Chunks), CurrentChunk(Chunks.begin()) {
     if (!Chunks.empty()) {
-      DecompressedChunk = CurrentChunk->decompress();
+      CurrentChunk->decompress(DecompressedChunk);
       CurrentID = DecompressedChunk.begin();
     }
   }
@@ -40,8 +40,8 @@ public:
     normalizeCursor();
   }
 
-  /// Applies binary search to advance cursor to the next item with DocID
-  /// equal or higher than the given one.
+  /// Applies galloping and binary search to advance cursor to the next item
+  /// with DocID equal or higher than the given one.
   void advanceTo(DocID ID) override {
     assert(!reachedEnd() &&
            "Posting List iterator can't advance() at the end.");
@@ -93,21 +93,35 @@ private:
     ++CurrentChunk;
     if (CurrentChunk == Chunks.end()) // Reached the end of PostingList.
       return;
-    DecompressedChunk = CurrentChunk->decompress();
+    CurrentChunk->decompress(DecompressedChunk);
     CurrentID = DecompressedChunk.begin();
   }
 
   /// Advances CurrentChunk to the chunk which might contain ID.
+  ///
+  /// In an AND of a short and a long list, the long list is advanced to IDs
+  /// from the short one, which are usually a few chunks ahead of the cursor.
+  /// Gallop ahead in exponentially growing steps before the binary search, so
+  /// that the cost depends on the distance skipped rather than on the number
+  /// of remaining chunks.
   void advanceToChunk(DocID ID) {
-    if ((CurrentChunk != Chunks.end() - 1) &&
-        ((CurrentChunk + 1)->Head <= ID)) {
-      CurrentChunk =
-          std::partition_point(CurrentChunk + 1, Chunks.end(),
-                               [&](const Chunk &C) { return C.Head < ID; });
-      --CurrentChunk;
-      DecompressedChunk = CurrentChunk->decompress();
-      CurrentID = DecompressedChunk.begin();
+    auto Next = CurrentChunk + 1;
+    if (Next == Chunks.end() || Next->Head > ID)
+      return;
+    // Invariant: Lo->Head <= ID, and Hi is either end() or Hi->Head > ID.
+    auto Lo = Next, Hi = Chunks.end();
+    for (size_t Step = 1; Step < size_t(Chunks.end() - Lo); Step *= 2) {
+      if (Lo[Step].Head > ID) {
+        Hi = Lo + Step;
+        break;
+      }
+      Lo += Step;
     }
+    CurrentChunk = std::partition_point(
+        Lo + 1, Hi, [&](const Chunk &C) { return C.Head <= ID; });
+    --CurrentChunk;
+    CurrentChunk->decompress(DecompressedChunk);
+    CurrentID = DecompressedChunk.begin();
   }
 
   const Token *Tok;
@@ -164,9 +178,9 @@ bool encodeVByte(DocID Delta, llvm::MutableArrayRef<uint8_t> &Payload) {
 /// DocIDs    42            47        7000
 /// gaps                    5         6958
 /// Encoding  (raw number)  00000101  10110110 00101110
-std::vector<Chunk> encodeStream(llvm::ArrayRef<DocID> Documents) {
+llvm::SmallVector<Chunk, 1> encodeStream(llvm::ArrayRef<DocID> Documents) {
   assert(!Documents.empty() && "Can't encode empty sequence.");
-  std::vector<Chunk> Result;
+  llvm::SmallVector<Chunk, 1> Result;
   Result.emplace_back();
   DocID Last = Result.back().Head = Documents.front();
   llvm::MutableArrayRef<uint8_t> RemainingPayload = Result.back().Payload;
@@ -178,7 +192,7 @@ std::vector<Chunk> encodeStream(llvm::ArrayRef<DocID> Documents) {
     }
     Last = Doc;
   }
-  return std::vector<Chunk>(Result); // no move, shrink-to-fit
+  return llvm::SmallVector<Chunk, 1>(Result); // no move, shrink-to-fit
 }
 
 /// Reads variable length DocID from the buffer and updates the buffer size. If
@@ -201,8 +215,9 @@ std::optional<DocID> readVByte(llvm::ArrayRef<uint8_t> &Bytes) {
 
 } // namespace
 
-llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Chunk::decompress() const {
-  llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Result{Head};
+void Chunk::decompress(llvm::SmallVectorImpl<DocID> &Result) const {
+  Result.clear();
+  Result.push_back(Head);
   llvm::ArrayRef<uint8_t> Bytes(Payload);
   DocID Delta;
   for (DocID Current = Head; !Bytes.empty(); Current += Delta) {
@@ -212,7 +227,12 @@ llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Chunk::decompress() const {
     Delta = *MaybeDelta;
     Result.push_back(Current + Delta);
   }
-  return llvm::SmallVector<DocID, Chunk::PayloadSize + 1>{Result};
+}
+
+llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Chunk::decompress() const {
+  llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Result;
+  decompress(Result);
+  return Result;
 }
 
 PostingList::PostingList(llvm::ArrayRef<DocID> Documents)
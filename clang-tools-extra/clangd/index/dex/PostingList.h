@@ -27,7 +27,6 @@
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/SmallVector.h"
 #include <cstdint>
-#include <vector>
 
 namespace clang {
 namespace clangd {
@@ -44,6 +43,9 @@ struct Chunk {
   static constexpr size_t PayloadSize = 32 - sizeof(DocID);
 
   llvm::SmallVector<DocID, PayloadSize + 1> decompress() const;
+  /// Decompresses into \p Result, replacing its contents. This lets iterators
+  /// reuse one buffer instead of copying a fresh vector for every chunk.
+  void decompress(llvm::SmallVectorImpl<DocID> &Result) const;
 
   /// The first element of decompressed Chunk.
   DocID Head;
@@ -56,6 +58,9 @@ static_assert(sizeof(Chunk) == 32, "Chunk should take 32 bytes of memory.");
 /// Tree as a leaf by constructing Iterator over the PostingList object. DocIDs
 /// are stored in underlying chunks. Compression saves memory at a small cost
 /// in access time, which is still fast enough in practice.
+///
+/// Most posting lists (scopes, types, rare trigrams) fit in a single chunk,
+/// which is stored inline to save a heap allocation per list.
 class PostingList {
 public:
   explicit PostingList(llvm::ArrayRef<DocID> Documents);
@@ -66,10 +71,12 @@ public:
   std::unique_ptr<Iterator> iterator(const Token *Tok = nullptr) const;
 
   /// Returns in-memory size of external storage.
-  size_t bytes() const { return Chunks.capacity() * sizeof(Chunk); }
+  size_t bytes() const {
+    return Chunks.size() > 1 ? Chunks.capacity() * sizeof(Chunk) : 0;
+  }
 
 private:
-  const std::vector<Chunk> Chunks;
+  const llvm::SmallVector<Chunk, 1> Chunks;
 };
 
 } // namespace dex
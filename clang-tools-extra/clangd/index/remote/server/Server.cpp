@@ -22,6 +22,7 @@
 #include "support/ThreadsafeFS.h"
 #include "support/Trace.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/CommandLine.h"
@@ -32,14 +33,19 @@
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/VirtualFileSystem.h"
 
+#include <atomic>
 #include <chrono>
+#include <deque>
 #include <grpc++/grpc++.h>
 #include <grpc++/health_check_service_interface.h>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #if ENABLE_GRPC_REFLECTION
 #include <grpc++/ext/proto_server_reflection_plugin.h>
@@ -111,12 +117,116 @@ llvm::cl::opt<size_t> LimitResults(
                    "single request. Limit is to keep the server from being "
                    "DOS'd. Defaults to 10000."));
 
+llvm::cl::opt<size_t> FuzzyFindCacheSize(
+    "fuzzy-find-cache-size", llvm::cl::init(0),
+    llvm::cl::desc("Maximum number of FuzzyFind responses to cache until the "
+                   "index is reloaded. Defaults to 0 (no caching)."));
+
 static Key<grpc::ServerContext *> CurrentRequest;
 
+// Statistics of the requests served, reported by the Monitor service.
+class RequestStats {
+public:
+  void record(llvm::StringRef RequestName, unsigned Sent,
+              std::chrono::milliseconds Latency) {
+    std::lock_guard<std::mutex> Lock(Mu);
+    Entry &E = Stats[RequestName];
+    ++E.Count;
+    E.Results += Sent;
+    E.TotalLatency += Latency;
+    E.MaxLatency = std::max(E.MaxLatency, Latency);
+  }
+
+  void fill(v1::MonitoringInfoReply &Reply) const {
+    std::lock_guard<std::mutex> Lock(Mu);
+    for (const auto &[Name, E] : Stats) {
+      v1::RequestStats *RS = Reply.add_request_stats();
+      RS->set_name(Name.str());
+      RS->set_count(E.Count);
+      RS->set_results(E.Results);
+      RS->set_total_latency_ms(E.TotalLatency.count());
+      RS->set_max_latency_ms(E.MaxLatency.count());
+    }
+  }
+
+private:
+  struct Entry {
+    uint64_t Count = 0;
+    uint64_t Results = 0;
+    std::chrono::milliseconds TotalLatency{0};
+    std::chrono::milliseconds MaxLatency{0};
+  };
+  mutable std::mutex Mu;
+  std::map<llvm::StringRef, Entry> Stats;
+};
+
+// Caches the responses to FuzzyFind requests, which clients repeat a lot (e.g.
+// every completion request in a scope), for the currently loaded index.
+class FuzzyFindCache {
+public:
+  using Response = std::vector<FuzzyFindReply>;
+
+  FuzzyFindCache(size_t Capacity) : Capacity(Capacity) {}
+
+  bool enabled() const { return Capacity != 0; }
+
+  // The generation must be read before querying the index, so that responses
+  // computed from an index that has been replaced since are not cached.
+  uint64_t generation() const { return Generation.load(); }
+
+  std::shared_ptr<const Response> lookup(const std::string &Key) {
+    std::lock_guard<std::mutex> Lock(Mu);
+    auto It = Responses.find(Key);
+    if (It == Responses.end())
+      return nullptr;
+    ++Hits;
+    return It->second;
+  }
+
+  void insert(std::string Key, Response R, uint64_t ForGeneration) {
+    std::lock_guard<std::mutex> Lock(Mu);
+    if (ForGeneration != Generation.load())
+      return;
+    auto [It, Inserted] = Responses.try_emplace(
+        Key, std::make_shared<const Response>(std::move(R)));
+    if (!Inserted)
+      return;
+    // Evict the oldest responses.
+    InsertionOrder.push_back(It->first());
+    while (InsertionOrder.size() > Capacity) {
+      Responses.erase(InsertionOrder.front());
+      InsertionOrder.pop_front();
+    }
+  }
+
+  // Drops all the cached responses, when a new version of the index is
+  // loaded.
+  void clear() {
+    std::lock_guard<std::mutex> Lock(Mu);
+    ++Generation;
+    InsertionOrder.clear();
+    Responses.clear();
+  }
+
+  uint64_t hits() const {
+    std::lock_guard<std::mutex> Lock(Mu);
+    return Hits;
+  }
+
+private:
+  const size_t Capacity;
+  std::atomic<uint64_t> Generation = 0;
+  mutable std::mutex Mu;
+  llvm::StringMap<std::shared_ptr<const Response>> Responses;
+  std::deque<llvm::StringRef> InsertionOrder;
+  uint64_t Hits = 0;
+};
+
 class RemoteIndexServer final : public v1::SymbolIndex::Service {
 public:
-  RemoteIndexServer(clangd::SymbolIndex &Index, llvm::StringRef IndexRoot)
-      : Index(Index) {
+  RemoteIndexServer(clangd::SymbolIndex &Index, llvm::StringRef IndexRoot,
+                    RequestStats &Stats, FuzzyFindCache &Cache)
+      : Index(Index), Stats(Stats), Cache(Cache) {
     llvm::SmallString<256> NativePath = IndexRoot;
     llvm::sys::path::native(NativePath);
     ProtobufMarshaller = std::unique_ptr<Marshaller>(new Marshaller(
@@ -190,8 +300,26 @@ private:
           Req->Limit, LimitResults);
       Req->Limit = LimitResults;
     }
+    std::string CacheKey;
+    uint64_t CacheGeneration = 0;
+    if (Cache.enabled()) {
+      CacheKey = Request->SerializeAsString();
+      CacheGeneration = Cache.generation();
+      if (auto Cached = Cache.lookup(CacheKey)) {
+        for (const FuzzyFindReply &Message : *Cached) {
+          logResponse(Message);
+          Reply->Write(Message);
+        }
+        unsigned Sent = Cached->size() - 1;
+        SPAN_ATTACH(Tracer, "Sent", Sent);
+        SPAN_ATTACH(Tracer, "Cached", true);
+        logRequestSummary("v1/FuzzyFind", Sent, StartTime);
+        return grpc::Status::OK;
+      }
+    }
     unsigned Sent = 0;
     unsigned FailedToSend = 0;
+    FuzzyFindCache::Response Response;
     bool HasMore = Index.fuzzyFind(*Req, [&](const clangd::Symbol &Item) {
       auto SerializedItem = ProtobufMarshaller->toProtobuf(Item);
       if (!SerializedItem) {
@@ -205,11 +333,17 @@ private:
       logResponse(NextMessage);
       Reply->Write(NextMessage);
       ++Sent;
+      if (Cache.enabled())
+        Response.push_back(std::move(NextMessage));
     });
     FuzzyFindReply LastMessage;
     LastMessage.mutable_final_result()->set_has_more(HasMore);
     logResponse(LastMessage);
     Reply->Write(LastMessage);
+    if (Cache.enabled()) {
+      Response.push_back(std::move(LastMessage));
+      Cache.insert(std::move(CacheKey), std::move(Response), CacheGeneration);
+    }
     SPAN_ATTACH(Tracer, "Sent", Sent);
     SPAN_ATTACH(Tracer, "Failed to send", FailedToSend);
     logRequestSummary("v1/FuzzyFind", Sent, StartTime);
@@ -370,22 +504,28 @@ private:
                          stopwatch::time_point StartTime) {
     auto Duration = stopwatch::now() - StartTime;
     auto Millis =
-        std::chrono::duration_cast<std::chrono::milliseconds>(Duration).count();
+        std::chrono::duration_cast<std::chrono::milliseconds>(Duration);
     log("[public] request {0} => OK: {1} results in {2}ms", RequestName, Sent,
-        Millis);
+        Millis.count());
+    Stats.record(RequestName, Sent, Millis);
   }
 
   std::unique_ptr<Marshaller> ProtobufMarshaller;
   clangd::SymbolIndex &Index;
+  RequestStats &Stats;
+  FuzzyFindCache &Cache;
 };
 
 class Monitor final : public v1::Monitor::Service {
 public:
-  Monitor(llvm::sys::TimePoint<> IndexAge)
-      : StartTime(std::chrono::system_clock::now()), IndexBuildTime(IndexAge) {}
+  Monitor(llvm::sys::TimePoint<> IndexAge, const RequestStats &Stats,
+          const FuzzyFindCache &Cache)
+      : StartTime(std::chrono::system_clock::now()), IndexBuildTime(IndexAge),
+        Stats(Stats), Cache(Cache) {}
 
   void updateIndex(llvm::sys::TimePoint<> UpdateTime) {
     IndexBuildTime.exchange(UpdateTime);
+    ++IndexReloads;
   }
 
 private:
@@ -406,11 +546,17 @@ private:
         std::chrono::duration_cast<std::chrono::seconds>(
             std::chrono::system_clock::now() - IndexBuildTime.load())
             .count());
+    Stats.fill(*Reply);
+    Reply->set_fuzzy_find_cache_hits(Cache.hits());
+    Reply->set_index_reloads(IndexReloads.load());
     return grpc::Status::OK;
   }
 
   const llvm::sys::TimePoint<> StartTime;
   std::atomic<llvm::sys::TimePoint<>> IndexBuildTime;
+  std::atomic<uint64_t> IndexReloads = 0;
+  const RequestStats &Stats;
+  const FuzzyFindCache &Cache;
 };
 
 void maybeTrimMemory() {
@@ -424,7 +570,7 @@ void maybeTrimMemory() {
 void hotReload(clangd::SwapIndex &Index, llvm::StringRef IndexPath,
                llvm::vfs::Status &LastStatus,
                llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> &FS,
-               Monitor &Monitor) {
+               Monitor &Monitor, FuzzyFindCache &Cache) {
   // glibc malloc doesn't shrink an arena if there are items living at the end,
   // which might happen since we destroy the old index after building new one.
   // Trim more aggresively to keep memory usage of the server low.
@@ -450,14 +596,16 @@ void hotReload(clangd::SwapIndex &Index, llvm::StringRef IndexPath,
     return;
   }
   Index.reset(std::move(NewIndex));
+  Cache.clear();
   Monitor.updateIndex(Status->getLastModificationTime());
   log("New index version loaded. Last modification time: {0}, size: {1} bytes.",
       Status->getLastModificationTime(), Status->getSize());
 }
 
 void runServerAndWait(clangd::SymbolIndex &Index, llvm::StringRef ServerAddress,
-                      llvm::StringRef IndexPath, Monitor &Monitor) {
-  RemoteIndexServer Service(Index, IndexRoot);
+                      llvm::StringRef IndexPath, Monitor &Monitor,
+                      RequestStats &Stats, FuzzyFindCache &Cache) {
+  RemoteIndexServer Service(Index, IndexRoot, Stats, Cache);
 
   grpc::EnableDefaultHealthCheckService(true);
 #if ENABLE_GRPC_REFLECTION
@@ -589,18 +737,21 @@ int main(int argc, char *argv[]) {
   }
   clang::clangd::SwapIndex Index(std::move(SymIndex));
 
-  Monitor Monitor(Status->getLastModificationTime());
+  RequestStats Stats;
+  FuzzyFindCache Cache(FuzzyFindCacheSize);
+  Monitor Monitor(Status->getLastModificationTime(), Stats, Cache);
 
-  std::thread HotReloadThread([&Index, &Status, &FS, &Monitor]() {
+  std::thread HotReloadThread([&Index, &Status, &FS, &Monitor, &Cache]() {
     llvm::vfs::Status LastStatus = *Status;
     static constexpr auto RefreshFrequency = std::chrono::seconds(30);
     while (!clang::clangd::shutdownRequested()) {
-      hotReload(Index, llvm::StringRef(IndexPath), LastStatus, FS, Monitor);
+      hotReload(Index, llvm::StringRef(IndexPath), LastStatus, FS, Monitor,
+                Cache);
       std::this_thread::sleep_for(RefreshFrequency);
     }
   });
 
-  runServerAndWait(Index, ServerAddress, IndexPath, Monitor);
+  runServerAndWait(Index, ServerAddress, IndexPath, Monitor, Stats, Cache);
 
   HotReloadThread.join();
 }
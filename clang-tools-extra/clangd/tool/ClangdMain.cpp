@@ -44,6 +44,7 @@
 #include "llvm/Support/raw_ostream.h"
 #include <chrono>
 #include <cstdlib>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -405,6 +406,15 @@ opt<PCHStorageFlag> PCHStorage{
     init(PCHStorageFlag::Disk),
 };
 
+opt<unsigned> ASTCacheSize{
+    "ast-cache-size",
+    cat(Misc),
+    desc("Limit the ASTs kept in memory for files not being worked on to this "
+         "many MiB in total, instead of to a fixed number of ASTs. 0 means "
+         "no size limit"),
+    init(0),
+};
+
 opt<bool> Sync{
     "sync",
     cat(Misc),
@@ -910,6 +920,10 @@ clangd accepts flags on the commandline, and in the CLANGD_FLAGS environment var
     Opts.StorePreamblesInMemory = false;
     break;
   }
+  if (ASTCacheSize) {
+    Opts.RetentionPolicy.MaxRetainedASTs = std::numeric_limits<unsigned>::max();
+    Opts.RetentionPolicy.MaxRetainedBytes = size_t(ASTCacheSize) << 20;
+  }
   if (!ResourceDir.empty())
     Opts.ResourceDir = ResourceDir;
   Opts.BuildDynamicSymbolIndex = true;
@@ -825,6 +825,40 @@ TEST(BackgroundQueueTest, Boost) {
   }
 }
 
+TEST(BackgroundQueueTest, BoostGroup) {
+  std::string Sequence;
+
+  BackgroundQueue::Task A([&] { Sequence.push_back('A'); });
+  A.Tag = "A";
+  A.GroupTag = "AC";
+  A.QueuePri = 1;
+
+  BackgroundQueue::Task B([&] { Sequence.push_back('B'); });
+  B.Tag = "B";
+  B.QueuePri = 2;
+
+  BackgroundQueue::Task C([&] { Sequence.push_back('C'); });
+  C.Tag = "C";
+  C.GroupTag = "AC";
+  C.QueuePri = 4;
+
+  {
+    BackgroundQueue Q;
+    Q.boost("AC", 3);
+    Q.append({A, B, C});
+    Q.work([&] { Q.stop(); });
+    EXPECT_EQ("CAB", Sequence) << "group was boosted before enqueueing";
+  }
+  Sequence.clear();
+  {
+    BackgroundQueue Q;
+    Q.append({A, B, C});
+    Q.boost("AC", 3);
+    Q.work([&] { Q.stop(); });
+    EXPECT_EQ("CAB", Sequence) << "group was boosted after enqueueing";
+  }
+}
+
 TEST(BackgroundQueueTest, Duplicates) {
   std::string Sequence;
   BackgroundQueue::Task A([&] { Sequence.push_back('A'); });
@@ -643,6 +643,43 @@ TEST_F(TUSchedulerTests, EvictedAST) {
               UnorderedElementsAre(Foo, AnyOf(Bar, Baz)));
 }
 
+TEST_F(TUSchedulerTests, EvictedASTBySize) {
+  auto Opts = optsForTest();
+  Opts.AsyncThreadsCount = 1;
+  Opts.RetentionPolicy.MaxRetainedASTs = 10;
+  // Any AST is larger than this, so only the most recent one is retained.
+  Opts.RetentionPolicy.MaxRetainedBytes = 1;
+  trace::TestTracer Tracer;
+  TUScheduler S(CDB, Opts);
+
+  auto Foo = testPath("foo.cpp");
+  auto Bar = testPath("bar.cpp");
+  S.update(Foo, getInputs(Foo, "int x=1;"), WantDiagnostics::Yes);
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+  ASSERT_THAT(S.getFilesWithCachedAST(), ElementsAre(Foo));
+  EXPECT_THAT(Tracer.takeMetric("ast_cache_evictions", "size"), SizeIs(0));
+
+  S.update(Bar, getInputs(Bar, "int x=2;"), WantDiagnostics::Yes);
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+  EXPECT_THAT(S.getFilesWithCachedAST(), ElementsAre(Bar));
+  EXPECT_THAT(Tracer.takeMetric("ast_cache_evictions", "size"), SizeIs(1));
+}
+
+TEST_F(TUSchedulerTests, NoRetainedASTs) {
+  auto Opts = optsForTest();
+  Opts.AsyncThreadsCount = 1;
+  Opts.RetentionPolicy.MaxRetainedASTs = 0;
+  trace::TestTracer Tracer;
+  TUScheduler S(CDB, Opts);
+
+  auto Foo = testPath("foo.cpp");
+  S.update(Foo, getInputs(Foo, "int x=1;"), WantDiagnostics::Yes);
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+  EXPECT_THAT(S.getFilesWithCachedAST(), IsEmpty());
+  EXPECT_THAT(Tracer.takeMetric("ast_cache_evictions", "count"),
+              Not(IsEmpty()));
+}
+
 // We send "empty" changes to TUScheduler when we think some external event
 // *might* have invalidated current state (e.g. a header was edited).
 // Verify that this doesn't evict our cache entries.
@@ -22,6 +22,7 @@
 #include "clang/Tooling/Core/Replacement.h"
 #include "clang/Tooling/Inclusions/StandardLibrary.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/STLFunctionalExtras.h"
@@ -56,15 +57,23 @@ void walkUsed(llvm::ArrayRef<Decl *> ASTRoots,
   const auto &SM = PP.getSourceManager();
   // This is duplicated in writeHTMLReport, changes should be mirrored there.
   tooling::stdlib::Recognizer Recognizer;
+  // Symbols are usually referenced many times, and their providers only depend
+  // on the symbol. walkAST reports canonical decls, so each symbol is looked up
+  // once.
+  llvm::DenseMap<Symbol, llvm::SmallVector<Header>> Providers;
+  auto ProvidersFor = [&](const Symbol &S) -> llvm::ArrayRef<Header> {
+    auto [It, Inserted] = Providers.try_emplace(S);
+    if (Inserted)
+      It->second = headersForSymbol(S, PP, PI);
+    return It->second;
+  };
   for (auto *Root : ASTRoots) {
     walkAST(*Root, [&](SourceLocation Loc, NamedDecl &ND, RefType RT) {
       auto FID = SM.getFileID(SM.getSpellingLoc(Loc));
       if (FID != SM.getMainFileID() && FID != SM.getPreambleFileID())
         return;
-      // FIXME: Most of the work done here is repetitive. It might be useful to
-      // have a cache/batching.
       SymbolReference SymRef{ND, Loc, RT};
-      return CB(SymRef, headersForSymbol(ND, PP, PI));
+      return CB(SymRef, ProvidersFor(ND));
     });
   }
   for (const SymbolReference &MacroRef : MacroRefs) {
@@ -72,7 +81,7 @@ void walkUsed(llvm::ArrayRef<Decl *> ASTRoots,
     if (!SM.isWrittenInMainFile(SM.getSpellingLoc(MacroRef.RefLocation)) ||
         shouldIgnoreMacroReference(PP, MacroRef.Target.macro()))
       continue;
-    CB(MacroRef, headersForSymbol(MacroRef.Target, PP, PI));
+    CB(MacroRef, ProvidersFor(MacroRef.Target));
   }
 }
 
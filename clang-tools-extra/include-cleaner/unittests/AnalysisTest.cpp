@@ -167,6 +167,29 @@ TEST_F(WalkUsedTest, MultipleProviders) {
                     UnorderedElementsAre(HeaderFile1, HeaderFile2, MainFile))));
 }
 
+TEST_F(WalkUsedTest, RepeatedReferences) {
+  llvm::Annotations Code(R"cpp(
+  #include "header.h"
+  void bar() {
+    $foo1^foo();
+    $foo2^foo();
+    $foo3^foo();
+  }
+  )cpp");
+  Inputs.Code = Code.code();
+  Inputs.ExtraFiles["header.h"] = guard(R"cpp(
+  void foo();
+  )cpp");
+
+  TestAST AST(Inputs);
+  auto HeaderFile = Header(*AST.fileManager().getOptionalFileRef("header.h"));
+  auto Providers = offsetToProviders(AST);
+  for (llvm::StringRef Point : {"foo1", "foo2", "foo3"})
+    EXPECT_THAT(Providers, Contains(Pair(Code.point(Point),
+                                         UnorderedElementsAre(HeaderFile))))
+        << Point;
+}
+
 TEST_F(WalkUsedTest, MacroRefs) {
   llvm::Annotations Code(R"cpp(
     #include "hdr.h"
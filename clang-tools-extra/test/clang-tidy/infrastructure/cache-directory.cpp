@@ -0,0 +1,26 @@
+// RUN: rm -rf %t && mkdir -p %t
+// RUN: echo 'namespace h {' > %t/header.h && echo '}' >> %t/header.h
+// RUN: cp %s %t/main.cpp
+
+// RUN: clang-tidy %t/main.cpp -checks='-*,llvm-namespace-comment' -header-filter='.*' -cache-directory=%t/cache -- -I%t | FileCheck %s --check-prefixes=CHECK,HEADER
+// RUN: ls %t/cache | count 1
+// RUN: clang-tidy %t/main.cpp -checks='-*,llvm-namespace-comment' -header-filter='.*' -cache-directory=%t/cache -- -I%t | FileCheck %s --check-prefixes=CHECK,HEADER
+// RUN: ls %t/cache | count 1
+
+// Changing an included file invalidates the entry.
+// RUN: echo '' > %t/header.h
+// RUN: clang-tidy %t/main.cpp -checks='-*,llvm-namespace-comment' -header-filter='.*' -cache-directory=%t/cache -- -I%t | FileCheck %s --implicit-check-not="header.h:"
+// RUN: ls %t/cache | count 1
+
+// Other options and compile flags use other entries.
+// RUN: clang-tidy %t/main.cpp -checks='-*,llvm-namespace-comment,misc-unused-using-decls' -header-filter='.*' -cache-directory=%t/cache -- -I%t | FileCheck %s
+// RUN: ls %t/cache | count 2
+// RUN: clang-tidy %t/main.cpp -checks='-*,llvm-namespace-comment' -header-filter='.*' -cache-directory=%t/cache -- -I%t -DX | FileCheck %s
+// RUN: ls %t/cache | count 3
+
+#include "header.h"
+
+namespace i {
+}
+// CHECK-DAG: main.cpp:[[@LINE-1]]:2: warning: namespace 'i' not terminated with a closing comment [llvm-namespace-comment]
+// HEADER-DAG: header.h:2:2: warning: namespace 'h' not terminated with a closing comment [llvm-namespace-comment]
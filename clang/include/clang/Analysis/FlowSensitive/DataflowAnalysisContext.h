@@ -290,6 +290,19 @@ private:
   llvm::DenseMap<Atom, const Formula *> FlowConditionConstraints;
   const Formula *Invariant = nullptr;
 
+  // Constraints are only ever added to flow conditions and to `Invariant`, so
+  // an implication that was proven, or a formula that was shown not to be
+  // allowed, stays that way. Analyses repeat the same queries on a flow
+  // condition many times, e.g. once per access to the same optional, and
+  // each query otherwise re-encodes the whole transitive flow condition and
+  // spends solver budget on it. Formulas are uniqued by the arena, so they
+  // can be compared by address.
+  llvm::DenseSet<std::pair<Atom, const Formula *>> ProvenImplications;
+  llvm::DenseSet<std::pair<Atom, const Formula *>> DisprovenAllowances;
+  // Results of `equivalentFormulas`, which don't depend on any flow condition.
+  llvm::DenseMap<std::pair<const Formula *, const Formula *>, bool>
+      EquivalentFormulas;
+
   llvm::DenseMap<const FunctionDecl *, AdornedCFG> FunctionContexts;
 
   // Fields modeled by environments covered by this context.
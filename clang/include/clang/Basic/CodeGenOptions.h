@@ -200,6 +200,13 @@ public:
   /// The string to embed in debug information as the current working directory.
   std::string DebugCompilationDir;
 
+  /// A file assigning the debug info of C++ types to the translation units
+  /// that own them. Each line holds a type identifier (its mangled RTTI name)
+  /// and the name of the owning compile unit, separated by a tab. With limited
+  /// debug info, other translation units only emit declarations of such types.
+  /// If empty, the file given with -mllvm -debug-type-ownership-file is used.
+  std::string DebugTypeOwnershipFile;
+
   /// The string to embed in coverage mapping as the current working directory.
   std::string CoverageCompilationDir;
 
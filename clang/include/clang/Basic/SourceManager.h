@@ -720,6 +720,13 @@ class SourceManager : public RefCountedBase<SourceManager> {
   /// expansion.
   SmallVector<SrcMgr::SLocEntry, 0> LocalSLocEntryTable;
 
+  /// The starting offset of each entry in LocalSLocEntryTable.
+  ///
+  /// getFileIDLocal() searches this instead of the entries themselves, which
+  /// are much larger, so that the search touches far fewer cache lines in
+  /// TUs with many macro expansions.
+  SmallVector<SourceLocation::UIntTy, 0> LocalLocOffsetTable;
+
   /// The table of SLocEntries that are loaded from other modules.
   ///
   /// Negative FileIDs are indexes into this table. To get from ID to an index,
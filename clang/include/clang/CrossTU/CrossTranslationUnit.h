@@ -20,6 +20,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/StringMap.h"
+#include "llvm/Support/CachePruning.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/Path.h"
 #include <optional>
@@ -254,6 +255,11 @@ private:
     LoadResultTy loadFromDump(StringRef Identifier);
     /// Loads an AST from a source-file.
     LoadResultTy loadFromSource(StringRef Identifier);
+    /// Loads the AST stored at \p CachePath in the shared AST cache, or
+    /// returns null if it is missing or out of date.
+    std::unique_ptr<ASTUnit> loadFromCache(StringRef CachePath);
+    /// Stores \p Unit in the shared AST cache and prunes the cache.
+    void storeInCache(ASTUnit &Unit, StringRef CachePath);
 
     CompilerInstance &CI;
     StringRef CTUDir;
@@ -265,6 +271,10 @@ private:
     /// files is stored.
     std::optional<InvocationListTy> InvocationList;
     index_error_code PreviousParsingResult = index_error_code::success;
+    /// The directory in which ASTs parsed on-demand are shared with other
+    /// analyzer processes, or empty if they are not.
+    std::string ASTCacheDir;
+    llvm::CachePruningPolicy ASTCachePolicy;
   };
 
   /// Maintain number of AST loads and check for reaching the load limit.
@@ -17,6 +17,7 @@
 #include "clang/Lex/Preprocessor.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Error.h"
 #include "llvm/Support/MD5.h"
 #include <cstddef>
 #include <memory>
@@ -132,6 +133,28 @@ public:
                         IntrusiveRefCntPtr<llvm::vfs::FileSystem> &VFS,
                         llvm::MemoryBuffer *MainFileBuffer) const;
 
+  /// Returns a key identifying the preamble that Build() would produce for
+  /// \p Invocation and the first \p Bounds bytes of \p MainFileBuffer, for
+  /// use as the file name in a preamble cache shared between processes.
+  ///
+  /// The key covers the compiler version, the -cc1 options and the preamble
+  /// text. It does not cover the files the preamble includes; those are
+  /// checked by CanReuse() after the cached preamble is loaded.
+  static std::string getCacheKey(const CompilerInvocation &Invocation,
+                                 const llvm::MemoryBufferRef &MainFileBuffer,
+                                 PreambleBounds Bounds);
+
+  /// Writes the PCH and everything CanReuse() needs to \p Path, replacing
+  /// any existing file atomically, so that load() can restore this preamble
+  /// in another process.
+  llvm::Error save(StringRef Path) const;
+
+  /// Loads a preamble written by save(). \p StoreInMemory and \p StoragePath
+  /// have the same meaning as for Build(). The caller is expected to check
+  /// CanReuse() before using the result.
+  static llvm::ErrorOr<PrecompiledPreamble>
+  load(StringRef Path, bool StoreInMemory, StringRef StoragePath);
+
 private:
   PrecompiledPreamble(std::unique_ptr<PCHStorage> Storage,
                       std::vector<char> PreambleBytes,
@@ -1868,6 +1868,26 @@ bool Interpret(InterpState &S) {
   if (!PC)
     return true;
 
+#if defined(__GNUC__) || defined(__clang__)
+  // Where computed goto is available, every opcode jumps straight to the
+  // handler of the next one instead of going back through the switch. This
+  // gives each handler its own indirect branch, which predicts a lot better
+  // than the single one of the switch.
+  static void *const DispatchTable[] = {
+#define GET_INTERP_LABELS
+#include "Opcodes.inc"
+#undef GET_INTERP_LABELS
+  };
+#define INTERP_LABEL(ID) Interp_OP_##ID:
+#define INTERP_NEXT                                                            \
+  do {                                                                         \
+    Op = PC.read<Opcode>();                                                    \
+    OpPC = PC;                                                                 \
+    assert(Op < std::size(DispatchTable));                                     \
+    goto *DispatchTable[Op];                                                   \
+  } while (0)
+#endif
+
   for (;;) {
     auto Op = PC.read<Opcode>();
     CodePtr OpPC = PC;
@@ -178,6 +178,8 @@ bool DataflowAnalysisContext::flowConditionImplies(Atom Token,
                                                    const Formula &F) {
   if (F.isLiteral(true))
     return true;
+  if (ProvenImplications.contains({Token, &F}))
+    return true;
 
   // Returns true if and only if truth assignment of the flow condition implies
   // that `F` is also true. We prove whether or not this property holds by
@@ -188,26 +190,49 @@ bool DataflowAnalysisContext::flowConditionImplies(Atom Token,
   Constraints.insert(&arena().makeAtomRef(Token));
   Constraints.insert(&arena().makeNot(F));
   addTransitiveFlowConditionConstraints(Token, Constraints);
-  return isUnsatisfiable(std::move(Constraints));
+  if (!isUnsatisfiable(std::move(Constraints)))
+    return false;
+  ProvenImplications.insert({Token, &F});
+  return true;
 }
 
 bool DataflowAnalysisContext::flowConditionAllows(Atom Token,
                                                   const Formula &F) {
   if (F.isLiteral(false))
     return false;
+  if (DisprovenAllowances.contains({Token, &F}))
+    return false;
 
   llvm::SetVector<const Formula *> Constraints;
   Constraints.insert(&arena().makeAtomRef(Token));
   Constraints.insert(&F);
   addTransitiveFlowConditionConstraints(Token, Constraints);
-  return isSatisfiable(std::move(Constraints));
+  Solver::Result::Status Status =
+      querySolver(std::move(Constraints)).getStatus();
+  if (Status == Solver::Result::Status::Unsatisfiable)
+    DisprovenAllowances.insert({Token, &F});
+  return Status == Solver::Result::Status::Satisfiable;
 }
 
 bool DataflowAnalysisContext::equivalentFormulas(const Formula &Val1,
                                                  const Formula &Val2) {
+  if (&Val1 == &Val2)
+    return true;
+  if (&Val2 < &Val1)
+    return equivalentFormulas(Val2, Val1);
+  auto It = EquivalentFormulas.find({&Val1, &Val2});
+  if (It != EquivalentFormulas.end())
+    return It->second;
+
   llvm::SetVector<const Formula *> Constraints;
   Constraints.insert(&arena().makeNot(arena().makeEquals(Val1, Val2)));
-  return isUnsatisfiable(std::move(Constraints));
+  Solver::Result::Status Status =
+      querySolver(std::move(Constraints)).getStatus();
+  // A timeout may not happen again with more budget left, don't cache it.
+  if (Status != Solver::Result::Status::TimedOut)
+    EquivalentFormulas[{&Val1, &Val2}] =
+        Status == Solver::Result::Status::Unsatisfiable;
+  return Status == Solver::Result::Status::Unsatisfiable;
 }
 
 void DataflowAnalysisContext::addTransitiveFlowConditionConstraints(
@@ -47,6 +47,7 @@
 #include "llvm/IR/Intrinsics.h"
 #include "llvm/IR/Metadata.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/MD5.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SHA1.h"
@@ -56,6 +57,11 @@
 using namespace clang;
 using namespace clang::CodeGen;
 
+static llvm::cl::opt<std::string> ClDebugTypeOwnershipFile(
+    "debug-type-ownership-file", llvm::cl::Hidden,
+    llvm::cl::desc("Read the owners of the debug info of C++ types from the "
+                   "given file, see CodeGenOptions::DebugTypeOwnershipFile"));
+
 static uint32_t getTypeAlignIfRequired(const Type *Ty, const ASTContext &Ctx) {
   auto TI = Ctx.getTypeInfo(Ty);
   if (TI.isAlignRequired())
@@ -112,6 +118,11 @@ CGDebugInfo::CGDebugInfo(CodeGenModule &CGM)
       DebugTypeExtRefs(CGM.getCodeGenOpts().DebugTypeExtRefs),
       DBuilder(CGM.getModule()) {
   CreateCompileUnit();
+  StringRef OwnershipFile = CGM.getCodeGenOpts().DebugTypeOwnershipFile;
+  if (OwnershipFile.empty())
+    OwnershipFile = ClDebugTypeOwnershipFile;
+  if (!OwnershipFile.empty())
+    loadDebugTypeOwnership(OwnershipFile);
 }
 
 CGDebugInfo::~CGDebugInfo() {
@@ -2725,6 +2736,34 @@ static bool isDefinedInClangModule(const RecordDecl *RD) {
   return true;
 }
 
+void CGDebugInfo::loadDebugTypeOwnership(StringRef Path) {
+  auto BufOrErr = CGM.getFileSystem()->getBufferForFile(Path);
+  if (!BufOrErr) {
+    CGM.getDiags().Report(diag::err_cannot_open_file)
+        << Path << BufOrErr.getError().message();
+    return;
+  }
+
+  StringRef CUName = TheCU->getFilename();
+  SmallVector<StringRef, 0> Lines;
+  (*BufOrErr)->getBuffer().split(Lines, '\n', -1, /*KeepEmpty=*/false);
+  for (StringRef Line : Lines) {
+    auto [Identifier, Owner] = Line.rtrim('\r').split('\t');
+    if (!Identifier.empty() && !Owner.empty() && Owner != CUName)
+      ForeignOwnedTypes.insert(Identifier);
+  }
+}
+
+bool CGDebugInfo::isOwnedByOtherTU(const RecordDecl *RD) {
+  if (ForeignOwnedTypes.empty() ||
+      DebugKind > llvm::codegenoptions::LimitedDebugInfo ||
+      RD->hasAttr<StandaloneDebugAttr>() || !RD->isExternallyVisible())
+    return false;
+  const auto *Ty = CGM.getContext().getRecordType(RD)->castAs<RecordType>();
+  SmallString<256> Identifier = getTypeIdentifier(Ty, CGM, TheCU);
+  return !Identifier.empty() && ForeignOwnedTypes.contains(Identifier);
+}
+
 void CGDebugInfo::completeClassData(const RecordDecl *RD) {
   if (auto *CXXRD = dyn_cast<CXXRecordDecl>(RD))
     if (CXXRD->isDynamicClass() &&
@@ -2736,6 +2775,9 @@ void CGDebugInfo::completeClassData(const RecordDecl *RD) {
   if (DebugTypeExtRefs && isDefinedInClangModule(RD->getDefinition()))
     return;
 
+  if (isOwnedByOtherTU(RD))
+    return;
+
   completeClass(RD);
 }
 
@@ -2852,7 +2894,9 @@ static bool shouldOmitDefinition(llvm::codegenoptions::DebugInfoKind DebugKind,
 }
 
 void CGDebugInfo::completeRequiredType(const RecordDecl *RD) {
-  if (shouldOmitDefinition(DebugKind, DebugTypeExtRefs, RD, CGM.getLangOpts()))
+  if (shouldOmitDefinition(DebugKind, DebugTypeExtRefs, RD,
+                           CGM.getLangOpts()) ||
+      isOwnedByOtherTU(RD))
     return;
 
   QualType Ty = CGM.getContext().getRecordType(RD);
@@ -2864,8 +2908,10 @@ void CGDebugInfo::completeRequiredType(const RecordDecl *RD) {
 llvm::DIType *CGDebugInfo::CreateType(const RecordType *Ty) {
   RecordDecl *RD = Ty->getDecl();
   llvm::DIType *T = cast_or_null<llvm::DIType>(getTypeOrNull(QualType(Ty, 0)));
-  if (T || shouldOmitDefinition(DebugKind, DebugTypeExtRefs, RD,
-                                CGM.getLangOpts())) {
+  if (T ||
+      shouldOmitDefinition(DebugKind, DebugTypeExtRefs, RD,
+                           CGM.getLangOpts()) ||
+      isOwnedByOtherTU(RD)) {
     if (!T)
       T = getOrCreateRecordFwdDecl(Ty, getDeclContextDescriptor(RD));
     return T;
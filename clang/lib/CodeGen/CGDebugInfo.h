@@ -25,6 +25,7 @@
 #include "clang/Basic/SourceLocation.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/IR/DIBuilder.h"
 #include "llvm/IR/DebugInfo.h"
 #include "llvm/IR/ValueHandle.h"
@@ -95,6 +96,10 @@ class CGDebugInfo {
   /// Cache of previously constructed Types.
   llvm::DenseMap<const void *, llvm::TrackingMDRef> TypeCache;
 
+  /// Identifiers of the types whose definitions are owned by another
+  /// translation unit, see CodeGenOptions::DebugTypeOwnershipFile.
+  llvm::StringSet<> ForeignOwnedTypes;
+
   /// Cache that maps VLA types to size expressions for that type,
   /// represented by instantiated Metadata nodes.
   llvm::SmallDenseMap<QualType, llvm::Metadata *> SizeExprCache;
@@ -705,6 +710,14 @@ private:
   /// Get the type from the cache or create a new type if necessary.
   llvm::DIType *getOrCreateType(QualType Ty, llvm::DIFile *Fg);
 
+  /// Read a type ownership file, see CodeGenOptions::DebugTypeOwnershipFile,
+  /// into ForeignOwnedTypes.
+  void loadDebugTypeOwnership(StringRef Path);
+
+  /// Return true if the debug info definition of \p RD is emitted by another
+  /// translation unit according to the type ownership file.
+  bool isOwnedByOtherTU(const RecordDecl *RD);
+
   /// Get a reference to a clang module.  If \p CreateSkeletonCU is true,
   /// this also creates a split dwarf skeleton compile unit.
   llvm::DIModule *getOrCreateModuleRef(ASTSourceDescriptor Mod,
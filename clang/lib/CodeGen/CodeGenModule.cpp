@@ -4227,12 +4227,21 @@ void CodeGenModule::EmitGlobalDefinition(GlobalDecl GD, llvm::GlobalValue *GV) {
     if (!shouldEmitFunction(GD))
       return;
 
+    // Record where the function is defined so that IRGen time can be
+    // attributed to the header that contains it. For template
+    // specializations this is the location of the pattern.
     llvm::TimeTraceScope TimeScope("CodeGen Function", [&]() {
-      std::string Name;
-      llvm::raw_string_ostream OS(Name);
+      llvm::TimeTraceMetadata M;
+      llvm::raw_string_ostream OS(M.Detail);
       FD->getNameForDiagnostic(OS, getContext().getPrintingPolicy(),
                                /*Qualified=*/true);
-      return Name;
+      PresumedLoc PLoc =
+          getContext().getSourceManager().getPresumedLoc(FD->getLocation());
+      if (PLoc.isValid()) {
+        M.File = PLoc.getFilename();
+        M.Line = PLoc.getLine();
+      }
+      return M;
     });
 
     if (const auto *Method = dyn_cast<CXXMethodDecl>(D)) {
@@ -14,18 +14,24 @@
 #include "clang/AST/Decl.h"
 #include "clang/AST/ParentMapContext.h"
 #include "clang/Basic/TargetInfo.h"
+#include "clang/Basic/Version.h"
 #include "clang/CrossTU/CrossTUDiagnostic.h"
 #include "clang/Frontend/ASTUnit.h"
 #include "clang/Frontend/CompilerInstance.h"
 #include "clang/Frontend/TextDiagnosticPrinter.h"
 #include "clang/Index/USRGeneration.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Option/ArgList.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/YAMLParser.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include "llvm/TargetParser/Triple.h"
 #include <algorithm>
 #include <fstream>
@@ -55,6 +61,21 @@ STATISTIC(NumLangMismatch, "The # of language mismatches");
 STATISTIC(NumLangDialectMismatch, "The # of language dialect mismatches");
 STATISTIC(NumASTLoadThresholdReached,
           "The # of ASTs not loaded because of threshold");
+STATISTIC(NumASTCacheHits,
+          "The # of on-demand parsed ASTs loaded from the AST cache");
+STATISTIC(NumASTCacheStores,
+          "The # of on-demand parsed ASTs stored in the AST cache");
+
+static llvm::cl::opt<std::string> CTUASTCacheDir(
+    "ctu-ast-cache-dir",
+    llvm::cl::desc("Share the ASTs parsed on-demand for CTU analysis with "
+                   "other analyzer processes through this directory"));
+
+static llvm::cl::opt<std::string> CTUASTCachePolicy(
+    "ctu-ast-cache-policy",
+    llvm::cl::desc("Pruning policy of the CTU AST cache, in the format "
+                   "accepted by parseCachePruningPolicy, e.g. "
+                   "'cache_size_bytes=8g:prune_after=24h'"));
 
 // Same as Triple's equality operator, but we check a field only if that is
 // known in both instances.
@@ -533,7 +554,18 @@ llvm::Expected<ASTUnit *> CrossTranslationUnitContext::loadExternalAST(
 
 CrossTranslationUnitContext::ASTLoader::ASTLoader(
     CompilerInstance &CI, StringRef CTUDir, StringRef InvocationListFilePath)
-    : CI(CI), CTUDir(CTUDir), InvocationListFilePath(InvocationListFilePath) {}
+    : CI(CI), CTUDir(CTUDir), InvocationListFilePath(InvocationListFilePath),
+      ASTCacheDir(CTUASTCacheDir) {
+  if (ASTCacheDir.empty())
+    return;
+  llvm::Expected<llvm::CachePruningPolicy> Policy =
+      llvm::parseCachePruningPolicy(CTUASTCachePolicy);
+  if (Policy)
+    ASTCachePolicy = *Policy;
+  else
+    CI.getDiagnostics().Report(diag::warn_ctu_ast_cache_policy)
+        << CTUASTCachePolicy << llvm::toString(Policy.takeError());
+}
 
 CrossTranslationUnitContext::LoadResultTy
 CrossTranslationUnitContext::ASTLoader::load(StringRef Identifier) {
@@ -603,6 +635,38 @@ CrossTranslationUnitContext::ASTLoader::loadFromSource(
                  CommandLineArgs.begin(),
                  [](auto &&CmdPart) { return CmdPart.c_str(); });
 
+  // The AST cache is keyed by everything needed to reproduce the parse, so
+  // processes analyzing different TUs of the same project share the ASTs of
+  // the TUs they import from. The reader validates a cached AST against its
+  // input files, so edited sources are parsed again.
+  SmallString<256> CachePath;
+  if (!ASTCacheDir.empty()) {
+    std::string Key = getClangFullVersion();
+    auto Add = [&](StringRef Part) {
+      Key += '\0';
+      Key += Part;
+    };
+    SmallString<256> WorkingDir;
+    if (!llvm::sys::fs::current_path(WorkingDir))
+      Add(WorkingDir);
+    Add(CI.getHeaderSearchOpts().ResourceDir);
+    for (const std::string &Arg : InvocationCommand)
+      Add(Arg);
+    llvm::XXH128_hash_t Hash =
+        llvm::xxh3_128bits(llvm::arrayRefFromStringRef(Key));
+    // pruneCache only considers files with the "llvmcache-" prefix.
+    CachePath = ASTCacheDir;
+    llvm::sys::path::append(
+        CachePath, "llvmcache-" +
+                       llvm::utohexstr(Hash.high64, /*LowerCase=*/true, 16) +
+                       llvm::utohexstr(Hash.low64, /*LowerCase=*/true, 16) +
+                       ".ast");
+    if (std::unique_ptr<ASTUnit> Unit = loadFromCache(CachePath)) {
+      ++NumASTCacheHits;
+      return std::move(Unit);
+    }
+  }
+
   IntrusiveRefCntPtr<DiagnosticOptions> DiagOpts{&CI.getDiagnosticOpts()};
   auto *DiagClient = new ForwardingDiagnosticConsumer{CI.getDiagnosticClient()};
   IntrusiveRefCntPtr<DiagnosticIDs> DiagID{
@@ -610,10 +674,59 @@ CrossTranslationUnitContext::ASTLoader::loadFromSource(
   IntrusiveRefCntPtr<DiagnosticsEngine> Diags(
       new DiagnosticsEngine{DiagID, &*DiagOpts, DiagClient});
 
-  return ASTUnit::LoadFromCommandLine(CommandLineArgs.begin(),
-                                      (CommandLineArgs.end()),
-                                      CI.getPCHContainerOperations(), Diags,
-                                      CI.getHeaderSearchOpts().ResourceDir);
+  std::unique_ptr<ASTUnit> Unit = ASTUnit::LoadFromCommandLine(
+      CommandLineArgs.begin(), (CommandLineArgs.end()),
+      CI.getPCHContainerOperations(), Diags,
+      CI.getHeaderSearchOpts().ResourceDir);
+  if (Unit && !CachePath.empty())
+    storeInCache(*Unit, CachePath);
+  return std::move(Unit);
+}
+
+std::unique_ptr<ASTUnit>
+CrossTranslationUnitContext::ASTLoader::loadFromCache(StringRef CachePath) {
+  if (!llvm::sys::fs::exists(CachePath))
+    return nullptr;
+
+  // A stale entry is expected after its sources change, so the reader must not
+  // complain about it. Diagnostics are forwarded once the AST is in use.
+  IntrusiveRefCntPtr<DiagnosticOptions> DiagOpts{&CI.getDiagnosticOpts()};
+  IntrusiveRefCntPtr<DiagnosticIDs> DiagID{
+      CI.getDiagnostics().getDiagnosticIDs()};
+  IntrusiveRefCntPtr<DiagnosticsEngine> Diags(
+      new DiagnosticsEngine{DiagID, &*DiagOpts, new IgnoringDiagConsumer()});
+  std::unique_ptr<ASTUnit> Unit = ASTUnit::LoadFromASTFile(
+      CachePath, CI.getPCHContainerOperations()->getRawReader(),
+      ASTUnit::LoadEverything, Diags, CI.getFileSystemOpts(),
+      CI.getHeaderSearchOptsPtr());
+  if (!Unit)
+    return nullptr;
+  Diags->setClient(
+      new ForwardingDiagnosticConsumer{CI.getDiagnosticClient()});
+
+  // pruneCache evicts the least recently accessed entries first, and the
+  // access time is not reliably updated by reading the file.
+  int FD;
+  if (!llvm::sys::fs::openFileForRead(CachePath, FD)) {
+    llvm::sys::fs::setLastAccessAndModificationTime(
+        FD, std::chrono::system_clock::now());
+    llvm::sys::Process::SafelyCloseFileDescriptor(FD);
+  }
+  return Unit;
+}
+
+void CrossTranslationUnitContext::ASTLoader::storeInCache(
+    ASTUnit &Unit, StringRef CachePath) {
+  // An AST with errors could not be loaded again.
+  if (Unit.getDiagnostics().hasErrorOccurred())
+    return;
+  if (llvm::sys::fs::create_directories(ASTCacheDir))
+    return;
+  // ASTUnit::Save writes to a temporary file which is renamed into place, so
+  // other processes never load a partially written AST.
+  if (!Unit.Save(CachePath))
+    ++NumASTCacheStores;
+  llvm::pruneCache(ASTCacheDir, ASTCachePolicy);
 }
 
 llvm::Expected<InvocationListTy>
@@ -13,6 +13,7 @@
 #include "clang/Frontend/PrecompiledPreamble.h"
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/LangStandard.h"
+#include "clang/Basic/Version.h"
 #include "clang/Frontend/CompilerInstance.h"
 #include "clang/Frontend/CompilerInvocation.h"
 #include "clang/Frontend/FrontendActions.h"
@@ -27,8 +28,10 @@
 #include "llvm/ADT/iterator_range.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/Support/CrashRecoveryContext.h"
+#include "llvm/Support/EndianStream.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Support/VirtualFileSystem.h"
@@ -723,6 +726,166 @@ void PrecompiledPreamble::OverridePreamble(
   configurePreamble(Bounds, CI, VFS, MainFileBuffer);
 }
 
+// Saved preambles start with this magic, followed by PreambleEndsAtStartOfLine,
+// PreambleBytes, FilesInPreamble, MissingFiles and finally the PCH itself.
+// Strings and arrays are prefixed with their size; integers are little-endian.
+static constexpr llvm::StringLiteral SavedPreambleMagic = "CLANG-PREAMBLE-1";
+
+std::string
+PrecompiledPreamble::getCacheKey(const CompilerInvocation &Invocation,
+                                 const llvm::MemoryBufferRef &MainFileBuffer,
+                                 PreambleBounds Bounds) {
+  assert(Bounds.Size <= MainFileBuffer.getBufferSize());
+  llvm::MD5 Hash;
+  auto AddString = [&](StringRef S) {
+    Hash.update(S);
+    Hash.update(StringRef("\0", 1));
+  };
+  AddString(getClangFullRepositoryVersion());
+  Invocation.generateCC1CommandLine(
+      [&](const llvm::Twine &Arg) { AddString(Arg.str()); });
+  AddString(MainFileBuffer.getBuffer().take_front(Bounds.Size));
+  AddString(Bounds.PreambleEndsAtStartOfLine ? "1" : "0");
+
+  llvm::MD5::MD5Result Result;
+  Hash.final(Result);
+  return std::string(Result.digest());
+}
+
+llvm::Error PrecompiledPreamble::save(StringRef Path) const {
+  std::unique_ptr<llvm::MemoryBuffer> TempPCH;
+  StringRef PCH;
+  if (Storage->getKind() == PCHStorage::Kind::InMemory) {
+    PCH = Storage->memoryContents();
+  } else {
+    auto BufOrErr = llvm::MemoryBuffer::getFile(
+        Storage->filePath(), /*IsText=*/false,
+        /*RequiresNullTerminator=*/false);
+    if (!BufOrErr)
+      return llvm::createFileError(Storage->filePath(), BufOrErr.getError());
+    TempPCH = std::move(*BufOrErr);
+    PCH = TempPCH->getBuffer();
+  }
+
+  return llvm::writeToOutput(Path, [&](llvm::raw_ostream &OS) {
+    llvm::support::endian::Writer W(OS, llvm::endianness::little);
+    auto WriteString = [&](StringRef S) {
+      W.write<uint64_t>(S.size());
+      OS << S;
+    };
+    OS << SavedPreambleMagic;
+    W.write<uint8_t>(PreambleEndsAtStartOfLine);
+    WriteString(getContents());
+    W.write<uint64_t>(FilesInPreamble.size());
+    for (const auto &F : FilesInPreamble) {
+      WriteString(F.first());
+      W.write<int64_t>(F.second.Size);
+      W.write<int64_t>(F.second.ModTime);
+      OS.write(reinterpret_cast<const char *>(F.second.MD5.data()),
+               F.second.MD5.size());
+    }
+    W.write<uint64_t>(MissingFiles.size());
+    for (const auto &F : MissingFiles)
+      WriteString(F.getKey());
+    WriteString(PCH);
+    return llvm::Error::success();
+  });
+}
+
+llvm::ErrorOr<PrecompiledPreamble>
+PrecompiledPreamble::load(StringRef Path, bool StoreInMemory,
+                          StringRef StoragePath) {
+  auto BufOrErr =
+      llvm::MemoryBuffer::getFile(Path, /*IsText=*/false,
+                                  /*RequiresNullTerminator=*/false);
+  if (!BufOrErr)
+    return BufOrErr.getError();
+  StringRef Data = (*BufOrErr)->getBuffer();
+
+  // All reads are bounds-checked, a truncated or corrupt file just fails to
+  // load.
+  bool Malformed = false;
+  auto ReadInt = [&](auto &Value) {
+    using T = std::remove_reference_t<decltype(Value)>;
+    if (Malformed || Data.size() < sizeof(T)) {
+      Malformed = true;
+      Value = 0;
+      return;
+    }
+    Value = llvm::support::endian::read<T>(Data.data(),
+                                           llvm::endianness::little);
+    Data = Data.drop_front(sizeof(T));
+  };
+  auto ReadString = [&]() {
+    uint64_t Size;
+    ReadInt(Size);
+    if (Malformed || Data.size() < Size) {
+      Malformed = true;
+      return StringRef();
+    }
+    StringRef S = Data.take_front(Size);
+    Data = Data.drop_front(Size);
+    return S;
+  };
+
+  if (!Data.consume_front(SavedPreambleMagic))
+    return std::make_error_code(std::errc::illegal_byte_sequence);
+  uint8_t EndsAtStartOfLine;
+  ReadInt(EndsAtStartOfLine);
+  StringRef Contents = ReadString();
+
+  llvm::StringMap<PreambleFileHash> FilesInPreamble;
+  uint64_t NumFiles;
+  ReadInt(NumFiles);
+  for (uint64_t I = 0; I != NumFiles && !Malformed; ++I) {
+    StringRef Name = ReadString();
+    int64_t Size, ModTime;
+    ReadInt(Size);
+    ReadInt(ModTime);
+    PreambleFileHash Hash;
+    Hash.Size = Size;
+    Hash.ModTime = ModTime;
+    for (uint8_t &B : Hash.MD5)
+      ReadInt(B);
+    FilesInPreamble[Name] = Hash;
+  }
+
+  llvm::StringSet<> MissingFiles;
+  uint64_t NumMissing;
+  ReadInt(NumMissing);
+  for (uint64_t I = 0; I != NumMissing && !Malformed; ++I)
+    MissingFiles.insert(ReadString());
+
+  StringRef PCH = ReadString();
+  if (Malformed || !Data.empty())
+    return std::make_error_code(std::errc::illegal_byte_sequence);
+
+  std::unique_ptr<PCHStorage> Storage;
+  if (StoreInMemory) {
+    auto Buffer = std::make_shared<PCHBuffer>();
+    Buffer->Data.assign(PCH.begin(), PCH.end());
+    Buffer->IsComplete = true;
+    Storage = PCHStorage::inMemory(std::move(Buffer));
+  } else {
+    std::unique_ptr<TempPCHFile> File = TempPCHFile::create(StoragePath);
+    if (!File)
+      return BuildPreambleError::CouldntCreateTempFile;
+    std::error_code EC;
+    llvm::raw_fd_ostream OS(File->getFilePath(), EC);
+    if (EC)
+      return EC;
+    OS << PCH;
+    OS.close();
+    if (OS.has_error())
+      return OS.error();
+    Storage = PCHStorage::file(std::move(File));
+  }
+
+  return PrecompiledPreamble(
+      std::move(Storage), std::vector<char>(Contents.begin(), Contents.end()),
+      EndsAtStartOfLine, std::move(FilesInPreamble), std::move(MissingFiles));
+}
+
 PrecompiledPreamble::PrecompiledPreamble(
     std::unique_ptr<PCHStorage> Storage, std::vector<char> PreambleBytes,
     bool PreambleEndsAtStartOfLine,
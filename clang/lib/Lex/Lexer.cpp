@@ -48,6 +48,8 @@
 
 #ifdef __SSE4_2__
 #include <nmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
 #endif
 
 using namespace clang;
@@ -1946,6 +1948,34 @@ fastParseASCIIIdentifier(const char *CurPtr,
       continue;
     return CurPtr;
   }
+#elif defined(__SSE2__)
+  // Without pcmpistri, classify 16 bytes at a time with signed compares. Bytes
+  // >= 0x80 are negative and so never fall in one of the ASCII ranges.
+  constexpr ssize_t BytesPerRegister = 16;
+  const __m128i Underscore = _mm_set1_epi8('_');
+  const __m128i LowerCaseBit = _mm_set1_epi8(0x20);
+  const __m128i BeforeA = _mm_set1_epi8('a' - 1);
+  const __m128i AfterZ = _mm_set1_epi8('z' + 1);
+  const __m128i Before0 = _mm_set1_epi8('0' - 1);
+  const __m128i After9 = _mm_set1_epi8('9' + 1);
+
+  while (LLVM_LIKELY(BufferEnd - CurPtr >= BytesPerRegister)) {
+    __m128i Cv = _mm_loadu_si128((const __m128i *)(CurPtr));
+    // Setting bit 5 maps 'A'-'Z' onto 'a'-'z' and nothing else onto 'a'-'z'.
+    __m128i Lower = _mm_or_si128(Cv, LowerCaseBit);
+    __m128i IsAlpha = _mm_and_si128(_mm_cmpgt_epi8(Lower, BeforeA),
+                                    _mm_cmpgt_epi8(AfterZ, Lower));
+    __m128i IsDigit = _mm_and_si128(_mm_cmpgt_epi8(Cv, Before0),
+                                    _mm_cmpgt_epi8(After9, Cv));
+    __m128i IsIdent = _mm_or_si128(_mm_or_si128(IsAlpha, IsDigit),
+                                   _mm_cmpeq_epi8(Cv, Underscore));
+    unsigned Mask = ~unsigned(_mm_movemask_epi8(IsIdent)) & 0xFFFF;
+    if (Mask == 0) {
+      CurPtr += BytesPerRegister;
+      continue;
+    }
+    return CurPtr + llvm::countr_zero(Mask);
+  }
 #endif
 
   unsigned char C = *CurPtr;
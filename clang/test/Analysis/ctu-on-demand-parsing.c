@@ -19,6 +19,26 @@
 // RUN:   -analyzer-config ctu-phase1-inlining=all \
 // RUN:   -verify ctu-on-demand-parsing.c
 //
+// The second analysis loads the AST stored in the AST cache by the first one.
+// RUN: cd "%t" && %clang_cc1 -std=c89 -analyze \
+// RUN:   -analyzer-checker=core,debug.ExprInspection \
+// RUN:   -analyzer-config experimental-enable-naive-ctu-analysis=true \
+// RUN:   -analyzer-config ctu-dir=. \
+// RUN:   -analyzer-config ctu-invocation-list=invocations.yaml \
+// RUN:   -analyzer-config ctu-phase1-inlining=all \
+// RUN:   -mllvm -ctu-ast-cache-dir=%t/ast-cache \
+// RUN:   -verify ctu-on-demand-parsing.c
+// RUN: ls %t/ast-cache | FileCheck --check-prefix=AST-CACHE %s
+// RUN: cd "%t" && %clang_cc1 -std=c89 -analyze \
+// RUN:   -analyzer-checker=core,debug.ExprInspection \
+// RUN:   -analyzer-config experimental-enable-naive-ctu-analysis=true \
+// RUN:   -analyzer-config ctu-dir=. \
+// RUN:   -analyzer-config ctu-invocation-list=invocations.yaml \
+// RUN:   -analyzer-config ctu-phase1-inlining=all \
+// RUN:   -mllvm -ctu-ast-cache-dir=%t/ast-cache \
+// RUN:   -verify ctu-on-demand-parsing.c
+// AST-CACHE: llvmcache-{{[0-9a-f]+}}.ast
+//
 // FIXME: On-demand ctu should be tested in the same file that we have for the
 // PCH version, but with a different verify prefix (e.g. -verfiy=on-demand-ctu)
 //
@@ -0,0 +1,38 @@
+// Check that with limited debug info, the types that a type ownership file
+// assigns to another translation unit are only declared.
+
+// RUN: rm -rf %t && split-file %s %t && cd %t
+// RUN: %clang_cc1 -triple x86_64-linux-gnu -emit-llvm -debug-info-kind=limited \
+// RUN:   -mllvm -debug-type-ownership-file=owners.txt -main-file-name a.cpp \
+// RUN:   a.cpp -o - | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-linux-gnu -emit-llvm -debug-info-kind=standalone \
+// RUN:   -mllvm -debug-type-ownership-file=owners.txt -main-file-name a.cpp \
+// RUN:   a.cpp -o - | FileCheck --check-prefix=FULL %s
+// RUN: not %clang_cc1 -triple x86_64-linux-gnu -emit-llvm -debug-info-kind=limited \
+// RUN:   -mllvm -debug-type-ownership-file=missing.txt -main-file-name a.cpp \
+// RUN:   a.cpp -o /dev/null 2>&1 | FileCheck --check-prefix=MISSING %s
+
+// CHECK-DAG: !DICompositeType(tag: DW_TAG_structure_type, name: "Owned",{{.*}} flags: DIFlagFwdDecl, identifier: "_ZTS5Owned")
+// CHECK-DAG: !DICompositeType(tag: DW_TAG_structure_type, name: "Mine",{{.*}} elements: {{.*}}, identifier: "_ZTS4Mine")
+// CHECK-DAG: !DICompositeType(tag: DW_TAG_structure_type, name: "Unlisted",{{.*}} elements: {{.*}}, identifier: "_ZTS8Unlisted")
+// CHECK-DAG: !DICompositeType(tag: DW_TAG_structure_type, name: "Standalone",{{.*}} elements: {{.*}}, identifier: "_ZTS10Standalone")
+
+// FULL-DAG: !DICompositeType(tag: DW_TAG_structure_type, name: "Owned",{{.*}} elements: {{.*}}, identifier: "_ZTS5Owned")
+
+// MISSING: cannot open file 'missing.txt'
+
+//--- owners.txt
+_ZTS5Owned	b.cpp
+_ZTS4Mine	a.cpp
+_ZTS10Standalone	b.cpp
+
+//--- a.cpp
+struct Owned { int x; };
+struct Mine { int x; };
+struct Unlisted { int x; };
+struct __attribute__((standalone_debug)) Standalone { int x; };
+
+Owned owned;
+Mine mine;
+Unlisted unlisted;
+Standalone standalone;
@@ -171,4 +171,46 @@ TEST_F(DataflowAnalysisContextTest, EquivBoolVals) {
                                          A.makeAnd(X, A.makeAnd(Y, Z))));
 }
 
+class CountingSolver : public Solver {
+public:
+  Result solve(llvm::ArrayRef<const Formula *> Vals) override {
+    ++Calls;
+    return Inner.solve(Vals);
+  }
+  bool reachedLimit() const override { return Inner.reachedLimit(); }
+
+  WatchedLiteralsSolver Inner;
+  unsigned Calls = 0;
+};
+
+TEST(DataflowAnalysisContextCacheTest, RepeatedQueriesAreCached) {
+  CountingSolver S;
+  DataflowAnalysisContext Context(S);
+  Arena &A = Context.arena();
+  auto &X = A.makeAtomRef(A.makeAtom());
+  auto &Y = A.makeAtomRef(A.makeAtom());
+  Atom FC = A.makeFlowConditionToken();
+  Context.addFlowConditionConstraint(FC, X);
+
+  EXPECT_TRUE(Context.flowConditionImplies(FC, X));
+  EXPECT_FALSE(Context.flowConditionAllows(FC, A.makeNot(X)));
+  EXPECT_FALSE(Context.flowConditionImplies(FC, Y));
+  EXPECT_EQ(S.Calls, 3u);
+
+  // Proven implications and disproven allowances are cached.
+  EXPECT_TRUE(Context.flowConditionImplies(FC, X));
+  EXPECT_FALSE(Context.flowConditionAllows(FC, A.makeNot(X)));
+  EXPECT_EQ(S.Calls, 3u);
+
+  // Other results may change once constraints are added.
+  Context.addFlowConditionConstraint(FC, Y);
+  EXPECT_TRUE(Context.flowConditionImplies(FC, Y));
+  EXPECT_EQ(S.Calls, 4u);
+
+  auto &NotNots = A.makeNot(A.makeOr(A.makeNot(X), A.makeNot(Y)));
+  EXPECT_TRUE(Context.equivalentFormulas(A.makeAnd(X, Y), NotNots));
+  EXPECT_TRUE(Context.equivalentFormulas(NotNots, A.makeAnd(X, Y)));
+  EXPECT_EQ(S.Calls, 5u);
+}
+
 } // namespace
@@ -11,6 +11,7 @@
 #include "clang/Frontend/CompilerInstance.h"
 #include "clang/Frontend/FrontendActions.h"
 #include "clang/Frontend/FrontendOptions.h"
+#include "clang/Frontend/PrecompiledPreamble.h"
 #include "clang/Lex/PreprocessorOptions.h"
 #include "clang/Basic/Diagnostic.h"
 #include "clang/Basic/FileManager.h"
@@ -267,4 +268,104 @@ TEST_F(PCHPreambleTest, ParseWithBom) {
   ASSERT_LE(HeaderReadCount, GetFileReadCount(Header));
 }
 
+
+TEST(PrecompiledPreambleTest, SaveAndLoad) {
+  SmallString<128> TestDir;
+  ASSERT_FALSE(sys::fs::createUniqueDirectory("preamble-test", TestDir));
+  SmallString<128> SavedPath(TestDir);
+  sys::path::append(SavedPath, "saved.preamble");
+
+  IntrusiveRefCntPtr<vfs::InMemoryFileSystem> VFS(new vfs::InMemoryFileSystem);
+  VFS->setCurrentWorkingDirectory("//./");
+  std::string Header = "//./header.h";
+  std::string MainName = "//./main.cpp";
+  std::string MainContents = "#include \"//./header.h\"\n"
+                             "int main() { return ZERO; }\n";
+  VFS->addFile(Header, 0, MemoryBuffer::getMemBufferCopy("#define ZERO 0\n"));
+  VFS->addFile(MainName, 0, MemoryBuffer::getMemBufferCopy(MainContents));
+
+  auto CreateInvocation = [&] {
+    auto CI = std::make_shared<CompilerInvocation>();
+    CI->getFrontendOpts().Inputs.push_back(
+        FrontendInputFile(MainName, InputKind(Language::CXX)));
+    CI->getTargetOpts().Triple = "i386-unknown-linux-gnu";
+    return CI;
+  };
+  std::shared_ptr<CompilerInvocation> CI = CreateInvocation();
+  std::unique_ptr<MemoryBuffer> MainBuffer =
+      MemoryBuffer::getMemBufferCopy(MainContents, MainName);
+  PreambleBounds Bounds =
+      ComputePreambleBounds(CI->getLangOpts(), *MainBuffer, 0);
+
+  IntrusiveRefCntPtr<DiagnosticsEngine> Diags(
+      CompilerInstance::createDiagnostics(*VFS, new DiagnosticOptions,
+                                          new DiagnosticConsumer));
+  PreambleCallbacks Callbacks;
+  llvm::ErrorOr<PrecompiledPreamble> Built = PrecompiledPreamble::Build(
+      *CI, MainBuffer.get(), Bounds, *Diags, VFS,
+      std::make_shared<PCHContainerOperations>(), /*StoreInMemory=*/true,
+      /*StoragePath=*/"", Callbacks);
+  ASSERT_TRUE(Built);
+  ASSERT_FALSE(Diags->hasErrorOccurred());
+  ASSERT_FALSE(llvm::errorToBool(Built->save(SavedPath)));
+
+  // Both kinds of storage restore the preamble, and its files are unchanged.
+  for (bool StoreInMemory : {true, false}) {
+    llvm::ErrorOr<PrecompiledPreamble> Loaded =
+        PrecompiledPreamble::load(SavedPath, StoreInMemory, TestDir);
+    ASSERT_TRUE(Loaded);
+    EXPECT_EQ(Loaded->getContents(), Built->getContents());
+    EXPECT_EQ(Loaded->getBounds().Size, Built->getBounds().Size);
+    EXPECT_EQ(Loaded->getSize(), Built->getSize());
+    EXPECT_TRUE(Loaded->CanReuse(*CI, *MainBuffer, Bounds, *VFS));
+  }
+
+  // The loaded PCH provides the macro of the header.
+  llvm::ErrorOr<PrecompiledPreamble> Loaded =
+      PrecompiledPreamble::load(SavedPath, /*StoreInMemory=*/true, "");
+  ASSERT_TRUE(Loaded);
+  {
+    std::shared_ptr<CompilerInvocation> ParseCI = CreateInvocation();
+    IntrusiveRefCntPtr<vfs::FileSystem> FS = VFS;
+    std::unique_ptr<MemoryBuffer> Buffer =
+        MemoryBuffer::getMemBufferCopy(MainContents, MainName);
+    Loaded->AddImplicitPreamble(*ParseCI, FS, Buffer.get());
+    auto Clang = std::make_unique<CompilerInstance>(
+        std::make_shared<PCHContainerOperations>());
+    Clang->setInvocation(std::move(ParseCI));
+    Clang->setDiagnostics(Diags.get());
+    Clang->createFileManager(FS);
+    ASSERT_TRUE(Clang->createTarget());
+    // The preprocessor takes ownership of the remapped main file.
+    Buffer.release();
+    SyntaxOnlyAction Action;
+    EXPECT_TRUE(Clang->ExecuteAction(Action));
+    EXPECT_FALSE(Diags->hasErrorOccurred());
+  }
+
+  // A loaded preamble is invalidated by changes to its files like any other.
+  VFS = new vfs::InMemoryFileSystem;
+  VFS->setCurrentWorkingDirectory("//./");
+  VFS->addFile(Header, 0,
+               MemoryBuffer::getMemBufferCopy("#define ZERO (1 - 1)\n"));
+  VFS->addFile(MainName, 0, MemoryBuffer::getMemBufferCopy(MainContents));
+  EXPECT_FALSE(Loaded->CanReuse(*CI, *MainBuffer, Bounds, *VFS));
+
+  // A truncated file fails to load.
+  {
+    auto SavedOrErr = MemoryBuffer::getFile(SavedPath);
+    ASSERT_TRUE(SavedOrErr);
+    std::string Truncated = (*SavedOrErr)->getBuffer().drop_back(1).str();
+    SavedOrErr->reset();
+    std::error_code EC;
+    raw_fd_ostream OS(SavedPath, EC);
+    ASSERT_FALSE(EC);
+    OS << Truncated;
+  }
+  EXPECT_FALSE(
+      PrecompiledPreamble::load(SavedPath, /*StoreInMemory=*/true, ""));
+
+  sys::fs::remove_directories(TestDir);
+}
+
 } // anonymous namespace
@@ -37,6 +37,9 @@ private:
   /// Emits the switch case and the invocation in the interpreter.
   void EmitInterp(raw_ostream &OS, StringRef N, const Record *R);
 
+  /// Emits the dispatch table entry for the threaded interpreter.
+  void EmitLabels(raw_ostream &OS, StringRef N, const Record *R);
+
   /// Emits the disassembler.
   void EmitDisasm(raw_ostream &OS, StringRef N, const Record *R);
 
@@ -84,6 +87,17 @@ void Enumerate(const Record *R, StringRef N,
 } // namespace
 
 void ClangOpcodesEmitter::run(raw_ostream &OS) {
+  // The interpreter cases are a plain switch unless the includer provides a
+  // label for each case and a way to dispatch to the next opcode.
+  OS << "#ifdef GET_INTERP\n";
+  OS << "#ifndef INTERP_LABEL\n";
+  OS << "#define INTERP_LABEL(ID)\n";
+  OS << "#endif\n";
+  OS << "#ifndef INTERP_NEXT\n";
+  OS << "#define INTERP_NEXT continue\n";
+  OS << "#endif\n";
+  OS << "#endif\n";
+
   for (const auto *Opcode : Records.getAllDerivedDefinitions("Opcode")) {
     // The name is the record name, unless overriden.
     StringRef N = Opcode->getValueAsString("Name");
@@ -92,12 +106,18 @@ void ClangOpcodesEmitter::run(raw_ostream &OS) {
 
     EmitEnum(OS, N, Opcode);
     EmitInterp(OS, N, Opcode);
+    EmitLabels(OS, N, Opcode);
     EmitDisasm(OS, N, Opcode);
     EmitProto(OS, N, Opcode);
     EmitGroup(OS, N, Opcode);
     EmitEmitter(OS, N, Opcode);
     EmitEval(OS, N, Opcode);
   }
+
+  OS << "#ifdef GET_INTERP\n";
+  OS << "#undef INTERP_LABEL\n";
+  OS << "#undef INTERP_NEXT\n";
+  OS << "#endif\n";
 }
 
 void ClangOpcodesEmitter::EmitEnum(raw_ostream &OS, StringRef N,
@@ -119,7 +139,8 @@ void ClangOpcodesEmitter::EmitInterp(raw_ostream &OS, StringRef N,
               bool ChangesPC = R->getValueAsBit("ChangesPC");
               const auto &Args = R->getValueAsListOfDefs("Args");
 
-              OS << "case OP_" << ID << ": {\n";
+              OS << "case OP_" << ID << ":\n";
+              OS << "INTERP_LABEL(" << ID << ") {\n";
 
               if (CanReturn)
                 OS << "  bool DoReturn = (S.Current == StartFrame);\n";
@@ -160,12 +181,21 @@ void ClangOpcodesEmitter::EmitInterp(raw_ostream &OS, StringRef N,
                 OS << "    return true;\n";
               }
 
-              OS << "  continue;\n";
+              OS << "  INTERP_NEXT;\n";
               OS << "}\n";
             });
   OS << "#endif\n";
 }
 
+void ClangOpcodesEmitter::EmitLabels(raw_ostream &OS, StringRef N,
+                                     const Record *R) {
+  OS << "#ifdef GET_INTERP_LABELS\n";
+  Enumerate(R, N, [&OS](ArrayRef<const Record *>, const Twine &ID) {
+    OS << "&&Interp_OP_" << ID << ",\n";
+  });
+  OS << "#endif\n";
+}
+
 void ClangOpcodesEmitter::EmitDisasm(raw_ostream &OS, StringRef N,
                                      const Record *R) {
   OS << "#ifdef GET_DISASM\n";
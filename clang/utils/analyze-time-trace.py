@@ -0,0 +1,242 @@
+#!/usr/bin/env python3
+#
+# ==------------------------------------------------------------------------==#
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+# ==------------------------------------------------------------------------==#
+"""Aggregate clang -ftime-trace output into a build-wide cost ranking.
+
+Reads the JSON traces written by -ftime-trace for any number of translation
+units and attributes the time spent in each phase to the responsible header,
+template specialization and function:
+
+  headers    "Source" events (parsing, including transitive includes) and
+             IRGen of the functions defined in the header.
+  templates  "InstantiateClass"/"InstantiateFunction" events and IRGen of the
+             specialization's functions.
+  functions  IRGen ("CodeGen Function") of each function.
+  backend    optimizer and codegen pass time of each LLVM function.
+
+Nested events for the same entity, such as a header included from itself or
+a pass adaptor and the passes it runs, are only counted once.
+
+Inputs may be trace files, directories that are searched for *.json, or
+summaries written by a previous run with -o, so per-target summaries can be
+merged into one ranking for the whole build:
+
+  analyze-time-trace.py -o lib.json build/lib
+  analyze-time-trace.py -o all.json lib.json tools.json
+  analyze-time-trace.py --top 50 --sort irgen all.json
+"""
+
+import argparse
+import json
+import multiprocessing
+import os
+import sys
+
+SUMMARY_VERSION = 1
+SECTIONS = ("headers", "templates", "functions", "backend")
+# Each entry is [frontend us, irgen us, backend us, count].
+PHASES = ("frontend", "irgen", "backend")
+BACKEND_PHASES = ("Optimizer", "CodeGenPasses")
+
+
+def split_qualified(name):
+    """Split a qualified name on the '::' separators outside template args."""
+    parts, depth, start, i = [], 0, 0, 0
+    while i < len(name):
+        c = name[i]
+        if c == "<":
+            depth += 1
+        elif c == ">":
+            depth = max(depth - 1, 0)
+        elif depth == 0 and name.startswith("::", i):
+            parts.append(name[start:i])
+            start = i + 2
+            i += 1
+        i += 1
+    parts.append(name[start:])
+    return parts
+
+
+def specialization_of(name):
+    """Return the template specialization a function belongs to, if any."""
+    parts = split_qualified(name)
+    if "<" in parts[-1]:
+        return name
+    if len(parts) > 1 and parts[-2].endswith(">"):
+        return "::".join(parts[:-1])
+    return None
+
+
+def with_ancestors(events):
+    """Yield (event, enclosing events) for the events of one thread."""
+    stack = []
+    for event in sorted(events, key=lambda e: (e["ts"], -e.get("dur", 0))):
+        end = event["ts"] + event.get("dur", 0)
+        while stack and stack[-1][1] <= event["ts"]:
+            stack.pop()
+        yield event, [e for e, _ in stack]
+        stack.append((event, end))
+
+
+def add(summary, section, key, phase, dur):
+    entry = summary[section].setdefault(key, [0, 0, 0, 0])
+    entry[PHASES.index(phase)] += dur
+    entry[3] += 1
+
+
+def analyze_trace(path):
+    """Return the summary of a single -ftime-trace file."""
+    with open(path) as f:
+        trace = json.load(f)
+    summary = {s: {} for s in SECTIONS}
+    threads = {}
+    for event in trace.get("traceEvents", []):
+        if event.get("ph") == "X" and not event.get("name", "").startswith(
+            "Total "
+        ):
+            threads.setdefault(event.get("tid"), []).append(event)
+
+    for events in threads.values():
+        for event, ancestors in with_ancestors(events):
+            name = event["name"]
+            args = event.get("args", {})
+            detail = args.get("detail", "")
+            dur = event.get("dur", 0)
+
+            def nested_in(pred):
+                return any(pred(a) for a in ancestors)
+
+            def same(a):
+                return a["name"] == name and a.get("args", {}).get("detail") == detail
+
+            if name == "Source":
+                if not nested_in(same):
+                    add(summary, "headers", detail, "frontend", dur)
+            elif name in ("InstantiateClass", "InstantiateFunction"):
+                if not nested_in(same):
+                    add(summary, "templates", detail, "frontend", dur)
+            elif name == "CodeGen Function":
+                if nested_in(same):
+                    continue
+                add(summary, "functions", detail, "irgen", dur)
+                spec = specialization_of(detail)
+                if spec:
+                    add(summary, "templates", spec, "irgen", dur)
+                if "file" in args:
+                    add(summary, "headers", args["file"], "irgen", dur)
+            elif detail and nested_in(lambda a: a["name"] in BACKEND_PHASES):
+                # Pass events carry the name of the IR unit they ran on. Skip
+                # modules, CGSCCs and loops, which are printed with brackets,
+                # parentheses or spaces, and count each function once.
+                if detail[0] in "[(" or " " in detail:
+                    continue
+                if not nested_in(lambda a: a.get("args", {}).get("detail") == detail):
+                    add(summary, "backend", detail, "backend", dur)
+    return summary
+
+
+def load(path):
+    """Return (number of TUs, summary) for a trace or a previous summary."""
+    try:
+        with open(path) as f:
+            data = json.load(f)
+    except (OSError, ValueError) as e:
+        print("warning: skipping %s: %s" % (path, e), file=sys.stderr)
+        return 0, None
+    if isinstance(data, dict) and "sections" in data:
+        if data.get("version") != SUMMARY_VERSION:
+            sys.exit("error: %s: unsupported summary version" % path)
+        return data["tus"], data["sections"]
+    if not isinstance(data, dict) or "traceEvents" not in data:
+        return 0, None
+    return 1, analyze_trace(path)
+
+
+def merge(into, summary):
+    for section in SECTIONS:
+        dest = into[section]
+        for key, entry in summary.get(section, {}).items():
+            old = dest.get(key)
+            if old is None:
+                dest[key] = list(entry)
+            else:
+                for i, v in enumerate(entry):
+                    old[i] += v
+
+
+def collect_inputs(paths):
+    for path in paths:
+        if not os.path.isdir(path):
+            yield path
+            continue
+        for root, _, files in os.walk(path):
+            for name in sorted(files):
+                if name.endswith(".json"):
+                    yield os.path.join(root, name)
+
+
+def print_report(tus, sections, top, sort):
+    print("%d translation units" % tus)
+    for section in SECTIONS:
+        entries = sections[section]
+        if not entries:
+            continue
+
+        def key(item):
+            e = item[1]
+            return sum(e[:3]) if sort == "total" else e[PHASES.index(sort)]
+
+        print("\n%s (top %d of %d):" % (section, min(top, len(entries)), len(entries)))
+        print(
+            "  %10s %10s %10s %10s %8s  name"
+            % ("total ms", "frontend", "irgen", "backend", "count")
+        )
+        for name, e in sorted(entries.items(), key=key, reverse=True)[:top]:
+            print(
+                "  %10.1f %10.1f %10.1f %10.1f %8d  %s"
+                % (sum(e[:3]) / 1000, e[0] / 1000, e[1] / 1000, e[2] / 1000, e[3], name)
+            )
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument("inputs", nargs="+", help="traces, directories or summaries")
+    parser.add_argument("-o", "--output", help="write the merged summary to this file")
+    parser.add_argument("--top", type=int, default=20, help="rows per section")
+    parser.add_argument(
+        "--sort", choices=("total",) + PHASES, default="total", help="ranking column"
+    )
+    parser.add_argument(
+        "-j", "--jobs", type=int, default=os.cpu_count(), help="parallel readers"
+    )
+    opts = parser.parse_args()
+
+    tus, sections = 0, {s: {} for s in SECTIONS}
+    inputs = list(collect_inputs(opts.inputs))
+    with multiprocessing.Pool(max(opts.jobs, 1)) as pool:
+        for n, summary in pool.imap_unordered(load, inputs, chunksize=16):
+            if summary is not None:
+                tus += n
+                merge(sections, summary)
+
+    if opts.output:
+        with open(opts.output, "w") as f:
+            json.dump(
+                {"version": SUMMARY_VERSION, "tus": tus, "sections": sections}, f
+            )
+            f.write("\n")
+    else:
+        print_report(tus, sections, opts.top, opts.sort)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
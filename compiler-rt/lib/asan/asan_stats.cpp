@@ -125,8 +125,9 @@ static void PrintAccumulatedStats() {
   Lock lock(&print_lock);
   stats.Print();
   StackDepotStats stack_depot_stats = StackDepotGetStats();
-  Printf("Stats: StackDepot: %zd ids; %zdM allocated\n",
-         stack_depot_stats.n_uniq_ids, stack_depot_stats.allocated >> 20);
+  Printf("Stats: StackDepot: %zd ids; %zdM allocated; %zd dropped\n",
+         stack_depot_stats.n_uniq_ids, stack_depot_stats.allocated >> 20,
+         stack_depot_stats.n_dropped);
   PrintInternalAllocatorStats();
 }
 
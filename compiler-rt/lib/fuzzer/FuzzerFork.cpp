@@ -101,6 +101,7 @@ struct GlobalEnv {
   int Verbosity = 0;
   int Group = 0;
   int NumCorpuses = 8;
+  bool MergeFromFeatures = false;
 
   size_t NumTimeouts = 0;
   size_t NumOOMs = 0;
@@ -201,6 +202,7 @@ struct GlobalEnv {
     NumRuns += Stats.number_of_executed_units;
 
     std::vector<SizedFile> TempFiles, MergeCandidates;
+    std::vector<std::vector<uint32_t>> CandidateFeatures;
     // Read all newly created inputs and their feature sets.
     // Choose only those inputs that have new features.
     GetSizedFilesFromDir(Job->CorpusDir, &TempFiles);
@@ -215,6 +217,7 @@ struct GlobalEnv {
       for (auto Ft : NewFeatures) {
         if (!Features.count(Ft)) {
           MergeCandidates.push_back(F);
+          CandidateFeatures.push_back(std::move(NewFeatures));
           break;
         }
       }
@@ -230,11 +233,29 @@ struct GlobalEnv {
 
     std::vector<std::string> FilesToAdd;
     std::set<uint32_t> NewFeatures, NewCov;
-    bool IsSetCoverMerge =
-        !Job->Cmd.getFlagValue("set_cover_merge").compare("1");
-    CrashResistantMerge(Args, {}, MergeCandidates, &FilesToAdd, Features,
-                        &NewFeatures, Cov, &NewCov, Job->CFPath, false,
-                        IsSetCoverMerge);
+    if (MergeFromFeatures) {
+      // The job recorded the features each input added to its corpus when it
+      // found them. Any other feature of the input was already known to the
+      // job, from its seeds, which come from the main corpus, or from a
+      // smaller input it found, which is a candidate itself. So taking the
+      // candidates by increasing size and keeping those with a feature we
+      // don't have yet gives the same corpus as a merge, without executing
+      // the inputs again.
+      for (size_t I = 0; I < MergeCandidates.size(); I++) {
+        bool HasNewFeature = false;
+        for (auto Ft : CandidateFeatures[I])
+          if (!Features.count(Ft) && NewFeatures.insert(Ft).second)
+            HasNewFeature = true;
+        if (HasNewFeature)
+          FilesToAdd.push_back(MergeCandidates[I].File);
+      }
+    } else {
+      bool IsSetCoverMerge =
+          !Job->Cmd.getFlagValue("set_cover_merge").compare("1");
+      CrashResistantMerge(Args, {}, MergeCandidates, &FilesToAdd, Features,
+                          &NewFeatures, Cov, &NewCov, Job->CFPath, false,
+                          IsSetCoverMerge);
+    }
     for (auto &Path : FilesToAdd) {
       auto U = FileToVector(Path);
       auto NewPath = DirPlusFile(MainCorpusDir, Hash(U));
@@ -322,6 +343,7 @@ void FuzzWithFork(Random &Rand, const FuzzingOptions &Options,
   Env.ProcessStartTime = std::chrono::system_clock::now();
   Env.DataFlowBinary = Options.CollectDataFlow;
   Env.Group = Options.ForkCorpusGroups;
+  Env.MergeFromFeatures = Options.ForkMergeFromFeatures;
 
   std::vector<SizedFile> SeedFiles;
   for (auto &Dir : CorpusDirs)
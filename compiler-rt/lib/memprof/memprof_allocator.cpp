@@ -134,9 +134,12 @@ struct ChunkHeader {
   // 3-rd 4 bytes
   u32 timestamp_ms;
   // 4-th 4 bytes
-  // Note only 1 bit is needed for this flag if we need space in the future for
-  // more fields.
-  u32 from_memalign;
+  // Note only 1 bit is needed for each of these flags if we need space in the
+  // future for more fields.
+  u16 from_memalign;
+  // Set if sample_interval_bytes is in effect and the allocation wasn't
+  // sampled. Such chunks are not recorded in the profile.
+  u16 not_sampled;
   // 5-th and 6-th 4 bytes
   // The max size of an allocation is 2^40 (kMaxAllowedMallocSize), so this
   // could be shrunk to kMaxAllowedMallocBits if we need space in the future for
@@ -385,7 +388,7 @@ struct Allocator {
           Allocator *A = (Allocator *)alloc;
           MemprofChunk *m =
               A->GetMemprofChunk((void *)chunk, user_requested_size);
-          if (!m)
+          if (!m || m->not_sampled)
             return;
           uptr user_beg = ((uptr)m) + kChunkHeaderSize;
           MemInfoBlock newMIB = CreateNewMIB(user_beg, m, user_requested_size);
@@ -404,6 +407,36 @@ struct Allocator {
                                        : kMaxAllowedMallocSize;
   }
 
+  // Returns the number of bytes until the next sampled byte. The sampled bytes
+  // form a Poisson process, so the distances are exponentially distributed
+  // with a mean of sample_interval_bytes.
+  static uptr NextSampleDistance(u32 *rand_state) {
+    u32 r = (Rand(rand_state) << 16) | Rand(rand_state);
+    // Uniform in (0, 1].
+    double u = (double(r) + 1) / 4294967296.0;
+    return uptr(-__builtin_log(u) * flags()->sample_interval_bytes) + 1;
+  }
+
+  // Returns whether an allocation of |size| bytes on |t| is profiled. An
+  // allocation is sampled if any of its bytes is, so the larger it is, the more
+  // likely it is to be recorded.
+  static bool ShouldSampleAllocation(MemprofThread *t, uptr size) {
+    // Allocations made before the thread is set up are always recorded.
+    if (!t)
+      return true;
+    MemprofAllocSampler &s = t->alloc_sampler();
+    if (UNLIKELY(s.rand_state == 0)) {
+      s.rand_state = (static_cast<u32>(NanoTime()) ^ t->tid()) | 1;
+      s.bytes_until_sample = NextSampleDistance(&s.rand_state);
+    }
+    if (LIKELY(size < s.bytes_until_sample)) {
+      s.bytes_until_sample -= size;
+      return false;
+    }
+    s.bytes_until_sample = NextSampleDistance(&s.rand_state);
+    return true;
+  }
+
   // -------------------- Allocation/Deallocation routines ---------------
   void *Allocate(uptr size, uptr alignment, BufferedStackTrace *stack,
                  AllocType alloc_type) {
@@ -476,7 +509,9 @@ struct Allocator {
 
     m->cpu_id = GetCpuId();
     m->timestamp_ms = GetTimestamp();
-    m->alloc_context_id = StackDepotPut(*stack);
+    m->not_sampled =
+        flags()->sample_interval_bytes && !ShouldSampleAllocation(t, size);
+    m->alloc_context_id = m->not_sampled ? 0 : StackDepotPut(*stack);
 
     uptr size_rounded_down_to_granularity =
         RoundDownTo(size, SHADOW_GRANULARITY);
@@ -516,7 +551,7 @@ struct Allocator {
     u64 user_requested_size =
         atomic_exchange(&m->user_requested_size, 0, memory_order_acquire);
     if (memprof_inited && atomic_load_relaxed(&constructed) &&
-        !atomic_load_relaxed(&destructing)) {
+        !atomic_load_relaxed(&destructing) && !m->not_sampled) {
       MemInfoBlock newMIB = this->CreateNewMIB(p, m, user_requested_size);
       InsertOrMerge(m->alloc_context_id, newMIB, MIBMap);
     }
@@ -29,6 +29,12 @@ namespace __memprof {
 
 class MemprofThread;
 
+// Per-thread state of the allocation sampling, see sample_interval_bytes.
+struct MemprofAllocSampler {
+  uptr bytes_until_sample;
+  u32 rand_state;
+};
+
 // These objects are created for every thread and are never deleted,
 // so we can find them by tid even if the thread is long dead.
 struct MemprofThreadContext final : public ThreadContextBase {
@@ -82,6 +88,7 @@ public:
 
   MemprofThreadLocalMallocStorage &malloc_storage() { return malloc_storage_; }
   MemprofStats &stats() { return stats_; }
+  MemprofAllocSampler &alloc_sampler() { return alloc_sampler_; }
 
 private:
   // NOTE: There is no MemprofThread constructor. It is allocated
@@ -108,6 +115,7 @@ private:
 
   MemprofThreadLocalMallocStorage malloc_storage_;
   MemprofStats stats_;
+  MemprofAllocSampler alloc_sampler_;
   bool unwinding_;
 };
 
@@ -1083,6 +1083,8 @@ inline void AvoidCVE_2016_2143() {}
 struct StackDepotStats {
   uptr n_uniq_ids;
   uptr allocated;
+  // Stack traces not stored because the depot reached its memory limit.
+  uptr n_dropped;
 };
 
 // The default value for allocator_release_to_os_interval_ms common flag to
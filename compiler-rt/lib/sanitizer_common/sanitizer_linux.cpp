@@ -75,6 +75,8 @@
 #  include <unistd.h>
 
 #  if SANITIZER_LINUX
+#    include <sys/socket.h>
+#    include <sys/un.h>
 #    include <sys/utsname.h>
 #  endif
 
@@ -1865,6 +1867,26 @@ uptr internal_clone(int (*fn)(void *), void *child_stack, int flags, void *arg,
 int internal_uname(struct utsname *buf) {
   return internal_syscall(SYSCALL(uname), buf);
 }
+
+fd_t ConnectToUnixSocket(const char *path) {
+  struct sockaddr_un addr;
+  if (internal_strlen(path) >= sizeof(addr.sun_path))
+    return kInvalidFd;
+  internal_memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  internal_strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+  int err;
+  uptr fd = internal_syscall(SYSCALL(socket), AF_UNIX,
+                             SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (internal_iserror(fd, &err))
+    return kInvalidFd;
+  uptr res = internal_syscall(SYSCALL(connect), fd, (uptr)&addr, sizeof(addr));
+  if (internal_iserror(res, &err)) {
+    internal_close(fd);
+    return kInvalidFd;
+  }
+  return fd;
+}
 #  endif
 
 #  if SANITIZER_ANDROID
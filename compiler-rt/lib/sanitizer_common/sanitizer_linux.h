@@ -85,6 +85,9 @@ uptr internal_clone(int (*fn)(void *), void *child_stack, int flags, void *arg,
                     int *parent_tidptr, void *newtls, int *child_tidptr);
 #    endif
 int internal_uname(struct utsname *buf);
+// Returns a stream socket connected to the UNIX domain socket bound to |path|,
+// or kInvalidFd on failure.
+fd_t ConnectToUnixSocket(const char *path);
 #  elif SANITIZER_FREEBSD
 uptr internal_procctl(int type, int id, int cmd, void *data);
 void internal_sigdelset(__sanitizer_sigset_t *set, int signum);
@@ -203,12 +203,40 @@ StackDepotNode::args_type StackDepotNode::load(u32 id) const {
   return stackStore.Load(store_id);
 }
 
-StackDepotStats StackDepotGetStats() { return theDepot.GetStats(); }
+static atomic_uintptr_t n_dropped;
+
+static bool StackDepotIsFull() {
+  int max_mb = common_flags()->stack_depot_max_mb;
+  if (LIKELY(max_mb <= 0))
+    return false;
+  // Estimate the node and use count maps from the number of ids, walking them
+  // as GetStats() does is too slow for every insertion.
+  uptr used = stackStore.Allocated() +
+              theDepot.NumUniqueIds() *
+                  (sizeof(StackDepotNode) + sizeof(atomic_uint32_t));
+  return used >= (static_cast<uptr>(max_mb) << 20);
+}
+
+static u32 PutOrFind(StackTrace stack) {
+  if (LIKELY(!StackDepotIsFull()))
+    return theDepot.Put(stack);
+  // Stacks stored before the limit was reached are still returned.
+  u32 id = theDepot.Find(stack);
+  if (!id && StackDepotNode::is_valid(stack))
+    atomic_fetch_add(&n_dropped, 1, memory_order_relaxed);
+  return id;
+}
+
+StackDepotStats StackDepotGetStats() {
+  StackDepotStats stats = theDepot.GetStats();
+  stats.n_dropped = atomic_load_relaxed(&n_dropped);
+  return stats;
+}
 
-u32 StackDepotPut(StackTrace stack) { return theDepot.Put(stack); }
+u32 StackDepotPut(StackTrace stack) { return PutOrFind(stack); }
 
 StackDepotHandle StackDepotPut_WithHandle(StackTrace stack) {
-  return StackDepotNode::get_handle(theDepot.Put(stack));
+  return StackDepotNode::get_handle(PutOrFind(stack));
 }
 
 StackTrace StackDepotGet(u32 id) {
@@ -242,6 +270,7 @@ StackDepotHandle StackDepotNode::get_handle(u32 id) {
 void StackDepotTestOnlyUnmap() {
   theDepot.TestOnlyUnmap();
   stackStore.TestOnlyUnmap();
+  atomic_store_relaxed(&n_dropped, 0);
 }
 
 } // namespace __sanitizer
@@ -42,6 +42,8 @@ class StackDepotBase {
 
   // Maps stack trace to an unique id.
   u32 Put(args_type args, bool *inserted = nullptr);
+  // Returns the id of a stack trace stored before, or 0 if it was not.
+  u32 Find(args_type args) const;
   // Retrieves a stored stack trace by the id.
   args_type Get(u32 id);
 
@@ -52,6 +54,9 @@ class StackDepotBase {
     };
   }
 
+  // Cheaper than GetStats(), which walks the node map.
+  u32 NumUniqueIds() const { return atomic_load_relaxed(&n_uniq_ids); }
+
   void LockBeforeFork();
   void UnlockAfterFork(bool fork_child);
   void PrintAll();
@@ -147,6 +152,16 @@ u32 StackDepotBase<Node, kReservedBits, kTabSizeLog>::Put(args_type args,
   return s;
 }
 
+template <class Node, int kReservedBits, int kTabSizeLog>
+u32 StackDepotBase<Node, kReservedBits, kTabSizeLog>::Find(
+    args_type args) const {
+  if (!LIKELY(Node::is_valid(args)))
+    return 0;
+  hash_type h = Node::hash(args);
+  u32 v = atomic_load(&tab[h % kTabSize], memory_order_consume);
+  return find(v & kUnlockMask, args, h);
+}
+
 template <class Node, int kReservedBits, int kTabSizeLog>
 typename StackDepotBase<Node, kReservedBits, kTabSizeLog>::args_type
 StackDepotBase<Node, kReservedBits, kTabSizeLog>::Get(u32 id) {
@@ -93,6 +93,9 @@ class SymbolizerProcess {
   virtual bool ReadFromSymbolizer();
   // Return the environment to run the symbolizer in.
   virtual char **GetEnvP() { return GetEnviron(); }
+  // Return the path of the socket of a running symbolizer to use instead of
+  // starting a new one, if any.
+  virtual const char *GetSocketPath() const { return nullptr; }
   InternalMmapVector<char> &GetBuff() { return buffer_; }
 
  private:
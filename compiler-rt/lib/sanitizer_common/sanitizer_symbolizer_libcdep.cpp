@@ -256,6 +256,11 @@ class LLVMSymbolizerProcess final : public SymbolizerProcess {
            buffer[length - 2] == '\n';
   }
 
+  const char *GetSocketPath() const override {
+    const char *path = common_flags()->external_symbolizer_socket;
+    return path && path[0] ? path : nullptr;
+  }
+
   // When adding a new architecture, don't forget to also update
   // script/asan_symbolize.py and sanitizer_common.h.
   void GetArgV(const char *path_to_binary,
@@ -527,8 +532,10 @@ const char *SymbolizerProcess::SendCommandImpl(const char *command) {
 bool SymbolizerProcess::Restart() {
   if (input_fd_ != kInvalidFd)
     CloseFile(input_fd_);
-  if (output_fd_ != kInvalidFd)
+  // Both are the same socket when connected to a shared symbolizer.
+  if (output_fd_ != kInvalidFd && output_fd_ != input_fd_)
     CloseFile(output_fd_);
+  input_fd_ = output_fd_ = kInvalidFd;
   return StartSymbolizerSubprocess();
 }
 
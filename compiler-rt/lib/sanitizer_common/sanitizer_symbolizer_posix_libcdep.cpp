@@ -132,6 +132,20 @@ static bool CreateTwoHighNumberedPipes(int *infd_, int *outfd_) {
 }
 
 bool SymbolizerProcess::StartSymbolizerSubprocess() {
+#  if SANITIZER_LINUX
+  if (const char *socket_path = GetSocketPath()) {
+    fd_t fd = ConnectToUnixSocket(socket_path);
+    if (fd != kInvalidFd) {
+      VReport(2, "Using the symbolizer listening at %s\n", socket_path);
+      input_fd_ = fd;
+      output_fd_ = fd;
+      return true;
+    }
+    VReport(1, "WARNING: can't connect to the symbolizer at %s\n",
+            socket_path);
+  }
+#  endif
+
   if (!FileExists(path_)) {
     if (!reported_invalid_path_) {
       Report("WARNING: invalid path to external symbolizer!\n");
@@ -454,6 +468,11 @@ static SymbolizerTool *ChooseExternalSymbolizer(LowLevelAllocator *allocator) {
     VReport(2, "Using llvm-symbolizer found at: %s\n", found_path);
     return new(*allocator) LLVMSymbolizer(found_path, allocator);
   }
+#if SANITIZER_LINUX
+  // A shared symbolizer can be used without a local llvm-symbolizer binary.
+  if (common_flags()->external_symbolizer_socket[0])
+    return new (*allocator) LLVMSymbolizer("llvm-symbolizer", allocator);
+#endif  // SANITIZER_LINUX
   if (common_flags()->allow_addr2line) {
     if (const char *found_path = FindPathToBinary("addr2line")) {
       VReport(2, "Using addr2line found at: %s\n", found_path);
@@ -20,6 +20,7 @@
 #include <thread>
 
 #include "gtest/gtest.h"
+#include "sanitizer_common/sanitizer_flags.h"
 #include "sanitizer_common/sanitizer_internal_defs.h"
 #include "sanitizer_common/sanitizer_libc.h"
 
@@ -84,6 +85,28 @@ TEST_F(StackDepotTest, Several) {
   EXPECT_NE(i1, i2);
 }
 
+TEST_F(StackDepotTest, MaxMemory) {
+  CommonFlags cf;
+  cf.CopyFrom(*common_flags());
+  cf.stack_depot_max_mb = 1;
+  OverrideCommonFlags(cf);
+  // The first block of the stack store already exceeds the limit.
+  uptr array1[] = {1, 2, 3, 4, 10};
+  StackTrace s1(array1, ARRAY_SIZE(array1));
+  u32 i1 = StackDepotPut(s1);
+  EXPECT_NE(i1, 0u);
+  uptr array2[] = {1, 2, 3, 4, 11};
+  StackTrace s2(array2, ARRAY_SIZE(array2));
+  EXPECT_EQ(StackDepotPut(s2), 0u);
+  EXPECT_EQ(StackDepotPut(s1), i1);
+  EXPECT_EQ(StackDepotGetStats().n_dropped, 1u);
+  EXPECT_EQ(StackDepotGetStats().n_uniq_ids, 1u);
+
+  cf.stack_depot_max_mb = 0;
+  OverrideCommonFlags(cf);
+  EXPECT_NE(StackDepotPut(s2), 0u);
+}
+
 TEST_F(StackDepotTest, Print) {
   uptr array1[] = {0x111, 0x222, 0x333, 0x444, 0x777};
   StackTrace s1(array1, ARRAY_SIZE(array1));
@@ -176,6 +176,9 @@ public:
         static_cast<u32>(getFlags()->quarantine_max_chunk_size);
 
     Stats.init();
+    if (getFlags()->release_to_os_rss_limit_mb > 0)
+      RssLimitBytes =
+          static_cast<uptr>(getFlags()->release_to_os_rss_limit_mb) << 20;
     // TODO(chiahungduan): Given that we support setting the default value in
     // the PrimaryConfig and CacheConfig, consider to deprecate the use of
     // `release_to_os_interval_ms` flag.
@@ -967,6 +970,15 @@ private:
   u32 Cookie = 0;
   u32 QuarantineMaxChunkSize = 0;
 
+  // The resident memory above which freed memory is released without waiting
+  // for the release interval, or 0 if there is no limit.
+  uptr RssLimitBytes = 0;
+  // Reading the resident memory size is a system call, so it is only checked
+  // once per RssCheckIntervalNs.
+  static constexpr u64 RssCheckIntervalNs = 100ULL * 1000 * 1000;
+  atomic_u64 LastRssCheckNs = {};
+  atomic_u8 OverRssLimit = {};
+
   GlobalStats Stats;
   PrimaryT Primary;
   SecondaryT Secondary;
@@ -1240,6 +1252,20 @@ private:
     return TaggedPtr;
   }
 
+  // Returns whether the resident memory exceeds `release_to_os_rss_limit_mb`.
+  // Racing threads may both refresh the cached value, which is harmless.
+  bool isOverRssLimit() {
+    if (LIKELY(RssLimitBytes == 0))
+      return false;
+    const u64 CurTimeNs = getMonotonicTimeFast();
+    if (CurTimeNs - atomic_load_relaxed(&LastRssCheckNs) >= RssCheckIntervalNs) {
+      atomic_store_relaxed(&LastRssCheckNs, CurTimeNs);
+      atomic_store_relaxed(&OverRssLimit,
+                           getResidentSetSize() > RssLimitBytes ? 1U : 0U);
+    }
+    return atomic_load_relaxed(&OverRssLimit) != 0;
+  }
+
   void quarantineOrDeallocateChunk(const Options &Options, void *TaggedPtr,
                                    Chunk::UnpackedHeader *Header,
                                    uptr Size) NO_THREAD_SAFETY_ANALYSIS {
@@ -1287,7 +1313,9 @@ private:
         // Note that in order not to block other thread's accessing the TSD,
         // release the TSD first then try the page release.
         if (CacheDrained)
-          Primary.tryReleaseToOS(ClassId, ReleaseToOS::Normal);
+          Primary.tryReleaseToOS(ClassId, isOverRssLimit()
+                                              ? ReleaseToOS::Force
+                                              : ReleaseToOS::Normal);
       } else {
         Secondary.deallocate(Options, BlockBegin);
       }
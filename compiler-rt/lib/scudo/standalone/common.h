@@ -170,6 +170,14 @@ inline uptr getPageSizeLogCached() {
 // Returns 0 if the number of CPUs could not be determined.
 u32 getNumberOfCPUs();
 
+// Returns the CPU the calling thread is running on, or -1 if it could not be
+// determined.
+s32 getCurrentCPU();
+
+// Returns the resident set size of the process in bytes, or 0 if it could not
+// be determined.
+uptr getResidentSetSize();
+
 const char *getEnv(const char *Name);
 
 u64 getMonotonicTime();
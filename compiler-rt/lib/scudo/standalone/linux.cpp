@@ -170,6 +170,28 @@ u32 getNumberOfCPUs() {
   return static_cast<u32>(CPU_COUNT(&CPUs));
 }
 
+s32 getCurrentCPU() { return sched_getcpu(); }
+
+uptr getResidentSetSize() {
+  // The second field of /proc/self/statm is the number of resident pages.
+  const int FileDesc = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+  if (FileDesc == -1)
+    return 0;
+  char Buffer[64];
+  const ssize_t ReadBytes = read(FileDesc, Buffer, sizeof(Buffer) - 1);
+  close(FileDesc);
+  if (ReadBytes <= 0)
+    return 0;
+  Buffer[ReadBytes] = '\0';
+  const char *P = Buffer;
+  while (*P && *P != ' ')
+    P++;
+  uptr Pages = 0;
+  for (P++; *P >= '0' && *P <= '9'; P++)
+    Pages = Pages * 10 + static_cast<uptr>(*P - '0');
+  return Pages * getPageSizeCached();
+}
+
 u32 getThreadID() {
 #if SCUDO_ANDROID
   return static_cast<u32>(gettid());
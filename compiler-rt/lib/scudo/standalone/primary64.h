@@ -221,12 +221,11 @@ public:
     RegionInfo *Region = getRegionInfo(ClassId);
     u16 PopCount = 0;
 
-    {
-      ScopedLock L(Region->FLLock);
-      PopCount = popBlocksImpl(C, ClassId, Region, ToArray, MaxBlockCount);
-      if (PopCount != 0U)
-        return PopCount;
-    }
+    lockFreeList(Region);
+    PopCount = popBlocksImpl(C, ClassId, Region, ToArray, MaxBlockCount);
+    Region->FLLock.unlock();
+    if (PopCount != 0U)
+      return PopCount;
 
     bool ReportRegionExhausted = false;
 
@@ -276,10 +275,11 @@ public:
 
     RegionInfo *Region = getRegionInfo(ClassId);
     if (ClassId == SizeClassMap::BatchClassId) {
-      ScopedLock L(Region->FLLock);
+      lockFreeList(Region);
       pushBatchClassBlocks(Region, Array, Size);
       if (conditionVariableEnabled())
         Region->FLLockCV.notifyAll(Region->FLLock);
+      Region->FLLock.unlock();
       return;
     }
 
@@ -303,12 +303,11 @@ public:
       }
     }
 
-    {
-      ScopedLock L(Region->FLLock);
-      pushBlocksImpl(C, ClassId, Region, Array, Size, SameGroup);
-      if (conditionVariableEnabled())
-        Region->FLLockCV.notifyAll(Region->FLLock);
-    }
+    lockFreeList(Region);
+    pushBlocksImpl(C, ClassId, Region, Array, Size, SameGroup);
+    if (conditionVariableEnabled())
+      Region->FLLockCV.notifyAll(Region->FLLock);
+    Region->FLLock.unlock();
   }
 
   void disable() NO_THREAD_SAFETY_ANALYSIS {
@@ -357,8 +356,10 @@ public:
     uptr TotalMapped = 0;
     uptr PoppedBlocks = 0;
     uptr PushedBlocks = 0;
+    uptr ContendedLocks = 0;
     for (uptr I = 0; I < NumClasses; I++) {
       RegionInfo *Region = getRegionInfo(I);
+      ContendedLocks += atomic_load_relaxed(&Region->FLLockContended);
       {
         ScopedLock L(Region->MMLock);
         TotalMapped += Region->MemMapInfo.MappedUser;
@@ -371,9 +372,11 @@ public:
     }
     const s32 IntervalMs = atomic_load_relaxed(&ReleaseToOsIntervalMs);
     Str->append("Stats: SizeClassAllocator64: %zuM mapped (%uM rss) in %zu "
-                "allocations; remains %zu; ReleaseToOsIntervalMs = %d\n",
+                "allocations; remains %zu; ReleaseToOsIntervalMs = %d; "
+                "freelist lock contended %zu times\n",
                 TotalMapped >> 20, 0U, PoppedBlocks,
-                PoppedBlocks - PushedBlocks, IntervalMs >= 0 ? IntervalMs : -1);
+                PoppedBlocks - PushedBlocks, IntervalMs >= 0 ? IntervalMs : -1,
+                ContendedLocks);
 
     for (uptr I = 0; I < NumClasses; I++) {
       RegionInfo *Region = getRegionInfo(I);
@@ -560,6 +563,9 @@ private:
     ConditionVariableT FLLockCV GUARDED_BY(FLLock);
     // Mutex for memmap operations
     HybridMutex MMLock ACQUIRED_BEFORE(FLLock);
+    // Number of times the freelist had to wait for `FLLock` in popBlocks() or
+    // pushBlocks().
+    atomic_uptr FLLockContended = {};
     // `RegionBeg` is initialized before thread creation and won't be changed.
     uptr RegionBeg = 0;
     u32 RandState GUARDED_BY(MMLock) = 0;
@@ -575,6 +581,17 @@ private:
   };
   static_assert(sizeof(RegionInfo) % SCUDO_CACHE_LINE_SIZE == 0, "");
 
+  // Same as locking `FLLock`, but counts the times it was contended. This is
+  // only used where the free list is exchanged with the caches, the other
+  // paths are rare enough to not matter.
+  ALWAYS_INLINE void lockFreeList(RegionInfo *Region)
+      ACQUIRE(Region->FLLock) {
+    if (LIKELY(Region->FLLock.tryLock()))
+      return;
+    atomic_fetch_add(&Region->FLLockContended, 1U, memory_order_relaxed);
+    Region->FLLock.lock();
+  }
+
   RegionInfo *getRegionInfo(uptr ClassId) {
     DCHECK_LT(ClassId, NumClasses);
     return &RegionInfoArray[ClassId];
@@ -1143,16 +1160,17 @@ private:
     const uptr TotalChunks = Region->MemMapInfo.AllocatedUser / BlockSize;
     Str->append("%s %02zu (%6zu): mapped: %6zuK popped: %7zu pushed: %7zu "
                 "inuse: %6zu total: %6zu releases attempted: %6zu last "
-                "released: %6zuK latest pushed bytes: %6zuK region: 0x%zx "
-                "(0x%zx)\n",
+                "released: %6zuK latest pushed bytes: %6zuK contended: %6zu "
+                "region: 0x%zx (0x%zx)\n",
                 Region->Exhausted ? "E" : " ", ClassId,
                 getSizeByClassId(ClassId), Region->MemMapInfo.MappedUser >> 10,
                 Region->FreeListInfo.PoppedBlocks,
                 Region->FreeListInfo.PushedBlocks, InUseBlocks, TotalChunks,
                 Region->ReleaseInfo.NumReleasesAttempted,
                 Region->ReleaseInfo.LastReleasedBytes >> 10,
-                RegionPushedBytesDelta >> 10, Region->RegionBeg,
-                getRegionBaseByClassId(ClassId));
+                RegionPushedBytesDelta >> 10,
+                atomic_load_relaxed(&Region->FLLockContended),
+                Region->RegionBeg, getRegionBaseByClassId(ClassId));
   }
 
   void getRegionFragmentationInfo(RegionInfo *Region, uptr ClassId,
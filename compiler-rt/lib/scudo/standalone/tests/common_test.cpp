@@ -53,6 +53,25 @@ TEST(ScudoCommonTest, SKIP_ON_FUCHSIA(ResidentMemorySize)) {
   MemMap.unmap();
 }
 
+TEST(ScudoCommonTest, CurrentCPU) {
+  const s32 CPU = getCurrentCPU();
+  if (!SCUDO_LINUX) {
+    EXPECT_EQ(CPU, -1);
+    return;
+  }
+  EXPECT_GE(CPU, 0);
+}
+
+TEST(ScudoCommonTest, SKIP_ON_FUCHSIA(ResidentSetSize)) {
+  const uptr OnStart = getResidentSetSize();
+  EXPECT_GT(OnStart, 0U);
+  EXPECT_EQ(OnStart % getPageSizeCached(), 0U);
+  // It should agree with the size read through the standard library.
+  const uptr Resident = getResidentMemorySize();
+  EXPECT_LE(OnStart, 2 * Resident);
+  EXPECT_GE(2 * OnStart, Resident);
+}
+
 TEST(ScudoCommonTest, Zeros) {
   const uptr Size = 1ull << 20;
 
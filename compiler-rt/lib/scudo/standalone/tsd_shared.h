@@ -224,7 +224,12 @@ private:
       Inc = CoPrimes[R % NumberOfCoPrimes];
     }
     if (N > 1U) {
-      u32 Index = R % N;
+      // Start with the context of the CPU we are running on. Contended
+      // threads thus settle on the contexts of their CPUs, which keeps the
+      // cached blocks of a context in the caches of the same CPU, and on the
+      // same node, rather than bouncing them between sockets.
+      const s32 CPU = getCurrentCPU();
+      u32 Index = (CPU >= 0 ? static_cast<u32>(CPU) : R) % N;
       uptr LowestPrecedence = UINTPTR_MAX;
       TSD<Allocator> *CandidateTSD = nullptr;
       // Go randomly through at most 4 contexts and find a candidate.
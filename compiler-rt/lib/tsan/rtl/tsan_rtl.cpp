@@ -726,6 +726,14 @@ void Initialize(ThreadState *thr) {
 
   VPrintf(1, "***** Running under ThreadSanitizer v3 (pid %d) *****\n",
           (int)internal_getpid());
+  if (flags()->sample_memory_accesses > 1) {
+    uptr n = flags()->sample_memory_accesses;
+    VPrintf(1,
+            "ThreadSanitizer: checking 1 in %zu memory accesses; each "
+            "occurrence of a race is detected with probability of about "
+            "1/%zu\n",
+            n, n * n);
+  }
 
   // Initialize thread 0.
   Tid tid = ThreadCreate(nullptr, 0, 0, true);
@@ -175,6 +175,10 @@ struct alignas(SANITIZER_CACHE_LINE_SIZE) ThreadState {
 
   atomic_sint32_t pending_signals;
 
+  // Number of memory accesses left until the next one that is checked, if
+  // sample_memory_accesses is enabled, 0 otherwise.
+  u32 mop_sample_countdown;
+
   VectorClock clock;
 
   // This is a slow path flag. On fast path, fast_state.GetIgnoreBit() is read.
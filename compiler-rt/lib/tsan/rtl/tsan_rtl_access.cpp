@@ -411,6 +411,23 @@ char* DumpShadow(char* buf, RawShadow raw) {
 // switching trace part. As the result the hottest callbacks contain only tail
 // calls, which effectively makes them leaf functions (can use all registers,
 // no frame setup, etc).
+// With sample_memory_accesses, only every N-th access of a thread is traced,
+// checked and stored in shadow. The countdown is reset only once the access
+// is traced, so that the TraceRestart* paths re-entering the callback with the
+// countdown at 1 do not skip the access.
+ALWAYS_INLINE bool SkipSampledAccess(ThreadState* thr) {
+  u32 countdown = thr->mop_sample_countdown;
+  if (LIKELY(countdown <= 1))
+    return false;
+  thr->mop_sample_countdown = countdown - 1;
+  return true;
+}
+
+ALWAYS_INLINE void ResetSampleCountdown(ThreadState* thr) {
+  if (UNLIKELY(thr->mop_sample_countdown))
+    thr->mop_sample_countdown = flags()->sample_memory_accesses;
+}
+
 NOINLINE void TraceRestartMemoryAccess(ThreadState* thr, uptr pc, uptr addr,
                                        uptr size, AccessType typ) {
   TraceSwitchPart(thr);
@@ -437,8 +454,11 @@ ALWAYS_INLINE USED void MemoryAccess(ThreadState* thr, uptr pc, uptr addr,
     return;
   if (UNLIKELY(fast_state.GetIgnoreBit()))
     return;
+  if (UNLIKELY(SkipSampledAccess(thr)))
+    return;
   if (!TryTraceMemoryAccess(thr, pc, addr, size, typ))
     return TraceRestartMemoryAccess(thr, pc, addr, size, typ);
+  ResetSampleCountdown(thr);
   CheckRaces(thr, shadow_mem, cur, shadow, access, typ);
 }
 
@@ -457,6 +477,8 @@ ALWAYS_INLINE USED void MemoryAccess16(ThreadState* thr, uptr pc, uptr addr,
   FastState fast_state = thr->fast_state;
   if (UNLIKELY(fast_state.GetIgnoreBit()))
     return;
+  if (UNLIKELY(SkipSampledAccess(thr)))
+    return;
   Shadow cur(fast_state, 0, 8, typ);
   RawShadow* shadow_mem = MemToShadow(addr);
   bool traced = false;
@@ -467,6 +489,7 @@ ALWAYS_INLINE USED void MemoryAccess16(ThreadState* thr, uptr pc, uptr addr,
     if (!TryTraceMemoryAccessRange(thr, pc, addr, size, typ))
       return RestartMemoryAccess16(thr, pc, addr, typ);
     traced = true;
+    ResetSampleCountdown(thr);
     if (UNLIKELY(CheckRaces(thr, shadow_mem, cur, shadow, access, typ)))
       return;
   }
@@ -475,8 +498,11 @@ SECOND:
   LOAD_CURRENT_SHADOW(cur, shadow_mem);
   if (LIKELY(ContainsSameAccess(shadow_mem, cur, shadow, access, typ)))
     return;
-  if (!traced && !TryTraceMemoryAccessRange(thr, pc, addr, size, typ))
-    return RestartMemoryAccess16(thr, pc, addr, typ);
+  if (!traced) {
+    if (!TryTraceMemoryAccessRange(thr, pc, addr, size, typ))
+      return RestartMemoryAccess16(thr, pc, addr, typ);
+    ResetSampleCountdown(thr);
+  }
   CheckRaces(thr, shadow_mem, cur, shadow, access, typ);
 }
 
@@ -494,6 +520,8 @@ ALWAYS_INLINE USED void UnalignedMemoryAccess(ThreadState* thr, uptr pc,
   FastState fast_state = thr->fast_state;
   if (UNLIKELY(fast_state.GetIgnoreBit()))
     return;
+  if (UNLIKELY(SkipSampledAccess(thr)))
+    return;
   RawShadow* shadow_mem = MemToShadow(addr);
   bool traced = false;
   uptr size1 = Min<uptr>(size, RoundUp(addr + 1, kShadowCell) - addr);
@@ -505,6 +533,7 @@ ALWAYS_INLINE USED void UnalignedMemoryAccess(ThreadState* thr, uptr pc,
     if (!TryTraceMemoryAccessRange(thr, pc, addr, size, typ))
       return RestartUnalignedMemoryAccess(thr, pc, addr, size, typ);
     traced = true;
+    ResetSampleCountdown(thr);
     if (UNLIKELY(CheckRaces(thr, shadow_mem, cur, shadow, access, typ)))
       return;
   }
@@ -517,8 +546,11 @@ SECOND:
   LOAD_CURRENT_SHADOW(cur, shadow_mem);
   if (LIKELY(ContainsSameAccess(shadow_mem, cur, shadow, access, typ)))
     return;
-  if (!traced && !TryTraceMemoryAccessRange(thr, pc, addr, size, typ))
-    return RestartUnalignedMemoryAccess(thr, pc, addr, size, typ);
+  if (!traced) {
+    if (!TryTraceMemoryAccessRange(thr, pc, addr, size, typ))
+      return RestartUnalignedMemoryAccess(thr, pc, addr, size, typ);
+    ResetSampleCountdown(thr);
+  }
   CheckRaces(thr, shadow_mem, cur, shadow, access, typ);
 }
 
@@ -163,6 +163,8 @@ void ThreadStart(ThreadState *thr, Tid tid, tid_t os_id,
 #if !SANITIZER_GO
   thr->is_inited = true;
 #endif
+  if (flags()->sample_memory_accesses > 1)
+    thr->mop_sample_countdown = flags()->sample_memory_accesses;
 
   uptr stk_addr = 0;
   uptr stk_end = 0;
@@ -120,6 +120,40 @@ TEST(BufferQueueTest, Apply) {
   ASSERT_EQ(Count, 10);
 }
 
+static size_t ReleasedBuffers = 0;
+static uint64_t ReleasedExtents = 0;
+
+TEST(BufferQueueTest, ReleaseCallback) {
+  bool Success = false;
+  BufferQueue Buffers(kSize, 2, Success);
+  ASSERT_TRUE(Success);
+  ReleasedBuffers = 0;
+  ReleasedExtents = 0;
+  Buffers.setReleaseCallback(+[](const BufferQueue::Buffer &B) {
+    ++ReleasedBuffers;
+    ReleasedExtents += atomic_load_relaxed(B.Extents);
+  });
+
+  BufferQueue::Buffer B;
+  ASSERT_EQ(Buffers.getBuffer(B), BufferQueue::ErrorCode::Ok);
+  atomic_store_relaxed(B.Extents, 42);
+  ASSERT_EQ(Buffers.releaseBuffer(B), BufferQueue::ErrorCode::Ok);
+  EXPECT_EQ(ReleasedBuffers, 1u);
+  EXPECT_EQ(ReleasedExtents, 42u);
+
+  // Buffers from a previous generation aren't passed to the callback.
+  ASSERT_EQ(Buffers.getBuffer(B), BufferQueue::ErrorCode::Ok);
+  ASSERT_EQ(Buffers.finalize(), BufferQueue::ErrorCode::Ok);
+  ASSERT_EQ(Buffers.init(kSize, 2), BufferQueue::ErrorCode::Ok);
+  ASSERT_EQ(Buffers.releaseBuffer(B), BufferQueue::ErrorCode::Ok);
+  EXPECT_EQ(ReleasedBuffers, 1u);
+
+  Buffers.setReleaseCallback(nullptr);
+  ASSERT_EQ(Buffers.getBuffer(B), BufferQueue::ErrorCode::Ok);
+  ASSERT_EQ(Buffers.releaseBuffer(B), BufferQueue::ErrorCode::Ok);
+  EXPECT_EQ(ReleasedBuffers, 1u);
+}
+
 TEST(BufferQueueTest, GenerationalSupport) {
   bool Success = false;
   BufferQueue Buffers(kSize, 10, Success);
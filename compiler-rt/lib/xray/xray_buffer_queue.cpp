@@ -154,7 +154,8 @@ BufferQueue::BufferQueue(size_t B, size_t N,
       Next(Buffers),
       First(Buffers),
       LiveBuffers(0),
-      Generation{0} {
+      Generation{0},
+      OnRelease{0} {
   Success = init(B, N) == BufferQueue::ErrorCode::Ok;
 }
 
@@ -182,6 +183,13 @@ BufferQueue::ErrorCode BufferQueue::getBuffer(Buffer &Buf) {
 }
 
 BufferQueue::ErrorCode BufferQueue::releaseBuffer(Buffer &Buf) {
+  // Run the callback while this thread still owns the buffer; once it is back
+  // in the queue, another thread may get it and start overwriting it.
+  if (auto CB = reinterpret_cast<ReleaseCallback>(
+          atomic_load(&OnRelease, memory_order_acquire)))
+    if (Buf.Generation == generation() && ownsBuffer(Buf))
+      CB(Buf);
+
   // Check whether the buffer being referred to is within the bounds of the
   // backing store's range.
   BufferRep *B = nullptr;
@@ -194,8 +202,7 @@ BufferQueue::ErrorCode BufferQueue::releaseBuffer(Buffer &Buf) {
       return BufferQueue::ErrorCode::Ok;
     }
 
-    if (Buf.Data < &BackingStore->Data ||
-        Buf.Data > &BackingStore->Data + (BufferCount * BufferSize))
+    if (!ownsBuffer(Buf))
       return BufferQueue::ErrorCode::UnrecognizedBuffer;
 
     --LiveBuffers;
@@ -215,6 +222,11 @@ BufferQueue::ErrorCode BufferQueue::releaseBuffer(Buffer &Buf) {
   return ErrorCode::Ok;
 }
 
+bool BufferQueue::ownsBuffer(const Buffer &Buf) const {
+  return BackingStore != nullptr && Buf.Data >= &BackingStore->Data &&
+         Buf.Data <= &BackingStore->Data + (BufferCount * BufferSize);
+}
+
 BufferQueue::ErrorCode BufferQueue::finalize() {
   if (atomic_exchange(&Finalizing, 1, memory_order_acq_rel))
     return ErrorCode::QueueFinalizing;
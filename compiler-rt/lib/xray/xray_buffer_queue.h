@@ -163,9 +163,15 @@ private:
   // associated with.
   atomic_uint64_t Generation;
 
+  // The ReleaseCallback to invoke from releaseBuffer, if any.
+  atomic_uintptr_t OnRelease;
+
   /// Releases references to the buffers backed by the current buffer queue.
   void cleanupBuffers();
 
+  /// Returns whether |Buf| points into the current backing store.
+  bool ownsBuffer(const Buffer &Buf) const;
+
 public:
   enum class ErrorCode : unsigned {
     Ok,
@@ -194,6 +200,10 @@ public:
     return "unknown error";
   }
 
+  /// A function that is called with each buffer of the current generation that
+  /// is released, before the buffer can be handed out again.
+  using ReleaseCallback = void (*)(const Buffer &);
+
   /// Initialise a queue of size |N| with buffers of size |B|. We report success
   /// through |Success|.
   BufferQueue(size_t B, size_t N, bool &Success);
@@ -237,6 +247,13 @@ public:
     return atomic_load(&Generation, memory_order_acquire);
   }
 
+  /// Sets the function called by releaseBuffer, or clears it if |CB| is null.
+  /// The callback runs on the releasing thread, which still owns the buffer, so
+  /// it may read the buffer's data up to its extents.
+  void setReleaseCallback(ReleaseCallback CB) {
+    atomic_store(&OnRelease, reinterpret_cast<uptr>(CB), memory_order_release);
+  }
+
   /// Returns the configured size of the buffers in the buffer queue.
   size_t ConfiguredBufferSize() const { return BufferSize; }
 
@@ -0,0 +1,24 @@
+// Check that with sample_interval_bytes only a sample of the allocations is
+// recorded. With an interval this large, none of the small allocations below
+// is expected to be sampled.
+
+// RUN: %clangxx_memprof -O0 %s -o %t
+// RUN: %env_memprof_opts=print_text=true:log_path=stdout %run %t | FileCheck %s --check-prefix=ALL
+// RUN: %env_memprof_opts=print_text=true:log_path=stdout:sample_interval_bytes=1000000000000000 %run %t | FileCheck %s --check-prefix=SAMPLED
+
+#include <stdlib.h>
+
+int main() {
+  for (int i = 0; i < 100; i++) {
+    volatile char *x = (char *)malloc(16);
+    x[0] = 0;
+    free((void *)x);
+  }
+  return 0;
+}
+
+// ALL: Recorded MIBs
+// ALL: alloc_count 100, size (ave/min/max) 16.00 / 16 / 16
+
+// SAMPLED: Recorded MIBs
+// SAMPLED-NOT: alloc_count 100
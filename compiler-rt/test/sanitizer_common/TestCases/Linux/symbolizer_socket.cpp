@@ -0,0 +1,61 @@
+// Check that the runtime symbolizes through an llvm-symbolizer started with
+// --listen when external_symbolizer_socket is set. The symbolizer path points
+// to a missing binary, so the frames can only be symbolized by the server.
+
+// RUN: %clangxx -O0 -g %s -o %t
+// RUN: rm -f %t.sock
+// RUN: %env_tool_opts=external_symbolizer_path=%t.missing/llvm-symbolizer:external_symbolizer_socket=%t.sock \
+// RUN:   %run %t %t.sock 2>&1 | FileCheck %s
+
+// The server runs on the host.
+// UNSUPPORTED: android
+
+#include <sanitizer/common_interface_defs.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static bool CanConnect(const char *path) {
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0)
+    return false;
+  sockaddr_un addr = {};
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+  bool ok = connect(fd, (sockaddr *)&addr, sizeof(addr)) == 0;
+  close(fd);
+  return ok;
+}
+
+__attribute__((noinline)) static void PrintStack() {
+  // CHECK: #1 {{.*}} in PrintStack{{.*}} {{.*}}symbolizer_socket.cpp:[[@LINE+1]]
+  __sanitizer_print_stack_trace();
+}
+
+int main(int argc, char **argv) {
+  const char *path = argv[1];
+  char listen[256];
+  snprintf(listen, sizeof(listen), "--listen=%s", path);
+  pid_t server = fork();
+  if (server == 0) {
+    execlp("llvm-symbolizer", "llvm-symbolizer", listen, nullptr);
+    _exit(1);
+  }
+  for (int i = 0; i != 600 && !CanConnect(path); ++i)
+    usleep(50000);
+
+  // CHECK: #2 {{.*}} in main {{.*}}symbolizer_socket.cpp:[[@LINE+1]]
+  PrintStack();
+  // The second trace is symbolized over the same connection.
+  // CHECK: #1 {{.*}} in PrintStack
+  // CHECK: #2 {{.*}} in main {{.*}}symbolizer_socket.cpp:[[@LINE+1]]
+  PrintStack();
+
+  kill(server, SIGTERM);
+  waitpid(server, nullptr, 0);
+  return 0;
+}
@@ -0,0 +1,36 @@
+// RUN: %clang_tsan -O1 %s -o %t
+// RUN: %deflake %env_tsan_opts=sample_memory_accesses=1 %run %t 2>&1 | FileCheck %s --check-prefix=ALL
+// RUN: %env_tsan_opts=sample_memory_accesses=1000000:verbosity=1 %run %t 2>&1 | FileCheck %s --check-prefix=SAMPLED
+#include "test.h"
+
+int Global;
+
+void *Thread1(void *x) {
+  barrier_wait(&barrier);
+  Global = 42;
+  return NULL;
+}
+
+void *Thread2(void *x) {
+  Global = 43;
+  barrier_wait(&barrier);
+  return NULL;
+}
+
+int main() {
+  barrier_init(&barrier, 2);
+  pthread_t t[2];
+  pthread_create(&t[0], NULL, Thread1, NULL);
+  pthread_create(&t[1], NULL, Thread2, NULL);
+  pthread_join(t[0], NULL);
+  pthread_join(t[1], NULL);
+  fprintf(stderr, "DONE\n");
+  return 0;
+}
+
+// ALL: WARNING: ThreadSanitizer: data race
+
+// The first accesses of each thread are sampled out.
+// SAMPLED: ThreadSanitizer: checking 1 in 1000000 memory accesses
+// SAMPLED-NOT: data race
+// SAMPLED: DONE
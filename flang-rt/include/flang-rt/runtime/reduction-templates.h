@@ -27,6 +27,8 @@
 #include "tools.h"
 #include "flang/Runtime/cpp-type.h"
 #include <algorithm>
+#include <type_traits>
+#include <utility>
 
 namespace Fortran::runtime {
 
@@ -38,6 +40,16 @@ namespace Fortran::runtime {
 // array and does something with a scalar element, and a GetResult()
 // member function that copies a final result into its destination.
 
+// Accumulators whose AccumulateAt() merely passes the element to an
+// Accumulate() member function can also be fed the elements of a contiguous
+// array directly, which avoids the per-element subscript arithmetic.
+template <typename ACCUMULATOR, typename TYPE, typename = void>
+struct AccumulatesElements : std::false_type {};
+template <typename ACCUMULATOR, typename TYPE>
+struct AccumulatesElements<ACCUMULATOR, TYPE,
+    std::void_t<decltype(std::declval<ACCUMULATOR &>().Accumulate(
+        std::declval<const TYPE &>()))>> : std::true_type {};
+
 // Total reduction of the array argument to a scalar (or to a vector in the
 // cases of FINDLOC, MAXLOC, & MINLOC).  These are the cases without DIM= or
 // cases where the argument has rank 1 and DIM=, if present, must be 1.
@@ -71,6 +83,18 @@ inline RT_API_ATTRS void DoTotalReduction(const Descriptor &x, int dim,
     }
   }
   // No MASK=, or scalar MASK=.TRUE.
+  if constexpr (!std::is_void_v<TYPE> &&
+      AccumulatesElements<ACCUMULATOR, TYPE>::value) {
+    if (x.IsContiguous()) {
+      const TYPE *p{x.OffsetElement<const TYPE>()};
+      for (auto elements{x.Elements()}; elements--; ++p) {
+        if (!accumulator.Accumulate(*p)) {
+          break; // cut short, result is known
+        }
+      }
+      return;
+    }
+  }
   for (auto elements{x.Elements()}; elements--; x.IncrementSubscripts(xAt)) {
     if (!accumulator.template AccumulateAt<TYPE>(xAt)) {
       break; // cut short, result is known
@@ -36,6 +36,24 @@ TEST(Reductions, Int4Ops) {
   EXPECT_EQ(eor, 7) << eor;
 }
 
+TEST(Reductions, ContiguousAndStrided) {
+  auto array{MakeArray<TypeCategory::Real, 8>(std::vector<int>{8},
+      std::vector<double>{1, 2, 3, 4, 5, 6, 7, 8})};
+  EXPECT_TRUE(array->IsContiguous());
+  EXPECT_EQ(RTNAME(SumReal8)(*array, __FILE__, __LINE__), 36.0);
+  EXPECT_EQ(RTNAME(ProductReal8)(*array, __FILE__, __LINE__), 40320.0);
+  EXPECT_EQ(RTNAME(MaxvalReal8)(*array, __FILE__, __LINE__), 8.0);
+  EXPECT_EQ(RTNAME(MinvalReal8)(*array, __FILE__, __LINE__), 1.0);
+
+  // View every other element, as with array(1:8:2).
+  array->GetDimension(0).SetExtent(4).SetByteStride(2 * sizeof(double));
+  EXPECT_FALSE(array->IsContiguous());
+  EXPECT_EQ(RTNAME(SumReal8)(*array, __FILE__, __LINE__), 16.0);
+  EXPECT_EQ(RTNAME(ProductReal8)(*array, __FILE__, __LINE__), 105.0);
+  EXPECT_EQ(RTNAME(MaxvalReal8)(*array, __FILE__, __LINE__), 7.0);
+  EXPECT_EQ(RTNAME(MinvalReal8)(*array, __FILE__, __LINE__), 1.0);
+}
+
 TEST(Reductions, DimMaskProductInt4) {
   std::vector<int> shape{2, 3};
   auto array{MakeArray<TypeCategory::Integer, 4>(
@@ -0,0 +1,89 @@
+// Compares the llvm libc pthread mutexes compiled for the host machine with
+// the ones of the system libc, for several threads contending for a mutex
+// around critical sections of various lengths.
+
+#include "src/__support/macros/config.h"
+#include "benchmark/benchmark.h"
+#include <pthread.h>
+
+namespace LIBC_NAMESPACE_DECL {
+
+extern int pthread_mutex_init(pthread_mutex_t *, const pthread_mutexattr_t *);
+extern int pthread_mutex_lock(pthread_mutex_t *);
+extern int pthread_mutex_unlock(pthread_mutex_t *);
+extern int pthread_mutexattr_init(pthread_mutexattr_t *);
+extern int pthread_mutexattr_setprotocol(pthread_mutexattr_t *, int);
+
+} // namespace LIBC_NAMESPACE_DECL
+
+namespace {
+
+struct LlvmLibc {
+  static int init(pthread_mutex_t *Mutex, int Protocol) {
+    pthread_mutexattr_t Attr;
+    LIBC_NAMESPACE::pthread_mutexattr_init(&Attr);
+    LIBC_NAMESPACE::pthread_mutexattr_setprotocol(&Attr, Protocol);
+    return LIBC_NAMESPACE::pthread_mutex_init(Mutex, &Attr);
+  }
+  static int lock(pthread_mutex_t *Mutex) {
+    return LIBC_NAMESPACE::pthread_mutex_lock(Mutex);
+  }
+  static int unlock(pthread_mutex_t *Mutex) {
+    return LIBC_NAMESPACE::pthread_mutex_unlock(Mutex);
+  }
+};
+
+struct System {
+  static int init(pthread_mutex_t *Mutex, int Protocol) {
+    pthread_mutexattr_t Attr;
+    ::pthread_mutexattr_init(&Attr);
+    ::pthread_mutexattr_setprotocol(&Attr, Protocol);
+    return ::pthread_mutex_init(Mutex, &Attr);
+  }
+  static int lock(pthread_mutex_t *Mutex) { return ::pthread_mutex_lock(Mutex); }
+  static int unlock(pthread_mutex_t *Mutex) {
+    return ::pthread_mutex_unlock(Mutex);
+  }
+};
+
+// Each benchmark has its own mutex, set up by its first thread. The other
+// threads only start their timed loop once it is done.
+template <typename Impl, int Protocol> pthread_mutex_t Mutex;
+
+// Stands for the work of a critical section, in iterations of a loop that
+// the compiler cannot remove.
+void work(int64_t Length) {
+  for (int64_t I = 0; I < Length; ++I)
+    benchmark::DoNotOptimize(I);
+}
+
+template <typename Impl, int Protocol>
+void BM_Mutex(benchmark::State &State) {
+  const int64_t Inside = State.range(0);
+  const int64_t Outside = State.range(1);
+  if (State.thread_index() == 0)
+    Impl::init(&Mutex<Impl, Protocol>, Protocol);
+  for (auto _ : State) {
+    Impl::lock(&Mutex<Impl, Protocol>);
+    work(Inside);
+    Impl::unlock(&Mutex<Impl, Protocol>);
+    work(Outside);
+  }
+  State.SetItemsProcessed(State.iterations());
+}
+
+} // namespace
+
+// Critical sections that are empty, short and long, separated by short and
+// long stretches of work outside of the mutex.
+#define BENCHMARK_MUTEX(IMPL, PROTOCOL, NAME)                                  \
+  BENCHMARK(BM_Mutex<IMPL, PROTOCOL>)                                          \
+      ->Name("BM_Mutex/" NAME)                                                 \
+      ->ArgsProduct({{0, 50, 1000}, {50, 1000}})                               \
+      ->ThreadRange(1, 16)                                                     \
+      ->UseRealTime()
+
+BENCHMARK_MUTEX(LlvmLibc, PTHREAD_PRIO_NONE, "llvm-libc");
+BENCHMARK_MUTEX(System, PTHREAD_PRIO_NONE, "system");
+BENCHMARK_MUTEX(LlvmLibc, PTHREAD_PRIO_INHERIT, "llvm-libc/prio-inherit");
+BENCHMARK_MUTEX(System, PTHREAD_PRIO_INHERIT, "system/prio-inherit");
@@ -0,0 +1,107 @@
+// Compares the llvm libc qsort compiled for the host machine with the one of
+// the system libc, for arrays of various element sizes, lengths and orders.
+
+#include "src/__support/macros/config.h"
+#include "benchmark/benchmark.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace LIBC_NAMESPACE_DECL {
+
+extern void qsort(void *, size_t, size_t, int (*)(const void *, const void *));
+
+} // namespace LIBC_NAMESPACE_DECL
+
+namespace {
+
+// The order of the keys of the array before sorting.
+enum InputOrder {
+  Random,
+  Sorted,
+  ReverseSorted,
+  // Random keys from a small set.
+  FewUnique,
+  // Sorted runs of 64 elements.
+  SawTooth,
+};
+
+// Elements with a 32 bit key, followed by padding up to Size bytes.
+template <size_t Size> struct Element {
+  static_assert(Size >= sizeof(uint32_t));
+  uint32_t Key;
+  char Padding[Size - sizeof(uint32_t)];
+};
+
+template <size_t Size> int compareElements(const void *L, const void *R) {
+  uint32_t LK = static_cast<const Element<Size> *>(L)->Key;
+  uint32_t RK = static_cast<const Element<Size> *>(R)->Key;
+  return (LK > RK) - (LK < RK);
+}
+
+template <size_t Size> std::vector<Element<Size>> makeInput(size_t Length,
+                                                            InputOrder Order) {
+  std::vector<Element<Size>> Array(Length);
+  uint32_t Seed = 42;
+  for (size_t I = 0; I < Length; ++I) {
+    Seed = Seed * 1103515245 + 12345;
+    uint32_t Key = 0;
+    switch (Order) {
+    case Random:
+      Key = Seed;
+      break;
+    case Sorted:
+      Key = static_cast<uint32_t>(I);
+      break;
+    case ReverseSorted:
+      Key = static_cast<uint32_t>(Length - I);
+      break;
+    case FewUnique:
+      Key = (Seed >> 16) % 16;
+      break;
+    case SawTooth:
+      Key = static_cast<uint32_t>(I % 64);
+      break;
+    }
+    std::memset(&Array[I], 0, Size);
+    Array[I].Key = Key;
+  }
+  return Array;
+}
+
+using QsortFunction = void (*)(void *, size_t, size_t,
+                               int (*)(const void *, const void *));
+
+template <QsortFunction Function, size_t Size>
+void BM_Qsort(benchmark::State &State) {
+  const size_t Length = State.range(0);
+  const auto Input = makeInput<Size>(Length, InputOrder(State.range(1)));
+  auto Array = Input;
+  for (auto _ : State) {
+    State.PauseTiming();
+    Array = Input;
+    State.ResumeTiming();
+    Function(Array.data(), Length, Size, compareElements<Size>);
+    benchmark::ClobberMemory();
+  }
+  State.SetItemsProcessed(State.iterations() * Length);
+}
+
+} // namespace
+
+#define BENCHMARK_QSORT(SIZE)                                                  \
+  BENCHMARK(BM_Qsort<LIBC_NAMESPACE::qsort, SIZE>)                             \
+      ->Name("BM_Qsort/" #SIZE "/llvm-libc")                                   \
+      ->ArgsProduct({{16, 1024, 1 << 20}, {Random, Sorted, ReverseSorted,     \
+                                           FewUnique, SawTooth}});             \
+  BENCHMARK(BM_Qsort<::qsort, SIZE>)                                           \
+      ->Name("BM_Qsort/" #SIZE "/system")                                      \
+      ->ArgsProduct({{16, 1024, 1 << 20}, {Random, Sorted, ReverseSorted,     \
+                                           FewUnique, SawTooth}})
+
+BENCHMARK_QSORT(4);
+BENCHMARK_QSORT(8);
+BENCHMARK_QSORT(16);
+BENCHMARK_QSORT(40);
@@ -0,0 +1,167 @@
+// Compares the llvm libc string functions compiled for the host machine with
+// the ones of the system libc, for strings of various lengths.
+
+#include "src/__support/macros/config.h"
+#include "benchmark/benchmark.h"
+#include <cstddef>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace LIBC_NAMESPACE_DECL {
+
+extern size_t strlen(const char *);
+extern char *strchr(const char *, int);
+extern char *strrchr(const char *, int);
+extern int strcmp(const char *, const char *);
+extern int strncmp(const char *, const char *, size_t);
+extern void *memmem(const void *, size_t, const void *, size_t);
+
+} // namespace LIBC_NAMESPACE_DECL
+
+namespace {
+
+// A string of the given length that doesn't contain the searched character.
+// The string starts one byte past an aligned address so that the unaligned
+// head is measured as well.
+struct StringInput {
+  explicit StringInput(size_t Length)
+      : Storage(Length + 2, 'a'), Str(Storage.data() + 1) {
+    Storage.back() = '\0';
+  }
+  std::string Storage;
+  const char *Str;
+};
+
+template <size_t (*Function)(const char *)>
+void BM_Strlen(benchmark::State &State) {
+  StringInput Input(State.range(0));
+  for (auto _ : State) {
+    benchmark::DoNotOptimize(Input.Str);
+    benchmark::DoNotOptimize(Function(Input.Str));
+  }
+  State.SetBytesProcessed(State.iterations() * State.range(0));
+}
+
+template <char *(*Function)(const char *, int)>
+void BM_Strchr(benchmark::State &State) {
+  StringInput Input(State.range(0));
+  for (auto _ : State) {
+    benchmark::DoNotOptimize(Input.Str);
+    benchmark::DoNotOptimize(Function(Input.Str, 'b'));
+  }
+  State.SetBytesProcessed(State.iterations() * State.range(0));
+}
+
+template <int (*Function)(const char *, const char *)>
+void BM_Strcmp(benchmark::State &State) {
+  StringInput Left(State.range(0));
+  StringInput Right(State.range(0));
+  for (auto _ : State) {
+    benchmark::DoNotOptimize(Left.Str);
+    benchmark::DoNotOptimize(Function(Left.Str, Right.Str));
+  }
+  State.SetBytesProcessed(State.iterations() * State.range(0));
+}
+
+template <int (*Function)(const char *, const char *, size_t)>
+void BM_Strncmp(benchmark::State &State) {
+  StringInput Left(State.range(0));
+  StringInput Right(State.range(0));
+  for (auto _ : State) {
+    benchmark::DoNotOptimize(Left.Str);
+    benchmark::DoNotOptimize(Function(Left.Str, Right.Str, State.range(0)));
+  }
+  State.SetBytesProcessed(State.iterations() * State.range(0));
+}
+
+// The needles of the substring searches, in a 1 MiB haystack that doesn't
+// contain them.
+enum NeedleKind {
+  // A short needle in random text.
+  ShortNeedle,
+  // A long needle in random text.
+  LongNeedle,
+  // "aaa...aba...aaa" in a haystack of 'a's, which makes a naive search
+  // quadratic.
+  PathologicalNeedle,
+};
+
+template <void *(*Function)(const void *, size_t, const void *, size_t)>
+void BM_Memmem(benchmark::State &State) {
+  const size_t HaystackLength = 1 << 20;
+  std::vector<char> Haystack(HaystackLength);
+  std::string Needle;
+  switch (State.range(0)) {
+  case ShortNeedle:
+  case LongNeedle: {
+    // Text with the letter frequencies of a small alphabet.
+    unsigned Seed = 42;
+    for (char &C : Haystack) {
+      Seed = Seed * 1103515245 + 12345;
+      C = 'a' + (Seed >> 16) % 16;
+    }
+    Needle = State.range(0) == ShortNeedle ? "abcdefz"
+                                           : std::string(256, 'a') + "z";
+    break;
+  }
+  case PathologicalNeedle:
+    std::fill(Haystack.begin(), Haystack.end(), 'a');
+    Needle = std::string(32, 'a') + 'b' + std::string(32, 'a');
+    break;
+  }
+  for (auto _ : State) {
+    benchmark::DoNotOptimize(Haystack.data());
+    benchmark::DoNotOptimize(Function(Haystack.data(), Haystack.size(),
+                                      Needle.data(), Needle.size()));
+  }
+  State.SetBytesProcessed(State.iterations() * HaystackLength);
+}
+
+// Wrappers so that the system functions have the same signatures in C and C++.
+size_t SystemStrlen(const char *S) { return ::strlen(S); }
+char *SystemStrchr(const char *S, int C) {
+  return const_cast<char *>(::strchr(S, C));
+}
+char *SystemStrrchr(const char *S, int C) {
+  return const_cast<char *>(::strrchr(S, C));
+}
+int SystemStrcmp(const char *L, const char *R) { return ::strcmp(L, R); }
+int SystemStrncmp(const char *L, const char *R, size_t N) {
+  return ::strncmp(L, R, N);
+}
+void *SystemMemmem(const void *H, size_t HL, const void *N, size_t NL) {
+  return ::memmem(H, HL, N, NL);
+}
+
+} // namespace
+
+#define BENCHMARK_STRING_FUNCTION(NAME, BM_TEMPLATE, LIBC_FUNCTION,           \
+                                  SYSTEM_FUNCTION)                             \
+  BENCHMARK(BM_TEMPLATE<LIBC_FUNCTION>)                                        \
+      ->Name(NAME "/llvm-libc")                                                \
+      ->RangeMultiplier(4)                                                     \
+      ->Range(1, 1 << 16);                                                     \
+  BENCHMARK(BM_TEMPLATE<SYSTEM_FUNCTION>)                                      \
+      ->Name(NAME "/system")                                                   \
+      ->RangeMultiplier(4)                                                     \
+      ->Range(1, 1 << 16)
+
+BENCHMARK_STRING_FUNCTION("BM_Strlen", BM_Strlen, LIBC_NAMESPACE::strlen,
+                          SystemStrlen);
+BENCHMARK_STRING_FUNCTION("BM_Strchr", BM_Strchr, LIBC_NAMESPACE::strchr,
+                          SystemStrchr);
+BENCHMARK_STRING_FUNCTION("BM_Strrchr", BM_Strchr, LIBC_NAMESPACE::strrchr,
+                          SystemStrrchr);
+BENCHMARK_STRING_FUNCTION("BM_Strcmp", BM_Strcmp, LIBC_NAMESPACE::strcmp,
+                          SystemStrcmp);
+BENCHMARK_STRING_FUNCTION("BM_Strncmp", BM_Strncmp, LIBC_NAMESPACE::strncmp,
+                          SystemStrncmp);
+
+BENCHMARK(BM_Memmem<LIBC_NAMESPACE::memmem>)
+    ->Name("BM_Memmem/llvm-libc")
+    ->DenseRange(ShortNeedle, PathologicalNeedle);
+BENCHMARK(BM_Memmem<SystemMemmem>)
+    ->Name("BM_Memmem/system")
+    ->DenseRange(ShortNeedle, PathologicalNeedle);
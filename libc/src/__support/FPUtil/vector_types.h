@@ -0,0 +1,31 @@
+//===-- Fixed size vector types for math functions --------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC___SUPPORT_FPUTIL_VECTOR_TYPES_H
+#define LLVM_LIBC_SRC___SUPPORT_FPUTIL_VECTOR_TYPES_H
+
+#include "src/__support/macros/config.h"
+
+#include <stdint.h>
+
+namespace LIBC_NAMESPACE_DECL {
+namespace fputil {
+
+// The 128-bit vectors are the ones passed in a single register by the x86 SSE
+// and the AArch64 Advanced SIMD vector function ABIs.
+using v2f32 = float __attribute__((__vector_size__(8)));
+using v4f32 = float __attribute__((__vector_size__(16)));
+using v4i32 = int32_t __attribute__((__vector_size__(16)));
+using v4u32 = uint32_t __attribute__((__vector_size__(16)));
+using v2f64 = double __attribute__((__vector_size__(16)));
+using v2i64 = int64_t __attribute__((__vector_size__(16)));
+
+} // namespace fputil
+} // namespace LIBC_NAMESPACE_DECL
+
+#endif // LLVM_LIBC_SRC___SUPPORT_FPUTIL_VECTOR_TYPES_H
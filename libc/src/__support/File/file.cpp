@@ -39,6 +39,22 @@ FileIOResult File::write_unlocked(const void *data, size_t len) {
 }
 
 FileIOResult File::write_unlocked_nbf(const uint8_t *data, size_t len) {
+  if (pos > 0 && platform_writev != nullptr) {
+    // Write the buffer and the data together, instead of one after the other.
+    const size_t write_size = pos;
+    FileIOResult write_result =
+        platform_writev(this, buf, write_size, data, len);
+    pos = 0; // Buffer is now empty so reset pos to the beginning.
+    if (write_result < write_size + len) {
+      err = true;
+      // Only the bytes written after the buffer are from data.
+      size_t data_written =
+          write_result <= write_size ? 0 : write_result - write_size;
+      return {data_written, write_result.error};
+    }
+    return len;
+  }
+
   if (pos > 0) { // If the buffer is not empty
     // Flush the buffer
     const size_t write_size = pos;
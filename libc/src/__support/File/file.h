@@ -14,9 +14,14 @@
 #include "src/__support/CPP/new.h"
 #include "src/__support/error_or.h"
 #include "src/__support/macros/config.h"
+#include "src/__support/macros/optimization.h"
 #include "src/__support/macros/properties/architectures.h"
 #include "src/__support/threads/mutex.h"
 
+#ifdef LIBC_FULL_BUILD
+#include "src/__support/threads/thread.h"
+#endif // LIBC_FULL_BUILD
+
 #include <stddef.h>
 #include <stdint.h>
 
@@ -45,6 +50,10 @@ public:
   using UnlockFunc = void(File *);
 
   using WriteFunc = FileIOResult(File *, const void *, size_t);
+  // Writes the bytes of the first range followed by the ones of the second in
+  // a single operation, and returns the number of bytes written from both.
+  using WritevFunc = FileIOResult(File *, const void *, size_t, const void *,
+                                  size_t);
   using ReadFunc = FileIOResult(File *, void *, size_t);
   // The SeekFunc is expected to return the current offset of the external
   // file position indicator.
@@ -86,6 +95,9 @@ private:
   ReadFunc *platform_read;
   SeekFunc *platform_seek;
   CloseFunc *platform_close;
+  // Optional, the buffer and the data of large writes are written with two
+  // calls to platform_write without it.
+  WritevFunc *platform_writev;
 
   Mutex mutex;
 
@@ -120,14 +132,23 @@ private:
   bool eof;
   bool err;
 
-  // This is a convenience RAII class to lock and unlock file objects.
+  // This is a convenience RAII class to lock and unlock file objects. The lock
+  // is not taken while the process has a single thread, since no other thread
+  // can access the file before it is released.
   class FileLock {
     File *file;
+    bool locked;
 
   public:
-    explicit FileLock(File *f) : file(f) { file->lock(); }
+    explicit FileLock(File *f) : file(f), locked(is_shared()) {
+      if (locked)
+        file->lock();
+    }
 
-    ~FileLock() { file->unlock(); }
+    ~FileLock() {
+      if (locked)
+        file->unlock();
+    }
 
     FileLock(const FileLock &) = delete;
     FileLock(FileLock &&) = delete;
@@ -155,10 +176,11 @@ public:
   // the set_buffer method and allocate a buffer.
   constexpr File(WriteFunc *wf, ReadFunc *rf, SeekFunc *sf, CloseFunc *cf,
                  uint8_t *buffer, size_t buffer_size, int buffer_mode,
-                 bool owned, ModeFlags modeflags)
+                 bool owned, ModeFlags modeflags, WritevFunc *wvf = nullptr)
       : platform_write(wf), platform_read(rf), platform_seek(sf),
-        platform_close(cf), mutex(/*timed=*/false, /*recursive=*/false,
-                                  /*robust=*/false, /*pshared=*/false),
+        platform_close(cf), platform_writev(wvf),
+        mutex(/*timed=*/false, /*recursive=*/false,
+              /*robust=*/false, /*pshared=*/false),
         ungetc_buf(0), buf(buffer), bufsize(buffer_size), bufmode(buffer_mode),
         own_buf(owned), mode(modeflags), pos(0), prev_op(FileOp::NONE),
         read_limit(0), eof(false), err(false) {
@@ -174,6 +196,23 @@ public:
     return write_unlocked(data, len);
   }
 
+  // Buffered write of the byte |c| without the file lock. The byte is stored
+  // in the buffer directly if that's all write_unlocked would do.
+  FileIOResult write_byte_unlocked(uint8_t c) {
+    if (LIBC_LIKELY(prev_op == FileOp::WRITE && pos < bufsize &&
+                    (bufmode == _IOFBF || (bufmode == _IOLBF && c != '\n')))) {
+      buf[pos++] = c;
+      return 1;
+    }
+    return write_unlocked(&c, 1);
+  }
+
+  // Buffered write of the byte |c| under the file lock.
+  FileIOResult write_byte(uint8_t c) {
+    FileLock l(this);
+    return write_byte_unlocked(c);
+  }
+
   // Buffered read of |len| bytes into |data| without the file lock.
   FileIOResult read_unlocked(void *data, size_t len);
 
@@ -183,6 +222,22 @@ public:
     return read_unlocked(data, len);
   }
 
+  // Buffered read of one byte into |c| without the file lock. The byte is read
+  // from the buffer directly if it has one.
+  FileIOResult read_byte_unlocked(uint8_t &c) {
+    if (LIBC_LIKELY(prev_op == FileOp::READ && pos < read_limit)) {
+      c = buf[pos++];
+      return 1;
+    }
+    return read_unlocked(&c, 1);
+  }
+
+  // Buffered read of one byte into |c| under the file lock.
+  FileIOResult read_byte(uint8_t &c) {
+    FileLock l(this);
+    return read_byte_unlocked(c);
+  }
+
   ErrorOr<int> seek(off_t offset, int whence);
 
   ErrorOr<off_t> tell();
@@ -276,6 +331,17 @@ public:
   static ModeFlags mode_flags(const char *mode);
 
 private:
+  // Whether other threads can access the file, in which case it has to be
+  // locked. Only known in full build mode, where the threads are created by
+  // this libc.
+  static bool is_shared() {
+#ifdef LIBC_FULL_BUILD
+    return process_is_multithreaded.load(cpp::MemoryOrder::RELAXED);
+#else
+    return true;
+#endif // LIBC_FULL_BUILD
+  }
+
   FileIOResult write_unlocked_lbf(const uint8_t *data, size_t len);
   FileIOResult write_unlocked_fbf(const uint8_t *data, size_t len);
   FileIOResult write_unlocked_nbf(const uint8_t *data, size_t len);
@@ -10,6 +10,7 @@
 
 #include "hdr/stdio_macros.h"
 #include "hdr/types/off_t.h"
+#include "hdr/types/struct_iovec.h"
 #include "src/__support/CPP/new.h"
 #include "src/__support/File/file.h"
 #include "src/__support/File/linux/lseekImpl.h"
@@ -34,6 +35,19 @@ FileIOResult linux_file_write(File *f, const void *data, size_t size) {
   return ret;
 }
 
+FileIOResult linux_file_writev(File *f, const void *data1, size_t size1,
+                               const void *data2, size_t size2) {
+  auto *lf = reinterpret_cast<LinuxFile *>(f);
+  iovec iov[2] = {{const_cast<void *>(data1), size1},
+                  {const_cast<void *>(data2), size2}};
+  long ret =
+      LIBC_NAMESPACE::syscall_impl<long>(SYS_writev, lf->get_fd(), iov, 2);
+  if (ret < 0) {
+    return {0, static_cast<int>(-ret)};
+  }
+  return static_cast<size_t>(ret);
+}
+
 FileIOResult linux_file_read(File *f, void *buf, size_t size) {
   auto *lf = reinterpret_cast<LinuxFile *>(f);
   int ret =
@@ -13,6 +13,8 @@
 namespace LIBC_NAMESPACE_DECL {
 
 FileIOResult linux_file_write(File *, const void *, size_t);
+FileIOResult linux_file_writev(File *, const void *, size_t, const void *,
+                               size_t);
 FileIOResult linux_file_read(File *, void *, size_t);
 ErrorOr<off_t> linux_file_seek(File *, off_t, int);
 int linux_file_close(File *);
@@ -25,7 +27,7 @@ public:
                       int buffer_mode, bool owned, File::ModeFlags modeflags)
       : File(&linux_file_write, &linux_file_read, &linux_file_seek,
              &linux_file_close, buffer, buffer_size, buffer_mode, owned,
-             modeflags),
+             modeflags, &linux_file_writev),
         fd(file_descriptor) {}
 
   int get_fd() const { return fd; }
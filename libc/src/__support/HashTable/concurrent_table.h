@@ -0,0 +1,78 @@
+//===-- HashTable shared between threads ------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC___SUPPORT_HASHTABLE_CONCURRENT_TABLE_H
+#define LLVM_LIBC_SRC___SUPPORT_HASHTABLE_CONCURRENT_TABLE_H
+
+#include "include/llvm-libc-types/ENTRY.h"
+#include "src/__support/CPP/optional.h"
+#include "src/__support/HashTable/table.h"
+#include "src/__support/macros/attributes.h"
+#include "src/__support/macros/config.h"
+#include "src/__support/macros/optimization.h"
+#include "src/__support/threads/linux/rwlock.h"
+#include <stddef.h>
+#include <stdint.h>
+
+namespace LIBC_NAMESPACE_DECL {
+namespace internal {
+
+// A HashTable that can be used by several threads at once. Lookups only take
+// the lock as readers, so they proceed in parallel. Insertions take it as a
+// writer, since they may grow the table and move all of its entries.
+//
+// As the entries move, the results are returned by value rather than as
+// pointers into the table.
+class ConcurrentHashTable {
+  HashTable *table;
+  RwLock lock;
+
+public:
+  LIBC_INLINE constexpr ConcurrentHashTable() : table(nullptr), lock() {}
+
+  // Allocates the table for capacity entries, which it grows beyond as
+  // needed. Returns false if the allocation failed.
+  [[nodiscard]] LIBC_INLINE bool initialize(size_t capacity,
+                                            uint64_t randomness) {
+    table = HashTable::allocate(capacity, randomness);
+    return table != nullptr;
+  }
+
+  // Frees the table. There must not be any concurrent access.
+  LIBC_INLINE void destroy() {
+    HashTable::deallocate(table);
+    table = nullptr;
+  }
+
+  LIBC_INLINE cpp::optional<ENTRY> find(const char *key) {
+    if (LIBC_UNLIKELY(lock.read_lock() != RwLock::LockResult::Success))
+      return cpp::nullopt;
+    ENTRY *entry = table->find(key);
+    cpp::optional<ENTRY> result =
+        entry ? cpp::optional<ENTRY>(*entry) : cpp::nullopt;
+    [[maybe_unused]] RwLock::LockResult unlocked = lock.unlock();
+    return result;
+  }
+
+  // Inserts item if its key is not in the table yet. Returns the entry of the
+  // key, or nullopt if the table could not grow.
+  LIBC_INLINE cpp::optional<ENTRY> insert(ENTRY item) {
+    if (LIBC_UNLIKELY(lock.write_lock() != RwLock::LockResult::Success))
+      return cpp::nullopt;
+    ENTRY *entry = HashTable::insert(table, item);
+    cpp::optional<ENTRY> result =
+        entry ? cpp::optional<ENTRY>(*entry) : cpp::nullopt;
+    [[maybe_unused]] RwLock::LockResult unlocked = lock.unlock();
+    return result;
+  }
+};
+
+} // namespace internal
+} // namespace LIBC_NAMESPACE_DECL
+
+#endif // LLVM_LIBC_SRC___SUPPORT_HASHTABLE_CONCURRENT_TABLE_H
@@ -102,6 +102,15 @@ struct Fmt {
                 "WithPrefix is only for radix == 2, 8 or 16");
 };
 
+// The two decimal digits of each number from 0 to 99, so that the built-in
+// integers are written two digits per division.
+LIBC_INLINE_VAR constexpr char DECIMAL_DIGIT_PAIRS[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
 // Move this to a separate header since it might be useful elsewhere.
 template <bool forward> class StringBufferWriterImpl {
   cpp::span<char> buffer;
@@ -396,9 +405,28 @@ template <typename T, typename Fmt = radix::Dec> class IntegerToString {
     LIBC_INLINE static void
     write_unsigned_number_dec(UNSIGNED_T value,
                               details::BackwardStringBufferWriter &sink) {
-      while (sink.ok() && value != 0) {
-        const uint8_t digit = extract_decimal_digit(value);
-        sink.push(digit_char(digit));
+      if constexpr (cpp::is_integral_v<UNSIGNED_T>) {
+        for (; sink.ok() && value >= 100; value /= 100) {
+          const size_t pair = static_cast<size_t>(value % 100) * 2;
+          sink.push(details::DECIMAL_DIGIT_PAIRS[pair + 1]);
+          sink.push(details::DECIMAL_DIGIT_PAIRS[pair]);
+        }
+        // The loop above may stop early on overflow with 'value' still having
+        // more than two digits, which would index past the pair table.
+        if (!sink.ok())
+          return;
+        if (value >= 10) {
+          const size_t pair = static_cast<size_t>(value) * 2;
+          sink.push(details::DECIMAL_DIGIT_PAIRS[pair + 1]);
+          sink.push(details::DECIMAL_DIGIT_PAIRS[pair]);
+        } else if (value != 0) {
+          sink.push(digit_char(static_cast<uint8_t>(value)));
+        }
+      } else {
+        while (sink.ok() && value != 0) {
+          const uint8_t digit = extract_decimal_digit(value);
+          sink.push(digit_char(digit));
+        }
       }
     }
 
@@ -0,0 +1,474 @@
+//===-- Implementation for size_class_heap --------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/__support/size_class_heap.h"
+#include "src/__support/CPP/mutex.h"
+#include "src/__support/OSUtil/syscall.h" // For internal syscall function.
+#include "src/__support/macros/config.h"
+#include "src/__support/threads/callonce.h"
+#include "src/__support/threads/fork_callbacks.h"
+#include "src/string/memory_utils/inline_memcpy.h"
+#include "src/string/memory_utils/inline_memset.h"
+
+#include <linux/param.h> // For EXEC_PAGESIZE.
+#include <stddef.h>
+#include <sys/mman.h>    // For PROT_* and MAP_* definitions.
+#include <sys/syscall.h> // For syscall numbers.
+
+namespace LIBC_NAMESPACE_DECL {
+
+#ifdef SYS_mmap2
+static constexpr long MMAP_SYSCALL_NUMBER = SYS_mmap2;
+#elif defined(SYS_mmap)
+static constexpr long MMAP_SYSCALL_NUMBER = SYS_mmap;
+#else
+#error "mmap or mmap2 syscalls not available."
+#endif
+
+namespace {
+
+constexpr size_t PAGE_SIZE = EXEC_PAGESIZE;
+
+void *map(size_t size, int prot) {
+  long result = syscall_impl<long>(MMAP_SYSCALL_NUMBER, 0, size, prot,
+                                   MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE,
+                                   -1, 0);
+  if (result < 0 && static_cast<uintptr_t>(result) >= UINTPTR_MAX - size)
+    return nullptr;
+  return reinterpret_cast<void *>(result);
+}
+
+void unmap(void *addr, size_t size) {
+  syscall_impl<long>(SYS_munmap, addr, size);
+}
+
+// The divisors of the size classes as fixed point reciprocals, so that the
+// index of an object in its slab is computed with a multiplication. The
+// results are exact since slab offsets are below 2^18.
+constexpr unsigned RECIPROCAL_SHIFT = 40;
+struct Reciprocals {
+  uint64_t values[size_class::NUM_CLASSES] = {};
+  constexpr Reciprocals() {
+    for (size_t i = 0; i < size_class::NUM_CLASSES; ++i) {
+      uint64_t size = size_class::size_of(i);
+      values[i] = ((uint64_t(1) << RECIPROCAL_SHIFT) + size - 1) / size;
+    }
+  }
+};
+constexpr Reciprocals RECIPROCALS;
+
+// Large allocations are preceded by the mapping that contains them.
+struct LargeHeader {
+  void *base;
+  size_t size;
+};
+static_assert(sizeof(LargeHeader) <= alignof(max_align_t) * 2);
+constexpr size_t LARGE_HEADER_SIZE = 2 * alignof(max_align_t);
+
+} // namespace
+
+struct alignas(64) SizeClassHeap::Slab {
+  // Objects that were freed, then the objects that were never used, from
+  // unused to end.
+  FreeObject *free_list;
+  cpp::byte *unused;
+  cpp::byte *end;
+  // The list of the slabs of the size class with objects left.
+  Slab *prev;
+  Slab *next;
+  // The objects that are allocated or in thread caches.
+  uint32_t used;
+  uint32_t index;
+  bool listed;
+
+  LIBC_INLINE cpp::byte *objects() {
+    return reinterpret_cast<cpp::byte *>(this + 1);
+  }
+  LIBC_INLINE bool exhausted() const { return !free_list && unused == end; }
+};
+
+void *SizeClassHeap::object_start(const void *ptr) {
+  Slab *slab = slab_of(ptr);
+  uint64_t offset = static_cast<uint64_t>(static_cast<const cpp::byte *>(ptr) -
+                                          slab->objects());
+  uint64_t object =
+      (offset * RECIPROCALS.values[slab->index]) >> RECIPROCAL_SHIFT;
+  return slab->objects() + object * size_class::size_of(slab->index);
+}
+
+size_t SizeClassHeap::usable_size(const void *ptr) {
+  if (is_small(ptr)) {
+    const cpp::byte *start = static_cast<const cpp::byte *>(object_start(ptr));
+    return size_class::size_of(slab_of(ptr)->index) -
+           static_cast<size_t>(static_cast<const cpp::byte *>(ptr) - start);
+  }
+  const LargeHeader *header = reinterpret_cast<const LargeHeader *>(
+      static_cast<const cpp::byte *>(ptr) - LARGE_HEADER_SIZE);
+  size_t offset = static_cast<size_t>(static_cast<const cpp::byte *>(ptr) -
+                                      static_cast<cpp::byte *>(header->base));
+  return header->size - offset;
+}
+
+SizeClassHeap::Slab *SizeClassHeap::new_slab(size_t index) {
+  Slab *slab = nullptr;
+  {
+    cpp::lock_guard lock(region_lock);
+    if (released) {
+      slab = released;
+      released = slab->next;
+    } else {
+      if (region_begin.load(cpp::MemoryOrder::RELAXED) == 0) {
+        // Reserve the range with an extra slab, to align its start.
+        void *reserved = map(REGION_SIZE + SLAB_SIZE, PROT_NONE);
+        if (!reserved)
+          return nullptr;
+        uintptr_t begin =
+            (reinterpret_cast<uintptr_t>(reserved) + SLAB_SIZE - 1) &
+            ~(SLAB_SIZE - 1);
+        region_next = begin;
+        region_begin.store(begin, cpp::MemoryOrder::RELAXED);
+      }
+      uintptr_t begin = region_begin.load(cpp::MemoryOrder::RELAXED);
+      if (region_next - begin + SLAB_SIZE > REGION_SIZE)
+        return nullptr;
+      if (syscall_impl<long>(SYS_mprotect, region_next, SLAB_SIZE,
+                             PROT_READ | PROT_WRITE) != 0)
+        return nullptr;
+      slab = reinterpret_cast<Slab *>(region_next);
+      region_next += SLAB_SIZE;
+    }
+  }
+
+  size_t size = size_class::size_of(index);
+  size_t count = (SLAB_SIZE - sizeof(Slab)) / size;
+  slab->free_list = nullptr;
+  slab->unused = slab->objects();
+  slab->end = slab->objects() + count * size;
+  slab->prev = nullptr;
+  slab->next = nullptr;
+  slab->used = 0;
+  slab->index = static_cast<uint32_t>(index);
+  slab->listed = false;
+  return slab;
+}
+
+void SizeClassHeap::release_slab(Slab *slab) {
+  // The header stays in memory, to link the released slabs.
+  syscall_impl<long>(SYS_madvise,
+                     reinterpret_cast<cpp::byte *>(slab) + PAGE_SIZE,
+                     SLAB_SIZE - PAGE_SIZE, MADV_DONTNEED);
+  cpp::lock_guard lock(region_lock);
+  slab->next = released;
+  released = slab;
+}
+
+SizeClassHeap::FreeObject *SizeClassHeap::take(size_t index,
+                                               uint32_t &count) {
+  SizeClass &size_class = classes[index];
+  const size_t size = size_class::size_of(index);
+  FreeObject *list = nullptr;
+  uint32_t taken = 0;
+
+  cpp::lock_guard lock(size_class.lock);
+  while (taken < count) {
+    Slab *slab = size_class.partial;
+    if (!slab) {
+      slab = new_slab(index);
+      if (!slab)
+        break;
+      slab->listed = true;
+      size_class.partial = slab;
+    }
+    while (taken < count && !slab->exhausted()) {
+      FreeObject *object;
+      if (slab->free_list) {
+        object = slab->free_list;
+        slab->free_list = object->next;
+      } else {
+        object = reinterpret_cast<FreeObject *>(slab->unused);
+        slab->unused += size;
+      }
+      object->next = list;
+      list = object;
+      ++slab->used;
+      ++taken;
+    }
+    if (slab->exhausted()) {
+      size_class.partial = slab->next;
+      if (slab->next)
+        slab->next->prev = nullptr;
+      slab->next = nullptr;
+      slab->listed = false;
+    }
+  }
+  count = taken;
+  return list;
+}
+
+void SizeClassHeap::give_back(size_t index, FreeObject *list, uint32_t count) {
+  SizeClass &size_class = classes[index];
+  Slab *empty = nullptr;
+  {
+    cpp::lock_guard lock(size_class.lock);
+    for (; count != 0; --count) {
+      FreeObject *object = list;
+      list = list->next;
+      Slab *slab = slab_of(object);
+      object->next = slab->free_list;
+      slab->free_list = object;
+      --slab->used;
+      if (!slab->listed) {
+        slab->prev = nullptr;
+        slab->next = size_class.partial;
+        if (slab->next)
+          slab->next->prev = slab;
+        size_class.partial = slab;
+        slab->listed = true;
+      }
+      // Keep the slab if it is the only one with objects left, so that a
+      // size class that goes back and forth doesn't map slabs over and over.
+      if (slab->used == 0 && (slab->prev || slab->next)) {
+        if (slab->prev)
+          slab->prev->next = slab->next;
+        else
+          size_class.partial = slab->next;
+        if (slab->next)
+          slab->next->prev = slab->prev;
+        slab->listed = false;
+        slab->next = empty;
+        empty = slab;
+      }
+    }
+  }
+  while (empty) {
+    Slab *next = empty->next;
+    release_slab(empty);
+    empty = next;
+  }
+}
+
+void *SizeClassHeap::refill(ThreadCache &cache, size_t index) {
+  uint32_t count = cache.disabled ? 1 : size_class::cache_capacity(index) / 2;
+  FreeObject *list = take(index, count);
+  if (!list)
+    return nullptr;
+  ThreadCache::Bin &bin = cache.bins[index];
+  bin.head = list->next;
+  bin.count = count - 1;
+  return list;
+}
+
+void SizeClassHeap::drain(ThreadCache &cache, size_t index, uint32_t count) {
+  ThreadCache::Bin &bin = cache.bins[index];
+  FreeObject *list = bin.head;
+  FreeObject *last = list;
+  for (uint32_t i = 1; i < count; ++i)
+    last = last->next;
+  bin.head = last->next;
+  bin.count -= count;
+  give_back(index, list, count);
+}
+
+void *SizeClassHeap::allocate(ThreadCache &cache, size_t size) {
+  if (LIBC_UNLIKELY(size > size_class::MAX_SMALL_SIZE))
+    return allocate_large(size, alignof(max_align_t));
+
+  size_t index = size_class::index_of(size);
+  ThreadCache::Bin &bin = cache.bins[index];
+  if (LIBC_LIKELY(bin.head != nullptr)) {
+    FreeObject *object = bin.head;
+    bin.head = object->next;
+    --bin.count;
+    return object;
+  }
+  return refill(cache, index);
+}
+
+void *SizeClassHeap::aligned_allocate(ThreadCache &cache, size_t alignment,
+                                      size_t size) {
+  // The alignment must be an integral power of two.
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+    return nullptr;
+  if (alignment <= alignof(max_align_t))
+    return allocate(cache, size);
+
+  // Objects are aligned to max_align_t, so a slightly larger one always has
+  // room for an aligned pointer. free finds the start of the object back, as
+  // long as the pointer is within it, even for empty requests.
+  if (size == 0)
+    size = 1;
+  if (alignment <= size_class::MAX_SMALL_SIZE &&
+      size <= size_class::MAX_SMALL_SIZE - alignment) {
+    void *object = allocate(cache, size + alignment - alignof(max_align_t));
+    if (!object)
+      return nullptr;
+    uintptr_t aligned =
+        (reinterpret_cast<uintptr_t>(object) + alignment - 1) &
+        ~(alignment - 1);
+    return reinterpret_cast<void *>(aligned);
+  }
+  return allocate_large(size, alignment);
+}
+
+void SizeClassHeap::free(ThreadCache &cache, void *ptr) {
+  if (!ptr)
+    return;
+  if (LIBC_UNLIKELY(!is_small(ptr)))
+    return free_large(ptr);
+
+  FreeObject *object = static_cast<FreeObject *>(object_start(ptr));
+  size_t index = slab_of(ptr)->index;
+  if (LIBC_UNLIKELY(cache.disabled)) {
+    object->next = nullptr;
+    return give_back(index, object, 1);
+  }
+  ThreadCache::Bin &bin = cache.bins[index];
+  object->next = bin.head;
+  bin.head = object;
+  uint32_t capacity = size_class::cache_capacity(index);
+  if (LIBC_UNLIKELY(++bin.count > capacity))
+    drain(cache, index, capacity / 2);
+}
+
+void *SizeClassHeap::realloc(ThreadCache &cache, void *ptr, size_t size) {
+  if (size == 0) {
+    free(cache, ptr);
+    return nullptr;
+  }
+  if (ptr == nullptr)
+    return allocate(cache, size);
+
+  size_t old_size = usable_size(ptr);
+  if (size <= old_size)
+    return ptr;
+  if (!is_small(ptr) && size > size_class::MAX_SMALL_SIZE)
+    return reallocate_large(ptr, size);
+
+  void *new_ptr = allocate(cache, size);
+  if (!new_ptr)
+    return nullptr;
+  inline_memcpy(new_ptr, ptr, old_size);
+  free(cache, ptr);
+  return new_ptr;
+}
+
+void *SizeClassHeap::calloc(ThreadCache &cache, size_t num, size_t size) {
+  size_t bytes;
+  if (__builtin_mul_overflow(num, size, &bytes))
+    return nullptr;
+  void *ptr = allocate(cache, bytes);
+  // Large allocations are fresh mappings, which are already zeroed.
+  if (ptr && is_small(ptr))
+    inline_memset(ptr, 0, bytes);
+  return ptr;
+}
+
+void SizeClassHeap::flush(ThreadCache &cache) {
+  cache.disabled = true;
+  for (size_t index = 0; index < size_class::NUM_CLASSES; ++index)
+    if (cache.bins[index].count)
+      drain(cache, index, cache.bins[index].count);
+}
+
+void SizeClassHeap::lock_all() {
+  for (SizeClass &size_class : classes)
+    size_class.lock.lock();
+  region_lock.lock();
+}
+
+void SizeClassHeap::unlock_all() {
+  region_lock.unlock();
+  for (SizeClass &size_class : classes)
+    size_class.lock.unlock();
+}
+
+void *SizeClassHeap::allocate_large(size_t size, size_t alignment) {
+  // The pointer follows the header, at most alignment bytes later.
+  size_t padding = alignment > LARGE_HEADER_SIZE ? alignment : 0;
+  if (alignment < LARGE_HEADER_SIZE)
+    alignment = LARGE_HEADER_SIZE;
+  size_t map_size;
+  if (__builtin_add_overflow(size, LARGE_HEADER_SIZE + padding + PAGE_SIZE - 1,
+                             &map_size))
+    return nullptr;
+  map_size &= ~(PAGE_SIZE - 1);
+
+  cpp::byte *base =
+      static_cast<cpp::byte *>(map(map_size, PROT_READ | PROT_WRITE));
+  if (!base)
+    return nullptr;
+  uintptr_t ptr =
+      (reinterpret_cast<uintptr_t>(base) + LARGE_HEADER_SIZE + alignment - 1) &
+      ~(alignment - 1);
+  LargeHeader *header =
+      reinterpret_cast<LargeHeader *>(ptr - LARGE_HEADER_SIZE);
+  header->base = base;
+  header->size = map_size;
+  return reinterpret_cast<void *>(ptr);
+}
+
+void SizeClassHeap::free_large(void *ptr) {
+  LargeHeader *header = reinterpret_cast<LargeHeader *>(
+      static_cast<cpp::byte *>(ptr) - LARGE_HEADER_SIZE);
+  unmap(header->base, header->size);
+}
+
+void *SizeClassHeap::reallocate_large(void *ptr, size_t size) {
+  LargeHeader *header = reinterpret_cast<LargeHeader *>(
+      static_cast<cpp::byte *>(ptr) - LARGE_HEADER_SIZE);
+  cpp::byte *base = static_cast<cpp::byte *>(header->base);
+  size_t offset = static_cast<size_t>(static_cast<cpp::byte *>(ptr) - base);
+  size_t map_size;
+  if (__builtin_add_overflow(size, offset + PAGE_SIZE - 1, &map_size))
+    return nullptr;
+  map_size &= ~(PAGE_SIZE - 1);
+
+  // Let the kernel move the pages instead of copying them. The offset of the
+  // pointer in its mapping stays the same, and so does its alignment.
+  long result = syscall_impl<long>(SYS_mremap, base, header->size, map_size,
+                                   MREMAP_MAYMOVE);
+  if (result < 0 && static_cast<uintptr_t>(result) >= UINTPTR_MAX - map_size)
+    return nullptr;
+  base = reinterpret_cast<cpp::byte *>(result);
+  header = reinterpret_cast<LargeHeader *>(base + offset - LARGE_HEADER_SIZE);
+  header->base = base;
+  header->size = map_size;
+  return base + offset;
+}
+
+static LIBC_CONSTINIT SizeClassHeap size_class_heap_symbols;
+SizeClassHeap *size_class_heap = &size_class_heap_symbols;
+LIBC_THREAD_LOCAL SizeClassHeap::ThreadCache size_class_heap_cache;
+
+extern "C" int __cxa_thread_atexit_impl(void (*)(void *), void *, void *);
+
+static void flush_size_class_heap_cache(void *cache) {
+  size_class_heap->flush(*static_cast<SizeClassHeap::ThreadCache *>(cache));
+}
+
+static void lock_size_class_heap() { size_class_heap->lock_all(); }
+static void unlock_size_class_heap() { size_class_heap->unlock_all(); }
+
+static CallOnceFlag fork_callbacks_once = callonce_impl::NOT_CALLED;
+
+static void register_fork_callbacks() {
+  register_atfork_callbacks(lock_size_class_heap, unlock_size_class_heap,
+                            unlock_size_class_heap);
+}
+
+void register_size_class_heap_cache() {
+  size_class_heap_cache.registered = true;
+  callonce(&fork_callbacks_once, register_fork_callbacks);
+  // Without the callback, the objects cached by the thread would be lost when
+  // it exits. Don't cache any then.
+  if (__cxa_thread_atexit_impl(flush_size_class_heap_cache,
+                               &size_class_heap_cache, nullptr) != 0)
+    size_class_heap->flush(size_class_heap_cache);
+}
+
+} // namespace LIBC_NAMESPACE_DECL
@@ -0,0 +1,182 @@
+//===-- Interface for size_class_heap -------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+// A general purpose allocator for Linux, designed for multithreaded programs.
+//
+// Requests of up to MAX_SMALL_SIZE bytes are rounded up to one of NUM_CLASSES
+// size classes. The objects of a size class are carved out of slabs of
+// SLAB_SIZE bytes, which all come from a single reserved range of the address
+// space, so that a pointer is small if and only if it is in that range, and
+// its slab is found by rounding it down to SLAB_SIZE.
+//
+// Each thread keeps a cache of free objects for every size class, which serves
+// most requests without any synchronization. The caches exchange batches of
+// objects with the slabs of the size class, under the lock of that size class.
+// Slabs without any allocated objects are returned to the system with
+// madvise, and reused by any size class.
+//
+// Larger requests are mapped directly and unmapped when freed.
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC___SUPPORT_SIZE_CLASS_HEAP_H
+#define LLVM_LIBC_SRC___SUPPORT_SIZE_CLASS_HEAP_H
+
+#include "src/__support/CPP/atomic.h"
+#include "src/__support/CPP/cstddef.h"
+#include "src/__support/macros/attributes.h"
+#include "src/__support/macros/config.h"
+#include "src/__support/macros/optimization.h"
+#include "src/__support/threads/linux/raw_mutex.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace LIBC_NAMESPACE_DECL {
+
+namespace size_class {
+
+// Sizes are multiples of 16 up to 128, then there are four classes between
+// consecutive powers of two, up to MAX_SMALL_SIZE.
+LIBC_INLINE_VAR constexpr size_t NUM_CLASSES = 40;
+LIBC_INLINE_VAR constexpr size_t MAX_SMALL_SIZE = 32768;
+
+LIBC_INLINE constexpr size_t index_of(size_t size) {
+  if (size <= 128)
+    return size == 0 ? 0 : (size - 1) / 16;
+  size_t log = 63 - static_cast<size_t>(__builtin_clzll(size - 1));
+  size_t step = (size_t(1) << log) / 4;
+  return 8 + (log - 7) * 4 + (size - 1 - (size_t(1) << log)) / step;
+}
+
+LIBC_INLINE constexpr size_t size_of(size_t index) {
+  if (index < 8)
+    return 16 * (index + 1);
+  size_t base = size_t(1) << (7 + (index - 8) / 4);
+  return base + ((index - 8) % 4 + 1) * (base / 4);
+}
+
+// The number of free objects that a thread caches for a size class: enough
+// for a few pages of memory, within [2, 128].
+LIBC_INLINE constexpr uint32_t cache_capacity(size_t index) {
+  size_t count = 32768 / size_of(index);
+  return static_cast<uint32_t>(count < 2 ? 2 : count > 128 ? 128 : count);
+}
+
+} // namespace size_class
+
+class SizeClassHeap {
+  struct FreeObject {
+    FreeObject *next;
+  };
+  struct Slab;
+
+public:
+  LIBC_INLINE_VAR static constexpr size_t SLAB_SIZE = 256 * 1024;
+  // The address space reserved for the slabs. It is only backed by memory
+  // once slabs are used.
+  LIBC_INLINE_VAR static constexpr size_t REGION_SIZE =
+      sizeof(void *) == 8 ? size_t(64) << 30 : size_t(256) << 20;
+
+  // The free objects that a thread keeps for itself. Objects freed by a thread
+  // go to its cache, whichever thread allocated them.
+  class ThreadCache {
+    struct Bin {
+      FreeObject *head = nullptr;
+      uint32_t count = 0;
+    };
+    Bin bins[size_class::NUM_CLASSES] = {};
+    // Set once a thread is exiting and its cache has been flushed. The objects
+    // are then exchanged with the slabs directly.
+    bool disabled = false;
+
+    friend class SizeClassHeap;
+
+  public:
+    // Whether the thread exit callback that flushes the cache is registered.
+    bool registered = false;
+
+    LIBC_INLINE constexpr ThreadCache() = default;
+  };
+
+  LIBC_INLINE constexpr SizeClassHeap() = default;
+
+  void *allocate(ThreadCache &cache, size_t size);
+  void *aligned_allocate(ThreadCache &cache, size_t alignment, size_t size);
+  void free(ThreadCache &cache, void *ptr);
+  void *realloc(ThreadCache &cache, void *ptr, size_t size);
+  void *calloc(ThreadCache &cache, size_t num, size_t size);
+
+  // Returns all the objects of the cache to their slabs and disables it.
+  void flush(ThreadCache &cache);
+
+  // Acquire and release all the locks of the heap, around fork.
+  void lock_all();
+  void unlock_all();
+
+private:
+  // Whether ptr is in a slab. The range is reserved once, on the first small
+  // allocation.
+  LIBC_INLINE bool is_small(const void *ptr) {
+    uintptr_t begin = region_begin.load(cpp::MemoryOrder::RELAXED);
+    return begin != 0 && reinterpret_cast<uintptr_t>(ptr) - begin < REGION_SIZE;
+  }
+
+  LIBC_INLINE static Slab *slab_of(const void *ptr) {
+    return reinterpret_cast<Slab *>(reinterpret_cast<uintptr_t>(ptr) &
+                                    ~(SLAB_SIZE - 1));
+  }
+
+  void *refill(ThreadCache &cache, size_t index);
+  void drain(ThreadCache &cache, size_t index, uint32_t count);
+
+  // Takes up to count objects of a size class from its slabs and returns them
+  // as a list. Sets count to the number of objects taken.
+  FreeObject *take(size_t index, uint32_t &count);
+  // Returns a list of count objects to their slabs.
+  void give_back(size_t index, FreeObject *list, uint32_t count);
+
+  Slab *new_slab(size_t index);
+  void release_slab(Slab *slab);
+
+  void *allocate_large(size_t size, size_t alignment);
+  void free_large(void *ptr);
+  void *reallocate_large(void *ptr, size_t size);
+
+  size_t usable_size(const void *ptr);
+  static void *object_start(const void *ptr);
+
+  // The slabs of a size class that have objects left.
+  struct alignas(64) SizeClass {
+    RawMutex lock;
+    Slab *partial = nullptr;
+  };
+  SizeClass classes[size_class::NUM_CLASSES] = {};
+
+  // The reserved range of the slabs, and the slabs that were returned to the
+  // system. Slabs are used in order from region_next.
+  RawMutex region_lock;
+  cpp::Atomic<uintptr_t> region_begin = 0;
+  uintptr_t region_next = 0;
+  Slab *released = nullptr;
+};
+
+extern SizeClassHeap *size_class_heap;
+extern LIBC_THREAD_LOCAL SizeClassHeap::ThreadCache size_class_heap_cache;
+
+// Registers the thread exit callback that flushes the cache of the calling
+// thread.
+void register_size_class_heap_cache();
+
+LIBC_INLINE SizeClassHeap::ThreadCache &size_class_heap_thread_cache() {
+  if (LIBC_UNLIKELY(!size_class_heap_cache.registered))
+    register_size_class_heap_cache();
+  return size_class_heap_cache;
+}
+
+} // namespace LIBC_NAMESPACE_DECL
+
+#endif // LLVM_LIBC_SRC___SUPPORT_SIZE_CLASS_HEAP_H
@@ -875,6 +875,36 @@ LIBC_INLINE bool is_float_hex_start(const char *__restrict src,
   return isalnum(src[first_digit]) && b36_char_to_int(src[first_digit]) < 16;
 }
 
+#if defined(LIBC_COPT_STRING_UNSAFE_WIDE_READ) &&                              \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define LIBC_STR_TO_FLOAT_EIGHT_DIGITS
+// If the eight characters at src are all decimal digits, sets value to the
+// number they represent and returns true. The read may go past the end of the
+// string, but it doesn't cross a page boundary, so it can't fault.
+LIBC_INLINE bool parse_eight_digits(const char *__restrict src,
+                                    uint32_t &value) {
+  constexpr uintptr_t PAGE_SIZE = 4096;
+  if ((reinterpret_cast<uintptr_t>(src) % PAGE_SIZE) > PAGE_SIZE - 8)
+    return false;
+  uint64_t chunk;
+  __builtin_memcpy(&chunk, src, sizeof(chunk));
+  // A byte is a digit if it is at least '0' and adding 0x46 doesn't carry
+  // into its high bit, meaning it is at most '9'.
+  if ((((chunk + 0x4646464646464646) | (chunk - 0x3030303030303030)) &
+       0x8080808080808080) != 0)
+    return false;
+  // Combine the digits pairwise, then the pairs into two groups of four, and
+  // finally the two groups, with the first character the most significant.
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10) + (chunk >> 8);
+  chunk = (((chunk & 0x000000FF000000FF) * 0x000F424000000064) +
+           (((chunk >> 16) & 0x000000FF000000FF) * 0x0000271000000001)) >>
+          32;
+  value = static_cast<uint32_t>(chunk);
+  return true;
+}
+#endif
+
 // Takes the start of a string representing a decimal float, as well as the
 // local decimalPoint. It returns if it suceeded in parsing any digits, and if
 // the return value is true then the outputs are pointer to the end of the
@@ -907,7 +937,26 @@ decimal_string_to_float(const char *__restrict src, const char DECIMAL_POINT,
   // The loop fills the mantissa with as many digits as it can hold
   const StorageType bitstype_max_div_by_base =
       cpp::numeric_limits<StorageType>::max() / BASE;
+#ifdef LIBC_STR_TO_FLOAT_EIGHT_DIGITS
+  // While the mantissa has room for eight more digits, they are read at once.
+  // This gives the same result as reading them one by one.
+  constexpr uint32_t EIGHT_DIGIT_BASE = 100000000;
+  const StorageType bitstype_max_div_by_eight_digit_base =
+      cpp::numeric_limits<StorageType>::max() / EIGHT_DIGIT_BASE;
+#endif
   while (true) {
+#ifdef LIBC_STR_TO_FLOAT_EIGHT_DIGITS
+    uint32_t eight_digits;
+    if (mantissa < bitstype_max_div_by_eight_digit_base &&
+        parse_eight_digits(src + index, eight_digits)) {
+      seen_digit = true;
+      mantissa = (mantissa * EIGHT_DIGIT_BASE) + eight_digits;
+      if (after_decimal)
+        exponent -= 8;
+      index += 8;
+      continue;
+    }
+#endif
     if (isdigit(src[index])) {
       uint32_t digit = static_cast<uint32_t>(b36_char_to_int(src[index]));
       seen_digit = true;
@@ -1272,4 +1321,6 @@ template <class T> LIBC_INLINE StrToNumResult<T> strtonan(const char *arg) {
 } // namespace internal
 } // namespace LIBC_NAMESPACE_DECL
 
+#undef LIBC_STR_TO_FLOAT_EIGHT_DIGITS
+
 #endif // LLVM_LIBC_SRC___SUPPORT_STR_TO_FLOAT_H
@@ -9,13 +9,22 @@
 #ifndef LLVM_LIBC_SRC___SUPPORT_THREADS_LINUX_MUTEX_H
 #define LLVM_LIBC_SRC___SUPPORT_THREADS_LINUX_MUTEX_H
 
+#include "hdr/time_macros.h"
 #include "hdr/types/pid_t.h"
+#include "src/__support/CPP/atomic.h"
 #include "src/__support/CPP/optional.h"
+#include "src/__support/OSUtil/syscall.h"
 #include "src/__support/libc_assert.h"
 #include "src/__support/macros/config.h"
+#include "src/__support/macros/optimization.h"
+#include "src/__support/threads/identifier.h"
 #include "src/__support/threads/linux/futex_utils.h"
 #include "src/__support/threads/linux/raw_mutex.h"
 #include "src/__support/threads/mutex_common.h"
+#include "src/__support/time/linux/clock_conversion.h"
+
+#include <linux/errno.h>
+#include <linux/futex.h>
 
 namespace LIBC_NAMESPACE_DECL {
 
@@ -26,24 +35,134 @@ class Mutex final : private RawMutex {
   unsigned char recursive;
   unsigned char robust;
   unsigned char pshared;
+  // A priority inheritance mutex stores the thread id of its owner in the
+  // futex word, with the FUTEX_WAITERS bit set by the kernel once there are
+  // waiters. The kernel then boosts the owner to the priority of the highest
+  // priority waiter.
+  unsigned char priority_inherit;
+
+  // The number of pauses the recent lock operations spun for before getting
+  // the mutex. Contended lock operations spin for up to twice as long before
+  // sleeping, so that a mutex held only briefly is mostly acquired without
+  // system calls while callers of a mutex held for long give up quickly.
+  cpp::Atomic<unsigned short> spin_estimate;
 
   // TLS address may not work across forked processes. Use thread id instead.
   pid_t owner;
   unsigned long long lock_count;
 
+  LIBC_INLINE_VAR static constexpr unsigned MAX_ADAPTIVE_SPIN_COUNT =
+      LIBC_COPT_RAW_MUTEX_DEFAULT_SPIN_COUNT;
+
+  LIBC_INLINE bool lock_adaptive(cpp::optional<Futex::Timeout> timeout) {
+    if (LIBC_LIKELY(this->RawMutex::try_lock()))
+      return true;
+    unsigned estimate = spin_estimate.load(cpp::MemoryOrder::RELAXED);
+    unsigned max_spin = 2 * estimate + 10;
+    if (max_spin > MAX_ADAPTIVE_SPIN_COUNT)
+      max_spin = MAX_ADAPTIVE_SPIN_COUNT;
+    unsigned spun = 0;
+    bool locked = this->RawMutex::lock_slow(timeout, this->pshared, max_spin,
+                                            &spun);
+    // Move the estimate an eighth of the way towards the last spin count.
+    int delta = (static_cast<int>(spun) - static_cast<int>(estimate)) / 8;
+    spin_estimate.store(static_cast<unsigned short>(estimate + delta),
+                        cpp::MemoryOrder::RELAXED);
+    return locked;
+  }
+
+  LIBC_INLINE MutexError lock_pi(cpp::optional<Futex::Timeout> timeout) {
+    FutexWordType expected = 0;
+    if (LIBC_LIKELY(this->futex.compare_exchange_strong(
+            expected, static_cast<FutexWordType>(internal::gettid()),
+            cpp::MemoryOrder::ACQUIRE, cpp::MemoryOrder::RELAXED)))
+      return MutexError::NONE;
+    // FUTEX_LOCK_PI only measures the timeout against the realtime clock.
+    // FUTEX_LOCK_PI2 is needed for the monotonic one, but it is only available
+    // from Linux 5.14. Without it, a monotonic timeout is converted to the
+    // realtime clock.
+    timespec abs_time{};
+    if (timeout)
+      abs_time = timeout->get_timespec();
+    int op = FUTEX_LOCK_PI;
+    if (timeout && !timeout->is_realtime()) {
+#ifdef FUTEX_LOCK_PI2
+      op = FUTEX_LOCK_PI2;
+#else
+      abs_time = internal::convert_clock(abs_time, CLOCK_MONOTONIC,
+                                         CLOCK_REALTIME);
+#endif
+    }
+    const int private_flag = this->pshared ? 0 : FUTEX_PRIVATE_FLAG;
+    for (;;) {
+      // The kernel queues the thread by priority and takes the mutex for it
+      // once its owner releases it.
+      long ret = syscall_impl<long>(
+          /* syscall number */ FUTEX_SYSCALL_ID,
+          /* futex address */ &this->futex,
+          /* futex operation  */ op | private_flag,
+          /* ignored */ 0,
+          /* timeout */ timeout ? &abs_time : nullptr,
+          /* ignored */ nullptr,
+          /* ignored */ 0);
+      if (ret == 0)
+        return MutexError::NONE;
+      if (ret == -ETIMEDOUT)
+        return MutexError::TIMEOUT;
+      if (ret == -EINTR)
+        continue;
+#ifdef FUTEX_LOCK_PI2
+      // The headers know FUTEX_LOCK_PI2, but the running kernel does not.
+      if (ret == -ENOSYS && op == FUTEX_LOCK_PI2) {
+        op = FUTEX_LOCK_PI;
+        abs_time = internal::convert_clock(abs_time, CLOCK_MONOTONIC,
+                                           CLOCK_REALTIME);
+        continue;
+      }
+#endif
+      return MutexError::BAD_LOCK_STATE;
+    }
+  }
+
+  LIBC_INLINE MutexError unlock_pi() {
+    FutexWordType tid = static_cast<FutexWordType>(internal::gettid());
+    FutexWordType expected = tid;
+    if (LIBC_LIKELY(this->futex.compare_exchange_strong(
+            expected, 0, cpp::MemoryOrder::RELEASE, cpp::MemoryOrder::RELAXED)))
+      return MutexError::NONE;
+    if ((expected & FUTEX_TID_MASK) != tid)
+      return MutexError::UNLOCK_WITHOUT_LOCK;
+    // There are waiters. Let the kernel hand the mutex over to the one with
+    // the highest priority.
+    long ret = syscall_impl<long>(
+        /* syscall number */ FUTEX_SYSCALL_ID,
+        /* futex address */ &this->futex,
+        /* futex operation  */
+        this->pshared ? FUTEX_UNLOCK_PI : FUTEX_UNLOCK_PI_PRIVATE,
+        /* ignored */ 0,
+        /* ignored */ nullptr,
+        /* ignored */ nullptr,
+        /* ignored */ 0);
+    return ret == 0 ? MutexError::NONE : MutexError::UNLOCK_WITHOUT_LOCK;
+  }
+
 public:
   LIBC_INLINE constexpr Mutex(bool is_timed, bool is_recursive, bool is_robust,
-                              bool is_pshared)
+                              bool is_pshared, bool is_priority_inherit = false)
       : RawMutex(), timed(is_timed), recursive(is_recursive), robust(is_robust),
-        pshared(is_pshared), owner(0), lock_count(0) {}
+        pshared(is_pshared), priority_inherit(is_priority_inherit),
+        spin_estimate(0), owner(0), lock_count(0) {}
 
   LIBC_INLINE static MutexError init(Mutex *mutex, bool is_timed, bool isrecur,
-                                     bool isrobust, bool is_pshared) {
+                                     bool isrobust, bool is_pshared,
+                                     bool is_priority_inherit = false) {
     RawMutex::init(mutex);
     mutex->timed = is_timed;
     mutex->recursive = isrecur;
     mutex->robust = isrobust;
     mutex->pshared = is_pshared;
+    mutex->priority_inherit = is_priority_inherit;
+    mutex->spin_estimate.store(0, cpp::MemoryOrder::RELAXED);
     mutex->owner = 0;
     mutex->lock_count = 0;
     return MutexError::NONE;
@@ -58,20 +177,25 @@ public:
 
   // TODO: record owner and lock count.
   LIBC_INLINE MutexError lock() {
+    if (LIBC_UNLIKELY(this->priority_inherit != 0))
+      return lock_pi(cpp::nullopt);
     // Since timeout is not specified, we do not need to check the return value.
-    this->RawMutex::lock(
-        /* timeout=*/cpp::nullopt, this->pshared);
+    lock_adaptive(/* timeout=*/cpp::nullopt);
     return MutexError::NONE;
   }
 
   // TODO: record owner and lock count.
   LIBC_INLINE MutexError timed_lock(internal::AbsTimeout abs_time) {
-    if (this->RawMutex::lock(abs_time, this->pshared))
+    if (LIBC_UNLIKELY(this->priority_inherit != 0))
+      return lock_pi(abs_time);
+    if (lock_adaptive(abs_time))
       return MutexError::NONE;
     return MutexError::TIMEOUT;
   }
 
   LIBC_INLINE MutexError unlock() {
+    if (LIBC_UNLIKELY(this->priority_inherit != 0))
+      return unlock_pi();
     if (this->RawMutex::unlock(this->pshared))
       return MutexError::NONE;
     return MutexError::UNLOCK_WITHOUT_LOCK;
@@ -79,6 +203,14 @@ public:
 
   // TODO: record owner and lock count.
   LIBC_INLINE MutexError try_lock() {
+    if (LIBC_UNLIKELY(this->priority_inherit != 0)) {
+      FutexWordType expected = 0;
+      if (this->futex.compare_exchange_strong(
+              expected, static_cast<FutexWordType>(internal::gettid()),
+              cpp::MemoryOrder::ACQUIRE, cpp::MemoryOrder::RELAXED))
+        return MutexError::NONE;
+      return MutexError::BUSY;
+    }
     if (this->RawMutex::try_lock())
       return MutexError::NONE;
     return MutexError::BUSY;
@@ -43,29 +43,48 @@ protected:
   LIBC_INLINE_VAR static constexpr FutexWordType LOCKED = 0b01;
   LIBC_INLINE_VAR static constexpr FutexWordType IN_CONTENTION = 0b10;
 
+  // The spinning threads double their pause between two loads of the futex
+  // word up to this many pauses, so that the waiters of a contended mutex do
+  // not keep its cache line bouncing between the cores.
+  LIBC_INLINE_VAR static constexpr unsigned MAX_SPIN_BACKOFF = 32;
+
 private:
-  LIBC_INLINE FutexWordType spin(unsigned spin_count) {
+  // Spin for at most spin_count pauses while the mutex is locked. The pauses
+  // used are subtracted from spin_count.
+  LIBC_INLINE FutexWordType spin(unsigned &spin_count) {
     FutexWordType result;
+    unsigned backoff = 1;
     for (;;) {
       result = futex.load(cpp::MemoryOrder::RELAXED);
       // spin until one of the following conditions is met:
       // - the mutex is unlocked
-      // - the mutex is in contention
       // - the spin count reaches 0
-      if (result != LOCKED || spin_count == 0u)
+      // Keep spinning while the mutex is in contention: the owner may release
+      // it soon, and sleeping costs two system calls.
+      if (result == UNLOCKED || spin_count == 0u)
         return result;
       // Pause the pipeline to avoid extraneous memory operations due to
       // speculation.
-      sleep_briefly();
-      spin_count--;
+      unsigned pauses = backoff < spin_count ? backoff : spin_count;
+      for (unsigned i = 0; i < pauses; ++i)
+        sleep_briefly();
+      spin_count -= pauses;
+      if (backoff < MAX_SPIN_BACKOFF)
+        backoff *= 2;
     };
   }
 
+protected:
   // Return true if the lock is acquired. Return false if timeout happens before
-  // the lock is acquired.
+  // the lock is acquired. If spun is not null, it receives the number of
+  // pauses spent spinning before the lock was acquired or the thread slept.
   LIBC_INLINE bool lock_slow(cpp::optional<Futex::Timeout> timeout,
-                             bool is_pshared, unsigned spin_count) {
-    FutexWordType state = spin(spin_count);
+                             bool is_pshared, unsigned spin_count,
+                             unsigned *spun = nullptr) {
+    unsigned remaining = spin_count;
+    FutexWordType state = spin(remaining);
+    if (spun)
+      *spun = spin_count - remaining;
     // Before go into contention state, try to grab the lock.
     if (state == UNLOCKED &&
         futex.compare_exchange_strong(state, LOCKED, cpp::MemoryOrder::ACQUIRE,
@@ -86,10 +105,12 @@ private:
       if (ETIMEDOUT == -futex.wait(IN_CONTENTION, timeout, is_pshared))
         return false;
       // Continue to spin after waking up.
-      state = spin(spin_count);
+      remaining = spin_count;
+      state = spin(remaining);
     }
   }
 
+private:
   LIBC_INLINE void wake(bool is_pshared) { futex.notify_one(is_pshared); }
 
 public:
@@ -292,6 +292,10 @@ int Thread::run(ThreadStyle style, ThreadRunner runner, void *arg, void *stack,
   clear_tid->set(CLEAR_TID_VALUE);
   attrib->platform_data = clear_tid;
 
+  // The new thread, and the threads it creates, observe this store as they
+  // are created after it.
+  process_is_multithreaded.store(true, cpp::MemoryOrder::RELAXED);
+
   // The clone syscall takes arguments in an architecture specific order.
   // Also, we want the result of the syscall to be in a register as the child
   // thread gets a completely different stack after it is created. The stack
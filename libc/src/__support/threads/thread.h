@@ -233,6 +233,10 @@ struct Thread {
 
 LIBC_INLINE_VAR LIBC_THREAD_LOCAL Thread self;
 
+// Set before the process creates its first thread, and never cleared. Until
+// then, the state shared by threads can be accessed without locking.
+LIBC_INLINE_VAR cpp::Atomic<bool> process_is_multithreaded = false;
+
 // Platforms should implement this function.
 [[noreturn]] void thread_exit(ThreadReturnValue retval, ThreadStyle style);
 
@@ -0,0 +1,22 @@
+//===-- Implementation header for _ZGVnN4v_expf -----------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_MATH__ZGVNN4V_EXPF_H
+#define LLVM_LIBC_SRC_MATH__ZGVNN4V_EXPF_H
+
+#include "src/__support/FPUtil/vector_types.h"
+#include "src/__support/macros/config.h"
+
+namespace LIBC_NAMESPACE_DECL {
+
+// expf with four lanes and no mask, in the AArch64 Advanced SIMD vector function ABI.
+fputil::v4f32 _ZGVnN4v_expf(fputil::v4f32 x);
+
+} // namespace LIBC_NAMESPACE_DECL
+
+#endif // LLVM_LIBC_SRC_MATH__ZGVNN4V_EXPF_H
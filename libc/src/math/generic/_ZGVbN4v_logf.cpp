@@ -0,0 +1,20 @@
+//===-- Vector single-precision log(x) function ---------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/math/_ZGVbN4v_logf.h"
+#include "logf_vector_impl.h"
+#include "src/__support/common.h"
+#include "src/__support/macros/config.h"
+
+namespace LIBC_NAMESPACE_DECL {
+
+LLVM_LIBC_FUNCTION(fputil::v4f32, _ZGVbN4v_logf, (fputil::v4f32 x)) {
+  return generic::logf(x);
+}
+
+} // namespace LIBC_NAMESPACE_DECL
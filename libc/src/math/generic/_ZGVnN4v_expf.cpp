@@ -0,0 +1,20 @@
+//===-- Vector single-precision e^x function ------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/math/_ZGVnN4v_expf.h"
+#include "expf_vector_impl.h"
+#include "src/__support/common.h"
+#include "src/__support/macros/config.h"
+
+namespace LIBC_NAMESPACE_DECL {
+
+LLVM_LIBC_FUNCTION(fputil::v4f32, _ZGVnN4v_expf, (fputil::v4f32 x)) {
+  return generic::expf(x);
+}
+
+} // namespace LIBC_NAMESPACE_DECL
@@ -0,0 +1,100 @@
+//===-- Vector single-precision e^x function --------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_MATH_GENERIC_EXPF_VECTOR_IMPL_H
+#define LLVM_LIBC_SRC_MATH_GENERIC_EXPF_VECTOR_IMPL_H
+
+#include "common_constants.h" // Lookup tables EXP_M1 and EXP_M2.
+#include "src/__support/CPP/bit.h"
+#include "src/__support/FPUtil/vector_types.h"
+#include "src/__support/common.h"
+#include "src/__support/macros/config.h"
+#include "src/__support/macros/optimization.h" // LIBC_UNLIKELY
+#include "src/math/expf.h"
+
+namespace LIBC_NAMESPACE_DECL {
+namespace generic {
+
+// The inputs whose results don't round correctly with expf_vector_eval. expf
+// handles them separately.
+LIBC_INLINE_VAR constexpr uint32_t EXPF_VECTOR_EXCEPTIONS[] = {
+    0xc236'bd8cU, // x = -0x1.6d7b18p+5f
+};
+
+// Computes e^x for |x| < 88, in the same way as expf, so that rounding the
+// results to single precision gives the same values. The range reduction is
+//   x = hi + mid + lo, with hi an integer, mid * 2^7 an integer and
+//   |lo| <= 2^-8,
+// so that exp(x) = exp(hi) * exp(mid) * exp(lo), where exp(hi) and exp(mid)
+// come from the lookup tables and exp(lo) from a degree-4 polynomial. The
+// table lookups are the only steps done one element at a time.
+LIBC_INLINE fputil::v2f64 expf_vector_eval(fputil::v2f64 x) {
+  using fputil::v2f64;
+  using fputil::v2i64;
+  // Adding 1.5 * 2^52 rounds x * 2^7 to an integer, left in the low bits of
+  // the sum.
+  constexpr double SHIFT = 0x1.8p52;
+  v2f64 kd = x * 0x1.0p7 + SHIFT;
+  v2i64 x_hi = cpp::bit_cast<v2i64>(kd) - cpp::bit_cast<int64_t>(SHIFT);
+  kd -= SHIFT;
+  v2f64 lo = x - kd * 0x1.0p-7;
+  x_hi += 104 << 7;
+  v2f64 exp_hi = {EXP_M1[x_hi[0] >> 7], EXP_M1[x_hi[1] >> 7]};
+  v2f64 exp_mid = {EXP_M2[x_hi[0] & 0x7f], EXP_M2[x_hi[1] & 0x7f]};
+  // The same polynomial as expf, generated by Sollya with:
+  //   > Q = fpminimax(expm1(x)/x, 3, [|D...|], [-2^-8, 2^-8]);
+  v2f64 exp_lo = lo * 0x1.55555555ef243p-5 + 0x1.555566668e5e7p-3;
+  exp_lo = exp_lo * lo + 0x1.000000000071cp-1;
+  exp_lo = exp_lo * lo + 0x1.ffffffffff777p-1;
+  exp_lo = exp_lo * lo + 0x1p0;
+  return exp_hi * exp_mid * exp_lo;
+}
+
+// Computes expf of each element, with the same results as the scalar function
+// in the default rounding mode. The elements with |x| >= 88, whose results
+// overflow, underflow or are special values, are handed to the scalar function,
+// which also sets errno and the floating point exceptions for them. So are the
+// exceptional values.
+LIBC_INLINE fputil::v4f32 expf(fputil::v4f32 x) {
+  using fputil::v2f32;
+  using fputil::v2f64;
+  using fputil::v4f32;
+  using fputil::v4i32;
+  using fputil::v4u32;
+
+  v4u32 x_u = cpp::bit_cast<v4u32>(x);
+  v4i32 special = (x_u & 0x7fff'ffffU) >= 0x42b0'0000U;
+#ifndef LIBC_MATH_HAS_SKIP_ACCURATE_PASS
+  for (uint32_t exception : EXPF_VECTOR_EXCEPTIONS)
+    special |= x_u == exception;
+#endif // !LIBC_MATH_HAS_SKIP_ACCURATE_PASS
+  // Replace the special elements by 0, so that they don't raise spurious
+  // exceptions.
+  v4f32 xs = cpp::bit_cast<v4f32>(cpp::bit_cast<v4i32>(x) & ~special);
+
+  v2f64 lo = expf_vector_eval(
+      __builtin_convertvector(__builtin_shufflevector(xs, xs, 0, 1), v2f64));
+  v2f64 hi = expf_vector_eval(
+      __builtin_convertvector(__builtin_shufflevector(xs, xs, 2, 3), v2f64));
+  v4f32 result = __builtin_shufflevector(__builtin_convertvector(lo, v2f32),
+                                         __builtin_convertvector(hi, v2f32), 0,
+                                         1, 2, 3);
+
+  if (LIBC_UNLIKELY((special[0] | special[1] | special[2] | special[3]) !=
+                    0)) {
+    for (int i = 0; i < 4; ++i)
+      if (special[i])
+        result[i] = LIBC_NAMESPACE::expf(x[i]);
+  }
+  return result;
+}
+
+} // namespace generic
+} // namespace LIBC_NAMESPACE_DECL
+
+#endif // LLVM_LIBC_SRC_MATH_GENERIC_EXPF_VECTOR_IMPL_H
@@ -0,0 +1,158 @@
+//===-- Vector single-precision log(x) function -----------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_MATH_GENERIC_LOGF_VECTOR_IMPL_H
+#define LLVM_LIBC_SRC_MATH_GENERIC_LOGF_VECTOR_IMPL_H
+
+#include "common_constants.h" // Lookup tables R, RD and LOG_R.
+#include "src/__support/CPP/bit.h"
+#include "src/__support/FPUtil/vector_types.h"
+#include "src/__support/common.h"
+#include "src/__support/macros/config.h"
+#include "src/__support/macros/optimization.h" // LIBC_UNLIKELY
+#include "src/__support/macros/properties/cpu_features.h"
+#include "src/math/logf.h"
+
+namespace LIBC_NAMESPACE_DECL {
+namespace generic {
+
+// The inputs whose results don't round correctly with logf_vector_eval. They
+// are the hard-to-round cases of logf, which handles them separately.
+LIBC_INLINE_VAR constexpr uint32_t LOGF_VECTOR_EXCEPTIONS[] = {
+    0x3f7f'4d6fU, // x = 0x1.fe9adep-1f
+    0x4117'8febU, // x = 0x1.2f1fd6p+3f
+#ifdef LIBC_TARGET_CPU_HAS_FMA
+    0x3f80'0000U, // x = 1.0f
+#else
+    0x1e88'452dU, // x = 0x1.108a5ap-66f
+#endif // LIBC_TARGET_CPU_HAS_FMA
+    0x4c5d'65a5U, // x = 0x1.bacb4ap+25f
+    0x65d8'90d3U, // x = 0x1.b121a6p+76f
+    0x6f31'a8ecU, // x = 0x1.6351d8p+95f
+    0x7a17'f30aU, // x = 0x1.2fe614p+117f
+#ifndef LIBC_TARGET_CPU_HAS_FMA_DOUBLE
+    0x500f'fb03U, // x = 0x1.1ff606p+33f
+    0x5cd6'9e88U, // x = 0x1.ad3d1p+58f
+    0x5ee8'984eU, // x = 0x1.d1309cp+62f
+#endif // !LIBC_TARGET_CPU_HAS_FMA_DOUBLE
+};
+
+// x * y + z, fused whenever fputil::multiply_add is for doubles.
+LIBC_INLINE fputil::v2f64 logf_vector_multiply_add(fputil::v2f64 x,
+                                                   fputil::v2f64 y,
+                                                   fputil::v2f64 z) {
+#ifdef LIBC_TARGET_CPU_HAS_FMA_DOUBLE
+#if __has_builtin(__builtin_elementwise_fma)
+  return __builtin_elementwise_fma(x, y, z);
+#else
+  return fputil::v2f64{__builtin_fma(x[0], y[0], z[0]),
+                       __builtin_fma(x[1], y[1], z[1])};
+#endif
+#else
+  return x * y + z;
+#endif // LIBC_TARGET_CPU_HAS_FMA_DOUBLE
+}
+
+// Computes log(2^m * u) for 1 <= u < 2, in the same way as logf, so that
+// rounding the results to single precision gives the same values. The range
+// reduction is
+//   log(2^m * u) = m * log(2) - log(r) + log(1 + v), with v = u * r - 1,
+// where r and -log(r) come from the lookup tables for the 7 leading
+// fractional bits of u, and log(1 + v) from a degree-5 polynomial. The table
+// lookups are the only steps done one element at a time.
+LIBC_INLINE fputil::v2f64 logf_vector_eval(fputil::v2f64 m, fputil::v2f64 u,
+                                           const int index[2]) {
+  using fputil::v2f64;
+  constexpr v2f64 LOG_2 = {0x1.62e42fefa39efp-1, 0x1.62e42fefa39efp-1};
+  constexpr v2f64 MINUS_ONE = {-1.0, -1.0};
+#ifdef LIBC_TARGET_CPU_HAS_FMA_FLOAT
+  // The single precision product of logf is exact, and so it is in double
+  // precision.
+  v2f64 r = {static_cast<double>(R[index[0]]),
+             static_cast<double>(R[index[1]])};
+#else
+  v2f64 r = {RD[index[0]], RD[index[1]]};
+#endif // LIBC_TARGET_CPU_HAS_FMA_FLOAT
+  v2f64 log_r = {LOG_R[index[0]], LOG_R[index[1]]};
+  v2f64 v = logf_vector_multiply_add(u, r, MINUS_ONE); // Exact.
+
+  // The same polynomial as logf, generated by Sollya with:
+  // > P = fpminimax(log(1 + x)/x, 4, [|1, D...|], [-2^-8, 2^-7]);
+  constexpr v2f64 C0 = {-0x1.000000000fe63p-1, -0x1.000000000fe63p-1};
+  constexpr v2f64 C1 = {0x1.555556e963c16p-2, 0x1.555556e963c16p-2};
+  constexpr v2f64 C2 = {-0x1.000028dedf986p-2, -0x1.000028dedf986p-2};
+  constexpr v2f64 C3 = {0x1.966681bfda7f7p-3, 0x1.966681bfda7f7p-3};
+  v2f64 v2 = v * v; // Exact
+  v2f64 p2 = logf_vector_multiply_add(v, C3, C2);
+  v2f64 p1 = logf_vector_multiply_add(v, C1, C0);
+  v2f64 p0 = log_r + v;
+  v2f64 p = logf_vector_multiply_add(
+      v2, logf_vector_multiply_add(v2, p2, p1), p0);
+  return logf_vector_multiply_add(m, LOG_2, p);
+}
+
+// Computes logf of each element, with the same results as the scalar function
+// in the default rounding mode. The elements that are not positive normal
+// numbers, whose results are special values or need a normalization, are
+// handed to the scalar function, which also sets errno and the floating point
+// exceptions for them. So are the exceptional values.
+LIBC_INLINE fputil::v4f32 logf(fputil::v4f32 x) {
+  using fputil::v2f32;
+  using fputil::v2f64;
+  using fputil::v4f32;
+  using fputil::v4i32;
+  using fputil::v4u32;
+
+  v4u32 x_u = cpp::bit_cast<v4u32>(x);
+  v4i32 special = (x_u - 0x0080'0000U) >= 0x7f00'0000U;
+#ifndef LIBC_MATH_HAS_SKIP_ACCURATE_PASS
+  for (uint32_t exception : LOGF_VECTOR_EXCEPTIONS)
+    special |= x_u == exception;
+#endif // !LIBC_MATH_HAS_SKIP_ACCURATE_PASS
+  // Replace the special elements by 1, so that they don't raise spurious
+  // exceptions.
+  x_u = (x_u & ~cpp::bit_cast<v4u32>(special)) |
+        (cpp::bit_cast<v4u32>(special) & 0x3f80'0000U);
+
+  // Add an extra 1 to the exponent if the 7 leading fractional bits are all
+  // 1's, as the index then wraps around to 0.
+  v4i32 m = cpp::bit_cast<v4i32>((x_u + (1 << 16)) >> 23) - 127;
+  v4u32 mant = x_u & 0x007f'ffffU;
+  v4u32 index = mant >> 16;
+  // Set bits to 1.m
+  v4f32 u = cpp::bit_cast<v4f32>(mant | 0x3f80'0000U);
+
+  const int index_lo[2] = {static_cast<int>(index[0]),
+                           static_cast<int>(index[1])};
+  const int index_hi[2] = {static_cast<int>(index[2]),
+                           static_cast<int>(index[3])};
+  v2f64 lo = logf_vector_eval(
+      __builtin_convertvector(__builtin_shufflevector(m, m, 0, 1), v2f64),
+      __builtin_convertvector(__builtin_shufflevector(u, u, 0, 1), v2f64),
+      index_lo);
+  v2f64 hi = logf_vector_eval(
+      __builtin_convertvector(__builtin_shufflevector(m, m, 2, 3), v2f64),
+      __builtin_convertvector(__builtin_shufflevector(u, u, 2, 3), v2f64),
+      index_hi);
+  v4f32 result = __builtin_shufflevector(__builtin_convertvector(lo, v2f32),
+                                         __builtin_convertvector(hi, v2f32), 0,
+                                         1, 2, 3);
+
+  if (LIBC_UNLIKELY((special[0] | special[1] | special[2] | special[3]) !=
+                    0)) {
+    for (int i = 0; i < 4; ++i)
+      if (special[i])
+        result[i] = LIBC_NAMESPACE::logf(x[i]);
+  }
+  return result;
+}
+
+} // namespace generic
+} // namespace LIBC_NAMESPACE_DECL
+
+#endif // LLVM_LIBC_SRC_MATH_GENERIC_LOGF_VECTOR_IMPL_H
@@ -29,7 +29,8 @@ LLVM_LIBC_FUNCTION(int, pthread_mutex_init,
       Mutex::init(reinterpret_cast<Mutex *>(m), /*is_timed=*/true,
                   get_mutexattr_type(mutexattr) & PTHREAD_MUTEX_RECURSIVE,
                   get_mutexattr_robust(mutexattr) & PTHREAD_MUTEX_ROBUST,
-                  get_mutexattr_pshared(mutexattr) & PTHREAD_PROCESS_SHARED);
+                  get_mutexattr_pshared(mutexattr) & PTHREAD_PROCESS_SHARED,
+                  get_mutexattr_protocol(mutexattr) == PTHREAD_PRIO_INHERIT);
   return err == MutexError::NONE ? 0 : EAGAIN;
 }
 
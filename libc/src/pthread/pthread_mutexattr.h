@@ -26,13 +26,17 @@ enum class PThreadMutexAttrPos : unsigned int {
   PSHARED_SHIFT = 3,
   PSHARED_MASK = 0x1 << PSHARED_SHIFT,
 
-  // TODO: Add a mask for protocol and prioceiling when it is supported.
+  PROTOCOL_SHIFT = 4,
+  PROTOCOL_MASK = 0x3 << PROTOCOL_SHIFT,
+
+  // TODO: Add a mask for prioceiling when it is supported.
 };
 
 constexpr pthread_mutexattr_t DEFAULT_MUTEXATTR =
     PTHREAD_MUTEX_DEFAULT << unsigned(PThreadMutexAttrPos::TYPE_SHIFT) |
     PTHREAD_MUTEX_STALLED << unsigned(PThreadMutexAttrPos::ROBUST_SHIFT) |
-    PTHREAD_PROCESS_PRIVATE << unsigned(PThreadMutexAttrPos::PSHARED_SHIFT);
+    PTHREAD_PROCESS_PRIVATE << unsigned(PThreadMutexAttrPos::PSHARED_SHIFT) |
+    PTHREAD_PRIO_NONE << unsigned(PThreadMutexAttrPos::PROTOCOL_SHIFT);
 
 LIBC_INLINE int get_mutexattr_type(pthread_mutexattr_t attr) {
   return (attr & unsigned(PThreadMutexAttrPos::TYPE_MASK)) >>
@@ -49,6 +53,11 @@ LIBC_INLINE int get_mutexattr_pshared(pthread_mutexattr_t attr) {
          unsigned(PThreadMutexAttrPos::PSHARED_SHIFT);
 }
 
+LIBC_INLINE int get_mutexattr_protocol(pthread_mutexattr_t attr) {
+  return (attr & unsigned(PThreadMutexAttrPos::PROTOCOL_MASK)) >>
+         unsigned(PThreadMutexAttrPos::PROTOCOL_SHIFT);
+}
+
 } // namespace LIBC_NAMESPACE_DECL
 
 #endif // LLVM_LIBC_SRC_PTHREAD_PTHREAD_MUTEXATTR_H
@@ -0,0 +1,25 @@
+//===-- Implementation of the pthread_mutexattr_getprotocol ---------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "pthread_mutexattr_getprotocol.h"
+#include "pthread_mutexattr.h"
+
+#include "src/__support/common.h"
+#include "src/__support/macros/config.h"
+
+namespace LIBC_NAMESPACE_DECL {
+
+LLVM_LIBC_FUNCTION(int, pthread_mutexattr_getprotocol,
+                   (const pthread_mutexattr_t *__restrict attr,
+                    int *__restrict protocol)) {
+  *protocol = (*attr & unsigned(PThreadMutexAttrPos::PROTOCOL_MASK)) >>
+              unsigned(PThreadMutexAttrPos::PROTOCOL_SHIFT);
+  return 0;
+}
+
+} // namespace LIBC_NAMESPACE_DECL
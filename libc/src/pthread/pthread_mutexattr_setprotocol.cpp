@@ -0,0 +1,32 @@
+//===-- Implementation of the pthread_mutexattr_setprotocol ---------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "pthread_mutexattr_setprotocol.h"
+#include "pthread_mutexattr.h"
+
+#include "src/__support/common.h"
+#include "src/__support/macros/config.h"
+#include "src/errno/libc_errno.h"
+
+#include <pthread.h>
+
+namespace LIBC_NAMESPACE_DECL {
+
+LLVM_LIBC_FUNCTION(int, pthread_mutexattr_setprotocol,
+                   (pthread_mutexattr_t *__restrict attr, int protocol)) {
+  if (protocol == PTHREAD_PRIO_PROTECT)
+    return ENOTSUP;
+  if (protocol != PTHREAD_PRIO_NONE && protocol != PTHREAD_PRIO_INHERIT)
+    return EINVAL;
+  pthread_mutexattr_t old = *attr;
+  old &= ~unsigned(PThreadMutexAttrPos::PROTOCOL_MASK);
+  *attr = old | (protocol << unsigned(PThreadMutexAttrPos::PROTOCOL_SHIFT));
+  return 0;
+}
+
+} // namespace LIBC_NAMESPACE_DECL
@@ -18,7 +18,7 @@ namespace LIBC_NAMESPACE_DECL {
 
 LLVM_LIBC_FUNCTION(int, getc, (::FILE * stream)) {
   unsigned char c;
-  auto result = reinterpret_cast<LIBC_NAMESPACE::File *>(stream)->read(&c, 1);
+  auto result = reinterpret_cast<LIBC_NAMESPACE::File *>(stream)->read_byte(c);
   size_t r = result.value;
   if (result.has_error())
     libc_errno = result.error;
@@ -19,7 +19,7 @@ namespace LIBC_NAMESPACE_DECL {
 LLVM_LIBC_FUNCTION(int, getc_unlocked, (::FILE * stream)) {
   unsigned char c;
   auto result =
-      reinterpret_cast<LIBC_NAMESPACE::File *>(stream)->read_unlocked(&c, 1);
+      reinterpret_cast<LIBC_NAMESPACE::File *>(stream)->read_byte_unlocked(c);
   size_t r = result.value;
   if (result.has_error())
     libc_errno = result.error;
@@ -17,7 +17,7 @@ namespace LIBC_NAMESPACE_DECL {
 
 LLVM_LIBC_FUNCTION(int, getchar, ()) {
   unsigned char c;
-  auto result = stdin->read(&c, 1);
+  auto result = stdin->read_byte(c);
   if (result.has_error())
     libc_errno = result.error;
 
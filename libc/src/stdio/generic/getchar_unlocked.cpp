@@ -17,7 +17,7 @@ namespace LIBC_NAMESPACE_DECL {
 
 LLVM_LIBC_FUNCTION(int, getchar_unlocked, ()) {
   unsigned char c;
-  auto result = stdin->read_unlocked(&c, 1);
+  auto result = stdin->read_byte_unlocked(c);
   if (result.has_error())
     libc_errno = result.error;
 
@@ -19,7 +19,8 @@ namespace LIBC_NAMESPACE_DECL {
 LLVM_LIBC_FUNCTION(int, putc, (int c, ::FILE *stream)) {
   unsigned char uc = static_cast<unsigned char>(c);
 
-  auto result = reinterpret_cast<LIBC_NAMESPACE::File *>(stream)->write(&uc, 1);
+  auto result =
+      reinterpret_cast<LIBC_NAMESPACE::File *>(stream)->write_byte(uc);
   if (result.has_error())
     libc_errno = result.error;
   size_t written = result.value;
@@ -19,7 +19,7 @@ namespace LIBC_NAMESPACE_DECL {
 LLVM_LIBC_FUNCTION(int, putchar, (int c)) {
   unsigned char uc = static_cast<unsigned char>(c);
 
-  auto result = LIBC_NAMESPACE::stdout->write(&uc, 1);
+  auto result = LIBC_NAMESPACE::stdout->write_byte(uc);
   if (result.has_error())
     libc_errno = result.error;
   size_t written = result.value;
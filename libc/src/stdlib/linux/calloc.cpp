@@ -0,0 +1,27 @@
+//===-- Linux implementation of calloc ------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdlib/calloc.h"
+#include "src/__support/common.h"
+#include "src/__support/macros/config.h"
+#include "src/__support/size_class_heap.h"
+#include "src/errno/libc_errno.h"
+
+#include <stddef.h>
+
+namespace LIBC_NAMESPACE_DECL {
+
+LLVM_LIBC_FUNCTION(void *, calloc, (size_t num, size_t size)) {
+  void *ptr =
+      size_class_heap->calloc(size_class_heap_thread_cache(), num, size);
+  if (!ptr && num != 0 && size != 0)
+    libc_errno = ENOMEM;
+  return ptr;
+}
+
+} // namespace LIBC_NAMESPACE_DECL
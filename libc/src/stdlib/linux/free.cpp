@@ -0,0 +1,22 @@
+//===-- Linux implementation of free --------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdlib/free.h"
+#include "src/__support/common.h"
+#include "src/__support/macros/config.h"
+#include "src/__support/size_class_heap.h"
+
+#include <stddef.h>
+
+namespace LIBC_NAMESPACE_DECL {
+
+LLVM_LIBC_FUNCTION(void, free, (void *ptr)) {
+  size_class_heap->free(size_class_heap_thread_cache(), ptr);
+}
+
+} // namespace LIBC_NAMESPACE_DECL
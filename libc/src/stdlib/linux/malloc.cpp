@@ -0,0 +1,26 @@
+//===-- Linux implementation of malloc ------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdlib/malloc.h"
+#include "src/__support/common.h"
+#include "src/__support/macros/config.h"
+#include "src/__support/size_class_heap.h"
+#include "src/errno/libc_errno.h"
+
+#include <stddef.h>
+
+namespace LIBC_NAMESPACE_DECL {
+
+LLVM_LIBC_FUNCTION(void *, malloc, (size_t size)) {
+  void *ptr = size_class_heap->allocate(size_class_heap_thread_cache(), size);
+  if (!ptr)
+    libc_errno = ENOMEM;
+  return ptr;
+}
+
+} // namespace LIBC_NAMESPACE_DECL
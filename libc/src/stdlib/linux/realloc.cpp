@@ -0,0 +1,27 @@
+//===-- Linux implementation of realloc -----------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdlib/realloc.h"
+#include "src/__support/common.h"
+#include "src/__support/macros/config.h"
+#include "src/__support/size_class_heap.h"
+#include "src/errno/libc_errno.h"
+
+#include <stddef.h>
+
+namespace LIBC_NAMESPACE_DECL {
+
+LLVM_LIBC_FUNCTION(void *, realloc, (void *ptr, size_t size)) {
+  void *new_ptr =
+      size_class_heap->realloc(size_class_heap_thread_cache(), ptr, size);
+  if (!new_ptr && size != 0)
+    libc_errno = ENOMEM;
+  return new_ptr;
+}
+
+} // namespace LIBC_NAMESPACE_DECL
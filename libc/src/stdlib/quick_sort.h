@@ -105,6 +105,30 @@ LIBC_INLINE size_t partition(const A &array, size_t pivot_index,
   return num_lt;
 }
 
+// Returns the length of the sorted or strictly descending run at the start of
+// the array, and sets reversed if it is descending.
+template <typename A, typename F>
+LIBC_INLINE size_t find_existing_run(const A &array, bool &reversed,
+                                     const F &is_less) {
+  const size_t array_len = array.len();
+  reversed = false;
+  if (array_len < 2)
+    return array_len;
+
+  size_t run_len = 2;
+  reversed = is_less(array.get(1), array.get(0));
+  if (reversed) {
+    while (run_len < array_len &&
+           is_less(array.get(run_len), array.get(run_len - 1)))
+      ++run_len;
+  } else {
+    while (run_len < array_len &&
+           !is_less(array.get(run_len), array.get(run_len - 1)))
+      ++run_len;
+  }
+  return run_len;
+}
+
 template <typename A, typename F>
 LIBC_INLINE void quick_sort_impl(A &array, const void *ancestor_pivot,
                                  size_t limit, const F &is_less) {
@@ -173,6 +197,17 @@ constexpr size_t ilog2(size_t n) {
 
 template <typename A, typename F>
 LIBC_INLINE void quick_sort(A &array, const F &is_less) {
+  // Sorted and reverse sorted inputs are common, and only take a linear scan.
+  // For other inputs, the run usually ends within the first few elements.
+  bool reversed;
+  const size_t array_len = array.len();
+  if (find_existing_run(array, reversed, is_less) == array_len) {
+    if (reversed)
+      for (size_t i = 0; i < array_len / 2; ++i)
+        array.swap(i, array_len - 1 - i);
+    return;
+  }
+
   const void *ancestor_pivot = nullptr;
   // Limit the number of imbalanced partitions to `2 * floor(log2(len))`.
   // The binary OR by one is used to eliminate the zero-check in the logarithm.
@@ -16,10 +16,7 @@ namespace LIBC_NAMESPACE_DECL {
 LLVM_LIBC_FUNCTION(void *, memmem,
                    (const void *haystack, size_t haystack_len,
                     const void *needle, size_t needle_len)) {
-  constexpr auto COMP = [](unsigned char l, unsigned char r) -> int {
-    return l - r;
-  };
-  return inline_memmem(haystack, haystack_len, needle, needle_len, COMP);
+  return inline_memmem(haystack, haystack_len, needle, needle_len);
 }
 
 } // namespace LIBC_NAMESPACE_DECL
@@ -0,0 +1,58 @@
+//===-- String function blocks for aarch64 ----------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+#ifndef LLVM_LIBC_SRC_STRING_MEMORY_UTILS_AARCH64_INLINE_STRINGS_H
+#define LLVM_LIBC_SRC_STRING_MEMORY_UTILS_AARCH64_INLINE_STRINGS_H
+
+#include "src/__support/macros/attributes.h" // LIBC_INLINE
+#include "src/__support/macros/config.h"     // LIBC_NAMESPACE_DECL
+#include "src/string/memory_utils/op_aarch64.h"
+
+#include <stdint.h> // uint64_t
+
+namespace LIBC_NAMESPACE_DECL {
+namespace aarch64 {
+
+#if defined(__ARM_NEON) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+// A block for the functions in generic/inline_strings.h. NEON has no
+// equivalent of movemask, so the comparison results are narrowed to four bits
+// per byte instead, with a single shift-right-and-narrow.
+struct NeonStringBlock {
+  static constexpr size_t SIZE = 16;
+  static constexpr size_t MASK_STRIDE = 4;
+  static constexpr uint64_t FULL_MASK = ~uint64_t(0);
+
+  uint8x16_t value;
+
+  LIBC_INLINE static NeonStringBlock load_aligned(const char *src) {
+    return load(src);
+  }
+  LIBC_INLINE static NeonStringBlock load(const char *src) {
+    return {vld1q_u8(reinterpret_cast<const uint8_t *>(src))};
+  }
+  LIBC_INLINE static NeonStringBlock splat(char c) {
+    return {vdupq_n_u8(static_cast<uint8_t>(c))};
+  }
+  LIBC_INLINE uint64_t eq(NeonStringBlock other) const {
+    return to_mask(vceqq_u8(value, other.value));
+  }
+  LIBC_INLINE uint64_t zeros() const { return to_mask(vceqzq_u8(value)); }
+
+private:
+  LIBC_INLINE static uint64_t to_mask(uint8x16_t comparison) {
+    uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(comparison), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+  }
+};
+
+using StringBlock = NeonStringBlock;
+#endif // __ARM_NEON
+
+} // namespace aarch64
+} // namespace LIBC_NAMESPACE_DECL
+
+#endif // LLVM_LIBC_SRC_STRING_MEMORY_UTILS_AARCH64_INLINE_STRINGS_H
@@ -0,0 +1,254 @@
+//===-- Block based implementations of string functions ---------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+// The functions in this file process strings one block of bytes at a time. A
+// block is a vector register of the target and provides:
+// - SIZE: the number of bytes in the block, a power of two.
+// - MASK_STRIDE: the number of bits per byte of the block in a mask.
+// - FULL_MASK: the mask with the bits of all bytes of the block set.
+// - load_aligned(src) and load(src): read SIZE bytes from src, which must be
+//   aligned to SIZE for load_aligned.
+// - splat(c): a block with all bytes equal to c.
+// - eq(other) and zeros(): the mask of the bytes that are equal to the ones of
+//   other, respectively that are zero.
+//
+// Reads never cross a page boundary: aligned blocks can't, and the functions
+// that read unaligned blocks fall back to bytes near the end of a page. They
+// do read past the end of strings though, which is why they are only used with
+// LIBC_COPT_STRING_UNSAFE_WIDE_READ.
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STRING_MEMORY_UTILS_GENERIC_INLINE_STRINGS_H
+#define LLVM_LIBC_SRC_STRING_MEMORY_UTILS_GENERIC_INLINE_STRINGS_H
+
+#include "src/__support/CPP/bit.h"           // cpp::countr_zero
+#include "src/__support/macros/attributes.h" // LIBC_INLINE
+#include "src/__support/macros/config.h"     // LIBC_NAMESPACE_DECL
+#include "src/__support/macros/optimization.h" // LIBC_UNLIKELY
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uint64_t, uintptr_t
+
+namespace LIBC_NAMESPACE_DECL {
+namespace generic {
+
+namespace string_block_details {
+
+// The smallest page size of the supported targets.
+LIBC_INLINE_VAR constexpr uintptr_t PAGE_SIZE = 4096;
+
+template <typename Block> LIBC_INLINE const char *align_down(const char *src) {
+  return reinterpret_cast<const char *>(reinterpret_cast<uintptr_t>(src) &
+                                        ~uintptr_t(Block::SIZE - 1));
+}
+
+// The number of bytes that can be read from left and right before either of
+// them reaches the end of its page.
+LIBC_INLINE size_t bytes_before_page_end(const char *left, const char *right) {
+  uintptr_t l =
+      PAGE_SIZE - (reinterpret_cast<uintptr_t>(left) & (PAGE_SIZE - 1));
+  uintptr_t r =
+      PAGE_SIZE - (reinterpret_cast<uintptr_t>(right) & (PAGE_SIZE - 1));
+  return static_cast<size_t>(l < r ? l : r);
+}
+
+// The index of the first, respectively last, byte of a non-zero mask.
+template <typename Block> LIBC_INLINE size_t first_byte(uint64_t mask) {
+  return static_cast<size_t>(cpp::countr_zero(mask)) / Block::MASK_STRIDE;
+}
+template <typename Block> LIBC_INLINE size_t last_byte(uint64_t mask) {
+  return static_cast<size_t>(63 - cpp::countl_zero(mask)) / Block::MASK_STRIDE;
+}
+
+// The mask of the first count bytes of a block, for count < Block::SIZE.
+template <typename Block> LIBC_INLINE uint64_t first_bytes(size_t count) {
+  return (uint64_t(1) << (count * Block::MASK_STRIDE)) - 1;
+}
+
+// Clears the bits of the first count bytes of a mask, for count <= Block::SIZE.
+template <typename Block>
+LIBC_INLINE uint64_t drop_first_bytes(uint64_t mask, size_t count) {
+  if (count == 0)
+    return mask;
+  // Shifting by two steps keeps the shift amount below 64 for a full block.
+  return mask & ~((uint64_t(2) << (count * Block::MASK_STRIDE - 1)) - 1);
+}
+
+LIBC_INLINE int byte_diff(const char *left, const char *right) {
+  return static_cast<int>(*reinterpret_cast<const unsigned char *>(left)) -
+         static_cast<int>(*reinterpret_cast<const unsigned char *>(right));
+}
+
+} // namespace string_block_details
+
+template <typename Block>
+LIBC_INLINE size_t string_length_block(const char *src) {
+  using namespace string_block_details;
+  const char *block = align_down<Block>(src);
+  // Drop the bytes of the first block that precede src.
+  uint64_t mask = Block::load_aligned(block).zeros() >>
+                  (static_cast<size_t>(src - block) * Block::MASK_STRIDE);
+  if (mask)
+    return first_byte<Block>(mask);
+  while (true) {
+    block += Block::SIZE;
+    mask = Block::load_aligned(block).zeros();
+    if (mask)
+      return static_cast<size_t>(block - src) + first_byte<Block>(mask);
+  }
+}
+
+// Returns the first occurrence of ch within the first n bytes of src, or
+// nullptr.
+template <typename Block>
+LIBC_INLINE void *find_first_character_block(const unsigned char *src,
+                                             unsigned char ch, size_t n) {
+  using namespace string_block_details;
+  if (n == 0)
+    return nullptr;
+  const char *str = reinterpret_cast<const char *>(src);
+  const Block needle = Block::splat(static_cast<char>(ch));
+  const char *block = align_down<Block>(str);
+  size_t offset = static_cast<size_t>(str - block);
+  uint64_t mask =
+      Block::load_aligned(block).eq(needle) >> (offset * Block::MASK_STRIDE);
+  // The index in src of the first byte that the mask refers to, and of the
+  // first byte after the current block.
+  size_t position = 0;
+  size_t block_end = Block::SIZE - offset;
+  while (true) {
+    if (mask) {
+      size_t index = position + first_byte<Block>(mask);
+      return index < n ? const_cast<unsigned char *>(src + index) : nullptr;
+    }
+    if (block_end >= n)
+      return nullptr;
+    position = block_end;
+    block_end += Block::SIZE;
+    block += Block::SIZE;
+    mask = Block::load_aligned(block).eq(needle);
+  }
+}
+
+// Returns the first occurrence of ch in src. If there is none, returns nullptr
+// if ReturnNull, or the end of the string otherwise.
+template <typename Block, bool ReturnNull>
+LIBC_INLINE char *strchr_block(const char *src, char ch) {
+  using namespace string_block_details;
+  const Block needle = Block::splat(ch);
+  const char *block = align_down<Block>(src);
+  const char *base = src;
+  Block data = Block::load_aligned(block);
+  uint64_t mask = (data.eq(needle) | data.zeros()) >>
+                  (static_cast<size_t>(src - block) * Block::MASK_STRIDE);
+  while (!mask) {
+    block += Block::SIZE;
+    base = block;
+    data = Block::load_aligned(block);
+    mask = data.eq(needle) | data.zeros();
+  }
+  const char *result = base + first_byte<Block>(mask);
+  if (ReturnNull && *result != ch)
+    return nullptr;
+  return const_cast<char *>(result);
+}
+
+// Returns the last occurrence of ch in src, or nullptr.
+template <typename Block>
+LIBC_INLINE char *strrchr_block(const char *src, char ch) {
+  using namespace string_block_details;
+  const Block needle = Block::splat(ch);
+  const char *block = align_down<Block>(src);
+  const char *base = src;
+  const char *last = nullptr;
+  size_t shift = static_cast<size_t>(src - block) * Block::MASK_STRIDE;
+  Block data = Block::load_aligned(block);
+  uint64_t zeros = data.zeros() >> shift;
+  uint64_t matches = data.eq(needle) >> shift;
+  while (!zeros) {
+    if (matches)
+      last = base + last_byte<Block>(matches);
+    block += Block::SIZE;
+    base = block;
+    data = Block::load_aligned(block);
+    zeros = data.zeros();
+    matches = data.eq(needle);
+  }
+  // Drop the matches after the terminator, but keep a match of the terminator
+  // itself.
+  size_t end = first_byte<Block>(zeros) + 1;
+  if (end < 64 / Block::MASK_STRIDE)
+    matches &= first_bytes<Block>(end);
+  if (matches)
+    last = base + last_byte<Block>(matches);
+  return const_cast<char *>(last);
+}
+
+template <typename Block>
+LIBC_INLINE int strcmp_block(const char *left, const char *right) {
+  using namespace string_block_details;
+  while (true) {
+    size_t bytes = bytes_before_page_end(left, right);
+    size_t blocks = bytes / Block::SIZE;
+    if (LIBC_UNLIKELY(blocks == 0)) {
+      // Compare bytes until the nearest of the two pages ends.
+      for (; bytes != 0; --bytes, ++left, ++right)
+        if (*left != *right || *left == '\0')
+          return byte_diff(left, right);
+      continue;
+    }
+    for (; blocks != 0; --blocks) {
+      const Block l = Block::load(left);
+      const Block r = Block::load(right);
+      uint64_t mask = (~l.eq(r) & Block::FULL_MASK) | l.zeros();
+      if (mask) {
+        size_t index = first_byte<Block>(mask);
+        return byte_diff(left + index, right + index);
+      }
+      left += Block::SIZE;
+      right += Block::SIZE;
+    }
+  }
+}
+
+template <typename Block>
+LIBC_INLINE int strncmp_block(const char *left, const char *right, size_t n) {
+  using namespace string_block_details;
+  while (n != 0) {
+    size_t bytes = bytes_before_page_end(left, right);
+    size_t blocks = bytes / Block::SIZE;
+    if (LIBC_UNLIKELY(blocks == 0)) {
+      // Compare bytes until the nearest of the two pages ends.
+      for (; bytes != 0 && n != 0; --bytes, --n, ++left, ++right)
+        if (*left != *right || *left == '\0')
+          return byte_diff(left, right);
+      continue;
+    }
+    for (; blocks != 0; --blocks) {
+      const Block l = Block::load(left);
+      const Block r = Block::load(right);
+      uint64_t mask = (~l.eq(r) & Block::FULL_MASK) | l.zeros();
+      if (n < Block::SIZE)
+        mask &= first_bytes<Block>(n);
+      if (mask) {
+        size_t index = first_byte<Block>(mask);
+        return byte_diff(left + index, right + index);
+      }
+      if (n <= Block::SIZE)
+        return 0;
+      n -= Block::SIZE;
+      left += Block::SIZE;
+      right += Block::SIZE;
+    }
+  }
+  return 0;
+}
+
+} // namespace generic
+} // namespace LIBC_NAMESPACE_DECL
+
+#endif // LLVM_LIBC_SRC_STRING_MEMORY_UTILS_GENERIC_INLINE_STRINGS_H
@@ -5,39 +5,209 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 //
 //===----------------------------------------------------------------------===//
+// The search uses the Two-Way algorithm of Crochemore and Perrin, which runs in
+// linear time and constant space for any needle. When the bytes are compared
+// for equality and the target has vector registers, candidate positions are
+// first found by matching the first and the last byte of the needle a whole
+// block of positions at a time.
+//===----------------------------------------------------------------------===//
 
 #ifndef LLVM_LIBC_SRC_STRING_MEMORY_UTILS_INLINE_MEMMEM_H
 #define LLVM_LIBC_SRC_STRING_MEMORY_UTILS_INLINE_MEMMEM_H
 
 #include "src/__support/macros/attributes.h" // LIBC_INLINE
 #include "src/__support/macros/config.h"     // LIBC_NAMESPACE_DECL
+#include "src/string/memory_utils/inline_strings.h"
 
 #include <stddef.h>
 
 namespace LIBC_NAMESPACE_DECL {
+namespace memmem_details {
+
+// Returns the start of the maximal suffix of the needle, for the order of comp
+// if !Reverse and its opposite otherwise. Sets period to the period of that
+// suffix.
+template <bool Reverse, typename Comp>
+LIBC_INLINE constexpr size_t maximal_suffix(const unsigned char *n, size_t m,
+                                            size_t &period, Comp &&comp) {
+  // The suffix starts after max_suffix, which wraps around to 0 - 1 initially.
+  size_t max_suffix = static_cast<size_t>(-1);
+  size_t j = 0;
+  size_t k = 1;
+  period = 1;
+  while (j + k < m) {
+    int c = comp(n[j + k], n[max_suffix + k]);
+    if (Reverse ? c > 0 : c < 0) {
+      j += k;
+      k = 1;
+      period = j - max_suffix;
+    } else if (c == 0) {
+      if (k != period) {
+        ++k;
+      } else {
+        j += period;
+        k = 1;
+      }
+    } else {
+      max_suffix = j++;
+      k = period = 1;
+    }
+  }
+  return max_suffix + 1;
+}
+
+template <typename Comp>
+LIBC_INLINE constexpr bool equal(const unsigned char *l, const unsigned char *r,
+                                 size_t count, Comp &&comp) {
+  for (size_t i = 0; i < count; ++i)
+    if (comp(l[i], r[i]))
+      return false;
+  return true;
+}
+
+// Two-Way search of a non-empty needle of length m in the haystack of length
+// len.
+template <typename Comp>
+LIBC_INLINE constexpr const unsigned char *
+two_way(const unsigned char *h, size_t len, const unsigned char *n, size_t m,
+        Comp &&comp) {
+  if (m > len)
+    return nullptr;
+
+  // Critical factorization of the needle into n[0, suffix) and n[suffix, m).
+  size_t period = 0;
+  size_t reverse_period = 0;
+  size_t suffix = maximal_suffix<false>(n, m, period, comp);
+  size_t reverse_suffix = maximal_suffix<true>(n, m, reverse_period, comp);
+  if (reverse_suffix > suffix) {
+    suffix = reverse_suffix;
+    period = reverse_period;
+  }
+
+  const size_t last = len - m;
+  if (equal(n, n + period, suffix, comp)) {
+    // The needle is periodic: after a mismatch in the left half, the bytes of
+    // the haystack that matched a whole period of the needle need not be
+    // compared again.
+    size_t memory = 0;
+    for (size_t j = 0; j <= last;) {
+      size_t i = suffix > memory ? suffix : memory;
+      while (i < m && !comp(n[i], h[i + j]))
+        ++i;
+      if (i < m) {
+        j += i - suffix + 1;
+        memory = 0;
+        continue;
+      }
+      i = suffix;
+      while (i > memory && !comp(n[i - 1], h[i - 1 + j]))
+        --i;
+      if (i <= memory)
+        return h + j;
+      j += period;
+      memory = m - period;
+    }
+  } else {
+    // Otherwise the halves don't overlap and any mismatch in the left half
+    // allows a shift by more than the longest of them.
+    period = (suffix > m - suffix ? suffix : m - suffix) + 1;
+    for (size_t j = 0; j <= last;) {
+      size_t i = suffix;
+      while (i < m && !comp(n[i], h[i + j]))
+        ++i;
+      if (i < m) {
+        j += i - suffix + 1;
+        continue;
+      }
+      i = suffix;
+      while (i > 0 && !comp(n[i - 1], h[i - 1 + j]))
+        --i;
+      if (i == 0)
+        return h + j;
+      j += period;
+    }
+  }
+  return nullptr;
+}
+
+LIBC_INLINE_VAR constexpr auto byte_comp = [](unsigned char l,
+                                              unsigned char r) -> int {
+  return l - r;
+};
+
+#if defined(LIBC_HAS_STRING_BLOCK)
+// Finds the positions of the haystack that start with the first byte and, m - 1
+// bytes later, end with the last byte of the needle, for a block of positions
+// at a time. Only these candidates are compared with the rest of the needle.
+//
+// The comparisons of the candidates are bounded by the bytes scanned so far,
+// so that the search falls back to Two-Way for needles and haystacks that
+// produce many candidates, and stays linear.
+LIBC_INLINE const unsigned char *prefiltered(const unsigned char *h,
+                                             size_t len,
+                                             const unsigned char *n,
+                                             size_t m) {
+  using namespace generic::string_block_details;
+  const char *haystack = reinterpret_cast<const char *>(h);
+  const StringBlock first = StringBlock::splat(static_cast<char>(n[0]));
+  const StringBlock last = StringBlock::splat(static_cast<char>(n[m - 1]));
+  size_t compared = 0;
+  size_t j = 0;
+  // Both loads stay within the haystack.
+  for (; j + m - 1 + StringBlock::SIZE <= len; j += StringBlock::SIZE) {
+    uint64_t mask = StringBlock::load(haystack + j).eq(first) &
+                    StringBlock::load(haystack + j + m - 1).eq(last);
+    while (mask) {
+      size_t index = first_byte<StringBlock>(mask);
+      const unsigned char *candidate = h + j + index;
+      size_t i = 1;
+      while (i + 1 < m && candidate[i] == n[i])
+        ++i;
+      if (i + 1 >= m)
+        return candidate;
+      compared += i;
+      if (compared > 8 * j + 256)
+        return two_way(h + j, len - j, n, m, byte_comp);
+      mask = drop_first_bytes<StringBlock>(mask, index + 1);
+    }
+  }
+  return two_way(h + j, len - j, n, m, byte_comp);
+}
+#endif // LIBC_HAS_STRING_BLOCK
+
+} // namespace memmem_details
 
 template <typename Comp>
 LIBC_INLINE constexpr static void *
 inline_memmem(const void *haystack, size_t haystack_len, const void *needle,
               size_t needle_len, Comp &&comp) {
-  // TODO: simple brute force implementation. This can be
-  // improved upon using well known string matching algorithms.
   if (!needle_len)
     return const_cast<void *>(haystack);
 
+  const unsigned char *result = memmem_details::two_way(
+      static_cast<const unsigned char *>(haystack), haystack_len,
+      static_cast<const unsigned char *>(needle), needle_len, comp);
+  return const_cast<unsigned char *>(result);
+}
+
+// Same as above, with the bytes compared for equality.
+LIBC_INLINE static void *inline_memmem(const void *haystack,
+                                       size_t haystack_len, const void *needle,
+                                       size_t needle_len) {
+#if defined(LIBC_HAS_STRING_BLOCK)
+  if (!needle_len)
+    return const_cast<void *>(haystack);
   if (needle_len > haystack_len)
     return nullptr;
 
-  const unsigned char *h = static_cast<const unsigned char *>(haystack);
-  const unsigned char *n = static_cast<const unsigned char *>(needle);
-  for (size_t i = 0; i <= (haystack_len - needle_len); ++i) {
-    size_t j = 0;
-    for (; j < needle_len && !comp(h[i + j], n[j]); ++j)
-      ;
-    if (j == needle_len)
-      return const_cast<unsigned char *>(h + i);
-  }
-  return nullptr;
+  const unsigned char *result = memmem_details::prefiltered(
+      static_cast<const unsigned char *>(haystack), haystack_len,
+      static_cast<const unsigned char *>(needle), needle_len);
+  return const_cast<unsigned char *>(result);
+#else
+  return inline_memmem(haystack, haystack_len, needle, needle_len,
+                       memmem_details::byte_comp);
+#endif
 }
 
 } // namespace LIBC_NAMESPACE_DECL
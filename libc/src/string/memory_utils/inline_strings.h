@@ -0,0 +1,37 @@
+//===-- Block based string functions ----------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+// Selects the vector block of the target for the functions in
+// generic/inline_strings.h. LIBC_HAS_STRING_BLOCK is defined if there is one.
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STRING_MEMORY_UTILS_INLINE_STRINGS_H
+#define LLVM_LIBC_SRC_STRING_MEMORY_UTILS_INLINE_STRINGS_H
+
+#include "src/__support/macros/config.h"                   // LIBC_NAMESPACE_DECL
+#include "src/__support/macros/properties/architectures.h" // LIBC_TARGET_ARCH_IS_
+#include "src/string/memory_utils/generic/inline_strings.h"
+
+#if defined(LIBC_TARGET_ARCH_IS_X86)
+#include "src/string/memory_utils/x86_64/inline_strings.h"
+#if defined(__SSE2__)
+#define LIBC_HAS_STRING_BLOCK
+namespace LIBC_NAMESPACE_DECL {
+using StringBlock = x86::StringBlock;
+} // namespace LIBC_NAMESPACE_DECL
+#endif
+#elif defined(LIBC_TARGET_ARCH_IS_AARCH64)
+#include "src/string/memory_utils/aarch64/inline_strings.h"
+#if defined(__ARM_NEON) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define LIBC_HAS_STRING_BLOCK
+namespace LIBC_NAMESPACE_DECL {
+using StringBlock = aarch64::StringBlock;
+} // namespace LIBC_NAMESPACE_DECL
+#endif
+#endif
+
+#endif // LLVM_LIBC_SRC_STRING_MEMORY_UTILS_INLINE_STRINGS_H
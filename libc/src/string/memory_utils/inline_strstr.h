@@ -26,6 +26,14 @@ LIBC_INLINE constexpr char *inline_strstr(const char *haystack,
   return static_cast<char *>(result);
 }
 
+// Same as above, with the characters compared for equality.
+LIBC_INLINE char *inline_strstr(const char *haystack, const char *needle) {
+  void *result = inline_memmem(
+      static_cast<const void *>(haystack), internal::string_length(haystack),
+      static_cast<const void *>(needle), internal::string_length(needle));
+  return static_cast<char *>(result);
+}
+
 } // namespace LIBC_NAMESPACE_DECL
 
 #endif // LLVM_LIBC_SRC_STRING_MEMORY_UTILS_INLINE_STRSTR_H
@@ -0,0 +1,108 @@
+//===-- String function blocks for x86_64 -----------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+#ifndef LLVM_LIBC_SRC_STRING_MEMORY_UTILS_X86_64_INLINE_STRINGS_H
+#define LLVM_LIBC_SRC_STRING_MEMORY_UTILS_X86_64_INLINE_STRINGS_H
+
+#include "src/__support/macros/attributes.h" // LIBC_INLINE
+#include "src/__support/macros/config.h"     // LIBC_NAMESPACE_DECL
+#include "src/string/memory_utils/op_x86.h"
+
+#include <stdint.h> // uint64_t
+
+namespace LIBC_NAMESPACE_DECL {
+namespace x86 {
+
+// Blocks for the functions in generic/inline_strings.h.
+
+#if defined(__SSE2__)
+struct Sse2StringBlock {
+  static constexpr size_t SIZE = 16;
+  static constexpr size_t MASK_STRIDE = 1;
+  static constexpr uint64_t FULL_MASK = 0xffff;
+
+  __m128i value;
+
+  LIBC_INLINE static Sse2StringBlock load_aligned(const char *src) {
+    return {_mm_load_si128(reinterpret_cast<const __m128i *>(src))};
+  }
+  LIBC_INLINE static Sse2StringBlock load(const char *src) {
+    return {_mm_loadu_si128(reinterpret_cast<const __m128i *>(src))};
+  }
+  LIBC_INLINE static Sse2StringBlock splat(char c) {
+    return {_mm_set1_epi8(c)};
+  }
+  LIBC_INLINE uint64_t eq(Sse2StringBlock other) const {
+    return static_cast<uint16_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(value, other.value)));
+  }
+  LIBC_INLINE uint64_t zeros() const { return eq({_mm_setzero_si128()}); }
+};
+#endif // __SSE2__
+
+#if defined(__AVX2__)
+struct Avx2StringBlock {
+  static constexpr size_t SIZE = 32;
+  static constexpr size_t MASK_STRIDE = 1;
+  static constexpr uint64_t FULL_MASK = 0xffffffff;
+
+  __m256i value;
+
+  LIBC_INLINE static Avx2StringBlock load_aligned(const char *src) {
+    return {_mm256_load_si256(reinterpret_cast<const __m256i *>(src))};
+  }
+  LIBC_INLINE static Avx2StringBlock load(const char *src) {
+    return {_mm256_loadu_si256(reinterpret_cast<const __m256i *>(src))};
+  }
+  LIBC_INLINE static Avx2StringBlock splat(char c) {
+    return {_mm256_set1_epi8(c)};
+  }
+  LIBC_INLINE uint64_t eq(Avx2StringBlock other) const {
+    return static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(value, other.value)));
+  }
+  LIBC_INLINE uint64_t zeros() const { return eq({_mm256_setzero_si256()}); }
+};
+#endif // __AVX2__
+
+#if defined(__AVX512BW__)
+struct Avx512StringBlock {
+  static constexpr size_t SIZE = 64;
+  static constexpr size_t MASK_STRIDE = 1;
+  static constexpr uint64_t FULL_MASK = ~uint64_t(0);
+
+  __m512i value;
+
+  LIBC_INLINE static Avx512StringBlock load_aligned(const char *src) {
+    return {_mm512_load_si512(reinterpret_cast<const __m512i *>(src))};
+  }
+  LIBC_INLINE static Avx512StringBlock load(const char *src) {
+    return {_mm512_loadu_si512(reinterpret_cast<const __m512i *>(src))};
+  }
+  LIBC_INLINE static Avx512StringBlock splat(char c) {
+    return {_mm512_set1_epi8(c)};
+  }
+  LIBC_INLINE uint64_t eq(Avx512StringBlock other) const {
+    return _mm512_cmpeq_epi8_mask(value, other.value);
+  }
+  LIBC_INLINE uint64_t zeros() const { return eq({_mm512_setzero_si512()}); }
+};
+#endif // __AVX512BW__
+
+// The widest block that the target supports.
+#if defined(__AVX512BW__)
+using StringBlock = Avx512StringBlock;
+#elif defined(__AVX2__)
+using StringBlock = Avx2StringBlock;
+#elif defined(__SSE2__)
+using StringBlock = Sse2StringBlock;
+#endif
+
+} // namespace x86
+} // namespace LIBC_NAMESPACE_DECL
+
+#endif // LLVM_LIBC_SRC_STRING_MEMORY_UTILS_X86_64_INLINE_STRINGS_H
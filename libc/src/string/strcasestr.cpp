@@ -15,8 +15,6 @@
 
 namespace LIBC_NAMESPACE_DECL {
 
-// TODO: This is a simple brute force implementation. This can be
-// improved upon using well known string matching algorithms.
 LLVM_LIBC_FUNCTION(char *, strcasestr,
                    (const char *haystack, const char *needle)) {
   auto case_cmp = [](char a, char b) {
@@ -11,12 +11,17 @@
 #include "src/__support/common.h"
 #include "src/__support/macros/config.h"
 #include "src/string/memory_utils/inline_strcmp.h"
+#include "src/string/memory_utils/inline_strings.h"
 
 namespace LIBC_NAMESPACE_DECL {
 
 LLVM_LIBC_FUNCTION(int, strcmp, (const char *left, const char *right)) {
+#if defined(LIBC_COPT_STRING_UNSAFE_WIDE_READ) && defined(LIBC_HAS_STRING_BLOCK)
+  return generic::strcmp_block<StringBlock>(left, right);
+#else
   auto comp = [](char l, char r) -> int { return l - r; };
   return inline_strcmp(left, right, comp);
+#endif
 }
 
 } // namespace LIBC_NAMESPACE_DECL
@@ -21,6 +21,7 @@
 #include "src/__support/macros/optimization.h" // LIBC_UNLIKELY
 #include "src/string/memory_utils/inline_bzero.h"
 #include "src/string/memory_utils/inline_memcpy.h"
+#include "src/string/memory_utils/inline_strings.h"
 
 namespace LIBC_NAMESPACE_DECL {
 namespace internal {
@@ -83,19 +84,21 @@ LIBC_INLINE size_t string_length_wide_read(const char *src) {
 // Returns the length of a string, denoted by the first occurrence
 // of a null terminator.
 template <typename T> LIBC_INLINE size_t string_length(const T *src) {
-#ifdef LIBC_COPT_STRING_UNSAFE_WIDE_READ
+#if defined(LIBC_COPT_STRING_UNSAFE_WIDE_READ) && defined(LIBC_HAS_STRING_BLOCK)
+  if constexpr (cpp::is_same_v<T, char>)
+    return generic::string_length_block<StringBlock>(src);
+#elif defined(LIBC_COPT_STRING_UNSAFE_WIDE_READ)
   // Unsigned int is the default size for most processors, and on x86-64 it
   // performs better than larger sizes when the src pointer can't be assumed to
   // be aligned to a word boundary, so it's the size we use for reading the
   // string a block at a time.
   if constexpr (cpp::is_same_v<T, char>)
     return string_length_wide_read<unsigned int>(src);
-#else
+#endif
   size_t length;
   for (length = 0; *src; ++src, ++length)
     ;
   return length;
-#endif
 }
 
 template <typename Word>
@@ -142,7 +145,9 @@ LIBC_INLINE void *find_first_character_byte_read(const unsigned char *src,
 // 'src'. If 'ch' is not found, returns nullptr.
 LIBC_INLINE void *find_first_character(const unsigned char *src,
                                        unsigned char ch, size_t max_strlen) {
-#ifdef LIBC_COPT_STRING_UNSAFE_WIDE_READ
+#if defined(LIBC_COPT_STRING_UNSAFE_WIDE_READ) && defined(LIBC_HAS_STRING_BLOCK)
+  return generic::find_first_character_block<StringBlock>(src, ch, max_strlen);
+#elif defined(LIBC_COPT_STRING_UNSAFE_WIDE_READ)
   // If the maximum size of the string is small, the overhead of aligning to a
   // word boundary and generating a bitmask of the appropriate size may be
   // greater than the gains from reading larger chunks. Based on some testing,
@@ -229,6 +234,10 @@ template <bool ReturnNull = true>
 LIBC_INLINE constexpr static char *strchr_implementation(const char *src,
                                                          int c) {
   char ch = static_cast<char>(c);
+#if defined(LIBC_COPT_STRING_UNSAFE_WIDE_READ) && defined(LIBC_HAS_STRING_BLOCK)
+  if (!cpp::is_constant_evaluated())
+    return generic::strchr_block<StringBlock, ReturnNull>(src, ch);
+#endif
   for (; *src && *src != ch; ++src)
     ;
   char *ret = ReturnNull ? nullptr : const_cast<char *>(src);
@@ -238,6 +247,10 @@ LIBC_INLINE constexpr static char *strchr_implementation(const char *src,
 LIBC_INLINE constexpr static char *strrchr_implementation(const char *src,
                                                           int c) {
   char ch = static_cast<char>(c);
+#if defined(LIBC_COPT_STRING_UNSAFE_WIDE_READ) && defined(LIBC_HAS_STRING_BLOCK)
+  if (!cpp::is_constant_evaluated())
+    return generic::strrchr_block<StringBlock>(src, ch);
+#endif
   char *last_occurrence = nullptr;
   while (true) {
     if (*src == ch)
@@ -11,6 +11,7 @@
 #include "src/__support/common.h"
 #include "src/__support/macros/config.h"
 #include "src/string/memory_utils/inline_strcmp.h"
+#include "src/string/memory_utils/inline_strings.h"
 
 #include <stddef.h>
 
@@ -18,8 +19,12 @@ namespace LIBC_NAMESPACE_DECL {
 
 LLVM_LIBC_FUNCTION(int, strncmp,
                    (const char *left, const char *right, size_t n)) {
+#if defined(LIBC_COPT_STRING_UNSAFE_WIDE_READ) && defined(LIBC_HAS_STRING_BLOCK)
+  return generic::strncmp_block<StringBlock>(left, right, n);
+#else
   auto comp = [](char l, char r) -> int { return l - r; };
   return inline_strncmp(left, right, n, comp);
+#endif
 }
 
 } // namespace LIBC_NAMESPACE_DECL
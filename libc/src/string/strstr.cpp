@@ -14,11 +14,8 @@
 
 namespace LIBC_NAMESPACE_DECL {
 
-// TODO: This is a simple brute force implementation. This can be
-// improved upon using well known string matching algorithms.
 LLVM_LIBC_FUNCTION(char *, strstr, (const char *haystack, const char *needle)) {
-  auto comp = [](char l, char r) -> int { return l - r; };
-  return inline_strstr(haystack, needle, comp);
+  return inline_strstr(haystack, needle);
 }
 
 } // namespace LIBC_NAMESPACE_DECL
@@ -0,0 +1,91 @@
+//===-- Tests for sharing a ConcurrentHashTable between threads -----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/__support/CPP/atomic.h"
+#include "src/__support/HashTable/concurrent_table.h"
+#include "src/__support/HashTable/randomness.h"
+#include "src/__support/threads/thread.h"
+#include "test/IntegrationTest/test.h"
+
+constexpr size_t NUM_WRITERS = 4;
+constexpr size_t NUM_READERS = 4;
+constexpr size_t KEYS_PER_WRITER = 512;
+constexpr size_t NUM_KEYS = NUM_WRITERS * KEYS_PER_WRITER;
+
+struct Key {
+  char bytes[3];
+};
+
+Key keys[NUM_KEYS];
+LIBC_NAMESPACE::internal::ConcurrentHashTable table;
+LIBC_NAMESPACE::cpp::Atomic<size_t> running_writers(NUM_WRITERS);
+LIBC_NAMESPACE::cpp::Atomic<size_t> bad_results(0);
+
+void *value_of(size_t i) { return reinterpret_cast<void *>(i + 1); }
+
+// Each writer inserts its own slice of the keys, growing the table while the
+// readers look up keys of every writer.
+int writer(void *arg) {
+  size_t first = reinterpret_cast<size_t>(arg) * KEYS_PER_WRITER;
+  for (size_t i = first; i < first + KEYS_PER_WRITER; ++i) {
+    LIBC_NAMESPACE::cpp::optional<ENTRY> entry =
+        table.insert({keys[i].bytes, value_of(i)});
+    if (!entry || entry->key != keys[i].bytes || entry->data != value_of(i))
+      bad_results.fetch_add(1);
+  }
+  running_writers.fetch_sub(1);
+  return 0;
+}
+
+// A key may not have been inserted yet, but if it is found, its entry must be
+// the one its writer inserted.
+int reader(void *arg) {
+  size_t i = reinterpret_cast<size_t>(arg);
+  while (running_writers.load() != 0) {
+    i = (i + 7) % NUM_KEYS;
+    LIBC_NAMESPACE::cpp::optional<ENTRY> entry = table.find(keys[i].bytes);
+    if (entry && (entry->key != keys[i].bytes || entry->data != value_of(i)))
+      bad_results.fetch_add(1);
+  }
+  return 0;
+}
+
+TEST_MAIN() {
+  for (size_t i = 0; i < NUM_KEYS; ++i) {
+    keys[i].bytes[0] = static_cast<char>(i / 128 + 1);
+    keys[i].bytes[1] = static_cast<char>(i % 128 + 1);
+    keys[i].bytes[2] = 0;
+  }
+  // Start small, so that the writers grow the table many times.
+  ASSERT_TRUE(table.initialize(
+      0, LIBC_NAMESPACE::internal::randomness::next_random_seed()));
+
+  LIBC_NAMESPACE::Thread readers[NUM_READERS];
+  LIBC_NAMESPACE::Thread writers[NUM_WRITERS];
+  for (size_t i = 0; i < NUM_READERS; ++i)
+    ASSERT_EQ(readers[i].run(reader, reinterpret_cast<void *>(i)), 0);
+  for (size_t i = 0; i < NUM_WRITERS; ++i)
+    ASSERT_EQ(writers[i].run(writer, reinterpret_cast<void *>(i)), 0);
+
+  int retval;
+  for (size_t i = 0; i < NUM_WRITERS; ++i)
+    ASSERT_EQ(writers[i].join(&retval), 0);
+  for (size_t i = 0; i < NUM_READERS; ++i)
+    ASSERT_EQ(readers[i].join(&retval), 0);
+  ASSERT_EQ(bad_results.load(), size_t(0));
+
+  // Every key ends up in the table with its own value.
+  for (size_t i = 0; i < NUM_KEYS; ++i) {
+    LIBC_NAMESPACE::cpp::optional<ENTRY> entry = table.find(keys[i].bytes);
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_EQ(entry->data, value_of(i));
+  }
+
+  table.destroy();
+  return 0;
+}
@@ -0,0 +1,148 @@
+//===-- Tests for the thread caches of size_class_heap --------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/__support/CPP/atomic.h"
+#include "src/__support/size_class_heap.h"
+#include "src/__support/threads/thread.h"
+#include "src/sys/wait/waitpid.h"
+#include "src/unistd/_exit.h"
+#include "src/unistd/fork.h"
+#include "test/IntegrationTest/test.h"
+
+#include <sys/wait.h>
+
+constexpr size_t NUM_THREADS = 8;
+constexpr size_t ITERATIONS = 20000;
+constexpr size_t LIVE_OBJECTS = 64;
+
+LIBC_NAMESPACE::cpp::Atomic<size_t> bad_results(0);
+
+void *allocate(size_t size) {
+  return LIBC_NAMESPACE::size_class_heap->allocate(
+      LIBC_NAMESPACE::size_class_heap_thread_cache(), size);
+}
+
+void deallocate(void *ptr) {
+  LIBC_NAMESPACE::size_class_heap->free(
+      LIBC_NAMESPACE::size_class_heap_thread_cache(), ptr);
+}
+
+size_t size_of(size_t i) { return (i * 37) % 3000 + 1; }
+
+// Fills an object with the byte of its owner, and checks that nobody else
+// wrote to it before it is freed.
+void *fill(size_t size, unsigned char pattern) {
+  unsigned char *ptr = static_cast<unsigned char *>(allocate(size));
+  if (!ptr) {
+    bad_results.fetch_add(1);
+    return nullptr;
+  }
+  for (size_t i = 0; i < size; ++i)
+    ptr[i] = pattern;
+  return ptr;
+}
+
+void check_and_free(void *object, size_t size, unsigned char pattern) {
+  unsigned char *ptr = static_cast<unsigned char *>(object);
+  for (size_t i = 0; ptr && i < size; ++i) {
+    if (ptr[i] != pattern) {
+      bad_results.fetch_add(1);
+      break;
+    }
+  }
+  deallocate(ptr);
+}
+
+// Objects allocated by the main thread, each freed by one of the workers into
+// its own cache.
+void *handed_over[NUM_THREADS][LIVE_OBJECTS];
+
+int worker(void *arg) {
+  size_t id = reinterpret_cast<size_t>(arg);
+  unsigned char pattern = static_cast<unsigned char>(id + 1);
+  void *live[LIVE_OBJECTS] = {};
+  for (size_t i = 0; i < ITERATIONS; ++i) {
+    size_t slot = (i * 7 + id) % LIVE_OBJECTS;
+    if (live[slot])
+      check_and_free(live[slot], size_of(slot), pattern);
+    live[slot] = fill(size_of(slot), pattern);
+  }
+  for (size_t slot = 0; slot < LIVE_OBJECTS; ++slot) {
+    check_and_free(live[slot], size_of(slot), pattern);
+    check_and_free(handed_over[id][slot], size_of(slot), 0xff);
+  }
+  // The objects left in the cache are flushed when the thread exits.
+  return 0;
+}
+
+void multiple_threads() {
+  for (size_t id = 0; id < NUM_THREADS; ++id)
+    for (size_t slot = 0; slot < LIVE_OBJECTS; ++slot)
+      handed_over[id][slot] = fill(size_of(slot), 0xff);
+
+  LIBC_NAMESPACE::Thread threads[NUM_THREADS];
+  for (size_t id = 0; id < NUM_THREADS; ++id)
+    ASSERT_EQ(threads[id].run(worker, reinterpret_cast<void *>(id)), 0);
+  int retval;
+  for (size_t id = 0; id < NUM_THREADS; ++id)
+    ASSERT_EQ(threads[id].join(&retval), 0);
+  ASSERT_EQ(bad_results.load(), size_t(0));
+
+  // The objects of the exited threads are available again, and distinct.
+  void *objects[NUM_THREADS * LIVE_OBJECTS];
+  for (size_t i = 0; i < NUM_THREADS * LIVE_OBJECTS; ++i)
+    objects[i] = fill(64, static_cast<unsigned char>(i));
+  for (size_t i = 0; i < NUM_THREADS * LIVE_OBJECTS; ++i)
+    check_and_free(objects[i], 64, static_cast<unsigned char>(i));
+  ASSERT_EQ(bad_results.load(), size_t(0));
+}
+
+LIBC_NAMESPACE::cpp::Atomic<bool> stop_churning(false);
+
+// Keeps taking the locks of the heap while the main thread forks.
+int churn(void *) {
+  void *live[LIVE_OBJECTS] = {};
+  for (size_t i = 0; !stop_churning.load(); ++i) {
+    size_t slot = i % LIVE_OBJECTS;
+    deallocate(live[slot]);
+    // Large enough for the cache to go back to the slabs often.
+    live[slot] = allocate(size_of(i) * 8);
+  }
+  for (void *ptr : live)
+    deallocate(ptr);
+  return 0;
+}
+
+// The child of a fork must find the locks of the heap released, whatever the
+// other threads of the parent were doing.
+void fork_while_allocating() {
+  LIBC_NAMESPACE::Thread thread;
+  ASSERT_EQ(thread.run(churn, nullptr), 0);
+  for (int i = 0; i < 20; ++i) {
+    pid_t pid = LIBC_NAMESPACE::fork();
+    if (pid == 0) {
+      for (size_t j = 0; j < 1000; ++j)
+        check_and_free(fill(size_of(j) * 8, 0x5a), size_of(j) * 8, 0x5a);
+      LIBC_NAMESPACE::_exit(bad_results.load() == 0 ? 0 : 1);
+    }
+    ASSERT_TRUE(pid > 0);
+    int status;
+    ASSERT_EQ(LIBC_NAMESPACE::waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+  }
+  stop_churning.store(true);
+  int retval;
+  ASSERT_EQ(thread.join(&retval), 0);
+}
+
+TEST_MAIN() {
+  multiple_threads();
+  fork_while_allocating();
+  return 0;
+}
@@ -10,6 +10,8 @@
 #include "src/pthread/pthread_mutex_init.h"
 #include "src/pthread/pthread_mutex_lock.h"
 #include "src/pthread/pthread_mutex_unlock.h"
+#include "src/pthread/pthread_mutexattr_init.h"
+#include "src/pthread/pthread_mutexattr_setprotocol.h"
 
 #include "src/pthread/pthread_create.h"
 #include "src/pthread/pthread_join.h"
@@ -40,8 +42,9 @@ void *counter(void *arg) {
   return nullptr;
 }
 
-void relay_counter() {
-  ASSERT_EQ(LIBC_NAMESPACE::pthread_mutex_init(&mutex, nullptr), 0);
+void relay_counter(const pthread_mutexattr_t *attr) {
+  shared_int = START;
+  ASSERT_EQ(LIBC_NAMESPACE::pthread_mutex_init(&mutex, attr), 0);
 
   // The idea of this test is that two competing threads will update
   // a counter only if the other thread has updated it.
@@ -191,7 +194,15 @@ void multiple_waiters() {
 static pthread_mutex_t test_initializer = PTHREAD_MUTEX_INITIALIZER;
 
 TEST_MAIN() {
-  relay_counter();
+  relay_counter(nullptr);
+
+  pthread_mutexattr_t pi_attr;
+  ASSERT_EQ(LIBC_NAMESPACE::pthread_mutexattr_init(&pi_attr), 0);
+  ASSERT_EQ(LIBC_NAMESPACE::pthread_mutexattr_setprotocol(&pi_attr,
+                                                          PTHREAD_PRIO_INHERIT),
+            0);
+  relay_counter(&pi_attr);
+
   wait_and_step();
   multiple_waiters();
   return 0;
@@ -26,10 +26,13 @@ class StringFile : public File {
   char str[SIZE] = {0};
   size_t eof_marker;
   bool write_append;
+  size_t writev_count;
 
   static FileIOResult str_read(LIBC_NAMESPACE::File *f, void *data, size_t len);
   static FileIOResult str_write(LIBC_NAMESPACE::File *f, const void *data,
                                 size_t len);
+  static FileIOResult str_writev(LIBC_NAMESPACE::File *f, const void *data1,
+                                 size_t len1, const void *data2, size_t len2);
   static ErrorOr<off_t> str_seek(LIBC_NAMESPACE::File *f, off_t offset,
                                  int whence);
   static int str_close(LIBC_NAMESPACE::File *f) {
@@ -39,11 +42,12 @@ class StringFile : public File {
 
 public:
   explicit StringFile(char *buffer, size_t buflen, int bufmode, bool owned,
-                      ModeFlags modeflags)
+                      ModeFlags modeflags, bool vectored = false)
       : LIBC_NAMESPACE::File(&str_write, &str_read, &str_seek, &str_close,
                              reinterpret_cast<uint8_t *>(buffer), buflen,
-                             bufmode, owned, modeflags),
-        pos(0), eof_marker(0), write_append(false) {
+                             bufmode, owned, modeflags,
+                             vectored ? &str_writev : nullptr),
+        pos(0), eof_marker(0), write_append(false), writev_count(0) {
     if (modeflags &
         static_cast<ModeFlags>(LIBC_NAMESPACE::File::OpenMode::APPEND))
       write_append = true;
@@ -51,6 +55,7 @@ public:
 
   void reset() { pos = 0; }
   size_t get_pos() const { return pos; }
+  size_t get_writev_count() const { return writev_count; }
   char *get_str() { return str; }
 
   // Use this method to prefill the file.
@@ -92,6 +97,16 @@ FileIOResult StringFile::str_write(LIBC_NAMESPACE::File *f, const void *data,
   return i;
 }
 
+FileIOResult StringFile::str_writev(LIBC_NAMESPACE::File *f,
+                                    const void *data1, size_t len1,
+                                    const void *data2, size_t len2) {
+  ++static_cast<StringFile *>(f)->writev_count;
+  size_t written = str_write(f, data1, len1);
+  if (written < len1)
+    return written;
+  return written + str_write(f, data2, len2);
+}
+
 ErrorOr<off_t> StringFile::str_seek(LIBC_NAMESPACE::File *f, off_t offset,
                                     int whence) {
   StringFile *sf = static_cast<StringFile *>(f);
@@ -105,12 +120,13 @@ ErrorOr<off_t> StringFile::str_seek(LIBC_NAMESPACE::File *f, off_t offset,
 }
 
 StringFile *new_string_file(char *buffer, size_t buflen, int bufmode,
-                            bool owned, const char *mode) {
+                            bool owned, const char *mode,
+                            bool vectored = false) {
   LIBC_NAMESPACE::AllocChecker ac;
   // We will just assume the allocation succeeds. We cannot test anything
   // otherwise.
   return new (ac) StringFile(buffer, buflen, bufmode, owned,
-                             LIBC_NAMESPACE::File::mode_flags(mode));
+                             LIBC_NAMESPACE::File::mode_flags(mode), vectored);
 }
 
 TEST(LlvmLibcFileTest, WriteOnly) {
@@ -226,6 +242,56 @@ TEST(LlvmLibcFileTest, WriteUnbuffered) {
   ASSERT_EQ(f->close(), 0);
 }
 
+TEST(LlvmLibcFileTest, WriteBytes) {
+  constexpr size_t FILE_BUFFER_SIZE = 4;
+  char file_buffer_line[FILE_BUFFER_SIZE];
+  char file_buffer_full[FILE_BUFFER_SIZE];
+  StringFile *f_line =
+      new_string_file(file_buffer_line, FILE_BUFFER_SIZE, _IOLBF, false, "w");
+  StringFile *f_full =
+      new_string_file(file_buffer_full, FILE_BUFFER_SIZE, _IOFBF, false, "w");
+
+  const char data[] = "ab\nc";
+  for (size_t i = 0; i < sizeof(data) - 1; ++i) {
+    ASSERT_EQ(f_line->write_byte(data[i]).value, size_t(1));
+    ASSERT_EQ(f_full->write_byte(data[i]).value, size_t(1));
+  }
+  // The newline flushes the line buffered file.
+  EXPECT_EQ(f_line->get_pos(), size_t(3));
+  EXPECT_EQ(f_full->get_pos(), size_t(0));
+  MemoryView src1("ab\n", 3), dst1(f_line->get_str(), 3);
+  EXPECT_MEM_EQ(src1, dst1);
+
+  // The full buffer is flushed on the next byte.
+  ASSERT_EQ(f_full->write_byte('d').value, size_t(1));
+  EXPECT_EQ(f_full->get_pos(), size_t(4));
+  MemoryView src2("ab\nc", 4), dst2(f_full->get_str(), 4);
+  EXPECT_MEM_EQ(src2, dst2);
+
+  ASSERT_EQ(f_line->close(), 0);
+  ASSERT_EQ(f_full->close(), 0);
+}
+
+TEST(LlvmLibcFileTest, WriteMergesBuffer) {
+  const char data[] = "larger than the buffer";
+  constexpr size_t FILE_BUFFER_SIZE = 8;
+  char file_buffer[FILE_BUFFER_SIZE];
+  StringFile *f = new_string_file(file_buffer, FILE_BUFFER_SIZE, _IOFBF, false,
+                                  "w", /*vectored=*/true);
+
+  ASSERT_EQ(f->write("abc", 3).value, size_t(3));
+  EXPECT_EQ(f->get_pos(), size_t(0));
+  // The buffered bytes and the data are written together.
+  ASSERT_EQ(f->write(data, sizeof(data)).value, sizeof(data));
+  EXPECT_EQ(f->get_writev_count(), size_t(1));
+  EXPECT_EQ(f->get_pos(), sizeof(data) + 3);
+  MemoryView src("abclarger than the buffer", sizeof(data) + 3),
+      dst(f->get_str(), sizeof(data) + 3);
+  EXPECT_MEM_EQ(src, dst);
+
+  ASSERT_EQ(f->close(), 0);
+}
+
 TEST(LlvmLibcFileTest, ReadOnly) {
   const char initial_content[] = "1234567890987654321";
   constexpr size_t FILE_BUFFER_SIZE = sizeof(initial_content);
@@ -279,6 +345,28 @@ TEST(LlvmLibcFileTest, ReadOnly) {
   ASSERT_EQ(f->close(), 0);
 }
 
+TEST(LlvmLibcFileTest, ReadBytes) {
+  const char initial_content[] = "123456";
+  constexpr size_t FILE_BUFFER_SIZE = 4;
+  char file_buffer[FILE_BUFFER_SIZE];
+  StringFile *f =
+      new_string_file(file_buffer, FILE_BUFFER_SIZE, _IOFBF, false, "r");
+  f->reset_and_fill(initial_content, sizeof(initial_content) - 1);
+
+  uint8_t c;
+  for (size_t i = 0; i < 5; ++i) {
+    ASSERT_EQ(f->read_byte(c).value, size_t(1));
+    EXPECT_EQ(c, uint8_t(initial_content[i]));
+  }
+  ASSERT_EQ(f->ungetc('x'), int('x'));
+  ASSERT_EQ(f->read_byte(c).value, size_t(1));
+  EXPECT_EQ(c, uint8_t('x'));
+  ASSERT_EQ(f->read_byte(c).value, size_t(1));
+  EXPECT_EQ(c, uint8_t('6'));
+
+  ASSERT_EQ(f->close(), 0);
+}
+
 TEST(LlvmLibcFileTest, ReadSeekCurAndRead) {
   const char initial_content[] = "1234567890987654321";
   constexpr size_t FILE_BUFFER_SIZE = sizeof(initial_content);
@@ -0,0 +1,57 @@
+//===-- Unittests for concurrent_table ------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/__support/HashTable/concurrent_table.h"
+#include "src/__support/HashTable/randomness.h"
+#include "src/__support/macros/config.h"
+#include "test/UnitTest/Test.h"
+
+namespace LIBC_NAMESPACE_DECL {
+namespace internal {
+
+TEST(LlvmLibcConcurrentTableTest, FindAndInsert) {
+  constexpr size_t TEST_SIZE = 256;
+  struct key {
+    char bytes[3];
+  } keys[TEST_SIZE];
+  for (size_t i = 0; i < TEST_SIZE; ++i) {
+    keys[i].bytes[0] = static_cast<char>(i / 16 + 1);
+    keys[i].bytes[1] = static_cast<char>(i % 16 + 1);
+    keys[i].bytes[2] = 0;
+  }
+
+  ConcurrentHashTable table;
+  ASSERT_TRUE(table.initialize(0, randomness::next_random_seed()));
+  ASSERT_FALSE(table.find(keys[0].bytes).has_value());
+
+  // Insert enough keys for the table to grow several times.
+  for (size_t i = 0; i < TEST_SIZE; ++i) {
+    cpp::optional<ENTRY> entry =
+        table.insert({keys[i].bytes, reinterpret_cast<void *>(i)});
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_EQ(entry->data, reinterpret_cast<void *>(i));
+  }
+
+  for (size_t i = 0; i < TEST_SIZE; ++i) {
+    cpp::optional<ENTRY> entry = table.find(keys[i].bytes);
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_EQ(entry->key, keys[i].bytes);
+    ASSERT_EQ(entry->data, reinterpret_cast<void *>(i));
+  }
+
+  // Inserting an existing key returns its entry and keeps the old value.
+  cpp::optional<ENTRY> entry =
+      table.insert({keys[1].bytes, reinterpret_cast<void *>(TEST_SIZE)});
+  ASSERT_TRUE(entry.has_value());
+  ASSERT_EQ(entry->data, reinterpret_cast<void *>(1));
+
+  table.destroy();
+}
+
+} // namespace internal
+} // namespace LIBC_NAMESPACE_DECL
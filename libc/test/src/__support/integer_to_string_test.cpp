@@ -417,4 +417,19 @@ TEST(LlvmLibcIntegerToStringTest, BufferOverrun) {
     const auto view = IntegerToString<int>::format_to(buffer, 11);
     ASSERT_FALSE(view.has_value());
   }
+  char small[3];
+  { // Writing a large number in a three char buffer : fails
+    const auto view =
+        IntegerToString<uint64_t>::format_to(small, 18446744073709551615ULL);
+    ASSERT_FALSE(view.has_value());
+  }
+  { // Writing '123' in a three char buffer : works
+    const auto view = IntegerToString<uint32_t>::format_to(small, 123);
+    ASSERT_TRUE(view.has_value());
+    ASSERT_EQ(*view, string_view("123"));
+  }
+  { // Writing '1234' in a three char buffer : fails
+    const auto view = IntegerToString<uint32_t>::format_to(small, 1234);
+    ASSERT_FALSE(view.has_value());
+  }
 }
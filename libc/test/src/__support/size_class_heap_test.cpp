@@ -0,0 +1,144 @@
+//===-- Unittests for size_class_heap -------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/__support/macros/config.h"
+#include "src/__support/size_class_heap.h"
+#include "test/UnitTest/Test.h"
+
+#include <stdint.h>
+
+using LIBC_NAMESPACE::SizeClassHeap;
+namespace size_class = LIBC_NAMESPACE::size_class;
+
+// The tests share a heap, separate from the global one, and each uses its own
+// thread cache.
+static SizeClassHeap heap;
+
+TEST(LlvmLibcSizeClassHeapTest, SizeClasses) {
+  ASSERT_EQ(size_class::index_of(0), size_t(0));
+  ASSERT_EQ(size_class::index_of(size_class::MAX_SMALL_SIZE),
+            size_class::NUM_CLASSES - 1);
+  ASSERT_EQ(size_class::size_of(size_class::NUM_CLASSES - 1),
+            size_class::MAX_SMALL_SIZE);
+  // Every size goes to the smallest class that fits it.
+  for (size_t size = 1; size <= size_class::MAX_SMALL_SIZE; ++size) {
+    size_t index = size_class::index_of(size);
+    ASSERT_GE(size_class::size_of(index), size);
+    if (index != 0)
+      ASSERT_LT(size_class::size_of(index - 1), size);
+  }
+}
+
+TEST(LlvmLibcSizeClassHeapTest, AllocateAndFree) {
+  SizeClassHeap::ThreadCache cache;
+  for (size_t size = 0; size <= 2 * size_class::MAX_SMALL_SIZE; size += 333) {
+    unsigned char *ptr =
+        static_cast<unsigned char *>(heap.allocate(cache, size));
+    ASSERT_NE(ptr, static_cast<unsigned char *>(nullptr));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignof(max_align_t),
+              uintptr_t(0));
+    for (size_t i = 0; i < size; ++i)
+      ptr[i] = static_cast<unsigned char>(i);
+    heap.free(cache, ptr);
+  }
+  heap.flush(cache);
+}
+
+TEST(LlvmLibcSizeClassHeapTest, ReusesFreedObjects) {
+  SizeClassHeap::ThreadCache cache;
+  void *ptr = heap.allocate(cache, 100);
+  heap.free(cache, ptr);
+  EXPECT_EQ(heap.allocate(cache, 100), ptr);
+  heap.free(cache, ptr);
+  heap.flush(cache);
+}
+
+TEST(LlvmLibcSizeClassHeapTest, DistinctObjects) {
+  constexpr size_t COUNT = 2048;
+  static uintptr_t objects[COUNT];
+  SizeClassHeap::ThreadCache cache;
+  // Enough objects to go through several slabs and batches.
+  for (size_t i = 0; i < COUNT; ++i) {
+    objects[i] = reinterpret_cast<uintptr_t>(heap.allocate(cache, 200));
+    ASSERT_NE(objects[i], uintptr_t(0));
+  }
+  for (size_t i = 0; i < COUNT; ++i)
+    for (size_t j = i + 1; j < COUNT; ++j)
+      ASSERT_TRUE(objects[i] + 200 <= objects[j] ||
+                  objects[j] + 200 <= objects[i]);
+  for (size_t i = 0; i < COUNT; ++i)
+    heap.free(cache, reinterpret_cast<void *>(objects[i]));
+  heap.flush(cache);
+}
+
+TEST(LlvmLibcSizeClassHeapTest, AlignedAllocate) {
+  SizeClassHeap::ThreadCache cache;
+  for (size_t alignment = 1; alignment <= 4 * SizeClassHeap::SLAB_SIZE;
+       alignment *= 2) {
+    for (size_t size : {size_t(0), size_t(1), size_t(1000), size_t(100000)}) {
+      char *ptr = static_cast<char *>(
+          heap.aligned_allocate(cache, alignment, size));
+      ASSERT_NE(ptr, static_cast<char *>(nullptr));
+      EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignment, uintptr_t(0));
+      for (size_t i = 0; i < size; ++i)
+        ptr[i] = 'a';
+      heap.free(cache, ptr);
+    }
+  }
+  EXPECT_EQ(heap.aligned_allocate(cache, 3, 16), static_cast<void *>(nullptr));
+  heap.flush(cache);
+}
+
+TEST(LlvmLibcSizeClassHeapTest, Calloc) {
+  SizeClassHeap::ThreadCache cache;
+  for (size_t size : {size_t(64), size_t(5000), size_t(100000)}) {
+    // Dirty an object of the same size class first.
+    unsigned char *ptr =
+        static_cast<unsigned char *>(heap.allocate(cache, size));
+    for (size_t i = 0; i < size; ++i)
+      ptr[i] = 0xff;
+    heap.free(cache, ptr);
+    ptr = static_cast<unsigned char *>(heap.calloc(cache, size, 1));
+    ASSERT_NE(ptr, static_cast<unsigned char *>(nullptr));
+    for (size_t i = 0; i < size; ++i)
+      ASSERT_EQ(ptr[i], static_cast<unsigned char>(0));
+    heap.free(cache, ptr);
+  }
+  EXPECT_EQ(heap.calloc(cache, SIZE_MAX / 2, 3), static_cast<void *>(nullptr));
+  heap.flush(cache);
+}
+
+TEST(LlvmLibcSizeClassHeapTest, Realloc) {
+  SizeClassHeap::ThreadCache cache;
+  unsigned char *ptr =
+      static_cast<unsigned char *>(heap.realloc(cache, nullptr, 10));
+  ASSERT_NE(ptr, static_cast<unsigned char *>(nullptr));
+  for (size_t i = 0; i < 10; ++i)
+    ptr[i] = static_cast<unsigned char>(i);
+  // Grow through small and large sizes, then shrink again.
+  for (size_t size :
+       {size_t(100), size_t(40000), size_t(1000000), size_t(20)}) {
+    ptr = static_cast<unsigned char *>(heap.realloc(cache, ptr, size));
+    ASSERT_NE(ptr, static_cast<unsigned char *>(nullptr));
+    for (size_t i = 0; i < 10; ++i)
+      ASSERT_EQ(ptr[i], static_cast<unsigned char>(i));
+  }
+  EXPECT_EQ(heap.realloc(cache, ptr, 0), static_cast<void *>(nullptr));
+  heap.flush(cache);
+}
+
+TEST(LlvmLibcSizeClassHeapTest, FreeAfterFlush) {
+  SizeClassHeap::ThreadCache cache;
+  void *ptr = heap.allocate(cache, 32);
+  heap.flush(cache);
+  // A flushed cache doesn't keep objects anymore, but still works.
+  heap.free(cache, ptr);
+  ptr = heap.allocate(cache, 32);
+  ASSERT_NE(ptr, static_cast<void *>(nullptr));
+  heap.free(cache, ptr);
+}
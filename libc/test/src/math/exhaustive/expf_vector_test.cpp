@@ -0,0 +1,52 @@
+//===-- Exhaustive test for the vector variants of expf -------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "exhaustive_test.h"
+#include "src/__support/FPUtil/vector_types.h"
+#include "src/__support/macros/properties/architectures.h"
+#include "utils/MPFRWrapper/MPFRUtils.h"
+
+#if defined(LIBC_TARGET_ARCH_IS_X86)
+#include "src/math/_ZGVbN4v_expf.h"
+#define VECTOR_EXPF LIBC_NAMESPACE::_ZGVbN4v_expf
+#elif defined(LIBC_TARGET_ARCH_IS_AARCH64)
+#include "src/math/_ZGVnN4v_expf.h"
+#define VECTOR_EXPF LIBC_NAMESPACE::_ZGVnN4v_expf
+#endif
+
+namespace mpfr = LIBC_NAMESPACE::testing::mpfr;
+
+// Consecutive inputs go to different lanes, with ordinary values in the others.
+static float expf_lane(float x) {
+  unsigned lane = LIBC_NAMESPACE::fputil::FPBits<float>(x).uintval() % 4;
+  LIBC_NAMESPACE::fputil::v4f32 v = {1.0f, -1.0f, 0.5f, -0.5f};
+  v[lane] = x;
+  return VECTOR_EXPF(v)[lane];
+}
+
+using LlvmLibcExpfVectorExhaustiveTest =
+    LlvmLibcUnaryOpExhaustiveMathTest<float, mpfr::Operation::Exp, expf_lane>;
+
+// The vector variants are only correctly rounded in the default rounding
+// mode.
+
+// Range: [0, Inf];
+static constexpr uint32_t POS_START = 0x0000'0000U;
+static constexpr uint32_t POS_STOP = 0x7f80'0000U;
+
+TEST_F(LlvmLibcExpfVectorExhaustiveTest, PostiveRange) {
+  test_full_range(mpfr::RoundingMode::Nearest, POS_START, POS_STOP);
+}
+
+// Range: [-Inf, 0];
+static constexpr uint32_t NEG_START = 0xb000'0000U;
+static constexpr uint32_t NEG_STOP = 0xff80'0000U;
+
+TEST_F(LlvmLibcExpfVectorExhaustiveTest, NegativeRange) {
+  test_full_range(mpfr::RoundingMode::Nearest, NEG_START, NEG_STOP);
+}
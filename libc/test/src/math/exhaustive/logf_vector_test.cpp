@@ -0,0 +1,44 @@
+//===-- Exhaustive test for the vector variants of logf -------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "exhaustive_test.h"
+#include "src/__support/FPUtil/vector_types.h"
+#include "src/__support/macros/properties/architectures.h"
+#include "utils/MPFRWrapper/MPFRUtils.h"
+
+#if defined(LIBC_TARGET_ARCH_IS_X86)
+#include "src/math/_ZGVbN4v_logf.h"
+#define VECTOR_LOGF LIBC_NAMESPACE::_ZGVbN4v_logf
+#elif defined(LIBC_TARGET_ARCH_IS_AARCH64)
+#include "src/math/_ZGVnN4v_logf.h"
+#define VECTOR_LOGF LIBC_NAMESPACE::_ZGVnN4v_logf
+#endif
+
+namespace mpfr = LIBC_NAMESPACE::testing::mpfr;
+
+// Consecutive inputs go to different lanes, with ordinary values in the others.
+static float logf_lane(float x) {
+  unsigned lane = LIBC_NAMESPACE::fputil::FPBits<float>(x).uintval() % 4;
+  LIBC_NAMESPACE::fputil::v4f32 v = {2.0f, 0.5f, 3.0f, 0.25f};
+  v[lane] = x;
+  return VECTOR_LOGF(v)[lane];
+}
+
+using LlvmLibcLogfVectorExhaustiveTest =
+    LlvmLibcUnaryOpExhaustiveMathTest<float, mpfr::Operation::Log, logf_lane>;
+
+// The vector variants are only correctly rounded in the default rounding
+// mode.
+
+// Range: [0, Inf];
+static constexpr uint32_t POS_START = 0x0000'0000U;
+static constexpr uint32_t POS_STOP = 0x7f80'0000U;
+
+TEST_F(LlvmLibcLogfVectorExhaustiveTest, PostiveRange) {
+  test_full_range(mpfr::RoundingMode::Nearest, POS_START, POS_STOP);
+}
@@ -0,0 +1,80 @@
+//===-- Differential test for the vector variants of expf -----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/__support/FPUtil/vector_types.h"
+#include "src/__support/macros/properties/architectures.h"
+#include "src/math/expf.h"
+#include "test/src/math/performance_testing/Timer.h"
+
+#include <fstream>
+
+#if defined(LIBC_TARGET_ARCH_IS_X86)
+#include "src/math/_ZGVbN4v_expf.h"
+#define VECTOR_EXPF LIBC_NAMESPACE::_ZGVbN4v_expf
+#elif defined(LIBC_TARGET_ARCH_IS_AARCH64)
+#include "src/math/_ZGVnN4v_expf.h"
+#define VECTOR_EXPF LIBC_NAMESPACE::_ZGVnN4v_expf
+#endif
+
+using LIBC_NAMESPACE::fputil::v4f32;
+
+static v4f32 scalar_expf(v4f32 x) {
+  return v4f32{LIBC_NAMESPACE::expf(x[0]), LIBC_NAMESPACE::expf(x[1]),
+               LIBC_NAMESPACE::expf(x[2]), LIBC_NAMESPACE::expf(x[3])};
+}
+
+constexpr size_t N = 1 << 14;
+static float inputs[N];
+static float outputs[N];
+
+// Measures the throughput over N inputs spread evenly in [start, stop), four
+// at a time. Unlike the bit patterns, the values are spread evenly, so that
+// the results are not dominated by those of tiny inputs.
+static double run(v4f32 (*func)(v4f32), float start, float stop,
+                  std::ofstream &log) {
+  constexpr size_t ROUNDS = 1000;
+  float step = (stop - start) / N;
+  for (size_t i = 0; i < N; ++i)
+    inputs[i] = start + static_cast<float>(i) * step;
+
+  LIBC_NAMESPACE::testing::Timer timer;
+  timer.start();
+  for (size_t round = 0; round < ROUNDS; ++round) {
+    for (size_t i = 0; i < N; i += 4) {
+      v4f32 x = {inputs[i], inputs[i + 1], inputs[i + 2], inputs[i + 3]};
+      v4f32 y = func(x);
+      for (size_t j = 0; j < 4; ++j)
+        outputs[i + j] = y[j];
+    }
+  }
+  timer.stop();
+  double average = static_cast<double>(timer.nanoseconds()) / N / ROUNDS;
+  log << "     Total time      : " << timer.nanoseconds() << " ns \n";
+  log << "     Average runtime : " << average << " ns/op \n";
+  log << "     Ops per second  : "
+      << static_cast<uint64_t>(1'000'000'000.0 / average) << " op/s \n";
+  return average;
+}
+
+static void run_in_range(float start, float stop, std::ofstream &log) {
+  log << "-- Vector function --\n";
+  double vector_average = run(&VECTOR_EXPF, start, stop, log);
+  log << "-- Scalar function --\n";
+  double scalar_average = run(&scalar_expf, start, stop, log);
+  log << "-- Average runtime ratio --\n";
+  log << "     Vector / Scalar : " << vector_average / scalar_average << " \n";
+}
+
+int main() {
+  std::ofstream log("expf_vector_perf.log");
+  log << " Performance tests with inputs in [-88, 0]:\n";
+  run_in_range(-88.0f, 0.0f, log);
+  log << "\n Performance tests with inputs in [0, 88]:\n";
+  run_in_range(0.0f, 88.0f, log);
+  return 0;
+}
@@ -0,0 +1,80 @@
+//===-- Differential test for the vector variants of logf -----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/__support/FPUtil/vector_types.h"
+#include "src/__support/macros/properties/architectures.h"
+#include "src/math/logf.h"
+#include "test/src/math/performance_testing/Timer.h"
+
+#include <fstream>
+
+#if defined(LIBC_TARGET_ARCH_IS_X86)
+#include "src/math/_ZGVbN4v_logf.h"
+#define VECTOR_LOGF LIBC_NAMESPACE::_ZGVbN4v_logf
+#elif defined(LIBC_TARGET_ARCH_IS_AARCH64)
+#include "src/math/_ZGVnN4v_logf.h"
+#define VECTOR_LOGF LIBC_NAMESPACE::_ZGVnN4v_logf
+#endif
+
+using LIBC_NAMESPACE::fputil::v4f32;
+
+static v4f32 scalar_logf(v4f32 x) {
+  return v4f32{LIBC_NAMESPACE::logf(x[0]), LIBC_NAMESPACE::logf(x[1]),
+               LIBC_NAMESPACE::logf(x[2]), LIBC_NAMESPACE::logf(x[3])};
+}
+
+constexpr size_t N = 1 << 14;
+static float inputs[N];
+static float outputs[N];
+
+// Measures the throughput over N inputs spread evenly in [start, stop), four
+// at a time. Unlike the bit patterns, the values are spread evenly, so that
+// the results are not dominated by those of tiny inputs.
+static double run(v4f32 (*func)(v4f32), float start, float stop,
+                  std::ofstream &log) {
+  constexpr size_t ROUNDS = 1000;
+  float step = (stop - start) / N;
+  for (size_t i = 0; i < N; ++i)
+    inputs[i] = start + static_cast<float>(i) * step;
+
+  LIBC_NAMESPACE::testing::Timer timer;
+  timer.start();
+  for (size_t round = 0; round < ROUNDS; ++round) {
+    for (size_t i = 0; i < N; i += 4) {
+      v4f32 x = {inputs[i], inputs[i + 1], inputs[i + 2], inputs[i + 3]};
+      v4f32 y = func(x);
+      for (size_t j = 0; j < 4; ++j)
+        outputs[i + j] = y[j];
+    }
+  }
+  timer.stop();
+  double average = static_cast<double>(timer.nanoseconds()) / N / ROUNDS;
+  log << "     Total time      : " << timer.nanoseconds() << " ns \n";
+  log << "     Average runtime : " << average << " ns/op \n";
+  log << "     Ops per second  : "
+      << static_cast<uint64_t>(1'000'000'000.0 / average) << " op/s \n";
+  return average;
+}
+
+static void run_in_range(float start, float stop, std::ofstream &log) {
+  log << "-- Vector function --\n";
+  double vector_average = run(&VECTOR_LOGF, start, stop, log);
+  log << "-- Scalar function --\n";
+  double scalar_average = run(&scalar_logf, start, stop, log);
+  log << "-- Average runtime ratio --\n";
+  log << "     Vector / Scalar : " << vector_average / scalar_average << " \n";
+}
+
+int main() {
+  std::ofstream log("logf_vector_perf.log");
+  log << " Performance tests with inputs in [2^-10, 1]:\n";
+  run_in_range(0x1.0p-10f, 1.0f, log);
+  log << "\n Performance tests with inputs in [1, 2^20]:\n";
+  run_in_range(1.0f, 0x1.0p20f, log);
+  return 0;
+}
@@ -0,0 +1,65 @@
+//===-- Unittests for the vector variants of expf -------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/__support/FPUtil/FPBits.h"
+#include "src/__support/FPUtil/vector_types.h"
+#include "src/__support/macros/properties/architectures.h"
+#include "src/math/expf.h"
+#include "test/UnitTest/FPMatcher.h"
+#include "test/UnitTest/Test.h"
+
+#include <stdint.h>
+
+#if defined(LIBC_TARGET_ARCH_IS_X86)
+#include "src/math/_ZGVbN4v_expf.h"
+#define VECTOR_EXPF LIBC_NAMESPACE::_ZGVbN4v_expf
+#elif defined(LIBC_TARGET_ARCH_IS_AARCH64)
+#include "src/math/_ZGVnN4v_expf.h"
+#define VECTOR_EXPF LIBC_NAMESPACE::_ZGVnN4v_expf
+#endif
+
+using LlvmLibcExpfVectorTest = LIBC_NAMESPACE::testing::FPTest<float>;
+using LIBC_NAMESPACE::fputil::v4f32;
+
+TEST_F(LlvmLibcExpfVectorTest, SpecialNumbers) {
+  v4f32 result = VECTOR_EXPF(v4f32{aNaN, inf, neg_inf, 0.0f});
+  EXPECT_FP_EQ(aNaN, result[0]);
+  EXPECT_FP_EQ(inf, result[1]);
+  EXPECT_FP_EQ(0.0f, result[2]);
+  EXPECT_FP_EQ(1.0f, result[3]);
+
+  // The special lanes don't affect the others.
+  result = VECTOR_EXPF(v4f32{1.0f, 100.0f, -0.0f, -110.0f});
+  EXPECT_FP_EQ(LIBC_NAMESPACE::expf(1.0f), result[0]);
+  EXPECT_FP_EQ(inf, result[1]);
+  EXPECT_FP_EQ(1.0f, result[2]);
+  EXPECT_FP_EQ(0.0f, result[3]);
+}
+
+// The results are the same as the scalar function, which is correctly rounded.
+TEST_F(LlvmLibcExpfVectorTest, MatchesScalar) {
+  constexpr uint32_t COUNT = 100'000;
+  constexpr uint32_t STEP = UINT32_MAX / COUNT / 4;
+  for (uint32_t i = 0, v = 0; i <= COUNT; ++i) {
+    v4f32 x;
+    for (int j = 0; j < 4; ++j, v += STEP)
+      x[j] = FPBits(v).get_val();
+    v4f32 result = VECTOR_EXPF(x);
+    for (int j = 0; j < 4; ++j)
+      EXPECT_FP_EQ(LIBC_NAMESPACE::expf(x[j]), result[j]);
+  }
+}
+
+// The exceptional value of expf, among ordinary ones.
+TEST_F(LlvmLibcExpfVectorTest, ExceptionalValues) {
+  v4f32 x = {FPBits(0x4283'070fU).get_val(), FPBits(0xc236'bd8cU).get_val(),
+             FPBits(0x3f80'0000U).get_val(), FPBits(0xbf81'eadfU).get_val()};
+  v4f32 result = VECTOR_EXPF(x);
+  for (int j = 0; j < 4; ++j)
+    EXPECT_FP_EQ(LIBC_NAMESPACE::expf(x[j]), result[j]);
+}
@@ -0,0 +1,73 @@
+//===-- Unittests for the vector variants of logf -------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/__support/FPUtil/FPBits.h"
+#include "src/__support/FPUtil/vector_types.h"
+#include "src/__support/macros/properties/architectures.h"
+#include "src/math/logf.h"
+#include "test/UnitTest/FPMatcher.h"
+#include "test/UnitTest/Test.h"
+
+#include <stdint.h>
+
+#if defined(LIBC_TARGET_ARCH_IS_X86)
+#include "src/math/_ZGVbN4v_logf.h"
+#define VECTOR_LOGF LIBC_NAMESPACE::_ZGVbN4v_logf
+#elif defined(LIBC_TARGET_ARCH_IS_AARCH64)
+#include "src/math/_ZGVnN4v_logf.h"
+#define VECTOR_LOGF LIBC_NAMESPACE::_ZGVnN4v_logf
+#endif
+
+using LlvmLibcLogfVectorTest = LIBC_NAMESPACE::testing::FPTest<float>;
+using LIBC_NAMESPACE::fputil::v4f32;
+
+TEST_F(LlvmLibcLogfVectorTest, SpecialNumbers) {
+  v4f32 result = VECTOR_LOGF(v4f32{aNaN, inf, neg_inf, 0.0f});
+  EXPECT_FP_EQ(aNaN, result[0]);
+  EXPECT_FP_EQ(inf, result[1]);
+  EXPECT_FP_EQ(aNaN, result[2]);
+  EXPECT_FP_EQ(neg_inf, result[3]);
+
+  // The special lanes don't affect the others.
+  result = VECTOR_LOGF(v4f32{2.0f, -1.0f, 1.0f, min_denormal});
+  EXPECT_FP_EQ(LIBC_NAMESPACE::logf(2.0f), result[0]);
+  EXPECT_FP_EQ(aNaN, result[1]);
+  EXPECT_FP_EQ(0.0f, result[2]);
+  EXPECT_FP_EQ(LIBC_NAMESPACE::logf(min_denormal), result[3]);
+}
+
+// The results are the same as the scalar function, which is correctly rounded.
+TEST_F(LlvmLibcLogfVectorTest, MatchesScalar) {
+  constexpr uint32_t COUNT = 100'000;
+  constexpr uint32_t STEP = UINT32_MAX / COUNT / 4;
+  for (uint32_t i = 0, v = 0; i <= COUNT; ++i) {
+    v4f32 x;
+    for (int j = 0; j < 4; ++j, v += STEP)
+      x[j] = FPBits(v).get_val();
+    v4f32 result = VECTOR_LOGF(x);
+    for (int j = 0; j < 4; ++j)
+      EXPECT_FP_EQ(LIBC_NAMESPACE::logf(x[j]), result[j]);
+  }
+}
+
+// The hard-to-round cases of logf, among ordinary values.
+TEST_F(LlvmLibcLogfVectorTest, ExceptionalValues) {
+  constexpr uint32_t INPUTS[] = {
+      0x3f7f'4d6fU, 0x4117'8febU, 0x1e88'452dU, 0x4c5d'65a5U,
+      0x65d8'90d3U, 0x6f31'a8ecU, 0x7a17'f30aU, 0x500f'fb03U,
+      0x5cd6'9e88U, 0x5ee8'984eU, 0x3f80'0000U, 0x4049'0fdbU,
+  };
+  for (size_t i = 0; i < sizeof(INPUTS) / sizeof(INPUTS[0]); i += 4) {
+    v4f32 x = {FPBits(INPUTS[i]).get_val(), FPBits(INPUTS[i + 1]).get_val(),
+               FPBits(INPUTS[i + 2]).get_val(),
+               FPBits(INPUTS[i + 3]).get_val()};
+    v4f32 result = VECTOR_LOGF(x);
+    for (int j = 0; j < 4; ++j)
+      EXPECT_FP_EQ(LIBC_NAMESPACE::logf(x[j]), result[j]);
+  }
+}
@@ -79,6 +79,31 @@ public:
       ASSERT_EQ(array[i], i + 1);
   }
 
+  void test_almost_sorted_array(SortingRoutine sort_func) {
+    // Only the last element is out of place.
+    int array[] = {2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14,
+                   15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 1};
+    constexpr size_t ARRAY_LEN = sizeof(array) / sizeof(int);
+
+    int_sort(sort_func, array, ARRAY_LEN);
+
+    for (int i = 0; i < int(ARRAY_LEN); ++i)
+      ASSERT_EQ(array[i], i + 1);
+  }
+
+  void test_reversed_array_with_duplicates(SortingRoutine sort_func) {
+    int array[] = {13, 12, 12, 11, 10, 9, 9, 8, 7, 6, 5, 4, 4,
+                   3,  3,  2,  2,  2,  1, 1, 1, 1, 0, 0, 0};
+    constexpr size_t ARRAY_LEN = sizeof(array) / sizeof(int);
+
+    int_sort(sort_func, array, ARRAY_LEN);
+
+    for (size_t i = 0; i < ARRAY_LEN - 1; ++i)
+      ASSERT_LE(array[i], array[i + 1]);
+    ASSERT_EQ(array[0], 0);
+    ASSERT_EQ(array[ARRAY_LEN - 1], 13);
+  }
+
   void test_all_equal_elements(SortingRoutine sort_func) {
     int array[] = {100, 100, 100, 100, 100, 100, 100, 100, 100,
                    100, 100, 100, 100, 100, 100, 100, 100, 100,
@@ -357,6 +382,12 @@ public:
   TEST_F(LlvmLibc##Name##Test, ReverseSortedArray) {                           \
     test_reversed_sorted_array(Func);                                          \
   }                                                                            \
+  TEST_F(LlvmLibc##Name##Test, AlmostSortedArray) {                            \
+    test_almost_sorted_array(Func);                                            \
+  }                                                                            \
+  TEST_F(LlvmLibc##Name##Test, ReverseArrayDuplicateElements) {                \
+    test_reversed_array_with_duplicates(Func);                                 \
+  }                                                                            \
   TEST_F(LlvmLibc##Name##Test, AllEqualElements) {                             \
     test_all_equal_elements(Func);                                             \
   }                                                                            \
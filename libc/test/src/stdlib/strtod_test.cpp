@@ -70,6 +70,20 @@ TEST_F(LlvmLibcStrToDTest, SimpleTest) {
   run_test("0x123", 5, uint64_t(0x4072300000000000));
 }
 
+// Long runs of digits, which may be read eight at a time, with the decimal
+// point and the end of the number at different offsets within a run.
+TEST_F(LlvmLibcStrToDTest, LongDigitSequences) {
+  run_test("12345678", 8, uint64_t(0x41678c29c0000000));
+  run_test("123456789", 9, uint64_t(0x419d6f3454000000));
+  run_test("1234567.890123456", 17, uint64_t(0x4132d687e3df217d));
+  run_test("3.14159265358979323846264338", 28, uint64_t(0x400921fb54442d18));
+  run_test("0.000000001234567890123", 23, uint64_t(0x3e1535afdf5adfcd));
+  run_test("987654321098765432109876e-10", 28, uint64_t(0x42d674e79fcecd23));
+  run_test("12345678.87654321x", 17, uint64_t(0x41678c29dc0ca459));
+  run_test("1234567812345678.", 17, uint64_t(0x43118b54df9fbd38));
+  run_test("99999999999999999999", 20, uint64_t(0x4415af1d78b58c40));
+}
+
 // These are tests that have caused problems in the past.
 TEST_F(LlvmLibcStrToDTest, SpecificFailures) {
   run_test("3E70000000000000", 16, uint64_t(0x7FF0000000000000), ERANGE);
@@ -6,8 +6,13 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "src/__support/macros/properties/os.h" // LIBC_TARGET_OS_IS_LINUX
 #include "src/string/memchr.h"
 #include "test/UnitTest/Test.h"
+
+#if !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
+#include "memory_utils/protected_pages.h"
+#endif // !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
 #include <stddef.h>
 
 // A helper function that calls memchr and abstracts away the explicit cast for
@@ -120,3 +125,26 @@ TEST(LlvmLibcMemChrTest, SignedCharacterFound) {
   // Should find the first character 'c'.
   ASSERT_EQ(actual[0], c);
 }
+
+#if !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
+
+static constexpr size_t MAX_LENGTH = 256;
+
+// The vector implementation reads whole blocks. Buffers that end right before
+// a page that traps check that no block reads into that page.
+TEST(LlvmLibcMemChrTest, EndsBeforeProtectedPage) {
+  ProtectedPages pages;
+  const Page page = pages.GetPageA().WithAccess(PROT_READ | PROT_WRITE);
+  for (size_t size = 0; size < MAX_LENGTH; ++size) {
+    char *src = reinterpret_cast<char *>(page.top(size));
+    for (size_t i = 0; i < size; ++i)
+      src[i] = 'a';
+    ASSERT_EQ(call_memchr(src, 'b', size), static_cast<const char *>(nullptr));
+    if (size != 0) {
+      src[size - 1] = 'b';
+      ASSERT_EQ(call_memchr(src, 'b', size), src + size - 1);
+    }
+  }
+}
+
+#endif // !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
@@ -127,4 +127,36 @@ TEST(LlvmLibcMemmemTest, ReturnNullIfInadequateHaystackLength) {
     ASSERT_EQ(result, static_cast<void *>(nullptr));
   }
 }
+
+TEST(LlvmLibcMemmemTest, PeriodicNeedle) {
+  char h[] = "abaabaabaababaabaabaabab";
+  char n[] = "abaabaabab";
+  void *result = LIBC_NAMESPACE::memmem(h, sizeof(h) - 1, n, sizeof(n) - 1);
+  ASSERT_EQ(static_cast<char *>(result), h + 3);
+}
+
+TEST(LlvmLibcMemmemTest, LongHaystackOfRepeatedBytes) {
+  // Every position matches the first and the last byte of the needle, but
+  // only the last one matches it entirely.
+  char h[300];
+  for (size_t i = 0; i < sizeof(h); ++i)
+    h[i] = 'a';
+  h[sizeof(h) - 10] = 'b';
+  char n[] = {'a', 'a', 'a', 'a', 'a', 'b', 'a', 'a', 'a', 'a'};
+  void *result = LIBC_NAMESPACE::memmem(h, sizeof(h), n, sizeof(n));
+  ASSERT_EQ(static_cast<char *>(result), h + sizeof(h) - 15);
+  result = LIBC_NAMESPACE::memmem(h, sizeof(h) - 6, n, sizeof(n));
+  ASSERT_EQ(result, static_cast<void *>(nullptr));
+}
+
+TEST(LlvmLibcMemmemTest, MatchAcrossBlocks) {
+  char h[200];
+  for (size_t i = 0; i < sizeof(h); ++i)
+    h[i] = static_cast<char>('a' + i % 7);
+  for (size_t start = 0; start + 40 <= sizeof(h); start += 13) {
+    void *result = LIBC_NAMESPACE::memmem(h, sizeof(h), h + start, 40);
+    ASSERT_EQ(static_cast<char *>(result), h + start % 7);
+  }
+}
+
 } // namespace LIBC_NAMESPACE_DECL
@@ -8,7 +8,37 @@
 
 #include "StrchrTest.h"
 
+#include "src/__support/macros/properties/os.h" // LIBC_TARGET_OS_IS_LINUX
 #include "src/string/strchr.h"
 #include "test/UnitTest/Test.h"
 
+#if !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
+#include "memory_utils/protected_pages.h"
+#endif // !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
+
 STRCHR_TEST(Strchr, LIBC_NAMESPACE::strchr)
+
+#if !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
+
+static constexpr size_t MAX_LENGTH = 256;
+
+// The vector implementation reads whole blocks. Strings that end right before
+// a page that traps check that no block reads into that page.
+TEST_F(LlvmLibcStrchrTest, EndsBeforeProtectedPage) {
+  ProtectedPages pages;
+  const Page page = pages.GetPageA().WithAccess(PROT_READ | PROT_WRITE);
+  for (size_t length = 0; length < MAX_LENGTH; ++length) {
+    char *str = reinterpret_cast<char *>(page.top(length + 1));
+    for (size_t i = 0; i < length; ++i)
+      str[i] = 'a';
+    str[length] = '\0';
+    ASSERT_EQ(LIBC_NAMESPACE::strchr(str, 'b'), static_cast<char *>(nullptr));
+    ASSERT_EQ(LIBC_NAMESPACE::strchr(str, '\0'), str + length);
+    if (length != 0) {
+      str[length - 1] = 'b';
+      ASSERT_EQ(LIBC_NAMESPACE::strchr(str, 'b'), str + length - 1);
+    }
+  }
+}
+
+#endif // !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
@@ -6,9 +6,14 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "src/__support/macros/properties/os.h" // LIBC_TARGET_OS_IS_LINUX
 #include "src/string/strchrnul.h"
 #include "test/UnitTest/Test.h"
 
+#if !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
+#include "memory_utils/protected_pages.h"
+#endif // !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
+
 TEST(LlvmLibcStrChrNulTest, FindsFirstCharacter) {
   const char *src = "abcde";
 
@@ -94,3 +99,23 @@ TEST(LlvmLibcStrChrNulTest, EmptyStringShouldOnlyMatchNullTerminator) {
   result = LIBC_NAMESPACE::strchrnul("", '*');
   ASSERT_EQ(*result, '\0');
 }
+
+#if !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
+
+static constexpr size_t MAX_LENGTH = 256;
+
+// The vector implementation reads whole blocks. Strings that end right before
+// a page that traps check that no block reads into that page.
+TEST(LlvmLibcStrChrNulTest, EndsBeforeProtectedPage) {
+  ProtectedPages pages;
+  const Page page = pages.GetPageA().WithAccess(PROT_READ | PROT_WRITE);
+  for (size_t length = 0; length < MAX_LENGTH; ++length) {
+    char *str = reinterpret_cast<char *>(page.top(length + 1));
+    for (size_t i = 0; i < length; ++i)
+      str[i] = 'a';
+    str[length] = '\0';
+    ASSERT_EQ(LIBC_NAMESPACE::strchrnul(str, 'b'), str + length);
+  }
+}
+
+#endif // !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
@@ -6,9 +6,14 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "src/__support/macros/properties/os.h" // LIBC_TARGET_OS_IS_LINUX
 #include "src/string/strcmp.h"
 #include "test/UnitTest/Test.h"
 
+#if !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
+#include "memory_utils/protected_pages.h"
+#endif // !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
+
 TEST(LlvmLibcStrCmpTest, EmptyStringsShouldReturnZero) {
   const char *s1 = "";
   const char *s2 = "";
@@ -106,3 +111,35 @@ TEST(LlvmLibcStrCmpTest, Case) {
   result = LIBC_NAMESPACE::strcmp(s2, s1);
   ASSERT_GT(result, 0);
 }
+
+#if !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
+
+static constexpr size_t MAX_LENGTH = 256;
+
+// The vector implementation reads unaligned blocks of both strings. Strings
+// that end right before a page that traps, next to strings that start at a
+// page, check that it falls back to bytes before either page end.
+TEST(LlvmLibcStrCmpTest, EndsBeforeProtectedPage) {
+  ProtectedPages pages;
+  const Page page_a = pages.GetPageA().WithAccess(PROT_READ | PROT_WRITE);
+  const Page page_b = pages.GetPageB().WithAccess(PROT_READ | PROT_WRITE);
+  for (size_t length = 0; length < MAX_LENGTH; ++length) {
+    char *s1 = reinterpret_cast<char *>(page_a.top(length + 1));
+    char *others[2] = {reinterpret_cast<char *>(page_b.top(length + 1)),
+                       reinterpret_cast<char *>(page_b.bottom(length + 1))};
+    for (char *s2 : others) {
+      for (size_t i = 0; i < length; ++i)
+        s1[i] = s2[i] = 'a';
+      s1[length] = s2[length] = '\0';
+      ASSERT_EQ(LIBC_NAMESPACE::strcmp(s1, s2), 0);
+      ASSERT_EQ(LIBC_NAMESPACE::strcmp(s2, s1), 0);
+      if (length != 0) {
+        s2[length - 1] = 'b';
+        ASSERT_LT(LIBC_NAMESPACE::strcmp(s1, s2), 0);
+        ASSERT_GT(LIBC_NAMESPACE::strcmp(s2, s1), 0);
+      }
+    }
+  }
+}
+
+#endif // !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
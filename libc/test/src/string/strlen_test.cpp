@@ -6,9 +6,14 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "src/__support/macros/properties/os.h" // LIBC_TARGET_OS_IS_LINUX
 #include "src/string/strlen.h"
 #include "test/UnitTest/Test.h"
 
+#if !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
+#include "memory_utils/protected_pages.h"
+#endif // !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
+
 TEST(LlvmLibcStrLenTest, EmptyString) {
   const char *empty = "";
 
@@ -22,3 +27,23 @@ TEST(LlvmLibcStrLenTest, AnyString) {
   size_t result = LIBC_NAMESPACE::strlen(any);
   ASSERT_EQ((size_t)12, result);
 }
+
+#if !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
+
+static constexpr size_t MAX_LENGTH = 256;
+
+// The vector implementation reads whole blocks. Strings that end right before
+// a page that traps check that no block reads into that page.
+TEST(LlvmLibcStrLenTest, EndsBeforeProtectedPage) {
+  ProtectedPages pages;
+  const Page page = pages.GetPageA().WithAccess(PROT_READ | PROT_WRITE);
+  for (size_t length = 0; length < MAX_LENGTH; ++length) {
+    char *str = reinterpret_cast<char *>(page.top(length + 1));
+    for (size_t i = 0; i < length; ++i)
+      str[i] = 'a';
+    str[length] = '\0';
+    ASSERT_EQ(LIBC_NAMESPACE::strlen(str), length);
+  }
+}
+
+#endif // !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
@@ -6,9 +6,14 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "src/__support/macros/properties/os.h" // LIBC_TARGET_OS_IS_LINUX
 #include "src/string/strncmp.h"
 #include "test/UnitTest/Test.h"
 
+#if !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
+#include "memory_utils/protected_pages.h"
+#endif // !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
+
 // This group is just copies of the strcmp tests, since all the same cases still
 // need to be tested.
 
@@ -167,3 +172,34 @@ TEST(LlvmLibcStrNCmpTest, Case) {
   result = LIBC_NAMESPACE::strncmp(s2, s1, 2);
   ASSERT_GT(result, 0);
 }
+
+#if !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
+
+static constexpr size_t MAX_LENGTH = 256;
+
+// The vector implementation reads unaligned blocks of both strings. Strings
+// without a terminator that end right before a page that traps, next to
+// strings that start at a page, check that it never reads past n bytes.
+TEST(LlvmLibcStrNCmpTest, EndsBeforeProtectedPage) {
+  ProtectedPages pages;
+  const Page page_a = pages.GetPageA().WithAccess(PROT_READ | PROT_WRITE);
+  const Page page_b = pages.GetPageB().WithAccess(PROT_READ | PROT_WRITE);
+  for (size_t length = 0; length < MAX_LENGTH; ++length) {
+    char *s1 = reinterpret_cast<char *>(page_a.top(length));
+    char *others[2] = {reinterpret_cast<char *>(page_b.top(length)),
+                       reinterpret_cast<char *>(page_b.bottom(length))};
+    for (char *s2 : others) {
+      for (size_t i = 0; i < length; ++i)
+        s1[i] = s2[i] = 'a';
+      ASSERT_EQ(LIBC_NAMESPACE::strncmp(s1, s2, length), 0);
+      ASSERT_EQ(LIBC_NAMESPACE::strncmp(s2, s1, length), 0);
+      if (length != 0) {
+        s2[length - 1] = 'b';
+        ASSERT_LT(LIBC_NAMESPACE::strncmp(s1, s2, length), 0);
+        ASSERT_GT(LIBC_NAMESPACE::strncmp(s2, s1, length), 0);
+      }
+    }
+  }
+}
+
+#endif // !defined(LIBC_FULL_BUILD) && defined(LIBC_TARGET_OS_IS_LINUX)
@@ -12,14 +12,22 @@
 
 #include <__algorithm/iterator_operations.h>
 #include <__algorithm/min.h>
+#include <__algorithm/simd_utils.h>
+#include <__algorithm/unwrap_iter.h>
+#include <__bit/bit_cast.h>
 #include <__bit/invert_if.h>
 #include <__bit/popcount.h>
 #include <__config>
+#include <__cstddef/ptrdiff_t.h>
+#include <__cstddef/size_t.h>
 #include <__functional/identity.h>
 #include <__fwd/bit_reference.h>
+#include <__iterator/aliasing_iterator.h>
 #include <__iterator/iterator_traits.h>
 #include <__type_traits/enable_if.h>
 #include <__type_traits/invoke.h>
+#include <__type_traits/is_constant_evaluated.h>
+#include <__type_traits/is_equality_comparable.h>
 
 #if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
 #  pragma GCC system_header
@@ -41,6 +49,64 @@ __count(_Iter __first, _Sent __last, const _Tp& __value, _Proj& __proj) {
   return __r;
 }
 
+#if _LIBCPP_VECTORIZE_ALGORITHMS
+template <class _Iter>
+[[__nodiscard__]] _LIBCPP_HIDE_FROM_ABI ptrdiff_t
+__count_vectorized(_Iter __first, _Iter __last, __iter_value_type<_Iter> __value) {
+  using __value_type              = __iter_value_type<_Iter>;
+  constexpr size_t __unroll_count = 4;
+  constexpr size_t __vec_size     = __native_vector_size<__value_type>;
+  using __vec                     = __simd_vector<__value_type, __vec_size>;
+
+  ptrdiff_t __r = 0;
+  while (static_cast<size_t>(__last - __first) >= __unroll_count * __vec_size) {
+    __vec __values[__unroll_count];
+
+    for (size_t __i = 0; __i != __unroll_count; ++__i)
+      __values[__i] = std::__load_vector<__vec>(__first + __i * __vec_size);
+
+    for (size_t __i = 0; __i != __unroll_count; ++__i)
+      __r += std::__count_set(__values[__i] == __value);
+
+    __first += __unroll_count * __vec_size;
+  }
+
+  // count the remaining 0-3 vectors
+  while (static_cast<size_t>(__last - __first) >= __vec_size) {
+    __r += std::__count_set(std::__load_vector<__vec>(__first) == __value);
+    __first += __vec_size;
+  }
+
+  // Unlike in find, an overlapping load at (last - vector_size) would count elements twice
+  for (; __first != __last; ++__first)
+    if (*__first == __value)
+      ++__r;
+  return __r;
+}
+
+// trivially equality comparable implementation
+template <class _AlgPolicy,
+          class _Tp,
+          class _Up,
+          class _Proj,
+          __enable_if_t<__is_identity<_Proj>::value && __libcpp_is_trivially_equality_comparable<_Tp, _Up>::value &&
+                            __can_map_to_integer_v<_Tp> && sizeof(_Tp) == sizeof(_Up),
+                        int> = 0>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX20 ptrdiff_t
+__count(_Tp* __first, _Tp* __last, const _Up& __value, _Proj&) {
+  if (__libcpp_is_constant_evaluated()) {
+    ptrdiff_t __r = 0;
+    for (; __first != __last; ++__first)
+      if (*__first == __value)
+        ++__r;
+    return __r;
+  }
+  using __integer_type = __get_as_integer_type_t<_Tp>;
+  using _Iter          = __aliasing_iterator<_Tp*, __integer_type>;
+  return std::__count_vectorized(_Iter(__first), _Iter(__last), std::__bit_cast<__integer_type>(__value));
+}
+#endif // _LIBCPP_VECTORIZE_ALGORITHMS
+
 // __bit_iterator implementation
 template <bool _ToCount, class _Cp, bool _IsConst>
 _LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX20 typename __bit_iterator<_Cp, _IsConst>::difference_type
@@ -85,7 +151,7 @@ template <class _InputIterator, class _Tp>
 [[__nodiscard__]] inline _LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX20 __iter_diff_t<_InputIterator>
 count(_InputIterator __first, _InputIterator __last, const _Tp& __value) {
   __identity __proj;
-  return std::__count<_ClassicAlgPolicy>(__first, __last, __value, __proj);
+  return std::__count<_ClassicAlgPolicy>(std::__unwrap_iter(__first), std::__unwrap_iter(__last), __value, __proj);
 }
 
 _LIBCPP_END_NAMESPACE_STD
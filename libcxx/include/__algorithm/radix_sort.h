@@ -27,8 +27,12 @@
 // - if all values of a radix are the same, we do not sort that radix, and just move items to the buffer;
 // - if two consecutive radices satisfies condition above, we do nothing for these two radices.
 
+// Floating-point numbers are sorted by an unsigned integer with the same order, see
+// `__floating_point_to_ordered_unsigned`.
+
 #include <__algorithm/for_each.h>
 #include <__algorithm/move.h>
+#include <__bit/bit_cast.h>
 #include <__bit/bit_log2.h>
 #include <__bit/countl.h>
 #include <__config>
@@ -40,10 +44,13 @@
 #include <__iterator/next.h>
 #include <__iterator/reverse_iterator.h>
 #include <__numeric/partial_sum.h>
+#include <__type_traits/conditional.h>
 #include <__type_traits/decay.h>
 #include <__type_traits/enable_if.h>
+#include <__type_traits/integral_constant.h>
 #include <__type_traits/invoke.h>
 #include <__type_traits/is_assignable.h>
+#include <__type_traits/is_floating_point.h>
 #include <__type_traits/is_integral.h>
 #include <__type_traits/is_unsigned.h>
 #include <__type_traits/make_unsigned.h>
@@ -307,6 +314,32 @@ struct __low_byte_fn {
   }
 };
 
+template <class _Tp>
+struct __is_radix_sortable_floating_point
+    : integral_constant<bool,
+                        is_floating_point<_Tp>::value && numeric_limits<_Tp>::is_iec559 &&
+                            (sizeof(_Tp) == sizeof(uint32_t) || sizeof(_Tp) == sizeof(uint64_t))> {};
+
+// Negative numbers have all bits flipped, so that larger magnitudes become smaller integers, and non-negative numbers
+// only the sign bit, so that they are larger than all negative numbers. Both zeros map to the same integer, since they
+// compare equal and must not be reordered by a stable sort.
+template <class _Fp>
+_LIBCPP_HIDE_FROM_ABI constexpr auto __floating_point_to_ordered_unsigned(_Fp __x) {
+  static_assert(__is_radix_sortable_floating_point<_Fp>::value);
+  using _Up                = __conditional_t<sizeof(_Fp) == sizeof(uint32_t), uint32_t, uint64_t>;
+  constexpr _Up __sign_bit = _Up(1) << (sizeof(_Up) * CHAR_BIT - 1);
+
+  const _Up __bits = std::__bit_cast<_Up>(__x == _Fp(0) ? _Fp(0) : __x);
+  return static_cast<_Up>((__bits & __sign_bit) ? ~__bits : __bits | __sign_bit);
+}
+
+struct __floating_point_to_ordered_unsigned_fn {
+  template <class _Fp>
+  _LIBCPP_HIDE_FROM_ABI constexpr auto operator()(_Fp __x) const {
+    return std::__floating_point_to_ordered_unsigned(__x);
+  }
+};
+
 template <class _RandomAccessIterator1, class _RandomAccessIterator2, class _Map, class _Radix>
 _LIBCPP_HIDE_FROM_ABI constexpr void
 __radix_sort(_RandomAccessIterator1 __first,
@@ -318,12 +351,22 @@ __radix_sort(_RandomAccessIterator1 __first,
   std::__radix_sort_impl(__first, __last, __buffer, __map_to_unsigned, __radix);
 }
 
-template <class _RandomAccessIterator1, class _RandomAccessIterator2>
+template <class _RandomAccessIterator1,
+          class _RandomAccessIterator2,
+          enable_if_t<!__is_radix_sortable_floating_point<__iter_value_type<_RandomAccessIterator1>>::value, int> = 0>
 _LIBCPP_HIDE_FROM_ABI constexpr void
 __radix_sort(_RandomAccessIterator1 __first, _RandomAccessIterator1 __last, _RandomAccessIterator2 __buffer) {
   std::__radix_sort(__first, __last, __buffer, __identity{}, __low_byte_fn{});
 }
 
+template <class _RandomAccessIterator1,
+          class _RandomAccessIterator2,
+          enable_if_t<__is_radix_sortable_floating_point<__iter_value_type<_RandomAccessIterator1>>::value, int> = 0>
+_LIBCPP_HIDE_FROM_ABI constexpr void
+__radix_sort(_RandomAccessIterator1 __first, _RandomAccessIterator1 __last, _RandomAccessIterator2 __buffer) {
+  std::__radix_sort(__first, __last, __buffer, __floating_point_to_ordered_unsigned_fn{}, __low_byte_fn{});
+}
+
 #endif // _LIBCPP_STD_VER >= 14
 
 _LIBCPP_END_NAMESPACE_STD
@@ -13,6 +13,7 @@
 #include <__bit/bit_cast.h>
 #include <__bit/countl.h>
 #include <__bit/countr.h>
+#include <__bit/popcount.h>
 #include <__config>
 #include <__cstddef/size_t.h>
 #include <__utility/integer_sequence.h>
@@ -148,6 +149,33 @@ template <class _Tp, size_t _Np>
   }
 }
 
+template <class _Tp, size_t _Np>
+[[__nodiscard__]] _LIBCPP_HIDE_FROM_ABI size_t __count_set(__simd_vector<_Tp, _Np> __vec) noexcept {
+  using __mask_vec = __simd_vector<bool, _Np>;
+
+  // This has MSan disabled du to https://github.com/llvm/llvm-project/issues/85876
+  auto __impl = [&]<class _MaskT>(_MaskT) _LIBCPP_NO_SANITIZE("memory") noexcept {
+    _MaskT __mask = __builtin_bit_cast(_MaskT, __builtin_convertvector(__vec, __mask_vec));
+    // The mask may be wider than the vector, in which case the upper bits are unspecified.
+    if constexpr (_Np < sizeof(_MaskT) * 8)
+      __mask &= static_cast<_MaskT>((_MaskT(1) << _Np) - 1);
+    return static_cast<size_t>(std::__popcount(__mask));
+  };
+
+  if constexpr (sizeof(__mask_vec) == sizeof(uint8_t)) {
+    return __impl(uint8_t{});
+  } else if constexpr (sizeof(__mask_vec) == sizeof(uint16_t)) {
+    return __impl(uint16_t{});
+  } else if constexpr (sizeof(__mask_vec) == sizeof(uint32_t)) {
+    return __impl(uint32_t{});
+  } else if constexpr (sizeof(__mask_vec) == sizeof(uint64_t)) {
+    return __impl(uint64_t{});
+  } else {
+    static_assert(sizeof(__mask_vec) == 0, "unexpected required size for mask integer type");
+    return 0;
+  }
+}
+
 template <class _Tp, size_t _Np>
 [[__nodiscard__]] _LIBCPP_HIDE_FROM_ABI size_t __find_first_not_set(__simd_vector<_Tp, _Np> __vec) noexcept {
   return std::__find_first_set(~__vec);
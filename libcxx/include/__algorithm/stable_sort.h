@@ -26,6 +26,7 @@
 #include <__type_traits/desugars_to.h>
 #include <__type_traits/enable_if.h>
 #include <__type_traits/is_constant_evaluated.h>
+#include <__type_traits/is_floating_point.h>
 #include <__type_traits/is_integral.h>
 #include <__type_traits/is_same.h>
 #include <__type_traits/is_trivially_assignable.h>
@@ -200,25 +201,17 @@ struct __stable_sort_switch {
 };
 
 #if _LIBCPP_STD_VER >= 17
+// The radix sort makes a fixed number of passes over the input, so it is faster than the merge sort for all sizes
+// above this bound.
 template <class _Tp>
 _LIBCPP_HIDE_FROM_ABI constexpr unsigned __radix_sort_min_bound() {
-  static_assert(is_integral<_Tp>::value);
+  static_assert(is_integral<_Tp>::value || is_floating_point<_Tp>::value);
   if constexpr (sizeof(_Tp) == 1) {
     return 1 << 8;
   }
 
   return 1 << 10;
 }
-
-template <class _Tp>
-_LIBCPP_HIDE_FROM_ABI constexpr unsigned __radix_sort_max_bound() {
-  static_assert(is_integral<_Tp>::value);
-  if constexpr (sizeof(_Tp) >= 8) {
-    return 1 << 15;
-  }
-
-  return 1 << 16;
-}
 #endif // _LIBCPP_STD_VER >= 17
 
 template <class _AlgPolicy, class _Compare, class _RandomAccessIterator>
@@ -250,10 +243,13 @@ _LIBCPP_CONSTEXPR_SINCE_CXX26 void __stable_sort(
       __desugars_to_v<__totally_ordered_less_tag, __remove_cvref_t<_Compare>, value_type, value_type >;
   constexpr auto __integral_value =
       is_integral_v<value_type > && is_same_v< value_type&, __iter_reference<_RandomAccessIterator>>;
-  constexpr auto __allowed_radix_sort = __default_comp && __integral_value;
+  constexpr auto __floating_point_value =
+      __desugars_to_v<__less_tag, __remove_cvref_t<_Compare>, value_type, value_type> &&
+      __is_radix_sortable_floating_point<value_type>::value &&
+      is_same_v< value_type&, __iter_reference<_RandomAccessIterator>>;
+  constexpr auto __allowed_radix_sort = (__default_comp && __integral_value) || __floating_point_value;
   if constexpr (__allowed_radix_sort) {
-    if (__len <= __buff_size && __len >= static_cast<difference_type>(std::__radix_sort_min_bound<value_type>()) &&
-        __len <= static_cast<difference_type>(std::__radix_sort_max_bound<value_type>())) {
+    if (__len <= __buff_size && __len >= static_cast<difference_type>(std::__radix_sort_min_bound<value_type>())) {
       if (__libcpp_is_constant_evaluated()) {
         for (auto* __p = __buff; __p < __buff + __buff_size; ++__p) {
           std::__construct_at(__p);
@@ -880,9 +880,13 @@ private:
             __is_sorted_and_unique(__containers_.keys | ranges::views::drop(__append_start_offset)),
             "Either the key container is not sorted or it contains duplicates");
       }
-      ranges::inplace_merge(__zv.begin(), __zv.begin() + __append_start_offset, __end, __compare_key);
+      // The existing elements that are less than the first appended one are already in place and can't be
+      // equivalent to any appended element, so only the rest of the elements is merged and deduplicated.
+      auto __append_start = __zv.begin() + __append_start_offset;
+      auto __merge_start  = ranges::lower_bound(__zv.begin(), __append_start, *__append_start, __compare_key);
+      ranges::inplace_merge(__merge_start, __append_start, __end, __compare_key);
 
-      auto __dup_start = ranges::unique(__zv, __key_equiv(__compare_)).begin();
+      auto __dup_start = ranges::unique(__merge_start, __end, __key_equiv(__compare_)).begin();
       auto __dist      = ranges::distance(__zv.begin(), __dup_start);
       __containers_.keys.erase(__containers_.keys.begin() + __dist, __containers_.keys.end());
       __containers_.values.erase(__containers_.values.begin() + __dist, __containers_.values.end());
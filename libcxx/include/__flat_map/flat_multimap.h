@@ -787,7 +787,10 @@ private:
             __is_sorted(__containers_.keys | ranges::views::drop(__append_start_offset)),
             "Key container is not sorted");
       }
-      ranges::inplace_merge(__zv.begin(), __zv.begin() + __append_start_offset, __end, __compare_key);
+      // The existing elements that are not greater than the first appended one are already in place.
+      auto __append_start = __zv.begin() + __append_start_offset;
+      auto __merge_start  = ranges::upper_bound(__zv.begin(), __append_start, *__append_start, __compare_key);
+      ranges::inplace_merge(__merge_start, __append_start, __end, __compare_key);
     }
     __on_failure.__complete();
   }
@@ -28,12 +28,14 @@
 #include <__format/formatter_char.h>
 #include <__format/formatter_floating_point.h>
 #include <__format/formatter_integer.h>
+#include <__format/formatter_output.h>
 #include <__format/formatter_pointer.h>
 #include <__format/formatter_string.h>
 #include <__format/parser_std_format_spec.h>
 #include <__iterator/concepts.h>
 #include <__iterator/incrementable_traits.h>
 #include <__iterator/iterator_traits.h> // iter_value_t
+#include <__type_traits/remove_cvref.h>
 #include <__variant/monostate.h>
 #include <array>
 #include <string>
@@ -303,6 +305,18 @@ _LIBCPP_HIDE_FROM_ABI constexpr typename _Ctx::iterator __vformat_to(_ParseCtx&&
   auto __end                       = __parse_ctx.end();
   typename _Ctx::iterator __out_it = __ctx.out();
   while (__begin != __end) {
+    // Copy the text up to the next replacement field or escape sequence with
+    // one bulk write, instead of writing it one code unit at a time.
+    auto __text_end = __begin;
+    while (__text_end != __end && *__text_end != _CharT('{') && *__text_end != _CharT('}'))
+      ++__text_end;
+    if (__text_end != __begin) {
+      if constexpr (!same_as<remove_cvref_t<_Ctx>, __compile_time_basic_format_context<_CharT>>)
+        __out_it = __formatter::__copy(__begin, __text_end, std::move(__out_it));
+      __begin = __text_end;
+      continue;
+    }
+
     switch (*__begin) {
     case _CharT('{'):
       ++__begin;
@@ -329,7 +343,7 @@ _LIBCPP_HIDE_FROM_ABI constexpr typename _Ctx::iterator __vformat_to(_ParseCtx&&
       break;
     }
 
-    // Copy the character to the output verbatim.
+    // Copy the escaped character to the output verbatim.
     *__out_it++ = *__begin++;
   }
   return __out_it;
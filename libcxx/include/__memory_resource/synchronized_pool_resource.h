@@ -61,6 +61,11 @@ public:
   _LIBCPP_HIDE_FROM_ABI pool_options options() const { return __unsync_.options(); }
 
 protected:
+#  if _LIBCPP_AVAILABILITY_HAS_PMR_THREAD_CACHES
+  void* do_allocate(size_t __bytes, size_t __align) override;
+
+  void do_deallocate(void* __p, size_t __bytes, size_t __align) override;
+#  else
   _LIBCPP_HIDE_FROM_ABI_VIRTUAL void* do_allocate(size_t __bytes, size_t __align) override {
 #  if _LIBCPP_HAS_THREADS
     unique_lock<mutex> __lk(__mut_);
@@ -74,6 +79,7 @@ protected:
 #  endif
     return __unsync_.deallocate(__p, __bytes, __align);
   }
+#  endif
 
   bool do_is_equal(const memory_resource& __other) const noexcept override; // key function
 
@@ -25,9 +25,13 @@ _LIBCPP_BEGIN_NAMESPACE_STD
 
 namespace pmr {
 
+class synchronized_pool_resource;
+
 // [mem.res.pool.overview]
 
 class _LIBCPP_AVAILABILITY_PMR _LIBCPP_EXPORTED_FROM_ABI unsynchronized_pool_resource : public memory_resource {
+  friend class synchronized_pool_resource;
+
   class __fixed_pool;
 
   class __adhoc_pool {
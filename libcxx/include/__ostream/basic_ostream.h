@@ -13,6 +13,7 @@
 
 #if _LIBCPP_HAS_LOCALIZATION
 
+#  include <__assert>
 #  include <__exception/operations.h>
 #  include <__fwd/memory.h>
 #  include <__memory/addressof.h>
@@ -22,7 +23,11 @@
 #  include <__system_error/error_code.h>
 #  include <__type_traits/conjunction.h>
 #  include <__type_traits/enable_if.h>
+#  include <__type_traits/integral_constant.h>
 #  include <__type_traits/is_base_of.h>
+#  include <__type_traits/is_integral.h>
+#  include <__type_traits/is_same.h>
+#  include <__type_traits/make_unsigned.h>
 #  include <__type_traits/void_t.h>
 #  include <__utility/declval.h>
 #  include <bitset>
@@ -89,6 +94,70 @@ public:
     return *this;
   }
 
+  // Formats __value into a local buffer when that gives the same result as num_put, which is the case in the classic
+  // locale when no flag that changes the formatting is set. This avoids the facet lookup and the virtual calls of
+  // num_put, and writes all characters into the stream buffer at once. Returns false if __value has to go through
+  // num_put. These members don't depend on the language mode, like the operators that use them, which are instantiated
+  // in user code for character types the dylib doesn't provide.
+  template <class _Tp>
+  using __has_classic_integer_format _LIBCPP_NODEBUG =
+      _BoolConstant<is_same<_CharT, char>::value && is_integral<_Tp>::value && !is_same<_Tp, bool>::value>;
+
+  template <class _Tp>
+  using __has_classic_float_format _LIBCPP_NODEBUG =
+      _BoolConstant<is_same<_CharT, char>::value && is_same<_Tp, double>::value>;
+
+  template <class _Tp, __enable_if_t<__has_classic_integer_format<_Tp>::value, int> = 0>
+  _LIBCPP_HIDE_FROM_ABI bool __put_num_classic(_Tp __value) {
+    if ((this->flags() & (ios_base::basefield | ios_base::showpos) & ~ios_base::dec) != 0 || !__is_classic_unpadded())
+      return false;
+    char __buffer[32];
+    char* __last  = __buffer + sizeof(__buffer);
+    char* __first = __last;
+    __make_unsigned_t<_Tp> __x = std::__to_unsigned_like(__value);
+    if (__value < 0)
+      __x = static_cast<__make_unsigned_t<_Tp> >(0 - __x);
+    do {
+      *--__first = static_cast<char>('0' + __x % 10);
+      __x /= 10;
+    } while (__x != 0);
+    if (__value < 0)
+      *--__first = '-';
+    __write_classic(__first, __last - __first);
+    return true;
+  }
+
+  template <class _Tp, __enable_if_t<__has_classic_float_format<_Tp>::value, int> = 0>
+  _LIBCPP_HIDE_FROM_ABI bool __put_num_classic(_Tp __value) {
+    // num_put formats with %.*g in the C locale. The output with more than 17 digits may not fit into the buffer.
+    const ios_base::fmtflags __format_flags =
+        ios_base::floatfield | ios_base::showpoint | ios_base::showpos | ios_base::uppercase;
+    if ((this->flags() & __format_flags) != 0 || this->precision() > 17 || !__is_classic_unpadded())
+      return false;
+    char __buffer[32];
+    int __size = __locale::__snprintf(
+        __buffer, sizeof(__buffer), _LIBCPP_GET_C_LOCALE, "%.*g", static_cast<int>(this->precision()), __value);
+    _LIBCPP_ASSERT_INTERNAL(__size >= 0 && __size < static_cast<int>(sizeof(__buffer)),
+                            "the buffer should be large enough");
+    __write_classic(__buffer, __size);
+    return true;
+  }
+
+  template <class _Tp,
+            __enable_if_t<!__has_classic_integer_format<_Tp>::value && !__has_classic_float_format<_Tp>::value, int> = 0>
+  _LIBCPP_HIDE_FROM_ABI bool __put_num_classic(_Tp) {
+    return false;
+  }
+
+  _LIBCPP_HIDE_FROM_ABI bool __is_classic_unpadded() const {
+    return this->width() == 0 && this->getloc() == locale::classic();
+  }
+
+  _LIBCPP_HIDE_FROM_ABI void __write_classic(const char_type* __s, streamsize __size) {
+    if (this->rdbuf()->sputn(__s, __size) != __size)
+      this->setstate(ios_base::badbit | ios_base::failbit);
+  }
+
   template <class _Tp>
   _LIBCPP_HIDE_FROM_ABI basic_ostream& __put_num(_Tp __value) {
 #  if _LIBCPP_HAS_EXCEPTIONS
@@ -96,6 +165,8 @@ public:
 #  endif // _LIBCPP_HAS_EXCEPTIONS
       sentry __s(*this);
       if (__s) {
+        if (__put_num_classic(__value))
+          return *this;
         using _Fp          = num_put<char_type, ostreambuf_iterator<char_type, traits_type> >;
         const _Fp& __facet = std::use_facet<_Fp>(this->getloc());
         if (__facet.put(*this, *this, this->fill(), __value).failed())
@@ -116,6 +187,8 @@ public:
 #  endif // _LIBCPP_HAS_EXCEPTIONS
       sentry __s(*this);
       if (__s) {
+        if (__put_num_classic(__value))
+          return *this;
         ios_base::fmtflags __flags = ios_base::flags() & ios_base::basefield;
 
         using _Fp          = num_put<char_type, ostreambuf_iterator<char_type, traits_type> >;
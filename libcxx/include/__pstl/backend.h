@@ -30,6 +30,9 @@ _LIBCPP_PUSH_MACROS
 #  elif defined(_LIBCPP_PSTL_BACKEND_LIBDISPATCH)
 #    include <__pstl/backends/default.h>
 #    include <__pstl/backends/libdispatch.h>
+#  elif defined(_LIBCPP_PSTL_BACKEND_THREAD_POOL)
+#    include <__pstl/backends/default.h>
+#    include <__pstl/backends/thread_pool.h>
 #  endif
 
 #endif // _LIBCPP_STD_VER >= 17
@@ -0,0 +1,130 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___PSTL_BACKENDS_THREAD_POOL_H
+#define _LIBCPP___PSTL_BACKENDS_THREAD_POOL_H
+
+#include <__config>
+#include <__cstddef/ptrdiff_t.h>
+#include <__cstddef/size_t.h>
+#include <__pstl/backend_fwd.h>
+#include <__pstl/cpu_algos/any_of.h>
+#include <__pstl/cpu_algos/chunked_cpu_traits.h>
+#include <__pstl/cpu_algos/cpu_traits.h>
+#include <__pstl/cpu_algos/fill.h>
+#include <__pstl/cpu_algos/find_if.h>
+#include <__pstl/cpu_algos/for_each.h>
+#include <__pstl/cpu_algos/merge.h>
+#include <__pstl/cpu_algos/stable_sort.h>
+#include <__pstl/cpu_algos/transform.h>
+#include <__pstl/cpu_algos/transform_reduce.h>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#  pragma GCC system_header
+#endif
+
+_LIBCPP_PUSH_MACROS
+#include <__undef_macros>
+
+#if _LIBCPP_STD_VER >= 17
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+namespace __pstl {
+
+//
+// This backend runs the chunks of an algorithm on a pool of threads that is created on first use and lives for the
+// rest of the program. Each worker keeps a deque of pending ranges of chunks: it splits the range it works on and
+// pushes the halves onto its own deque, and idle threads steal the oldest (largest) range from another deque. The
+// thread that invokes an algorithm takes part in the work and, while waiting for the remaining chunks, runs other
+// pending tasks. Algorithms can therefore be nested, e.g. a parallel algorithm can be called from the function
+// object passed to std::for_each(std::execution::par, ...), without exhausting the pool.
+//
+// The pool size and the grain size are read from the environment on first use:
+//  - LIBCPP_PSTL_NUM_THREADS: the number of threads used, including the calling thread. Defaults to
+//    std::thread::hardware_concurrency().
+//  - LIBCPP_PSTL_GRAIN_SIZE: the minimum number of elements processed by a single chunk. Defaults to 256.
+//
+namespace __thread_pool {
+// Runs __func(__context, __chunk) for each __chunk in [0, __chunk_count) and returns once all of them completed.
+// __func must not throw.
+_LIBCPP_EXPORTED_FROM_ABI void
+__parallel_apply(size_t __chunk_count, void* __context, void (*__func)(void* __context, size_t __chunk)) noexcept;
+
+struct __chunk_partitions {
+  ptrdiff_t __chunk_count_; // includes the first chunk
+  ptrdiff_t __chunk_size_;
+  ptrdiff_t __first_chunk_size_;
+};
+
+[[__gnu__::__pure__]] _LIBCPP_EXPORTED_FROM_ABI __chunk_partitions __partition_chunks(ptrdiff_t __size) noexcept;
+
+struct __executor {
+  _LIBCPP_HIDE_FROM_ABI static void
+  __apply(size_t __chunk_count, void* __context, void (*__func)(void* __context, size_t __chunk)) noexcept {
+    __thread_pool::__parallel_apply(__chunk_count, __context, __func);
+  }
+
+  _LIBCPP_HIDE_FROM_ABI static __chunk_partitions __partition_chunks(ptrdiff_t __size) noexcept {
+    return __thread_pool::__partition_chunks(__size);
+  }
+};
+} // namespace __thread_pool
+
+template <>
+struct __cpu_traits<__thread_pool_backend_tag> : __chunked_cpu_traits<__thread_pool::__executor> {};
+
+// Mandatory implementations of the computational basis
+template <class _ExecutionPolicy>
+struct __find_if<__thread_pool_backend_tag, _ExecutionPolicy>
+    : __cpu_parallel_find_if<__thread_pool_backend_tag, _ExecutionPolicy> {};
+
+template <class _ExecutionPolicy>
+struct __for_each<__thread_pool_backend_tag, _ExecutionPolicy>
+    : __cpu_parallel_for_each<__thread_pool_backend_tag, _ExecutionPolicy> {};
+
+template <class _ExecutionPolicy>
+struct __merge<__thread_pool_backend_tag, _ExecutionPolicy>
+    : __cpu_parallel_merge<__thread_pool_backend_tag, _ExecutionPolicy> {};
+
+template <class _ExecutionPolicy>
+struct __stable_sort<__thread_pool_backend_tag, _ExecutionPolicy>
+    : __cpu_parallel_stable_sort<__thread_pool_backend_tag, _ExecutionPolicy> {};
+
+template <class _ExecutionPolicy>
+struct __transform<__thread_pool_backend_tag, _ExecutionPolicy>
+    : __cpu_parallel_transform<__thread_pool_backend_tag, _ExecutionPolicy> {};
+
+template <class _ExecutionPolicy>
+struct __transform_binary<__thread_pool_backend_tag, _ExecutionPolicy>
+    : __cpu_parallel_transform_binary<__thread_pool_backend_tag, _ExecutionPolicy> {};
+
+template <class _ExecutionPolicy>
+struct __transform_reduce<__thread_pool_backend_tag, _ExecutionPolicy>
+    : __cpu_parallel_transform_reduce<__thread_pool_backend_tag, _ExecutionPolicy> {};
+
+template <class _ExecutionPolicy>
+struct __transform_reduce_binary<__thread_pool_backend_tag, _ExecutionPolicy>
+    : __cpu_parallel_transform_reduce_binary<__thread_pool_backend_tag, _ExecutionPolicy> {};
+
+// Not mandatory, but better optimized
+template <class _ExecutionPolicy>
+struct __any_of<__thread_pool_backend_tag, _ExecutionPolicy>
+    : __cpu_parallel_any_of<__thread_pool_backend_tag, _ExecutionPolicy> {};
+
+template <class _ExecutionPolicy>
+struct __fill<__thread_pool_backend_tag, _ExecutionPolicy>
+    : __cpu_parallel_fill<__thread_pool_backend_tag, _ExecutionPolicy> {};
+
+} // namespace __pstl
+_LIBCPP_END_NAMESPACE_STD
+
+#endif // _LIBCPP_STD_VER >= 17
+
+_LIBCPP_POP_MACROS
+
+#endif // _LIBCPP___PSTL_BACKENDS_THREAD_POOL_H
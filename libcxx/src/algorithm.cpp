@@ -6,13 +6,51 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <__algorithm/radix_sort.h>
 #include <algorithm>
 #include <bit>
+#include <cstddef>
+#include <type_traits>
 
 _LIBCPP_BEGIN_NAMESPACE_STD
 
+namespace {
+
+// Above this size, a radix sort of elements of up to four bytes is faster than introsort. Larger elements need twice
+// as many passes over the input, which makes the radix sort lose against the branchless partitioning.
+constexpr ptrdiff_t radix_sort_min_size = 1 << 10;
+
+// The radix sort needs a buffer as large as the input. std::sort is not allowed to fail and callers don't expect it to
+// allocate, so the buffer lives on the stack, and its size bounds the ranges that are radix sorted.
+constexpr size_t radix_sort_buffer_bytes = 1 << 14;
+
+// Kept out of line so that callers that don't radix sort don't pay for the buffer in their stack frame.
+template <class Tp>
+_LIBCPP_NOINLINE void radix_sort_with_stack_buffer(Tp* first, Tp* last) {
+  alignas(Tp) unsigned char buffer[radix_sort_buffer_bytes];
+  std::__radix_sort(first, last, reinterpret_cast<Tp*>(buffer));
+}
+
+// Returns false if the range should be sorted with introsort instead.
+template <class Tp>
+bool radix_sort(Tp* first, Tp* last) {
+  if constexpr (sizeof(Tp) > 4 || !(is_integral_v<Tp> || __is_radix_sortable_floating_point<Tp>::value)) {
+    return false;
+  } else {
+    if (last - first < radix_sort_min_size || static_cast<size_t>(last - first) > radix_sort_buffer_bytes / sizeof(Tp))
+      return false;
+    radix_sort_with_stack_buffer(first, last);
+    return true;
+  }
+}
+
+} // namespace
+
 template <class Comp, class RandomAccessIterator>
 void __sort(RandomAccessIterator first, RandomAccessIterator last, Comp comp) {
+  if (radix_sort(first, last))
+    return;
+
   auto depth_limit = 2 * std::__bit_log2(static_cast<size_t>(last - first));
 
   // Only use bitset partitioning for arithmetic types.  We should also check
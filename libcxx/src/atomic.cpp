@@ -116,7 +116,10 @@ static void __libcpp_platform_wake_by_address(__cxx_atomic_contention_t const vo
 
 #endif // __linux__
 
-static constexpr size_t __libcpp_contention_table_size = (1 << 8); /* < there's no magic in this number */
+// Unrelated atomics that share an entry wake each other up. std::hash spreads addresses evenly whatever their
+// alignment, so sharing only depends on the number of atomics being waited on: with 300 of them, about 70% share
+// their entry with another one in a table of 256 entries, and about 25% in a table of 1024 entries (64 KiB).
+static constexpr size_t __libcpp_contention_table_size = (1 << 10);
 
 struct alignas(64) /*  aim to avoid false sharing */ __libcpp_contention_table_entry {
   __cxx_atomic_contention_t __contention_state;
@@ -8,8 +8,10 @@
 
 #include <__assert>
 #include <__config>
+#include <cstdint>
 #include <errno.h>
 #include <filesystem>
+#include <memory>
 #include <stack>
 #include <utility>
 
@@ -24,6 +26,19 @@
 #  include <dirent.h> // for DIR & friends
 #endif
 
+// On Linux, read directories with getdents64 into a large buffer and open subdirectories relative to their parent,
+// instead of going through the DIR streams of the C library.
+#if defined(__linux__)
+#  include <fcntl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+// The offsets of the entries, which are needed to resume reading a directory, may not fit into a 32-bit off_t.
+#  if defined(SYS_getdents64) && defined(O_DIRECTORY) && defined(O_CLOEXEC) &&                                          \
+      (defined(__LP64__) || (defined(_FILE_OFFSET_BITS) && _FILE_OFFSET_BITS == 64))
+#    define _LIBCPP_FILESYSTEM_USE_GETDENTS
+#  endif
+#endif
+
 _LIBCPP_BEGIN_NAMESPACE_FILESYSTEM
 
 using detail::ErrorHandler;
@@ -99,6 +114,131 @@ private:
   HANDLE __stream_{INVALID_HANDLE_VALUE};
   WIN32_FIND_DATAW __data_;
 
+public:
+  path __root_;
+  directory_entry __entry_;
+};
+#elif defined(_LIBCPP_FILESYSTEM_USE_GETDENTS)
+class __dir_stream {
+public:
+  __dir_stream()                               = delete;
+  __dir_stream& operator=(const __dir_stream&) = delete;
+
+  __dir_stream(__dir_stream&& other) noexcept
+      : __fd_(other.__fd_),
+        __buffer_(std::move(other.__buffer_)),
+        __offset_(other.__offset_),
+        __name_(other.__name_),
+        __root_(std::move(other.__root_)),
+        __entry_(std::move(other.__entry_)) {
+    other.__fd_ = -1;
+  }
+
+  __dir_stream(const path& root, directory_options opts, error_code& ec) : __root_(root) {
+    __buffer_ = std::make_shared<__dirent_buffer>();
+    open(AT_FDCWD, root.c_str(), opts, ec);
+  }
+
+  // Opens the current entry of `parent`, which must be a directory. The two streams share the buffer of `parent`.
+  __dir_stream(const __dir_stream& parent, directory_options opts, error_code& ec)
+      : __buffer_(parent.__buffer_), __root_(parent.__entry_.path()) {
+    open(parent.__fd_, parent.__name_, opts, ec);
+  }
+
+  ~__dir_stream() noexcept {
+    if (__fd_ != -1)
+      close();
+  }
+
+  bool good() const noexcept { return __fd_ != -1; }
+
+  bool advance(error_code& ec) {
+    __dirent_buffer& buf = *__buffer_;
+    if (buf.__fd_ != __fd_) {
+      // A subdirectory was read into the buffer since the last entry of this stream, so read the rest again.
+      if (::lseek(__fd_, __offset_, SEEK_SET) == -1) {
+        ec = detail::capture_errno();
+        close();
+        return false;
+      }
+      buf.__fd_  = __fd_;
+      buf.__pos_ = buf.__end_ = 0;
+    }
+    while (true) {
+      if (buf.__pos_ == buf.__end_) {
+        long n = ::syscall(SYS_getdents64, __fd_, buf.__data_, sizeof(buf.__data_));
+        if (n <= 0) {
+          if (n == -1)
+            ec = detail::capture_errno();
+          close();
+          return false;
+        }
+        buf.__pos_ = 0;
+        buf.__end_ = static_cast<size_t>(n);
+      }
+      const auto* ent = reinterpret_cast<const __linux_dirent64*>(buf.__data_ + buf.__pos_);
+      buf.__pos_ += ent->d_reclen;
+      __offset_ = ent->d_off;
+      string_view str = ent->d_name;
+      if (str == "." || str == "..")
+        continue;
+      __name_ = ent->d_name;
+      __entry_.__assign_iter_entry(__root_ / str, directory_entry::__create_iter_result(detail::get_file_type(ent, 0)));
+      return true;
+    }
+  }
+
+private:
+  // The layout of the records returned by getdents64, which no C library header declares portably.
+  struct __linux_dirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[1];
+  };
+
+  // The records read from the directory with the file descriptor `__fd_`. A recursive_directory_iterator has a single
+  // buffer for all its levels, instead of one for each open directory.
+  struct __dirent_buffer {
+    // Large enough for a few hundred entries per system call.
+    alignas(__linux_dirent64) char __data_[32 * 1024];
+    int __fd_     = -1;
+    size_t __pos_ = 0;
+    size_t __end_ = 0;
+  };
+
+  void open(int at, const char* name, directory_options opts, error_code& ec) {
+    if ((__fd_ = ::openat(at, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC)) == -1) {
+      ec                      = detail::capture_errno();
+      const bool allow_eacces = bool(opts & directory_options::skip_permission_denied);
+      if (allow_eacces && ec == errc::permission_denied)
+        ec.clear();
+      return;
+    }
+    __buffer_->__fd_  = __fd_;
+    __buffer_->__pos_ = __buffer_->__end_ = 0;
+    advance(ec);
+  }
+
+  error_code close() noexcept {
+    error_code m_ec;
+    if (::close(__fd_) == -1)
+      m_ec = detail::capture_errno();
+    // The descriptor may be reused by the next directory that is opened.
+    if (__buffer_->__fd_ == __fd_)
+      __buffer_->__fd_ = -1;
+    __fd_ = -1;
+    return m_ec;
+  }
+
+  int __fd_ = -1;
+  shared_ptr<__dirent_buffer> __buffer_;
+  // The position in the directory after the current entry.
+  off_t __offset_ = 0;
+  // The name of the current entry, which points into the buffer until another directory is read into it.
+  const char* __name_ = nullptr;
+
 public:
   path __root_;
   directory_entry __entry_;
@@ -299,7 +439,11 @@ bool recursive_directory_iterator::__try_recursion(error_code* ec) {
   }
 
   if (!skip_rec) {
+#if defined(_LIBCPP_FILESYSTEM_USE_GETDENTS)
+    __dir_stream new_it(curr_it, __imp_->__options_, m_ec);
+#else
     __dir_stream new_it(curr_it.__entry_.path(), __imp_->__options_, m_ec);
+#endif
     if (new_it.good()) {
       __imp_->__stack_.push(std::move(new_it));
       return true;
@@ -19,6 +19,14 @@
 #  endif
 #endif
 
+#if _LIBCPP_HAS_THREADS
+#  include <__utility/no_destroy.h>
+#  include <cstdint>
+#  include <mutex>
+#  include <thread>
+#  include "include/atomic_support.h"
+#endif
+
 _LIBCPP_BEGIN_NAMESPACE_STD
 
 namespace pmr {
@@ -275,6 +283,291 @@ public:
   static const size_t __default_alignment = alignof(max_align_t);
 };
 
+#if _LIBCPP_HAS_THREADS
+namespace {
+
+// A per-thread cache of free blocks in front of the pools of synchronized_pool_resources.
+//
+// A thread caches blocks of the small pools of the last few resources it used,
+// in one slot per resource, so that most allocations and deallocations neither
+// take the mutex of the resource nor touch its free lists. A slot exchanges
+// blocks with its resource in batches. When a thread uses more resources than
+// it has slots, the least recently used slot gives its blocks back, and so do
+// all slots when the thread exits.
+//
+// release() drops the cached blocks of the released resource from all caches
+// before the memory goes back upstream. To find them, the slots caching blocks
+// of a resource are linked into one of several registries, picked by the
+// address of the resource. The mutex of a registry is taken when a slot starts
+// or stops caching blocks of a resource, and by release() only if the registry
+// is not empty.
+//
+// The mutexes are locked in this order: the mutex of a resource, the mutex of a
+// registry, the mutex of a cache. A thread holding the mutex of its cache only
+// tries to lock the mutex of a resource.
+class pool_thread_cache {
+public:
+  // Blocks of the smallest pools, up to 512 bytes, are cached, at most
+  // `capacity` of each size.
+  static constexpr int cached_pools  = 7;
+  static constexpr size_t capacity   = 64;
+  static constexpr size_t batch_size = capacity / 2;
+  static constexpr int slot_count    = 4;
+
+  pool_thread_cache() {
+    for (slot& s : slots_)
+      s.cache = this;
+  }
+
+  pool_thread_cache(const pool_thread_cache&)            = delete;
+  pool_thread_cache& operator=(const pool_thread_cache&) = delete;
+
+  ~pool_thread_cache() {
+    destroyed = true;
+    for (slot& s : slots_) {
+      {
+        unique_lock<mutex> lock(mutex_);
+        flush(lock, s);
+      }
+      detach(s);
+    }
+  }
+
+  // Returns the cache of the calling thread, or nullptr if it was already
+  // destroyed because the thread is exiting.
+  static pool_thread_cache* get() {
+    static thread_local pool_thread_cache cache;
+    return destroyed ? nullptr : &cache;
+  }
+
+  void* allocate(unsynchronized_pool_resource& pool, mutex& pool_mutex, int index, size_t block_size) {
+    unique_lock<mutex> lock(mutex_);
+    slot& s = find(lock, pool, pool_mutex);
+    s.lists[index].block_size = block_size;
+    if (void* result = pop(s, index))
+      return result;
+
+    // Refill the slot without holding the mutex of the cache, which must not be
+    // held while waiting for the mutex of the resource.
+    lock.unlock();
+    void* blocks[batch_size];
+    size_t count = 0;
+    {
+      lock_guard<mutex> pool_lock(pool_mutex);
+      blocks[count++] = pool.allocate(block_size, 1);
+#  if _LIBCPP_HAS_EXCEPTIONS
+      try {
+#  endif
+        for (; count != batch_size; ++count)
+          blocks[count] = pool.allocate(block_size, 1);
+#  if _LIBCPP_HAS_EXCEPTIONS
+      } catch (...) {
+        // Keep the blocks allocated so far; the caller only needs the first one.
+      }
+#  endif
+    }
+    lock.lock();
+    // If the resource was released in the meantime, which dropped the slot, the
+    // other blocks may already be back upstream and must not be cached.
+    if (s.owner == &pool) {
+      for (size_t i = 1; i != count; ++i)
+        push(s, index, blocks[i]);
+    }
+    return blocks[0];
+  }
+
+  void deallocate(unsynchronized_pool_resource& pool, mutex& pool_mutex, int index, size_t block_size, void* p) {
+    unique_lock<mutex> lock(mutex_);
+    slot& s = find(lock, pool, pool_mutex);
+    s.lists[index].block_size = block_size;
+    if (s.lists[index].count != capacity) {
+      push(s, index, p);
+      return;
+    }
+
+    void* blocks[batch_size];
+    for (void*& block : blocks)
+      block = pop(s, index);
+    push(s, index, p);
+    lock.unlock();
+    lock_guard<mutex> pool_lock(pool_mutex);
+    for (void* block : blocks)
+      pool.deallocate(block, block_size, 1);
+  }
+
+  // Forgets the blocks of `pool` in all caches. Called with the mutex of `pool`
+  // held when `pool` returns its memory upstream.
+  static void drop(const unsynchronized_pool_resource* pool) {
+    registry& reg = registry_for(pool);
+    // A slot joins the registry before it caches any block of `pool`, which
+    // happens before the release, so an empty registry has no slot of `pool`.
+    if (__libcpp_atomic_load(&reg.size, _AO_Acquire) == 0)
+      return;
+    lock_guard<mutex> registry_lock(reg.mutex_);
+    for (slot* s = reg.head; s != nullptr; s = s->next) {
+      lock_guard<mutex> lock(s->cache->mutex_);
+      if (s->owner == pool)
+        clear(*s);
+    }
+  }
+
+private:
+  struct free_block {
+    free_block* next;
+  };
+
+  struct free_list {
+    free_block* head  = nullptr;
+    size_t count      = 0;
+    size_t block_size = 0;
+  };
+
+  struct registry;
+
+  struct slot {
+    // The resource the blocks belong to, changed under the mutex of the cache.
+    unsynchronized_pool_resource* owner = nullptr;
+    mutex* owner_mutex                  = nullptr;
+    free_list lists[cached_pools];
+    unsigned long long last_use = 0;
+    pool_thread_cache* cache    = nullptr;
+    // The registry the slot is linked into, if any. Only the thread of the
+    // cache changes it, under the mutex of the registry.
+    registry* reg = nullptr;
+    slot* prev    = nullptr;
+    slot* next    = nullptr;
+  };
+
+  struct registry {
+    mutex mutex_;
+    slot* head  = nullptr;
+    size_t size = 0;
+  };
+
+  static constexpr size_t registry_count = 31;
+
+  struct registry_table {
+    registry registries[registry_count];
+  };
+
+  static constinit inline thread_local bool destroyed = false;
+
+  static registry& registry_for(const unsynchronized_pool_resource* pool) {
+    static __no_destroy<registry_table> table;
+    return table.__get().registries[(reinterpret_cast<uintptr_t>(pool) >> 4) % registry_count];
+  }
+
+  static void* pop(slot& s, int index) {
+    free_list& list = s.lists[index];
+    free_block* block = list.head;
+    if (block != nullptr) {
+      list.head = block->next;
+      --list.count;
+    }
+    return block;
+  }
+
+  static void push(slot& s, int index, void* p) {
+    free_list& list = s.lists[index];
+    free_block* block = ::new (p) free_block{list.head};
+    list.head         = block;
+    ++list.count;
+  }
+
+  static void clear(slot& s) {
+    for (free_list& list : s.lists)
+      list = free_list();
+    s.owner       = nullptr;
+    s.owner_mutex = nullptr;
+  }
+
+  // Returns the slot caching blocks of `pool`, after taking over the least
+  // recently used one if there is none. `lock` holds mutex_.
+  slot& find(unique_lock<mutex>& lock, unsynchronized_pool_resource& pool, mutex& pool_mutex) {
+    while (true) {
+      slot* victim = nullptr;
+      for (slot& s : slots_) {
+        if (s.owner == &pool) {
+          s.last_use = ++clock_;
+          return s;
+        }
+        if (victim == nullptr || (victim->owner != nullptr && (s.owner == nullptr || s.last_use < victim->last_use)))
+          victim = &s;
+      }
+      flush(lock, *victim);
+      // Moving the slot to the registry of `pool` locks registries, which must
+      // not be done while holding mutex_. The slot may be dropped again before
+      // mutex_ is back, in which case it is looked for again.
+      lock.unlock();
+      detach(*victim);
+      attach(*victim, pool, pool_mutex);
+      lock.lock();
+    }
+  }
+
+  // Links the empty slot `s` into the registry of `pool`, then makes it cache
+  // blocks of `pool`.
+  void attach(slot& s, unsynchronized_pool_resource& pool, mutex& pool_mutex) {
+    registry& reg = registry_for(&pool);
+    lock_guard<mutex> registry_lock(reg.mutex_);
+    s.reg  = &reg;
+    s.prev = nullptr;
+    s.next = reg.head;
+    if (s.next != nullptr)
+      s.next->prev = &s;
+    reg.head = &s;
+    __libcpp_atomic_store(&reg.size, reg.size + 1, _AO_Release);
+    lock_guard<mutex> lock(mutex_);
+    s.owner       = &pool;
+    s.owner_mutex = &pool_mutex;
+  }
+
+  // Unlinks the slot `s`, which holds no blocks, from its registry.
+  static void detach(slot& s) {
+    registry* reg = s.reg;
+    if (reg == nullptr)
+      return;
+    lock_guard<mutex> registry_lock(reg->mutex_);
+    if (s.prev != nullptr)
+      s.prev->next = s.next;
+    else
+      reg->head = s.next;
+    if (s.next != nullptr)
+      s.next->prev = s.prev;
+    __libcpp_atomic_store(&reg->size, reg->size - 1, _AO_Release);
+    s.reg = nullptr;
+  }
+
+  // Gives all blocks cached in `s` back to their resource. `lock` holds mutex_.
+  static void flush(unique_lock<mutex>& lock, slot& s) {
+    while (s.owner != nullptr) {
+      // The owner is alive as long as it is set: release() clears it under
+      // mutex_ before any memory is freed.
+      unique_lock<mutex> pool_lock(*s.owner_mutex, try_to_lock);
+      if (pool_lock.owns_lock()) {
+        for (int index = 0; index != cached_pools; ++index) {
+          while (void* block = pop(s, index))
+            s.owner->deallocate(block, s.lists[index].block_size, 1);
+        }
+        clear(s);
+        return;
+      }
+      // Another thread holds the mutex of the resource, possibly while
+      // waiting for mutex_ to drop this slot.
+      lock.unlock();
+      this_thread::yield();
+      lock.lock();
+    }
+  }
+
+  mutex mutex_;
+  slot slots_[slot_count];
+  unsigned long long clock_ = 0;
+};
+
+} // namespace
+#endif // _LIBCPP_HAS_THREADS
+
 size_t unsynchronized_pool_resource::__pool_block_size(int i) const { return size_t(1) << __log2_pool_block_size(i); }
 
 int unsynchronized_pool_resource::__log2_pool_block_size(int i) const { return (i + __log2_smallest_block_size); }
@@ -332,6 +625,9 @@ pool_options unsynchronized_pool_resource::options() const {
 }
 
 void unsynchronized_pool_resource::release() {
+#if _LIBCPP_HAS_THREADS
+  pool_thread_cache::drop(this);
+#endif
   __adhoc_pool_.__release_ptr(__res_);
   if (__fixed_pools_ != nullptr) {
     const int n = __num_fixed_pools_;
@@ -411,6 +707,32 @@ void unsynchronized_pool_resource::do_deallocate(void* p, size_t bytes, size_t a
   }
 }
 
+// 23.12.5, mem.res.pool.resource
+
+void* synchronized_pool_resource::do_allocate(size_t bytes, size_t align) {
+#if _LIBCPP_HAS_THREADS
+  int i = __unsync_.__pool_index(bytes, align);
+  if (i < pool_thread_cache::cached_pools && i < __unsync_.__num_fixed_pools_) {
+    if (pool_thread_cache* cache = pool_thread_cache::get())
+      return cache->allocate(__unsync_, __mut_, i, __unsync_.__pool_block_size(i));
+  }
+  unique_lock<mutex> lk(__mut_);
+#endif
+  return __unsync_.allocate(bytes, align);
+}
+
+void synchronized_pool_resource::do_deallocate(void* p, size_t bytes, size_t align) {
+#if _LIBCPP_HAS_THREADS
+  int i = __unsync_.__pool_index(bytes, align);
+  if (i < pool_thread_cache::cached_pools && i < __unsync_.__num_fixed_pools_) {
+    if (pool_thread_cache* cache = pool_thread_cache::get())
+      return cache->deallocate(__unsync_, __mut_, i, __unsync_.__pool_block_size(i), p);
+  }
+  unique_lock<mutex> lk(__mut_);
+#endif
+  __unsync_.deallocate(p, bytes, align);
+}
+
 bool synchronized_pool_resource::do_is_equal(const memory_resource& other) const noexcept { return &other == this; }
 
 // 23.12.6, mem.res.monotonic.buffer
@@ -0,0 +1,231 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <__algorithm/max.h>
+#include <__algorithm/min.h>
+#include <__config>
+#include <__pstl/backends/thread_pool.h>
+#include <__utility/no_destroy.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+namespace __pstl::__thread_pool {
+namespace {
+
+// Returns the value of the environment variable `name` if it is set to a positive number, or `default_value`.
+size_t read_env(const char* name, size_t default_value) {
+  const char* value = std::getenv(name);
+  if (value == nullptr)
+    return default_value;
+  char* end;
+  unsigned long long result = std::strtoull(value, &end, 10);
+  if (end == value || *end != '\0' || result == 0)
+    return default_value;
+  return static_cast<size_t>(result);
+}
+
+size_t thread_count() {
+  static const size_t count = read_env("LIBCPP_PSTL_NUM_THREADS", std::max(1u, std::thread::hardware_concurrency()));
+  return count;
+}
+
+size_t grain_size() {
+  static const size_t size = read_env("LIBCPP_PSTL_GRAIN_SIZE", 256);
+  return size;
+}
+
+// One call to __parallel_apply. It lives on the stack of the calling thread, which returns once `remaining` dropped to
+// zero. Every task refers to at least one chunk that did not run yet, so no task refers to a job that completed.
+struct job {
+  void* context;
+  void (*func)(void*, size_t);
+  atomic<size_t> remaining;
+};
+
+// The chunks [first, last) of a job.
+struct task {
+  job* owner;
+  size_t first;
+  size_t last;
+};
+
+// The owner of a deque pushes and pops at the back, so it keeps working on the ranges it split last. Thieves take
+// from the front, which holds the largest ranges.
+class task_deque {
+public:
+  void push(task t) {
+    lock_guard<mutex> lock(mutex_);
+    tasks_.push_back(t);
+  }
+
+  bool pop(task& t) {
+    lock_guard<mutex> lock(mutex_);
+    if (tasks_.empty())
+      return false;
+    t = tasks_.back();
+    tasks_.pop_back();
+    return true;
+  }
+
+  bool steal(task& t) {
+    lock_guard<mutex> lock(mutex_);
+    if (tasks_.empty())
+      return false;
+    t = tasks_.front();
+    tasks_.pop_front();
+    return true;
+  }
+
+private:
+  mutex mutex_;
+  deque<task> tasks_;
+};
+
+constexpr size_t not_a_worker = static_cast<size_t>(-1);
+
+// The index of the deque of the current thread in the pool, or not_a_worker for threads that the pool did not create.
+thread_local size_t current_worker = not_a_worker;
+
+class thread_pool {
+public:
+  explicit thread_pool(size_t workers) : deques_(workers) {
+    workers_.reserve(workers);
+    for (size_t i = 0; i != workers; ++i) {
+#if _LIBCPP_HAS_EXCEPTIONS
+      try {
+#endif
+        workers_.emplace_back([this, i] { work(i); });
+#if _LIBCPP_HAS_EXCEPTIONS
+      } catch (...) {
+        // Run with the threads we got; the calling thread can always make progress on its own.
+        break;
+      }
+#endif
+    }
+  }
+
+  void apply(size_t chunk_count, void* context, void (*func)(void*, size_t)) {
+    job j{context, func, {chunk_count}};
+    run({&j, 0, chunk_count});
+
+    // Help with whatever work is pending until the chunks of this job that were stolen completed. This may run
+    // tasks of other jobs, which is what makes nested calls from the pool's threads safe.
+    while (j.remaining.load(memory_order_acquire) != 0) {
+      task t;
+      if (find_task(t))
+        run(t);
+      else
+        this_thread::yield();
+    }
+  }
+
+private:
+  void run(task t) {
+    // Split off the upper half until a single chunk remains, making the halves available to other threads.
+    while (t.last - t.first > 1) {
+      size_t mid = t.first + (t.last - t.first) / 2;
+      push({t.owner, mid, t.last});
+      t.last = mid;
+    }
+    job* owner = t.owner;
+    owner->func(owner->context, t.first);
+    // This must be the last access to the job, which may be destroyed as soon as `remaining` drops to zero.
+    owner->remaining.fetch_sub(1, memory_order_acq_rel);
+  }
+
+  void push(task t) {
+    // Threads outside of the pool share a deque, which the pool's threads only steal from.
+    (current_worker == not_a_worker ? injected_ : deques_[current_worker]).push(t);
+    queued_.fetch_add(1);
+    if (sleepers_.load() != 0) {
+      // Taking the mutex makes sure that a worker that saw no queued tasks is already waiting.
+      { lock_guard<mutex> lock(sleep_mutex_); }
+      wake_.notify_one();
+    }
+  }
+
+  bool find_task(task& t) {
+    size_t self = current_worker;
+    bool found  = (self != not_a_worker && deques_[self].pop(t)) || injected_.steal(t);
+    for (size_t i = 1; !found && i <= deques_.size(); ++i) {
+      size_t victim = (self == not_a_worker ? 0 : self) + i;
+      if (victim >= deques_.size())
+        victim -= deques_.size();
+      found = victim != self && deques_[victim].steal(t);
+    }
+    if (found)
+      queued_.fetch_sub(1);
+    return found;
+  }
+
+  [[noreturn]] void work(size_t index) {
+    current_worker = index;
+    for (;;) {
+      task t;
+      if (find_task(t)) {
+        run(t);
+        continue;
+      }
+      unique_lock<mutex> lock(sleep_mutex_);
+      sleepers_.fetch_add(1);
+      wake_.wait(lock, [this] { return queued_.load() != 0; });
+      sleepers_.fetch_sub(1);
+    }
+  }
+
+  vector<task_deque> deques_;
+  task_deque injected_;
+  vector<thread> workers_;
+
+  // The number of tasks in all deques, and the number of workers waiting for it to become non-zero.
+  atomic<size_t> queued_{0};
+  atomic<size_t> sleepers_{0};
+  mutex sleep_mutex_;
+  condition_variable wake_;
+};
+
+thread_pool& get_pool() {
+  // The workers never exit, so the pool must outlive static destructors that may still run parallel algorithms.
+  static __no_destroy<thread_pool> pool(thread_count() - 1);
+  return pool.__get();
+}
+
+} // namespace
+
+void __parallel_apply(size_t chunk_count, void* context, void (*func)(void* context, size_t chunk)) noexcept {
+  if (chunk_count == 1 || thread_count() == 1) {
+    for (size_t chunk = 0; chunk != chunk_count; ++chunk)
+      func(context, chunk);
+    return;
+  }
+  if (chunk_count != 0)
+    get_pool().apply(chunk_count, context, func);
+}
+
+__chunk_partitions __partition_chunks(ptrdiff_t element_count) noexcept {
+  // Create a few chunks per thread so that the threads can balance uneven work by stealing, but no more than that,
+  // as every chunk costs a task and, for reductions, a partial result.
+  ptrdiff_t max_chunks = thread_count() == 1 ? 1 : static_cast<ptrdiff_t>(thread_count() * 16);
+  ptrdiff_t grain      = static_cast<ptrdiff_t>(grain_size());
+
+  __chunk_partitions partitions;
+  partitions.__chunk_count_      = std::max<ptrdiff_t>(1, std::min(element_count / grain, max_chunks));
+  partitions.__chunk_size_       = element_count / partitions.__chunk_count_;
+  partitions.__first_chunk_size_ = element_count - (partitions.__chunk_count_ - 1) * partitions.__chunk_size_;
+  return partitions;
+}
+
+} // namespace __pstl::__thread_pool
+_LIBCPP_END_NAMESPACE_STD
@@ -0,0 +1,49 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+// The value is only found in the last element, so the whole range is scanned.
+template <class T>
+static void BM_FindLast(benchmark::State& st) {
+  std::vector<T> vec(st.range(0), T(1));
+  vec.back() = T(2);
+  for (auto _ : st) {
+    benchmark::DoNotOptimize(vec);
+    benchmark::DoNotOptimize(std::find(vec.begin(), vec.end(), T(2)));
+  }
+  st.SetBytesProcessed(st.iterations() * st.range(0) * sizeof(T));
+}
+BENCHMARK(BM_FindLast<std::int16_t>)->Range(8, 1 << 18);
+BENCHMARK(BM_FindLast<std::int32_t>)->Range(8, 1 << 18);
+BENCHMARK(BM_FindLast<std::int64_t>)->Range(8, 1 << 18);
+
+template <class T>
+static void BM_Count(benchmark::State& st) {
+  std::vector<T> vec(st.range(0));
+  for (std::size_t i = 0; i != vec.size(); ++i)
+    vec[i] = T(i % 3);
+  for (auto _ : st) {
+    benchmark::DoNotOptimize(vec);
+    benchmark::DoNotOptimize(std::count(vec.begin(), vec.end(), T(1)));
+  }
+  st.SetBytesProcessed(st.iterations() * st.range(0) * sizeof(T));
+}
+BENCHMARK(BM_Count<std::int8_t>)->Range(8, 1 << 18);
+BENCHMARK(BM_Count<std::int16_t>)->Range(8, 1 << 18);
+BENCHMARK(BM_Count<std::int32_t>)->Range(8, 1 << 18);
+BENCHMARK(BM_Count<std::int64_t>)->Range(8, 1 << 18);
+
+BENCHMARK_MAIN();
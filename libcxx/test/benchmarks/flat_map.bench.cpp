@@ -0,0 +1,73 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17, c++20
+
+#include <algorithm>
+#include <cstdint>
+#include <flat_map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+// Builds a map of state.range(0) elements with bulk inserts of state.range(1) elements each.
+static std::vector<std::vector<std::pair<std::int64_t, std::int64_t>>>
+make_batches(benchmark::State& state, bool ascending) {
+  std::mt19937_64 gen(42);
+  std::vector<std::vector<std::pair<std::int64_t, std::int64_t>>> batches(state.range(0) / state.range(1));
+  std::int64_t next = 0;
+  for (auto& batch : batches) {
+    for (std::int64_t i = 0; i != state.range(1); ++i)
+      batch.emplace_back(ascending ? next++ : static_cast<std::int64_t>(gen() % (4 * state.range(0))), i);
+    std::sort(batch.begin(), batch.end());
+    batch.erase(std::unique(batch.begin(),
+                            batch.end(),
+                            [](const auto& x, const auto& y) { return x.first == y.first; }),
+                batch.end());
+  }
+  return batches;
+}
+
+template <bool Ascending>
+static void BM_FlatMapBulkInsert(benchmark::State& state) {
+  auto batches = make_batches(state, Ascending);
+  for (auto _ : state) {
+    std::flat_map<std::int64_t, std::int64_t> map;
+    for (const auto& batch : batches)
+      map.insert(std::sorted_unique, batch.begin(), batch.end());
+    benchmark::DoNotOptimize(map);
+  }
+}
+BENCHMARK(BM_FlatMapBulkInsert<true>)->Args({1 << 16, 256})->Args({1 << 16, 4096});
+BENCHMARK(BM_FlatMapBulkInsert<false>)->Args({1 << 16, 256})->Args({1 << 16, 4096});
+
+// The same with a sorted vector of pairs, merging every batch by hand.
+template <bool Ascending>
+static void BM_SortedVectorBulkInsert(benchmark::State& state) {
+  auto batches = make_batches(state, Ascending);
+  for (auto _ : state) {
+    std::vector<std::pair<std::int64_t, std::int64_t>> vec;
+    for (const auto& batch : batches) {
+      auto offset = vec.size();
+      vec.insert(vec.end(), batch.begin(), batch.end());
+      auto middle = vec.begin() + offset;
+      auto less   = [](const auto& x, const auto& y) { return x.first < y.first; };
+      auto first  = std::lower_bound(vec.begin(), middle, *middle, less);
+      std::inplace_merge(first, middle, vec.end(), less);
+      vec.erase(std::unique(first, vec.end(), [](const auto& x, const auto& y) { return x.first == y.first; }),
+                vec.end());
+    }
+    benchmark::DoNotOptimize(vec);
+  }
+}
+BENCHMARK(BM_SortedVectorBulkInsert<true>)->Args({1 << 16, 256})->Args({1 << 16, 4096});
+BENCHMARK(BM_SortedVectorBulkInsert<false>)->Args({1 << 16, 256})->Args({1 << 16, 4096});
+
+BENCHMARK_MAIN();
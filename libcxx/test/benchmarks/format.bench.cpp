@@ -0,0 +1,50 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17
+
+#include <format>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+// A typical log line: mostly text with a few short replacement fields.
+static void BM_format_to_n_log_line(benchmark::State& state) {
+  char buffer[256];
+  int line = 42;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(line);
+    auto result = std::format_to_n(
+        buffer, sizeof(buffer), "request handled by worker {} in {} us, status {} (retries: {})", 7, line, 200, 0);
+    benchmark::DoNotOptimize(buffer);
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_format_to_n_log_line);
+
+static void BM_format_to_n_text_only(benchmark::State& state) {
+  char buffer[256];
+  for (auto _ : state) {
+    auto result = std::format_to_n(buffer, sizeof(buffer), "a format string without any replacement fields at all");
+    benchmark::DoNotOptimize(buffer);
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_format_to_n_text_only);
+
+static void BM_format_log_line(benchmark::State& state) {
+  int line = 42;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(line);
+    benchmark::DoNotOptimize(
+        std::format("request handled by worker {} in {} us, status {} (retries: {})", 7, line, 200, 0));
+  }
+}
+BENCHMARK(BM_format_log_line);
+
+BENCHMARK_MAIN();
@@ -94,4 +94,19 @@ static void BM_Ostream_number(benchmark::State& state) {
 }
 BENCHMARK(BM_Ostream_number)->DenseRange(0, 3)->UseRealTime()->Threads(1)->ThreadPerCpu();
 
+// A log line worth of numbers into the same stream.
+static void BM_Ostream_numbers(benchmark::State& state) {
+  LocaleSelector sel(state);
+  std::ostringstream ss;
+  if (sel.imbue)
+    ss.imbue(*sel.imbue);
+  int i = 0;
+  while (state.KeepRunning()) {
+    ss.seekp(0);
+    ss << i++ << ' ' << -123456789L << ' ' << 42u << ' ' << 3.25 << ' ' << -0.0001234;
+    benchmark::DoNotOptimize(ss.rdbuf());
+  }
+}
+BENCHMARK(BM_Ostream_numbers)->DenseRange(0, 3)->UseRealTime()->Threads(1)->ThreadPerCpu();
+
 BENCHMARK_MAIN();
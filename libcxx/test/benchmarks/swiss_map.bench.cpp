@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17
+
+// Compares std::__swiss_map with std::unordered_map.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "GenerateInput.h"
+
+template <class Key>
+std::vector<Key> makeKeys(std::size_t n);
+
+template <>
+std::vector<std::uint64_t> makeKeys<std::uint64_t>(std::size_t n) {
+  return getRandomIntegerInputs<std::uint64_t>(n);
+}
+
+template <>
+std::vector<std::string> makeKeys<std::string>(std::size_t n) {
+  return getRandomStringInputsWithLength(n, 32);
+}
+
+template <class Map>
+void BM_Insert(benchmark::State& st) {
+  using Key = typename Map::key_type;
+  auto in   = makeKeys<Key>(st.range(0));
+  for (auto _ : st) {
+    Map m;
+    for (const Key& k : in)
+      m.try_emplace(k);
+    benchmark::DoNotOptimize(m);
+  }
+}
+
+template <class Map>
+void BM_FindHit(benchmark::State& st) {
+  using Key = typename Map::key_type;
+  auto in   = makeKeys<Key>(st.range(0));
+  Map m;
+  for (const Key& k : in)
+    m.try_emplace(k);
+  for (auto _ : st) {
+    for (const Key& k : in)
+      benchmark::DoNotOptimize(m.find(k));
+  }
+}
+
+template <class Map>
+void BM_FindMiss(benchmark::State& st) {
+  using Key   = typename Map::key_type;
+  auto in     = makeKeys<Key>(st.range(0));
+  auto misses = makeKeys<Key>(st.range(0));
+  Map m;
+  for (const Key& k : in)
+    m.try_emplace(k);
+  for (auto _ : st) {
+    for (const Key& k : misses)
+      benchmark::DoNotOptimize(m.find(k));
+  }
+}
+
+template <class Map>
+void BM_EraseInsert(benchmark::State& st) {
+  using Key = typename Map::key_type;
+  auto in   = makeKeys<Key>(st.range(0));
+  Map m;
+  for (const Key& k : in)
+    m.try_emplace(k);
+  for (auto _ : st) {
+    for (const Key& k : in) {
+      m.erase(k);
+      m.try_emplace(k);
+    }
+  }
+}
+
+template <class Map>
+void BM_Iterate(benchmark::State& st) {
+  using Key = typename Map::key_type;
+  auto in   = makeKeys<Key>(st.range(0));
+  Map m;
+  for (const Key& k : in)
+    m.try_emplace(k);
+  for (auto _ : st) {
+    for (auto& v : m)
+      benchmark::DoNotOptimize(v.second);
+  }
+}
+
+using IntUnorderedMap    = std::unordered_map<std::uint64_t, std::uint64_t>;
+using IntSwissMap        = std::__swiss_map<std::uint64_t, std::uint64_t>;
+using StringUnorderedMap = std::unordered_map<std::string, std::uint64_t>;
+using StringSwissMap     = std::__swiss_map<std::string, std::uint64_t>;
+
+#define BENCH_ALL(Name)                                                                                                \
+  BENCHMARK(Name<IntUnorderedMap>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);                                          \
+  BENCHMARK(Name<IntSwissMap>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);                                              \
+  BENCHMARK(Name<StringUnorderedMap>)->Arg(1 << 10)->Arg(1 << 16);                                                     \
+  BENCHMARK(Name<StringSwissMap>)->Arg(1 << 10)->Arg(1 << 16)
+
+BENCH_ALL(BM_Insert);
+BENCH_ALL(BM_FindHit);
+BENCH_ALL(BM_FindMiss);
+BENCH_ALL(BM_EraseInsert);
+BENCH_ALL(BM_Iterate);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,55 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: no-threads
+
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+
+#include "benchmark/benchmark.h"
+
+// What synchronized_pool_resource did before it cached blocks per thread: one mutex around an
+// unsynchronized_pool_resource.
+class locked_pool_resource : public std::pmr::memory_resource {
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pool_.allocate(bytes, align);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pool_.deallocate(p, bytes, align);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return &other == this; }
+
+  std::mutex mutex_;
+  std::pmr::unsynchronized_pool_resource pool_;
+};
+
+// Every thread allocates a few blocks and frees them again, as a node-based container would.
+template <class Resource>
+static void BM_AllocateDeallocate(benchmark::State& state) {
+  static Resource resource;
+  const std::size_t size = state.range(0);
+  void* blocks[16];
+  for (auto _ : state) {
+    for (void*& p : blocks)
+      p = resource.allocate(size);
+    benchmark::DoNotOptimize(blocks);
+    for (void* p : blocks)
+      resource.deallocate(p, size);
+  }
+  state.SetItemsProcessed(state.iterations() * 16);
+}
+BENCHMARK(BM_AllocateDeallocate<std::pmr::synchronized_pool_resource>)->Arg(32)->Arg(256)->ThreadRange(1, 8);
+BENCHMARK(BM_AllocateDeallocate<locked_pool_resource>)->Arg(32)->Arg(256)->ThreadRange(1, 8);
+
+BENCHMARK_MAIN();
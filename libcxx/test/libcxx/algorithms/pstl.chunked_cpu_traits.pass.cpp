@@ -0,0 +1,121 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+
+// template <class _Executor>
+// struct __chunked_cpu_traits;
+
+// Check the basis operations shared by the chunked backends against their serial counterparts, with an executor that
+// runs the chunks in reverse order and partitions that don't divide the input evenly.
+
+#include <__pstl/cpu_algos/chunked_cpu_traits.h>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+struct Partitions {
+  std::ptrdiff_t __chunk_count_;
+  std::ptrdiff_t __chunk_size_;
+  std::ptrdiff_t __first_chunk_size_;
+};
+
+struct ReverseExecutor {
+  static void __apply(std::size_t chunk_count, void* context, void (*func)(void*, std::size_t)) noexcept {
+    for (std::size_t chunk = chunk_count; chunk != 0; --chunk)
+      func(context, chunk - 1);
+  }
+
+  static Partitions __partition_chunks(std::ptrdiff_t size) noexcept {
+    Partitions partitions;
+    partitions.__chunk_count_      = std::max<std::ptrdiff_t>(1, std::min<std::ptrdiff_t>(size / 7, 13));
+    partitions.__chunk_size_       = size / partitions.__chunk_count_;
+    partitions.__first_chunk_size_ = size - (partitions.__chunk_count_ - 1) * partitions.__chunk_size_;
+    return partitions;
+  }
+};
+
+using Traits = std::__pstl::__chunked_cpu_traits<ReverseExecutor>;
+
+int main(int, char**) {
+  for (int size : {0, 1, 2, 7, 8, 50, 91, 1000, 4097}) {
+    std::vector<int> v(size);
+    for (int i = 0; i != size; ++i)
+      v[i] = (i * 7919) % 101;
+
+    { // __for_each visits every element once
+      std::vector<int> expected = v;
+      for (int& x : expected)
+        ++x;
+      std::vector<int> actual = v;
+      assert(Traits::__for_each(actual.begin(), actual.end(), [](auto first, auto last) {
+        for (; first != last; ++first)
+          ++*first;
+      }));
+      assert(actual == expected);
+    }
+
+    if (!v.empty()) { // __transform_reduce
+      auto result = Traits::__transform_reduce(
+          v.begin(),
+          v.end(),
+          [](auto it) { return static_cast<long>(*it); },
+          5l,
+          std::plus<>(),
+          [](auto first, auto last, long init) {
+            for (; first != last; ++first)
+              init += *first;
+            return init;
+          });
+      assert(result);
+      assert(*result == std::accumulate(v.begin(), v.end(), 5l));
+    }
+
+    { // __stable_sort keeps equal elements in order
+      std::vector<std::pair<int, int>> actual;
+      for (int i = 0; i != size; ++i)
+        actual.emplace_back(v[i] % 10, i);
+      std::vector<std::pair<int, int>> expected = actual;
+      auto comp = [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; };
+      std::stable_sort(expected.begin(), expected.end(), comp);
+      assert(Traits::__stable_sort(actual.begin(), actual.end(), comp, [](auto first, auto last, auto c) {
+        std::stable_sort(first, last, c);
+      }));
+      assert(actual == expected);
+    }
+
+    { // __merge of two ranges of different sizes
+      std::vector<int> a(v.begin(), v.begin() + size / 3);
+      std::vector<int> b(v.begin() + size / 3, v.end());
+      std::sort(a.begin(), a.end());
+      std::sort(b.begin(), b.end());
+      std::vector<int> expected(size);
+      std::merge(a.begin(), a.end(), b.begin(), b.end(), expected.begin());
+      for (int swap = 0; swap != 2; ++swap) {
+        std::vector<int> actual(size);
+        assert(Traits::__merge(
+            a.begin(),
+            a.end(),
+            b.begin(),
+            b.end(),
+            actual.begin(),
+            std::less<>(),
+            [](auto first1, auto last1, auto first2, auto last2, auto result, auto comp) {
+              std::merge(first1, last1, first2, last2, result, comp);
+            }));
+        assert(actual == expected);
+        std::swap(a, b);
+      }
+    }
+  }
+  return 0;
+}
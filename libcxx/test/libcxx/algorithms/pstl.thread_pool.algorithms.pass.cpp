@@ -0,0 +1,70 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// <algorithm>
+
+// REQUIRES: libcpp-pstl-backend-thread-pool
+// UNSUPPORTED: c++03, c++11, c++14
+
+// Run the algorithms built on each basis operation of the thread pool backend with sizes around the chunk boundaries
+// and compare them against the serial algorithms.
+
+#include <algorithm>
+#include <cassert>
+#include <execution>
+#include <functional>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+int main(int, char**) {
+  for (int size : {0, 1, 255, 256, 257, 511, 4096, 4099, 100000}) {
+    std::vector<int> v(size);
+    for (int i = 0; i != size; ++i)
+      v[i] = (i * 7919) % 1009;
+
+    { // __for_each
+      std::vector<int> actual(size);
+      std::transform(std::execution::par, v.begin(), v.end(), actual.begin(), [](int x) { return x * 2; });
+      for (int i = 0; i != size; ++i)
+        assert(actual[i] == v[i] * 2);
+    }
+
+    { // __transform_reduce
+      long sum = std::transform_reduce(
+          std::execution::par, v.begin(), v.end(), 3l, std::plus<>(), [](int x) { return static_cast<long>(x); });
+      assert(sum == std::accumulate(v.begin(), v.end(), 3l));
+    }
+
+    { // __stable_sort
+      std::vector<std::pair<int, int>> actual;
+      for (int i = 0; i != size; ++i)
+        actual.emplace_back(v[i] % 17, i);
+      std::vector<std::pair<int, int>> expected = actual;
+      auto comp = [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; };
+      std::stable_sort(expected.begin(), expected.end(), comp);
+      std::stable_sort(std::execution::par, actual.begin(), actual.end(), comp);
+      assert(actual == expected);
+    }
+
+    { // __merge
+      std::vector<int> a(v.begin(), v.begin() + size / 3);
+      std::vector<int> b(v.begin() + size / 3, v.end());
+      std::sort(a.begin(), a.end());
+      std::sort(b.begin(), b.end());
+      std::vector<int> expected(size);
+      std::merge(a.begin(), a.end(), b.begin(), b.end(), expected.begin());
+      std::vector<int> actual(size);
+      std::merge(std::execution::par, a.begin(), a.end(), b.begin(), b.end(), actual.begin());
+      assert(actual == expected);
+      std::merge(std::execution::par, b.begin(), b.end(), a.begin(), a.end(), actual.begin());
+      assert(actual == expected);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,57 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// <algorithm>
+
+// REQUIRES: libcpp-pstl-backend-thread-pool
+// UNSUPPORTED: c++03, c++11, c++14
+
+// Make sure that parallel algorithms can be called from the function objects of other parallel algorithms, and from
+// several threads at once, without deadlocking the thread pool.
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <execution>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+int main(int, char**) {
+  {
+    std::vector<std::vector<int>> rows(100, std::vector<int>(10000));
+    std::for_each(std::execution::par, rows.begin(), rows.end(), [](std::vector<int>& row) {
+      std::fill(std::execution::par, row.begin(), row.end(), 1);
+    });
+    long sum = std::transform_reduce(
+        std::execution::par, rows.begin(), rows.end(), 0l, std::plus<>(), [](const std::vector<int>& row) {
+          return std::reduce(std::execution::par, row.begin(), row.end(), 0l);
+        });
+    assert(sum == 100l * 10000);
+  }
+
+  {
+    std::atomic<long> sum{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t != 4; ++t)
+      threads.emplace_back([&sum] {
+        std::vector<int> v(100000);
+        std::iota(v.begin(), v.end(), 0);
+        for (int i = 0; i != 10; ++i) {
+          std::sort(std::execution::par, v.begin(), v.end(), std::greater<>());
+          std::sort(std::execution::par, v.begin(), v.end());
+          assert(std::is_sorted(v.begin(), v.end()));
+          sum += std::reduce(std::execution::par, v.begin(), v.end(), 0l);
+        }
+      });
+    for (auto& thread : threads)
+      thread.join();
+    assert(sum == 4l * 10 * (99999l * 100000 / 2));
+  }
+  return 0;
+}
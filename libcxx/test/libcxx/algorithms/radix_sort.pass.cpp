@@ -0,0 +1,107 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// <algorithm>
+
+// UNSUPPORTED: c++03, c++11, c++14
+
+// Large ranges of arithmetic types are sorted with a radix sort. Make sure that the result matches the one of a
+// comparison sort, including the relative order of the signed zeros in a stable sort.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+template <class T>
+std::vector<T> make_input(std::size_t n, std::mt19937& gen) {
+  std::vector<T> v(n);
+  for (auto& x : v)
+    x = static_cast<T>(gen());
+  return v;
+}
+
+template <class T>
+std::vector<T> make_floating_point_input(std::size_t n, std::mt19937& gen) {
+  std::uniform_real_distribution<T> dist(-1000, 1000);
+  std::vector<T> v(n);
+  for (auto& x : v) {
+    switch (gen() % 5) {
+    case 0:
+      x = T(0);
+      break;
+    case 1:
+      x = -T(0);
+      break;
+    case 2:
+      x = (gen() % 2 ? 1 : -1) * std::numeric_limits<T>::infinity();
+      break;
+    case 3:
+      x = (gen() % 2 ? 1 : -1) * std::numeric_limits<T>::denorm_min();
+      break;
+    default:
+      x = dist(gen);
+    }
+  }
+  return v;
+}
+
+// A comparator that isn't recognized as std::less, so that it doesn't use the radix sort.
+template <class T>
+struct Less {
+  bool operator()(T lhs, T rhs) const { return lhs < rhs; }
+};
+
+template <class T>
+bool same_representation(const std::vector<T>& lhs, const std::vector<T>& rhs) {
+  return lhs.size() == rhs.size() && std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(T)) == 0;
+}
+
+template <class T, class MakeInput>
+void test(MakeInput make) {
+  std::mt19937 gen(42);
+  for (std::size_t n : {0, 1, 100, 255, 256, 1023, 1024, 5000, 100000}) {
+    std::vector<T> input = make(n, gen);
+
+    std::vector<T> expected = input;
+    std::stable_sort(expected.begin(), expected.end(), Less<T>());
+
+    std::vector<T> stable = input;
+    std::stable_sort(stable.begin(), stable.end());
+    assert(same_representation(stable, expected));
+
+    std::vector<T> stable_less = input;
+    std::stable_sort(stable_less.begin(), stable_less.end(), std::less<T>());
+    assert(same_representation(stable_less, expected));
+
+    std::vector<T> unstable = input;
+    std::sort(unstable.begin(), unstable.end());
+    assert(std::equal(unstable.begin(), unstable.end(), expected.begin(), expected.end()));
+  }
+}
+
+int main(int, char**) {
+  test<signed char>(make_input<signed char>);
+  test<unsigned char>(make_input<unsigned char>);
+  test<short>(make_input<short>);
+  test<unsigned short>(make_input<unsigned short>);
+  test<int>(make_input<int>);
+  test<unsigned>(make_input<unsigned>);
+  test<long long>(make_input<long long>);
+  test<unsigned long long>(make_input<unsigned long long>);
+  test<float>(make_floating_point_input<float>);
+  test<double>(make_floating_point_input<double>);
+
+  return 0;
+}
@@ -0,0 +1,148 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// <algorithm>
+
+// UNSUPPORTED: c++03, c++11, c++14
+
+// std::find and std::count on ranges of trivially equality comparable types are vectorized. Check them against a
+// scalar loop for every length and alignment around the vector size, for ranges whose elements are all equal, and
+// check that floating point types, which aren't trivially equality comparable, keep comparing NaNs and signed zeros
+// by value.
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+template <class T>
+std::ptrdiff_t scalar_find(const T* first, const T* last, T value) {
+  const T* it = first;
+  while (it != last && !(*it == value))
+    ++it;
+  return it - first;
+}
+
+template <class T>
+std::ptrdiff_t scalar_count(const T* first, const T* last, T value) {
+  std::ptrdiff_t n = 0;
+  for (; first != last; ++first)
+    n += *first == value;
+  return n;
+}
+
+template <class T>
+void check(const T* first, const T* last, T value) {
+  assert(std::find(first, last, value) - first == scalar_find(first, last, value));
+  assert(std::count(first, last, value) == scalar_count(first, last, value));
+}
+
+// The offset of the range from an aligned allocation covers unaligned heads, and the lengths cover every split into
+// unrolled iterations, single vectors and a scalar or overlapping tail.
+template <class T>
+void test_lengths_and_offsets() {
+  constexpr std::size_t max_length = 300;
+  constexpr std::size_t max_offset = 16;
+  std::vector<T> storage(max_length + max_offset);
+
+  for (std::size_t offset = 0; offset != max_offset; ++offset) {
+    for (std::size_t length = 0; length <= max_length; length += length < 80 ? 1 : 7) {
+      T* first = storage.data() + offset;
+      T* last  = first + length;
+      for (std::size_t i = 0; i != storage.size(); ++i)
+        storage[i] = static_cast<T>(i % 5 + 1);
+
+      // Not found, and a value that only occurs outside of the range.
+      check<const T>(first, last, T(0));
+      storage[offset + length] = T(0);
+      check<const T>(first, last, T(0));
+
+      // Found at each position, including the last element of the range.
+      for (std::size_t pos = 0; pos < length; pos += pos < 40 ? 1 : 13) {
+        storage[offset + pos] = T(0);
+        check<const T>(first, last, T(0));
+        storage[offset + pos] = T(1);
+      }
+      if (length != 0) {
+        storage[offset + length - 1] = T(0);
+        check<const T>(first, last, T(0));
+      }
+
+      // Several occurrences.
+      check<const T>(first, last, T(3));
+    }
+  }
+}
+
+template <class T>
+void test_all_equal() {
+  for (std::size_t length : {1, 7, 8, 31, 32, 33, 64, 127, 128, 129, 1000}) {
+    std::vector<T> v(length, T(42));
+    assert(std::find(v.begin(), v.end(), T(42)) == v.begin());
+    assert(std::find(v.begin(), v.end(), T(41)) == v.end());
+    assert(std::count(v.begin(), v.end(), T(42)) == static_cast<std::ptrdiff_t>(length));
+    assert(std::count(v.begin(), v.end(), T(41)) == 0);
+
+    // Every bit set, like the comparison mask of a matching lane.
+    if constexpr (std::is_signed_v<T>) {
+      std::vector<T> ones(length, T(-1));
+      assert(std::count(ones.begin(), ones.end(), T(-1)) == static_cast<std::ptrdiff_t>(length));
+    }
+  }
+}
+
+template <class T>
+void test_floating_point() {
+  const T nan = std::numeric_limits<T>::quiet_NaN();
+  for (std::size_t length : {1, 8, 33, 129}) {
+    std::vector<T> v(length, nan);
+    assert(std::find(v.begin(), v.end(), nan) == v.end());
+    assert(std::count(v.begin(), v.end(), nan) == 0);
+
+    std::vector<T> zeros(length, -T(0));
+    zeros.back() = T(0);
+    assert(std::find(zeros.begin(), zeros.end(), T(0)) == zeros.begin());
+    assert(std::count(zeros.begin(), zeros.end(), T(0)) == static_cast<std::ptrdiff_t>(length));
+    assert(std::count(zeros.begin(), zeros.end(), -T(0)) == static_cast<std::ptrdiff_t>(length));
+  }
+}
+
+// std::count unwraps contiguous iterators; make sure other iterators still work.
+void test_non_contiguous() {
+  std::deque<int> d;
+  for (int i = 0; i != 1000; ++i)
+    d.push_back(i % 10);
+  assert(std::count(d.begin(), d.end(), 3) == 100);
+  assert(std::find(d.begin(), d.end(), 9) == d.begin() + 9);
+}
+
+template <class T>
+void test_integral() {
+  test_lengths_and_offsets<T>();
+  test_all_equal<T>();
+}
+
+int main(int, char**) {
+  test_integral<char>();
+  test_integral<short>();
+  test_integral<unsigned short>();
+  test_integral<int>();
+  test_integral<unsigned>();
+  test_integral<long long>();
+  test_integral<unsigned long long>();
+  test_integral<char16_t>();
+  test_integral<char32_t>();
+  test_floating_point<float>();
+  test_floating_point<double>();
+  test_non_contiguous();
+
+  return 0;
+}
@@ -0,0 +1,211 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+
+// <unordered_map>
+
+// std::__swiss_map, checked against std::unordered_map.
+
+#include <cassert>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "test_macros.h"
+
+template <class Map, class Ref>
+void check_equal(const Map& m, const Ref& ref) {
+  assert(m.size() == ref.size());
+  std::size_t n = 0;
+  for (const auto& v : m) {
+    auto it = ref.find(v.first);
+    assert(it != ref.end());
+    assert(it->second == v.second);
+    ++n;
+  }
+  assert(n == ref.size());
+}
+
+void test_against_unordered_map() {
+  std::mt19937 rng(42);
+  for (int range : {8, 100, 5000}) {
+    std::__swiss_map<int, int> m;
+    std::unordered_map<int, int> ref;
+    for (int i = 0; i != 20000; ++i) {
+      int k = static_cast<int>(rng() % range);
+      switch (rng() % 4) {
+      case 0:
+        m[k]   = i;
+        ref[k] = i;
+        break;
+      case 1:
+        assert(m.erase(k) == ref.erase(k));
+        break;
+      case 2: {
+        auto r1 = m.try_emplace(k, i);
+        auto r2 = ref.try_emplace(k, i);
+        assert(r1.second == r2.second);
+        assert(r1.first->second == r2.first->second);
+        break;
+      }
+      default: {
+        auto it = m.find(k);
+        assert((it == m.end()) == (ref.find(k) == ref.end()));
+        if (it != m.end()) {
+          m.erase(it);
+          ref.erase(k);
+        }
+      }
+      }
+      assert(m.size() == ref.size());
+    }
+    check_equal(m, ref);
+
+    std::__swiss_map<int, int> copy = m;
+    assert(copy == m);
+    std::__swiss_map<int, int> moved = std::move(copy);
+    assert(moved == m);
+
+    m.rehash(0);
+    check_equal(m, ref);
+    m.clear();
+    assert(m.empty());
+    assert(m.begin() == m.end());
+  }
+}
+
+void test_interface() {
+  std::__swiss_map<std::string, std::string> m = {{"a", "1"}, {"b", "2"}};
+  assert(m.emplace("c", "3").second);
+  assert(!m.emplace(std::make_pair(std::string("a"), std::string("x"))).second);
+  assert(m.insert_or_assign("a", "x").second == false);
+  assert(m.at("a") == "x");
+  assert(m.count("b") == 1);
+  assert(!m.contains("d"));
+
+  m.reserve(1000);
+  std::size_t buckets = m.bucket_count();
+  for (int i = 0; i != 1000; ++i)
+    m[std::to_string(i)] = "v";
+  assert(m.bucket_count() == buckets);
+  assert(m.size() == 1003);
+  assert(m.load_factor() <= m.max_load_factor());
+
+  auto it = m.erase(m.find("a"));
+  assert(m.size() == 1002);
+  for (; it != m.end(); ++it)
+    assert(it->first != "a");
+
+#ifndef TEST_HAS_NO_EXCEPTIONS
+  try {
+    (void)m.at("a");
+    assert(false);
+  } catch (const std::out_of_range&) {
+  }
+#endif
+}
+
+#ifndef TEST_HAS_NO_EXCEPTIONS
+struct ThrowingCopy {
+  static int copies_left;
+  int value;
+
+  explicit ThrowingCopy(int v) : value(v) {}
+  ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+    if (copies_left-- == 0)
+      throw 0;
+  }
+  ThrowingCopy(ThrowingCopy&& other) noexcept(false) : value(other.value) {}
+};
+int ThrowingCopy::copies_left = -1;
+
+// Elements that may throw when moved are copied when growing, so the map is left untouched if that fails.
+void test_rehash_exception_safety() {
+  std::__swiss_map<int, ThrowingCopy> m;
+  m.reserve(1);
+  std::size_t buckets = m.bucket_count();
+  int n               = static_cast<int>(m.max_load_factor() * buckets);
+  for (int i = 0; i != n; ++i)
+    m.emplace(i, ThrowingCopy(i));
+  assert(m.bucket_count() == buckets);
+  // The map is full, so inserting another element grows it.
+
+  ThrowingCopy::copies_left = 3;
+  try {
+    m.emplace(n, ThrowingCopy(n));
+    assert(false);
+  } catch (int) {
+  }
+  ThrowingCopy::copies_left = -1;
+  assert(m.bucket_count() == buckets);
+  assert(m.size() == static_cast<std::size_t>(n));
+  for (int i = 0; i != n; ++i)
+    assert(m.at(i).value == i);
+}
+
+struct ThrowingHash {
+  static int hashes_left;
+
+  std::size_t operator()(int k) const {
+    if (hashes_left >= 0 && hashes_left-- == 0)
+      throw 0;
+    return std::hash<int>()(k);
+  }
+};
+int ThrowingHash::hashes_left = -1;
+
+// Nothrow movable elements are moved when growing, but only after all of them were hashed, so the map is left
+// untouched if the hasher throws.
+void test_rehash_throwing_hash() {
+  std::__swiss_map<int, std::string, ThrowingHash> m;
+  m.reserve(1);
+  std::size_t buckets = m.bucket_count();
+  int n               = static_cast<int>(m.max_load_factor() * buckets);
+  for (int i = 0; i != n; ++i)
+    m.emplace(i, std::to_string(i));
+  assert(m.bucket_count() == buckets);
+
+  // The first hash is the one of the new key, the others happen while growing.
+  for (int hashes = 1; hashes != n + 1; ++hashes) {
+    ThrowingHash::hashes_left = hashes;
+    try {
+      m.emplace(n, std::to_string(n));
+      assert(false);
+    } catch (int) {
+    }
+    ThrowingHash::hashes_left = -1;
+    assert(m.bucket_count() == buckets);
+    assert(m.size() == static_cast<std::size_t>(n));
+    for (int i = 0; i != n; ++i)
+      assert(m.at(i) == std::to_string(i));
+  }
+}
+#endif
+
+struct ThrowingMoveHash {
+  ThrowingMoveHash() = default;
+  ThrowingMoveHash(const ThrowingMoveHash&) = default;
+  ThrowingMoveHash(ThrowingMoveHash&&) noexcept(false) {}
+  std::size_t operator()(int k) const { return std::hash<int>()(k); }
+};
+
+static_assert(std::is_nothrow_move_constructible<std::__swiss_map<int, int> >::value, "");
+static_assert(!std::is_nothrow_move_constructible<std::__swiss_map<int, int, ThrowingMoveHash> >::value, "");
+
+int main(int, char**) {
+  test_against_unordered_map();
+  test_interface();
+#ifndef TEST_HAS_NO_EXCEPTIONS
+  test_rehash_exception_safety();
+  test_rehash_throwing_hash();
+#endif
+  return 0;
+}
@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// <ostream>
+
+// UNSUPPORTED: no-localization
+// UNSUPPORTED: c++03
+
+// Numbers written to a stream in the classic locale bypass num_put unless a flag changes the result. Make sure that
+// the result is the same as printf's, which num_put is specified in terms of, for the flags that take either path.
+
+#include <cassert>
+#include <cstdio>
+#include <ios>
+#include <limits>
+#include <sstream>
+#include <string>
+
+template <class T>
+std::string stream(T value, std::ios_base::fmtflags flags = std::ios_base::dec, int precision = 6, int width = 0) {
+  std::ostringstream ss;
+  ss.flags(flags);
+  ss.precision(precision);
+  ss.width(width);
+  ss << value;
+  assert(ss.width() == 0);
+  return ss.str();
+}
+
+template <class... Args>
+std::string print(const char* format, Args... args) {
+  char buffer[512];
+  std::snprintf(buffer, sizeof(buffer), format, args...);
+  return buffer;
+}
+
+int main(int, char**) {
+  for (long long value : {0LL, 1LL, -1LL, 42LL, -123456789LL, std::numeric_limits<long long>::min()}) {
+    assert(stream(value) == print("%lld", value));
+    assert(stream(value, std::ios_base::fmtflags()) == print("%lld", value));
+    assert(stream(value, std::ios_base::dec | std::ios_base::showpos) == print("%+lld", value));
+    assert(stream(value, std::ios_base::hex) == print("%llx", value));
+    assert(stream(value, std::ios_base::dec, 6, 25) == print("%25lld", value));
+    assert(stream(static_cast<int>(value)) == print("%d", static_cast<int>(value)));
+    assert(stream(static_cast<short>(value)) == print("%hd", static_cast<short>(value)));
+  }
+  assert(stream(std::numeric_limits<unsigned long long>::max()) ==
+         print("%llu", std::numeric_limits<unsigned long long>::max()));
+
+  for (double value : {0.0, -0.0, 1.0, 0.1, -2.5, 1e-5, 123456.0, 1234567.0, 1e300, 5e-324}) {
+    for (int precision : {0, 1, 6, 17, 30})
+      assert(stream(value, std::ios_base::dec, precision) == print("%.*g", precision, value));
+    assert(stream(value, std::ios_base::dec | std::ios_base::showpoint) == print("%#g", value));
+    assert(stream(value, std::ios_base::dec | std::ios_base::showpos) == print("%+g", value));
+    assert(stream(value, std::ios_base::dec | std::ios_base::uppercase) == print("%G", value));
+    assert(stream(value, std::ios_base::fixed) == print("%f", value));
+    assert(stream(value, std::ios_base::dec, 6, 20) == print("%20g", value));
+    assert(stream(static_cast<float>(value)) == print("%g", static_cast<double>(static_cast<float>(value))));
+  }
+  assert(stream(std::numeric_limits<double>::infinity()) == "inf");
+  assert(stream(-std::numeric_limits<double>::infinity()) == "-inf");
+
+  return 0;
+}
@@ -0,0 +1,141 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// <memory_resource>
+
+// UNSUPPORTED: no-threads
+// UNSUPPORTED: c++03, c++11, c++14
+// XFAIL: availability-pmr-missing
+
+// synchronized_pool_resource caches small blocks per thread. Make sure that blocks can be allocated and deallocated
+// from several threads, also in different threads and on different resources, and that release() and the destructor
+// of a resource return all memory upstream, including the blocks cached by other threads.
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class counting_resource : public std::pmr::memory_resource {
+public:
+  std::size_t outstanding() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return outstanding_;
+  }
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    void* result = std::pmr::new_delete_resource()->allocate(bytes, align);
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++outstanding_;
+    return result;
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    std::lock_guard<std::mutex> lock(mutex_);
+    --outstanding_;
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return &other == this; }
+
+  std::mutex mutex_;
+  std::size_t outstanding_ = 0;
+};
+
+struct block {
+  void* p;
+  std::size_t size;
+};
+
+void use(std::pmr::memory_resource& resource, std::vector<block>& blocks, unsigned seed, int iterations) {
+  static const std::size_t sizes[] = {1, 8, 24, 64, 100, 256, 512, 1000, 4096, 100000};
+  for (int i = 0; i != iterations; ++i) {
+    seed = seed * 1103515245 + 12345;
+    if (blocks.size() < 300 && (seed >> 16) % 3 != 0) {
+      std::size_t size = sizes[(seed >> 8) % (sizeof(sizes) / sizeof(sizes[0]))];
+      void* p          = resource.allocate(size);
+      std::memset(p, static_cast<unsigned char>(i), size);
+      blocks.push_back({p, size});
+    } else if (!blocks.empty()) {
+      resource.deallocate(blocks.back().p, blocks.back().size);
+      blocks.pop_back();
+    }
+  }
+}
+
+int main(int, char**) {
+  counting_resource upstream;
+  {
+    std::pmr::synchronized_pool_resource first(&upstream);
+    std::pmr::synchronized_pool_resource second(&upstream);
+
+    // Allocate on one thread and deallocate on another one.
+    std::vector<block> handed_over;
+    std::thread producer([&] { use(first, handed_over, 1, 2000); });
+    producer.join();
+    std::thread consumer([&] {
+      for (block b : handed_over)
+        first.deallocate(b.p, b.size);
+    });
+    consumer.join();
+    handed_over.clear();
+
+    // Use both resources from several threads at once, and release one of them while the threads are paused with
+    // blocks of both in their caches.
+    std::atomic<unsigned> paused(0);
+    std::atomic<bool> released(false);
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t != 4; ++t) {
+      threads.emplace_back([&, t] {
+        std::vector<block> blocks;
+        for (int round = 0; round != 10; ++round) {
+          if (round == 5) {
+            ++paused;
+            while (!released)
+              std::this_thread::yield();
+          }
+          std::pmr::synchronized_pool_resource& resource = round % 2 ? first : second;
+          use(resource, blocks, t * 100 + round, 500);
+          for (block b : blocks)
+            resource.deallocate(b.p, b.size);
+          blocks.clear();
+        }
+      });
+    }
+    while (paused != 4)
+      std::this_thread::yield();
+    first.release();
+    released = true;
+    for (std::thread& thread : threads)
+      thread.join();
+
+    first.release();
+    {
+      std::vector<block> blocks;
+      use(first, blocks, 42, 1000);
+      for (block b : blocks)
+        first.deallocate(b.p, b.size);
+    }
+    second.release();
+    first.release();
+    assert(upstream.outstanding() == 0);
+
+    // The destructor releases the blocks that are still allocated.
+    std::vector<block> leaked;
+    use(first, leaked, 7, 100);
+  }
+  assert(upstream.outstanding() == 0);
+
+  return 0;
+}
@@ -26,10 +26,14 @@
 #include "llvm/DebugInfo/PDB/Native/PDBFile.h"
 #include "llvm/DebugInfo/PDB/Native/TpiHashing.h"
 #include "llvm/DebugInfo/PDB/Native/TpiStream.h"
+#include "llvm/Support/CachePruning.h"
+#include "llvm/Support/EndianStream.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TimeProfiler.h"
+#include "llvm/Support/xxhash.h"
 
 using namespace llvm;
 using namespace llvm::codeview;
@@ -588,15 +592,85 @@ void PrecompSource::registerMapping() {
 // Parellel GHash type merging implementation.
 //===----------------------------------------------------------------------===//
 
+// With /lldghashcache:, the ghashes computed for an object file without a
+// .debug$H section are saved to a file named after a hash of its .debug$T
+// contents, so that later links with an identical .debug$T (e.g. from system
+// libraries or unchanged third-party objects) can skip hashing every record.
+// The llvmcache- prefix lets pruneCache apply /lldghashcachepolicy: to them.
+// The file consists of a magic string, the size of .debug$T, the number of
+// ghashes, and the ghashes.
+static constexpr char ghashCacheMagic[] = "lldghsh1";
+
+static std::string getGHashCachePath(StringRef dir, ArrayRef<uint8_t> debugT) {
+  XXH128_hash_t h = xxh3_128bits(debugT);
+  SmallString<128> path(dir);
+  sys::path::append(path, "llvmcache-ghash-" +
+                              utohexstr(h.high64, true, 16) +
+                              utohexstr(h.low64, true, 16));
+  return std::string(path);
+}
+
+static std::optional<std::vector<GloballyHashedType>>
+readCachedGHashes(StringRef path, ArrayRef<uint8_t> debugT) {
+  auto mbOrErr = MemoryBuffer::getFile(path, /*IsText=*/false,
+                                       /*RequiresNullTerminator=*/false);
+  if (!mbOrErr)
+    return std::nullopt;
+  StringRef buf = (*mbOrErr)->getBuffer();
+  constexpr size_t headerSize = 8 + 8 + 8;
+  if (buf.size() < headerSize || !buf.starts_with(ghashCacheMagic))
+    return std::nullopt;
+  uint64_t debugTSize = support::endian::read64le(buf.data() + 8);
+  uint64_t count = support::endian::read64le(buf.data() + 16);
+  if (debugTSize != debugT.size() ||
+      buf.size() - headerSize != count * sizeof(GloballyHashedType))
+    return std::nullopt;
+  std::vector<GloballyHashedType> hashes(count);
+  memcpy(hashes.data(), buf.data() + headerSize,
+         count * sizeof(GloballyHashedType));
+  return hashes;
+}
+
+static void writeCachedGHashes(COFFLinkerContext &ctx, StringRef path,
+                               ArrayRef<uint8_t> debugT,
+                               ArrayRef<GloballyHashedType> hashes) {
+  // writeToOutput writes to a temporary file and renames it, so concurrent
+  // links never observe a partial file.
+  Error e = writeToOutput(path, [&](raw_ostream &os) -> Error {
+    os << StringRef(ghashCacheMagic, 8);
+    support::endian::write<uint64_t>(os, debugT.size(),
+                                     llvm::endianness::little);
+    support::endian::write<uint64_t>(os, hashes.size(),
+                                     llvm::endianness::little);
+    os << toStringRef(ArrayRef(
+        reinterpret_cast<const uint8_t *>(hashes.data()),
+        hashes.size() * sizeof(GloballyHashedType)));
+    return Error::success();
+  });
+  if (e)
+    Log(ctx) << "cannot write " << path << ": " << std::move(e);
+}
+
 void TpiSource::loadGHashes() {
   if (std::optional<ArrayRef<uint8_t>> debugH = getDebugH(file)) {
     ghashes = getHashesFromDebugH(*debugH);
     ownedGHashes = false;
   } else {
-    CVTypeArray types;
-    BinaryStreamReader reader(file->debugTypes, llvm::endianness::little);
-    cantFail(reader.readArray(types, reader.getLength()));
-    assignGHashesFromVector(GloballyHashedType::hashTypes(types));
+    std::string cachePath;
+    std::optional<std::vector<GloballyHashedType>> hashVec;
+    if (!ctx.config.ghashCache.empty()) {
+      cachePath = getGHashCachePath(ctx.config.ghashCache, file->debugTypes);
+      hashVec = readCachedGHashes(cachePath, file->debugTypes);
+    }
+    if (!hashVec) {
+      CVTypeArray types;
+      BinaryStreamReader reader(file->debugTypes, llvm::endianness::little);
+      cantFail(reader.readArray(types, reader.getLength()));
+      hashVec = GloballyHashedType::hashTypes(types);
+      if (!cachePath.empty())
+        writeCachedGHashes(ctx, cachePath, file->debugTypes, *hashVec);
+    }
+    assignGHashesFromVector(std::move(*hashVec));
   }
 
   fillIsItemIndexFromDebugT();
@@ -1082,6 +1156,8 @@ void TypeMerger::mergeTypesWithGHash() {
                     [&](TpiSource *source) { source->loadGHashes(); });
     parallelForEach(objectSources,
                     [&](TpiSource *source) { source->loadGHashes(); });
+    if (!ctx.config.ghashCache.empty())
+      pruneCache(ctx.config.ghashCache, ctx.config.ghashCachePolicy);
   }
 
   llvm::TimeTraceScope timeScope("Merge types (GHASH)");
@@ -2010,12 +2010,27 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
   if (auto *arg = args.getLastArg(OPT_lldltocache))
     config->ltoCache = arg->getValue();
 
+  // Handle /lldghashcache
+  if (auto *arg = args.getLastArg(OPT_lldghashcache)) {
+    config->ghashCache = arg->getValue();
+    if (std::error_code ec = sys::fs::create_directories(config->ghashCache))
+      Warn(ctx) << "/lldghashcache: cannot create " << config->ghashCache
+                << ": " << ec.message();
+  }
+
   // Handle /lldsavecachepolicy
   if (auto *arg = args.getLastArg(OPT_lldltocachepolicy))
     config->ltoCachePolicy = CHECK(
         parseCachePruningPolicy(arg->getValue()),
         Twine("/lldltocachepolicy: invalid cache policy: ") + arg->getValue());
 
+  // Handle /lldghashcachepolicy
+  if (auto *arg = args.getLastArg(OPT_lldghashcachepolicy))
+    config->ghashCachePolicy = CHECK(
+        parseCachePruningPolicy(arg->getValue()),
+        Twine("/lldghashcachepolicy: invalid cache policy: ") +
+            arg->getValue());
+
   // Handle /failifmismatch
   for (auto *arg : args.filtered(OPT_failifmismatch))
     checkFailIfMismatch(arg->getValue(), nullptr);
@@ -55,6 +55,7 @@
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FormatAdapters.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/ScopedPrinter.h"
 #include "llvm/Support/TimeProfiler.h"
@@ -72,6 +73,18 @@ using llvm::pdb::StringTableFixup;
 namespace {
 class DebugSHandler;
 
+// Diagnostics of a module symbol stream that is built in parallel with others.
+using DeferredDiagnostics = std::vector<std::pair<DiagLevel, std::string>>;
+
+// Reports a diagnostic, or stores it in `deferred` if that is set.
+void report(COFFLinkerContext &ctx, DeferredDiagnostics *deferred,
+            DiagLevel level, const Twine &msg) {
+  if (deferred)
+    deferred->emplace_back(level, msg.str());
+  else
+    COFFSyncStream(ctx, level) << msg.str();
+}
+
 class PDBLinker {
   friend DebugSHandler;
 
@@ -124,6 +137,17 @@ public:
   // given object file into the given stream writer.
   Error writeAllModuleSymbolRecords(ObjFile *file, BinaryStreamWriter &writer);
 
+  // Copy, relocate, and rewrite all module symbols of the given object file
+  // into `out`, which will be written to the module stream at `startOffset`.
+  // If `deferred` is set, diagnostics are stored there instead of reported.
+  Error buildModuleSymbolStream(ObjFile *file, uint32_t startOffset,
+                                std::vector<uint8_t> &out,
+                                DeferredDiagnostics *deferred = nullptr);
+
+  // Build the module symbol streams of the object files following the last
+  // batch in parallel, until their input size reaches a limit.
+  void buildModuleSymbolStreamBatch(uint32_t startOffset);
+
   // Callback to copy and relocate debug symbols during PDB file writing.
   static Error commitSymbolsForObject(void *ctx, void *obj,
                                       BinaryStreamWriter &writer);
@@ -134,7 +158,8 @@ public:
   void writeSymbolRecord(SectionChunk *debugChunk,
                          ArrayRef<uint8_t> sectionContents, CVSymbol sym,
                          size_t alignedSize, uint32_t &nextRelocIndex,
-                         std::vector<uint8_t> &storage);
+                         std::vector<uint8_t> &storage,
+                         DeferredDiagnostics *deferred = nullptr);
 
   /// Add the section map and section contributions to the PDB.
   void addSections(ArrayRef<uint8_t> sectionTable);
@@ -148,7 +173,7 @@ public:
 private:
   void pdbMakeAbsolute(SmallVectorImpl<char> &fileName);
   void translateIdSymbols(MutableArrayRef<uint8_t> &recordData,
-                          TpiSource *source);
+                          TpiSource *source, DeferredDiagnostics *deferred);
   void addCommonLinkerModuleSymbols(StringRef path,
                                     pdb::DbiModuleDescriptorBuilder &mod);
 
@@ -164,6 +189,19 @@ private:
 
   llvm::SmallString<128> nativePath;
 
+  // Module symbol streams built ahead of time by buildModuleSymbolStreamBatch.
+  struct PrebuiltModuleSymbols {
+    // The offset in the module stream the symbols were built for.
+    uint32_t startOffset;
+    std::vector<uint8_t> data;
+    // Reported when the stream is committed, so that they come out in module
+    // order like on the serial path.
+    DeferredDiagnostics diagnostics;
+  };
+  DenseMap<ObjFile *, PrebuiltModuleSymbols> prebuiltModuleSymbols;
+  // The index into ctx.objFileInstances of the next file to prebuild.
+  size_t nextPrebuiltFile = 0;
+
   // For statistics
   uint64_t globalSymbols = 0;
   uint64_t moduleSymbols = 0;
@@ -340,7 +378,8 @@ static SymbolKind symbolKind(ArrayRef<uint8_t> recordData) {
 
 /// MSVC translates S_PROC_ID_END to S_END, and S_[LG]PROC32_ID to S_[LG]PROC32
 void PDBLinker::translateIdSymbols(MutableArrayRef<uint8_t> &recordData,
-                                   TpiSource *source) {
+                                   TpiSource *source,
+                                   DeferredDiagnostics *deferred) {
   RecordPrefix *prefix = reinterpret_cast<RecordPrefix *>(recordData.data());
 
   SymbolKind kind = symbolKind(recordData);
@@ -385,11 +424,12 @@ void PDBLinker::translateIdSymbols(MutableArrayRef<uint8_t> &recordData,
         }
       }
       if (newType == TypeIndex(SimpleTypeKind::NotTranslated)) {
-        Warn(ctx) << formatv(
-            "procedure symbol record for `{0}` in {1} refers to PDB "
-            "item index {2:X} which is not a valid function ID record",
-            getSymbolName(CVSymbol(recordData)), source->file->getName(),
-            ti->getIndex());
+        report(ctx, deferred, DiagLevel::Warn,
+               formatv("procedure symbol record for `{0}` in {1} refers to "
+                       "PDB item index {2:X} which is not a valid function ID "
+                       "record",
+                       getSymbolName(CVSymbol(recordData)),
+                       source->file->getName(), ti->getIndex()));
       }
       *ti = newType;
     }
@@ -425,9 +465,11 @@ static void scopeStackOpen(SmallVectorImpl<uint32_t> &stack,
 static void scopeStackClose(COFFLinkerContext &ctx,
                             SmallVectorImpl<uint32_t> &stack,
                             std::vector<uint8_t> &storage,
-                            uint32_t storageBaseOffset, ObjFile *file) {
+                            uint32_t storageBaseOffset, ObjFile *file,
+                            DeferredDiagnostics *deferred) {
   if (stack.empty()) {
-    Warn(ctx) << "symbol scopes are not balanced in " << file->getName();
+    report(ctx, deferred, DiagLevel::Warn,
+           "symbol scopes are not balanced in " + file->getName());
     return;
   }
 
@@ -559,7 +601,8 @@ void PDBLinker::writeSymbolRecord(SectionChunk *debugChunk,
                                   ArrayRef<uint8_t> sectionContents,
                                   CVSymbol sym, size_t alignedSize,
                                   uint32_t &nextRelocIndex,
-                                  std::vector<uint8_t> &storage) {
+                                  std::vector<uint8_t> &storage,
+                                  DeferredDiagnostics *deferred) {
   // Allocate space for the new record at the end of the storage.
   storage.resize(storage.size() + alignedSize);
   auto recordBytes = MutableArrayRef<uint8_t>(storage).take_back(alignedSize);
@@ -572,14 +615,15 @@ void PDBLinker::writeSymbolRecord(SectionChunk *debugChunk,
   // Re-map all the type index references.
   TpiSource *source = debugChunk->file->debugTypesObj;
   if (!source->remapTypesInSymbolRecord(recordBytes)) {
-    Log(ctx) << "ignoring unknown symbol record with kind 0x"
-             << utohexstr(sym.kind());
+    report(ctx, deferred, DiagLevel::Log,
+           "ignoring unknown symbol record with kind 0x" +
+               utohexstr(sym.kind()));
     replaceWithSkipRecord(recordBytes);
   }
 
   // An object file may have S_xxx_ID symbols, but these get converted to
   // "real" symbols in a PDB.
-  translateIdSymbols(recordBytes, source);
+  translateIdSymbols(recordBytes, source, deferred);
 }
 
 void PDBLinker::analyzeSymbolSubsection(
@@ -644,10 +688,9 @@ void PDBLinker::analyzeSymbolSubsection(
   }
 }
 
-Error PDBLinker::writeAllModuleSymbolRecords(ObjFile *file,
-                                             BinaryStreamWriter &writer) {
-  ExitOnError exitOnErr;
-  std::vector<uint8_t> storage;
+Error PDBLinker::buildModuleSymbolStream(ObjFile *file, uint32_t startOffset,
+                                         std::vector<uint8_t> &out,
+                                         DeferredDiagnostics *deferred) {
   SmallVector<uint32_t, 4> scopes;
 
   // Visit all live .debug$S sections a second time, and write them to the PDB.
@@ -661,16 +704,16 @@ Error PDBLinker::writeAllModuleSymbolRecords(ObjFile *file,
         SectionChunk::consumeDebugMagic(sectionContents, ".debug$S");
     DebugSubsectionArray subsections;
     BinaryStreamReader reader(contents, llvm::endianness::little);
-    exitOnErr(reader.readArray(subsections, contents.size()));
+    if (Error e = reader.readArray(subsections, contents.size()))
+      return e;
 
     uint32_t nextRelocIndex = 0;
     for (const DebugSubsectionRecord &ss : subsections) {
       if (ss.kind() != DebugSubsectionKind::Symbols)
         continue;
 
-      uint32_t moduleSymStart = writer.getOffset();
+      size_t subsectionStart = out.size();
       scopes.clear();
-      storage.clear();
       ArrayRef<uint8_t> symsBuffer;
       BinaryStreamRef sr = ss.getRecordData();
       cantFail(sr.readBytes(0, sr.getLength(), symsBuffer));
@@ -679,16 +722,16 @@ Error PDBLinker::writeAllModuleSymbolRecords(ObjFile *file,
             // Track the current scope. Only update records in the postmerge
             // pass.
             if (symbolOpensScope(sym.kind()))
-              scopeStackOpen(scopes, storage);
+              scopeStackOpen(scopes, out);
             else if (symbolEndsScope(sym.kind()))
-              scopeStackClose(ctx, scopes, storage, moduleSymStart, file);
+              scopeStackClose(ctx, scopes, out, startOffset, file, deferred);
 
             // Copy, relocate, and rewrite each module symbol.
             if (symbolGoesInModuleStream(sym, scopes.size())) {
               uint32_t alignedSize =
                   alignTo(sym.length(), alignOf(CodeViewContainer::Pdb));
               writeSymbolRecord(debugChunk, sectionContents, sym, alignedSize,
-                                nextRelocIndex, storage);
+                                nextRelocIndex, out, deferred);
             }
             return Error::success();
           });
@@ -697,21 +740,76 @@ Error PDBLinker::writeAllModuleSymbolRecords(ObjFile *file,
       // already warned about them in the first analysis pass.
       if (ec) {
         consumeError(std::move(ec));
-        storage.clear();
+        out.resize(subsectionStart);
       }
-
-      // Writing bytes has a very high overhead, so write the entire subsection
-      // at once.
-      // TODO: Consider buffering symbols for the entire object file to reduce
-      // overhead even further.
-      if (Error e = writer.writeBytes(storage))
-        return e;
     }
   }
 
   return Error::success();
 }
 
+void PDBLinker::buildModuleSymbolStreamBatch(uint32_t startOffset) {
+  // Bound the memory used by the prebuilt streams, which are about as large as
+  // the .debug$S sections they are built from.
+  constexpr uint64_t batchLimit = 256 << 20;
+  ArrayRef<ObjFile *> files = ctx.objFileInstances;
+  size_t begin = nextPrebuiltFile, end = begin;
+  for (uint64_t size = 0; end != files.size() && size < batchLimit; ++end)
+    for (SectionChunk *debugChunk : files[end]->getDebugChunks())
+      if (debugChunk->live)
+        size += debugChunk->getSize();
+  nextPrebuiltFile = end;
+
+  std::vector<PrebuiltModuleSymbols> streams(end - begin);
+  std::unique_ptr<bool[]> ok = std::make_unique<bool[]>(end - begin);
+  parallelFor(0, end - begin, [&](size_t i) {
+    streams[i].startOffset = startOffset;
+    Error e = buildModuleSymbolStream(files[begin + i], startOffset,
+                                      streams[i].data,
+                                      &streams[i].diagnostics);
+    ok[i] = !e;
+    consumeError(std::move(e));
+  });
+  for (size_t i = 0; i != end - begin; ++i)
+    if (ok[i])
+      prebuiltModuleSymbols[files[begin + i]] = std::move(streams[i]);
+}
+
+Error PDBLinker::writeAllModuleSymbolRecords(ObjFile *file,
+                                             BinaryStreamWriter &writer) {
+  // Module streams are committed one at a time in module order. Rewriting the
+  // symbol records dominates, so do that for a batch of the following object
+  // files in parallel. Fall back to building the stream here if it was not
+  // prebuilt (e.g. it failed, in which case this reports the error) or was
+  // built for a different offset.
+  uint32_t startOffset = writer.getOffset();
+  auto it = prebuiltModuleSymbols.find(file);
+  if (it == prebuiltModuleSymbols.end() &&
+      nextPrebuiltFile != ctx.objFileInstances.size()) {
+    buildModuleSymbolStreamBatch(startOffset);
+    it = prebuiltModuleSymbols.find(file);
+  }
+
+  std::vector<uint8_t> storage;
+  bool prebuilt = false;
+  if (it != prebuiltModuleSymbols.end()) {
+    if (it->second.startOffset == startOffset) {
+      storage = std::move(it->second.data);
+      for (auto &[level, msg] : it->second.diagnostics)
+        report(ctx, nullptr, level, msg);
+      prebuilt = true;
+    }
+    prebuiltModuleSymbols.erase(it);
+  }
+  if (!prebuilt)
+    if (Error e = buildModuleSymbolStream(file, startOffset, storage))
+      return e;
+
+  // Writing bytes has a very high overhead, so write the entire stream at
+  // once.
+  return writer.writeBytes(storage);
+}
+
 Error PDBLinker::commitSymbolsForObject(void *ctx, void *obj,
                                         BinaryStreamWriter &writer) {
   return static_cast<PDBLinker *>(ctx)->writeAllModuleSymbolRecords(
@@ -2669,9 +2669,19 @@ void Writer::addBaserels() {
     if (sec->header.Characteristics & IMAGE_SCN_MEM_DISCARDABLE)
       continue;
     llvm::TimeTraceScope timeScope("Base relocations: ", sec->name);
-    // Collect all locations for base relocations.
-    for (Chunk *c : sec->chunks)
-      c->getBaserels(&v);
+    // Collect all locations for base relocations. Sections such as .text can
+    // have hundreds of thousands of chunks, so scan them in parallel and
+    // concatenate the results in chunk order to keep the output deterministic.
+    std::vector<std::vector<Baserel>> perChunk(sec->chunks.size());
+    parallelFor(0, sec->chunks.size(), [&](size_t i) {
+      sec->chunks[i]->getBaserels(&perChunk[i]);
+    });
+    size_t numBaserels = 0;
+    for (const std::vector<Baserel> &rels : perChunk)
+      numBaserels += rels.size();
+    v.reserve(numBaserels);
+    for (const std::vector<Baserel> &rels : perChunk)
+      v.insert(v.end(), rels.begin(), rels.end());
     // Add the addresses to .reloc section.
     if (!v.empty())
       addBaserelBlocks(v);
@@ -2682,10 +2692,13 @@ void Writer::addBaserels() {
 // Add addresses to .reloc section. Note that addresses are grouped by page.
 void Writer::addBaserelBlocks(std::vector<Baserel> &v) {
   const uint32_t mask = ~uint32_t(pageSize - 1);
+  // Chunks are laid out in increasing RVA order, so V is usually sorted
+  // already. Use a stable sort so that duplicate RVAs keep their order.
+  auto less = [](const Baserel &x, const Baserel &y) { return x.rva < y.rva; };
+  if (!llvm::is_sorted(v, less))
+    llvm::stable_sort(v, less);
   uint32_t page = v[0].rva & mask;
   size_t i = 0, j = 1;
-  llvm::sort(v,
-             [](const Baserel &x, const Baserel &y) { return x.rva < y.rva; });
   for (size_t e = v.size(); j < e; ++j) {
     uint32_t p = v[j].rva & mask;
     if (p == page)
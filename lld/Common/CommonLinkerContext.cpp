@@ -24,6 +24,7 @@ static CommonLinkerContext *lctx;
 
 CommonLinkerContext::CommonLinkerContext() {
   lctx = this;
+  ++SpecificAllocBase::generation;
   // Fire off the static initializations in CGF's constructor.
   codegen::RegisterCodeGenFlags CGF;
 }
@@ -34,6 +35,10 @@ CommonLinkerContext::~CommonLinkerContext() {
   // new in SpecificAlloc::create().
   for (auto &it : instances)
     it.second->~SpecificAllocBase();
+  for (auto &it : perThreadInstances) {
+    it.second->~SpecificAllocBase();
+    ::operator delete(it.second);
+  }
   lctx = nullptr;
 }
 
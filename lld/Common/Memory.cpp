@@ -23,3 +23,20 @@ lld::SpecificAllocBase::getOrCreate(void *tag, size_t size, size_t align,
   }
   return instance;
 }
+
+std::atomic<uint64_t> lld::SpecificAllocBase::generation{0};
+
+SpecificAllocBase *lld::SpecificAllocBase::getOrCreatePerThread(
+    void *tag, size_t size, size_t align,
+    SpecificAllocBase *(&creator)(void *)) {
+  CommonLinkerContext &ctx = context();
+  std::lock_guard<std::mutex> lock(ctx.perThreadMutex);
+  SpecificAllocBase *&instance = ctx.perThreadInstances[tag];
+  // bAlloc may be in use by the main thread, so allocate the storage
+  // separately. It is released in ~CommonLinkerContext().
+  if (instance == nullptr) {
+    assert(align <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+    instance = creator(::operator new(size));
+  }
+  return instance;
+}
@@ -8,29 +8,50 @@
 
 #include "lld/Common/Timer.h"
 #include "lld/Common/ErrorHandler.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/Support/Format.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/Process.h"
 #include <ratio>
 
 using namespace lld;
 using namespace llvm;
 
+// Returns the user and system CPU time consumed so far by all threads.
+static std::chrono::nanoseconds getCpuTime() {
+  llvm::sys::TimePoint<> now;
+  std::chrono::nanoseconds user, sys;
+  llvm::sys::Process::GetTimeUsage(now, user, sys);
+  return user + sys;
+}
+
 ScopedTimer::ScopedTimer(Timer &t) : t(&t) {
   startTime = std::chrono::high_resolution_clock::now();
+  if (t.isTrackingUsage()) {
+    startCpuTime = getCpuTime();
+    startPeakMemory = llvm::sys::Process::GetPeakMemoryUsage();
+  }
 }
 
 void ScopedTimer::stop() {
   if (!t)
     return;
   t->addToTotal(std::chrono::high_resolution_clock::now() - startTime);
+  if (t->isTrackingUsage()) {
+    t->addToCpuTotal(getCpuTime() - startCpuTime);
+    t->addToPeakMemoryGrowth(llvm::sys::Process::GetPeakMemoryUsage() -
+                             startPeakMemory);
+  }
   t = nullptr;
 }
 
 ScopedTimer::~ScopedTimer() { stop(); }
 
-Timer::Timer(llvm::StringRef name) : total(0), name(std::string(name)) {}
+Timer::Timer(llvm::StringRef name)
+    : total(0), cpuTotal(0), peakMemoryGrowth(0), name(std::string(name)) {}
 Timer::Timer(llvm::StringRef name, Timer &parent)
-    : total(0), name(std::string(name)) {
+    : total(0), cpuTotal(0), peakMemoryGrowth(0), name(std::string(name)) {
   parent.children.push_back(this);
 }
 
@@ -70,3 +91,29 @@ void Timer::print(int depth, double totalDuration, bool recurse) const {
         child->print(depth + 1, totalDuration);
   }
 }
+
+void Timer::enableUsageTracking() {
+  trackUsage = true;
+  for (Timer *child : children)
+    child->enableUsageTracking();
+}
+
+void Timer::writeJSON(json::OStream &os) const {
+  auto toMillis = [](std::chrono::nanoseconds::rep ns) {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::nanoseconds(ns))
+        .count();
+  };
+  os.object([&] {
+    os.attribute("name", name);
+    os.attribute("wall_ms", toMillis(total));
+    os.attribute("cpu_ms", toMillis(cpuTotal));
+    os.attribute("peak_rss_growth", int64_t(peakMemoryGrowth));
+    if (llvm::any_of(children, [](Timer *c) { return c->total > 0; }))
+      os.attributeArray("children", [&] {
+        for (const Timer *child : children)
+          if (child->total > 0)
+            child->writeJSON(os);
+      });
+  });
+}
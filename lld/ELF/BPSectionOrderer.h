@@ -24,11 +24,16 @@ class InputSectionBase;
 /// Run Balanced Partitioning to find the optimal function and data order to
 /// improve startup time and compressed size.
 ///
+/// The startup order is read from the temporal profile traces in profilePath
+/// and/or from startupTracePath, a text file listing symbol names in the order
+/// they were first executed.
+///
 /// It is important that -ffunction-sections and -fdata-sections compiler flags
 /// are used to ensure functions and data are in their own sections and thus
 /// can be reordered.
 llvm::DenseMap<const InputSectionBase *, int>
 runBalancedPartitioning(Ctx &ctx, llvm::StringRef profilePath,
+                        llvm::StringRef startupTracePath,
                         bool forFunctionCompression, bool forDataCompression,
                         bool compressionSortStartupFunctions, bool verbose);
 
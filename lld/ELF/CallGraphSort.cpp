@@ -28,6 +28,7 @@
 #include "InputSection.h"
 #include "Symbols.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Transforms/Utils/CodeLayout.h"
 
 #include <numeric>
@@ -189,6 +190,29 @@ static void mergeClusters(std::vector<Cluster> &cs, Cluster &into, int intoIdx,
   from.weight = 0;
 }
 
+// Print the symbols of the sections in the given order to
+// --print-symbol-order.
+static void printSymbolOrder(Ctx &ctx,
+                             ArrayRef<const InputSectionBase *> order) {
+  std::error_code ec;
+  raw_fd_ostream os(ctx.arg.printSymbolOrder, ec, sys::fs::OF_None);
+  if (ec) {
+    ErrAlways(ctx) << "cannot open " << ctx.arg.printSymbolOrder << ": "
+                   << ec.message();
+    return;
+  }
+
+  for (const InputSectionBase *sec : order) {
+    // Search all the symbols in the file of the section
+    // and find out a Defined symbol with name that is within the section.
+    for (Symbol *sym : sec->file->getSymbols())
+      if (!sym->isSection()) // Filter out section-type symbols here.
+        if (auto *d = dyn_cast<Defined>(sym))
+          if (sec == d->section)
+            os << sym->getName() << "\n";
+  }
+}
+
 // Group InputSections into clusters using the Call-Chain Clustering heuristic
 // then sort the clusters by density.
 DenseMap<const InputSectionBase *, int> CallGraphSort::run() {
@@ -245,34 +269,46 @@ DenseMap<const InputSectionBase *, int> CallGraphSort::run() {
     }
   }
   if (!ctx.arg.printSymbolOrder.empty()) {
-    std::error_code ec;
-    raw_fd_ostream os(ctx.arg.printSymbolOrder, ec, sys::fs::OF_None);
-    if (ec) {
-      ErrAlways(ctx) << "cannot open " << ctx.arg.printSymbolOrder << ": "
-                     << ec.message();
-      return orderMap;
-    }
-
-    // Print the symbols ordered by C3, in the order of increasing curOrder
     // Instead of sorting all the orderMap, just repeat the loops above.
+    SmallVector<const InputSectionBase *, 0> order;
     for (int leader : sorted)
       for (int i = leader;;) {
-        // Search all the symbols in the file of the section
-        // and find out a Defined symbol with name that is within the section.
-        for (Symbol *sym : sections[i]->file->getSymbols())
-          if (!sym->isSection()) // Filter out section-type symbols here.
-            if (auto *d = dyn_cast<Defined>(sym))
-              if (sections[i] == d->section)
-                os << sym->getName() << "\n";
+        order.push_back(sections[i]);
         i = clusters[i].next;
         if (i == leader)
           break;
       }
+    printSymbolOrder(ctx, order);
   }
 
   return orderMap;
 }
 
+// Returns the percentage of the call weight whose call site is less than
+// -z common-page-size away from its callee if the sections are laid out
+// contiguously in the given order.
+static double getPageLocalCallPercentage(
+    Ctx &ctx, ArrayRef<uint64_t> order, ArrayRef<uint64_t> funcSizes,
+    ArrayRef<codelayout::EdgeCount> callCounts,
+    ArrayRef<uint64_t> callOffsets) {
+  SmallVector<uint64_t, 0> addrs(funcSizes.size());
+  uint64_t addr = 0;
+  for (uint64_t idx : order) {
+    addrs[idx] = addr;
+    addr += funcSizes[idx];
+  }
+
+  uint64_t total = 0, local = 0;
+  for (auto [call, offset] : llvm::zip_equal(callCounts, callOffsets)) {
+    uint64_t from = addrs[call.src] + offset;
+    uint64_t to = addrs[call.dst];
+    total += call.count;
+    if ((from > to ? from - to : to - from) < ctx.arg.commonPageSize)
+      local += call.count;
+  }
+  return total ? 100.0 * local / total : 0.0;
+}
+
 // Sort sections by the profile data using the Cache-Directed Sort algorithm.
 // The placement is done by optimizing the locality by co-locating frequently
 // executed code sections together.
@@ -280,6 +316,7 @@ static DenseMap<const InputSectionBase *, int>
 computeCacheDirectedSortOrder(Ctx &ctx) {
   SmallVector<uint64_t, 0> funcSizes;
   SmallVector<uint64_t, 0> funcCounts;
+  SmallVector<uint64_t, 0> outCounts;
   SmallVector<codelayout::EdgeCount, 0> callCounts;
   SmallVector<uint64_t, 0> callOffsets;
   SmallVector<const InputSectionBase *, 0> sections;
@@ -292,6 +329,7 @@ computeCacheDirectedSortOrder(Ctx &ctx) {
       sections.push_back(inSec);
       funcSizes.push_back(inSec->getSize());
       funcCounts.push_back(0);
+      outCounts.push_back(0);
     }
     return res.first->second;
   };
@@ -320,18 +358,53 @@ computeCacheDirectedSortOrder(Ctx &ctx) {
     // data does not contain jump offsets.
     callOffsets.push_back((funcSizes[from] + 1) / 2);
     funcCounts[to] += weight;
+    outCounts[from] += weight;
   }
 
+  // The profile only contains calls, so the count of a section is inferred
+  // from its incoming and outgoing calls. Using the larger of the two keeps
+  // entry points and functions called from unprofiled code from looking cold.
+  for (size_t i = 0, e = funcCounts.size(); i != e; ++i)
+    funcCounts[i] = std::max(funcCounts[i], outCounts[i]);
+
   // Run the layout algorithm.
   std::vector<uint64_t> sortedSections = codelayout::computeCacheDirectedLayout(
       funcSizes, funcCounts, callCounts, callOffsets);
 
+  if (ctx.e.verbose) {
+    // Estimate the effect on i-TLB misses by comparing the share of calls
+    // that stay within a page with the unsorted order of input sections.
+    SmallVector<uint64_t, 0> inputOrder;
+    for (const InputSectionBase *sec : ctx.inputSections) {
+      auto it = secToTargetId.find(sec);
+      if (it != secToTargetId.end())
+        inputOrder.push_back(it->second);
+    }
+    if (inputOrder.size() == sections.size())
+      Log(ctx) << "--call-graph-profile-sort=cdsort: "
+               << format("%.1f%%", getPageLocalCallPercentage(
+                                       ctx, inputOrder, funcSizes, callCounts,
+                                       callOffsets))
+               << " of calls within a page before sorting, "
+               << format("%.1f%%", getPageLocalCallPercentage(
+                                       ctx, sortedSections, funcSizes,
+                                       callCounts, callOffsets))
+               << " after";
+  }
+
   // Create the final order.
   DenseMap<const InputSectionBase *, int> orderMap;
   int curOrder = -sortedSections.size();
   for (uint64_t secIdx : sortedSections)
     orderMap[sections[secIdx]] = curOrder++;
 
+  if (!ctx.arg.printSymbolOrder.empty()) {
+    SmallVector<const InputSectionBase *, 0> order;
+    for (uint64_t secIdx : sortedSections)
+      order.push_back(sections[secIdx]);
+    printSymbolOrder(ctx, order);
+  }
+
   return orderMap;
 }
 
@@ -11,6 +11,7 @@
 
 #include "lld/Common/CommonLinkerContext.h"
 #include "lld/Common/ErrorHandler.h"
+#include "lld/Common/Timer.h"
 #include "llvm/ADT/CachedHashString.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/MapVector.h"
@@ -205,6 +206,7 @@ struct Config {
   llvm::StringRef entry;
   llvm::StringRef emulation;
   llvm::StringRef fini;
+  llvm::StringRef incrementalDir;
   llvm::StringRef init;
   llvm::StringRef ltoAAPipeline;
   llvm::StringRef ltoCSProfileFile;
@@ -220,6 +222,7 @@ struct Config {
   llvm::StringRef optStatsFilename;
   llvm::StringRef progName;
   llvm::StringRef printArchiveStats;
+  llvm::StringRef printPhaseStats;
   llvm::StringRef printSymbolOrder;
   llvm::StringRef soName;
   llvm::StringRef sysroot;
@@ -270,6 +273,7 @@ struct Config {
   BsymbolicKind bsymbolic = BsymbolicKind::None;
   CGProfileSortKind callGraphProfileSort;
   llvm::StringRef irpgoProfilePath;
+  llvm::StringRef bpStartupTracePath;
   bool bpStartupFunctionSort = false;
   bool bpCompressionSortStartupFunctions = false;
   bool bpFunctionOrderForCompression = false;
@@ -350,6 +354,7 @@ struct Config {
   bool thinLTOEmitIndexFiles;
   bool thinLTOIndexOnly;
   bool timeTraceEnabled;
+  bool timeTraceSummaryOnly;
   bool tocOptimize;
   bool pcRelOptimize;
   bool undefinedVersion;
@@ -689,6 +694,22 @@ struct Ctx : CommonLinkerContext {
   // STT_SECTION symbol associated to the .toc input section.
   llvm::DenseSet<std::pair<const Symbol *, uint64_t>> ppc64noTocRelax;
 
+  // Timers reported by --print-phase-stats=.
+  Timer rootTimer;
+  Timer inputFileTimer;
+  Timer ltoTimer;
+  Timer gcTimer;
+  Timer icfTimer;
+  Timer finalizeTimer;
+  Timer scanRelocTimer;
+  Timer addressAssignTimer;
+  Timer compressTimer;
+  Timer writeTimer;
+  // The time spent parsing each input file. Only collected if
+  // --print-phase-stats= is specified.
+  SmallVector<std::pair<std::chrono::nanoseconds, const InputFile *>, 0>
+      inputFileParseTimes;
+
   Ctx();
 
   llvm::raw_fd_ostream openAuxiliaryFile(llvm::StringRef, std::error_code &);
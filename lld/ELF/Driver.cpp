@@ -28,6 +28,7 @@
 #include "InputFiles.h"
 #include "InputSection.h"
 #include "LTO.h"
+#include "LinkState.h"
 #include "LinkerScript.h"
 #include "MarkLive.h"
 #include "OutputSections.h"
@@ -59,6 +60,7 @@
 #include "llvm/Support/Compression.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/GlobPattern.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
@@ -98,7 +100,16 @@ ELFSyncStream elf::InternalErr(Ctx &ctx, const uint8_t *buf) {
   return s;
 }
 
-Ctx::Ctx() : driver(*this) {}
+Ctx::Ctx()
+    : driver(*this), rootTimer("Total Linking Time"),
+      inputFileTimer("Input File Reading", rootTimer),
+      ltoTimer("LTO", rootTimer), gcTimer("GC", rootTimer),
+      icfTimer("ICF", rootTimer),
+      finalizeTimer("Finalize Sections", rootTimer),
+      scanRelocTimer("Scan Relocations", finalizeTimer),
+      addressAssignTimer("Assign Addresses", finalizeTimer),
+      compressTimer("Compress Sections", rootTimer),
+      writeTimer("Write Output File", rootTimer) {}
 
 llvm::raw_fd_ostream Ctx::openAuxiliaryFile(llvm::StringRef filename,
                                             std::error_code &ec) {
@@ -594,6 +605,44 @@ constexpr const char *saveTempsValues[] = {
 
 LinkerDriver::LinkerDriver(Ctx &ctx) : ctx(ctx) {}
 
+// Handle --print-phase-stats=. The timers always measure wall time; CPU time
+// and peak memory are only measured when this option is given.
+static void writePhaseStats(Ctx &ctx) {
+  if (ctx.arg.printPhaseStats.empty())
+    return;
+
+  std::error_code ec;
+  raw_fd_ostream os = ctx.openAuxiliaryFile(ctx.arg.printPhaseStats, ec);
+  if (ec) {
+    ErrAlways(ctx) << "--print-phase-stats=: cannot open "
+                   << ctx.arg.printPhaseStats << ": " << ec.message();
+    return;
+  }
+
+  // Report the input files that took the longest to parse.
+  auto &times = ctx.inputFileParseTimes;
+  size_t n = std::min<size_t>(times.size(), 10);
+  std::partial_sort(times.begin(), times.begin() + n, times.end(),
+                    [](auto &a, auto &b) { return a.first > b.first; });
+
+  json::OStream j(os, 2);
+  j.object([&] {
+    j.attributeBegin("phases");
+    ctx.rootTimer.writeJSON(j);
+    j.attributeEnd();
+    j.attributeArray("slowest_input_files", [&] {
+      for (const auto &entry : ArrayRef(times).take_front(n))
+        j.object([&] {
+          std::chrono::duration<double, std::milli> ms = entry.first;
+          j.attribute("name", toStr(ctx, entry.second));
+          j.attribute("size", int64_t(entry.second->mb.getBufferSize()));
+          j.attribute("parse_ms", ms.count());
+        });
+    });
+  });
+  os << '\n';
+}
+
 void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
   ELFOptTable parser;
   opt::InputArgList args = parser.parse(ctx, argsArr.slice(1));
@@ -655,12 +704,25 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
   if (args.hasArg(OPT_version))
     return;
 
+  // With --incremental=, skip the link if the previous output is known to be
+  // identical to what we would produce.
+  if (!ctx.arg.incrementalDir.empty() && isLinkStateUpToDate(ctx, args)) {
+    Log(ctx) << "--incremental: " << ctx.arg.outputFile << " is up to date";
+    return;
+  }
+
   // Initialize time trace profiler.
   if (ctx.arg.timeTraceEnabled)
-    timeTraceProfilerInitialize(ctx.arg.timeTraceGranularity, ctx.arg.progName);
+    timeTraceProfilerInitialize(ctx.arg.timeTraceGranularity, ctx.arg.progName,
+                                /*TimeTraceVerbose=*/false,
+                                ctx.arg.timeTraceSummaryOnly);
+
+  if (!ctx.arg.printPhaseStats.empty())
+    ctx.rootTimer.enableUsageTracking();
 
   {
     llvm::TimeTraceScope timeScope("ExecuteLinker");
+    ScopedTimer t(ctx.rootTimer);
 
     initLLVM();
     createFiles(args);
@@ -676,6 +738,11 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
     invokeELFT(link, args);
   }
 
+  if (!ctx.arg.incrementalDir.empty() && !errCount(ctx))
+    writeLinkState(ctx, args);
+
+  writePhaseStats(ctx);
+
   if (ctx.arg.timeTraceEnabled) {
     checkError(ctx.e, timeTraceProfilerWrite(
                           args.getLastArgValue(OPT_time_trace_eq).str(),
@@ -1178,14 +1245,15 @@ static void parseBPOrdererOptions(Ctx &ctx, opt::InputArgList &args) {
   ctx.arg.bpVerboseSectionOrderer = args.hasArg(OPT_verbose_bp_section_orderer);
 
   ctx.arg.irpgoProfilePath = args.getLastArgValue(OPT_irpgo_profile);
-  if (ctx.arg.irpgoProfilePath.empty()) {
+  ctx.arg.bpStartupTracePath = args.getLastArgValue(OPT_bp_startup_trace);
+  if (ctx.arg.irpgoProfilePath.empty() && ctx.arg.bpStartupTracePath.empty()) {
     if (ctx.arg.bpStartupFunctionSort)
       ErrAlways(ctx) << "--bp-startup-sort=function must be used with "
-                        "--irpgo-profile";
+                        "--irpgo-profile or --bp-startup-trace";
     if (ctx.arg.bpCompressionSortStartupFunctions)
       ErrAlways(ctx)
           << "--bp-compression-sort-startup-functions must be used with "
-             "--irpgo-profile";
+             "--irpgo-profile or --bp-startup-trace";
   }
 }
 
@@ -1381,6 +1449,7 @@ static void readConfigs(Ctx &ctx, opt::InputArgList &args) {
       args.hasArg(OPT_ignore_data_address_equality);
   ctx.arg.ignoreFunctionAddressEquality =
       args.hasArg(OPT_ignore_function_address_equality);
+  ctx.arg.incrementalDir = args.getLastArgValue(OPT_incremental);
   ctx.arg.init = args.getLastArgValue(OPT_init, "_init");
   ctx.arg.ltoAAPipeline = args.getLastArgValue(OPT_lto_aa_pipeline);
   ctx.arg.ltoCSProfileGenerate = args.hasArg(OPT_lto_cs_profile_generate);
@@ -1456,6 +1525,7 @@ static void readConfigs(Ctx &ctx, opt::InputArgList &args) {
       args.hasFlag(OPT_print_gc_sections, OPT_no_print_gc_sections, false);
   ctx.arg.printMemoryUsage = args.hasArg(OPT_print_memory_usage);
   ctx.arg.printArchiveStats = args.getLastArgValue(OPT_print_archive_stats);
+  ctx.arg.printPhaseStats = args.getLastArgValue(OPT_print_phase_stats);
   ctx.arg.printSymbolOrder = args.getLastArgValue(OPT_print_symbol_order);
   ctx.arg.rejectMismatch = !args.hasArg(OPT_no_warn_mismatch);
   ctx.arg.relax = args.hasFlag(OPT_relax, OPT_no_relax, true);
@@ -1532,6 +1602,7 @@ static void readConfigs(Ctx &ctx, opt::InputArgList &args) {
       args.hasArg(OPT_time_trace_eq) && !ctx.e.disableOutput;
   ctx.arg.timeTraceGranularity =
       args::getInteger(args, OPT_time_trace_granularity, 500);
+  ctx.arg.timeTraceSummaryOnly = args.hasArg(OPT_time_trace_summary_only);
   ctx.arg.trace = args.hasArg(OPT_trace);
   ctx.arg.undefined = args::getStrings(args, OPT_undefined);
   ctx.arg.undefinedVersion =
@@ -1996,6 +2067,7 @@ static bool isFormatBinary(Ctx &ctx, StringRef s) {
 
 void LinkerDriver::createFiles(opt::InputArgList &args) {
   llvm::TimeTraceScope timeScope("Load input files");
+  ScopedTimer t(ctx.inputFileTimer);
   // For --{push,pop}-state.
   std::vector<std::tuple<bool, bool, bool>> stack;
 
@@ -2990,7 +3062,10 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
   for (StringRef name : ctx.arg.undefined)
     ctx.symtab->addUnusedUndefined(name)->referenced = true;
 
-  parseFiles(ctx, files);
+  {
+    ScopedTimer t(ctx.inputFileTimer);
+    parseFiles(ctx, files);
+  }
 
   // Create dynamic sections for dynamic linking and static PIE.
   ctx.hasDynsym = !ctx.sharedFiles.empty() || ctx.arg.isPic;
@@ -3125,7 +3200,10 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
   // except a few linker-synthesized ones will be added to the symbol table.
   const size_t numObjsBeforeLTO = ctx.objectFiles.size();
   const size_t numInputFilesBeforeLTO = ctx.driver.files.size();
-  compileBitcodeFiles<ELFT>(skipLinkedOutput);
+  {
+    ScopedTimer t(ctx.ltoTimer);
+    compileBitcodeFiles<ELFT>(skipLinkedOutput);
+  }
 
   // Symbol resolution finished. Report backward reference problems,
   // --print-archive-stats=, and --why-extract=.
@@ -3264,7 +3342,10 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
   splitSections<ELFT>(ctx);
 
   // Garbage collection and removal of shared symbols from unused shared objects.
-  markLive<ELFT>(ctx);
+  {
+    ScopedTimer t(ctx.gcTimer);
+    markLive<ELFT>(ctx);
+  }
 
   // Make copies of any input sections that need to be copied into each
   // partition.
@@ -3317,6 +3398,7 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
   // Two input sections with different output sections should not be folded.
   // ICF runs after processSectionCommands() so that we know the output sections.
   if (ctx.arg.icf != ICFLevel::None) {
+    ScopedTimer t(ctx.icfTimer);
     findKeepUniqueSections<ELFT>(ctx, args);
     doIcf<ELFT>(ctx);
   }
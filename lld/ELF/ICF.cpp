@@ -33,10 +33,12 @@
 // terminates are considered identical. Here are details:
 //
 // 1. First, we partition sections using their hash values as keys. Hash
-//    values contain section types, section contents and numbers of
-//    relocations. During this step, relocation targets are not taken into
-//    account. We just put sections that apparently differ into different
-//    equivalence classes.
+//    values contain section contents and the offsets and types of
+//    relocations, along with the addresses of relocation targets that are
+//    known not to move relative to their sections. Equivalence classes of
+//    relocation targets are not taken into account. We just put sections that
+//    apparently differ into different equivalence classes. Sections that end
+//    up in a class of their own are dropped from the following steps.
 //
 // 2. Next, for each equivalence class, we visit sections to compare
 //    relocation targets. Relocation targets are considered equivalent if
@@ -82,6 +84,7 @@
 #include "SyntheticSections.h"
 #include "llvm/BinaryFormat/ELF.h"
 #include "llvm/Object/ELF.h"
+#include "llvm/Support/Endian.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/xxhash.h"
@@ -414,6 +417,7 @@ void ICF<ELFT>::forEachClass(llvm::function_ref<void(size_t, size_t)> fn) {
   // If threading is disabled or the number of sections are
   // too small to use threading, call Fn sequentially.
   if (parallel::strategy.ThreadsRequested == 1 || sections.size() < 1024) {
+    current = next = 0;
     forEachClassRange(0, sections.size(), fn);
     ++cnt;
     return;
@@ -459,6 +463,29 @@ static void combineRelocHashes(unsigned cnt, InputSection *isec,
   isec->eqClass[(cnt + 1) % 2] = hash | (1U << 31);
 }
 
+// Hash the parts of relocations compared by constantEq: offsets, types, and
+// the offsets of targets that are regular input sections or absolute. The
+// result must be equal for sections that are equal in terms of constantEq.
+template <class ELFT, class RelTy>
+static uint64_t hashRelocs(Ctx &ctx, InputSection *isec, Relocs<RelTy> rels) {
+  if (rels.size() == 0)
+    return 0;
+  SmallVector<uint8_t, 0> buf;
+  buf.resize_for_overwrite(rels.size() * 24);
+  uint8_t *p = buf.data();
+  for (RelTy rel : rels) {
+    uint64_t val = 0;
+    if (auto *d = dyn_cast<Defined>(&isec->file->getRelocTargetSym(rel)))
+      if (!d->section || isa<InputSection>(d->section))
+        val = d->value + getAddend<ELFT>(rel);
+    support::endian::write64le(p, rel.r_offset);
+    support::endian::write64le(p + 8, rel.getType(ctx.arg.isMips64EL));
+    support::endian::write64le(p + 16, val);
+    p += 24;
+  }
+  return xxh3_64bits(buf);
+}
+
 // The main function of ICF.
 template <class ELFT> void ICF<ELFT>::run() {
   // Two text sections may have identical content and relocations but different
@@ -489,8 +516,16 @@ template <class ELFT> void ICF<ELFT>::run() {
 
   // Initially, we use hash values to partition sections.
   parallelForEach(sections, [&](InputSection *s) {
+    const RelsOrRelas<ELFT> rels = s->template relsOrRelas<ELFT>();
+    uint64_t relHash;
+    if (rels.areRelocsCrel())
+      relHash = hashRelocs<ELFT>(ctx, s, rels.crels);
+    else if (rels.areRelocsRel())
+      relHash = hashRelocs<ELFT>(ctx, s, rels.rels);
+    else
+      relHash = hashRelocs<ELFT>(ctx, s, rels.relas);
     // Set MSB to 1 to avoid collisions with unique IDs.
-    s->eqClass[0] = xxh3_64bits(s->content()) | (1U << 31);
+    s->eqClass[0] = (xxh3_64bits(s->content()) ^ relHash) | (1U << 31);
   });
 
   // Perform 2 rounds of relocation hash propagation. 2 is an empirical value to
@@ -522,6 +557,29 @@ template <class ELFT> void ICF<ELFT>::run() {
     segregate(begin, end, eqClassBase, true);
   });
 
+  // A section that is not constant-equal to any other section is never
+  // folded. Usually most sections are like that, so remove them to avoid
+  // visiting them again in every iteration below. They may still be read as
+  // relocation targets by variableEq, so have both slots hold their final
+  // class, and use a new base for later IDs so that they remain unique.
+  {
+    const size_t n = sections.size();
+    auto clsOf = [&](size_t i) { return sections[i]->eqClass[next]; };
+    SmallVector<InputSection *, 0> remaining;
+    for (size_t i = 0; i != n; ++i) {
+      if ((i != 0 && clsOf(i - 1) == clsOf(i)) ||
+          (i + 1 != n && clsOf(i + 1) == clsOf(i)))
+        remaining.push_back(sections[i]);
+    }
+    // forEachClass may switch to the serial mode, which only uses slot 0.
+    for (InputSection *s : sections)
+      s->eqClass[0] = s->eqClass[1] = s->eqClass[next];
+    Log(ctx) << "ICF: " << remaining.size() << " of " << n
+             << " sections remain after comparing contents";
+    sections = std::move(remaining);
+    eqClassBase += n + 1;
+  }
+
   // Split groups by comparing relocations until convergence is obtained.
   do {
     repeat = false;
@@ -26,6 +26,7 @@
 #include "llvm/Support/ARMBuildAttributes.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/RISCVAttributeParser.h"
 #include "llvm/Support/TimeProfiler.h"
@@ -258,7 +259,12 @@ std::optional<MemoryBufferRef> elf::readFile(Ctx &ctx, StringRef path) {
     return std::nullopt;
   }
 
+  // Start reading mapped inputs in the background, so that the page faults
+  // taken while parsing them in parallel hit the page cache. Archive members
+  // are only read if they are extracted, so don't prefetch archives.
   MemoryBufferRef mbref = (*mbOrErr)->getMemBufferRef();
+  if (!mbref.getBuffer().starts_with("!<arch>\n"))
+    (*mbOrErr)->willNeedIfMmap();
   ctx.memoryBuffers.push_back(std::move(*mbOrErr)); // take MB ownership
 
   if (ctx.tar)
@@ -352,9 +358,29 @@ doParseFiles(Ctx &ctx,
   // Add all files to the symbol table. This will add almost all symbols that we
   // need to the symbol table. This process might add files to the link due to
   // addDependentLibrary.
-  for (size_t i = 0; i < files.size(); ++i) {
-    llvm::TimeTraceScope timeScope("Parse input files", files[i]->getName());
-    doParseFile<ELFT>(ctx, files[i].get());
+  //
+  // Symbol resolution must process files in command line order, but reading
+  // and hashing symbol names does not depend on other files. Do the latter in
+  // parallel for a batch of files at a time, which bounds the memory used by
+  // the precomputed names.
+  for (size_t i = 0; i < files.size();) {
+    size_t end = std::min<size_t>(files.size(), i + 1024);
+    parallelFor(i, end, [&](size_t j) {
+      InputFile *f = files[j].get();
+      if (f->kind() == InputFile::ObjKind && f->ekind == ctx.arg.ekind)
+        cast<ObjFile<ELFT>>(f)->prepareGlobalNames();
+    });
+    for (; i != end; ++i) {
+      llvm::TimeTraceScope timeScope("Parse input files", files[i]->getName());
+      if (ctx.arg.printPhaseStats.empty()) {
+        doParseFile<ELFT>(ctx, files[i].get());
+        continue;
+      }
+      auto start = std::chrono::steady_clock::now();
+      doParseFile<ELFT>(ctx, files[i].get());
+      ctx.inputFileParseTimes.emplace_back(
+          std::chrono::steady_clock::now() - start, files[i].get());
+    }
   }
   if (ctx.driver.armCmseImpLib)
     cast<ObjFile<ELFT>>(*ctx.driver.armCmseImpLib).importCmseSymbols();
@@ -1130,9 +1156,19 @@ void ObjFile<ELFT>::initializeSymbols(const object::ELFFile<ELFT> &obj) {
 
   // Some entries have been filled by LazyObjFile.
   auto *symtab = ctx.symtab.get();
-  for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
-    if (!symbols[i])
-      symbols[i] = symtab->insert(CHECK2(eSyms[i].getName(stringTable), this));
+  if (globalNames) {
+    for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
+      if (!symbols[i]) {
+        auto [name, hash] = globalNames[i - firstGlobal];
+        symbols[i] = symtab->insert(name, hash);
+      }
+    globalNames.reset();
+  } else {
+    for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
+      if (!symbols[i])
+        symbols[i] =
+            symtab->insert(CHECK2(eSyms[i].getName(stringTable), this));
+  }
 
   // Perform symbol resolution on non-local symbols.
   SmallVector<unsigned, 32> undefineds;
@@ -1954,11 +1990,35 @@ template <class ELFT> void ObjFile<ELFT>::parseLazy() {
   for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
     if (eSyms[i].st_shndx == SHN_UNDEF)
       continue;
-    symbols[i] = symtab->insert(CHECK2(eSyms[i].getName(stringTable), this));
+    if (globalNames) {
+      auto [name, hash] = globalNames[i - firstGlobal];
+      symbols[i] = symtab->insert(name, hash);
+    } else {
+      symbols[i] = symtab->insert(CHECK2(eSyms[i].getName(stringTable), this));
+    }
     symbols[i]->resolve(ctx, LazySymbol{*this});
     if (!lazy)
       break;
   }
+  globalNames.reset();
+}
+
+template <class ELFT> void ObjFile<ELFT>::prepareGlobalNames() {
+  ArrayRef<Elf_Sym> eSyms = this->getELFSyms<ELFT>();
+  if (firstGlobal >= eSyms.size())
+    return;
+  auto names = std::make_unique<std::pair<StringRef, uint32_t>[]>(
+      eSyms.size() - firstGlobal);
+  for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
+    Expected<StringRef> name = eSyms[i].getName(stringTable);
+    // Leave the error to be reported by the serial path.
+    if (!name) {
+      consumeError(name.takeError());
+      return;
+    }
+    names[i - firstGlobal] = {*name, SymbolTable::hashName(*name)};
+  }
+  globalNames = std::move(names);
 }
 
 bool InputFile::shouldExtractForCommon(StringRef name) const {
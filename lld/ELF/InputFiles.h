@@ -263,6 +263,11 @@ public:
   void parse(bool ignoreComdats = false);
   void parseLazy();
 
+  // Read the names of global symbols and compute their hash values in
+  // advance. This is thread-safe and is called in parallel before parse() or
+  // parseLazy(), which then only need to do the symbol table lookups.
+  void prepareGlobalNames();
+
   StringRef getShtGroupSignature(ArrayRef<Elf_Shdr> sections,
                                  const Elf_Shdr &sec);
 
@@ -319,6 +324,10 @@ private:
   // The following variable contains the contents of .symtab_shndx.
   // If the section does not exist (which is common), the array is empty.
   ArrayRef<Elf_Word> shndxTable;
+
+  // Names and SymbolTable::hashName values of global symbols, filled by
+  // prepareGlobalNames() and released once the symbols are inserted.
+  std::unique_ptr<std::pair<StringRef, uint32_t>[]> globalNames;
 };
 
 class BitcodeFile : public InputFile {
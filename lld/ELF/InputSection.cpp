@@ -1462,9 +1462,18 @@ void MergeInputSection::splitNonStrings(ArrayRef<uint8_t> data,
   assert((size % entSize) == 0);
   const bool live = !(flags & SHF_ALLOC) || !getCtx().arg.gcSections;
 
-  pieces.resize_for_overwrite(size / entSize);
-  for (size_t i = 0, j = 0; i != size; i += entSize, j++)
-    pieces[j] = {i, (uint32_t)xxh3_64bits(data.slice(i, entSize)), live};
+  size_t n = size / entSize;
+  pieces.resize_for_overwrite(n);
+  // Hash the records in batches, which is faster than hashing them one by
+  // one when they are as small as they typically are (4 to 16 bytes).
+  uint64_t hashes[256];
+  for (size_t j = 0; j != n;) {
+    size_t num = std::min<size_t>(n - j, std::size(hashes));
+    xxh3_64bits_records(data.slice(j * entSize, num * entSize), entSize,
+                        MutableArrayRef(hashes, num));
+    for (size_t k = 0; k != num; ++k, ++j)
+      pieces[j] = {j * entSize, (uint32_t)hashes[k], live};
+  }
 }
 
 template <class ELFT>
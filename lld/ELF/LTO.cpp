@@ -145,6 +145,7 @@ static lto::Config createConfig(Ctx &ctx) {
 
   c.TimeTraceEnabled = ctx.arg.timeTraceEnabled;
   c.TimeTraceGranularity = ctx.arg.timeTraceGranularity;
+  c.TimeTraceSummaryOnly = ctx.arg.timeTraceSummaryOnly;
 
   c.CSIRProfile = std::string(ctx.arg.ltoCSProfileFile);
   c.RunCSIRInstr = ctx.arg.ltoCSProfileGenerate;
@@ -0,0 +1,258 @@
+//===- LinkState.cpp ------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the --incremental=<dir> option. After a successful
+// link, we save a small state file to <dir> that records a hash of the command
+// line, the size and content hash of every file the link read, the
+// modification time of every library search directory, and the size and
+// modification time of the output. On the next link with the same output, if
+// the command line and every input are unchanged, no file was added to or
+// removed from a search directory, and the output has not been touched, the
+// output is already what we would produce, so the link is skipped.
+//
+// This is common in edit-compile-debug cycles in which a rebuild of an object
+// file yields bytes identical to the previous build (e.g. a comment or an
+// unrelated header changed, or the object came from a compiler cache), but the
+// build system re-runs the link because the object's timestamp changed.
+//
+// When any input differs, we fall back to a full link and overwrite the state.
+// Links that write anything besides the output file, such as a map file or a
+// dependency file, are never skipped.
+//
+//===----------------------------------------------------------------------===//
+
+#include "LinkState.h"
+#include "Config.h"
+#include "Driver.h"
+#include "lld/Common/Version.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Option/ArgList.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+using namespace llvm;
+using namespace lld;
+using namespace lld::elf;
+
+static constexpr char stateMagic[] = "lld-link-state 2";
+
+static std::string getStatePath(Ctx &ctx) {
+  SmallString<128> out(ctx.arg.outputFile);
+  sys::fs::make_absolute(out);
+  SmallString<128> path(ctx.arg.incrementalDir);
+  sys::path::append(path, "link-" + utohexstr(xxh3_64bits(out)) + ".state");
+  return std::string(path);
+}
+
+// Hash everything other than input file contents that may affect the output.
+static uint64_t getArgsHash(opt::InputArgList &args) {
+  std::string s = getLLDVersion();
+  SmallString<128> cwd;
+  if (!sys::fs::current_path(cwd))
+    s += cwd;
+  for (const opt::Arg *arg : args) {
+    s += '\0';
+    s += arg->getAsString(args);
+  }
+  return xxh3_64bits(s);
+}
+
+static std::optional<std::pair<uint64_t, uint64_t>>
+getOutputStamp(StringRef path) {
+  sys::fs::file_status st;
+  if (sys::fs::status(path, st) || !sys::fs::is_regular_file(st))
+    return std::nullopt;
+  return std::make_pair(
+      st.getSize(),
+      uint64_t(st.getLastModificationTime().time_since_epoch().count()));
+}
+
+// Returns the modification time of a library search directory, which changes
+// whenever a file is added to or removed from it, or "-" if it does not exist.
+static std::string getDirStamp(StringRef path) {
+  sys::fs::file_status st;
+  if (sys::fs::status(path, st) || !sys::fs::is_directory(st))
+    return "-";
+  return utostr(st.getLastModificationTime().time_since_epoch().count());
+}
+
+// Returns the search directories of the link, with "=" replaced by the
+// sysroot as done by findFile().
+static SmallVector<std::string, 0> getSearchDirs(Ctx &ctx) {
+  SmallVector<std::string, 0> dirs;
+  for (StringRef dir : ctx.arg.searchPaths) {
+    SmallString<128> s;
+    if (dir.starts_with("="))
+      sys::path::append(s, ctx.arg.sysroot, dir.substr(1));
+    else
+      s = dir;
+    dirs.push_back(std::string(s));
+  }
+  return dirs;
+}
+
+// Returns the name of an option that makes the link write something besides
+// the output file, or an empty string if there is none. Such links always
+// run, because skipping them would leave those outputs stale or missing.
+static StringRef getSideOutputOption(Ctx &ctx, opt::InputArgList &args) {
+  if (!ctx.arg.mapFile.empty())
+    return "--Map";
+  if (!ctx.arg.whyExtract.empty())
+    return "--why-extract";
+  if (!ctx.arg.dependencyFile.empty())
+    return "--dependency-file";
+  if (!ctx.arg.printArchiveStats.empty())
+    return "--print-archive-stats";
+  if (!ctx.arg.printSymbolOrder.empty())
+    return "--print-symbol-order";
+  if (!ctx.arg.optRemarksFilename.empty())
+    return "--opt-remarks-filename";
+  if (!ctx.arg.ltoObjPath.empty())
+    return "--lto-obj-path";
+  if (!ctx.arg.saveTempsArgs.empty())
+    return "--save-temps";
+  if (ctx.arg.thinLTOIndexOnly)
+    return "--thinlto-index-only";
+  if (ctx.arg.timeTraceEnabled)
+    return "--time-trace";
+  if (ctx.arg.cref)
+    return "--cref";
+  if (ctx.arg.printGcSections)
+    return "--print-gc-sections";
+  if (ctx.arg.printIcfSections)
+    return "--print-icf-sections";
+  if (ctx.arg.printMemoryUsage)
+    return "--print-memory-usage";
+  if (ctx.arg.trace || args.hasArg(OPT_trace_symbol))
+    return "--trace";
+  return "";
+}
+
+static bool isInputUpToDate(StringRef size, StringRef hash, StringRef path) {
+  uint64_t oldSize, newSize;
+  if (size.getAsInteger(10, oldSize) || sys::fs::file_size(path, newSize) ||
+      oldSize != newSize)
+    return false;
+  auto inOrErr = MemoryBuffer::getFile(path, /*IsText=*/false,
+                                       /*RequiresNullTerminator=*/false);
+  return inOrErr && hash == utohexstr(xxh3_64bits((*inOrErr)->getBuffer()));
+}
+
+bool elf::isLinkStateUpToDate(Ctx &ctx, opt::InputArgList &args) {
+  if (ctx.arg.outputFile == "-" || ctx.tar)
+    return false;
+  StringRef sideOutput = getSideOutputOption(ctx, args);
+  if (!sideOutput.empty()) {
+    Log(ctx) << "--incremental: not skipping the link because of "
+             << sideOutput;
+    return false;
+  }
+  llvm::TimeTraceScope timeScope("Check link state");
+
+  auto mbOrErr = MemoryBuffer::getFile(getStatePath(ctx), /*IsText=*/true);
+  if (!mbOrErr)
+    return false;
+
+  SmallVector<StringRef, 0> lines;
+  (*mbOrErr)->getBuffer().split(lines, '\n', -1, /*KeepEmpty=*/false);
+  if (lines.size() < 3 || lines[0] != stateMagic)
+    return false;
+
+  // args <hash>
+  if (lines[1] != "args " + utohexstr(getArgsHash(args)))
+    return false;
+
+  // output <size> <mtime>
+  auto stamp = getOutputStamp(ctx.arg.outputFile);
+  if (!stamp || lines[2] != ("output " + Twine(stamp->first) + " " +
+                             Twine(stamp->second))
+                                .str())
+    return false;
+
+  // dir <mtime> <path>
+  // input <size> <hash> <path>
+  for (StringRef line : ArrayRef(lines).drop_front(3)) {
+    StringRef kind, path;
+    std::tie(kind, line) = line.split(' ');
+    if (kind == "dir") {
+      StringRef stamp;
+      std::tie(stamp, path) = line.split(' ');
+      if (path.empty())
+        return false;
+      if (stamp != getDirStamp(path)) {
+        Log(ctx) << "--incremental: search directory " << path << " changed";
+        return false;
+      }
+      continue;
+    }
+
+    StringRef size, hash;
+    std::tie(size, line) = line.split(' ');
+    std::tie(hash, path) = line.split(' ');
+    if (kind != "input" || path.empty())
+      return false;
+    if (!isInputUpToDate(size, hash, path)) {
+      Log(ctx) << "--incremental: " << path << " changed";
+      return false;
+    }
+  }
+  return true;
+}
+
+void elf::writeLinkState(Ctx &ctx, opt::InputArgList &args) {
+  if (ctx.arg.outputFile == "-" || ctx.tar)
+    return;
+  llvm::TimeTraceScope timeScope("Write link state");
+
+  // The output may be missing, e.g. for --thinlto-index-only. Don't save a
+  // state in that case.
+  auto stamp = getOutputStamp(ctx.arg.outputFile);
+  if (!stamp)
+    return;
+
+  if (std::error_code ec = sys::fs::create_directories(ctx.arg.incrementalDir)) {
+    Warn(ctx) << "--incremental: cannot create " << ctx.arg.incrementalDir
+              << ": " << ec.message();
+    return;
+  }
+
+  std::string path = getStatePath(ctx);
+  Error e = writeToOutput(path, [&](raw_ostream &os) -> Error {
+    os << stateMagic << '\n';
+    os << "args " << utohexstr(getArgsHash(args)) << '\n';
+    os << "output " << stamp->first << ' ' << stamp->second << '\n';
+    for (const std::string &dir : getSearchDirs(ctx))
+      os << "dir " << getDirStamp(dir) << ' ' << dir << '\n';
+    auto writeInput = [&](MemoryBufferRef mb) {
+      os << "input " << mb.getBufferSize() << ' '
+         << utohexstr(xxh3_64bits(mb.getBuffer())) << ' '
+         << mb.getBufferIdentifier() << '\n';
+    };
+    for (const std::unique_ptr<MemoryBuffer> &mb : ctx.memoryBuffers)
+      writeInput(mb->getMemBufferRef());
+    // LTO reads the profiles by itself rather than through readFile().
+    for (StringRef profile :
+         {ctx.arg.ltoSampleProfile, ctx.arg.ltoCSProfileFile}) {
+      if (profile.empty())
+        continue;
+      auto mbOrErr = MemoryBuffer::getFile(profile, /*IsText=*/false,
+                                           /*RequiresNullTerminator=*/false);
+      if (!mbOrErr)
+        return errorCodeToError(mbOrErr.getError());
+      writeInput((*mbOrErr)->getMemBufferRef());
+    }
+    return Error::success();
+  });
+  if (e)
+    Warn(ctx) << "--incremental: cannot write " << path << ": "
+              << std::move(e);
+}
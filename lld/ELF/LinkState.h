@@ -0,0 +1,28 @@
+//===- LinkState.h ----------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLD_ELF_LINKSTATE_H
+#define LLD_ELF_LINKSTATE_H
+
+namespace llvm::opt {
+class InputArgList;
+}
+
+namespace lld::elf {
+struct Ctx;
+
+// Returns true if the link state saved by a previous --incremental= link
+// proves that the existing output file is identical to what this link would
+// produce, in which case the link can be skipped.
+bool isLinkStateUpToDate(Ctx &, llvm::opt::InputArgList &args);
+
+// Saves the link state for --incremental= after a successful link.
+void writeLinkState(Ctx &, llvm::opt::InputArgList &args);
+} // namespace lld::elf
+
+#endif
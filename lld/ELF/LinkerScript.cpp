@@ -1242,9 +1242,31 @@ bool LinkerScript::assignOffsets(OutputSection *sec) {
     // Handle a single input section description command.
     // It calculates and assigns the offsets for each section and also
     // updates the output section size.
+    auto *isd = cast<InputSectionDescription>(cmd);
+    auto &sections = isd->sections;
+    size_t i = 0;
+
+    // The input sections' alignments do not exceed sec->addralign, so if sec
+    // is aligned, the offsets of the leading non-synthetic sections only
+    // depend on where the description starts. During thunk creation, later
+    // passes typically only add or grow thunks, so reuse the layout of the
+    // previous pass for the unchanged prefix if the start is the same and no
+    // section has been inserted before its end.
+    const uint64_t begin = dot - sec->addr;
+    const bool aligned = sec->addr % sec->addralign == 0;
+    if (reuseStableLayout && aligned && isd->stableCount &&
+        isd->stableBegin == begin && isd->stableCount <= sections.size() &&
+        sections[isd->stableCount - 1] == isd->stableLast) {
+      i = isd->stableCount;
+      dot = sec->addr + isd->stableEnd;
+      expandOutputSection(isd->stableEnd - begin);
+    } else {
+      isd->stableCount = 0;
+      isd->stableBegin = begin;
+    }
 
-    auto &sections = cast<InputSectionDescription>(cmd)->sections;
-    for (InputSection *isec : sections) {
+    for (size_t e = sections.size(); i != e; ++i) {
+      InputSection *isec = sections[i];
       assert(isec->getParent() == sec);
       if (isa<PotentialSpillSection>(isec))
         continue;
@@ -1257,6 +1279,12 @@ bool LinkerScript::assignOffsets(OutputSection *sec) {
       // SIZEOF works correctly in the case below:
       // .foo { *(.aaa) a = SIZEOF(.foo); *(.bbb) }
       expandOutputSection(dot - pos);
+
+      if (aligned && isd->stableCount == i && !isa<SyntheticSection>(isec)) {
+        isd->stableLast = isec;
+        isd->stableCount = i + 1;
+        isd->stableEnd = dot - sec->addr;
+      }
     }
   }
 
@@ -250,6 +250,16 @@ public:
   // into Sections at the end of a createThunks() pass.
   SmallVector<std::pair<ThunkSection *, uint32_t>, 0> thunkSections;
 
+  // The layout of the leading sections that are neither synthetic nor
+  // potential spills, as computed by the last assignOffsets() pass:
+  // sections[0, stableCount) were laid out from offset stableBegin to
+  // stableEnd within the output section. See
+  // LinkerScript::reuseStableLayout.
+  InputSection *stableLast = nullptr;
+  uint32_t stableCount = 0;
+  uint64_t stableBegin = 0;
+  uint64_t stableEnd = 0;
+
   // SectionPatterns can be filtered with the INPUT_SECTION_FLAGS command.
   uint64_t withFlags;
   uint64_t withoutFlags;
@@ -420,6 +430,12 @@ public:
   bool seenDataAlign = false;
   bool seenRelroEnd = false;
   bool errorOnMissingSection = false;
+  // If true, assignOffsets() may reuse the offsets of the stable leading input
+  // sections of an InputSectionDescription computed by the previous pass. The
+  // caller guarantees that since that pass, input sections have only been
+  // inserted (e.g. thunks), not removed or reordered, and that the sizes of
+  // non-synthetic input sections have not changed.
+  bool reuseStableLayout = false;
   SmallVector<SmallString<0>, 0> recordedErrors;
 
   // List of section patterns specified with KEEP commands. They will
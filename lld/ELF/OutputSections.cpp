@@ -367,117 +367,216 @@ static SmallVector<uint8_t, 0> deflateShard(Ctx &ctx, ArrayRef<uint8_t> in,
 //
 // * (if --compress-debug-sections is specified) non-empty .debug_* sections
 // * (if --compress-sections is specified) matched sections
-template <class ELFT> void OutputSection::maybeCompress(Ctx &ctx) {
-  using Elf_Chdr = typename ELFT::Chdr;
-  (void)sizeof(Elf_Chdr);
+namespace {
+// An output section being compressed by compressSections.
+struct CompressJob {
+  OutputSection *osec;
+  DebugCompressionType ctype;
+  int level;
+  std::unique_ptr<uint8_t[]> buf;
+  std::vector<ArrayRef<uint8_t>> shardsIn;
+  std::unique_ptr<SmallVector<uint8_t, 0>[]> shardsOut;
+  std::unique_ptr<uint32_t[]> shardsAdler;
+};
+
+// Compression contexts indexed by parallel::getThreadIndex(). Reusing a context
+// for all shards compressed by a thread avoids reallocating the zstd state,
+// which is several MiB at higher levels, for every 1-MiB shard.
+struct CompressContexts {
+#if LLVM_ENABLE_ZSTD
+  SmallVector<ZSTD_CCtx *, 0> zstd;
+
+  CompressContexts() : zstd(parallel::getThreadCount()) {}
+  ~CompressContexts() {
+    for (ZSTD_CCtx *cctx : zstd)
+      ZSTD_freeCCtx(cctx);
+  }
+
+  ZSTD_CCtx *getZstd(int level) {
+    ZSTD_CCtx *&cctx = zstd[parallel::getThreadIndex()];
+    if (cctx)
+      ZSTD_CCtx_reset(cctx, ZSTD_reset_session_and_parameters);
+    else
+      cctx = ZSTD_createCCtx();
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level);
+    return cctx;
+  }
+#endif
+};
+} // namespace
 
+static std::pair<DebugCompressionType, int>
+getCompressionType(Ctx &ctx, OutputSection &osec) {
   DebugCompressionType ctype = DebugCompressionType::None;
-  size_t compressedSize = sizeof(Elf_Chdr);
   unsigned level = 0; // default compression level
-  if (!(flags & SHF_ALLOC) && ctx.arg.compressDebugSections &&
-      name.starts_with(".debug_"))
+  if (!(osec.flags & SHF_ALLOC) && ctx.arg.compressDebugSections &&
+      osec.name.starts_with(".debug_"))
     ctype = *ctx.arg.compressDebugSections;
   for (auto &[glob, t, l] : ctx.arg.compressSections)
-    if (glob.match(name))
+    if (glob.match(osec.name))
       std::tie(ctype, level) = {t, l};
-  if (ctype == DebugCompressionType::None)
-    return;
-  if (flags & SHF_ALLOC) {
-    Err(ctx) << "--compress-sections: section '" << name
+  if (ctype != DebugCompressionType::None && (osec.flags & SHF_ALLOC)) {
+    Err(ctx) << "--compress-sections: section '" << osec.name
              << "' with the SHF_ALLOC flag cannot be compressed";
-    return;
-  }
-
-  llvm::TimeTraceScope timeScope("Compress sections");
-  auto buf = std::make_unique<uint8_t[]>(size);
-  // Write uncompressed data to a temporary zero-initialized buffer.
-  {
-    parallel::TaskGroup tg;
-    writeTo<ELFT>(ctx, buf.get(), tg);
+    ctype = DebugCompressionType::None;
   }
-  // The generic ABI specifies "The sh_size and sh_addralign fields of the
-  // section header for a compressed section reflect the requirements of the
-  // compressed section." However, 1-byte alignment has been wildly accepted
-  // and utilized for a long time. Removing alignment padding is particularly
-  // useful when there are many compressed output sections.
-  addralign = 1;
-
-  // Split input into 1-MiB shards.
-  [[maybe_unused]] constexpr size_t shardSize = 1 << 20;
-  auto shardsIn = split(ArrayRef<uint8_t>(buf.get(), size), shardSize);
-  const size_t numShards = shardsIn.size();
-  auto shardsOut = std::make_unique<SmallVector<uint8_t, 0>[]>(numShards);
+#if LLVM_ENABLE_ZLIB
+  // We chose 1 (Z_BEST_SPEED) as the default compression level because it is
+  // fast and provides decent compression ratios.
+  if (ctype == DebugCompressionType::Zlib && !level)
+    level = Z_BEST_SPEED;
+#endif
+  return {ctype, level};
+}
 
+static void compressShard(Ctx &ctx, CompressContexts &contexts,
+                          CompressJob &job, size_t i) {
+  ArrayRef<uint8_t> in = job.shardsIn[i];
 #if LLVM_ENABLE_ZSTD
   // Use ZSTD's streaming compression API. See
   // http://facebook.github.io/zstd/zstd_manual.html "Streaming compression -
   // HowTo".
-  if (ctype == DebugCompressionType::Zstd) {
-    parallelFor(0, numShards, [&](size_t i) {
-      SmallVector<uint8_t, 0> out;
-      ZSTD_CCtx *cctx = ZSTD_createCCtx();
-      ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level);
-      ZSTD_inBuffer zib = {shardsIn[i].data(), shardsIn[i].size(), 0};
-      ZSTD_outBuffer zob = {nullptr, 0, 0};
-      size_t size;
-      do {
-        // Allocate a buffer of half of the input size, and grow it by 1.5x if
-        // insufficient.
-        if (zob.pos == zob.size) {
-          out.resize_for_overwrite(
-              zob.size ? zob.size * 3 / 2 : std::max<size_t>(zib.size / 4, 64));
-          zob = {out.data(), out.size(), zob.pos};
-        }
-        size = ZSTD_compressStream2(cctx, &zob, &zib, ZSTD_e_end);
-        assert(!ZSTD_isError(size));
-      } while (size != 0);
-      out.truncate(zob.pos);
-      ZSTD_freeCCtx(cctx);
-      shardsOut[i] = std::move(out);
-    });
-    compressed.type = ELFCOMPRESS_ZSTD;
-    for (size_t i = 0; i != numShards; ++i)
-      compressedSize += shardsOut[i].size();
+  if (job.ctype == DebugCompressionType::Zstd) {
+    SmallVector<uint8_t, 0> out;
+    ZSTD_CCtx *cctx = contexts.getZstd(job.level);
+    ZSTD_inBuffer zib = {in.data(), in.size(), 0};
+    ZSTD_outBuffer zob = {nullptr, 0, 0};
+    size_t size;
+    do {
+      // Allocate a buffer of half of the input size, and grow it by 1.5x if
+      // insufficient.
+      if (zob.pos == zob.size) {
+        out.resize_for_overwrite(
+            zob.size ? zob.size * 3 / 2 : std::max<size_t>(zib.size / 4, 64));
+        zob = {out.data(), out.size(), zob.pos};
+      }
+      size = ZSTD_compressStream2(cctx, &zob, &zib, ZSTD_e_end);
+      assert(!ZSTD_isError(size));
+    } while (size != 0);
+    out.truncate(zob.pos);
+    job.shardsOut[i] = std::move(out);
   }
 #endif
 
 #if LLVM_ENABLE_ZLIB
-  // We chose 1 (Z_BEST_SPEED) as the default compression level because it is
-  // fast and provides decent compression ratios.
-  if (ctype == DebugCompressionType::Zlib) {
-    if (!level)
-      level = Z_BEST_SPEED;
-
-    // Compress shards and compute Alder-32 checksums. Use Z_SYNC_FLUSH for all
-    // shards but the last to flush the output to a byte boundary to be
-    // concatenated with the next shard.
-    auto shardsAdler = std::make_unique<uint32_t[]>(numShards);
-    parallelFor(0, numShards, [&](size_t i) {
-      shardsOut[i] = deflateShard(ctx, shardsIn[i], level,
-                                  i != numShards - 1 ? Z_SYNC_FLUSH : Z_FINISH);
-      shardsAdler[i] = adler32(1, shardsIn[i].data(), shardsIn[i].size());
-    });
+  // Compress shards and compute Alder-32 checksums. Use Z_SYNC_FLUSH for all
+  // shards but the last to flush the output to a byte boundary to be
+  // concatenated with the next shard.
+  if (job.ctype == DebugCompressionType::Zlib) {
+    bool last = i == job.shardsIn.size() - 1;
+    job.shardsOut[i] =
+        deflateShard(ctx, in, job.level, last ? Z_FINISH : Z_SYNC_FLUSH);
+    job.shardsAdler[i] = adler32(1, in.data(), in.size());
+  }
+#endif
+}
+
+template <class ELFT> static void finishCompression(CompressJob &job) {
+  using Elf_Chdr = typename ELFT::Chdr;
+  OutputSection &osec = *job.osec;
+  const size_t numShards = job.shardsIn.size();
+  size_t compressedSize = sizeof(Elf_Chdr);
+  for (size_t i = 0; i != numShards; ++i)
+    compressedSize += job.shardsOut[i].size();
 
+  if (job.ctype == DebugCompressionType::Zstd)
+    osec.compressed.type = ELFCOMPRESS_ZSTD;
+
+#if LLVM_ENABLE_ZLIB
+  if (job.ctype == DebugCompressionType::Zlib) {
     // Update section size and combine Alder-32 checksums.
-    uint32_t checksum = 1;       // Initial Adler-32 value
-    compressedSize += 2;         // Elf_Chdir and zlib header
-    for (size_t i = 0; i != numShards; ++i) {
-      compressedSize += shardsOut[i].size();
-      checksum = adler32_combine(checksum, shardsAdler[i], shardsIn[i].size());
-    }
+    uint32_t checksum = 1; // Initial Adler-32 value
+    compressedSize += 2;   // Elf_Chdir and zlib header
+    for (size_t i = 0; i != numShards; ++i)
+      checksum = adler32_combine(checksum, job.shardsAdler[i],
+                                 job.shardsIn[i].size());
     compressedSize += 4; // checksum
-    compressed.type = ELFCOMPRESS_ZLIB;
-    compressed.checksum = checksum;
+    osec.compressed.type = ELFCOMPRESS_ZLIB;
+    osec.compressed.checksum = checksum;
   }
 #endif
 
-  if (compressedSize >= size)
+  if (compressedSize >= osec.size)
     return;
-  compressed.uncompressedSize = size;
-  compressed.shards = std::move(shardsOut);
-  compressed.numShards = numShards;
-  size = compressedSize;
-  flags |= SHF_COMPRESSED;
+  osec.compressed.uncompressedSize = osec.size;
+  osec.compressed.shards = std::move(job.shardsOut);
+  osec.compressed.numShards = numShards;
+  osec.size = compressedSize;
+  osec.flags |= SHF_COMPRESSED;
+}
+
+// Compresses a group of output sections. The shards of all sections are
+// compressed by a single parallelFor so that small sections, which have few
+// shards each, are compressed concurrently.
+template <class ELFT>
+static void compressGroup(Ctx &ctx, CompressContexts &contexts,
+                          MutableArrayRef<CompressJob> jobs) {
+  llvm::TimeTraceScope timeScope("Compress sections");
+
+  // Write uncompressed data to temporary zero-initialized buffers.
+  {
+    parallel::TaskGroup tg;
+    for (CompressJob &job : jobs) {
+      job.buf = std::make_unique<uint8_t[]>(job.osec->size);
+      job.osec->writeTo<ELFT>(ctx, job.buf.get(), tg);
+    }
+  }
+
+  // Split input into 1-MiB shards.
+  constexpr size_t shardSize = 1 << 20;
+  SmallVector<std::pair<CompressJob *, size_t>, 0> shards;
+  for (CompressJob &job : jobs) {
+    // The generic ABI specifies "The sh_size and sh_addralign fields of the
+    // section header for a compressed section reflect the requirements of the
+    // compressed section." However, 1-byte alignment has been wildly accepted
+    // and utilized for a long time. Removing alignment padding is particularly
+    // useful when there are many compressed output sections.
+    job.osec->addralign = 1;
+
+    job.shardsIn =
+        split(ArrayRef<uint8_t>(job.buf.get(), job.osec->size), shardSize);
+    const size_t numShards = job.shardsIn.size();
+    job.shardsOut = std::make_unique<SmallVector<uint8_t, 0>[]>(numShards);
+    if (job.ctype == DebugCompressionType::Zlib)
+      job.shardsAdler = std::make_unique<uint32_t[]>(numShards);
+    for (size_t i = 0; i != numShards; ++i)
+      shards.emplace_back(&job, i);
+  }
+
+  parallelFor(0, shards.size(), [&](size_t i) {
+    compressShard(ctx, contexts, *shards[i].first, shards[i].second);
+  });
+
+  for (CompressJob &job : jobs) {
+    finishCompression<ELFT>(job);
+    job.buf.reset();
+  }
+}
+
+// If --compress-debug-sections or --compress-sections is specified, compress
+// the matching output sections.
+template <class ELFT> void elf::compressSections(Ctx &ctx) {
+  // Sections are grouped in output order until the total uncompressed size
+  // exceeds groupLimit, which bounds the memory for the uncompressed buffers.
+  // A section larger than the limit forms a group by itself.
+  constexpr uint64_t groupLimit = 64 << 20;
+  CompressContexts contexts;
+  SmallVector<CompressJob, 0> jobs;
+  uint64_t pending = 0;
+  for (OutputSection *osec : ctx.outputSections) {
+    auto [ctype, level] = getCompressionType(ctx, *osec);
+    if (ctype == DebugCompressionType::None)
+      continue;
+    if (!jobs.empty() && pending + osec->size > groupLimit) {
+      compressGroup<ELFT>(ctx, contexts, jobs);
+      jobs.clear();
+      pending = 0;
+    }
+    jobs.push_back({osec, ctype, level, nullptr, {}, nullptr, nullptr});
+    pending += osec->size;
+  }
+  if (!jobs.empty())
+    compressGroup<ELFT>(ctx, contexts, jobs);
 }
 
 static void writeInt(Ctx &ctx, uint8_t *buf, uint64_t data, uint64_t size) {
@@ -953,7 +1052,7 @@ template void OutputSection::writeTo<ELF64LE>(Ctx &, uint8_t *,
 template void OutputSection::writeTo<ELF64BE>(Ctx &, uint8_t *,
                                               llvm::parallel::TaskGroup &);
 
-template void OutputSection::maybeCompress<ELF32LE>(Ctx &);
-template void OutputSection::maybeCompress<ELF32BE>(Ctx &);
-template void OutputSection::maybeCompress<ELF64LE>(Ctx &);
-template void OutputSection::maybeCompress<ELF64BE>(Ctx &);
+template void elf::compressSections<ELF32LE>(Ctx &);
+template void elf::compressSections<ELF32BE>(Ctx &);
+template void elf::compressSections<ELF64LE>(Ctx &);
+template void elf::compressSections<ELF64BE>(Ctx &);
@@ -118,7 +118,6 @@ public:
   void writeTo(Ctx &, uint8_t *buf, llvm::parallel::TaskGroup &tg);
   // Check that the addends for dynamic relocations were written correctly.
   void checkDynRelAddends(Ctx &);
-  template <class ELFT> void maybeCompress(Ctx &);
 
   void sort(llvm::function_ref<int(InputSectionBase *s)> order);
   void sortInitFini();
@@ -172,6 +171,7 @@ getInputSections(const OutputSection &os,
                  SmallVector<InputSection *, 0> &storage);
 
 uint64_t getHeaderSize(Ctx &);
+template <class ELFT> void compressSections(Ctx &);
 } // namespace lld::elf
 
 #endif
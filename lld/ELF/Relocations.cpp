@@ -462,6 +462,10 @@ private:
   // End of relocations, used by Mips/PPC64.
   const void *end = nullptr;
 
+  // Scratch storage for the relocations of the section being scanned, reused
+  // across sections.
+  SmallVector<Relocation, 0> buf;
+
   template <class RelTy> RelType getMipsN32RelType(RelTy *&rel) const;
   template <class ELFT, class RelTy>
   int64_t computeMipsAddend(const RelTy &rel, RelExpr expr, bool isLocal) const;
@@ -1630,8 +1634,18 @@ static void checkPPC64TLSRelax(InputSectionBase &sec, Relocs<RelTy> rels) {
 
 template <class ELFT, class RelTy>
 void RelocationScanner::scan(Relocs<RelTy> rels) {
-  // Not all relocations end up in Sec->Relocations, but a lot do.
-  sec->relocations.reserve(rels.size());
+  // Not all relocations end up in sec->relocations. For example, marker
+  // relocations are dropped, and relative relocations only produce dynamic
+  // relocations unless RELR is used. Reserving rels.size() for every section
+  // would waste a lot of memory in the latter case, so collect relocations into
+  // a buffer reused across sections and copy them to an exactly sized vector.
+  bool useBuf = sec->relocations.empty();
+  if (useBuf) {
+    buf.reserve(rels.size());
+    sec->relocations = std::move(buf);
+  } else {
+    sec->relocations.reserve(sec->relocations.size() + rels.size());
+  }
 
   if (ctx.arg.emachine == EM_PPC64)
     checkPPC64TLSRelax<RelTy>(*sec, rels);
@@ -1663,6 +1677,14 @@ void RelocationScanner::scan(Relocs<RelTy> rels) {
                       [](const Relocation &lhs, const Relocation &rhs) {
                         return lhs.offset < rhs.offset;
                       });
+
+  if (useBuf) {
+    SmallVector<Relocation, 0> relocs(sec->relocations.begin(),
+                                      sec->relocations.end());
+    buf = std::move(sec->relocations);
+    buf.clear();
+    sec->relocations = std::move(relocs);
+  }
 }
 
 template <class ELFT>
@@ -60,20 +60,35 @@ void SymbolTable::wrap(Symbol *sym, Symbol *real, Symbol *wrap) {
   real->isUsedInRegularObj = false;
 }
 
-// Find an existing symbol or create a new one.
-Symbol *SymbolTable::insert(StringRef name) {
-  // <name>@@<version> means the symbol is the default version. In that
-  // case <name>@@<version> will be used to resolve references to <name>.
-  //
-  // Since this is a hot path, the following string search code is
-  // optimized for speed. StringRef::find(char) is much faster than
-  // StringRef::find(StringRef).
-  StringRef stem = name;
+// <name>@@<version> means the symbol is the default version. In that case
+// <name>@@<version> will be used to resolve references to <name>, so the
+// symbol is keyed by <name>.
+//
+// Since this is a hot path, the following string search code is optimized for
+// speed. StringRef::find(char) is much faster than StringRef::find(StringRef).
+static StringRef getStem(StringRef name) {
   size_t pos = name.find('@');
   if (pos != StringRef::npos && pos + 1 < name.size() && name[pos + 1] == '@')
-    stem = name.take_front(pos);
+    return name.take_front(pos);
+  return name;
+}
+
+uint32_t SymbolTable::hashName(StringRef name) {
+  return CachedHashStringRef(getStem(name)).hash();
+}
+
+// Find an existing symbol or create a new one.
+Symbol *SymbolTable::insert(StringRef name) {
+  StringRef stem = getStem(name);
+  return insert(name, CachedHashStringRef(stem));
+}
+
+Symbol *SymbolTable::insert(StringRef name, uint32_t hash) {
+  return insert(name, CachedHashStringRef(getStem(name), hash));
+}
 
-  auto p = symMap.insert({CachedHashStringRef(stem), (int)symVector.size()});
+Symbol *SymbolTable::insert(StringRef name, CachedHashStringRef stem) {
+  auto p = symMap.insert({stem, (int)symVector.size()});
   if (!p.second) {
     Symbol *sym = symVector[p.first->second];
     if (stem.size() != name.size()) {
@@ -91,7 +106,7 @@ Symbol *SymbolTable::insert(StringRef name) {
   sym->setName(name);
   sym->partition = 1;
   sym->versionId = VER_NDX_GLOBAL;
-  if (pos != StringRef::npos)
+  if (name.find('@') != StringRef::npos)
     sym->hasVersionSuffix = true;
   return sym;
 }
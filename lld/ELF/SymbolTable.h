@@ -45,6 +45,11 @@ public:
 
   Symbol *insert(StringRef name);
 
+  // Same as insert(name), but takes hashName(name) computed in advance. This
+  // allows the hashing of symbol names to be done in parallel.
+  Symbol *insert(StringRef name, uint32_t hash);
+  static uint32_t hashName(StringRef name);
+
   template <typename T> Symbol *addSymbol(const T &newSym) {
     Symbol *sym = insert(newSym.getName());
     sym->resolve(ctx, newSym);
@@ -91,6 +96,7 @@ private:
                           StringRef versionName, bool includeNonDefault);
   void assignWildcardVersion(SymbolVersion ver, uint16_t versionId,
                              bool includeNonDefault);
+  Symbol *insert(StringRef name, llvm::CachedHashStringRef stem);
 
   Ctx &ctx;
 
@@ -442,18 +442,21 @@ Defined *EhFrameSection::isFdeLive(EhSectionPiece &fde, ArrayRef<RelTy> rels) {
 // is one CIE record per input object file which is followed by
 // a list of FDEs. This function searches an existing CIE or create a new
 // one and associates FDEs to the CIE.
+// liveFdes tells whether each FDE of the section is live, as computed by
+// isFdeLive().
 template <class ELFT, class RelTy>
-void EhFrameSection::addRecords(EhInputSection *sec, ArrayRef<RelTy> rels) {
+void EhFrameSection::addRecords(EhInputSection *sec, ArrayRef<RelTy> rels,
+                                ArrayRef<bool> liveFdes) {
   offsetToCie.clear();
   for (EhSectionPiece &cie : sec->cies)
     offsetToCie[cie.inputOff] = addCie<ELFT>(cie, rels);
-  for (EhSectionPiece &fde : sec->fdes) {
+  for (auto [fde, live] : llvm::zip_equal(sec->fdes, liveFdes)) {
     uint32_t id = endian::read32<ELFT::Endianness>(fde.data().data() + 4);
     CieRecord *rec = offsetToCie[fde.inputOff + 4 - id];
     if (!rec)
       Fatal(ctx) << sec << ": invalid CIE reference";
 
-    if (!isFdeLive<ELFT>(fde, rels))
+    if (!live)
       continue;
     rec->fdes.push_back(&fde);
     numFdes++;
@@ -461,15 +464,41 @@ void EhFrameSection::addRecords(EhInputSection *sec, ArrayRef<RelTy> rels) {
 }
 
 template <class ELFT>
-void EhFrameSection::addSectionAux(EhInputSection *sec) {
+void EhFrameSection::addSectionAux(EhInputSection *sec,
+                                   ArrayRef<bool> liveFdes) {
   if (!sec->isLive())
     return;
   const RelsOrRelas<ELFT> rels =
       sec->template relsOrRelas<ELFT>(/*supportsCrel=*/false);
   if (rels.areRelocsRel())
-    addRecords<ELFT>(sec, rels.rels);
+    addRecords<ELFT>(sec, rels.rels, liveFdes);
   else
-    addRecords<ELFT>(sec, rels.relas);
+    addRecords<ELFT>(sec, rels.relas, liveFdes);
+}
+
+template <class ELFT> void EhFrameSection::addSections() {
+  // Whether an FDE is live only depends on the target of its first relocation,
+  // so it is decided for all the sections in parallel. The CIEs and FDEs are
+  // then added in order, which keeps the output deterministic.
+  SmallVector<SmallVector<bool, 0>, 0> liveFdes(sections.size());
+  parallelFor(0, sections.size(), [&](size_t i) {
+    EhInputSection *sec = sections[i];
+    if (!sec->isLive())
+      return;
+    liveFdes[i].resize(sec->fdes.size());
+    auto fill = [&](auto rels) {
+      for (auto [fde, live] : llvm::zip_equal(sec->fdes, liveFdes[i]))
+        live = isFdeLive<ELFT>(fde, rels) != nullptr;
+    };
+    const RelsOrRelas<ELFT> rels =
+        sec->template relsOrRelas<ELFT>(/*supportsCrel=*/false);
+    if (rels.areRelocsRel())
+      fill(rels.rels);
+    else
+      fill(rels.relas);
+  });
+  for (auto [sec, live] : llvm::zip_equal(sections, liveFdes))
+    addSectionAux<ELFT>(sec, live);
 }
 
 // Used by ICF<ELFT>::handleLSDA(). This function is very similar to
@@ -521,20 +550,16 @@ void EhFrameSection::finalizeContents() {
   case ELFNoneKind:
     llvm_unreachable("invalid ekind");
   case ELF32LEKind:
-    for (EhInputSection *sec : sections)
-      addSectionAux<ELF32LE>(sec);
+    addSections<ELF32LE>();
     break;
   case ELF32BEKind:
-    for (EhInputSection *sec : sections)
-      addSectionAux<ELF32BE>(sec);
+    addSections<ELF32BE>();
     break;
   case ELF64LEKind:
-    for (EhInputSection *sec : sections)
-      addSectionAux<ELF64LE>(sec);
+    addSections<ELF64LE>();
     break;
   case ELF64BEKind:
-    for (EhInputSection *sec : sections)
-      addSectionAux<ELF64BE>(sec);
+    addSections<ELF64BE>();
     break;
   }
 
@@ -563,30 +588,42 @@ void EhFrameSection::finalizeContents() {
 // returns a list of such pairs.
 SmallVector<EhFrameSection::FdeData, 0> EhFrameSection::getFdeData() const {
   uint8_t *buf = ctx.bufferStart + getParent()->offset + outSecOff;
-  SmallVector<FdeData, 0> ret;
 
-  uint64_t va = getPartition(ctx).ehFrameHdr->getVA();
+  // Read the PCs of the FDEs in parallel.
+  SmallVector<std::pair<const EhSectionPiece *, uint8_t>, 0> fdes;
+  fdes.reserve(numFdes);
   for (CieRecord *rec : cieRecords) {
     uint8_t enc = getFdeEncoding(rec->cie);
-    for (EhSectionPiece *fde : rec->fdes) {
-      uint64_t pc = getFdePc(buf, fde->outputOff, enc);
-      uint64_t fdeVA = getParent()->addr + fde->outputOff;
-      if (!isInt<32>(pc - va)) {
-        Err(ctx) << fde->sec << ": PC offset is too large: 0x"
-                 << Twine::utohexstr(pc - va);
-        continue;
-      }
-      ret.push_back({uint32_t(pc - va), uint32_t(fdeVA - va)});
+    for (EhSectionPiece *fde : rec->fdes)
+      fdes.emplace_back(fde, enc);
+  }
+  SmallVector<uint64_t, 0> pcs(fdes.size());
+  parallelFor(0, fdes.size(), [&](size_t i) {
+    pcs[i] = getFdePc(buf, fdes[i].first->outputOff, fdes[i].second);
+  });
+
+  SmallVector<FdeData, 0> ret;
+  ret.reserve(fdes.size());
+  uint64_t va = getPartition(ctx).ehFrameHdr->getVA();
+  for (auto [fde, pc] : llvm::zip_equal(fdes, pcs)) {
+    uint64_t fdeVA = getParent()->addr + fde.first->outputOff;
+    if (!isInt<32>(pc - va)) {
+      Err(ctx) << fde.first->sec << ": PC offset is too large: 0x"
+               << Twine::utohexstr(pc - va);
+      continue;
     }
+    ret.push_back({uint32_t(pc - va), uint32_t(fdeVA - va)});
   }
 
   // Sort the FDE list by their PC and uniqueify. Usually there is only
   // one FDE for a PC (i.e. function), but if ICF merges two functions
   // into one, there can be more than one FDEs pointing to the address.
+  // The FDEs are in ascending address order, so sorting on the address as
+  // well keeps the first FDE of a PC, as a stable sort would.
   auto less = [](const FdeData &a, const FdeData &b) {
-    return a.pcRel < b.pcRel;
+    return std::tie(a.pcRel, a.fdeVARel) < std::tie(b.pcRel, b.fdeVARel);
   };
-  llvm::stable_sort(ret, less);
+  parallelSort(ret, less);
   auto eq = [](const FdeData &a, const FdeData &b) {
     return a.pcRel == b.pcRel;
   };
@@ -3523,9 +3560,42 @@ createSymbols(
     }
   });
 
-  size_t numSymbols = 0;
-  for (ArrayRef<GdbSymbol> v : ArrayRef(symbols.get(), numShards))
-    numSymbols += v.size();
+  // CU vectors and symbol names are adjacent in the output file, in the order
+  // of the flattened shards below. We can compute their offsets in the output
+  // file now. Compute the size of each shard's part first, and then assign
+  // offsets within shards in parallel.
+  size_t cuVectorSizes[numShards], nameSizes[numShards];
+  parallelFor(0, numShards, [&](size_t shardId) {
+    cuVectorSizes[shardId] = nameSizes[shardId] = 0;
+    for (const GdbSymbol &sym : symbols[shardId]) {
+      cuVectorSizes[shardId] += (sym.cuVector.size() + 1) * 4;
+      nameSizes[shardId] += sym.name.size() + 1;
+    }
+  });
+  size_t numSymbols = 0, cuVectorOffs[numShards], nameOffs[numShards];
+  size_t off = 0;
+  for (size_t shardId = 0; shardId != numShards; ++shardId) {
+    numSymbols += symbols[shardId].size();
+    cuVectorOffs[shardId] = off;
+    off += cuVectorSizes[shardId];
+  }
+  for (size_t shardId = 0; shardId != numShards; ++shardId) {
+    nameOffs[shardId] = off;
+    off += nameSizes[shardId];
+  }
+  // If off overflows, the last symbol's nameOff likely overflows.
+  if (!isUInt<32>(off))
+    Err(ctx) << "--gdb-index: constant pool size (" << off
+             << ") exceeds UINT32_MAX";
+  parallelFor(0, numShards, [&](size_t shardId) {
+    size_t cuVectorOff = cuVectorOffs[shardId], nameOff = nameOffs[shardId];
+    for (GdbSymbol &sym : symbols[shardId]) {
+      sym.cuVectorOff = cuVectorOff;
+      sym.nameOff = nameOff;
+      cuVectorOff += (sym.cuVector.size() + 1) * 4;
+      nameOff += sym.name.size() + 1;
+    }
+  });
 
   // The return type is a flattened vector, so we'll copy each vector
   // contents to Ret.
@@ -3536,22 +3606,6 @@ createSymbols(
     for (GdbSymbol &sym : vec)
       ret.push_back(std::move(sym));
 
-  // CU vectors and symbol names are adjacent in the output file.
-  // We can compute their offsets in the output file now.
-  size_t off = 0;
-  for (GdbSymbol &sym : ret) {
-    sym.cuVectorOff = off;
-    off += (sym.cuVector.size() + 1) * 4;
-  }
-  for (GdbSymbol &sym : ret) {
-    sym.nameOff = off;
-    off += sym.name.size() + 1;
-  }
-  // If off overflows, the last symbol's nameOff likely overflows.
-  if (!isUInt<32>(off))
-    Err(ctx) << "--gdb-index: constant pool size (" << off
-             << ") exceeds UINT32_MAX";
-
   return {ret, off};
 }
 
@@ -3677,14 +3731,14 @@ void GdbIndexSection::writeTo(uint8_t *buf) {
   });
 
   // Write the CU vectors.
-  for (GdbSymbol &sym : symbols) {
-    write32le(buf, sym.cuVector.size());
-    buf += 4;
+  parallelForEach(symbols, [&](GdbSymbol &sym) {
+    uint8_t *p = buf + sym.cuVectorOff;
+    write32le(p, sym.cuVector.size());
     for (uint32_t val : sym.cuVector) {
-      write32le(buf, val);
-      buf += 4;
+      p += 4;
+      write32le(p, val);
     }
-  }
+  });
 }
 
 bool GdbIndexSection::isNeeded() const { return !chunks.empty(); }
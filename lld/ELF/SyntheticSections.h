@@ -81,8 +81,11 @@ private:
   uint64_t size = 0;
 
   template <class ELFT, class RelTy>
-  void addRecords(EhInputSection *s, llvm::ArrayRef<RelTy> rels);
-  template <class ELFT> void addSectionAux(EhInputSection *s);
+  void addRecords(EhInputSection *s, llvm::ArrayRef<RelTy> rels,
+                  ArrayRef<bool> liveFdes);
+  template <class ELFT>
+  void addSectionAux(EhInputSection *s, ArrayRef<bool> liveFdes);
+  template <class ELFT> void addSections();
   template <class ELFT, class RelTy>
   void iterateFDEWithLSDAAux(EhInputSection &sec, ArrayRef<RelTy> rels,
                              llvm::DenseSet<size_t> &ciesWithLSDA,
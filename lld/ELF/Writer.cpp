@@ -322,14 +322,19 @@ template <class ELFT> void Writer<ELFT>::run() {
   // completes section contents. For example, we need to add strings
   // to the string table, and add entries to .got and .plt.
   // finalizeSections does that.
-  finalizeSections();
+  {
+    ScopedTimer t(ctx.finalizeTimer);
+    finalizeSections();
+  }
   checkExecuteOnly();
   checkExecuteOnlyReport();
 
   // If --compressed-debug-sections is specified, compress .debug_* sections.
   // Do it right now because it changes the size of output sections.
-  for (OutputSection *sec : ctx.outputSections)
-    sec->maybeCompress<ELFT>(ctx);
+  {
+    ScopedTimer t(ctx.compressTimer);
+    compressSections<ELFT>(ctx);
+  }
 
   if (ctx.script->hasSectionsCommand)
     ctx.script->allocateHeaders(ctx.mainPart->phdrs);
@@ -366,6 +371,7 @@ template <class ELFT> void Writer<ELFT>::run() {
 
   {
     llvm::TimeTraceScope timeScope("Write output file");
+    ScopedTimer t(ctx.writeTimer);
     // Write the result down to a file.
     openFile();
     if (errCount(ctx))
@@ -1088,6 +1094,7 @@ static DenseMap<const InputSectionBase *, int> buildSectionOrder(Ctx &ctx) {
     TimeTraceScope timeScope("Balanced Partitioning Section Orderer");
     sectionOrder = runBalancedPartitioning(
         ctx, ctx.arg.bpStartupFunctionSort ? ctx.arg.irpgoProfilePath : "",
+        ctx.arg.bpStartupFunctionSort ? ctx.arg.bpStartupTracePath : "",
         ctx.arg.bpFunctionOrderForCompression,
         ctx.arg.bpDataOrderForCompression,
         ctx.arg.bpCompressionSortStartupFunctions,
@@ -1522,6 +1529,7 @@ template <class ELFT> void Writer<ELFT>::finalizeAddressDependentContent() {
     randomizeSectionPadding(ctx);
 
   uint32_t pass = 0, assignPasses = 0;
+  bool reordered = true;
   for (;;) {
     bool changed = ctx.target->needsThunks
                        ? tc.createThunks(pass, ctx.outputSections)
@@ -1530,6 +1538,15 @@ template <class ELFT> void Writer<ELFT>::finalizeAddressDependentContent() {
     changed |= spilled;
     ++pass;
 
+    // Thunks and erratum patches are inserted into input section lists without
+    // changing the sizes of other input sections. Unless the lists have been
+    // rearranged since the last assignAddresses(), the next one only needs to
+    // recompute offsets from the first synthetic section of each list.
+    // relaxOnce() may shrink any section, so always do a full pass for it.
+    ctx.script->reuseStableLayout =
+        ctx.target->needsThunks && !reordered && !spilled;
+    reordered = spilled;
+
     // With Thunk Size much smaller than branch range we expect to
     // converge quickly; if we get to 30 something has gone wrong.
     if (changed && pass >= 30) {
@@ -1607,6 +1624,7 @@ template <class ELFT> void Writer<ELFT>::finalizeAddressDependentContent() {
       finalizeOrderDependentContent();
     }
   }
+  ctx.script->reuseStableLayout = false;
   if (!ctx.arg.relocatable)
     ctx.target->finalizeRelax(pass);
 
@@ -1872,6 +1890,7 @@ template <class ELFT> void Writer<ELFT>::finalizeSections() {
 
   if (!ctx.arg.relocatable) {
     llvm::TimeTraceScope timeScope("Scan relocations");
+    ScopedTimer t(ctx.scanRelocTimer);
     // Scan relocations. This must be done after every symbol is declared so
     // that we can correctly decide if a dynamic relocation is needed. This is
     // called after processSymbolAssignments() because it needs to know whether
@@ -2125,7 +2144,10 @@ template <class ELFT> void Writer<ELFT>::finalizeSections() {
   // 3) Assign the final values for the linker script symbols. Linker scripts
   //    sometimes using forward symbol declarations. We want to set the correct
   //    values. They also might change after adding the thunks.
-  finalizeAddressDependentContent();
+  {
+    ScopedTimer t(ctx.addressAssignTimer);
+    finalizeAddressDependentContent();
+  }
 
   // All information needed for OutputSection part of Map file is available.
   if (errCount(ctx))
@@ -223,6 +223,7 @@ struct Configuration {
 
   bool callGraphProfileSort = false;
   llvm::StringRef printSymbolOrder;
+  llvm::StringRef printChainedFixupStats;
 
   llvm::StringRef irpgoProfilePath;
   bool bpStartupFunctionSort = false;
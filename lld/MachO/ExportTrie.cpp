@@ -41,6 +41,7 @@
 #include "lld/Common/Memory.h"
 #include "llvm/BinaryFormat/MachO.h"
 #include "llvm/Support/LEB128.h"
+#include "llvm/Support/Parallel.h"
 #include <optional>
 
 using namespace llvm;
@@ -86,13 +87,14 @@ struct macho::TrieNode {
   std::vector<Edge> edges;
   std::optional<ExportInfo> info;
   // Estimated offset from the start of the serialized trie to the current node.
-  // This will converge to the true offset when updateOffset() is run to a
-  // fixpoint.
+  // This will converge to the true offset when TrieBuilder::build() reassigns
+  // offsets from getSize() to a fixpoint.
   size_t offset = 0;
 
   uint32_t getTerminalSize() const;
-  // Returns whether the new estimated offset differs from the old one.
-  bool updateOffset(size_t &nextOffset);
+  // Returns the size of the serialized node, given the current estimated
+  // offsets of its children.
+  size_t getSize() const;
   void writeTo(uint8_t *buf) const;
 };
 
@@ -134,7 +136,7 @@ uint32_t TrieNode::getTerminalSize() const {
   return size;
 }
 
-bool TrieNode::updateOffset(size_t &nextOffset) {
+size_t TrieNode::getSize() const {
   // Size of the whole node (including the terminalSize and the outgoing edges.)
   // In contrast, terminalSize only records the size of the other data in the
   // node.
@@ -153,12 +155,7 @@ bool TrieNode::updateOffset(size_t &nextOffset) {
     nodeSize += edge.substring.size() + 1             // String length.
                 + getULEB128Size(edge.child->offset); // Offset len.
   }
-  // On input, 'nextOffset' is the new preferred location for this node.
-  bool result = (offset != nextOffset);
-  // Store new location in node object for use by parents.
-  offset = nextOffset;
-  nextOffset += nodeSize;
-  return result;
+  return nodeSize;
 }
 
 void TrieNode::writeTo(uint8_t *buf) const {
@@ -194,9 +191,9 @@ TrieBuilder::~TrieBuilder() {
     delete node;
 }
 
-TrieNode *TrieBuilder::makeNode() {
+TrieNode *TrieBuilder::makeNode(std::vector<TrieNode *> &owner) {
   auto *node = new TrieNode();
-  nodes.emplace_back(node);
+  owner.emplace_back(node);
   return node;
 }
 
@@ -218,8 +215,13 @@ static int charAt(const Symbol *sym, size_t pos) {
 //          of characters along its path from the root.
 // pos:     The string index we are currently sorting on. Note that each symbol
 //          S contained in vec has the same prefix S[0...pos).
+// owner:   Receives the nodes created by this call.
+// pending: If non-null, the construction of each new node with at most
+//          splitThreshold symbols below it is deferred to this list.
 void TrieBuilder::sortAndBuild(MutableArrayRef<const Symbol *> vec,
-                               TrieNode *node, size_t lastPos, size_t pos) {
+                               TrieNode *node, size_t lastPos, size_t pos,
+                               std::vector<TrieNode *> &owner,
+                               std::vector<PendingSubtrie> *pending) {
 tailcall:
   if (vec.empty())
     return;
@@ -244,15 +246,22 @@ tailcall:
   bool isTerminal = pivot == -1;
   bool prefixesDiverge = i != 0 || j != vec.size();
   if (lastPos != pos && (isTerminal || prefixesDiverge)) {
-    TrieNode *newNode = makeNode();
+    TrieNode *newNode = makeNode(owner);
     node->edges.emplace_back(pivotSymbol->getName().slice(lastPos, pos),
                              newNode);
     node = newNode;
     lastPos = pos;
+
+    // Nothing outside of this call adds edges to the new node, so the rest of
+    // its subtrie can be built independently.
+    if (pending && vec.size() <= splitThreshold) {
+      pending->push_back({vec, i, j, node, pos});
+      return;
+    }
   }
 
-  sortAndBuild(vec.slice(0, i), node, lastPos, pos);
-  sortAndBuild(vec.slice(j), node, lastPos, pos);
+  sortAndBuild(vec.slice(0, i), node, lastPos, pos, owner, pending);
+  sortAndBuild(vec.slice(j), node, lastPos, pos, owner, pending);
 
   if (isTerminal) {
     assert(j - i == 1); // no duplicate symbols
@@ -266,30 +275,83 @@ tailcall:
   }
 }
 
+// Resumes the construction of a subtrie deferred by sortAndBuild().
+void TrieBuilder::buildChildren(const PendingSubtrie &sub,
+                                std::vector<TrieNode *> &owner,
+                                std::vector<PendingSubtrie> *pending) {
+  sortAndBuild(sub.vec.slice(0, sub.i), sub.node, sub.pos, sub.pos, owner,
+               pending);
+  sortAndBuild(sub.vec.slice(sub.j), sub.node, sub.pos, sub.pos, owner,
+               pending);
+  if (charAt(sub.vec[sub.i], sub.pos) == -1) {
+    assert(sub.j - sub.i == 1); // no duplicate symbols
+    sub.node->info = ExportInfo(*sub.vec[sub.i], imageBase);
+  } else {
+    sortAndBuild(sub.vec.slice(sub.i, sub.j - sub.i), sub.node, sub.pos,
+                 sub.pos + 1, owner, pending);
+  }
+}
+
 size_t TrieBuilder::build() {
   if (exported.empty())
     return 0;
 
-  TrieNode *root = makeNode();
-  sortAndBuild(exported, root, 0, 0);
+  // For large export sets, build the top of the trie serially and the
+  // subtries below it in parallel. Each node's edges are created in the same
+  // order either way, so the result does not depend on the thread count.
+  std::vector<PendingSubtrie> pending;
+  splitThreshold = exported.size() >= 4096 ? exported.size() / 256 : 0;
+  TrieNode *root = makeNode(nodes);
+  sortAndBuild(exported, root, 0, 0, nodes,
+               splitThreshold ? &pending : nullptr);
+  if (!pending.empty()) {
+    std::vector<std::vector<TrieNode *>> owners(pending.size());
+    parallelFor(0, pending.size(), [&](size_t k) {
+      buildChildren(pending[k], owners[k], /*pending=*/nullptr);
+    });
+    for (std::vector<TrieNode *> &owner : owners)
+      nodes.insert(nodes.end(), owner.begin(), owner.end());
+
+    // Serialize the nodes in preorder, which is the order in which a serial
+    // build creates them.
+    std::vector<TrieNode *> order;
+    order.reserve(nodes.size());
+    std::vector<TrieNode *> stack = {root};
+    while (!stack.empty()) {
+      TrieNode *node = stack.back();
+      stack.pop_back();
+      order.push_back(node);
+      for (const Edge &edge : llvm::reverse(node->edges))
+        stack.push_back(edge.child);
+    }
+    assert(order.size() == nodes.size());
+    nodes = std::move(order);
+  }
 
   // Assign each node in the vector an offset in the trie stream, iterating
-  // until all uleb128 sizes have stabilized.
+  // until all uleb128 sizes have stabilized. Every node precedes its children,
+  // so a node's size only depends on offsets from the previous iteration and
+  // all sizes can be computed in parallel.
+  std::vector<size_t> sizes(nodes.size());
   size_t offset;
   bool more;
   do {
+    parallelFor(0, nodes.size(),
+                [&](size_t k) { sizes[k] = nodes[k]->getSize(); });
     offset = 0;
     more = false;
-    for (TrieNode *node : nodes)
-      more |= node->updateOffset(offset);
+    for (size_t k = 0, e = nodes.size(); k != e; ++k) {
+      more |= nodes[k]->offset != offset;
+      nodes[k]->offset = offset;
+      offset += sizes[k];
+    }
   } while (more);
 
   return offset;
 }
 
 void TrieBuilder::writeTo(uint8_t *buf) const {
-  for (TrieNode *node : nodes)
-    node->writeTo(buf);
+  parallelForEach(nodes, [&](const TrieNode *node) { node->writeTo(buf); });
 }
 
 namespace {
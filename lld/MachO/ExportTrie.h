@@ -29,12 +29,30 @@ public:
   void writeTo(uint8_t *buf) const;
 
 private:
-  TrieNode *makeNode();
+  // A subtrie whose construction was deferred so that it can be built in
+  // parallel with its siblings. vec has already been partitioned around the
+  // character at pos: [0, i) sort before it, [i, j) match it, and the rest sort
+  // after it.
+  struct PendingSubtrie {
+    llvm::MutableArrayRef<const Symbol *> vec;
+    size_t i, j;
+    TrieNode *node;
+    size_t pos;
+  };
+
+  TrieNode *makeNode(std::vector<TrieNode *> &owner);
   void sortAndBuild(llvm::MutableArrayRef<const Symbol *> vec, TrieNode *node,
-                    size_t lastPos, size_t pos);
+                    size_t lastPos, size_t pos, std::vector<TrieNode *> &owner,
+                    std::vector<PendingSubtrie> *pending);
+  void buildChildren(const PendingSubtrie &sub, std::vector<TrieNode *> &owner,
+                     std::vector<PendingSubtrie> *pending);
 
   uint64_t imageBase = 0;
+  // Subtries with at most this many symbols are deferred. 0 disables parallel
+  // construction.
+  size_t splitThreshold = 0;
   std::vector<const Symbol *> exported;
+  // All nodes of the trie, in the order in which they are serialized.
   std::vector<TrieNode *> nodes;
 };
 
@@ -19,6 +19,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/BinaryFormat/MachO.h"
 #include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/TimeProfiler.h"
 
 using namespace llvm;
@@ -448,6 +449,8 @@ private:
 
   bool parsePointerListInfo(const ConcatInputSection *isec, uint32_t secOffset,
                             PointerListInfo &ptrList);
+  void reservePointerLists(ArrayRef<InfoInputCategory> categories,
+                           ClassExtensionInfo &extInfo);
 
   void emitAndLinkPointerList(Defined *parentSym, uint32_t linkAtOffset,
                               const ClassExtensionInfo &extInfo,
@@ -468,6 +471,7 @@ private:
   void createSymbolReference(Defined *refFrom, const Symbol *refTo,
                              uint32_t offset, const Reloc &relocTemplate);
   Defined *tryFindDefinedOnIsec(const InputSection *isec, uint32_t offset);
+  Symbol *tryGetSymbolFromReloc(const Reloc *reloc);
   Symbol *tryGetSymbolAtIsecOffset(const ConcatInputSection *isec,
                                    uint32_t offset);
   Defined *tryGetDefinedAtIsecOffset(const ConcatInputSection *isec,
@@ -533,13 +537,33 @@ void ObjcCategoryMerger::collectSectionWriteInfoFromIsec(
   catWriteInfo.valid = true;
 }
 
+// Returns the relocations of a pointer list section indexed by offset / word
+// size. Lists have a relocation for every pointer, so this avoids a linear
+// getRelocAt() lookup for each entry.
+static SmallVector<const Reloc *, 0>
+getRelocsByWord(const InputSection *isec) {
+  SmallVector<const Reloc *, 0> relocs(isec->getSize() / target->wordSize);
+  for (const Reloc &r : isec->relocs) {
+    uint32_t idx = r.offset / target->wordSize;
+    if (r.offset % target->wordSize != 0 || idx >= relocs.size())
+      continue;
+    // Keep the first relocation at each offset, like getRelocAt().
+    const Reloc *&slot = relocs[idx];
+    if (!slot)
+      slot = &r;
+  }
+  return relocs;
+}
+
 Symbol *
 ObjcCategoryMerger::tryGetSymbolAtIsecOffset(const ConcatInputSection *isec,
                                              uint32_t offset) {
   if (!isec)
     return nullptr;
-  const Reloc *reloc = isec->getRelocAt(offset);
+  return tryGetSymbolFromReloc(isec->getRelocAt(offset));
+}
 
+Symbol *ObjcCategoryMerger::tryGetSymbolFromReloc(const Reloc *reloc) {
   if (!reloc)
     return nullptr;
 
@@ -702,9 +726,10 @@ void ObjcCategoryMerger::parseProtocolListInfo(
            sourceLang == SourceLanguage::Swift)) &&
          "Protocol list does not match expected size");
 
+  SmallVector<const Reloc *, 0> relocs = getRelocsByWord(ptrListSym->isec());
   uint32_t off = protocolListHeaderLayout.totalSize;
   for (uint32_t inx = 0; inx < protocolCount; ++inx) {
-    const Reloc *reloc = ptrListSym->isec()->getRelocAt(off);
+    const Reloc *reloc = relocs[off / target->wordSize];
     assert(reloc && "No reloc found at protocol list offset");
 
     auto *listSym = dyn_cast_or_null<Defined>(cast<Symbol *>(reloc->referent));
@@ -764,9 +789,10 @@ bool ObjcCategoryMerger::parsePointerListInfo(const ConcatInputSection *isec,
   assert(expectedListSize == ptrListSym->isec()->data.size() &&
          "Pointer list does not match expected size");
 
+  SmallVector<const Reloc *, 0> relocs = getRelocsByWord(ptrListSym->isec());
   for (uint32_t off = listHeaderLayout.totalSize; off < expectedListSize;
        off += target->wordSize) {
-    const Reloc *reloc = ptrListSym->isec()->getRelocAt(off);
+    const Reloc *reloc = relocs[off / target->wordSize];
     assert(reloc && "No reloc found at pointer list offset");
 
     auto *listSym =
@@ -783,6 +809,49 @@ bool ObjcCategoryMerger::parsePointerListInfo(const ConcatInputSection *isec,
   return true;
 }
 
+// Grow the method, protocol and property lists of extInfo to hold the entries
+// of all the given categories up front, rather than reallocating them as each
+// category is appended.
+void ObjcCategoryMerger::reservePointerLists(
+    ArrayRef<InfoInputCategory> categories, ClassExtensionInfo &extInfo) {
+  auto getListSym = [&](const ConcatInputSection *isec,
+                        uint32_t off) -> const Defined * {
+    const Reloc *reloc = isec->getRelocAt(off);
+    return reloc ? dyn_cast_or_null<Defined>(
+                       reloc->referent.dyn_cast<Symbol *>())
+                 : nullptr;
+  };
+  auto readHeader = [](const Defined *sym, uint32_t off) {
+    return *reinterpret_cast<const uint32_t *>(sym->isec()->data.data() + off);
+  };
+
+  size_t numInstanceMethods = 0, numClassMethods = 0, numProtocols = 0,
+         numInstanceProps = 0, numClassProps = 0;
+  auto countPointers = [&](const ConcatInputSection *isec, uint32_t off,
+                           size_t &count) {
+    if (const Defined *sym = getListSym(isec, off))
+      count += readHeader(sym, listHeaderLayout.structSizeOffset) *
+               readHeader(sym, listHeaderLayout.structCountOffset) /
+               target->wordSize;
+  };
+  for (const InfoInputCategory &catInfo : categories) {
+    const ConcatInputSection *isec = catInfo.catBodyIsec;
+    countPointers(isec, catLayout.instanceMethodsOffset, numInstanceMethods);
+    countPointers(isec, catLayout.classMethodsOffset, numClassMethods);
+    countPointers(isec, catLayout.instancePropsOffset, numInstanceProps);
+    countPointers(isec, catLayout.classPropsOffset, numClassProps);
+    // Protocol lists start with a count rather than a list header.
+    if (const Defined *sym = getListSym(isec, catLayout.protocolsOffset))
+      numProtocols += readHeader(sym, listHeaderLayout.structSizeOffset);
+  }
+
+  extInfo.instanceMethods.allPtrs.reserve(numInstanceMethods);
+  extInfo.classMethods.allPtrs.reserve(numClassMethods);
+  extInfo.protocols.allPtrs.reserve(numProtocols);
+  extInfo.instanceProps.allPtrs.reserve(numInstanceProps);
+  extInfo.classProps.allPtrs.reserve(numClassProps);
+}
+
 // Here we parse all the information of an input category (catInfo) and
 // append the parsed info into the structure which will contain all the
 // information about how a class is extended (extInfo)
@@ -1119,6 +1188,7 @@ bool ObjcCategoryMerger::mergeCategoriesIntoSingleCategory(
   assert(categories.size() > 1 && "Expected at least 2 categories");
 
   ClassExtensionInfo extInfo(catLayout);
+  reservePointerLists(categories, extInfo);
 
   for (auto &catInfo : categories)
     if (!parseCatInfoToExtInfo(catInfo, extInfo))
@@ -1166,18 +1236,31 @@ DenseSet<const Symbol *> ObjcCategoryMerger::collectNlCategories() {
 }
 
 void ObjcCategoryMerger::collectAndValidateCategoriesData() {
+  TimeTraceScope timeScope("Collect categories");
   auto nlCategories = collectNlCategories();
 
+  SmallVector<ConcatInputSection *, 0> catLists;
   for (InputSection *sec : allInputSections) {
     if (sec->getName() != section_names::objcCatList)
       continue;
     ConcatInputSection *catListCisec = dyn_cast<ConcatInputSection>(sec);
     assert(catListCisec &&
            "__objc_catList InputSection is not a ConcatInputSection");
+    catLists.push_back(catListCisec);
+  }
 
+  // Parsing the categories is read-only, so do it for all __objc_catlist
+  // sections in parallel. The class map is then filled serially in input
+  // order so that the merged output is deterministic.
+  SmallVector<SmallVector<std::pair<Symbol *, InfoInputCategory>, 0>, 0>
+      parsed(catLists.size());
+  parallelFor(0, catLists.size(), [&](size_t i) {
+    ConcatInputSection *catListCisec = catLists[i];
+    SmallVector<const Reloc *, 0> relocs = getRelocsByWord(catListCisec);
     for (uint32_t off = 0; off < catListCisec->getSize();
          off += target->wordSize) {
-      Defined *categorySym = tryGetDefinedAtIsecOffset(catListCisec, off);
+      Defined *categorySym = dyn_cast_or_null<Defined>(
+          tryGetSymbolFromReloc(relocs[off / target->wordSize]));
       assert(categorySym &&
              "Failed to get a valid category at __objc_catlit offset");
 
@@ -1206,12 +1289,14 @@ void ObjcCategoryMerger::collectAndValidateCategoriesData() {
           tryGetSymbolAtIsecOffset(catBodyIsec, catLayout.klassOffset);
       assert(classSym && "Category does not have a valid base class");
 
-      if (!collectCategoryWriterInfoFromCategory(catInputInfo))
-        continue;
-
-      categoryMap[classSym].push_back(catInputInfo);
+      parsed[i].emplace_back(classSym, catInputInfo);
     }
-  }
+  });
+
+  for (auto &cats : parsed)
+    for (auto &[classSym, catInputInfo] : cats)
+      if (collectCategoryWriterInfoFromCategory(catInputInfo))
+        categoryMap[classSym].push_back(catInputInfo);
 }
 
 // In the input we have multiple __objc_catlist InputSection, each of which may
@@ -1284,6 +1369,7 @@ void ObjcCategoryMerger::eraseISec(ConcatInputSection *isec) {
 // their method/protocol/prop lists and the __objc_catlist entries that link to
 // them.
 void ObjcCategoryMerger::eraseMergedCategories() {
+  TimeTraceScope timeScope("Erase merged categories");
   // Map of InputSection to a set of offsets of the categories that were merged
   MapVector<ConcatInputSection *, std::set<uint64_t>> catListToErasedOffsets;
 
@@ -1337,6 +1423,7 @@ void ObjcCategoryMerger::doMerge() {
   collectAndValidateCategoriesData();
 
   for (auto &[baseClass, catInfos] : categoryMap) {
+    TimeTraceScope timeScope("Merge categories", baseClass->getName());
     bool merged = false;
     if (auto *baseClassDef = dyn_cast<Defined>(baseClass)) {
       // Merge all categories into the base class
@@ -1415,6 +1502,7 @@ bool ObjcCategoryMerger::mergeCategoriesIntoBaseClass(
   ClassExtensionInfo extInfo(catLayout);
   extInfo.baseClass = baseClass;
   extInfo.baseClassSourceLanguage = getClassSymSourceLang(baseClass);
+  reservePointerLists(categories, extInfo);
 
   for (auto &catInfo : categories)
     if (!parseCatInfoToExtInfo(catInfo, extInfo))
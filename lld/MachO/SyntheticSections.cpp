@@ -2493,11 +2493,14 @@ void ChainedFixupsSection::finalizeContents() {
   else
     importFormat = DYLD_CHAINED_IMPORT;
 
-  for (Location &loc : locations)
+  parallelForEach(locations, [](Location &loc) {
     loc.offset =
         loc.isec->parent->getSegmentOffset() + loc.isec->getOffset(loc.offset);
+  });
 
-  llvm::sort(locations, [](const Location &a, const Location &b) {
+  // No two fixups may share a location (buildFixupChains() rejects overlaps),
+  // so the order is total and an unstable parallel sort is deterministic.
+  parallelSort(locations, [](const Location &a, const Location &b) {
     const OutputSegment *segA = a.isec->parent->parent;
     const OutputSegment *segB = b.isec->parent->parent;
     if (segA == segB)
@@ -2510,10 +2513,13 @@ void ChainedFixupsSection::finalizeContents() {
   };
 
   const uint64_t pageSize = target->getPageSize();
+  fixupSegments.clear();
+  pageBoundaries.clear();
   for (size_t i = 0, count = locations.size(); i < count;) {
     const Location &firstLoc = locations[i];
     fixupSegments.emplace_back(firstLoc.isec->parent->parent);
     while (i < count && sameSegment(locations[i], firstLoc)) {
+      pageBoundaries.push_back(i);
       uint32_t pageIdx = locations[i].offset / pageSize;
       fixupSegments.back().pageStarts.emplace_back(
           pageIdx, locations[i].offset % pageSize);
@@ -2523,6 +2529,7 @@ void ChainedFixupsSection::finalizeContents() {
         ++i;
     }
   }
+  pageBoundaries.push_back(locations.size());
 
   // Compute expected encoded size.
   size = alignTo<8>(sizeof(dyld_chained_fixups_header));
@@ -804,6 +804,9 @@ public:
                                           int64_t addend) const;
 
   const std::vector<Location> &getLocations() const { return locations; }
+  // The index into getLocations() of the first fixup of each page that has
+  // fixups, followed by getLocations().size(). Valid after finalizeContents().
+  llvm::ArrayRef<size_t> getPageBoundaries() const { return pageBoundaries; }
 
   bool hasWeakBinding() const { return hasWeakBind; }
   bool hasNonWeakDefinition() const { return hasNonWeakDef; }
@@ -812,6 +815,7 @@ private:
   // Location::offset initially stores the offset within an InputSection, but
   // contains output segment offsets after finalizeContents().
   std::vector<Location> locations;
+  std::vector<size_t> pageBoundaries;
   // (target symbol, addend) => import ordinal
   llvm::MapVector<std::pair<const Symbol *, int64_t>, uint32_t> bindings;
 
@@ -471,55 +471,60 @@ void UnwindInfoSectionImpl::finalize() {
   // vector of indices to entries and sort & fold that instead.
   cuIndices.resize(cuEntries.size());
   std::iota(cuIndices.begin(), cuIndices.end(), 0);
-  llvm::sort(cuIndices, [&](size_t a, size_t b) {
-    return cuEntries[a].functionAddress < cuEntries[b].functionAddress;
+  // Break ties on the index so that the order does not depend on how the sort
+  // is split between threads.
+  parallelSort(cuIndices, [&](size_t a, size_t b) {
+    if (cuEntries[a].functionAddress != cuEntries[b].functionAddress)
+      return cuEntries[a].functionAddress < cuEntries[b].functionAddress;
+    return a < b;
   });
 
   // Record the ending boundary before we fold the entries.
   cueEndBoundary = cuEntries[cuIndices.back()].functionAddress +
                    cuEntries[cuIndices.back()].functionLength;
 
-  // Fold adjacent entries with matching encoding+personality and without LSDA
-  // We use three iterators on the same cuIndices to fold in-situ:
-  // (1) `foldBegin` is the first of a potential sequence of matching entries
-  // (2) `foldEnd` is the first non-matching entry after `foldBegin`.
-  // The semi-open interval [ foldBegin .. foldEnd ) contains a range
-  // entries that can be folded into a single entry and written to ...
-  // (3) `foldWrite`
-  auto foldWrite = cuIndices.begin();
-  for (auto foldBegin = cuIndices.begin(); foldBegin < cuIndices.end();) {
-    auto foldEnd = foldBegin;
-    // Common LSDA encodings (e.g. for C++ and Objective-C) contain offsets from
-    // a base address. The base address is normally not contained directly in
-    // the LSDA, and in that case, the personality function treats the starting
-    // address of the function (which is computed by the unwinder) as the base
-    // address and interprets the LSDA accordingly. The unwinder computes the
-    // starting address of a function as the address associated with its CU
-    // entry. For this reason, we cannot fold adjacent entries if they have an
-    // LSDA, because folding would make the unwinder compute the wrong starting
-    // address for the functions with the folded entries, which in turn would
-    // cause the personality function to misinterpret the LSDA for those
-    // functions. In the very rare case where the base address is encoded
-    // directly in the LSDA, two functions at different addresses would
-    // necessarily have different LSDAs, so their CU entries would not have been
-    // folded anyway.
-    while (++foldEnd < cuIndices.end() &&
-           cuEntries[*foldBegin].encoding == cuEntries[*foldEnd].encoding &&
-           !cuEntries[*foldBegin].lsda && !cuEntries[*foldEnd].lsda &&
+  // Fold adjacent entries with matching encoding+personality and without LSDA.
+  // The conditions are equalities between neighbors, so a sequence of entries
+  // can be folded into its first one iff each of them can be folded into the
+  // one before it. We decide that for all the entries in parallel, then keep
+  // the first entry of each sequence in-situ.
+  auto canFoldInto = [&](const CompactUnwindEntry &prev,
+                         const CompactUnwindEntry &cu) {
+    // Common LSDA encodings (e.g. for C++ and Objective-C) contain offsets
+    // from a base address. The base address is normally not contained directly
+    // in the LSDA, and in that case, the personality function treats the
+    // starting address of the function (which is computed by the unwinder) as
+    // the base address and interprets the LSDA accordingly. The unwinder
+    // computes the starting address of a function as the address associated
+    // with its CU entry. For this reason, we cannot fold adjacent entries if
+    // they have an LSDA, because folding would make the unwinder compute the
+    // wrong starting address for the functions with the folded entries, which
+    // in turn would cause the personality function to misinterpret the LSDA
+    // for those functions. In the very rare case where the base address is
+    // encoded directly in the LSDA, two functions at different addresses would
+    // necessarily have different LSDAs, so their CU entries would not have
+    // been folded anyway.
+    return prev.encoding == cu.encoding && !prev.lsda && !cu.lsda &&
            // If we've gotten to this point, we don't have an LSDA, which should
-           // also imply that we don't have a personality function, since in all
-           // likelihood a personality function needs the LSDA to do anything
-           // useful. It can be technically valid to have a personality function
-           // and no LSDA though (e.g. the C++ personality __gxx_personality_v0
-           // is just a no-op without LSDA), so we still check for personality
-           // function equivalence to handle that case.
-           cuEntries[*foldBegin].personality ==
-               cuEntries[*foldEnd].personality &&
-           canFoldEncoding(cuEntries[*foldEnd].encoding))
-      ;
-    *foldWrite++ = *foldBegin;
-    foldBegin = foldEnd;
-  }
+           // also imply that we don't have a personality function, since in
+           // all likelihood a personality function needs the LSDA to do
+           // anything useful. It can be technically valid to have a
+           // personality function and no LSDA though (e.g. the C++
+           // personality __gxx_personality_v0 is just a no-op without LSDA),
+           // so we still check for personality function equivalence to handle
+           // that case.
+           prev.personality == cu.personality && canFoldEncoding(cu.encoding);
+  };
+  std::vector<uint8_t> folded(cuIndices.size());
+  parallelFor(1, cuIndices.size(), [&](size_t i) {
+    folded[i] =
+        canFoldInto(cuEntries[cuIndices[i - 1]], cuEntries[cuIndices[i]]);
+  });
+  auto foldWrite = cuIndices.begin();
+  for (size_t i = 0, e = cuIndices.size(); i != e; ++i)
+    if (!folded[i])
+      *foldWrite++ = cuIndices[i];
+  size_t numFunctions = cuIndices.size();
   cuIndices.erase(foldWrite, cuIndices.end());
 
   encodePersonalities();
@@ -560,6 +565,7 @@ void UnwindInfoSectionImpl::finalize() {
   //     and 127..255 references a local per-second-level-page table.
   // First we try the compact format and determine how many entries fit.
   // If more entries fit in the regular format, we use that.
+  size_t numCommonEncodingEntries = 0;
   for (size_t i = 0; i < cuIndices.size();) {
     size_t idx = cuIndices[i];
     secondLevelPages.emplace_back();
@@ -572,13 +578,15 @@ void UnwindInfoSectionImpl::finalize() {
         SECOND_LEVEL_PAGE_WORDS -
         sizeof(unwind_info_compressed_second_level_page_header) /
             sizeof(uint32_t);
+    size_t pageCommonEncodingEntries = 0;
     while (wordsRemaining >= 1 && i < cuIndices.size()) {
       idx = cuIndices[i];
       const CompactUnwindEntry *cuPtr = &cuEntries[idx];
       if (cuPtr->functionAddress >= functionAddressMax)
         break;
-      if (commonEncodingIndexes.count(cuPtr->encoding) ||
-          page.localEncodingIndexes.count(cuPtr->encoding)) {
+      bool isCommon = commonEncodingIndexes.count(cuPtr->encoding);
+      if (isCommon || page.localEncodingIndexes.count(cuPtr->encoding)) {
+        pageCommonEncodingEntries += isCommon;
         i++;
         wordsRemaining--;
       } else if (wordsRemaining >= 2 && n < COMPACT_ENCODINGS_MAX) {
@@ -603,9 +611,21 @@ void UnwindInfoSectionImpl::finalize() {
       i = page.entryIndex + page.entryCount;
     } else {
       page.kind = UNWIND_SECOND_LEVEL_COMPRESSED;
+      numCommonEncodingEntries += pageCommonEncodingEntries;
     }
   }
 
+  size_t numCompressedPages =
+      count_if(secondLevelPages, [](const SecondLevelPage &page) {
+        return page.kind == UNWIND_SECOND_LEVEL_COMPRESSED;
+      });
+  log("unwind info: " + Twine(numFunctions) + " functions folded into " +
+      Twine(cuIndices.size()) + " entries, " + Twine(commonEncodings.size()) +
+      " common encodings used by " + Twine(numCommonEncodingEntries) +
+      " entries, " + Twine(numCompressedPages) + " compressed and " +
+      Twine(secondLevelPages.size() - numCompressedPages) +
+      " regular second-level pages");
+
   for (size_t idx : cuIndices) {
     lsdaIndex[idx] = entriesWithLsda.size();
     if (cuEntries[idx].lsda)
@@ -692,9 +712,11 @@ void UnwindInfoSectionImpl::writeTo(uint8_t *buf) const {
     lep++;
   }
 
-  // Level-2 pages
-  auto *pp = reinterpret_cast<uint32_t *>(lep);
-  for (const SecondLevelPage &page : secondLevelPages) {
+  // Level-2 pages. Each one fills its own fixed-size slot.
+  auto *pagesBegin = reinterpret_cast<uint32_t *>(lep);
+  parallelFor(0, secondLevelPages.size(), [&](size_t pageIdx) {
+    const SecondLevelPage &page = secondLevelPages[pageIdx];
+    uint32_t *pp = pagesBegin + pageIdx * SECOND_LEVEL_PAGE_WORDS;
     if (page.kind == UNWIND_SECOND_LEVEL_COMPRESSED) {
       uintptr_t functionAddressBase =
           cuEntries[cuIndices[page.entryIndex]].functionAddress;
@@ -736,8 +758,7 @@ void UnwindInfoSectionImpl::writeTo(uint8_t *buf) const {
         *ep++ = cue.encoding;
       }
     }
-    pp += SECOND_LEVEL_PAGE_WORDS;
-  }
+  });
 }
 
 UnwindInfoSection *macho::makeUnwindInfoSection() {
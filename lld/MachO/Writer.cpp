@@ -25,6 +25,7 @@
 #include "lld/Common/CommonLinkerContext.h"
 #include "llvm/BinaryFormat/MachO.h"
 #include "llvm/Config/llvm-config.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
@@ -1258,35 +1259,77 @@ void Writer::buildFixupChains() {
   const uint64_t pageSize = target->getPageSize();
   constexpr uint32_t stride = 4; // for DYLD_CHAINED_PTR_64
 
-  for (size_t i = 0, count = loc.size(); i < count;) {
-    const OutputSegment *oseg = loc[i].isec->parent->parent;
+  // Each page's chain is independent of all other pages, so link them in
+  // parallel. A page stops at its first invalid fixup, and only the error for
+  // the lowest such fixup is reported so that diagnostics are deterministic.
+  ArrayRef<size_t> pages = in.chainedFixups->getPageBoundaries();
+  size_t numPages = pages.size() - 1;
+  std::vector<size_t> failedAt(numPages, loc.size());
+  std::vector<uint32_t> numBinds;
+  if (!config->printChainedFixupStats.empty())
+    numBinds.resize(numPages);
+
+  parallelFor(0, numPages, [&](size_t page) {
+    const OutputSegment *oseg = loc[pages[page]].isec->parent->parent;
     uint8_t *buf = buffer->getBufferStart() + oseg->fileOff;
-    uint64_t pageIdx = loc[i].offset / pageSize;
-    ++i;
-
-    while (i < count && loc[i].isec->parent->parent == oseg &&
-           (loc[i].offset / pageSize) == pageIdx) {
+    for (size_t i = pages[page] + 1, e = pages[page + 1]; i < e; ++i) {
       uint64_t offset = loc[i].offset - loc[i - 1].offset;
-
-      auto fail = [&](Twine message) {
-        error(loc[i].isec->getSegName() + "," + loc[i].isec->getName() +
-              ", offset " +
-              Twine(loc[i].offset - loc[i].isec->parent->getSegmentOffset()) +
-              ": " + message);
-      };
-
-      if (offset < target->wordSize)
-        return fail("fixups overlap");
-      if (offset % stride != 0)
-        return fail(
-            "fixups are unaligned (offset " + Twine(offset) +
-            " is not a multiple of the stride). Re-link with -no_fixup_chains");
-
+      if (offset < target->wordSize || offset % stride != 0) {
+        failedAt[page] = i;
+        return;
+      }
       // The "next" field is in the same location for bind and rebase entries.
       reinterpret_cast<dyld_chained_ptr_64_bind *>(buf + loc[i - 1].offset)
           ->next = offset / stride;
-      ++i;
     }
+    if (!numBinds.empty())
+      for (size_t i = pages[page], e = pages[page + 1]; i < e; ++i)
+        numBinds[page] +=
+            reinterpret_cast<dyld_chained_ptr_64_bind *>(buf + loc[i].offset)
+                ->bind;
+  });
+
+  for (size_t i : failedAt) {
+    if (i == loc.size())
+      continue;
+    uint64_t offset = loc[i].offset - loc[i - 1].offset;
+    std::string prefix =
+        (loc[i].isec->getSegName() + "," + loc[i].isec->getName() +
+         ", offset " +
+         Twine(loc[i].offset - loc[i].isec->parent->getSegmentOffset()))
+            .str();
+    if (offset < target->wordSize)
+      error(prefix + ": fixups overlap");
+    else
+      error(prefix + ": fixups are unaligned (offset " + Twine(offset) +
+            " is not a multiple of the stride). Re-link with -no_fixup_chains");
+    return;
+  }
+
+  if (config->printChainedFixupStats.empty())
+    return;
+  std::error_code ec;
+  raw_fd_ostream os(config->printChainedFixupStats, ec, sys::fs::OF_None);
+  if (ec) {
+    error("cannot open " + config->printChainedFixupStats + ": " +
+          ec.message());
+    return;
+  }
+  // One line per page with fixups, so that the density of dirty pages can be
+  // compared across orderings (e.g. with --symbol-ordering-file or
+  // --bp-compression-sort).
+  size_t totalBinds = 0;
+  for (uint32_t n : numBinds)
+    totalBinds += n;
+  os << "# pages with fixups: " << numPages << "\n";
+  os << "# binds: " << totalBinds << "\n";
+  os << "# rebases: " << loc.size() - totalBinds << "\n";
+  os << "# segment\tpage\tbinds\trebases\n";
+  for (size_t page = 0; page != numPages; ++page) {
+    const Location &first = loc[pages[page]];
+    uint32_t fixups = pages[page + 1] - pages[page];
+    os << first.isec->parent->parent->name << '\t' << first.offset / pageSize
+       << '\t' << numBinds[page] << '\t' << fixups - numBinds[page] << '\n';
   }
 }
 
@@ -22,6 +22,7 @@
 #include "lld/Common/ErrorHandler.h"
 #include "lld/Common/Memory.h"
 #include "llvm/Support/StringSaver.h"
+#include <mutex>
 
 namespace llvm {
 class raw_ostream;
@@ -40,6 +41,10 @@ public:
   llvm::StringSaver saver{bAlloc};
   llvm::UniqueStringSaver uniqueSaver{bAlloc};
   llvm::DenseMap<void *, SpecificAllocBase *> instances;
+  // Arenas created by SpecificAllocBase::getOrCreatePerThread(), guarded by
+  // perThreadMutex.
+  llvm::DenseMap<void *, SpecificAllocBase *> perThreadInstances;
+  std::mutex perThreadMutex;
 
   ErrorHandler e;
 };
@@ -22,6 +22,9 @@
 #define LLD_COMMON_MEMORY_H
 
 #include "llvm/Support/Allocator.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/PerThreadBumpPtrAllocator.h"
+#include <atomic>
 
 namespace lld {
 // A base class only used by the CommonLinkerContext to keep track of the
@@ -30,6 +33,15 @@ struct SpecificAllocBase {
   virtual ~SpecificAllocBase() = default;
   static SpecificAllocBase *getOrCreate(void *tag, size_t size, size_t align,
                                         SpecificAllocBase *(&creator)(void *));
+  // Like getOrCreate(), but for arenas used by the threads of the parallel
+  // executor. This may be called concurrently, including with getOrCreate().
+  static SpecificAllocBase *
+  getOrCreatePerThread(void *tag, size_t size, size_t align,
+                       SpecificAllocBase *(&creator)(void *));
+
+  // Incremented for each CommonLinkerContext, so that threads can tell
+  // whether an arena they cached belongs to the current context.
+  static std::atomic<uint64_t> generation;
 };
 
 // An arena of specific types T, created on-demand.
@@ -55,9 +67,46 @@ inline llvm::SpecificBumpPtrAllocator<T> &getSpecificAllocSingleton() {
   return ((SpecificAlloc<T> *)instance)->alloc;
 }
 
+// An arena of specific types T with one allocator per thread of the parallel
+// executor, created on-demand.
+template <class T> struct SpecificPerThreadAlloc : public SpecificAllocBase {
+  static SpecificAllocBase *create(void *storage) {
+    return new (storage) SpecificPerThreadAlloc<T>();
+  }
+  llvm::parallel::PerThreadAllocator<llvm::SpecificBumpPtrAllocator<T>> alloc;
+  static int tag;
+};
+
+template <class T> int SpecificPerThreadAlloc<T>::tag = 0;
+
+// Returns the calling thread's allocator of the per-thread arena for T. Must
+// be called from a thread of the parallel executor.
+template <typename T>
+inline llvm::SpecificBumpPtrAllocator<T> &getSpecificPerThreadAllocSingleton() {
+  // Looking up the arena takes a lock, so remember it for the current context.
+  thread_local uint64_t cachedGeneration = 0;
+  thread_local SpecificPerThreadAlloc<T> *cached = nullptr;
+  uint64_t gen = SpecificAllocBase::generation.load(std::memory_order_relaxed);
+  if (cachedGeneration != gen) {
+    SpecificAllocBase *instance = SpecificAllocBase::getOrCreatePerThread(
+        &SpecificPerThreadAlloc<T>::tag, sizeof(SpecificPerThreadAlloc<T>),
+        alignof(SpecificPerThreadAlloc<T>), SpecificPerThreadAlloc<T>::create);
+    cached = (SpecificPerThreadAlloc<T> *)instance;
+    cachedGeneration = gen;
+  }
+  return cached->alloc.getThreadLocalAllocator();
+}
+
 // Creates new instances of T off a (almost) contiguous arena/object pool. The
 // instances are destroyed whenever lldMain() goes out of scope.
+//
+// This may be called from the bodies of parallelFor and friends: threads of
+// the parallel executor allocate from their own bump regions, so they neither
+// contend with each other nor race with the main thread.
 template <typename T, typename... U> T *make(U &&... args) {
+  if (llvm::parallel::isExecutorThread())
+    return new (getSpecificPerThreadAllocSingleton<T>().Allocate())
+        T(std::forward<U>(args)...);
   return new (getSpecificAllocSingleton<T>().Allocate())
       T(std::forward<U>(args)...);
 }
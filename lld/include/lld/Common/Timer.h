@@ -18,6 +18,10 @@
 #include <memory>
 #include <vector>
 
+namespace llvm::json {
+class OStream;
+}
+
 namespace lld {
 
 class Timer;
@@ -30,6 +34,8 @@ struct ScopedTimer {
   void stop();
 
   std::chrono::time_point<std::chrono::high_resolution_clock> startTime;
+  std::chrono::nanoseconds startCpuTime{0};
+  size_t startPeakMemory = 0;
 
   Timer *t = nullptr;
 };
@@ -42,16 +48,34 @@ public:
   explicit Timer(llvm::StringRef name);
 
   void addToTotal(std::chrono::nanoseconds time) { total += time.count(); }
+  void addToCpuTotal(std::chrono::nanoseconds time) {
+    cpuTotal += time.count();
+  }
+  void addToPeakMemoryGrowth(size_t bytes) { peakMemoryGrowth += bytes; }
   void print();
 
+  // Makes ScopedTimer also measure the CPU time and peak memory growth of
+  // this timer and its children. This costs extra system calls per scope, so
+  // it is off by default.
+  void enableUsageTracking();
+  bool isTrackingUsage() const { return trackUsage; }
+
+  // Writes this timer and its children as a JSON object with the wall time,
+  // the CPU time of all threads of the process, and how much the peak
+  // resident set size grew while the timer was running.
+  void writeJSON(llvm::json::OStream &os) const;
+
   double millis() const;
 
 private:
   void print(int depth, double totalDuration, bool recurse = true) const;
 
   std::atomic<std::chrono::nanoseconds::rep> total;
+  std::atomic<std::chrono::nanoseconds::rep> cpuTotal;
+  std::atomic<size_t> peakMemoryGrowth;
   std::vector<Timer *> children;
   std::string name;
+  bool trackUsage = false;
 };
 
 } // namespace lld
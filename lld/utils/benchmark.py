@@ -0,0 +1,240 @@
+#!/usr/bin/env python3
+#
+# ==------------------------------------------------------------------------==#
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+# ==------------------------------------------------------------------------==#
+"""Replay --reproduce archives to benchmark lld.
+
+Each archive written by --reproduce= (ELF, MachO, wasm) or /reproduce:
+(COFF) is extracted once, and the link is run repeatedly from the extracted
+directory with --time-trace enabled. For every archive this records the
+median and minimum wall time, the peak RSS of the linker process, and the
+total time of each phase reported in the time trace (not available for
+wasm, which has no --time-trace).
+
+Results are written as JSON. Passing --baseline compares the new results
+against a previous run and exits with status 1 if any archive or phase got
+slower by more than --threshold percent.
+
+  benchmark.py --lld build/bin/lld --runs 5 -o new.json corpus/*.tar
+  benchmark.py --lld build/bin/lld --baseline old.json corpus/*.tar
+"""
+
+import argparse
+import json
+import os
+import shlex
+import shutil
+import statistics
+import subprocess
+import sys
+import tarfile
+import tempfile
+import time
+
+FLAVORS = ("gnu", "darwin", "link", "wasm")
+
+# Options that only wasm-ld accepts. ELF shares --export-dynamic and
+# --export-dynamic-symbol, so a plain --export* prefix match is not enough.
+WASM_FLAGS = (
+    "--export",
+    "--export-if-defined",
+    "--export-all",
+    "--export-table",
+    "--export-memory",
+    "--import-memory",
+    "--import-table",
+    "--no-entry",
+    "--stack-first",
+)
+WASM_JOINED_FLAGS = (
+    "--export=",
+    "--export-if-defined=",
+    "--export-memory=",
+    "--import-memory=",
+    "--initial-memory=",
+)
+
+
+def detect_flavor(args):
+    """Guess the lld flavor from the arguments in response.txt."""
+    for arg in args:
+        lower = arg.lower()
+        if lower.startswith(("/out:", "-out:", "/machine:", "-machine:")):
+            return "link"
+        if arg in ("-arch", "-platform_version", "-dylib", "-execute"):
+            return "darwin"
+        if (
+            arg.endswith(".wasm")
+            or arg in WASM_FLAGS
+            or arg.startswith(WASM_JOINED_FLAGS)
+        ):
+            return "wasm"
+    return "gnu"
+
+
+def extract(archive, dest):
+    """Extract a reproduce tarball and return the directory with response.txt."""
+    with tarfile.open(archive) as tar:
+        tar.extractall(dest)
+    for root, _, files in os.walk(dest):
+        if "response.txt" in files:
+            return root
+    sys.exit("error: %s: no response.txt found" % archive)
+
+
+def read_phases(trace_path):
+    """Return {phase: milliseconds} from the "Total" events of a time trace."""
+    with open(trace_path) as f:
+        trace = json.load(f)
+    phases = {}
+    for event in trace.get("traceEvents", []):
+        name = event.get("name", "")
+        if event.get("ph") == "X" and name.startswith("Total "):
+            phases[name[len("Total ") :]] = event.get("dur", 0) / 1000.0
+    return phases
+
+
+def run_once(cmd, cwd):
+    """Run cmd and return (wall seconds, peak RSS in bytes)."""
+    with tempfile.TemporaryFile() as stderr:
+        start = time.perf_counter()
+        proc = subprocess.Popen(cmd, cwd=cwd, stdout=subprocess.DEVNULL, stderr=stderr)
+        # wait4 reports the resource usage of this child only, unlike
+        # getrusage(RUSAGE_CHILDREN) which accumulates over all children.
+        _, status, usage = os.wait4(proc.pid, 0)
+        wall = time.perf_counter() - start
+        if os.waitstatus_to_exitcode(status) != 0:
+            stderr.seek(0)
+            sys.exit(
+                "error: %s failed in %s:\n%s"
+                % (shlex.join(cmd), cwd, stderr.read().decode(errors="replace"))
+            )
+    # ru_maxrss is in bytes on macOS and in kilobytes elsewhere.
+    rss = usage.ru_maxrss if sys.platform == "darwin" else usage.ru_maxrss * 1024
+    return wall, rss
+
+
+def benchmark(archive, opts):
+    tmp = tempfile.mkdtemp(prefix="lld-bench-")
+    try:
+        root = extract(archive, tmp)
+        with open(os.path.join(root, "response.txt")) as f:
+            response = shlex.split(f.read())
+        flavor = opts.flavor or detect_flavor(response)
+        trace = os.path.join(tmp, "trace.json")
+        cmd = [opts.lld, "-flavor", flavor, "@response.txt"]
+        # ELF, MachO and lld-link accept --time-trace=<file>; wasm-ld has no
+        # time trace support, so only wall time and RSS are recorded for it.
+        has_trace = flavor != "wasm"
+        if has_trace:
+            cmd.append("--time-trace=" + trace)
+        if opts.threads:
+            threads = "/threads:" if flavor == "link" else "--threads="
+            cmd.append(threads + str(opts.threads))
+
+        walls, rsses, phases = [], [], {}
+        for _ in range(opts.runs):
+            wall, rss = run_once(cmd, root)
+            walls.append(wall * 1000.0)
+            rsses.append(rss)
+            if not has_trace:
+                continue
+            for name, ms in read_phases(trace).items():
+                phases.setdefault(name, []).append(ms)
+        return {
+            "flavor": flavor,
+            "runs": opts.runs,
+            "wall_ms": statistics.median(walls),
+            "min_wall_ms": min(walls),
+            "peak_rss": max(rsses),
+            "phases": {k: statistics.median(v) for k, v in sorted(phases.items())},
+        }
+    finally:
+        shutil.rmtree(tmp, ignore_errors=True)
+
+
+def compare(results, baseline, threshold):
+    """Print the changes against baseline and return the list of regressions."""
+    regressions = []
+
+    def check(name, label, old, new):
+        if not old:
+            return
+        change = (new - old) / old * 100.0
+        print("  %-40s %10.1f -> %10.1f  %+6.1f%%" % (label, old, new, change))
+        if change > threshold:
+            regressions.append("%s: %s: %+.1f%%" % (name, label, change))
+
+    for name, new in sorted(results.items()):
+        old = baseline.get(name)
+        if not old:
+            print("%s: not in baseline" % name)
+            continue
+        print("%s:" % name)
+        check(name, "wall_ms", old["wall_ms"], new["wall_ms"])
+        check(name, "peak_rss (MiB)", old["peak_rss"] / 2**20, new["peak_rss"] / 2**20)
+        for phase, ms in new["phases"].items():
+            check(name, phase, old["phases"].get(phase), ms)
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument("archives", nargs="+", help="--reproduce tarballs")
+    parser.add_argument("--lld", default="lld", help="path to the lld binary")
+    parser.add_argument(
+        "--flavor", choices=FLAVORS, help="lld flavor (default: guess per archive)"
+    )
+    parser.add_argument("--runs", type=int, default=3, help="links per archive")
+    parser.add_argument("--threads", type=int, help="value for --threads")
+    parser.add_argument("-o", "--output", help="write the results to this file")
+    parser.add_argument("--baseline", help="results of a previous run to compare")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=5.0,
+        help="percentage slowdown reported as a regression (default: 5)",
+    )
+    opts = parser.parse_args()
+    if opts.runs < 1:
+        parser.error("--runs must be positive")
+    # The links run from the extracted archives, so resolve the binary first.
+    lld = shutil.which(opts.lld)
+    if not lld:
+        parser.error("cannot find %s" % opts.lld)
+    opts.lld = os.path.abspath(lld)
+
+    results = {}
+    for archive in opts.archives:
+        name = os.path.basename(archive)
+        print("benchmarking %s..." % name, file=sys.stderr)
+        results[name] = benchmark(archive, opts)
+
+    if opts.output:
+        with open(opts.output, "w") as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+            f.write("\n")
+    elif not opts.baseline:
+        json.dump(results, sys.stdout, indent=2, sort_keys=True)
+        print()
+
+    if opts.baseline:
+        with open(opts.baseline) as f:
+            regressions = compare(results, json.load(f), opts.threshold)
+        if regressions:
+            print("\nregressions over %.1f%%:" % opts.threshold)
+            for r in regressions:
+                print("  " + r)
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
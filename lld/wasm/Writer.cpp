@@ -224,9 +224,18 @@ void Writer::writeHeader() {
 
 void Writer::writeSections() {
   uint8_t *buf = buffer->getBufferStart();
-  parallelForEach(outputSections, [buf](OutputSection *s) {
+  // The code and data sections write their input chunks in parallel. Nested
+  // parallel loops run serially, so write these two from this thread first.
+  auto isChunked = [](OutputSection *s) {
+    return isa<CodeSection>(s) || isa<DataSection>(s);
+  };
+  for (OutputSection *s : outputSections)
+    if (isChunked(s))
+      s->writeTo(buf);
+  parallelForEach(outputSections, [&](OutputSection *s) {
     assert(s->isNeeded());
-    s->writeTo(buf);
+    if (!isChunked(s))
+      s->writeTo(buf);
   });
 }
 
@@ -61,7 +61,8 @@ public:
   ///
   /// Keys must be unique for any given data. This function attempts to see if
   /// the data is available for the specified key and will return a valid memory
-  /// buffer is data is available.
+  /// buffer is data is available. This can be called from multiple threads at
+  /// the same time.
   ///
   /// \param key
   ///   The unique string key that identifies data being cached.
@@ -92,9 +93,8 @@ private:
 
   llvm::FileCache m_cache_callback;
   FileSpec m_cache_dir;
+  /// Serializes writing cache files. Reading them doesn't need the lock.
   std::mutex m_mutex;
-  std::unique_ptr<llvm::MemoryBuffer> m_mem_buff_up;
-  bool m_take_ownership = false;
 };
 
 /// A signature for a given file on disk.
@@ -57,12 +57,18 @@ protected:
   InvalidRanges m_invalid_ranges;
   Process &m_process;
   uint32_t m_L2_cache_line_byte_size;
+  // The address of the L2 cache line after the last ones that were read from
+  // the process, and how many lines were read. A miss on that line starts
+  // reading more lines ahead.
+  lldb::addr_t m_read_ahead_addr = LLDB_INVALID_ADDRESS;
+  uint32_t m_read_ahead_lines = 1;
 
 private:
   MemoryCache(const MemoryCache &) = delete;
   const MemoryCache &operator=(const MemoryCache &) = delete;
 
-  lldb::DataBufferSP GetL2CacheLine(lldb::addr_t addr, Status &error);
+  lldb::DataBufferSP GetL2CacheLine(lldb::addr_t addr, Status &error,
+                                    uint32_t min_lines = 1);
 };
 
     
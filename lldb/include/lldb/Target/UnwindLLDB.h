@@ -9,8 +9,10 @@
 #ifndef LLDB_TARGET_UNWINDLLDB_H
 #define LLDB_TARGET_UNWINDLLDB_H
 
+#include <unordered_map>
 #include <vector>
 
+#include "lldb/Core/AddressRange.h"
 #include "lldb/Symbol/FuncUnwinders.h"
 #include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Symbol/UnwindPlan.h"
@@ -71,6 +73,7 @@ protected:
     m_frames.clear();
     m_candidate_frame.reset();
     m_unwind_complete = false;
+    m_function_scopes.clear();
   }
 
   uint32_t DoGetFrameCount() override;
@@ -111,6 +114,29 @@ protected:
     return m_user_supplied_trap_handler_functions;
   }
 
+  /// Resolve the function and symbol of a pc like
+  /// Address::ResolveFunctionScope.
+  ///
+  /// The result is remembered until the unwinder is cleared at the next stop,
+  /// as a recursive function puts many frames with the same pc on the stack.
+  ///
+  /// \param[in] pc
+  ///     The pc to look up, which must be the load address of \a pc_addr.
+  ///
+  /// \param[in] pc_addr
+  ///     The pc as an address resolved to a section.
+  ///
+  /// \param[out] sym_ctx
+  ///     The symbol context with the function and symbol of the pc.
+  ///
+  /// \param[out] addr_range
+  ///     The address range of the function or symbol.
+  ///
+  /// \return
+  ///     True if a function or a symbol was found.
+  bool ResolveFunctionScope(lldb::addr_t pc, Address &pc_addr,
+                            SymbolContext &sym_ctx, AddressRange &addr_range);
+
 private:
   struct Cursor {
     lldb::addr_t start_pc =
@@ -141,6 +167,14 @@ private:
 
   std::vector<ConstString> m_user_supplied_trap_handler_functions;
 
+  struct FunctionScope {
+    bool valid;
+    SymbolContext sym_ctx;
+    AddressRange addr_range;
+  };
+  /// The function scopes of the pcs of this stop, see ResolveFunctionScope.
+  std::unordered_map<lldb::addr_t, FunctionScope> m_function_scopes;
+
   // Check if Full UnwindPlan of First frame is valid or not.
   // If not then try Fallback UnwindPlan of the frame. If Fallback
   // UnwindPlan succeeds then update the Full UnwindPlan with the
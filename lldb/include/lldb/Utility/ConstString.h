@@ -400,8 +400,12 @@ public:
     size_t GetBytesTotal() const { return bytes_total; }
     size_t GetBytesUsed() const { return bytes_used; }
     size_t GetBytesUnused() const { return bytes_total - bytes_used; }
+    uint64_t GetLockContentions() const { return lock_contentions; }
     size_t bytes_total = 0;
     size_t bytes_used = 0;
+    /// The number of times a thread had to wait for another one to access the
+    /// string pool.
+    uint64_t lock_contentions = 0;
   };
 
   static MemoryStats GetMemoryStats();
@@ -181,6 +181,7 @@ public:
     eServerPacketType_vStopped,
     eServerPacketType_vCtrlC,
     eServerPacketType_vStdio,
+    eServerPacketType_MultiMemRead,
   };
 
   ServerPacketType GetServerPacketType() const;
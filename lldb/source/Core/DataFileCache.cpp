@@ -15,6 +15,7 @@
 #include "lldb/Utility/LLDBLog.h"
 #include "lldb/Utility/Log.h"
 #include "llvm/Support/CachePruning.h"
+#include "llvm/Support/FileSystem.h"
 
 using namespace lldb_private;
 
@@ -48,17 +49,10 @@ DataFileCache::DataFileCache(llvm::StringRef path, llvm::CachePruningPolicy poli
   m_cache_dir.SetPath(path);
   pruneCache(path, policy);
 
-  // This lambda will get called when the data is gotten from the cache and
-  // also after the data was set for a given key. We only need to take
-  // ownership of the data if we are geting the data, so we use the
-  // m_take_ownership member variable to indicate if we need to take
-  // ownership.
-
-  auto add_buffer = [this](unsigned task, const llvm::Twine &moduleName,
-                           std::unique_ptr<llvm::MemoryBuffer> m) {
-    if (m_take_ownership)
-      m_mem_buff_up = std::move(m);
-  };
+  // This lambda will get called after the data was set for a given key. The
+  // data was just written, so there is nothing to do with the buffer.
+  auto add_buffer = [](unsigned task, const llvm::Twine &moduleName,
+                       std::unique_ptr<llvm::MemoryBuffer> m) {};
   llvm::Expected<llvm::FileCache> cache_or_err =
       llvm::localCache("LLDBModuleCache", "lldb-module", path, add_buffer);
   if (cache_or_err)
@@ -72,37 +66,34 @@ DataFileCache::DataFileCache(llvm::StringRef path, llvm::CachePruningPolicy poli
 
 std::unique_ptr<llvm::MemoryBuffer>
 DataFileCache::GetCachedData(llvm::StringRef key) {
-  std::lock_guard<std::mutex> guard(m_mutex);
-
-  const unsigned task = 1;
-  m_take_ownership = true;
-  // If we call the "m_cache_callback" function and the data is cached, it will
-  // call the "add_buffer" lambda function from the constructor which will in
-  // turn take ownership of the member buffer that is passed to the callback and
-  // put it into a member variable.
-  llvm::Expected<llvm::AddStreamFn> add_stream_or_err =
-      m_cache_callback(task, key, "");
-  m_take_ownership = false;
-  // At this point we either already called the "add_buffer" lambda with
-  // the data or we haven't. We can tell if we got the cached data by checking
-  // the add_stream function pointer value below.
-  if (add_stream_or_err) {
-    llvm::AddStreamFn &add_stream = *add_stream_or_err;
-    // If the "add_stream" is nullptr, then the data was cached and we already
-    // called the "add_buffer" lambda. If it is valid, then if we were to call
-    // the add_stream function it would cause a cache file to get generated
-    // and we would be expected to fill in the data. In this function we only
-    // want to check if the data was cached, so we don't want to call
-    // "add_stream" in this function.
-    if (!add_stream)
-      return std::move(m_mem_buff_up);
-  } else {
+  // The llvm caching code writes a cache file to a temporary file and renames
+  // it into place, so a cache file is always complete and can be read without
+  // holding m_mutex. This lets many modules get their cached data at the same
+  // time when they are loaded in parallel. The file is opened the same way the
+  // llvm caching code does: the access time is updated so that pruning the
+  // cache removes the least recently used files first, and the data is mapped
+  // into memory instead of being read when the file is large enough.
+  std::string cache_path = GetCacheFilePath(key).GetPath();
+  llvm::Expected<llvm::sys::fs::file_t> fd_or_err =
+      llvm::sys::fs::openNativeFileForRead(cache_path,
+                                           llvm::sys::fs::OF_UpdateAtime);
+  if (!fd_or_err) {
+    // Data was not cached.
+    llvm::consumeError(fd_or_err.takeError());
+    return std::unique_ptr<llvm::MemoryBuffer>();
+  }
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer_or_err =
+      llvm::MemoryBuffer::getOpenFile(*fd_or_err, cache_path,
+                                      /*FileSize=*/-1,
+                                      /*RequiresNullTerminator=*/false);
+  llvm::sys::fs::closeFile(*fd_or_err);
+  if (!buffer_or_err) {
     Log *log = GetLog(LLDBLog::Modules);
-    LLDB_LOG_ERROR(log, add_stream_or_err.takeError(),
-                   "failed to get the cache add stream callback for key: {0}");
+    LLDB_LOG(log, "failed to read the cache file for key {0}: {1}", key,
+             buffer_or_err.getError().message());
+    return std::unique_ptr<llvm::MemoryBuffer>();
   }
-  // Data was not cached.
-  return std::unique_ptr<llvm::MemoryBuffer>();
+  return std::move(*buffer_or_err);
 }
 
 bool DataFileCache::SetCachedData(llvm::StringRef key,
@@ -11,6 +11,8 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "DYLDRendezvous.h"
 #include "Plugins/Process/Utility/AuxVector.h"
@@ -96,6 +98,9 @@ protected:
   /// Loaded module list. (link map for each module)
   std::map<lldb::ModuleWP, lldb::addr_t, std::owner_less<lldb::ModuleWP>>
       m_loaded_modules;
+  /// Protects m_loaded_modules, which is updated while modules are loaded in
+  /// parallel.
+  std::mutex m_loaded_modules_mutex;
 
   /// Returns true if the process is for a core file.
   bool IsCoreFile() const;
@@ -152,6 +157,12 @@ protected:
   /// of all dependent modules.
   virtual void LoadAllCurrentModules();
 
+  /// Loads the modules of \p entries, in parallel if the target allows it.
+  /// Returns the modules in the order of the entries, with a null module for
+  /// each entry that could not be loaded.
+  std::vector<lldb::ModuleSP>
+  LoadModulesAtAddresses(const std::vector<DYLDRendezvous::SOEntry> &entries);
+
   void LoadVDSO();
 
   // Loading an interpreter module (if present) assuming m_interpreter_base
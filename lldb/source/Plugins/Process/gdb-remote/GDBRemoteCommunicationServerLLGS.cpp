@@ -94,6 +94,9 @@ void GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers() {
       &GDBRemoteCommunicationServerLLGS::Handle_memory_read);
   RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_M,
                                 &GDBRemoteCommunicationServerLLGS::Handle_M);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_MultiMemRead,
+      &GDBRemoteCommunicationServerLLGS::Handle_MultiMemRead);
   RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType__M,
                                 &GDBRemoteCommunicationServerLLGS::Handle__M);
   RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType__m,
@@ -2548,6 +2551,75 @@ GDBRemoteCommunicationServerLLGS::Handle_memory_read(
   return SendPacketNoLock(response.GetString());
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_MultiMemRead(
+    StringExtractorGDBRemote &packet) {
+  Log *log = GetLog(LLDBLog::Process);
+
+  if (!m_current_process ||
+      (m_current_process->GetID() == LLDB_INVALID_PROCESS_ID)) {
+    LLDB_LOGF(
+        log,
+        "GDBRemoteCommunicationServerLLGS::%s failed, no process available",
+        __FUNCTION__);
+    return SendErrorResponse(0x15);
+  }
+
+  // The packet is "MultiMemRead:ranges:<addr>,<length>,<addr>,<length>,...;"
+  // with all numbers in hex.
+  llvm::StringRef packet_str = packet.GetStringRef();
+  packet_str.consume_front("MultiMemRead:");
+  std::optional<llvm::StringRef> ranges_str;
+  for (llvm::StringRef key_value : llvm::split(packet_str, ';')) {
+    auto [key, value] = key_value.split(':');
+    if (key == "ranges")
+      ranges_str = value;
+  }
+  if (!ranges_str)
+    return SendIllFormedResponse(packet, "No ranges in MultiMemRead packet");
+
+  llvm::SmallVector<llvm::StringRef, 16> numbers;
+  ranges_str->split(numbers, ',', /*MaxSplit=*/-1, /*KeepEmpty=*/false);
+  if (numbers.empty() || numbers.size() % 2 != 0)
+    return SendIllFormedResponse(packet,
+                                 "Malformed ranges in MultiMemRead packet");
+
+  std::vector<std::pair<lldb::addr_t, uint64_t>> ranges;
+  uint64_t total_size = 0;
+  for (size_t i = 0; i < numbers.size(); i += 2) {
+    lldb::addr_t addr;
+    uint64_t size;
+    if (numbers[i].getAsInteger(16, addr) ||
+        numbers[i + 1].getAsInteger(16, size))
+      return SendIllFormedResponse(packet,
+                                   "Malformed ranges in MultiMemRead packet");
+    total_size += size;
+    ranges.emplace_back(addr, size);
+  }
+  // Read all the ranges first as the reply starts with the number of bytes read
+  // in each of them. A range that can't be read gets a length of zero.
+  std::string buf(total_size, '\0');
+  StreamGDBRemote response;
+  size_t buf_size = 0;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    auto [addr, size] = ranges[i];
+    size_t bytes_read = 0;
+    if (size > 0) {
+      Status error = m_current_process->ReadMemoryWithoutTrap(
+          addr, &buf[buf_size], size, bytes_read);
+      LLDB_LOG(log,
+               "ReadMemoryWithoutTrap({0}) read {1} of {2} requested bytes "
+               "(error: {3})",
+               addr, bytes_read, size, error);
+    }
+    buf_size += bytes_read;
+    response.Printf("%s%" PRIx64, i == 0 ? "" : ",", (uint64_t)bytes_read);
+  }
+  response.PutChar(';');
+  response.PutEscapedBytes(buf.data(), buf_size);
+  return SendPacketNoLock(response.GetString());
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle__M(StringExtractorGDBRemote &packet) {
   Log *log = GetLog(LLDBLog::Process);
@@ -4221,6 +4293,7 @@ std::vector<std::string> GDBRemoteCommunicationServerLLGS::HandleFeatures(
                             "QListThreadsInStopReply+",
                             "qXfer:features:read+",
                             "QNonStop+",
+                            "MultiMemRead+",
                         });
 
   // report server-only features
@@ -10,10 +10,12 @@
 
 #include "ThreadMinidump.h"
 
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/DumpDataExtractor.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
+#include "lldb/Core/Progress.h"
 #include "lldb/Core/Section.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
 #include "lldb/Interpreter/CommandObject.h"
@@ -34,6 +36,7 @@
 #include "lldb/Utility/State.h"
 #include "llvm/BinaryFormat/Magic.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/Threading.h"
 
 #include "Plugins/DynamicLoader/POSIX-DYLD/DynamicLoaderPOSIXDYLD.h"
@@ -502,6 +505,9 @@ void ProcessMinidump::ReadModuleList() {
 
   Log *log = GetLog(LLDBLog::DynamicLoader);
 
+  if (filtered_modules.size() > 1 && GetTarget().GetParallelModuleLoad())
+    PreloadModules(filtered_modules);
+
   for (auto module : filtered_modules) {
     std::string name = cantFail(m_minidump_parser->GetMinidumpFile().getString(
         module->ModuleNameRVA));
@@ -585,6 +591,42 @@ void ProcessMinidump::ReadModuleList() {
   }
 }
 
+void ProcessMinidump::PreloadModules(
+    llvm::ArrayRef<const minidump::Module *> modules) {
+  Target &target = GetTarget();
+  const ArchSpec arch = GetArchitecture();
+  const FileSpecList search_paths = target.GetExecutableSearchPaths();
+  const bool preload_symbols = target.GetPreloadSymbols();
+  Progress progress("Loading minidump modules", "", modules.size(),
+                    &target.GetDebugger());
+
+  // Creating a module takes the lock of the shared module list, but
+  // preloading its symbols, which parses its symbol table and indexes its
+  // debug info, does not. That is the part that runs in parallel.
+  llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+  for (const minidump::Module *module : modules) {
+    std::string name = cantFail(
+        m_minidump_parser->GetMinidumpFile().getString(module->ModuleNameRVA));
+    ModuleSpec module_spec(FileSpec(name, arch.GetTriple()),
+                           m_minidump_parser->GetModuleUUID(module));
+    module_spec.GetArchitecture() = arch;
+    if (!module_spec.GetUUID().IsValid()) {
+      progress.Increment(1, name);
+      continue;
+    }
+    task_group.async([&, module_spec = std::move(module_spec),
+                      name = std::move(name)]() {
+      ModuleSP module_sp;
+      ModuleList::GetSharedModule(module_spec, module_sp, &search_paths,
+                                  nullptr, nullptr);
+      if (module_sp && preload_symbols)
+        module_sp->PreloadSymbols();
+      progress.Increment(1, name);
+    });
+  }
+  task_group.wait();
+}
+
 bool ProcessMinidump::GetProcessInfo(ProcessInstanceInfo &info) {
   info.Clear();
   info.SetProcessID(GetID());
@@ -99,6 +99,11 @@ protected:
 
   void ReadModuleList();
 
+  /// Create the modules of the minidump that can be found by their UUID in
+  /// the shared module list, and preload their symbols, on the debugger
+  /// thread pool. ReadModuleList then finds them there.
+  void PreloadModules(llvm::ArrayRef<const minidump::Module *> modules);
+
   lldb::ModuleSP GetOrCreateModule(lldb_private::UUID minidump_uuid,
                                    llvm::StringRef name,
                                    lldb_private::ModuleSpec module_spec);
@@ -36,6 +36,8 @@ void MemoryCache::Clear(bool clear_invalid_ranges) {
   if (clear_invalid_ranges)
     m_invalid_ranges.Clear();
   m_L2_cache_line_byte_size = m_process.GetMemoryCacheLineSize();
+  m_read_ahead_addr = LLDB_INVALID_ADDRESS;
+  m_read_ahead_lines = 1;
 }
 
 void MemoryCache::AddL1CacheData(lldb::addr_t addr, const void *src,
@@ -123,8 +125,12 @@ bool MemoryCache::RemoveInvalidRange(lldb::addr_t base_addr,
   return false;
 }
 
+// The most L2 cache lines read ahead of the one that is needed.
+static const uint32_t g_max_read_ahead_lines = 8;
+
 lldb::DataBufferSP MemoryCache::GetL2CacheLine(lldb::addr_t line_base_addr,
-                                               Status &error) {
+                                               Status &error,
+                                               uint32_t min_lines) {
   // This function assumes that the address given is aligned correctly.
   assert((line_base_addr % m_L2_cache_line_byte_size) == 0);
 
@@ -133,22 +139,59 @@ lldb::DataBufferSP MemoryCache::GetL2CacheLine(lldb::addr_t line_base_addr,
   if (pos != m_L2_cache.end())
     return pos->second;
 
-  auto data_buffer_heap_sp =
-      std::make_shared<DataBufferHeap>(m_L2_cache_line_byte_size, 0);
+  // Each read from the process can be a round trip to a remote stub, which
+  // costs much more than reading a few more bytes. When memory is scanned,
+  // like a string or an array read a piece at a time, the miss is on the line
+  // right after the ones we read last, so read twice as many lines ahead each
+  // time this happens. Any other miss only reads the lines that are needed.
+  if (line_base_addr == m_read_ahead_addr)
+    m_read_ahead_lines =
+        std::min(m_read_ahead_lines * 2, g_max_read_ahead_lines);
+  else
+    m_read_ahead_lines = 1;
+
+  // Don't read lines we already have or that are known to be unreadable.
+  const uint32_t cache_line_byte_size = m_L2_cache_line_byte_size;
+  const uint32_t max_lines = std::max(m_read_ahead_lines, min_lines);
+  uint32_t num_lines = 1;
+  for (; num_lines < max_lines; ++num_lines) {
+    const addr_t line_addr = line_base_addr + num_lines * cache_line_byte_size;
+    if (line_addr < line_base_addr || m_L2_cache.count(line_addr) ||
+        m_invalid_ranges.FindEntryThatContains(line_addr))
+      break;
+  }
+
+  DataBufferHeap data(num_lines * cache_line_byte_size, 0);
   size_t process_bytes_read = m_process.ReadMemoryFromInferior(
-      line_base_addr, data_buffer_heap_sp->GetBytes(),
-      data_buffer_heap_sp->GetByteSize(), error);
+      line_base_addr, data.GetBytes(), data.GetByteSize(), error);
+  // Some stubs fail the whole read if any of it is unreadable, read only the
+  // line we were asked for then.
+  if (process_bytes_read == 0 && num_lines > 1) {
+    num_lines = 1;
+    process_bytes_read = m_process.ReadMemoryFromInferior(
+        line_base_addr, data.GetBytes(), cache_line_byte_size, error);
+  }
+  m_read_ahead_addr = line_base_addr + num_lines * cache_line_byte_size;
 
   // If we failed a read, not much we can do.
   if (process_bytes_read == 0)
     return lldb::DataBufferSP();
 
   // If we didn't get a complete read, we can still cache what we did get.
-  if (process_bytes_read < m_L2_cache_line_byte_size)
-    data_buffer_heap_sp->SetByteSize(process_bytes_read);
-
-  m_L2_cache[line_base_addr] = data_buffer_heap_sp;
-  return data_buffer_heap_sp;
+  lldb::DataBufferSP first_line_sp;
+  for (uint32_t i = 0; i < num_lines; ++i) {
+    const size_t line_offset = (size_t)i * cache_line_byte_size;
+    if (line_offset >= process_bytes_read)
+      break;
+    const size_t line_bytes = std::min<size_t>(
+        cache_line_byte_size, process_bytes_read - line_offset);
+    auto data_buffer_heap_sp = std::make_shared<DataBufferHeap>(
+        data.GetBytes() + line_offset, line_bytes);
+    m_L2_cache[line_base_addr + line_offset] = data_buffer_heap_sp;
+    if (i == 0)
+      first_line_sp = data_buffer_heap_sp;
+  }
+  return first_line_sp;
 }
 
 size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
@@ -206,7 +249,10 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
   // We're going to have all of our loads and reads be cache line aligned.
   addr_t cache_line_offset = addr % m_L2_cache_line_byte_size;
   addr_t cache_line_base_addr = addr - cache_line_offset;
-  DataBufferSP first_cache_line = GetL2CacheLine(cache_line_base_addr, error);
+  const uint32_t num_lines =
+      cache_line_offset + dst_len > m_L2_cache_line_byte_size ? 2 : 1;
+  DataBufferSP first_cache_line =
+      GetL2CacheLine(cache_line_base_addr, error, num_lines);
   // If we get nothing, then the read to the inferior likely failed. Nothing to
   // do here.
   if (!first_cache_line)
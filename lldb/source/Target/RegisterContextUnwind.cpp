@@ -159,7 +159,8 @@ void RegisterContextUnwind::InitializeZerothFrame() {
   }
 
   AddressRange addr_range;
-  m_sym_ctx_valid = m_current_pc.ResolveFunctionScope(m_sym_ctx, &addr_range);
+  m_sym_ctx_valid = m_parent_unwind.ResolveFunctionScope(
+      current_pc, m_current_pc, m_sym_ctx, addr_range);
 
   if (m_sym_ctx.symbol) {
     UnwindLogMsg("with pc value of 0x%" PRIx64 ", symbol name is '%s'",
@@ -496,7 +497,8 @@ void RegisterContextUnwind::InitializeNonZerothFrame() {
   }
 
   AddressRange addr_range;
-  m_sym_ctx_valid = m_current_pc.ResolveFunctionScope(m_sym_ctx, &addr_range);
+  m_sym_ctx_valid = m_parent_unwind.ResolveFunctionScope(pc, m_current_pc,
+                                                         m_sym_ctx, addr_range);
 
   if (m_sym_ctx.symbol) {
     UnwindLogMsg("with pc value of 0x%" PRIx64 ", symbol name is '%s'", pc,
@@ -555,7 +557,8 @@ void RegisterContextUnwind::InitializeNonZerothFrame() {
     Address temporary_pc;
     temporary_pc.SetLoadAddress(pc - 1, &process->GetTarget());
     m_sym_ctx.Clear(false);
-    m_sym_ctx_valid = temporary_pc.ResolveFunctionScope(m_sym_ctx, &addr_range);
+    m_sym_ctx_valid = m_parent_unwind.ResolveFunctionScope(
+        pc - 1, temporary_pc, m_sym_ctx, addr_range);
 
     UnwindLogMsg("Symbol is now %s",
                  GetSymbolOrFunctionName(m_sym_ctx).AsCString(""));
@@ -99,6 +99,7 @@ llvm::json::Value ConstStringStats::ToJSON() const {
   obj.try_emplace<int64_t>("bytesTotal", stats.GetBytesTotal());
   obj.try_emplace<int64_t>("bytesUsed", stats.GetBytesUsed());
   obj.try_emplace<int64_t>("bytesUnused", stats.GetBytesUnused());
+  obj.try_emplace<int64_t>("lockContentions", stats.GetLockContentions());
   return obj;
 }
 
@@ -436,8 +436,12 @@ llvm::Error Trace::OnLiveCpuBinaryDataRead(lldb::cpu_id_t cpu_id,
 
 llvm::Error Trace::OnDataFileRead(FileSpec file,
                                   OnBinaryDataReadCallback callback) {
+  // Trace files can be several gigabytes large and their size is usually a
+  // multiple of the page size, in which case requiring a null terminator
+  // would make MemoryBuffer read the whole file instead of mapping it.
   ErrorOr<std::unique_ptr<MemoryBuffer>> trace_or_error =
-      MemoryBuffer::getFile(file.GetPath());
+      MemoryBuffer::getFile(file.GetPath(), /*IsText=*/false,
+                            /*RequiresNullTerminator=*/false);
   if (std::error_code err = trace_or_error.getError())
     return createStringError(
         inconvertibleErrorCode(), "Failed fetching trace-related file %s. %s",
@@ -465,6 +465,19 @@ UnwindLLDB::DoCreateRegisterContextForFrame(StackFrame *frame) {
   return reg_ctx_sp;
 }
 
+bool UnwindLLDB::ResolveFunctionScope(lldb::addr_t pc, Address &pc_addr,
+                                      SymbolContext &sym_ctx,
+                                      AddressRange &addr_range) {
+  auto [it, inserted] = m_function_scopes.try_emplace(pc);
+  FunctionScope &scope = it->second;
+  if (inserted)
+    scope.valid =
+        pc_addr.ResolveFunctionScope(scope.sym_ctx, &scope.addr_range);
+  sym_ctx = scope.sym_ctx;
+  addr_range = scope.addr_range;
+  return scope.valid;
+}
+
 UnwindLLDB::RegisterContextLLDBSP
 UnwindLLDB::GetRegisterContextForFrameNum(uint32_t frame_num) {
   RegisterContextLLDBSP reg_ctx_sp;
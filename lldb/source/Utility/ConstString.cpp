@@ -19,6 +19,9 @@
 #include "llvm/Support/Threading.h"
 
 #include <array>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 #include <utility>
 
 #include <cinttypes>
@@ -79,8 +82,8 @@ public:
 
   StringPoolValueType GetMangledCounterpart(const char *ccstr) {
     if (ccstr != nullptr) {
-      const PoolEntry &pool = selectPool(llvm::StringRef(ccstr));
-      llvm::sys::SmartScopedReader<false> rlock(pool.m_mutex);
+      PoolEntry &pool = selectPool(llvm::StringRef(ccstr));
+      std::shared_lock<PoolMutex> rlock = LockShared(pool);
       return GetStringMapEntryFromKeyData(ccstr).getValue();
     }
     return nullptr;
@@ -101,21 +104,28 @@ public:
   const char *GetConstCStringWithStringRef(llvm::StringRef string_ref) {
     if (string_ref.data()) {
       const uint32_t string_hash = StringPool::hash(string_ref);
-      PoolEntry &pool = selectPool(string_hash);
 
+      // Strings are never removed from the pool, so a string this thread got
+      // before can be returned without looking at the pool.
+      const char *&recent = g_recent_strings[string_hash % RecentStringsSize];
+      if (recent && GetConstCStringLength(recent) == string_ref.size() &&
+          memcmp(recent, string_ref.data(), string_ref.size()) == 0)
+        return recent;
+
+      PoolEntry &pool = selectPool(string_hash);
       {
-        llvm::sys::SmartScopedReader<false> rlock(pool.m_mutex);
+        std::shared_lock<PoolMutex> rlock = LockShared(pool);
         auto it = pool.m_string_map.find(string_ref, string_hash);
         if (it != pool.m_string_map.end())
-          return it->getKeyData();
+          return recent = it->getKeyData();
       }
 
-      llvm::sys::SmartScopedWriter<false> wlock(pool.m_mutex);
+      std::unique_lock<PoolMutex> wlock = Lock(pool);
       StringPoolEntryType &entry =
           *pool.m_string_map
                .insert(std::make_pair(string_ref, nullptr), string_hash)
                .first;
-      return entry.getKeyData();
+      return recent = entry.getKeyData();
     }
     return nullptr;
   }
@@ -128,7 +138,7 @@ public:
     {
       const uint32_t demangled_hash = StringPool::hash(demangled);
       PoolEntry &pool = selectPool(demangled_hash);
-      llvm::sys::SmartScopedWriter<false> wlock(pool.m_mutex);
+      std::unique_lock<PoolMutex> wlock = Lock(pool);
 
       // Make or update string pool entry with the mangled counterpart
       StringPool &map = pool.m_string_map;
@@ -145,7 +155,7 @@ public:
       // Now assign the demangled const string as the counterpart of the
       // mangled const string...
       PoolEntry &pool = selectPool(llvm::StringRef(mangled_ccstr));
-      llvm::sys::SmartScopedWriter<false> wlock(pool.m_mutex);
+      std::unique_lock<PoolMutex> wlock = Lock(pool);
       GetStringMapEntryFromKeyData(mangled_ccstr).setValue(demangled_ccstr);
     }
 
@@ -169,18 +179,47 @@ public:
       const Allocator &alloc = pool.m_string_map.getAllocator();
       stats.bytes_total += alloc.getTotalMemory();
       stats.bytes_used += alloc.getBytesAllocated();
+      stats.lock_contentions +=
+          pool.m_lock_contentions.load(std::memory_order_relaxed);
     }
     return stats;
   }
 
 protected:
+  typedef llvm::sys::SmartRWMutex<false> PoolMutex;
+
   struct PoolEntry {
-    mutable llvm::sys::SmartRWMutex<false> m_mutex;
+    mutable PoolMutex m_mutex;
     StringPool m_string_map;
+    /// The number of times a thread had to wait for m_mutex.
+    std::atomic<uint64_t> m_lock_contentions{0};
   };
 
   std::array<PoolEntry, 256> m_string_pools;
 
+  /// The number of strings each thread remembers from its recent lookups.
+  static const size_t RecentStringsSize = 256;
+  static thread_local std::array<const char *, RecentStringsSize>
+      g_recent_strings;
+
+  static std::shared_lock<PoolMutex> LockShared(PoolEntry &pool) {
+    std::shared_lock<PoolMutex> lock(pool.m_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+      pool.m_lock_contentions.fetch_add(1, std::memory_order_relaxed);
+      lock.lock();
+    }
+    return lock;
+  }
+
+  static std::unique_lock<PoolMutex> Lock(PoolEntry &pool) {
+    std::unique_lock<PoolMutex> lock(pool.m_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+      pool.m_lock_contentions.fetch_add(1, std::memory_order_relaxed);
+      lock.lock();
+    }
+    return lock;
+  }
+
   PoolEntry &selectPool(const llvm::StringRef &s) {
     return selectPool(StringPool::hash(s));
   }
@@ -190,6 +229,9 @@ protected:
   }
 };
 
+thread_local std::array<const char *, Pool::RecentStringsSize>
+    Pool::g_recent_strings;
+
 // Frameworks and dylibs aren't supposed to have global C++ initializers so we
 // hide the string pool in a static function so that it will get initialized on
 // the first call to this static function.
@@ -9,20 +9,51 @@
 #include "lldb/Utility/StringExtractor.h"
 #include "llvm/ADT/StringExtras.h"
 
+#include <algorithm>
+#include <array>
 #include <tuple>
 
 #include <cctype>
 #include <cstdlib>
 #include <cstring>
 
+// The value of each character as a hex digit, or -1 if it isn't one.
+static constexpr std::array<int8_t, 256> g_xdigit_values = [] {
+  std::array<int8_t, 256> values{};
+  for (int ch = 0; ch < 256; ++ch) {
+    if (ch >= 'a' && ch <= 'f')
+      values[ch] = 10 + ch - 'a';
+    else if (ch >= 'A' && ch <= 'F')
+      values[ch] = 10 + ch - 'A';
+    else if (ch >= '0' && ch <= '9')
+      values[ch] = ch - '0';
+    else
+      values[ch] = -1;
+  }
+  return values;
+}();
+
 static inline int xdigit_to_sint(char ch) {
-  if (ch >= 'a' && ch <= 'f')
-    return 10 + ch - 'a';
-  if (ch >= 'A' && ch <= 'F')
-    return 10 + ch - 'A';
-  if (ch >= '0' && ch <= '9')
-    return ch - '0';
-  return -1;
+  return g_xdigit_values[static_cast<uint8_t>(ch)];
+}
+
+// Decodes the pairs of hex digits at the start of src into dest, until either
+// is exhausted or a character isn't a hex digit, and returns the number of
+// bytes decoded. Memory and register contents are sent as long runs of hex
+// digits, so this avoids the checks DecodeHexU8 does for every byte.
+static size_t DecodeHexBytes(llvm::StringRef src,
+                             llvm::MutableArrayRef<uint8_t> dest) {
+  const size_t count = std::min(src.size() / 2, dest.size());
+  const char *hex = src.data();
+  size_t i = 0;
+  for (; i < count; ++i, hex += 2) {
+    const int hi_nibble = xdigit_to_sint(hex[0]);
+    const int lo_nibble = xdigit_to_sint(hex[1]);
+    if ((hi_nibble | lo_nibble) < 0)
+      break;
+    dest[i] = static_cast<uint8_t>((hi_nibble << 4) | lo_nibble);
+  }
+  return i;
 }
 
 // StringExtractor constructor
@@ -265,6 +296,14 @@ size_t StringExtractor::GetHexBytes(llvm::MutableArrayRef<uint8_t> dest,
                                     uint8_t fail_fill_value) {
   size_t bytes_extracted = 0;
   while (!dest.empty() && GetBytesLeft() > 0) {
+    const size_t bytes_decoded =
+        DecodeHexBytes(llvm::StringRef(m_packet).substr(m_index), dest);
+    m_index += 2 * bytes_decoded;
+    bytes_extracted += bytes_decoded;
+    dest = dest.drop_front(bytes_decoded);
+    if (dest.empty() || GetBytesLeft() == 0)
+      break;
+    // Let GetHexU8 skip spaces or fail at the next character.
     dest[0] = GetHexU8(fail_fill_value);
     if (!IsGood())
       break;
@@ -285,6 +324,13 @@ size_t StringExtractor::GetHexBytes(llvm::MutableArrayRef<uint8_t> dest,
 size_t StringExtractor::GetHexBytesAvail(llvm::MutableArrayRef<uint8_t> dest) {
   size_t bytes_extracted = 0;
   while (!dest.empty()) {
+    const size_t bytes_decoded =
+        DecodeHexBytes(llvm::StringRef(m_packet).substr(m_index), dest);
+    m_index += 2 * bytes_decoded;
+    bytes_extracted += bytes_decoded;
+    dest = dest.drop_front(bytes_decoded);
+    if (dest.empty())
+      break;
     int decode = DecodeHexU8();
     if (decode == -1)
       break;
@@ -550,6 +550,68 @@ class LldbGdbServerTestCase(
         read_contents = seven.unhexlify(context.get("read_contents"))
         self.assertEqual(read_contents, MEMORY_CONTENTS)
 
+    def test_MultiMemRead_packet_reads_memory(self):
+        self.build()
+        self.set_inferior_startup_launch()
+        MEMORY_CONTENTS = "Test contents 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+
+        # Start up the inferior.
+        procs = self.prep_debug_monitor_and_inferior(
+            inferior_args=[
+                "set-message:%s" % MEMORY_CONTENTS,
+                "get-data-address-hex:g_message",
+                "sleep:5",
+            ]
+        )
+
+        # Run the process and stop it once it printed the message address.
+        self.test_sequence.add_log_lines(
+            [
+                "read packet: $c#63",
+                {
+                    "type": "output_match",
+                    "regex": self.maybe_strict_output_regex(
+                        r"data address: 0x([0-9a-fA-F]+)\r\n"
+                    ),
+                    "capture": {1: "message_address"},
+                },
+                "read packet: {}".format(chr(3)),
+                {
+                    "direction": "send",
+                    "regex": r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);",
+                    "capture": {1: "stop_signo", 2: "stop_thread_id"},
+                },
+            ],
+            True,
+        )
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        self.assertIsNotNone(context.get("message_address"))
+        message_address = int(context.get("message_address"), 16)
+
+        # Read three ranges of the message at once, one of them empty.
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            [
+                "read packet: $MultiMemRead:ranges:{0:x},4,{1:x},a,{0:x},0;#00".format(
+                    message_address, message_address + 14
+                ),
+                {
+                    "direction": "send",
+                    "regex": re.compile(
+                        r"^\$([^;]*);(.*)#[0-9a-fA-F]{2}$", re.MULTILINE | re.DOTALL
+                    ),
+                    "capture": {1: "sizes", 2: "content_raw"},
+                },
+            ],
+            True,
+        )
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        self.assertEqual(context.get("sizes"), "4,a,0")
+        content = self.decode_gdbremote_binary(context.get("content_raw"))
+        self.assertEqual(content, "Test0123456789")
+
     def breakpoint_set_and_remove_work(self, want_hardware):
         # Start up the inferior.
         procs = self.prep_debug_monitor_and_inferior(
@@ -218,7 +218,13 @@ void VariablesRequestHandler::operator()(
             dap.enable_synthetic_child_debugging,
             /*is_name_duplicated=*/false, custom_name));
       };
-      const int64_t num_children = variable.GetNumChildren();
+      // When only a page of the children is requested, don't count the
+      // children past it. Synthetic child providers of linked containers walk
+      // the container to count its elements. Counting one more child tells
+      // whether the page is the last one.
+      const int64_t num_children =
+          count == 0 ? variable.GetNumChildren()
+                     : variable.GetNumChildren(start + count + 1);
       int64_t end_idx = start + ((count == 0) ? num_children : count);
       int64_t i = start;
       for (; i < end_idx && i < num_children; ++i)
@@ -44,6 +44,7 @@
 #include "llvm/Support/Path.h"
 #include "llvm/Support/ScopedPrinter.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <iomanip>
@@ -207,12 +208,18 @@ TryCreateAutoSummaryForContainer(lldb::SBValue &v) {
 
   llvm::StringRef separator = "";
 
-  for (size_t i = 0, e = v.GetNumChildren(); i < e; ++i) {
+  // Counting the children of a large container can be slow, so we only look
+  // at a bounded number of them. Children without a name or a description are
+  // skipped, so the summary may still be short when we reach that bound.
+  const size_t max_children = max_length + 1;
+  const size_t num_children = v.GetNumChildren(max_children + 1);
+  bool truncated = num_children > max_children;
+  for (size_t i = 0, e = std::min(num_children, max_children); i < e; ++i) {
     // If we reached the time limit or exceeded the number of characters, we
     // dump `...` to signal that there are more elements in the collection.
     if (summary.size() > max_length ||
         (std::chrono::steady_clock::now() - start) > max_evaluation_time) {
-      os << separator << "...";
+      truncated = true;
       break;
     }
     lldb::SBValue child = v.GetChildAtIndex(i);
@@ -237,6 +244,8 @@ TryCreateAutoSummaryForContainer(lldb::SBValue &v) {
       separator = ", ";
     }
   }
+  if (truncated)
+    os << separator << "...";
   os << "}";
 
   if (summary == "{...}" || summary == "{}")
@@ -0,0 +1,71 @@
+//===-- DataFileCacheTest.cpp ---------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/DataFileCache.h"
+#include "TestingSupport/SubsystemRAII.h"
+#include "lldb/Host/FileSystem.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+using namespace lldb_private;
+
+namespace {
+class DataFileCacheTest : public ::testing::Test {
+  SubsystemRAII<FileSystem> subsystems;
+};
+} // namespace
+
+TEST_F(DataFileCacheTest, GetAndSet) {
+  llvm::unittest::TempDir dir("lldb-data-file-cache", /*Unique=*/true);
+  DataFileCache cache(dir.path(), llvm::CachePruningPolicy());
+
+  EXPECT_EQ(cache.GetCachedData("key"), nullptr);
+  std::vector<uint8_t> data = {'h', 'e', 'l', 'l', 'o'};
+  EXPECT_TRUE(cache.SetCachedData("key", data));
+  std::unique_ptr<llvm::MemoryBuffer> buffer = cache.GetCachedData("key");
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_EQ(buffer->getBuffer(), "hello");
+
+  EXPECT_TRUE(cache.RemoveCacheFile("key").Success());
+  EXPECT_EQ(cache.GetCachedData("key"), nullptr);
+}
+
+TEST_F(DataFileCacheTest, GetFromManyThreads) {
+  llvm::unittest::TempDir dir("lldb-data-file-cache", /*Unique=*/true);
+  DataFileCache cache(dir.path(), llvm::CachePruningPolicy());
+
+  // Large enough for the cache file to be mapped into memory.
+  const size_t num_keys = 8;
+  std::vector<uint8_t> data(64 * 1024);
+  for (size_t i = 0; i < num_keys; ++i) {
+    std::fill(data.begin(), data.end(), uint8_t(i));
+    ASSERT_TRUE(cache.SetCachedData("key" + std::to_string(i), data));
+  }
+
+  std::vector<std::thread> threads;
+  std::vector<int> matches(num_keys * 4, 0);
+  for (size_t t = 0; t < matches.size(); ++t) {
+    threads.emplace_back([&, t]() {
+      size_t i = t % num_keys;
+      std::unique_ptr<llvm::MemoryBuffer> buffer =
+          cache.GetCachedData("key" + std::to_string(i));
+      if (!buffer || buffer->getBufferSize() != data.size())
+        return;
+      matches[t] = llvm::all_of(buffer->getBuffer(),
+                                [i](char c) { return uint8_t(c) == i; });
+    });
+  }
+  for (std::thread &thread : threads)
+    thread.join();
+  for (size_t t = 0; t < matches.size(); ++t)
+    EXPECT_TRUE(matches[t]) << "thread " << t;
+}
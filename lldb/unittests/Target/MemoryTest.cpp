@@ -50,6 +50,7 @@ public:
   void RefreshStateAfterStop() override {}
   size_t DoReadMemory(lldb::addr_t vm_addr, void *buf, size_t size,
                       Status &error) override {
+    m_num_reads++;
     if (m_bytes_left == 0)
       return 0;
 
@@ -72,6 +73,7 @@ public:
 
   // Test-specific additions
   size_t m_bytes_left;
+  size_t m_num_reads = 0;
   MemoryCache &GetMemoryCache() { return m_memory_cache; }
   void SetMaxReadSize(size_t size) { m_bytes_left = size; }
 };
@@ -226,3 +228,54 @@ TEST_F(MemoryTest, TesetMemoryCacheRead) {
                                                        // instead of using an
                                                        // old cache
 }
+
+TEST_F(MemoryTest, MemoryCacheReadAhead) {
+  ArchSpec arch("x86_64-apple-macosx-");
+
+  Platform::SetHostPlatform(PlatformRemoteMacOSX::CreateInstance(true, &arch));
+
+  DebuggerSP debugger_sp = Debugger::CreateInstance();
+  ASSERT_TRUE(debugger_sp);
+
+  TargetSP target_sp = CreateTarget(debugger_sp, arch);
+  ASSERT_TRUE(target_sp);
+
+  ListenerSP listener_sp(Listener::MakeListener("dummy"));
+  ProcessSP process_sp = std::make_shared<DummyProcess>(target_sp, listener_sp);
+  ASSERT_TRUE(process_sp);
+
+  DummyProcess *process = static_cast<DummyProcess *>(process_sp.get());
+  MemoryCache &mem_cache = process->GetMemoryCache();
+  const uint64_t l2_cache_size = process->GetMemoryCacheLineSize();
+  Status error;
+  std::vector<uint8_t> data(l2_cache_size);
+
+  // A single read only reads the cache line it needs.
+  process->SetMaxReadSize(l2_cache_size * 64);
+  ASSERT_EQ(mem_cache.Read(0x10000, data.data(), data.size(), error),
+            l2_cache_size);
+  ASSERT_EQ(process->m_num_reads, 1u);
+  ASSERT_EQ(process->m_bytes_left, l2_cache_size * 63);
+
+  // Scanning memory reads more and more lines ahead: 2 lines, then 4, 8 and 8.
+  for (uint64_t i = 1; i < 23; ++i)
+    ASSERT_EQ(mem_cache.Read(0x10000 + i * l2_cache_size, data.data(),
+                             data.size(), error),
+              l2_cache_size);
+  ASSERT_EQ(process->m_num_reads, 5u);
+  ASSERT_EQ(process->m_bytes_left, l2_cache_size * 41);
+
+  // Reading elsewhere only reads one line again.
+  ASSERT_EQ(mem_cache.Read(0x40000, data.data(), data.size(), error),
+            l2_cache_size);
+  ASSERT_EQ(process->m_num_reads, 6u);
+  ASSERT_EQ(process->m_bytes_left, l2_cache_size * 40);
+
+  // Reading ahead stops at lines that are known to be unreadable.
+  mem_cache.AddInvalidRange(0x40000 + l2_cache_size * 2, l2_cache_size);
+  ASSERT_EQ(mem_cache.Read(0x40000 + l2_cache_size, data.data(), data.size(),
+                           error),
+            l2_cache_size);
+  ASSERT_EQ(process->m_num_reads, 7u);
+  ASSERT_EQ(process->m_bytes_left, l2_cache_size * 39);
+}
@@ -351,6 +351,25 @@ TEST_F(StringExtractorTest, GetHexBytes_Partial) {
   ASSERT_EQ('2', *ex.Peek());
 }
 
+TEST_F(StringExtractorTest, GetHexBytes_Spaces) {
+  llvm::StringRef kHexEncodedBytes = "abcd ef01  2345xy";
+  const size_t kValidHexPairs = 6;
+  StringExtractor ex(kHexEncodedBytes);
+
+  uint8_t dst[8];
+  ASSERT_EQ(kValidHexPairs, ex.GetHexBytes(dst, 0xde));
+  EXPECT_EQ(0xab, dst[0]);
+  EXPECT_EQ(0xcd, dst[1]);
+  EXPECT_EQ(0xef, dst[2]);
+  EXPECT_EQ(0x01, dst[3]);
+  EXPECT_EQ(0x23, dst[4]);
+  EXPECT_EQ(0x45, dst[5]);
+  EXPECT_EQ(0xde, dst[6]);
+  EXPECT_EQ(0xde, dst[7]);
+
+  ASSERT_EQ(false, ex.IsGood());
+}
+
 TEST_F(StringExtractorTest, GetHexBytesAvail) {
   llvm::StringRef kHexEncodedBytes = "abcdef0123456789xyzw";
   const size_t kValidHexPairs = 8;
@@ -95,6 +95,10 @@ struct StableFunctionMap {
   /// Merge a \p OtherMap into this function map.
   void merge(const StableFunctionMap &OtherMap);
 
+  /// Merge a \p OtherMap into this function map, moving its entries rather
+  /// than copying them.
+  void merge(StableFunctionMap &&OtherMap);
+
   /// \returns true if there is no stable function entry.
   bool empty() const { return size() == 0; }
 
@@ -109,10 +113,17 @@ struct StableFunctionMap {
   /// \p Type is the type of size to return.
   size_t size(SizeType Type = UniqueHashCount) const;
 
-  /// Finalize the stable function map by trimming content.
+  /// Finalize the stable function map by trimming content. The hashes are
+  /// finalized in parallel.
   void finalize(bool SkipTrim = false);
 
 private:
+  /// Finalize the functions \p SFS of a hash.
+  /// \returns false if they should not be merged.
+  bool finalizeFunctions(
+      SmallVectorImpl<std::unique_ptr<StableFunctionEntry>> &SFS,
+      bool SkipTrim) const;
+
   /// Insert a `StableFunctionEntry` into the function map directly. This
   /// method assumes that string names have already been uniqued and the
   /// `StableFunctionEntry` is ready for insertion.
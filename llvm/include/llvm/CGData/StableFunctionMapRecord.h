@@ -56,6 +56,11 @@ struct StableFunctionMapRecord {
     FunctionMap->merge(*Other.FunctionMap);
   }
 
+  /// Merge the stable function map into this one, consuming \p Other.
+  void merge(StableFunctionMapRecord &&Other) {
+    FunctionMap->merge(std::move(*Other.FunctionMap));
+  }
+
   /// \returns true if the stable function map is empty.
   bool empty() const { return FunctionMap->empty(); }
 
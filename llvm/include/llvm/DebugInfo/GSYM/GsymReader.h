@@ -10,6 +10,7 @@
 #define LLVM_DEBUGINFO_GSYM_GSYMREADER_H
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/DebugInfo/GSYM/FileEntry.h"
 #include "llvm/DebugInfo/GSYM/FunctionInfo.h"
 #include "llvm/DebugInfo/GSYM/Header.h"
@@ -151,6 +152,22 @@ public:
   /// primary result, followed by results for any merged functions
   llvm::Expected<std::vector<LookupResult>> lookupAll(uint64_t Addr) const;
 
+  /// Lookup many addresses in the GSYM.
+  ///
+  /// This produces the same results as calling lookup() for each address, but
+  /// the address table search is skipped when an address falls in the same
+  /// function as the previous one. Callers symbolizing many addresses, such
+  /// as profile samples, should pass them sorted to benefit from this.
+  ///
+  /// \param Addrs The virtual addresses to lookup.
+  ///
+  /// \param Callback Called for each address in order with the result of its
+  /// lookup.
+  void lookupBatch(ArrayRef<uint64_t> Addrs,
+                   function_ref<void(uint64_t Addr,
+                                     Expected<LookupResult> Result)>
+                       Callback) const;
+
   /// Get a string from the string table.
   ///
   /// \param Offset The string table offset for the string to retrieve.
@@ -404,8 +421,12 @@ protected:
   ///
   /// \returns An valid data extractor on success, or an error if we fail to
   /// find the address in a function info or corrrectly decode the data
+  ///
+  /// \param[out] FoundAddrIdx If not null, set to the address index of the
+  /// function info that was found.
   llvm::Expected<llvm::DataExtractor>
-  getFunctionInfoDataForAddress(uint64_t Addr, uint64_t &FuncStartAddr) const;
+  getFunctionInfoDataForAddress(uint64_t Addr, uint64_t &FuncStartAddr,
+                                uint64_t *FoundAddrIdx = nullptr) const;
 
   /// Get the function data and address given an address index.
   ///
@@ -18,6 +18,7 @@
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/Error.h"
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -99,7 +100,12 @@ private:
   // entire file is mapped anyway.  Because of that, the user must supply the
   // allocator to allocate broken records from.
   BumpPtrAllocator &Allocator;
-  DenseMap<uint32_t, std::vector<CacheEntry>> CacheMap;
+  // The allocations made for reads at each offset, ordered by offset so that
+  // the allocations overlapping a request can be found without visiting all
+  // of them. The allocations at one offset are in order of increasing size.
+  std::map<uint64_t, std::vector<CacheEntry>> CacheMap;
+  // The size of the largest allocation in CacheMap.
+  uint64_t MaxCacheEntrySize = 0;
 };
 
 class WritableMappedBlockStream : public WritableBinaryStream {
@@ -35,6 +35,7 @@
 #include <condition_variable>
 #include <optional>
 #include <queue>
+#include <vector>
 
 namespace llvm {
 
@@ -85,6 +86,15 @@ std::string getDebuginfodDebuginfoUrlPath(object::BuildIDRef ID);
 /// server URLs.
 Expected<std::string> getCachedOrDownloadDebuginfo(object::BuildIDRef ID);
 
+/// Fetches the debug binaries for all of \p IDs like
+/// getCachedOrDownloadDebuginfo, with up to \p MaxInFlight requests running
+/// at the same time. This avoids a serial round trip per binary when many
+/// are needed at once, e.g. to symbolize a core dump. The results are in the
+/// same order as \p IDs.
+std::vector<Expected<std::string>>
+getCachedOrDownloadDebuginfos(ArrayRef<object::BuildID> IDs,
+                              unsigned MaxInFlight = 16);
+
 /// Fetches any debuginfod artifact using the default local cache directory and
 /// server URLs.
 Expected<std::string> getCachedOrDownloadArtifact(StringRef UniqueKey,
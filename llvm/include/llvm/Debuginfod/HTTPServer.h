@@ -19,6 +19,8 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Error.h"
 
+#include <chrono>
+
 #ifdef LLVM_ENABLE_HTTPLIB
 // forward declarations
 namespace httplib {
@@ -127,6 +129,16 @@ public:
 
   /// If the server is listening, stop and unbind the socket.
   void stop();
+
+  /// Sets the number of threads which serve requests. A thread serves one
+  /// connection at a time, including while a persistent connection is idle, so
+  /// this bounds the number of clients served concurrently. If 0, use the
+  /// hardware concurrency. Must be called before listen().
+  void setNumThreads(unsigned NumThreads);
+
+  /// Sets the number of requests a persistent connection may serve and the
+  /// time after which an idle one is closed.
+  void setKeepAlive(size_t MaxCount, std::chrono::seconds Timeout);
 };
 } // end namespace llvm
 
@@ -271,6 +271,9 @@ public:
     return *this;
   }
 
+  /// Reserve space for N symbols, e.g. before adding them one at a time.
+  void reserve(UnderlyingVector::size_type N) { Symbols.reserve(N); }
+
   bool empty() const { return Symbols.empty(); }
   UnderlyingVector::size_type size() const { return Symbols.size(); }
   iterator begin() { return Symbols.begin(); }
@@ -0,0 +1,106 @@
+//===--- JITStatisticsPlugin.h -- Per-module JIT statistics ----*- C++ -*--===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Records how much time the JIT spends compiling and linking, and how much
+// code each function ends up as.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_DEBUGGING_JITSTATISTICSPLUGIN_H
+#define LLVM_EXECUTIONENGINE_ORC_DEBUGGING_JITSTATISTICSPLUGIN_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ExecutionEngine/Orc/Core.h"
+#include "llvm/ExecutionEngine/Orc/IRCompileLayer.h"
+#include "llvm/ExecutionEngine/Orc/ObjectLinkingLayer.h"
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace llvm {
+
+class raw_ostream;
+
+namespace orc {
+
+/// Collects JIT statistics:
+///   - For each module compiled by a compiler wrapped with wrapCompiler(): the
+///     number of functions and IR instructions, and the compile time.
+///   - For each graph linked by the ObjectLinkingLayer: the link time, the
+///     total size of the linked sections, and the address and size of each
+///     defined function.
+///
+/// The statistics can be printed as JSON with printJSON().
+class JITStatisticsPlugin : public ObjectLinkingLayer::Plugin {
+public:
+  struct CompileStats {
+    std::string ModuleName;
+    uint64_t NumFunctions = 0;
+    uint64_t NumInstructions = 0;
+    std::chrono::nanoseconds CompileTime{0};
+  };
+
+  struct FunctionStats {
+    std::string Name;
+    ExecutorAddr Addr;
+    uint64_t CodeSize = 0;
+  };
+
+  struct LinkStats {
+    std::string GraphName;
+    uint64_t LinkedSize = 0;
+    std::chrono::nanoseconds LinkTime{0};
+    std::vector<FunctionStats> Functions;
+  };
+
+  /// Returns an IRCompiler that forwards to Compiler and records the time
+  /// spent on each module. The plugin must outlive the returned compiler.
+  std::unique_ptr<IRCompileLayer::IRCompiler>
+  wrapCompiler(std::unique_ptr<IRCompileLayer::IRCompiler> Compiler);
+
+  void modifyPassConfig(MaterializationResponsibility &MR,
+                        jitlink::LinkGraph &G,
+                        jitlink::PassConfiguration &Config) override;
+
+  Error notifyEmitted(MaterializationResponsibility &MR) override;
+  Error notifyFailed(MaterializationResponsibility &MR) override;
+  Error notifyRemovingResources(JITDylib &JD, ResourceKey K) override {
+    return Error::success();
+  }
+  void notifyTransferringResources(JITDylib &JD, ResourceKey DstKey,
+                                   ResourceKey SrcKey) override {}
+
+  std::vector<CompileStats> getCompileStats();
+  std::vector<LinkStats> getLinkStats();
+
+  /// Prints all statistics recorded so far as a JSON object with "compiles"
+  /// and "links" arrays.
+  void printJSON(raw_ostream &OS);
+
+private:
+  class TimingCompiler;
+
+  struct PendingLink {
+    std::chrono::steady_clock::time_point Start;
+    LinkStats Stats;
+  };
+
+  void recordCompile(CompileStats Stats);
+
+  std::mutex PluginMutex;
+  std::vector<CompileStats> Compiles;
+  std::vector<LinkStats> Links;
+  DenseMap<MaterializationResponsibility *, PendingLink> PendingLinks;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_DEBUGGING_JITSTATISTICSPLUGIN_H
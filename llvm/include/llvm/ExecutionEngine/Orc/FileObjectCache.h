@@ -0,0 +1,65 @@
+//===- FileObjectCache.h - Content-addressed object cache -------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An ObjectCache that stores compiled objects in a directory, keyed by a hash
+// of the module's IR.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_FILEOBJECTCACHE_H
+#define LLVM_EXECUTIONENGINE_ORC_FILEOBJECTCACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/Support/MemoryBufferRef.h"
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace llvm {
+namespace orc {
+
+/// An ObjectCache that stores objects in CacheDir under a name derived from a
+/// hash of the module's textual IR, so that identical modules compiled by
+/// different processes share cache entries. Cached objects are loaded with
+/// MemoryBuffer::getFile and may therefore be memory mapped rather than read.
+///
+/// The key only covers the IR (including the target triple and data layout),
+/// but not the module identifier or source file name, so that the same IR
+/// loaded from different paths shares an entry.
+/// Clients that compile the same IR with different code generation options
+/// (CPU, features, optimization level, ...) should describe those options in
+/// KeyPrefix, or use a separate CacheDir for each configuration.
+///
+/// Code generation modifies the module, so the path computed by a getObject
+/// miss is remembered and used by the following notifyObjectCompiled for the
+/// same module. A single instance can be shared by concurrent compile threads,
+/// e.g. via ConcurrentIRCompiler.
+class FileObjectCache : public ObjectCache {
+public:
+  FileObjectCache(std::string CacheDir, std::string KeyPrefix = "")
+      : CacheDir(std::move(CacheDir)), KeyPrefix(std::move(KeyPrefix)) {}
+
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override;
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override;
+
+  /// Returns the path that the object for M is cached at.
+  std::string getCachePath(const Module &M) const;
+
+private:
+  std::string CacheDir;
+  std::string KeyPrefix;
+
+  std::mutex PendingPathsMutex;
+  DenseMap<const Module *, std::string> PendingPaths;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_FILEOBJECTCACHE_H
@@ -57,6 +57,14 @@ public:
   static std::optional<GlobalValueSet>
   compileWholeModule(GlobalValueSet Requested);
 
+  /// Returns a partition function that adds to each requested function the
+  /// functions it directly calls in the same module, transitively and in
+  /// breadth-first order, for as long as the partition stays within
+  /// MaxInstructions IR instructions. This amortizes per-module codegen setup
+  /// over functions likely to be needed together, while keeping partitions
+  /// small enough to compile concurrently.
+  static PartitionFunction clusterByCallGraph(size_t MaxInstructions = 2000);
+
   /// Sets the partition function.
   void setPartitionFunction(PartitionFunction Partition);
 
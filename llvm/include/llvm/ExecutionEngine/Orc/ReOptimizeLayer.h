@@ -18,6 +18,7 @@
 #include "llvm/ExecutionEngine/Orc/RedirectionManager.h"
 #include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
 #include "llvm/IR/IRBuilder.h"
+#include "llvm/Passes/OptimizationLevel.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
 #include "llvm/Transforms/Utils/Cloning.h"
 
@@ -84,6 +85,13 @@ public:
     return Error::success();
   }
 
+  /// Returns a ReOptimizeFunc that runs the default module optimization
+  /// pipeline at the given level. Combined with reoptimizeIfCallFrequent this
+  /// gives a simple two-tier JIT: modules are first emitted as they were added
+  /// (e.g. unoptimized, for fast startup), and frequently called ones are
+  /// recompiled at Level and redirected to the new definitions.
+  static ReOptimizeFunc optimizeAt(OptimizationLevel Level);
+
   // Create IR reoptimize request fucntion call.
   static void createReoptimizeCall(Module &M, Instruction &IP,
                                    GlobalVariable *ArgBuffer);
@@ -13,9 +13,11 @@
 #ifndef LLVM_EXECUTIONENGINE_ORC_SPECULATEANALYSES_H
 #define LLVM_EXECUTIONENGINE_ORC_SPECULATEANALYSES_H
 
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Analysis/BranchProbabilityInfo.h"
 #include "llvm/ExecutionEngine/Orc/Core.h"
 #include "llvm/ExecutionEngine/Orc/Speculation.h"
+#include "llvm/IR/DataLayout.h"
 
 namespace llvm {
 
@@ -76,6 +78,29 @@ public:
   ResultTy operator()(Function &F);
 };
 
+// Replays the first-call order recorded by Speculator::getCallOrder() in an
+// earlier run: when a function is first called, the functions that followed
+// it in the recorded order are speculatively compiled. Every function is
+// instrumented, so the order can be recorded again for the next run.
+class RecordedOrderQuery : public SpeculateQuery {
+public:
+  // MangledOrder holds linker-level names as recorded by the Speculator; the
+  // global prefix of DL, if any, is stripped to recover the IR names.
+  RecordedOrderQuery(ArrayRef<std::string> MangledOrder, const DataLayout &DL,
+                     unsigned Lookahead = 8);
+
+  // Reads an order written by Speculator::writeCallOrder().
+  static Expected<RecordedOrderQuery>
+  fromFile(StringRef Path, const DataLayout &DL, unsigned Lookahead = 8);
+
+  ResultTy operator()(Function &F);
+
+private:
+  std::vector<std::string> Order;
+  StringMap<size_t> Position;
+  unsigned Lookahead;
+};
+
 } // namespace orc
 } // namespace llvm
 
@@ -21,6 +21,7 @@
 #include <mutex>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace llvm {
 namespace orc {
@@ -64,10 +65,18 @@ public:
   using StubAddrLikelies = DenseMap<TargetFAddr, SymbolNameSet>;
 
 private:
-  void registerSymbolsWithAddr(TargetFAddr ImplAddr,
+  void registerSymbolsWithAddr(TargetFAddr ImplAddr, SymbolStringPtr ImplName,
                                SymbolNameSet likelySymbols) {
     std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
     GlobalSpecMap.insert({ImplAddr, std::move(likelySymbols)});
+    ImplNames.insert({ImplAddr, std::move(ImplName)});
+  }
+
+  void recordCall(TargetFAddr ImplAddr) {
+    std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+    auto It = ImplNames.find(ImplAddr);
+    if (It != ImplNames.end())
+      CallOrder.push_back(It->second);
   }
 
   void launchCompile(ExecutorAddr FAddr) {
@@ -133,7 +142,21 @@ public:
 
   // Speculatively compile likely functions for the given Stub Address.
   // destination of __orc_speculate_for jump
-  void speculateFor(TargetFAddr StubAddr) { launchCompile(StubAddr); }
+  void speculateFor(TargetFAddr StubAddr) {
+    recordCall(StubAddr);
+    launchCompile(StubAddr);
+  }
+
+  /// Returns the (mangled) names of the instrumented functions in the order
+  /// in which they were first called. Feeding this to a RecordedOrderQuery in
+  /// a later run speculatively compiles functions in the same order.
+  std::vector<SymbolStringPtr> getCallOrder() {
+    std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+    return CallOrder;
+  }
+
+  /// Writes getCallOrder() to Path, one name per line.
+  Error writeCallOrder(StringRef Path);
 
   // FIXME : Register with Stub Address, after JITLink Fix.
   void registerSymbols(FunctionCandidatesMap Candidates, JITDylib *JD) {
@@ -145,7 +168,8 @@ public:
                            this](Expected<SymbolMap> ReadySymbol) {
         if (ReadySymbol) {
           auto RDef = (*ReadySymbol)[Target];
-          registerSymbolsWithAddr(RDef.getAddress(), std::move(Likely));
+          registerSymbolsWithAddr(RDef.getAddress(), Target,
+                                  std::move(Likely));
         } else
           this->getES().reportError(ReadySymbol.takeError());
       };
@@ -166,6 +190,8 @@ private:
   ImplSymbolMap &AliaseeImplTable;
   ExecutionSession &ES;
   StubAddrLikelies GlobalSpecMap;
+  DenseMap<TargetFAddr, SymbolStringPtr> ImplNames;
+  std::vector<SymbolStringPtr> CallOrder;
 };
 
 class IRSpeculationLayer : public IRLayer {
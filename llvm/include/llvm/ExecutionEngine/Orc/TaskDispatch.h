@@ -26,6 +26,7 @@
 #include <deque>
 #include <mutex>
 #include <thread>
+#include <utility>
 #endif
 
 namespace llvm {
@@ -132,6 +133,8 @@ public:
   void dispatch(std::unique_ptr<Task> T) override;
   void shutdown() override;
 private:
+  enum TaskKind { Normal, Materialization, Idle };
+
   bool canRunMaterializationTaskNow();
   bool canRunIdleTaskNow();
 
@@ -140,6 +143,13 @@ private:
   size_t Outstanding = 0;
   std::condition_variable OutstandingCV;
 
+  // Threads that have run out of work wait on ParkedCV for a short while
+  // before exiting. Dispatch hands tasks to them through HandoffQueue instead
+  // of starting a new thread for each task.
+  size_t NumParkedThreads = 0;
+  std::condition_variable ParkedCV;
+  std::deque<std::pair<std::unique_ptr<Task>, TaskKind>> HandoffQueue;
+
   std::optional<size_t> MaxMaterializationThreads;
   size_t NumMaterializationThreads = 0;
   std::deque<std::unique_ptr<Task>> MaterializationTaskQueue;
@@ -182,6 +182,9 @@ struct Config {
   /// Time trace granularity.
   unsigned TimeTraceGranularity = 500;
 
+  /// Only record the per-name totals in the time trace.
+  bool TimeTraceSummaryOnly = false;
+
   bool ShouldDiscardValueNames = true;
   DiagnosticHandlerFunction DiagHandler;
 
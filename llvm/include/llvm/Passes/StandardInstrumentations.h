@@ -30,6 +30,7 @@
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Transforms/IPO/SampleProfileProbe.h"
 
+#include <map>
 #include <string>
 #include <utility>
 
@@ -497,6 +498,40 @@ private:
   void runAfterPass();
 };
 
+/// This class implements --track-pass-memory. It samples the number of bytes
+/// allocated with malloc when each pass starts and ends, and prints the passes
+/// that grew the heap the most, per IR unit kind, when it is destroyed. With
+/// --time-trace, the growth of each pass run is also recorded as an instant
+/// event of the pass.
+class PassMemoryTracker {
+public:
+  PassMemoryTracker() = default;
+  // We intend this to be unique per-compilation, thus no copies.
+  PassMemoryTracker(const PassMemoryTracker &) = delete;
+  void operator=(const PassMemoryTracker &) = delete;
+  ~PassMemoryTracker();
+
+  void registerCallbacks(PassInstrumentationCallbacks &PIC);
+
+private:
+  struct PassMemoryInfo {
+    unsigned Runs = 0;
+    int64_t TotalGrowth = 0;
+    int64_t MaxGrowth = 0;
+    size_t MaxUsage = 0;
+  };
+  /// Statistics of the passes, keyed by pass and IR unit kind.
+  std::map<std::pair<std::string, StringRef>, PassMemoryInfo> Info;
+  /// Heap usage and IR unit kind of the running passes. Passes can run other
+  /// passes.
+  SmallVector<std::pair<size_t, StringRef>, 8> Stack;
+
+  // Implementation of pass instrumentation callbacks.
+  void runBeforePass(StringRef PassID, Any IR);
+  void runAfterPass(StringRef PassID);
+  void print();
+};
+
 // Class that holds transitions between basic blocks.  The transitions
 // are contained in a map of values to names of basic blocks.
 class DCData {
@@ -599,6 +634,7 @@ class StandardInstrumentations {
   PrintPassInstrumentation PrintPass;
   TimePassesHandler TimePasses;
   TimeProfilingPassesHandler TimeProfilingPasses;
+  PassMemoryTracker PassMemory;
   OptNoneInstrumentation OptNone;
   OptPassGateInstrumentation OptPassGate;
   PreservedCFGCheckerInstrumentation PreservedCFGChecker;
@@ -0,0 +1,64 @@
+//===- llvm/Support/ConcurrentStringSaver.h ---------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_CONCURRENTSTRINGSAVER_H
+#define LLVM_SUPPORT_CONCURRENTSTRINGSAVER_H
+
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/Allocator.h"
+#include <mutex>
+#include <string>
+
+namespace llvm {
+
+/// A thread-safe variant of UniqueStringSaver. Saving the same string yields
+/// the same StringRef, whatever thread saves it, and returned strings stay
+/// valid until the saver is destroyed.
+///
+/// Strings are distributed over a fixed number of shards by hash, and each
+/// shard has its own lock, allocator and set. Threads interning different
+/// strings rarely contend, unlike a UniqueStringSaver guarded by a single
+/// mutex. Unlike parallel::PerThreadBumpPtrAllocator, this can be used from
+/// any thread.
+class ConcurrentUniqueStringSaver final {
+public:
+  ConcurrentUniqueStringSaver() = default;
+  ConcurrentUniqueStringSaver(const ConcurrentUniqueStringSaver &) = delete;
+  ConcurrentUniqueStringSaver &
+  operator=(const ConcurrentUniqueStringSaver &) = delete;
+
+  // All returned strings are null-terminated: *save(S).end() == 0.
+  StringRef save(const char *S) { return save(StringRef(S)); }
+  StringRef save(StringRef S);
+  StringRef save(const Twine &S);
+  StringRef save(const std::string &S) { return save(StringRef(S)); }
+
+  /// Return the number of unique strings saved. This locks every shard, so it
+  /// should not be called on a hot path.
+  size_t size() const;
+
+  /// Return the total memory allocated for string bodies.
+  size_t getTotalMemory() const;
+
+private:
+  static constexpr unsigned NumShards = 64;
+
+  struct alignas(64) Shard {
+    mutable std::mutex Mutex;
+    BumpPtrAllocator Alloc;
+    DenseSet<StringRef> Unique;
+  };
+
+  Shard Shards[NumShards];
+};
+
+} // namespace llvm
+
+#endif // LLVM_SUPPORT_CONCURRENTSTRINGSAVER_H
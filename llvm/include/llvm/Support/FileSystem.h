@@ -1292,6 +1292,7 @@ private:
 
   void unmapImpl();
   void dontNeedImpl();
+  void willNeedImpl();
 
   std::error_code init(sys::fs::file_t FD, uint64_t Offset, mapmode Mode);
 
@@ -1322,6 +1323,7 @@ public:
     copyFrom(mapped_file_region());
   }
   void dontNeed() { dontNeedImpl(); }
+  void willNeed() { willNeedImpl(); }
 
   size_t size() const;
   char *data() const;
@@ -82,6 +82,11 @@ public:
   /// function should not be called on a writable buffer.
   virtual void dontNeedIfMmap() {}
 
+  /// For MemoryBuffer_MMap, tell the kernel that the whole buffer will be
+  /// accessed soon, so that it can start reading it in the background. This
+  /// calls madvise(MADV_WILLNEED) on *NIX systems.
+  virtual void willNeedIfMmap() {}
+
   /// Open the specified file as a MemoryBuffer, returning a new MemoryBuffer
   /// if successful, otherwise returning null.
   ///
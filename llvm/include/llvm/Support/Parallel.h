@@ -10,6 +10,7 @@
 #define LLVM_SUPPORT_PARALLEL_H
 
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/MathExtras.h"
@@ -18,7 +19,9 @@
 #include <algorithm>
 #include <condition_variable>
 #include <functional>
+#include <iterator>
 #include <mutex>
+#include <vector>
 
 namespace llvm {
 
@@ -42,16 +45,22 @@ extern ThreadPoolStrategy strategy;
 // Direct access to thread_local variables from a different DLL isn't
 // possible with Windows Native TLS.
 unsigned getThreadIndex();
+bool isExecutorThread();
 #else
 // Don't access this directly, use the getThreadIndex wrapper.
 extern thread_local unsigned threadIndex;
 
 inline unsigned getThreadIndex() { GET_THREAD_INDEX_IMPL; }
+
+// Returns true if the calling thread was created by the default executor, i.e.
+// if it may be running a task of a parallel routine concurrently with others.
+inline bool isExecutorThread() { return threadIndex != UINT_MAX; }
 #endif
 
 size_t getThreadCount();
 #else
 inline unsigned getThreadIndex() { return 0; }
+inline bool isExecutorThread() { return false; }
 inline size_t getThreadCount() { return 1; }
 #endif
 
@@ -156,6 +165,77 @@ void parallel_sort(RandomAccessIterator Start, RandomAccessIterator End,
                       llvm::Log2_64(std::distance(Start, End)) + 1);
 }
 
+/// Merge pairs of adjacent sorted runs of \p Src, delimited by \p Bounds, into
+/// the same positions of \p Dst, and update \p Bounds to the merged runs.
+template <class SrcIterator, class DstIterator, class Comparator>
+void parallel_merge_runs(SrcIterator Src, DstIterator Dst,
+                         SmallVectorImpl<size_t> &Bounds,
+                         const Comparator &Comp) {
+  size_t NumRuns = Bounds.size() - 1;
+  {
+    TaskGroup TG;
+    for (size_t I = 0; I < NumRuns; I += 2) {
+      TG.spawn([=, &Bounds, &Comp] {
+        // An odd run at the end is merged with an empty one, i.e. moved.
+        size_t B = Bounds[I];
+        size_t M = Bounds[std::min(I + 1, NumRuns)];
+        size_t E = Bounds[std::min(I + 2, NumRuns)];
+        std::merge(std::make_move_iterator(Src + B),
+                   std::make_move_iterator(Src + M),
+                   std::make_move_iterator(Src + M),
+                   std::make_move_iterator(Src + E), Dst + B, Comp);
+      });
+    }
+  }
+  size_t J = 0;
+  for (size_t I = 0; I < NumRuns; I += 2)
+    Bounds[J++] = Bounds[I];
+  Bounds[J++] = Bounds[NumRuns];
+  Bounds.truncate(J);
+}
+
+template <class RandomAccessIterator, class Comparator>
+void parallel_stable_sort(RandomAccessIterator Start, RandomAccessIterator End,
+                          const Comparator &Comp) {
+  using ValueTy =
+      typename std::iterator_traits<RandomAccessIterator>::value_type;
+  size_t NumItems = std::distance(Start, End);
+  size_t NumRuns = std::min<size_t>(PowerOf2Ceil(getThreadCount()),
+                                    NumItems / MinParallelSize);
+  if (NumRuns < 2) {
+    std::stable_sort(Start, End, Comp);
+    return;
+  }
+
+  // Sort one run per thread, then merge the runs pairwise. std::merge takes
+  // equal elements from the left run first, so the result is the same as that
+  // of a single std::stable_sort whatever the thread count is. The merges
+  // ping-pong between the input and one buffer of the same size.
+  SmallVector<size_t, 0> Bounds;
+  for (size_t I = 0; I <= NumRuns; ++I)
+    Bounds.push_back(NumItems * I / NumRuns);
+  {
+    TaskGroup TG;
+    for (size_t I = 0; I != NumRuns; ++I)
+      TG.spawn([=, &Bounds, &Comp] {
+        std::stable_sort(Start + Bounds[I], Start + Bounds[I + 1], Comp);
+      });
+  }
+
+  std::vector<ValueTy> Buf(std::make_move_iterator(Start),
+                           std::make_move_iterator(End));
+  bool InBuf = true;
+  while (Bounds.size() > 2) {
+    if (InBuf)
+      parallel_merge_runs(Buf.begin(), Start, Bounds, Comp);
+    else
+      parallel_merge_runs(Start, Buf.begin(), Bounds, Comp);
+    InBuf = !InBuf;
+  }
+  if (InBuf)
+    std::move(Buf.begin(), Buf.end(), Start);
+}
+
 // TaskGroup has a relatively high overhead, so we want to reduce
 // the number of spawn() calls. We'll create up to 1024 tasks here.
 // (Note that 1024 is an arbitrary number. This code probably needs
@@ -225,6 +305,23 @@ void parallelSort(RandomAccessIterator Start, RandomAccessIterator End,
   llvm::sort(Start, End, Comp);
 }
 
+/// Like parallelSort, but equal elements keep their relative order, so the
+/// result does not depend on the number of threads. Uses a temporary buffer
+/// with one element per input element.
+template <class RandomAccessIterator,
+          class Comparator = std::less<
+              typename std::iterator_traits<RandomAccessIterator>::value_type>>
+void parallelStableSort(RandomAccessIterator Start, RandomAccessIterator End,
+                        const Comparator &Comp = Comparator()) {
+#if LLVM_ENABLE_THREADS
+  if (parallel::strategy.ThreadsRequested != 1) {
+    parallel::detail::parallel_stable_sort(Start, End, Comp);
+    return;
+  }
+#endif
+  std::stable_sort(Start, End, Comp);
+}
+
 void parallelFor(size_t Begin, size_t End, function_ref<void(size_t)> Fn);
 
 template <class IterTy, class FuncTy>
@@ -255,6 +352,12 @@ void parallelSort(RangeTy &&R, const Comparator &Comp = Comparator()) {
   parallelSort(std::begin(R), std::end(R), Comp);
 }
 
+template <class RangeTy,
+          class Comparator = std::less<decltype(*std::begin(RangeTy()))>>
+void parallelStableSort(RangeTy &&R, const Comparator &Comp = Comparator()) {
+  parallelStableSort(std::begin(R), std::end(R), Comp);
+}
+
 template <class RangeTy, class FuncTy>
 void parallelForEach(RangeTy &&R, FuncTy Fn) {
   parallelForEach(std::begin(R), std::end(R), Fn);
@@ -163,20 +163,7 @@ private:
   /// Asynchronous submission of a task to the pool. The returned future can be
   /// used to wait for the task to finish and is *non-blocking* on destruction.
   void asyncEnqueue(std::function<void()> Task,
-                    ThreadPoolTaskGroup *Group) override {
-    int requestedThreads;
-    {
-      // Lock the queue and push the new task
-      std::unique_lock<std::mutex> LockGuard(QueueLock);
-
-      // Don't allow enqueueing after disabling the pool
-      assert(EnableFlag && "Queuing a thread during ThreadPool destruction");
-      Tasks.emplace_back(std::make_pair(std::move(Task), Group));
-      requestedThreads = ActiveThreads + Tasks.size();
-    }
-    QueueCondition.notify_one();
-    grow(requestedThreads);
-  }
+                    ThreadPoolTaskGroup *Group) override;
 
   /// Grow to ensure that we have at least `requested` Threads, but do not go
   /// over MaxThreadCount.
@@ -191,6 +178,11 @@ private:
 
   /// Tasks waiting for execution in the pool.
   std::deque<std::pair<std::function<void()>, ThreadPoolTaskGroup *>> Tasks;
+  /// Tasks of high priority groups, which run before any task in Tasks.
+  std::deque<std::pair<std::function<void()>, ThreadPoolTaskGroup *>>
+      HighPriorityTasks;
+  /// Number of queued tasks in the given group (only non-zero).
+  DenseMap<ThreadPoolTaskGroup *, unsigned> QueuedGroups;
 
   /// Locking and signaling for accessing the Tasks queue.
   std::mutex QueueLock;
@@ -243,12 +235,13 @@ private:
   /// Asynchronous submission of a task to the pool. The returned future can be
   /// used to wait for the task to finish and is *non-blocking* on destruction.
   void asyncEnqueue(std::function<void()> Task,
-                    ThreadPoolTaskGroup *Group) override {
-    Tasks.emplace_back(std::make_pair(std::move(Task), Group));
-  }
+                    ThreadPoolTaskGroup *Group) override;
 
   /// Tasks waiting for execution in the pool.
   std::deque<std::pair<std::function<void()>, ThreadPoolTaskGroup *>> Tasks;
+  /// Tasks of high priority groups, which run before any task in Tasks.
+  std::deque<std::pair<std::function<void()>, ThreadPoolTaskGroup *>>
+      HighPriorityTasks;
 };
 
 #if LLVM_ENABLE_THREADS
@@ -261,10 +254,16 @@ using DefaultThreadPool = SingleThreadExecutor;
 /// groups can run on the same threadpool but can be waited for separately.
 /// It is even possible for tasks of one group to submit and wait for tasks
 /// of another group, as long as this does not form a loop.
+///
+/// Tasks of a high priority group are started before any queued task that is
+/// not in a high priority group, e.g. to keep latency-sensitive work from
+/// waiting behind bulk work submitted earlier. Running tasks are never
+/// interrupted.
 class ThreadPoolTaskGroup {
 public:
   /// The ThreadPool argument is the thread pool to forward calls to.
-  ThreadPoolTaskGroup(ThreadPoolInterface &Pool) : Pool(Pool) {}
+  ThreadPoolTaskGroup(ThreadPoolInterface &Pool, bool HighPriority = false)
+      : Pool(Pool), HighPriority(HighPriority) {}
 
   /// Blocking destructor: will wait for all the tasks in the group to complete
   /// by calling ThreadPool::wait().
@@ -280,8 +279,11 @@ public:
   /// Calls ThreadPool::wait() for this group.
   void wait() { Pool.wait(*this); }
 
+  bool isHighPriority() const { return HighPriority; }
+
 private:
   ThreadPoolInterface &Pool;
+  const bool HighPriority;
 };
 
 } // namespace llvm
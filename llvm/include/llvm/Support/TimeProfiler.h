@@ -115,9 +115,12 @@ struct TimeTraceProfilerEntry;
 /// Initialize the time trace profiler.
 /// This sets up the global \p TimeTraceProfilerInstance
 /// variable to be the profiler instance.
+/// If \p TimeTraceSummaryOnly is set, only the "Total" events are recorded:
+/// detail callbacks are not invoked and individual events are dropped.
 void timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
                                  StringRef ProcName,
-                                 bool TimeTraceVerbose = false);
+                                 bool TimeTraceVerbose = false,
+                                 bool TimeTraceSummaryOnly = false);
 
 /// Cleanup the time trace profiler, if it was initialized.
 void timeTraceProfilerCleanup();
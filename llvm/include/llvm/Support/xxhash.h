@@ -51,6 +51,14 @@ inline uint64_t xxh3_64bits(StringRef data) {
   return xxh3_64bits(ArrayRef(data.bytes_begin(), data.size()));
 }
 
+/// Compute xxh3_64bits of each consecutive \p recordSize byte record of
+/// \p data and store the results in \p out, which must hold
+/// data.size() / recordSize elements. This is faster than calling xxh3_64bits
+/// on each record when records are small, as the length dispatch is done once
+/// and the hash is specialized for the common sizes.
+void xxh3_64bits_records(ArrayRef<uint8_t> data, size_t recordSize,
+                         MutableArrayRef<uint64_t> out);
+
 /*-**********************************************************************
  *  XXH3 128-bit variant
  ************************************************************************/
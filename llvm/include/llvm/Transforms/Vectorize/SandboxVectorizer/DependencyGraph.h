@@ -337,6 +337,13 @@ private:
   std::optional<Context::CallbackID> SetUseCB;
 
   std::unique_ptr<BatchAAResults> BatchAA;
+  /// The maximum number of alias queries. Once it is exhausted, memory
+  /// instructions are conservatively considered dependent.
+  unsigned AABudget;
+  /// The number of alias queries made since the DAG was last cleared.
+  unsigned AAQueries = 0;
+  /// \Returns the AA budget set with -sbvec-dag-aa-budget.
+  static unsigned getDefaultAABudget();
 
   enum class DependencyType {
     ReadAfterWrite,  ///> Memory dependency write -> read
@@ -353,7 +360,6 @@ private:
   /// as it won't call AA. Therefore it returns the worst-case dep type.
   static DependencyType getRoughDepType(Instruction *FromI, Instruction *ToI);
 
-  // TODO: Implement AABudget.
   /// \Returns true if there is a memory/other dependency \p SrcI->DstI.
   bool alias(Instruction *SrcI, Instruction *DstI, DependencyType DepType);
 
@@ -396,7 +402,8 @@ private:
 public:
   /// This constructor also registers callbacks.
   DependencyGraph(AAResults &AA, Context &Ctx)
-      : Ctx(&Ctx), BatchAA(std::make_unique<BatchAAResults>(AA)) {
+      : Ctx(&Ctx), BatchAA(std::make_unique<BatchAAResults>(AA)),
+        AABudget(getDefaultAABudget()) {
     CreateInstrCB = Ctx.registerCreateInstrCallback(
         [this](Instruction *I) { notifyCreateInstr(I); });
     EraseInstrCB = Ctx.registerEraseInstrCallback(
@@ -444,9 +451,12 @@ public:
   Interval<Instruction> extend(ArrayRef<Instruction *> Instrs);
   /// \Returns the range of instructions included in the DAG.
   Interval<Instruction> getInterval() const { return DAGInterval; }
+  /// Sets the maximum number of alias queries made until the next clear().
+  void setAABudget(unsigned Budget) { AABudget = Budget; }
   void clear() {
     InstrToNodeMap.clear();
     DAGInterval = {};
+    AAQueries = 0;
   }
 #ifndef NDEBUG
   /// \Returns true if the DAG's state is clear. Used in assertions.
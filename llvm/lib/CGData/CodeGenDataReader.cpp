@@ -62,7 +62,7 @@ Error CodeGenDataReader::mergeFromObjectFile(
       while (Data != EndData) {
         StableFunctionMapRecord LocalFunctionMapRecord;
         LocalFunctionMapRecord.deserialize(Data);
-        GlobalFunctionMapRecord.merge(LocalFunctionMapRecord);
+        GlobalFunctionMapRecord.merge(std::move(LocalFunctionMapRecord));
       }
     }
   };
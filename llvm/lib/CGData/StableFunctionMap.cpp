@@ -17,6 +17,7 @@
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Parallel.h"
 
 #define DEBUG_TYPE "stable-function-map"
 
@@ -109,6 +110,30 @@ void StableFunctionMap::merge(const StableFunctionMap &OtherMap) {
   }
 }
 
+void StableFunctionMap::merge(StableFunctionMap &&OtherMap) {
+  assert(!Finalized && "Cannot merge after finalization");
+  SmallVector<unsigned> IdMap;
+  IdMap.reserve(OtherMap.IdToName.size());
+  for (const std::string &Name : OtherMap.IdToName)
+    IdMap.push_back(getIdOrCreateForName(Name));
+  for (auto &[Hash, Funcs] : OtherMap.HashToFuncs) {
+    for (auto &Func : Funcs) {
+      Func->FunctionNameId = IdMap[Func->FunctionNameId];
+      Func->ModuleNameId = IdMap[Func->ModuleNameId];
+    }
+    auto &ThisFuncs = HashToFuncs[Hash];
+    if (ThisFuncs.empty()) {
+      ThisFuncs = std::move(Funcs);
+      continue;
+    }
+    ThisFuncs.append(std::make_move_iterator(Funcs.begin()),
+                     std::make_move_iterator(Funcs.end()));
+  }
+  OtherMap.HashToFuncs.clear();
+  OtherMap.IdToName.clear();
+  OtherMap.NameToId.clear();
+}
+
 size_t StableFunctionMap::size(SizeType Type) const {
   switch (Type) {
   case UniqueHashCount:
@@ -132,7 +157,8 @@ size_t StableFunctionMap::size(SizeType Type) const {
 
 using ParamLocs = SmallVector<IndexPair>;
 static void removeIdenticalIndexPair(
-    SmallVector<std::unique_ptr<StableFunctionMap::StableFunctionEntry>> &SFS) {
+    SmallVectorImpl<std::unique_ptr<StableFunctionMap::StableFunctionEntry>>
+        &SFS) {
   auto &RSF = SFS[0];
   unsigned StableFunctionCount = SFS.size();
 
@@ -160,8 +186,8 @@ static void removeIdenticalIndexPair(
 }
 
 static bool isProfitable(
-    const SmallVector<std::unique_ptr<StableFunctionMap::StableFunctionEntry>>
-        &SFS) {
+    const SmallVectorImpl<
+        std::unique_ptr<StableFunctionMap::StableFunctionEntry>> &SFS) {
   unsigned StableFunctionCount = SFS.size();
   if (StableFunctionCount < GlobalMergingMinMerges)
     return false;
@@ -201,57 +227,59 @@ static bool isProfitable(
   return Result;
 }
 
-void StableFunctionMap::finalize(bool SkipTrim) {
-  for (auto It = HashToFuncs.begin(); It != HashToFuncs.end(); ++It) {
-    auto &[StableHash, SFS] = *It;
-
-    // Group stable functions by ModuleIdentifier.
-    std::stable_sort(SFS.begin(), SFS.end(),
-                     [&](const std::unique_ptr<StableFunctionEntry> &L,
-                         const std::unique_ptr<StableFunctionEntry> &R) {
-                       return *getNameForId(L->ModuleNameId) <
-                              *getNameForId(R->ModuleNameId);
-                     });
+bool StableFunctionMap::finalizeFunctions(
+    SmallVectorImpl<std::unique_ptr<StableFunctionEntry>> &SFS,
+    bool SkipTrim) const {
+  // Group stable functions by ModuleIdentifier.
+  std::stable_sort(SFS.begin(), SFS.end(),
+                   [&](const std::unique_ptr<StableFunctionEntry> &L,
+                       const std::unique_ptr<StableFunctionEntry> &R) {
+                     return IdToName[L->ModuleNameId] <
+                            IdToName[R->ModuleNameId];
+                   });
 
-    // Consider the first function as the root function.
-    auto &RSF = SFS[0];
+  // Consider the first function as the root function.
+  auto &RSF = SFS[0];
 
-    bool Invalid = false;
-    unsigned StableFunctionCount = SFS.size();
-    for (unsigned I = 1; I < StableFunctionCount; ++I) {
-      auto &SF = SFS[I];
-      assert(RSF->Hash == SF->Hash);
-      if (RSF->InstCount != SF->InstCount) {
-        Invalid = true;
-        break;
-      }
-      if (RSF->IndexOperandHashMap->size() != SF->IndexOperandHashMap->size()) {
-        Invalid = true;
-        break;
-      }
-      for (auto &P : *RSF->IndexOperandHashMap) {
-        auto &InstOpndIndex = P.first;
-        if (!SF->IndexOperandHashMap->count(InstOpndIndex)) {
-          Invalid = true;
-          break;
-        }
-      }
-    }
-    if (Invalid) {
-      HashToFuncs.erase(It);
-      continue;
+  unsigned StableFunctionCount = SFS.size();
+  for (unsigned I = 1; I < StableFunctionCount; ++I) {
+    auto &SF = SFS[I];
+    assert(RSF->Hash == SF->Hash);
+    if (RSF->InstCount != SF->InstCount)
+      return false;
+    if (RSF->IndexOperandHashMap->size() != SF->IndexOperandHashMap->size())
+      return false;
+    for (auto &P : *RSF->IndexOperandHashMap) {
+      auto &InstOpndIndex = P.first;
+      if (!SF->IndexOperandHashMap->count(InstOpndIndex))
+        return false;
     }
+  }
 
-    if (SkipTrim)
-      continue;
+  if (SkipTrim)
+    return true;
 
-    // Trim the index pair that has the same operand hash across
-    // stable functions.
-    removeIdenticalIndexPair(SFS);
+  // Trim the index pair that has the same operand hash across
+  // stable functions.
+  removeIdenticalIndexPair(SFS);
 
-    if (!isProfitable(SFS))
-      HashToFuncs.erase(It);
-  }
+  return isProfitable(SFS);
+}
+
+void StableFunctionMap::finalize(bool SkipTrim) {
+  // The functions of each hash are finalized independently, and only the
+  // erasure of the hashes that cannot be merged touches the map itself.
+  SmallVector<HashFuncsMapType::iterator> Entries;
+  Entries.reserve(HashToFuncs.size());
+  for (auto It = HashToFuncs.begin(); It != HashToFuncs.end(); ++It)
+    Entries.push_back(It);
+  SmallVector<char> Keep(Entries.size());
+  parallelFor(0, Entries.size(), [&](size_t I) {
+    Keep[I] = finalizeFunctions(Entries[I]->second, SkipTrim);
+  });
+  for (size_t I = 0, E = Entries.size(); I != E; ++I)
+    if (!Keep[I])
+      HashToFuncs.erase(Entries[I]);
 
   Finalized = true;
 }
@@ -142,6 +142,16 @@ LiveIntervalUnion::Query::collectInterferingVRegs(unsigned MaxInterferingRegs) {
       return 0;
     }
 
+    // The bounds of the union live in the root node of its IntervalMap, so
+    // checking them is much cheaper than the find() below, which has to walk
+    // down the tree. This is the common case for register units that are only
+    // live in a few places of a large function.
+    if (LR->endIndex() <= LiveUnion->startIndex() ||
+        LR->beginIndex() >= LiveUnion->endIndex()) {
+      SeenAllInterferences = true;
+      return 0;
+    }
+
     // In most cases, the union will start before LR.
     LRI = LR->begin();
     LiveUnionI.setMap(LiveUnion->getMap());
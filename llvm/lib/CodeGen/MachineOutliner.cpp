@@ -90,6 +90,7 @@ using namespace outliner;
 // Statistics for outlined functions.
 STATISTIC(NumOutlined, "Number of candidates outlined");
 STATISTIC(FunctionsCreated, "Number of functions created");
+STATISTIC(OutliningBenefit, "Estimated number of bytes saved by outlining");
 
 // Statistics for instruction mapping.
 STATISTIC(NumLegalInUnsignedVec, "Outlinable instructions mapped");
@@ -672,9 +673,16 @@ static SmallVector<MatchedEntry> getMatchedEntries(InstructionMapper &Mapper) {
     return &(*InstrList[Index]);
   };
 
+  // Every instruction is visited once per match that starts before it, so
+  // hash each instruction only once up front.
+  SmallVector<stable_hash> Hashes(Size, 0);
+  for (unsigned I = 0; I < Size; ++I)
+    if (const MachineInstr *MI = getValidInstr(I); MI && !MI->isDebugInstr())
+      Hashes[I] = stableHashValue(*MI);
+
   auto getStableHashAndFollow =
-      [](const MachineInstr &MI, const HashNode *CurrNode) -> const HashNode * {
-    stable_hash StableHash = stableHashValue(MI);
+      [&](unsigned Index, const HashNode *CurrNode) -> const HashNode * {
+    stable_hash StableHash = Hashes[Index];
     if (!StableHash)
       return nullptr;
     auto It = CurrNode->Successors.find(StableHash);
@@ -685,7 +693,7 @@ static SmallVector<MatchedEntry> getMatchedEntries(InstructionMapper &Mapper) {
     const MachineInstr *MI = getValidInstr(I);
     if (!MI || MI->isDebugInstr())
       continue;
-    const HashNode *CurrNode = getStableHashAndFollow(*MI, RootNode);
+    const HashNode *CurrNode = getStableHashAndFollow(I, RootNode);
     if (!CurrNode)
       continue;
 
@@ -696,7 +704,7 @@ static SmallVector<MatchedEntry> getMatchedEntries(InstructionMapper &Mapper) {
       // Skip debug instructions as we did for the outlined function.
       if (MJ->isDebugInstr())
         continue;
-      CurrNode = getStableHashAndFollow(*MJ, CurrNode);
+      CurrNode = getStableHashAndFollow(J, CurrNode);
       if (!CurrNode)
         break;
       // Even with a match ending with a terminal, we continue finding
@@ -1080,6 +1088,7 @@ bool MachineOutliner::outline(
     OF->MF = createOutlinedFunction(M, *OF, Mapper, OutlinedFunctionNum);
     emitOutlinedFunctionRemark(*OF);
     FunctionsCreated++;
+    OutliningBenefit += OF->getBenefit();
     OutlinedFunctionNum++; // Created a function, move to the next name.
     MachineFunction *MF = OF->MF;
     const TargetSubtargetInfo &STI = MF->getSubtarget();
@@ -76,12 +76,14 @@
 #include "llvm/MC/MCTargetOptions.h"
 #include "llvm/Pass.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/ModRef.h"
 #include "llvm/Support/Mutex.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include "llvm/Target/TargetMachine.h"
 #include <algorithm>
 #include <cassert>
@@ -360,6 +362,26 @@ struct MachineVerifier {
   void verifyProperties(const MachineFunction &MF);
 };
 
+static cl::opt<unsigned> VerifySampleRate(
+    "machine-verifier-sample-rate", cl::Hidden, cl::init(1),
+    cl::desc("Only let the machine verifier pass check about one in N "
+             "functions, selected deterministically by a hash of the function "
+             "name (0 or 1 = check all functions)"));
+
+/// Return true if the verifier pass should skip \p MF.
+static bool shouldSkipVerification(const MachineFunction &MF) {
+  // Skip functions that have known verification problems.
+  // FIXME: Remove this mechanism when all problematic passes have been
+  // fixed.
+  if (MF.getProperties().hasProperty(
+          MachineFunctionProperties::Property::FailsVerification))
+    return true;
+  // The same functions are selected at every verification point of a run and
+  // across runs, so a failure can be reproduced with the same sample rate.
+  return VerifySampleRate > 1 &&
+         xxh3_64bits(MF.getName()) % VerifySampleRate != 0;
+}
+
 struct MachineVerifierLegacyPass : public MachineFunctionPass {
   static char ID; // Pass ID, replacement for typeid
 
@@ -380,11 +402,7 @@ struct MachineVerifierLegacyPass : public MachineFunctionPass {
   }
 
   bool runOnMachineFunction(MachineFunction &MF) override {
-    // Skip functions that have known verification problems.
-    // FIXME: Remove this mechanism when all problematic passes have been
-    // fixed.
-    if (MF.getProperties().hasProperty(
-            MachineFunctionProperties::Property::FailsVerification))
+    if (shouldSkipVerification(MF))
       return false;
 
     MachineVerifier(this, Banner.c_str(), &errs()).verify(MF);
@@ -397,11 +415,7 @@ struct MachineVerifierLegacyPass : public MachineFunctionPass {
 PreservedAnalyses
 MachineVerifierPass::run(MachineFunction &MF,
                          MachineFunctionAnalysisManager &MFAM) {
-  // Skip functions that have known verification problems.
-  // FIXME: Remove this mechanism when all problematic passes have been
-  // fixed.
-  if (MF.getProperties().hasProperty(
-          MachineFunctionProperties::Property::FailsVerification))
+  if (shouldSkipVerification(MF))
     return PreservedAnalyses::all();
   MachineVerifier(MFAM, Banner.c_str(), &errs()).verify(MF);
   return PreservedAnalyses::all();
@@ -81,6 +81,7 @@ using namespace llvm;
 STATISTIC(NumGlobalSplits, "Number of split global live ranges");
 STATISTIC(NumLocalSplits,  "Number of split local live ranges");
 STATISTIC(NumEvicted,      "Number of interferences evicted");
+STATISTIC(NumOverBudget,   "Number of functions over the split/evict budget");
 
 static cl::opt<SplitEditor::ComplementSpillMode> SplitSpillMode(
     "split-spill-mode", cl::Hidden,
@@ -146,6 +147,14 @@ static cl::opt<unsigned> SplitThresholdForRegWithHint(
              "percentage"),
     cl::init(75), cl::Hidden);
 
+static cl::opt<unsigned> SplitEvictBudget(
+    "greedy-split-evict-budget",
+    cl::desc("Maximum number of eviction and live range splitting attempts "
+             "per function. Once it is exhausted, the remaining spillable "
+             "live ranges are spilled without further splitting or eviction "
+             "(0 = unlimited)"),
+    cl::init(0), cl::Hidden);
+
 static RegisterRegAlloc greedyRegAlloc("greedy", "greedy register allocator",
                                        createGreedyRegisterAllocator);
 
@@ -722,6 +731,22 @@ bool RegAllocEvictionAdvisor::canAllocatePhysReg(unsigned CostPerUseLimit,
   return true;
 }
 
+/// consumeSplitEvictBudget - Account for one eviction or splitting attempt
+/// for VirtReg. Return false if the -greedy-split-evict-budget of the function
+/// is exhausted, in which case VirtReg should be spilled instead. Ranges that
+/// cannot be spilled are always allowed to evict and split.
+bool RAGreedy::consumeSplitEvictBudget(const LiveInterval &VirtReg) {
+  if (!SplitEvictBudget || !VirtReg.isSpillable())
+    return true;
+  if (SplitEvictWork >= SplitEvictBudget)
+    return false;
+  if (++SplitEvictWork == SplitEvictBudget) {
+    LLVM_DEBUG(dbgs() << "Split/evict budget exhausted\n");
+    ++NumOverBudget;
+  }
+  return true;
+}
+
 /// tryEvict - Try to evict all interferences for a physreg.
 /// @param  VirtReg Currently unassigned virtual register.
 /// @param  Order   Physregs to try.
@@ -731,6 +756,9 @@ MCRegister RAGreedy::tryEvict(const LiveInterval &VirtReg,
                               SmallVectorImpl<Register> &NewVRegs,
                               uint8_t CostPerUseLimit,
                               const SmallVirtRegSet &FixedRegisters) {
+  if (!consumeSplitEvictBudget(VirtReg))
+    return MCRegister();
+
   NamedRegionTimer T("evict", "Evict", TimerGroupName, TimerGroupDescription,
                      TimePassesIsEnabled);
 
@@ -1957,6 +1985,9 @@ MCRegister RAGreedy::trySplit(const LiveInterval &VirtReg,
   if (ExtraInfo->getStage(VirtReg) >= RS_Spill)
     return MCRegister();
 
+  if (!consumeSplitEvictBudget(VirtReg))
+    return MCRegister();
+
   // Local intervals are handled separately.
   if (LIS->intervalIsInOneMBB(VirtReg)) {
     NamedRegionTimer T("local_split", "Local Splitting", TimerGroupName,
@@ -2922,10 +2953,25 @@ bool RAGreedy::run(MachineFunction &mf) {
   IntfCache.init(MF, Matrix->getLiveUnions(), Indexes, LIS, TRI);
   GlobalCand.resize(32);  // This will grow as needed.
   SetOfBrokenHints.clear();
+  SplitEvictWork = 0;
 
   allocatePhysRegs();
   tryHintsRecoloring();
 
+  if (SplitEvictBudget && SplitEvictWork >= SplitEvictBudget) {
+    ORE->emit([&]() {
+      DebugLoc Loc;
+      if (auto *SP = MF->getFunction().getSubprogram())
+        Loc = DILocation::get(SP->getContext(), SP->getLine(), 1, SP);
+      MachineOptimizationRemarkMissed R(DEBUG_TYPE, "SplitEvictBudgetExceeded",
+                                        Loc, &MF->front());
+      R << "split/evict budget of "
+        << ore::NV("Budget", unsigned(SplitEvictBudget))
+        << " exhausted; remaining live ranges were spilled";
+      return R;
+    });
+  }
+
   if (VerifyEnabled)
     MF->verify(LIS, Indexes, "Before post optimization", &errs());
   postOptimization();
@@ -286,6 +286,10 @@ private:
 
   bool ReverseLocalAssignment = false;
 
+  /// Number of eviction and splitting attempts made in the current machine
+  /// function, checked against -greedy-split-evict-budget.
+  unsigned SplitEvictWork = 0;
+
 public:
   RAGreedy(RequiredAnalyses &Analyses, const RegAllocFilterFunc F = nullptr);
 
@@ -329,6 +333,7 @@ private:
                                   SmallLISet &RecoloringCandidates,
                                   const SmallVirtRegSet &FixedRegisters);
 
+  bool consumeSplitEvictBudget(const LiveInterval &);
   MCRegister tryAssign(const LiveInterval &, AllocationOrder &,
                        SmallVectorImpl<Register> &, const SmallVirtRegSet &);
   MCRegister tryEvict(const LiveInterval &, AllocationOrder &,
@@ -384,16 +384,18 @@ void WindowScheduler::generateTripleMBB() {
 }
 
 void WindowScheduler::restoreTripleMBB() {
-  // After list scheduling, the MBB is restored in one traversal.
-  for (size_t I = 0; I < TriMIs.size(); ++I) {
-    auto *MI = TriMIs[I];
-    auto OldPos = MBB->begin();
-    std::advance(OldPos, I);
+  // After list scheduling, the MBB is restored in one traversal. OldPos is the
+  // position the current MI originally had; everything before it has already
+  // been restored.
+  auto OldPos = MBB->begin();
+  for (auto *MI : TriMIs) {
     auto CurPos = MI->getIterator();
-    if (CurPos != OldPos) {
-      MBB->splice(OldPos, MBB, CurPos);
-      Context->LIS->handleMove(*MI, /*UpdateFlags=*/false);
+    if (CurPos == OldPos) {
+      ++OldPos;
+      continue;
     }
+    MBB->splice(OldPos, MBB, CurPos);
+    Context->LIS->handleMove(*MI, /*UpdateFlags=*/false);
   }
 }
 
@@ -11,6 +11,7 @@
 #include "llvm/DebugInfo/GSYM/LineTable.h"
 #include "llvm/DebugInfo/GSYM/OutputAggregator.h"
 #include "llvm/MC/StringTableBuilder.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <algorithm>
@@ -276,8 +277,9 @@ llvm::Error GsymCreator::finalize(OutputAggregator &Out) {
   if (!IsSegment) {
     if (NumBefore > 1) {
       // Sort function infos so we can emit sorted functions. Use stable sort to
-      // ensure determinism.
-      llvm::stable_sort(Funcs);
+      // ensure determinism. Comparing function infos may compare their inline
+      // and line tables, so sort in parallel for large inputs.
+      parallelStableSort(Funcs.begin(), Funcs.end());
       std::vector<FunctionInfo> FinalizedFuncs;
       FinalizedFuncs.reserve(Funcs.size());
       FinalizedFuncs.emplace_back(std::move(Funcs.front()));
@@ -254,7 +254,8 @@ GsymReader::getAddressIndex(const uint64_t Addr) const {
 
 llvm::Expected<DataExtractor>
 GsymReader::getFunctionInfoDataForAddress(uint64_t Addr,
-                                          uint64_t &FuncStartAddr) const {
+                                          uint64_t &FuncStartAddr,
+                                          uint64_t *FoundAddrIdx) const {
   Expected<uint64_t> ExpectedAddrIdx = getAddressIndex(Addr);
   if (!ExpectedAddrIdx)
     return ExpectedAddrIdx.takeError();
@@ -288,8 +289,11 @@ GsymReader::getFunctionInfoDataForAddress(uint64_t Addr,
     uint64_t Offset = 0;
     uint32_t FuncSize = ExpextedData->getU32(&Offset);
     if (FuncSize == 0 ||
-        AddressRange(FuncStartAddr, FuncStartAddr + FuncSize).contains(Addr))
+        AddressRange(FuncStartAddr, FuncStartAddr + FuncSize).contains(Addr)) {
+      if (FoundAddrIdx)
+        *FoundAddrIdx = AddrIdx;
       return ExpextedData;
+    }
   }
   return createStringError(std::errc::invalid_argument,
                            "address 0x%" PRIx64 " is not in GSYM", Addr);
@@ -380,6 +384,45 @@ GsymReader::lookupAll(uint64_t Addr) const {
   return Results;
 }
 
+void GsymReader::lookupBatch(
+    ArrayRef<uint64_t> Addrs,
+    function_ref<void(uint64_t Addr, Expected<LookupResult> Result)> Callback)
+    const {
+  // The function info data found for the previous address, and the range of
+  // addresses for which getFunctionInfoDataForAddress would return it: from
+  // the address it was found for up to the end of the function or the start
+  // of the next function in the address table, whichever comes first.
+  std::optional<DataExtractor> Data;
+  uint64_t FuncStartAddr = 0;
+  uint64_t ValidStart = 0, ValidEnd = 0;
+  const size_t NumAddresses = getNumAddresses();
+  for (uint64_t Addr : Addrs) {
+    if (!Data || Addr < ValidStart || Addr >= ValidEnd) {
+      Data.reset();
+      uint64_t AddrIdx = 0;
+      auto ExpectedData =
+          getFunctionInfoDataForAddress(Addr, FuncStartAddr, &AddrIdx);
+      if (!ExpectedData) {
+        Callback(Addr, ExpectedData.takeError());
+        continue;
+      }
+      Data = *ExpectedData;
+      uint64_t Offset = 0;
+      uint32_t FuncSize = Data->getU32(&Offset);
+      ValidStart = Addr;
+      ValidEnd = FuncSize ? FuncStartAddr + FuncSize : UINT64_MAX;
+      for (uint64_t I = AddrIdx + 1; I < NumAddresses; ++I) {
+        std::optional<uint64_t> NextAddr = getAddress(I);
+        if (NextAddr && *NextAddr != FuncStartAddr) {
+          ValidEnd = std::min(ValidEnd, *NextAddr);
+          break;
+        }
+      }
+    }
+    Callback(Addr, FunctionInfo::lookup(*Data, *this, FuncStartAddr, Addr));
+  }
+}
+
 void GsymReader::dump(raw_ostream &OS) {
   const auto &Header = getHeader();
   // Dump the GSYM header.
@@ -92,56 +92,23 @@ Error MappedBlockStream::readBytes(uint64_t Offset, uint64_t Size,
   if (tryReadContiguously(Offset, Size, Buffer))
     return Error::success();
 
-  auto CacheIter = CacheMap.find(Offset);
-  if (CacheIter != CacheMap.end()) {
-    // Try to find an alloc that was large enough for this request.
+  // Look for an allocation that contains the whole request. It can only start
+  // at or before the request, and no further before its end than the size of
+  // the largest allocation.
+  const uint64_t End = Offset + Size;
+  for (auto CacheIter = CacheMap.upper_bound(Offset);
+       CacheIter != CacheMap.begin();) {
+    --CacheIter;
+    if (CacheIter->first + MaxCacheEntrySize < End)
+      break;
     for (auto &Entry : CacheIter->second) {
-      if (Entry.size() >= Size) {
-        Buffer = Entry.slice(0, Size);
+      if (CacheIter->first + Entry.size() >= End) {
+        Buffer = Entry.slice(Offset - CacheIter->first, Size);
         return Error::success();
       }
     }
   }
 
-  // We couldn't find a buffer that started at the correct offset (the most
-  // common scenario).  Try to see if there is a buffer that starts at some
-  // other offset but overlaps the desired range.
-  for (auto &CacheItem : CacheMap) {
-    Interval RequestExtent = std::make_pair(Offset, Offset + Size);
-
-    // We already checked this one on the fast path above.
-    if (CacheItem.first == Offset)
-      continue;
-    // If the initial extent of the cached item is beyond the ending extent
-    // of the request, there is no overlap.
-    if (CacheItem.first >= Offset + Size)
-      continue;
-
-    // We really only have to check the last item in the list, since we append
-    // in order of increasing length.
-    if (CacheItem.second.empty())
-      continue;
-
-    auto CachedAlloc = CacheItem.second.back();
-    // If the initial extent of the request is beyond the ending extent of
-    // the cached item, there is no overlap.
-    Interval CachedExtent =
-        std::make_pair(CacheItem.first, CacheItem.first + CachedAlloc.size());
-    if (RequestExtent.first >= CachedExtent.first + CachedExtent.second)
-      continue;
-
-    Interval Intersection = intersect(CachedExtent, RequestExtent);
-    // Only use this if the entire request extent is contained in the cached
-    // extent.
-    if (Intersection != RequestExtent)
-      continue;
-
-    uint64_t CacheRangeOffset =
-        AbsoluteDifference(CachedExtent.first, Intersection.first);
-    Buffer = CachedAlloc.slice(CacheRangeOffset, Size);
-    return Error::success();
-  }
-
   // Otherwise allocate a large enough buffer in the pool, memcpy the data
   // into it, and return an ArrayRef to that.  Do not touch existing pool
   // allocations, as existing clients may be holding a pointer which must
@@ -150,13 +117,8 @@ Error MappedBlockStream::readBytes(uint64_t Offset, uint64_t Size,
   if (auto EC = readBytes(Offset, MutableArrayRef<uint8_t>(WriteBuffer, Size)))
     return EC;
 
-  if (CacheIter != CacheMap.end()) {
-    CacheIter->second.emplace_back(WriteBuffer, Size);
-  } else {
-    std::vector<CacheEntry> List;
-    List.emplace_back(WriteBuffer, Size);
-    CacheMap.insert(std::make_pair(Offset, List));
-  }
+  CacheMap[Offset].emplace_back(WriteBuffer, Size);
+  MaxCacheEntrySize = std::max(MaxCacheEntrySize, Size);
   Buffer = ArrayRef<uint8_t>(WriteBuffer, Size);
   return Error::success();
 }
@@ -267,7 +229,10 @@ Error MappedBlockStream::readBytes(uint64_t Offset,
   return Error::success();
 }
 
-void MappedBlockStream::invalidateCache() { CacheMap.shrink_and_clear(); }
+void MappedBlockStream::invalidateCache() {
+  CacheMap.clear();
+  MaxCacheEntrySize = 0;
+}
 
 void MappedBlockStream::fixCacheAfterWrite(uint64_t Offset,
                                            ArrayRef<uint8_t> Data) const {
@@ -277,9 +242,9 @@ void MappedBlockStream::fixCacheAfterWrite(uint64_t Offset,
   // outstanding buffers are automatically updated.
   for (const auto &MapEntry : CacheMap) {
     // If the end of the written extent precedes the beginning of the cached
-    // extent, ignore this map entry.
+    // extent, it precedes all the following ones too.
     if (Offset + Data.size() < MapEntry.first)
-      continue;
+      break;
     for (const auto &Alloc : MapEntry.second) {
       // If the end of the cached extent precedes the beginning of the written
       // extent, ignore this alloc.
@@ -159,6 +159,27 @@ Expected<std::string> getCachedOrDownloadDebuginfo(BuildIDRef ID) {
   return getCachedOrDownloadArtifact(getDebuginfodCacheKey(UrlPath), UrlPath);
 }
 
+std::vector<Expected<std::string>>
+getCachedOrDownloadDebuginfos(ArrayRef<object::BuildID> IDs,
+                              unsigned MaxInFlight) {
+  // Each request uses its own HTTPClient, so they can run on separate
+  // threads. Concurrent downloads of the same artifact are safe, as the cache
+  // commits each file with an atomic rename.
+  std::vector<std::optional<Expected<std::string>>> Results(IDs.size());
+  {
+    DefaultThreadPool Pool(hardware_concurrency(
+        std::max<unsigned>(1, std::min<size_t>(MaxInFlight, IDs.size()))));
+    for (size_t I = 0, E = IDs.size(); I != E; ++I)
+      Pool.async([&, I] { Results[I] = getCachedOrDownloadDebuginfo(IDs[I]); });
+    Pool.wait();
+  }
+  std::vector<Expected<std::string>> Ret;
+  Ret.reserve(IDs.size());
+  for (std::optional<Expected<std::string>> &R : Results)
+    Ret.push_back(std::move(*R));
+  return Ret;
+}
+
 // General fetching function.
 Expected<std::string> getCachedOrDownloadArtifact(StringRef UniqueKey,
                                                   StringRef UrlPath) {
@@ -21,6 +21,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Regex.h"
+#include "llvm/Support/Threading.h"
 
 #ifdef LLVM_ENABLE_HTTPLIB
 #include "httplib.h"
@@ -155,6 +156,16 @@ void HTTPServer::stop() {
   Port = 0;
 }
 
+void HTTPServer::setNumThreads(unsigned NumThreads) {
+  unsigned N = hardware_concurrency(NumThreads).compute_thread_count();
+  Server->new_task_queue = [N] { return new httplib::ThreadPool(N); };
+}
+
+void HTTPServer::setKeepAlive(size_t MaxCount, std::chrono::seconds Timeout) {
+  Server->set_keep_alive_max_count(MaxCount);
+  Server->set_keep_alive_timeout(Timeout.count());
+}
+
 #else
 
 // TODO: Implement barebones standalone HTTP server implementation.
@@ -195,4 +206,8 @@ void HTTPServer::stop() {
   llvm_unreachable("no httplib");
 }
 
+void HTTPServer::setNumThreads(unsigned NumThreads) {}
+
+void HTTPServer::setKeepAlive(size_t MaxCount, std::chrono::seconds Timeout) {}
+
 #endif // LLVM_ENABLE_HTTPLIB
@@ -0,0 +1,156 @@
+//===--- JITStatisticsPlugin.cpp -- Per-module JIT statistics -------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/Debugging/JITStatisticsPlugin.h"
+#include "llvm/ExecutionEngine/JITLink/JITLink.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/raw_ostream.h"
+
+#define DEBUG_TYPE "orc"
+
+using namespace llvm;
+using namespace llvm::orc;
+using namespace llvm::jitlink;
+
+class JITStatisticsPlugin::TimingCompiler : public IRCompileLayer::IRCompiler {
+public:
+  TimingCompiler(JITStatisticsPlugin &P,
+                 std::unique_ptr<IRCompileLayer::IRCompiler> Compiler)
+      : IRCompiler(Compiler->getManglingOptions()), P(P),
+        Compiler(std::move(Compiler)) {}
+
+  Expected<std::unique_ptr<MemoryBuffer>> operator()(Module &M) override {
+    CompileStats Stats;
+    Stats.ModuleName = M.getModuleIdentifier();
+    for (auto &F : M) {
+      if (F.isDeclaration())
+        continue;
+      ++Stats.NumFunctions;
+      Stats.NumInstructions += F.getInstructionCount();
+    }
+
+    auto Start = std::chrono::steady_clock::now();
+    auto Obj = (*Compiler)(M);
+    Stats.CompileTime = std::chrono::steady_clock::now() - Start;
+    if (Obj)
+      P.recordCompile(std::move(Stats));
+    return Obj;
+  }
+
+private:
+  JITStatisticsPlugin &P;
+  std::unique_ptr<IRCompileLayer::IRCompiler> Compiler;
+};
+
+std::unique_ptr<IRCompileLayer::IRCompiler> JITStatisticsPlugin::wrapCompiler(
+    std::unique_ptr<IRCompileLayer::IRCompiler> Compiler) {
+  return std::make_unique<TimingCompiler>(*this, std::move(Compiler));
+}
+
+void JITStatisticsPlugin::recordCompile(CompileStats Stats) {
+  std::lock_guard<std::mutex> Lock(PluginMutex);
+  Compiles.push_back(std::move(Stats));
+}
+
+void JITStatisticsPlugin::modifyPassConfig(MaterializationResponsibility &MR,
+                                           LinkGraph &G,
+                                           PassConfiguration &Config) {
+  {
+    std::lock_guard<std::mutex> Lock(PluginMutex);
+    auto &Pending = PendingLinks[&MR];
+    Pending.Start = std::chrono::steady_clock::now();
+    Pending.Stats.GraphName = G.getName();
+  }
+
+  Config.PostFixupPasses.push_back([this, MR = &MR](LinkGraph &G) {
+    uint64_t LinkedSize = 0;
+    for (auto &Sec : G.sections())
+      for (auto *B : Sec.blocks())
+        LinkedSize += B->getSize();
+
+    std::vector<FunctionStats> Functions;
+    for (auto *Sym : G.defined_symbols())
+      if (Sym->isCallable() && Sym->hasName())
+        Functions.push_back(
+            {(*Sym->getName()).str(), Sym->getAddress(), Sym->getSize()});
+
+    std::lock_guard<std::mutex> Lock(PluginMutex);
+    auto I = PendingLinks.find(MR);
+    if (I != PendingLinks.end()) {
+      I->second.Stats.LinkedSize = LinkedSize;
+      I->second.Stats.Functions = std::move(Functions);
+    }
+    return Error::success();
+  });
+}
+
+Error JITStatisticsPlugin::notifyEmitted(MaterializationResponsibility &MR) {
+  std::lock_guard<std::mutex> Lock(PluginMutex);
+  auto I = PendingLinks.find(&MR);
+  if (I == PendingLinks.end())
+    return Error::success();
+
+  I->second.Stats.LinkTime = std::chrono::steady_clock::now() - I->second.Start;
+  Links.push_back(std::move(I->second.Stats));
+  PendingLinks.erase(I);
+  return Error::success();
+}
+
+Error JITStatisticsPlugin::notifyFailed(MaterializationResponsibility &MR) {
+  std::lock_guard<std::mutex> Lock(PluginMutex);
+  PendingLinks.erase(&MR);
+  return Error::success();
+}
+
+std::vector<JITStatisticsPlugin::CompileStats>
+JITStatisticsPlugin::getCompileStats() {
+  std::lock_guard<std::mutex> Lock(PluginMutex);
+  return Compiles;
+}
+
+std::vector<JITStatisticsPlugin::LinkStats>
+JITStatisticsPlugin::getLinkStats() {
+  std::lock_guard<std::mutex> Lock(PluginMutex);
+  return Links;
+}
+
+void JITStatisticsPlugin::printJSON(raw_ostream &OS) {
+  auto CompileList = getCompileStats();
+  auto LinkList = getLinkStats();
+
+  json::OStream J(OS, 2);
+  J.object([&] {
+    J.attributeArray("compiles", [&] {
+      for (auto &C : CompileList)
+        J.object([&] {
+          J.attribute("module", C.ModuleName);
+          J.attribute("functions", int64_t(C.NumFunctions));
+          J.attribute("instructions", int64_t(C.NumInstructions));
+          J.attribute("compile_us", int64_t(C.CompileTime.count() / 1000));
+        });
+    });
+    J.attributeArray("links", [&] {
+      for (auto &L : LinkList)
+        J.object([&] {
+          J.attribute("graph", L.GraphName);
+          J.attribute("size", int64_t(L.LinkedSize));
+          J.attribute("link_us", int64_t(L.LinkTime.count() / 1000));
+          J.attributeArray("functions", [&] {
+            for (auto &F : L.Functions)
+              J.object([&] {
+                J.attribute("name", F.Name);
+                J.attribute("addr", int64_t(F.Addr.getValue()));
+                J.attribute("size", int64_t(F.CodeSize));
+              });
+          });
+        });
+    });
+  });
+  OS << '\n';
+}
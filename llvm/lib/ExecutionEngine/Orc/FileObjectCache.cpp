@@ -0,0 +1,88 @@
+//===- FileObjectCache.cpp - Content-addressed object cache ---------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/FileObjectCache.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/raw_sha1_ostream.h"
+
+#define DEBUG_TYPE "orc"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+std::string FileObjectCache::getCachePath(const Module &M) const {
+  std::string IR;
+  raw_string_ostream IROS(IR);
+  M.print(IROS, nullptr);
+
+  // Leave out the module identifier and source file name, which describe where
+  // the module came from rather than what it contains.
+  StringRef Body(IR);
+  if (Body.starts_with("; ModuleID = "))
+    Body = Body.split('\n').second;
+  if (Body.starts_with("source_filename = "))
+    Body = Body.split('\n').second;
+
+  raw_sha1_ostream OS;
+  OS << KeyPrefix << '\0' << Body;
+  SmallString<128> Path(CacheDir);
+  sys::path::append(Path, toHex(OS.sha1(), /*LowerCase=*/true) + ".o");
+  return std::string(Path);
+}
+
+void FileObjectCache::notifyObjectCompiled(const Module *M,
+                                           MemoryBufferRef Obj) {
+  if (auto EC = sys::fs::create_directories(CacheDir)) {
+    LLVM_DEBUG(dbgs() << "FileObjectCache: cannot create " << CacheDir << ": "
+                      << EC.message() << "\n");
+    return;
+  }
+
+  std::string Path;
+  {
+    std::lock_guard<std::mutex> Lock(PendingPathsMutex);
+    auto I = PendingPaths.find(M);
+    if (I != PendingPaths.end()) {
+      Path = std::move(I->second);
+      PendingPaths.erase(I);
+    }
+  }
+  if (Path.empty())
+    Path = getCachePath(*M);
+
+  // Write through a temporary file so that concurrent readers never see a
+  // partially written object.
+  if (auto Err = writeToOutput(Path, [&](raw_ostream &OS) {
+        OS << Obj.getBuffer();
+        return Error::success();
+      })) {
+    LLVM_DEBUG(dbgs() << "FileObjectCache: cannot write " << Path << ": "
+                      << Err << "\n");
+    consumeError(std::move(Err));
+  }
+}
+
+std::unique_ptr<MemoryBuffer> FileObjectCache::getObject(const Module *M) {
+  std::string Path = getCachePath(*M);
+  auto Buf = MemoryBuffer::getFile(Path, /*IsText=*/false,
+                                   /*RequiresNullTerminator=*/false);
+  if (Buf)
+    return std::move(*Buf);
+
+  // The module is about to be compiled, which changes its IR. Store the object
+  // under the path of the IR it was compiled from.
+  std::lock_guard<std::mutex> Lock(PendingPathsMutex);
+  PendingPaths[M] = std::move(Path);
+  return nullptr;
+}
@@ -9,6 +9,10 @@
 #include "llvm/ExecutionEngine/Orc/IRPartitionLayer.h"
 #include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
 #include "llvm/ExecutionEngine/Orc/IndirectionUtils.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+
+#include <deque>
 
 using namespace llvm;
 using namespace llvm::orc;
@@ -116,6 +120,43 @@ IRPartitionLayer::compileWholeModule(GlobalValueSet Requested) {
   return std::nullopt;
 }
 
+IRPartitionLayer::PartitionFunction
+IRPartitionLayer::clusterByCallGraph(size_t MaxInstructions) {
+  return [MaxInstructions](GlobalValueSet Requested)
+             -> std::optional<GlobalValueSet> {
+    std::deque<const Function *> Worklist;
+    size_t NumInstructions = 0;
+    for (const auto *GV : Requested)
+      if (const auto *F = dyn_cast<Function>(GV)) {
+        Worklist.push_back(F);
+        NumInstructions += F->getInstructionCount();
+      }
+
+    while (!Worklist.empty() && NumInstructions < MaxInstructions) {
+      const Function *F = Worklist.front();
+      Worklist.pop_front();
+      for (const auto &I : instructions(*F)) {
+        const auto *CB = dyn_cast<CallBase>(&I);
+        if (!CB)
+          continue;
+        // Functions that were already emitted have been turned into
+        // declarations in this module, so only definitions are candidates.
+        const Function *Callee = CB->getCalledFunction();
+        if (!Callee || Callee->isDeclaration() ||
+            Callee->getParent() != F->getParent() || Requested.count(Callee))
+          continue;
+        size_t CalleeSize = Callee->getInstructionCount();
+        if (NumInstructions + CalleeSize > MaxInstructions)
+          continue;
+        Requested.insert(Callee);
+        NumInstructions += CalleeSize;
+        Worklist.push_back(Callee);
+      }
+    }
+    return std::move(Requested);
+  };
+}
+
 void IRPartitionLayer::emit(std::unique_ptr<MaterializationResponsibility> R,
                             ThreadSafeModule TSM) {
   assert(TSM && "Null module");
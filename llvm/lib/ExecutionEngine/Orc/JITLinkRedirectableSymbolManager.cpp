@@ -34,6 +34,7 @@ void JITLinkRedirectableSymbolManager::emitRedirectableSymbols(
       G->createSection(JumpStubSectionName, MemProt::Exec | MemProt::Read);
 
   SymbolFlagsMap NewSymbols;
+  NewSymbols.reserve(InitialDests.size());
   for (auto &[Name, Def] : InitialDests) {
     jitlink::Symbol *TargetSym = nullptr;
     if (Def.getAddress())
@@ -68,6 +69,8 @@ Error JITLinkRedirectableSymbolManager::redirect(JITDylib &JD,
   auto &ES = ObjLinkingLayer.getExecutionSession();
   SymbolLookupSet LS;
   DenseMap<NonOwningSymbolStringPtr, SymbolStringPtr> PtrToStub;
+  LS.reserve(NewDests.size());
+  PtrToStub.reserve(NewDests.size());
   for (auto &[StubName, Sym] : NewDests) {
     auto PtrName = ES.intern((*StubName + StubSuffix).str());
     PtrToStub[NonOwningSymbolStringPtr(PtrName)] = StubName;
@@ -79,6 +82,7 @@ Error JITLinkRedirectableSymbolManager::redirect(JITDylib &JD,
     return PtrSyms.takeError();
 
   std::vector<tpctypes::PointerWrite> PtrWrites;
+  PtrWrites.reserve(PtrSyms->size());
   for (auto &[PtrName, PtrSym] : *PtrSyms) {
     auto DestSymI = NewDests.find(PtrToStub[NonOwningSymbolStringPtr(PtrName)]);
     assert(DestSymI != NewDests.end() && "Bad ptr -> stub mapping");
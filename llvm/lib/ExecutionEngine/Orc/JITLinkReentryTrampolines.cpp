@@ -144,6 +144,7 @@ void JITLinkReentryTrampolines::emit(ResourceTrackerSP RT,
                       Linkage::Strong, Scope::SideEffectsOnly, true, true);
 
   auto TrampolineAddrs = std::make_shared<std::vector<ExecutorSymbolDef>>();
+  TrampolineAddrs->reserve(NumTrampolines);
   TrampolineAddrScraper->registerGraph(*G, TrampolineAddrs);
 
   // Add Graph via object linking layer.
@@ -385,6 +385,7 @@ void LazyReexportsManager::emitRedirectableSymbols(
 
   // Bind entry points to names.
   SymbolMap Redirs;
+  Redirs.reserve(Reexports.size());
   size_t I = 0;
   for (auto &[Name, AI] : Reexports)
     Redirs[Name] = {(*ReentryPoints)[I++].getAddress(), AI.AliasFlags};
@@ -394,6 +395,8 @@ void LazyReexportsManager::emitRedirectableSymbols(
     if (auto Err = MR->withResourceKeyDo([&](ResourceKey K) {
           auto &JD = MR->getTargetJITDylib();
           auto &ReentryAddrsForK = KeyToReentryAddrs[K];
+          ReentryAddrsForK.reserve(ReentryAddrsForK.size() + Reexports.size());
+          CallThroughs.reserve(CallThroughs.size() + Reexports.size());
           for (auto &[Name, AI] : Reexports) {
             const auto &ReentryPoint = (*ReentryPoints)[I++];
             CallThroughs[ReentryPoint.getAddress()] = {&JD, Name, AI.Aliasee};
@@ -10,6 +10,7 @@
 
 #include "llvm/Config/llvm-config.h" // for LLVM_ON_UNIX
 #include "llvm/ExecutionEngine/Orc/Shared/OrcRTBridge.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/WindowsError.h"
 
 #if defined(LLVM_ON_UNIX) && !defined(__ANDROID__)
@@ -49,6 +50,14 @@ void InProcessMemoryMapper::reserve(size_t NumBytes,
   if (EC)
     return OnReserved(errorCodeToError(EC));
 
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  // Slabs are reserved once and carved up for many graphs; let the kernel
+  // back them with transparent huge pages to reduce iTLB pressure. This is
+  // only a hint, so failures are ignored.
+  if (MB.allocatedSize() >= (2 << 20))
+    (void)::madvise(MB.base(), MB.allocatedSize(), MADV_HUGEPAGE);
+#endif
+
   {
     std::lock_guard<std::mutex> Lock(Mutex);
     Reservations[MB.base()].Size = MB.allocatedSize();
@@ -67,6 +76,22 @@ void InProcessMemoryMapper::initialize(MemoryMapper::AllocInfo &AI,
   ExecutorAddr MinAddr(~0ULL);
   ExecutorAddr MaxAddr(0);
 
+  // Segments that are adjacent at page granularity and share a protection
+  // (e.g. standard and finalize lifetime segments of the same kind) are
+  // protected with a single call.
+  ExecutorAddr ProtBase;
+  ExecutorAddr ProtEnd;
+  unsigned ProtFlags = 0;
+  auto FlushProtection = [&]() -> std::error_code {
+    if (ProtBase == ProtEnd)
+      return std::error_code();
+    auto EC = sys::Memory::protectMappedMemory(
+        {ProtBase.toPtr<void *>(), static_cast<size_t>(ProtEnd - ProtBase)},
+        ProtFlags);
+    ProtBase = ProtEnd;
+    return EC;
+  };
+
   // FIXME: Release finalize lifetime segments.
   for (auto &Segment : AI.Segments) {
     auto Base = AI.MappingBase + Segment.Offset;
@@ -81,14 +106,24 @@ void InProcessMemoryMapper::initialize(MemoryMapper::AllocInfo &AI,
     std::memset((Base + Segment.ContentSize).toPtr<void *>(), 0,
                 Segment.ZeroFillSize);
 
-    if (auto EC = sys::Memory::protectMappedMemory(
-            {Base.toPtr<void *>(), Size},
-            toSysMemoryProtectionFlags(Segment.AG.getMemProt()))) {
-      return OnInitialized(errorCodeToError(EC));
+    unsigned Flags = toSysMemoryProtectionFlags(Segment.AG.getMemProt());
+    if (ProtBase == ProtEnd || Flags != ProtFlags ||
+        alignTo(ProtEnd.getValue(), PageSize) != Base.getValue()) {
+      if (auto EC = FlushProtection())
+        return OnInitialized(errorCodeToError(EC));
+      ProtBase = Base;
+      ProtFlags = Flags;
     }
-    if ((Segment.AG.getMemProt() & MemProt::Exec) == MemProt::Exec)
-      sys::Memory::InvalidateInstructionCache(Base.toPtr<void *>(), Size);
+    ProtEnd = Base + Size;
   }
+  if (auto EC = FlushProtection())
+    return OnInitialized(errorCodeToError(EC));
+
+  for (auto &Segment : AI.Segments)
+    if ((Segment.AG.getMemProt() & MemProt::Exec) == MemProt::Exec)
+      sys::Memory::InvalidateInstructionCache(
+          (AI.MappingBase + Segment.Offset).toPtr<void *>(),
+          Segment.ContentSize + Segment.ZeroFillSize);
 
   std::vector<shared::WrapperFunctionCall> DeinitializeActions;
   {
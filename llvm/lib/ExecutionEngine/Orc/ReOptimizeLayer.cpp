@@ -1,5 +1,6 @@
 #include "llvm/ExecutionEngine/Orc/ReOptimizeLayer.h"
 #include "llvm/ExecutionEngine/Orc/Mangling.h"
+#include "llvm/Passes/PassBuilder.h"
 
 using namespace llvm;
 using namespace orc;
@@ -113,6 +114,33 @@ Error ReOptimizeLayer::reoptimizeIfCallFrequent(ReOptimizeLayer &Parent,
   });
 }
 
+ReOptimizeLayer::ReOptimizeFunc
+ReOptimizeLayer::optimizeAt(OptimizationLevel Level) {
+  return [Level](ReOptimizeLayer &Parent, ReOptMaterializationUnitID MUID,
+                 unsigned CurVersion, ResourceTrackerSP OldRT,
+                 ThreadSafeModule &TSM) -> Error {
+    TSM.withModuleDo([&](Module &M) {
+      LoopAnalysisManager LAM;
+      FunctionAnalysisManager FAM;
+      CGSCCAnalysisManager CGAM;
+      ModuleAnalysisManager MAM;
+
+      PassBuilder PB;
+      PB.registerModuleAnalyses(MAM);
+      PB.registerCGSCCAnalyses(CGAM);
+      PB.registerFunctionAnalyses(FAM);
+      PB.registerLoopAnalyses(LAM);
+      PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+
+      ModulePassManager MPM = Level == OptimizationLevel::O0
+                                  ? PB.buildO0DefaultPipeline(Level)
+                                  : PB.buildPerModuleDefaultPipeline(Level);
+      MPM.run(M, MAM);
+    });
+    return Error::success();
+  };
+}
+
 Expected<SymbolMap>
 ReOptimizeLayer::emitMUImplSymbols(ReOptMaterializationUnitState &MUState,
                                    uint32_t Version, JITDylib &JD,
@@ -16,6 +16,7 @@
 #include "llvm/Support/Endian.h"
 
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
+#include <sys/uio.h>
 #include <unistd.h>
 #else
 #include <io.h>
@@ -101,11 +102,46 @@ Error FDSimpleRemoteEPCTransport::sendMessage(SimpleRemoteEPCOpcode OpC,
   if (Disconnected)
     return make_error<StringError>("FD-transport disconnected",
                                    inconvertibleErrorCode());
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+  // Write the header and the argument bytes with a single system call where
+  // possible: this halves the number of writes per message and avoids the
+  // header being sent in a segment of its own on sockets.
+  struct iovec IOV[2] = {
+      {HeaderBuffer, FDMsgHeader::Size},
+      {const_cast<char *>(ArgBytes.data()), ArgBytes.size()}};
+  size_t Remaining = FDMsgHeader::Size + ArgBytes.size();
+  while (true) {
+    ssize_t Written = ::writev(OutFD, IOV, 2);
+    if (Written < 0) {
+      auto ErrNo = errno;
+      if (ErrNo == EAGAIN || ErrNo == EINTR)
+        continue;
+      return errorCodeToError(std::error_code(ErrNo, std::generic_category()));
+    }
+    Remaining -= Written;
+    if (Remaining == 0)
+      return Error::success();
+    // Short write: fall back to writeBytes for whatever is left.
+    if (static_cast<size_t>(Written) < FDMsgHeader::Size) {
+      if (int ErrNo = writeBytes(HeaderBuffer + Written,
+                                 FDMsgHeader::Size - Written))
+        return errorCodeToError(
+            std::error_code(ErrNo, std::generic_category()));
+      Written = FDMsgHeader::Size;
+    }
+    size_t ArgOffset = Written - FDMsgHeader::Size;
+    if (int ErrNo = writeBytes(ArgBytes.data() + ArgOffset,
+                               ArgBytes.size() - ArgOffset))
+      return errorCodeToError(std::error_code(ErrNo, std::generic_category()));
+    return Error::success();
+  }
+#else
   if (int ErrNo = writeBytes(HeaderBuffer, FDMsgHeader::Size))
     return errorCodeToError(std::error_code(ErrNo, std::generic_category()));
   if (int ErrNo = writeBytes(ArgBytes.data(), ArgBytes.size()))
     return errorCodeToError(std::error_code(ErrNo, std::generic_category()));
   return Error::success();
+#endif
 }
 
 void FDSimpleRemoteEPCTransport::disconnect() {
@@ -17,6 +17,7 @@
 #include "llvm/IR/PassManager.h"
 #include "llvm/Passes/PassBuilder.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/MemoryBuffer.h"
 
 namespace {
 using namespace llvm;
@@ -299,5 +300,51 @@ SpeculateQuery::ResultTy SequenceBBQuery::operator()(Function &F) {
   return CallerAndCalles;
 }
 
+RecordedOrderQuery::RecordedOrderQuery(ArrayRef<std::string> MangledOrder,
+                                       const DataLayout &DL,
+                                       unsigned Lookahead)
+    : Lookahead(Lookahead) {
+  char Prefix = DL.getGlobalPrefix();
+  for (StringRef Name : MangledOrder) {
+    if (Prefix && Name.starts_with(StringRef(&Prefix, 1)))
+      Name = Name.drop_front();
+    // Keep the first occurrence of each function.
+    if (Position.try_emplace(Name, Order.size()).second)
+      Order.push_back(Name.str());
+  }
+}
+
+Expected<RecordedOrderQuery>
+RecordedOrderQuery::fromFile(StringRef Path, const DataLayout &DL,
+                             unsigned Lookahead) {
+  auto Buf = MemoryBuffer::getFile(Path, /*IsText=*/true);
+  if (!Buf)
+    return createFileError(Path, Buf.getError());
+
+  std::vector<std::string> MangledOrder;
+  SmallVector<StringRef, 0> Lines;
+  (*Buf)->getBuffer().split(Lines, '\n', -1, /*KeepEmpty=*/false);
+  for (StringRef Line : Lines)
+    MangledOrder.push_back(Line.trim().str());
+  return RecordedOrderQuery(MangledOrder, DL, Lookahead);
+}
+
+SpeculateQuery::ResultTy RecordedOrderQuery::operator()(Function &F) {
+  DenseMap<StringRef, DenseSet<StringRef>> CallerAndCalles;
+  DenseSet<StringRef> Calles;
+
+  auto It = Position.find(F.getName());
+  if (It != Position.end()) {
+    size_t End = std::min(Order.size(), It->second + 1 + Lookahead);
+    for (size_t I = It->second + 1; I != End; ++I)
+      Calles.insert(Order[I]);
+  }
+
+  // Return an entry even if there is nothing to speculate so that F is
+  // instrumented and shows up in the next recorded order.
+  CallerAndCalles.insert({F.getName(), std::move(Calles)});
+  return CallerAndCalles;
+}
+
 } // namespace orc
 } // namespace llvm
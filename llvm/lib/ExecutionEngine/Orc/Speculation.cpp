@@ -18,6 +18,7 @@
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
 #include "llvm/IR/Verifier.h"
+#include "llvm/Support/raw_ostream.h"
 
 namespace llvm {
 
@@ -53,6 +54,14 @@ Error Speculator::addSpeculationRuntime(JITDylib &JD,
   }));
 }
 
+Error Speculator::writeCallOrder(StringRef Path) {
+  return writeToOutput(Path, [this](raw_ostream &OS) {
+    for (auto &Name : getCallOrder())
+      OS << *Name << '\n';
+    return Error::success();
+  });
+}
+
 // If two modules, share the same LLVMContext, different threads must
 // not access them concurrently without locking the associated LLVMContext
 // this implementation follows this contract.
@@ -44,7 +44,8 @@ using namespace llvm;
 using namespace llvm::orc;
 
 // Register debug object, return error message or null for success.
-static void appendJITDebugDescriptor(const char *ObjAddr, size_t Size) {
+static void appendJITDebugDescriptor(const char *ObjAddr, size_t Size,
+                                     bool AutoRegisterCode) {
   LLVM_DEBUG({
     dbgs() << "Adding debug object to GDB JIT interface "
            << formatv("([{0:x16} -- {1:x16}])",
@@ -72,6 +73,12 @@ static void appendJITDebugDescriptor(const char *ObjAddr, size_t Size) {
   __jit_debug_descriptor.first_entry = E;
   __jit_debug_descriptor.relevant_entry = E;
   __jit_debug_descriptor.action_flag = JIT_REGISTER_FN;
+
+  // Run into the rendezvous breakpoint while still holding the lock, so that
+  // the debugger cannot observe relevant_entry after another thread has
+  // already replaced it.
+  if (AutoRegisterCode)
+    __jit_debug_register_code();
 }
 
 extern "C" orc::shared::CWrapperFunctionResult
@@ -81,10 +88,7 @@ llvm_orc_registerJITLoaderGDBAllocAction(const char *ArgData, size_t ArgSize) {
              ArgData, ArgSize,
              [](ExecutorAddrRange R, bool AutoRegisterCode) {
                appendJITDebugDescriptor(R.Start.toPtr<const char *>(),
-                                        R.size());
-               // Run into the rendezvous breakpoint.
-               if (AutoRegisterCode)
-                 __jit_debug_register_code();
+                                        R.size(), AutoRegisterCode);
                return Error::success();
              })
       .release();
@@ -97,10 +101,7 @@ llvm_orc_registerJITLoaderGDBWrapper(const char *ArgData, size_t ArgSize) {
              ArgData, ArgSize,
              [](ExecutorAddrRange R, bool AutoRegisterCode) {
                appendJITDebugDescriptor(R.Start.toPtr<const char *>(),
-                                        R.size());
-               // Run into the rendezvous breakpoint.
-               if (AutoRegisterCode)
-                 __jit_debug_register_code();
+                                        R.size(), AutoRegisterCode);
                return Error::success();
              })
       .release();
@@ -10,6 +10,9 @@
 #include "llvm/Config/llvm-config.h" // for LLVM_ENABLE_THREADS
 #include "llvm/ExecutionEngine/Orc/Core.h"
 
+#include <chrono>
+#include <tuple>
+
 namespace llvm {
 namespace orc {
 
@@ -29,16 +32,20 @@ void InPlaceTaskDispatcher::dispatch(std::unique_ptr<Task> T) { T->run(); }
 void InPlaceTaskDispatcher::shutdown() {}
 
 #if LLVM_ENABLE_THREADS
+// How long a thread that has run out of work waits for a new task before
+// exiting.
+static constexpr std::chrono::milliseconds ParkTimeout(100);
+
 void DynamicThreadPoolTaskDispatcher::dispatch(std::unique_ptr<Task> T) {
 
-  enum { Normal, Materialization, Idle } TaskKind;
+  TaskKind Kind;
 
   if (isa<MaterializationTask>(*T))
-    TaskKind = Materialization;
+    Kind = Materialization;
   else if (isa<IdleTask>(*T))
-    TaskKind = Idle;
+    Kind = Idle;
   else
-    TaskKind = Normal;
+    Kind = Normal;
 
   {
     std::lock_guard<std::mutex> Lock(DispatchMutex);
@@ -47,7 +54,7 @@ void DynamicThreadPoolTaskDispatcher::dispatch(std::unique_ptr<Task> T) {
     if (Shutdown)
       return;
 
-    if (TaskKind == Materialization) {
+    if (Kind == Materialization) {
 
       // If this is a materialization task and there are too many running
       // already then queue this one up and return early.
@@ -56,15 +63,23 @@ void DynamicThreadPoolTaskDispatcher::dispatch(std::unique_ptr<Task> T) {
 
       // Otherwise record that we have a materialization task running.
       ++NumMaterializationThreads;
-    } else if (TaskKind == Idle) {
+    } else if (Kind == Idle) {
       if (!canRunIdleTaskNow())
         return IdleTaskQueue.push_back(std::move(T));
     }
 
     ++Outstanding;
+
+    // If a parked thread is available then hand the task to it rather than
+    // paying for a new thread.
+    if (HandoffQueue.size() < NumParkedThreads) {
+      HandoffQueue.push_back({std::move(T), Kind});
+      ParkedCV.notify_one();
+      return;
+    }
   }
 
-  std::thread([this, T = std::move(T), TaskKind]() mutable {
+  std::thread([this, T = std::move(T), Kind]() mutable {
     while (true) {
 
       // Run the task.
@@ -77,10 +92,10 @@ void DynamicThreadPoolTaskDispatcher::dispatch(std::unique_ptr<Task> T) {
       T.reset();
 
       // Check the work queue state and either proceed with the next task or
-      // end this thread.
-      std::lock_guard<std::mutex> Lock(DispatchMutex);
+      // park this thread.
+      std::unique_lock<std::mutex> Lock(DispatchMutex);
 
-      if (TaskKind == Materialization)
+      if (Kind == Materialization)
         --NumMaterializationThreads;
       --Outstanding;
 
@@ -88,19 +103,38 @@ void DynamicThreadPoolTaskDispatcher::dispatch(std::unique_ptr<Task> T) {
         // If there are any materialization tasks running then steal that work.
         T = std::move(MaterializationTaskQueue.front());
         MaterializationTaskQueue.pop_front();
-        TaskKind = Materialization;
+        Kind = Materialization;
         ++NumMaterializationThreads;
         ++Outstanding;
-      } else if (!IdleTaskQueue.empty() && canRunIdleTaskNow()) {
+        continue;
+      }
+
+      if (!IdleTaskQueue.empty() && canRunIdleTaskNow()) {
         T = std::move(IdleTaskQueue.front());
         IdleTaskQueue.pop_front();
-        TaskKind = Idle;
+        Kind = Idle;
         ++Outstanding;
-      } else {
-        if (Outstanding == 0)
+        continue;
+      }
+
+      if (Outstanding == 0)
+        OutstandingCV.notify_all();
+
+      // Wait for dispatch to hand us a task. Tasks already handed off are
+      // counted in Outstanding, so take them even after shutdown.
+      ++NumParkedThreads;
+      ParkedCV.wait_for(Lock, ParkTimeout,
+                        [this]() { return Shutdown || !HandoffQueue.empty(); });
+      --NumParkedThreads;
+
+      if (HandoffQueue.empty()) {
+        if (Outstanding == 0 && NumParkedThreads == 0)
           OutstandingCV.notify_all();
         return;
       }
+
+      std::tie(T, Kind) = std::move(HandoffQueue.front());
+      HandoffQueue.pop_front();
     }
   }).detach();
 }
@@ -108,7 +142,10 @@ void DynamicThreadPoolTaskDispatcher::dispatch(std::unique_ptr<Task> T) {
 void DynamicThreadPoolTaskDispatcher::shutdown() {
   std::unique_lock<std::mutex> Lock(DispatchMutex);
   Shutdown = true;
-  OutstandingCV.wait(Lock, [this]() { return Outstanding == 0; });
+  ParkedCV.notify_all();
+  OutstandingCV.wait(Lock, [this]() {
+    return Outstanding == 0 && NumParkedThreads == 0;
+  });
 }
 
 bool DynamicThreadPoolTaskDispatcher::canRunMaterializationTaskNow() {
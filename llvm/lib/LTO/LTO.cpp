@@ -58,6 +58,7 @@
 #include "llvm/Transforms/Utils/FunctionImportUtils.h"
 #include "llvm/Transforms/Utils/SplitModule.h"
 
+#include <condition_variable>
 #include <optional>
 #include <set>
 
@@ -75,6 +76,17 @@ static cl::opt<bool>
 
 extern cl::opt<bool> CodeGenDataThinLTOTwoRounds;
 
+static cl::opt<unsigned> ThinLTOBackendMemoryBudget(
+    "thinlto-backend-memory-budget", cl::init(0), cl::Hidden,
+    cl::desc("Approximate memory budget in MiB for the in-process ThinLTO "
+             "backends running at the same time. A backend's memory use is "
+             "estimated from its bitcode size. 0 means no limit"));
+
+static cl::opt<unsigned> ThinLTOBackendMemoryPerBitcodeByte(
+    "thinlto-backend-memory-per-bitcode-byte", cl::init(16), cl::Hidden,
+    cl::desc("Estimated backend memory use per byte of module bitcode, used "
+             "by -thinlto-backend-memory-budget"));
+
 namespace llvm {
 /// Enable global value internalization in LTO.
 cl::opt<bool> EnableLTOInternalization(
@@ -1427,6 +1439,37 @@ protected:
 
   bool ShouldEmitIndexFiles;
 
+  // State for -thinlto-backend-memory-budget. Backends are admitted while the
+  // sum of their estimated memory use fits in the budget; a backend that
+  // exceeds the budget on its own runs alone.
+  uint64_t MemoryBudget = 0;
+  uint64_t MemoryInUse = 0;
+  std::mutex MemoryMu;
+  std::condition_variable MemoryCV;
+
+  uint64_t admitBackend(const BitcodeModule &BM) {
+    if (!MemoryBudget)
+      return 0;
+    uint64_t Estimate = uint64_t(BM.getBuffer().size()) *
+                        ThinLTOBackendMemoryPerBitcodeByte;
+    std::unique_lock<std::mutex> L(MemoryMu);
+    MemoryCV.wait(L, [&] {
+      return MemoryInUse == 0 || MemoryInUse + Estimate <= MemoryBudget;
+    });
+    MemoryInUse += Estimate;
+    return Estimate;
+  }
+
+  void releaseBackend(uint64_t Estimate) {
+    if (!Estimate)
+      return;
+    {
+      std::lock_guard<std::mutex> L(MemoryMu);
+      MemoryInUse -= Estimate;
+    }
+    MemoryCV.notify_all();
+  }
+
 public:
   InProcessThinBackend(
       const Config &Conf, ModuleSummaryIndex &CombinedIndex,
@@ -1442,6 +1485,10 @@ public:
     CfiFunctionDefs.insert(Defs.guid_begin(), Defs.guid_end());
     auto &Decls = CombinedIndex.cfiFunctionDecls();
     CfiFunctionDecls.insert(Decls.guid_begin(), Decls.guid_end());
+    // The budget blocks start() until running backends finish, which only
+    // works if they run on other threads.
+    if (LLVM_ENABLE_THREADS)
+      MemoryBudget = uint64_t(ThinLTOBackendMemoryBudget) << 20;
   }
 
   virtual Error runThinLTOBackendThread(
@@ -1501,6 +1548,7 @@ public:
     assert(ModuleToDefinedGVSummaries.count(ModulePath));
     const GVSummaryMapTy &DefinedGlobals =
         ModuleToDefinedGVSummaries.find(ModulePath)->second;
+    uint64_t MemoryEstimate = admitBackend(BM);
     BackendThreadPool.async(
         [=](BitcodeModule BM, ModuleSummaryIndex &CombinedIndex,
             const FunctionImporter::ImportMapTy &ImportList,
@@ -1511,7 +1559,9 @@ public:
             MapVector<StringRef, BitcodeModule> &ModuleMap) {
           if (LLVM_ENABLE_THREADS && Conf.TimeTraceEnabled)
             timeTraceProfilerInitialize(Conf.TimeTraceGranularity,
-                                        "thin backend");
+                                        "thin backend",
+                                        /*TimeTraceVerbose=*/false,
+                                        Conf.TimeTraceSummaryOnly);
           Error E = runThinLTOBackendThread(
               AddStream, Cache, Task, BM, CombinedIndex, ImportList, ExportList,
               ResolvedODR, DefinedGlobals, ModuleMap);
@@ -1524,6 +1574,7 @@ public:
           }
           if (LLVM_ENABLE_THREADS && Conf.TimeTraceEnabled)
             timeTraceProfilerFinishThread();
+          releaseBackend(MemoryEstimate);
         },
         BM, std::ref(CombinedIndex), std::ref(ImportList), std::ref(ExportList),
         std::ref(ResolvedODR), std::ref(DefinedGlobals), std::ref(ModuleMap));
@@ -1885,7 +1936,10 @@ Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
   if (DumpThinCGSCCs)
     ThinLTO.CombinedIndex.dumpSCCs(outs());
 
-  std::set<GlobalValue::GUID> ExportedGUIDs;
+  // This holds an entry for every externally visible prevailing symbol, so use
+  // a DenseSet rather than a node-based set to keep the thin link's peak
+  // memory down on large links.
+  DenseSet<GlobalValue::GUID> ExportedGUIDs;
 
   bool WholeProgramVisibilityEnabledInLTO =
       Conf.HasWholeProgramVisibility &&
@@ -1924,8 +1978,12 @@ Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
   // no index entries in the typeIdMetadata map (e.g. if we are instead
   // performing IR-based WPD in hybrid regular/thin LTO mode).
   std::map<ValueInfo, std::vector<VTableSlotSummary>> LocalWPDTargetsMap;
-  runWholeProgramDevirtOnIndex(ThinLTO.CombinedIndex, ExportedGUIDs,
-                               LocalWPDTargetsMap);
+  {
+    std::set<GlobalValue::GUID> WPDExportedGUIDs;
+    runWholeProgramDevirtOnIndex(ThinLTO.CombinedIndex, WPDExportedGUIDs,
+                                 LocalWPDTargetsMap);
+    ExportedGUIDs.insert(WPDExportedGUIDs.begin(), WPDExportedGUIDs.end());
+  }
 
   auto isPrevailing = [&](GlobalValue::GUID GUID, const GlobalValueSummary *S) {
     return ThinLTO.PrevailingModuleForGUID[GUID] == S->modulePath();
@@ -75,6 +75,13 @@ static cl::opt<bool> ThinLTOAssumeMerged(
     cl::desc("Assume the input has already undergone ThinLTO function "
              "importing and the other pre-optimization pipeline changes."));
 
+static cl::opt<bool> LTOSplitRoundRobin(
+    "lto-split-round-robin", cl::init(false),
+    cl::desc("When splitting the regular LTO module for parallel codegen, "
+             "distribute functions to partitions round-robin instead of by "
+             "name hash, so that one partition does not dominate codegen "
+             "time"));
+
 namespace llvm {
 extern cl::opt<bool> NoPGOWarnMismatch;
 }
@@ -508,7 +515,7 @@ static void splitCodeGen(const Config &C, TargetMachine *TM,
   if (!TM->splitModule(Mod, ParallelCodeGenParallelismLevel,
                        HandleModulePartition)) {
     SplitModule(Mod, ParallelCodeGenParallelismLevel, HandleModulePartition,
-                false);
+                /*PreserveLocals=*/false, LTOSplitRoundRobin);
   }
 
   // Because the inner lambda (which runs in a worker thread) captures our local
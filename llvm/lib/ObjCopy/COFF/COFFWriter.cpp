@@ -14,6 +14,7 @@
 #include "llvm/Object/COFF.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Parallel.h"
 #include <cstddef>
 #include <cstdint>
 
@@ -313,7 +314,9 @@ void COFFWriter::writeHeaders(bool IsBigObj) {
 }
 
 void COFFWriter::writeSections() {
-  for (const auto &S : Obj.getSections()) {
+  // Each section's raw data and relocations occupy their own part of the
+  // output, so the sections can be copied in parallel.
+  parallelForEach(Obj.getSections(), [&](const Section &S) {
     uint8_t *Ptr = reinterpret_cast<uint8_t *>(Buf->getBufferStart()) +
                    S.Header.PointerToRawData;
     ArrayRef<uint8_t> Contents = S.getContents();
@@ -340,7 +343,7 @@ void COFFWriter::writeSections() {
       memcpy(Ptr, &R.Reloc, sizeof(R.Reloc));
       Ptr += sizeof(R.Reloc);
     }
-  }
+  });
 }
 
 template <class SymbolTy> void COFFWriter::writeSymbolStringTables() {
@@ -40,9 +40,11 @@
 #include "llvm/Support/GraphWriter.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/Program.h"
 #include "llvm/Support/Regex.h"
 #include "llvm/Support/Signals.h"
+#include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/xxhash.h"
 #include <unordered_map>
@@ -145,6 +147,11 @@ static cl::opt<bool>
                     cl::desc("Dump dropped debug variables stats"),
                     cl::init(false));
 
+static cl::opt<bool>
+    TrackPassMemory("track-pass-memory", cl::Hidden,
+                    cl::desc("Report the heap growth of each pass"),
+                    cl::init(false));
+
 template <typename IRUnitT> static const IRUnitT *unwrapIR(Any IR) {
   const IRUnitT **IRPtr = llvm::any_cast<const IRUnitT *>(&IR);
   return IRPtr ? *IRPtr : nullptr;
@@ -1595,6 +1602,93 @@ void TimeProfilingPassesHandler::runBeforePass(StringRef PassID, Any IR) {
 
 void TimeProfilingPassesHandler::runAfterPass() { timeTraceProfilerEnd(); }
 
+static StringRef getIRUnitKind(Any IR) {
+  if (unwrapIR<Module>(IR))
+    return "module";
+  if (unwrapIR<Function>(IR))
+    return "function";
+  if (unwrapIR<LazyCallGraph::SCC>(IR))
+    return "cgscc";
+  if (unwrapIR<Loop>(IR))
+    return "loop";
+  if (unwrapIR<MachineFunction>(IR))
+    return "machine function";
+  llvm_unreachable("Unknown wrapped IR type");
+}
+
+PassMemoryTracker::~PassMemoryTracker() {
+  if (!Info.empty())
+    print();
+}
+
+void PassMemoryTracker::registerCallbacks(PassInstrumentationCallbacks &PIC) {
+  if (!TrackPassMemory)
+    return;
+  PIC.registerBeforeNonSkippedPassCallback(
+      [this](StringRef P, Any IR) { this->runBeforePass(P, IR); });
+  PIC.registerAfterPassCallback(
+      [this](StringRef P, Any IR, const PreservedAnalyses &) {
+        this->runAfterPass(P);
+      },
+      true);
+  PIC.registerAfterPassInvalidatedCallback(
+      [this](StringRef P, const PreservedAnalyses &) { this->runAfterPass(P); },
+      true);
+}
+
+void PassMemoryTracker::runBeforePass(StringRef PassID, Any IR) {
+  // The pass managers and adaptors would only repeat the growth of the passes
+  // they run.
+  if (isSpecialPass(PassID, {"PassManager", "PassAdaptor"}))
+    return;
+  Stack.emplace_back(sys::Process::GetMallocUsage(), getIRUnitKind(IR));
+}
+
+void PassMemoryTracker::runAfterPass(StringRef PassID) {
+  if (isSpecialPass(PassID, {"PassManager", "PassAdaptor"}))
+    return;
+  assert(!Stack.empty() && "Unbalanced pass callbacks");
+  auto [Start, Kind] = Stack.pop_back_val();
+  size_t Usage = sys::Process::GetMallocUsage();
+  int64_t Growth = (int64_t)Usage - (int64_t)Start;
+
+  PassMemoryInfo &PI = Info[{PassID.str(), Kind}];
+  ++PI.Runs;
+  PI.TotalGrowth += Growth;
+  PI.MaxGrowth = std::max(PI.MaxGrowth, Growth);
+  PI.MaxUsage = std::max(PI.MaxUsage, Usage);
+
+  // This runs before the time profiler closes the entry of the pass.
+  if (getTimeTraceProfilerInstance())
+    timeTraceAddInstantEvent("Heap growth", [&] {
+      return formatv("{0} on {1}: {2} bytes", PassID, Kind, Growth).str();
+    });
+}
+
+void PassMemoryTracker::print() {
+  using EntryT = std::pair<const std::pair<std::string, StringRef>,
+                           PassMemoryInfo>;
+  std::vector<const EntryT *> Entries;
+  for (const EntryT &E : Info)
+    Entries.push_back(&E);
+  llvm::stable_sort(Entries, [](const EntryT *A, const EntryT *B) {
+    return A->second.TotalGrowth > B->second.TotalGrowth;
+  });
+
+  std::unique_ptr<raw_ostream> OS = CreateInfoOutputFile();
+  *OS << "===" << std::string(73, '-') << "===\n"
+      << "                          Pass heap growth report\n"
+      << "===" << std::string(73, '-') << "===\n"
+      << "  Total growth   Max growth    Max usage     Runs  Pass (IR unit)\n";
+  for (const EntryT *E : Entries) {
+    const PassMemoryInfo &PI = E->second;
+    *OS << formatv("{0,14} {1,12} {2,12} {3,8}  {4} ({5})\n", PI.TotalGrowth,
+                   PI.MaxGrowth, PI.MaxUsage, PI.Runs, E->first.first,
+                   E->first.second);
+  }
+  OS->flush();
+}
+
 namespace {
 
 class DisplayNode;
@@ -2539,6 +2633,9 @@ void StandardInstrumentations::registerCallbacks(
   // AfterCallbacks by its `registerCallbacks`. This is necessary
   // to ensure that other callbacks are not included in the timings.
   TimeProfilingPasses.registerCallbacks(PIC);
+  // Its 'AfterPassCallback' is put in front of the one of TimeProfiling, so
+  // that the instant events it adds belong to the entry of the pass.
+  PassMemory.registerCallbacks(PIC);
 }
 
 template class ChangeReporter<std::string>;
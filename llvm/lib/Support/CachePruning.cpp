@@ -11,18 +11,20 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/CachePruning.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/WithColor.h"
 #include "llvm/Support/raw_ostream.h"
 
 #define DEBUG_TYPE "cache-pruning"
 
-#include <set>
+#include <optional>
 #include <system_error>
 
 using namespace llvm;
@@ -33,8 +35,8 @@ struct FileInfo {
   uint64_t Size;
   std::string Path;
 
-  /// Used to determine which files to prune first. Also used to determine
-  /// set membership, so must take into account all fields.
+  /// Used to determine which files to prune first. Takes into account all
+  /// fields so that the order is deterministic.
   bool operator<(const FileInfo &Other) const {
     return std::tie(Time, Other.Size, Path) <
            std::tie(Other.Time, Size, Other.Path);
@@ -201,12 +203,8 @@ bool llvm::pruneCache(StringRef Path, CachePruningPolicy Policy,
     writeTimestampFile(TimestampFile);
   }
 
-  // Keep track of files to delete to get below the size limit.
-  // Order by time of last use so that recently used files are preserved.
-  std::set<FileInfo> FileInfos;
-  uint64_t TotalSize = 0;
-
-  // Walk the entire directory cache, looking for unused files.
+  // Walk the entire directory cache, looking for cache files.
+  std::vector<std::string> Paths;
   std::error_code EC;
   SmallString<128> CachePathNative;
   sys::path::native(Path, CachePathNative);
@@ -220,30 +218,50 @@ bool llvm::pruneCache(StringRef Path, CachePruningPolicy Policy,
     StringRef filename = sys::path::filename(File->path());
     if (!filename.starts_with("llvmcache-") && !filename.starts_with("Thin-"))
       continue;
+    Paths.push_back(File->path());
+  }
 
+  // Stat the files in parallel. Large caches hold millions of entries, and
+  // the stat calls dominate the time spent here.
+  std::vector<std::optional<sys::fs::file_status>> Statuses(Paths.size());
+  parallelFor(0, Paths.size(), [&](size_t I) {
+    sys::fs::file_status St;
+    if (!sys::fs::status(Paths[I], St))
+      Statuses[I] = St;
+  });
+
+  // Keep track of files to delete to get below the size limit.
+  std::vector<FileInfo> FileInfos;
+  std::vector<StringRef> Expired;
+  uint64_t TotalSize = 0;
+  for (size_t I = 0, E = Paths.size(); I != E; ++I) {
     // Look at this file. If we can't stat it, there's nothing interesting
     // there.
-    ErrorOr<sys::fs::basic_file_status> StatusOrErr = File->status();
-    if (!StatusOrErr) {
-      LLVM_DEBUG(dbgs() << "Ignore " << File->path() << " (can't stat)\n");
+    if (!Statuses[I]) {
+      LLVM_DEBUG(dbgs() << "Ignore " << Paths[I] << " (can't stat)\n");
       continue;
     }
 
     // If the file hasn't been used recently enough, delete it
-    const auto FileAccessTime = StatusOrErr->getLastAccessedTime();
+    const auto FileAccessTime = Statuses[I]->getLastAccessedTime();
     auto FileAge = CurrentTime - FileAccessTime;
     if (Policy.Expiration != seconds(0) && FileAge > Policy.Expiration) {
-      LLVM_DEBUG(dbgs() << "Remove " << File->path() << " ("
+      LLVM_DEBUG(dbgs() << "Remove " << Paths[I] << " ("
                         << duration_cast<seconds>(FileAge).count()
                         << "s old)\n");
-      sys::fs::remove(File->path());
+      Expired.push_back(Paths[I]);
       continue;
     }
 
     // Leave it here for now, but add it to the list of size-based pruning.
-    TotalSize += StatusOrErr->getSize();
-    FileInfos.insert({FileAccessTime, StatusOrErr->getSize(), File->path()});
+    TotalSize += Statuses[I]->getSize();
+    FileInfos.push_back(
+        {FileAccessTime, Statuses[I]->getSize(), std::move(Paths[I])});
   }
+  parallelForEach(Expired, [](StringRef P) { sys::fs::remove(P); });
+
+  // Order by time of last use so that recently used files are preserved.
+  llvm::sort(FileInfos);
 
   auto FileInfo = FileInfos.begin();
   size_t NumFiles = FileInfos.size();
@@ -0,0 +1,52 @@
+//===-- ConcurrentStringSaver.cpp -----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/ConcurrentStringSaver.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/xxhash.h"
+
+using namespace llvm;
+
+StringRef ConcurrentUniqueStringSaver::save(StringRef S) {
+  // The set hashes with DenseMapInfo; use an independent hash so that the
+  // strings of one shard still spread over its buckets.
+  Shard &Sh = Shards[xxh3_64bits(S) % NumShards];
+  std::lock_guard<std::mutex> Lock(Sh.Mutex);
+  auto R = Sh.Unique.insert(S);
+  if (R.second) {
+    char *P = Sh.Alloc.Allocate<char>(S.size() + 1);
+    if (!S.empty())
+      memcpy(P, S.data(), S.size());
+    P[S.size()] = '\0';
+    *R.first = StringRef(P, S.size()); // safe replacement with equal value
+  }
+  return *R.first;
+}
+
+StringRef ConcurrentUniqueStringSaver::save(const Twine &S) {
+  SmallString<128> Storage;
+  return save(S.toStringRef(Storage));
+}
+
+size_t ConcurrentUniqueStringSaver::size() const {
+  size_t N = 0;
+  for (const Shard &Sh : Shards) {
+    std::lock_guard<std::mutex> Lock(Sh.Mutex);
+    N += Sh.Unique.size();
+  }
+  return N;
+}
+
+size_t ConcurrentUniqueStringSaver::getTotalMemory() const {
+  size_t N = 0;
+  for (const Shard &Sh : Shards) {
+    std::lock_guard<std::mutex> Lock(Sh.Mutex);
+    N += Sh.Alloc.getTotalMemory();
+  }
+  return N;
+}
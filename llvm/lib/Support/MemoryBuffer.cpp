@@ -245,6 +245,8 @@ public:
   }
 
   void dontNeedIfMmap() override { MFR.dontNeed(); }
+
+  void willNeedIfMmap() override { MFR.willNeed(); }
 };
 } // namespace
 
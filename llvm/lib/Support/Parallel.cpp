@@ -11,6 +11,7 @@
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/Threading.h"
 
+#include <algorithm>
 #include <atomic>
 #include <future>
 #include <thread>
@@ -26,6 +27,7 @@ namespace parallel {
 static thread_local unsigned threadIndex = UINT_MAX;
 
 unsigned getThreadIndex() { GET_THREAD_INDEX_IMPL; }
+bool isExecutorThread() { return threadIndex != UINT_MAX; }
 #else
 thread_local unsigned threadIndex = UINT_MAX;
 #endif
@@ -218,18 +220,25 @@ void llvm::parallelFor(size_t Begin, size_t End,
     auto TaskSize = NumItems / parallel::detail::MaxTasksPerGroup;
     if (TaskSize == 0)
       TaskSize = 1;
-
+    size_t NumTasks = (NumItems + TaskSize - 1) / TaskSize;
+
+    // Rather than queueing every task in the executor, which takes its lock
+    // once per task, start one worker per thread and let the workers claim
+    // tasks from a shared counter. Threads that finish their tasks early keep
+    // claiming new ones, which balances skewed workloads.
+    std::atomic<size_t> NextTask{0};
+    size_t NumWorkers = std::min(NumTasks, parallel::getThreadCount());
     parallel::TaskGroup TG;
-    for (; Begin + TaskSize < End; Begin += TaskSize) {
-      TG.spawn([=, &Fn] {
-        for (size_t I = Begin, E = Begin + TaskSize; I != E; ++I)
-          Fn(I);
-      });
-    }
-    if (Begin != End) {
-      TG.spawn([=, &Fn] {
-        for (size_t I = Begin; I != End; ++I)
-          Fn(I);
+    for (size_t W = 0; W != NumWorkers; ++W) {
+      TG.spawn([=, &Fn, &NextTask] {
+        for (size_t Task = NextTask.fetch_add(1, std::memory_order_relaxed);
+             Task < NumTasks;
+             Task = NextTask.fetch_add(1, std::memory_order_relaxed)) {
+          size_t TBegin = Begin + Task * TaskSize;
+          size_t TEnd = std::min(TBegin + TaskSize, End);
+          for (size_t I = TBegin; I != TEnd; ++I)
+            Fn(I);
+        }
       });
     }
     return;
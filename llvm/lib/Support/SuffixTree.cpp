@@ -121,6 +121,9 @@ void SuffixTree::setLeafNodes() {
   // the LeafNodes vector of the suffix tree.
   unsigned LeafCounter = 0;
 
+  // There is one leaf per suffix.
+  LeafNodes.reserve(Str.size());
+
   // This keeps track of nodes whose children have been added to the stack.
   // The value is a pair, representing a node's first and last children.
   DenseMap<SuffixTreeInternalNode *,
@@ -193,7 +196,8 @@ unsigned SuffixTree::extend(unsigned EndIdx, unsigned SuffixesToAdd) {
     unsigned FirstChar = Str[Active.Idx];
 
     // Have we inserted anything starting with FirstChar at the current node?
-    if (Active.Node->Children.count(FirstChar) == 0) {
+    auto ChildIt = Active.Node->Children.find(FirstChar);
+    if (ChildIt == Active.Node->Children.end()) {
       // If not, then we can just insert a leaf and move to the next step.
       insertLeaf(*Active.Node, EndIdx, FirstChar);
 
@@ -206,7 +210,7 @@ unsigned SuffixTree::extend(unsigned EndIdx, unsigned SuffixesToAdd) {
     } else {
       // There's a match with FirstChar, so look for the point in the tree to
       // insert a new node.
-      SuffixTreeNode *NextNode = Active.Node->Children[FirstChar];
+      SuffixTreeNode *NextNode = ChildIt->second;
 
       unsigned SubstringLen = numElementsInSubstring(NextNode);
 
@@ -347,8 +351,8 @@ void SuffixTree::RepeatedSubstringIterator::advance() {
     // Yes. Update the state to reflect this, and then bail out.
     N = Curr;
     RS.Length = Length;
-    for (unsigned StartIdx : RepeatedSubstringStarts)
-      RS.StartIndices.push_back(StartIdx);
+    RS.StartIndices.assign(RepeatedSubstringStarts.begin(),
+                           RepeatedSubstringStarts.end());
     break;
   }
   // At this point, either NewRS is an empty RepeatedSubstring, or it was
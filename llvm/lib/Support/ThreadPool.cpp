@@ -50,6 +50,25 @@ void StdThreadPool::grow(int requested) {
   }
 }
 
+void StdThreadPool::asyncEnqueue(std::function<void()> Task,
+                                 ThreadPoolTaskGroup *Group) {
+  int requestedThreads;
+  {
+    // Lock the queue and push the new task
+    std::unique_lock<std::mutex> LockGuard(QueueLock);
+
+    // Don't allow enqueueing after disabling the pool
+    assert(EnableFlag && "Queuing a thread during ThreadPool destruction");
+    auto &Queue = Group && Group->isHighPriority() ? HighPriorityTasks : Tasks;
+    Queue.emplace_back(std::move(Task), Group);
+    if (Group != nullptr)
+      ++QueuedGroups[Group];
+    requestedThreads = ActiveThreads + Tasks.size() + HighPriorityTasks.size();
+  }
+  QueueCondition.notify_one();
+  grow(requestedThreads);
+}
+
 #ifndef NDEBUG
 // The group of the tasks run by the current thread.
 static LLVM_THREAD_LOCAL std::vector<ThreadPoolTaskGroup *>
@@ -66,13 +85,13 @@ void StdThreadPool::processTasks(ThreadPoolTaskGroup *WaitingForGroup) {
       bool workCompletedForGroup = false; // Result of workCompletedUnlocked()
       // Wait for tasks to be pushed in the queue
       QueueCondition.wait(LockGuard, [&] {
-        return !EnableFlag || !Tasks.empty() ||
+        return !EnableFlag || !Tasks.empty() || !HighPriorityTasks.empty() ||
                (WaitingForGroup != nullptr &&
                 (workCompletedForGroup =
                      workCompletedUnlocked(WaitingForGroup)));
       });
       // Exit condition
-      if (!EnableFlag && Tasks.empty())
+      if (!EnableFlag && Tasks.empty() && HighPriorityTasks.empty())
         return;
       if (WaitingForGroup != nullptr && workCompletedForGroup)
         return;
@@ -82,13 +101,18 @@ void StdThreadPool::processTasks(ThreadPoolTaskGroup *WaitingForGroup) {
       // in order for wait() to properly detect that even if the queue is
       // empty, there is still a task in flight.
       ++ActiveThreads;
-      Task = std::move(Tasks.front().first);
-      GroupOfTask = Tasks.front().second;
+      auto &Queue = HighPriorityTasks.empty() ? Tasks : HighPriorityTasks;
+      Task = std::move(Queue.front().first);
+      GroupOfTask = Queue.front().second;
       // Need to count active threads in each group separately, ActiveThreads
       // would never be 0 if waiting for another group inside a wait.
-      if (GroupOfTask != nullptr)
+      if (GroupOfTask != nullptr) {
         ++ActiveGroups[GroupOfTask]; // Increment or set to 1 if new item
-      Tasks.pop_front();
+        auto Q = QueuedGroups.find(GroupOfTask);
+        if (--(Q->second) == 0)
+          QueuedGroups.erase(Q);
+      }
+      Queue.pop_front();
     }
 #ifndef NDEBUG
     if (CurrentThreadTaskGroups == nullptr)
@@ -135,10 +159,8 @@ void StdThreadPool::processTasks(ThreadPoolTaskGroup *WaitingForGroup) {
 
 bool StdThreadPool::workCompletedUnlocked(ThreadPoolTaskGroup *Group) const {
   if (Group == nullptr)
-    return !ActiveThreads && Tasks.empty();
-  return ActiveGroups.count(Group) == 0 &&
-         !llvm::any_of(Tasks,
-                       [Group](const auto &T) { return T.second == Group; });
+    return !ActiveThreads && Tasks.empty() && HighPriorityTasks.empty();
+  return ActiveGroups.count(Group) == 0 && QueuedGroups.count(Group) == 0;
 }
 
 void StdThreadPool::wait() {
@@ -198,11 +220,18 @@ SingleThreadExecutor::SingleThreadExecutor(ThreadPoolStrategy S) {
   }
 }
 
+void SingleThreadExecutor::asyncEnqueue(std::function<void()> Task,
+                                        ThreadPoolTaskGroup *Group) {
+  auto &Queue = Group && Group->isHighPriority() ? HighPriorityTasks : Tasks;
+  Queue.emplace_back(std::move(Task), Group);
+}
+
 void SingleThreadExecutor::wait() {
   // Sequential implementation running the tasks
-  while (!Tasks.empty()) {
-    auto Task = std::move(Tasks.front().first);
-    Tasks.pop_front();
+  while (!Tasks.empty() || !HighPriorityTasks.empty()) {
+    auto &Queue = HighPriorityTasks.empty() ? Tasks : HighPriorityTasks;
+    auto Task = std::move(Queue.front().first);
+    Queue.pop_front();
     Task();
   }
 }
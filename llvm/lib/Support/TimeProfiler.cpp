@@ -126,11 +126,13 @@ struct InProgressEntry {
 
 struct llvm::TimeTraceProfiler {
   TimeTraceProfiler(unsigned TimeTraceGranularity = 0, StringRef ProcName = "",
-                    bool TimeTraceVerbose = false)
+                    bool TimeTraceVerbose = false,
+                    bool TimeTraceSummaryOnly = false)
       : BeginningOfTime(system_clock::now()), StartTime(ClockType::now()),
         ProcName(ProcName), Pid(sys::Process::getProcessId()),
         Tid(llvm::get_threadid()), TimeTraceGranularity(TimeTraceGranularity),
-        TimeTraceVerbose(TimeTraceVerbose) {
+        TimeTraceVerbose(TimeTraceVerbose),
+        TimeTraceSummaryOnly(TimeTraceSummaryOnly) {
     llvm::get_thread_name(ThreadName);
   }
 
@@ -140,8 +142,8 @@ struct llvm::TimeTraceProfiler {
     assert(EventType != TimeTraceEventType::InstantEvent &&
            "Instant Events don't have begin and end.");
     Stack.emplace_back(std::make_unique<InProgressEntry>(
-        ClockType::now(), TimePointType(), std::move(Name), Detail(),
-        EventType));
+        ClockType::now(), TimePointType(), std::move(Name),
+        TimeTraceSummaryOnly ? std::string() : Detail(), EventType));
     return &Stack.back()->Event;
   }
 
@@ -151,13 +153,13 @@ struct llvm::TimeTraceProfiler {
     assert(EventType != TimeTraceEventType::InstantEvent &&
            "Instant Events don't have begin and end.");
     Stack.emplace_back(std::make_unique<InProgressEntry>(
-        ClockType::now(), TimePointType(), std::move(Name), Metadata(),
-        EventType));
+        ClockType::now(), TimePointType(), std::move(Name),
+        TimeTraceSummaryOnly ? TimeTraceMetadata() : Metadata(), EventType));
     return &Stack.back()->Event;
   }
 
   void insert(std::string Name, llvm::function_ref<std::string()> Detail) {
-    if (Stack.empty())
+    if (Stack.empty() || TimeTraceSummaryOnly)
       return;
 
     Stack.back()->InstantEvents.emplace_back(TimeTraceProfilerEntry(
@@ -184,7 +186,8 @@ struct llvm::TimeTraceProfiler {
     assert(Iter != Stack.end() && "Event not in the Stack");
 
     // Only include sections longer or equal to TimeTraceGranularity msec.
-    if (duration_cast<microseconds>(Duration).count() >= TimeTraceGranularity) {
+    if (!TimeTraceSummaryOnly &&
+        duration_cast<microseconds>(Duration).count() >= TimeTraceGranularity) {
       Entries.emplace_back(E);
       for (auto &IE : Iter->get()->InstantEvents) {
         Entries.emplace_back(IE);
@@ -381,6 +384,11 @@ struct llvm::TimeTraceProfiler {
   // Make time trace capture verbose event details (e.g. source filenames). This
   // can increase the size of the output by 2-3 times.
   const bool TimeTraceVerbose;
+
+  // Only record the per-name totals. Event details are never computed and
+  // individual events are not kept, so the profiler is cheap enough to leave
+  // enabled and the output stays small.
+  const bool TimeTraceSummaryOnly;
 };
 
 bool llvm::isTimeTraceVerbose() {
@@ -390,12 +398,13 @@ bool llvm::isTimeTraceVerbose() {
 
 void llvm::timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
                                        StringRef ProcName,
-                                       bool TimeTraceVerbose) {
+                                       bool TimeTraceVerbose,
+                                       bool TimeTraceSummaryOnly) {
   assert(TimeTraceProfilerInstance == nullptr &&
          "Profiler should not be initialized");
   TimeTraceProfilerInstance = new TimeTraceProfiler(
       TimeTraceGranularity, llvm::sys::path::filename(ProcName),
-      TimeTraceVerbose);
+      TimeTraceVerbose, TimeTraceSummaryOnly);
 }
 
 // Removes all TimeTraceProfilerInstances.
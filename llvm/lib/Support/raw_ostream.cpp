@@ -856,8 +856,10 @@ size_t raw_fd_ostream::preferred_buffer_size() const {
   // the complexity.
   if (S_ISCHR(statbuf.st_mode) && is_displayed())
     return 0;
-  // Return the preferred block size.
-  return statbuf.st_blksize;
+  // Use the preferred block size, but batch at least 64 KiB per write() call.
+  // st_blksize is typically 4 KiB, which turns writing a large object file or
+  // debug dump into hundreds of thousands of system calls.
+  return std::max<size_t>(statbuf.st_blksize, 64 * 1024);
 #endif
 }
 
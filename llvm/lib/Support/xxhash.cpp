@@ -562,6 +562,41 @@ uint64_t llvm::xxh3_64bits(ArrayRef<uint8_t> data) {
   return XXH3_hashLong_64b(in, len, kSecret, sizeof(kSecret));
 }
 
+template <size_t Len>
+static void XXH3_records_0to16_64b(const uint8_t *in, uint64_t *out,
+                                   size_t num) {
+  for (size_t i = 0; i != num; ++i, in += Len)
+    out[i] = XXH3_len_0to16_64b(in, Len, kSecret, 0);
+}
+
+void llvm::xxh3_64bits_records(ArrayRef<uint8_t> data, size_t recordSize,
+                               MutableArrayRef<uint64_t> out) {
+  assert(recordSize && data.size() % recordSize == 0 &&
+         out.size() == data.size() / recordSize);
+  auto *in = data.data();
+  size_t num = out.size();
+  // Constant lengths let the compiler fold the branches of the short-input
+  // paths, leaving a handful of multiplies per record.
+  switch (recordSize) {
+  case 4:
+    return XXH3_records_0to16_64b<4>(in, out.data(), num);
+  case 8:
+    return XXH3_records_0to16_64b<8>(in, out.data(), num);
+  case 16:
+    return XXH3_records_0to16_64b<16>(in, out.data(), num);
+  }
+  if (recordSize <= 16) {
+    for (size_t i = 0; i != num; ++i, in += recordSize)
+      out[i] = XXH3_len_0to16_64b(in, recordSize, kSecret, 0);
+  } else if (recordSize <= 128) {
+    for (size_t i = 0; i != num; ++i, in += recordSize)
+      out[i] = XXH3_len_17to128_64b(in, recordSize, kSecret, 0);
+  } else {
+    for (size_t i = 0; i != num; ++i, in += recordSize)
+      out[i] = xxh3_64bits(ArrayRef(in, recordSize));
+  }
+}
+
 /* ==========================================
  * XXH3 128 bits (a.k.a XXH128)
  * ==========================================
@@ -3086,6 +3086,119 @@ AArch64TargetLowering::EmitF128CSEL(MachineInstr &MI,
   return EndBB;
 }
 
+MachineBasicBlock *
+AArch64TargetLowering::EmitSVEMemLoop(MachineInstr &MI,
+                                      MachineBasicBlock *MBB) const {
+  // We materialise the SVE memcpy/memset pseudo-instructions as a loop
+  // handling one vector of bytes per iteration, the predicate disabling the
+  // lanes past the end:
+
+  // OrigBB:
+  //     [Splat = dup Value, for memset]
+  //     StartIdx = mov #0
+  //     whilelo StartPg.b, StartIdx, Size
+  //     b.eq EndBB
+  // LoopBB:
+  //     Idx = PHI [StartIdx, OrigBB], [NextIdx, LoopBB]
+  //     Pg = PHI [StartPg, OrigBB], [NextPg, LoopBB]
+  //     [ld1b Data.b, Pg/z, [Src, Idx], for memcpy]
+  //     st1b Data.b, Pg, [Dst, Idx]
+  //     NextIdx = incb Idx
+  //     whilelo NextPg.b, NextIdx, Size
+  //     b.first LoopBB
+  // EndBB:
+
+  MachineFunction *MF = MBB->getParent();
+  MachineRegisterInfo &MRI = MF->getRegInfo();
+  const TargetInstrInfo *TII = Subtarget->getInstrInfo();
+  const BasicBlock *LLVM_BB = MBB->getBasicBlock();
+  DebugLoc DL = MI.getDebugLoc();
+  MachineFunction::iterator It = ++MBB->getIterator();
+
+  bool IsSet = MI.getOpcode() == AArch64::SVEMemorySetLoopPseudo;
+  Register DstReg = MI.getOperand(0).getReg();
+  Register SrcOrValueReg = MI.getOperand(1).getReg();
+  Register SizeReg = MI.getOperand(2).getReg();
+  SmallVector<MachineMemOperand *, 1> LoadMMOs, StoreMMOs;
+  for (MachineMemOperand *MMO : MI.memoperands())
+    (MMO->isLoad() ? LoadMMOs : StoreMMOs).push_back(MMO);
+
+  MachineBasicBlock *LoopBB = MF->CreateMachineBasicBlock(LLVM_BB);
+  MachineBasicBlock *EndBB = MF->CreateMachineBasicBlock(LLVM_BB);
+  MF->insert(It, LoopBB);
+  MF->insert(It, EndBB);
+
+  // Transfer rest of current basic-block to EndBB
+  EndBB->splice(EndBB->begin(), MBB, std::next(MachineBasicBlock::iterator(MI)),
+                MBB->end());
+  EndBB->transferSuccessorsAndUpdatePHIs(MBB);
+
+  Register DataReg;
+  if (IsSet) {
+    Register ValueReg = MRI.createVirtualRegister(&AArch64::GPR32spRegClass);
+    BuildMI(MBB, DL, TII->get(TargetOpcode::COPY), ValueReg)
+        .addReg(SrcOrValueReg);
+    DataReg = MRI.createVirtualRegister(&AArch64::ZPRRegClass);
+    BuildMI(MBB, DL, TII->get(AArch64::DUP_ZR_B), DataReg).addReg(ValueReg);
+  }
+  Register StartIdxReg =
+      MRI.createVirtualRegister(&AArch64::GPR64commonRegClass);
+  Register StartPgReg = MRI.createVirtualRegister(&AArch64::PPR_3bRegClass);
+  BuildMI(MBB, DL, TII->get(AArch64::MOVi64imm), StartIdxReg).addImm(0);
+  BuildMI(MBB, DL, TII->get(AArch64::WHILELO_PXX_B), StartPgReg)
+      .addReg(StartIdxReg)
+      .addReg(SizeReg);
+  BuildMI(MBB, DL, TII->get(AArch64::Bcc)).addImm(AArch64CC::EQ).addMBB(EndBB);
+  MBB->addSuccessor(LoopBB);
+  MBB->addSuccessor(EndBB);
+
+  Register IdxReg = MRI.createVirtualRegister(&AArch64::GPR64commonRegClass);
+  Register PgReg = MRI.createVirtualRegister(&AArch64::PPR_3bRegClass);
+  Register NextIdxReg =
+      MRI.createVirtualRegister(&AArch64::GPR64commonRegClass);
+  Register NextPgReg = MRI.createVirtualRegister(&AArch64::PPR_3bRegClass);
+  BuildMI(LoopBB, DL, TII->get(AArch64::PHI), IdxReg)
+      .addReg(StartIdxReg)
+      .addMBB(MBB)
+      .addReg(NextIdxReg)
+      .addMBB(LoopBB);
+  BuildMI(LoopBB, DL, TII->get(AArch64::PHI), PgReg)
+      .addReg(StartPgReg)
+      .addMBB(MBB)
+      .addReg(NextPgReg)
+      .addMBB(LoopBB);
+  if (!IsSet) {
+    DataReg = MRI.createVirtualRegister(&AArch64::ZPRRegClass);
+    BuildMI(LoopBB, DL, TII->get(AArch64::LD1B), DataReg)
+        .addReg(PgReg)
+        .addReg(SrcOrValueReg)
+        .addReg(IdxReg)
+        .setMemRefs(LoadMMOs);
+  }
+  BuildMI(LoopBB, DL, TII->get(AArch64::ST1B))
+      .addReg(DataReg)
+      .addReg(PgReg)
+      .addReg(DstReg)
+      .addReg(IdxReg)
+      .setMemRefs(StoreMMOs);
+  BuildMI(LoopBB, DL, TII->get(AArch64::INCB_XPiI), NextIdxReg)
+      .addReg(IdxReg)
+      .addImm(AArch64SVEPredPattern::all)
+      .addImm(1);
+  BuildMI(LoopBB, DL, TII->get(AArch64::WHILELO_PXX_B), NextPgReg)
+      .addReg(NextIdxReg)
+      .addReg(SizeReg);
+  // The first lane is active if and only if N is set.
+  BuildMI(LoopBB, DL, TII->get(AArch64::Bcc))
+      .addImm(AArch64CC::MI)
+      .addMBB(LoopBB);
+  LoopBB->addSuccessor(LoopBB);
+  LoopBB->addSuccessor(EndBB);
+
+  MI.eraseFromParent();
+  return EndBB;
+}
+
 MachineBasicBlock *AArch64TargetLowering::EmitLoweredCatchRet(
        MachineInstr &MI, MachineBasicBlock *BB) const {
   assert(!isAsynchronousEHPersonality(classifyEHPersonality(
@@ -3383,6 +3496,9 @@ MachineBasicBlock *AArch64TargetLowering::EmitInstrWithCustomInserter(
     return EmitGetSMESaveSize(MI, BB);
   case AArch64::F128CSEL:
     return EmitF128CSEL(MI, BB);
+  case AArch64::SVEMemoryCopyLoopPseudo:
+  case AArch64::SVEMemorySetLoopPseudo:
+    return EmitSVEMemLoop(MI, BB);
   case TargetOpcode::STATEPOINT:
     // STATEPOINT is a pseudo instruction which has no implicit defs/uses
     // while bl call instruction (where statepoint will be lowered at the end)
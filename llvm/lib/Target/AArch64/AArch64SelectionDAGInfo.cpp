@@ -23,6 +23,12 @@ static cl::opt<bool>
                                 "to lower to librt functions"),
                        cl::init(true));
 
+static cl::opt<bool> EnableSVEMemLoops(
+    "aarch64-sve-mem-loops", cl::Hidden,
+    cl::desc("Expand memcpy and memset of a variable length into predicated "
+             "SVE loops instead of calling the library"),
+    cl::init(false));
+
 bool AArch64SelectionDAGInfo::isTargetMemoryOpcode(unsigned Opcode) const {
   return Opcode >= AArch64ISD::FIRST_MEMORY_OPCODE &&
          Opcode <= AArch64ISD::LAST_MEMORY_OPCODE;
@@ -79,6 +85,35 @@ SDValue AArch64SelectionDAGInfo::EmitMOPS(unsigned Opcode, SelectionDAG &DAG,
   }
 }
 
+SDValue AArch64SelectionDAGInfo::EmitSVEMemLoop(
+    unsigned Opcode, SelectionDAG &DAG, const SDLoc &DL, SDValue Chain,
+    SDValue Dst, SDValue SrcOrValue, SDValue Size, Align Alignment,
+    MachinePointerInfo DstPtrInfo, MachinePointerInfo SrcPtrInfo) const {
+  const bool IsSet = Opcode == AArch64::SVEMemorySetLoopPseudo;
+  MachineFunction &MF = DAG.getMachineFunction();
+
+  // The loop accesses one vector at a time, so only the start of the accesses
+  // is known.
+  SmallVector<MachineMemOperand *, 2> MemOps;
+  MemOps.push_back(MF.getMachineMemOperand(DstPtrInfo,
+                                           MachineMemOperand::MOStore,
+                                           LocationSize::afterPointer(),
+                                           Alignment));
+  if (IsSet) {
+    SrcOrValue = DAG.getZExtOrTrunc(SrcOrValue, DL, MVT::i32);
+  } else {
+    MemOps.push_back(MF.getMachineMemOperand(SrcPtrInfo,
+                                             MachineMemOperand::MOLoad,
+                                             LocationSize::afterPointer(),
+                                             Alignment));
+  }
+
+  SDValue Ops[] = {Dst, SrcOrValue, Size, Chain};
+  MachineSDNode *Node = DAG.getMachineNode(Opcode, DL, MVT::Other, Ops);
+  DAG.setNodeMemRefs(Node, MemOps);
+  return SDValue(Node, 0);
+}
+
 SDValue AArch64SelectionDAGInfo::EmitStreamingCompatibleMemLibCall(
     SelectionDAG &DAG, const SDLoc &DL, SDValue Chain, SDValue Dst, SDValue Src,
     SDValue Size, RTLIB::Libcall LC) const {
@@ -148,6 +183,11 @@ SDValue AArch64SelectionDAGInfo::EmitTargetCodeForMemcpy(
     return EmitMOPS(AArch64::MOPSMemoryCopyPseudo, DAG, DL, Chain, Dst, Src,
                     Size, Alignment, isVolatile, DstPtrInfo, SrcPtrInfo);
 
+  if (EnableSVEMemLoops && STI.isSVEAvailable() && !isVolatile &&
+      !isa<ConstantSDNode>(Size))
+    return EmitSVEMemLoop(AArch64::SVEMemoryCopyLoopPseudo, DAG, DL, Chain,
+                          Dst, Src, Size, Alignment, DstPtrInfo, SrcPtrInfo);
+
   SMEAttrs Attrs(DAG.getMachineFunction().getFunction());
   if (LowerToSMERoutines && !Attrs.hasNonStreamingInterfaceAndBody())
     return EmitStreamingCompatibleMemLibCall(DAG, DL, Chain, Dst, Src, Size,
@@ -167,6 +207,12 @@ SDValue AArch64SelectionDAGInfo::EmitTargetCodeForMemset(
                     Size, Alignment, isVolatile, DstPtrInfo,
                     MachinePointerInfo{});
 
+  if (EnableSVEMemLoops && STI.isSVEAvailable() && !isVolatile &&
+      !isa<ConstantSDNode>(Size))
+    return EmitSVEMemLoop(AArch64::SVEMemorySetLoopPseudo, DAG, dl, Chain, Dst,
+                          Src, Size, Alignment, DstPtrInfo,
+                          MachinePointerInfo{});
+
   SMEAttrs Attrs(DAG.getMachineFunction().getFunction());
   if (LowerToSMERoutines && !Attrs.hasNonStreamingInterfaceAndBody())
     return EmitStreamingCompatibleMemLibCall(DAG, dl, Chain, Dst, Src, Size,
@@ -29,6 +29,12 @@ public:
                    MachinePointerInfo DstPtrInfo,
                    MachinePointerInfo SrcPtrInfo) const;
 
+  SDValue EmitSVEMemLoop(unsigned Opcode, SelectionDAG &DAG, const SDLoc &DL,
+                         SDValue Chain, SDValue Dst, SDValue SrcOrValue,
+                         SDValue Size, Align Alignment,
+                         MachinePointerInfo DstPtrInfo,
+                         MachinePointerInfo SrcPtrInfo) const;
+
   SDValue EmitTargetCodeForMemcpy(SelectionDAG &DAG, const SDLoc &dl,
                                   SDValue Chain, SDValue Dst, SDValue Src,
                                   SDValue Size, Align Alignment,
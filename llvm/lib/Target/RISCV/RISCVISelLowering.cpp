@@ -1722,6 +1722,15 @@ bool RISCVTargetLowering::getTgtMemIntrinsic(IntrinsicInfo &Info,
   case Intrinsic::riscv_seg8_load:
     return SetRVVLoadStoreInfo(/*PtrOp*/ 0, /*IsStore*/ false,
                                /*IsUnitStrided*/ false, /*UsePtrVal*/ true);
+  case Intrinsic::riscv_sseg2_load:
+  case Intrinsic::riscv_sseg3_load:
+  case Intrinsic::riscv_sseg4_load:
+  case Intrinsic::riscv_sseg5_load:
+  case Intrinsic::riscv_sseg6_load:
+  case Intrinsic::riscv_sseg7_load:
+  case Intrinsic::riscv_sseg8_load:
+    return SetRVVLoadStoreInfo(/*PtrOp*/ 0, /*IsStore*/ false,
+                               /*IsUnitStrided*/ false);
   case Intrinsic::riscv_seg2_store:
   case Intrinsic::riscv_seg3_store:
   case Intrinsic::riscv_seg4_store:
@@ -10291,13 +10300,27 @@ SDValue RISCVTargetLowering::LowerINTRINSIC_W_CHAIN(SDValue Op,
   case Intrinsic::riscv_seg5_load:
   case Intrinsic::riscv_seg6_load:
   case Intrinsic::riscv_seg7_load:
-  case Intrinsic::riscv_seg8_load: {
+  case Intrinsic::riscv_seg8_load:
+  case Intrinsic::riscv_sseg2_load:
+  case Intrinsic::riscv_sseg3_load:
+  case Intrinsic::riscv_sseg4_load:
+  case Intrinsic::riscv_sseg5_load:
+  case Intrinsic::riscv_sseg6_load:
+  case Intrinsic::riscv_sseg7_load:
+  case Intrinsic::riscv_sseg8_load: {
     SDLoc DL(Op);
     static const Intrinsic::ID VlsegInts[7] = {
         Intrinsic::riscv_vlseg2, Intrinsic::riscv_vlseg3,
         Intrinsic::riscv_vlseg4, Intrinsic::riscv_vlseg5,
         Intrinsic::riscv_vlseg6, Intrinsic::riscv_vlseg7,
         Intrinsic::riscv_vlseg8};
+    static const Intrinsic::ID VlssegInts[7] = {
+        Intrinsic::riscv_vlsseg2, Intrinsic::riscv_vlsseg3,
+        Intrinsic::riscv_vlsseg4, Intrinsic::riscv_vlsseg5,
+        Intrinsic::riscv_vlsseg6, Intrinsic::riscv_vlsseg7,
+        Intrinsic::riscv_vlsseg8};
+    bool IsStrided = IntNo >= Intrinsic::riscv_sseg2_load &&
+                     IntNo <= Intrinsic::riscv_sseg8_load;
     unsigned NF = Op->getNumValues() - 1;
     assert(NF >= 2 && NF <= 8 && "Unexpected seg number");
     MVT XLenVT = Subtarget.getXLenVT();
@@ -10308,17 +10331,17 @@ SDValue RISCVTargetLowering::LowerINTRINSIC_W_CHAIN(SDValue Op,
     EVT VecTupTy = MVT::getRISCVVectorTupleVT(Sz, NF);
 
     SDValue VL = DAG.getConstant(VT.getVectorNumElements(), DL, XLenVT);
-    SDValue IntID = DAG.getTargetConstant(VlsegInts[NF - 2], DL, XLenVT);
+    SDValue IntID = DAG.getTargetConstant(
+        IsStrided ? VlssegInts[NF - 2] : VlsegInts[NF - 2], DL, XLenVT);
     auto *Load = cast<MemIntrinsicSDNode>(Op);
 
     SDVTList VTs = DAG.getVTList({VecTupTy, MVT::Other});
-    SDValue Ops[] = {
-        Load->getChain(),
-        IntID,
-        DAG.getUNDEF(VecTupTy),
-        Op.getOperand(2),
-        VL,
-        DAG.getTargetConstant(Log2_64(VT.getScalarSizeInBits()), DL, XLenVT)};
+    SmallVector<SDValue, 7> Ops = {Load->getChain(), IntID,
+                                   DAG.getUNDEF(VecTupTy), Op.getOperand(2)};
+    if (IsStrided)
+      Ops.push_back(Op.getOperand(3));
+    Ops.append({VL, DAG.getTargetConstant(Log2_64(VT.getScalarSizeInBits()),
+                                          DL, XLenVT)});
     SDValue Result =
         DAG.getMemIntrinsicNode(ISD::INTRINSIC_W_CHAIN, DL, VTs, Ops,
                                 Load->getMemoryVT(), Load->getMemOperand());
@@ -23009,6 +23032,12 @@ static const Intrinsic::ID FixedVlsegIntrIds[] = {
     Intrinsic::riscv_seg6_load, Intrinsic::riscv_seg7_load,
     Intrinsic::riscv_seg8_load};
 
+static const Intrinsic::ID FixedVlssegIntrIds[] = {
+    Intrinsic::riscv_sseg2_load, Intrinsic::riscv_sseg3_load,
+    Intrinsic::riscv_sseg4_load, Intrinsic::riscv_sseg5_load,
+    Intrinsic::riscv_sseg6_load, Intrinsic::riscv_sseg7_load,
+    Intrinsic::riscv_sseg8_load};
+
 /// Lower an interleaved load into a vlsegN intrinsic.
 ///
 /// E.g. Lower an interleaved load (Factor = 2):
@@ -23059,6 +23088,30 @@ bool RISCVTargetLowering::lowerInterleavedLoad(
 
   Value *VL = ConstantInt::get(XLenTy, VTy->getNumElements());
 
+  // Likewise, if the first or last fields are unused, only load the fields
+  // in between with a strided segment load.
+  auto [MinIndex, MaxIndex] =
+      std::minmax_element(Indices.begin(), Indices.end());
+  unsigned FirstIndex = *MinIndex;
+  unsigned NumFields = *MaxIndex - FirstIndex + 1;
+  if (NumFields > 1 && NumFields < Factor &&
+      !Subtarget.hasOptimizedSegmentLoadStore(Factor)) {
+    unsigned ScalarSizeInBytes = VTy->getScalarSizeInBits() / 8;
+    Value *Stride = ConstantInt::get(XLenTy, Factor * ScalarSizeInBytes);
+    Value *Offset = ConstantInt::get(XLenTy, FirstIndex * ScalarSizeInBytes);
+    Value *BasePtr = Builder.CreatePtrAdd(LI->getPointerOperand(), Offset);
+    CallInst *VlssegN = Builder.CreateIntrinsic(
+        FixedVlssegIntrIds[NumFields - 2],
+        {VTy, BasePtr->getType(), XLenTy}, {BasePtr, Stride, VL});
+
+    for (unsigned i = 0; i < Shuffles.size(); i++) {
+      Value *SubVec =
+          Builder.CreateExtractValue(VlssegN, Indices[i] - FirstIndex);
+      Shuffles[i]->replaceAllUsesWith(SubVec);
+    }
+    return true;
+  }
+
   CallInst *VlsegN = Builder.CreateIntrinsic(
       FixedVlsegIntrIds[Factor - 2], {VTy, LI->getPointerOperandType(), XLenTy},
       {LI->getPointerOperand(), VL});
@@ -911,6 +911,14 @@ InstructionCost RISCVTTIImpl::getInterleavedMemoryOpCost(
             getMemoryOpCost(Opcode, VTy->getElementType(), Alignment, 0,
                             CostKind, {TTI::OK_AnyValue, TTI::OP_None});
         unsigned NumLoads = getEstimatedVLFor(VTy);
+        // Fixed vector loads only access the fields from the first to the
+        // last used one, see RISCVTargetLowering::lowerInterleavedLoad.
+        if (Opcode == Instruction::Load && isa<FixedVectorType>(VTy) &&
+            !Indices.empty()) {
+          auto [MinIndex, MaxIndex] =
+              std::minmax_element(Indices.begin(), Indices.end());
+          NumLoads = NumLoads / Factor * (*MaxIndex - *MinIndex + 1);
+        }
         return NumLoads * MemOpCost;
       }
     }
@@ -10,9 +10,20 @@
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/SandboxIR/Instruction.h"
 #include "llvm/SandboxIR/Utils.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Transforms/Vectorize/SandboxVectorizer/Scheduler.h"
 
-namespace llvm::sandboxir {
+namespace llvm {
+
+static cl::opt<unsigned> DAGAABudget(
+    "sbvec-dag-aa-budget", cl::init(10000), cl::Hidden,
+    cl::desc("The maximum number of alias queries the dependency graph makes "
+             "for a region. Once exhausted, memory instructions are assumed "
+             "to depend on each other."));
+
+namespace sandboxir {
+
+unsigned DependencyGraph::getDefaultAABudget() { return DAGAABudget; }
 
 User::op_iterator PredIterator::skipBadIt(User::op_iterator OpIt,
                                           User::op_iterator OpItE,
@@ -187,11 +198,15 @@ bool DependencyGraph::alias(Instruction *SrcI, Instruction *DstI,
   // Check aliasing.
   assert((SrcI->mayReadFromMemory() || SrcI->mayWriteToMemory()) &&
          "Expected a mem instr");
-  // TODO: Check AABudget
+  if (isOrdered(SrcI))
+    return true;
+  // Large blocks can make the number of queries quadratic, so stop asking AA
+  // once the budget is exhausted.
+  if (AAQueries >= AABudget)
+    return true;
+  ++AAQueries;
   ModRefInfo SrcModRef =
-      isOrdered(SrcI)
-          ? ModRefInfo::ModRef
-          : Utils::aliasAnalysisGetModRefInfo(*BatchAA, SrcI, *DstLocOpt);
+      Utils::aliasAnalysisGetModRefInfo(*BatchAA, SrcI, *DstLocOpt);
   switch (DepType) {
   case DependencyType::ReadAfterWrite:
   case DependencyType::WriteAfterWrite:
@@ -662,4 +677,5 @@ void DependencyGraph::dump() const {
 }
 #endif // NDEBUG
 
-} // namespace llvm::sandboxir
+} // namespace sandboxir
+} // namespace llvm
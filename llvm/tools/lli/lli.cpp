@@ -143,6 +143,13 @@ namespace {
                "rather than individual functions"),
       cl::init(false));
 
+  cl::opt<unsigned> LazyClusterSize(
+      "lazy-cluster-size",
+      cl::desc("Compile each lazily requested function together with its "
+               "direct callees, up to this many IR instructions per "
+               "partition (jit-kind=orc-lazy only)"),
+      cl::init(0));
+
   cl::list<std::string>
       JITDylibs("jd",
                 cl::desc("Specifies the JITDylib to be used for any subsequent "
@@ -1057,6 +1064,9 @@ int runOrcJIT(const char *ProgName) {
 
   if (PerModuleLazy)
     J->setPartitionFunction(orc::IRPartitionLayer::compileWholeModule);
+  else if (LazyClusterSize)
+    J->setPartitionFunction(
+        orc::IRPartitionLayer::clusterByCallGraph(LazyClusterSize));
 
   auto IRDump = createIRDebugDumper();
   J->getIRTransformLayer().setTransform(
@@ -1198,6 +1208,11 @@ void disallowOrcOptions() {
     errs() << "-per-module-lazy requires -jit-kind=orc-lazy\n";
     exit(1);
   }
+
+  if (LazyClusterSize) {
+    errs() << "-lazy-cluster-size requires -jit-kind=orc-lazy\n";
+    exit(1);
+  }
 }
 
 Expected<std::unique_ptr<orc::ExecutorProcessControl>> launchRemote() {
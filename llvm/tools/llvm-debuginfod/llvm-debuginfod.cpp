@@ -24,6 +24,7 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/LLVMDriver.h"
 #include "llvm/Support/ThreadPool.h"
+#include <optional>
 
 using namespace llvm;
 
@@ -64,9 +65,16 @@ static std::string HostInterface;
 static int ScanInterval;
 static double MinInterval;
 static size_t MaxConcurrency;
+static std::optional<unsigned> RequestThreads;
+static unsigned KeepAliveTimeout;
 static bool VerboseLogging;
 static std::vector<std::string> ScanPaths;
 
+// A debugger fetches the debug info of every module it loads, usually over one
+// persistent connection, so let that connection serve many requests. The idle
+// timeout (-k) is what returns its thread to the pool.
+static constexpr size_t KeepAliveMaxCount = 100;
+
 ExitOnError ExitOnErr;
 
 template <typename T>
@@ -107,6 +115,9 @@ static void parseArgs(int argc, char **argv) {
   parseIntArg(Args, OPT_port, Port, 0u);
   parseIntArg(Args, OPT_scan_interval, ScanInterval, 300);
   parseIntArg(Args, OPT_max_concurrency, MaxConcurrency, size_t(0));
+  if (Args.hasArg(OPT_request_threads))
+    parseIntArg(Args, OPT_request_threads, RequestThreads.emplace(), 0u);
+  parseIntArg(Args, OPT_keep_alive_timeout, KeepAliveTimeout, 5u);
 
   if (const opt::Arg *A = Args.getLastArg(OPT_min_interval)) {
     StringRef V(A->getValue());
@@ -133,6 +144,10 @@ int llvm_debuginfod_main(int argc, char **argv, const llvm::ToolContext &) {
   DebuginfodLog Log;
   DebuginfodCollection Collection(Paths, Log, Pool, MinInterval);
   DebuginfodServer Server(Log, Collection);
+  if (RequestThreads)
+    Server.Server.setNumThreads(*RequestThreads);
+  Server.Server.setKeepAlive(KeepAliveMaxCount,
+                             std::chrono::seconds(KeepAliveTimeout));
 
   if (!Port)
     Port = ExitOnErr(Server.Server.bind(HostInterface.c_str()));
@@ -45,7 +45,10 @@
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/TargetParser/Host.h"
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <thread>
 
 namespace llvm {
 namespace exegesis {
@@ -274,6 +277,13 @@ static cl::opt<int> BenchmarkProcessCPU(
     cl::desc("The CPU number that the benchmarking process should executon on"),
     cl::cat(BenchmarkOptions), cl::init(-1));
 
+static cl::list<int> BenchmarkProcessCPUs(
+    "benchmark-process-cpus",
+    cl::desc("Comma separated list of CPUs to run the benchmarking processes "
+             "on. The snippets are measured concurrently, one at a time on "
+             "each CPU, which should be isolated from the rest of the system"),
+    cl::CommaSeparated, cl::cat(BenchmarkOptions));
+
 static cl::opt<std::string> MAttr(
     "mattr", cl::desc("comma-separated list of target architecture features"),
     cl::value_desc("+feature1,-feature2,..."), cl::cat(Options), cl::init(""));
@@ -386,6 +396,56 @@ generateSnippets(const LLVMState &State, unsigned Opcode,
   return Benchmarks;
 }
 
+// Measures Conf with each repetitor and aggregates the results.
+static Benchmark runBenchmarkConfiguration(
+    const BenchmarkCode &Conf,
+    ArrayRef<std::unique_ptr<const SnippetRepetitor>> Repetitors,
+    ArrayRef<unsigned> MinInstructionCounts, const BenchmarkRunner &Runner,
+    std::optional<int> BenchmarkCPU) {
+  SmallVector<Benchmark, 2> AllResults;
+
+  for (const std::unique_ptr<const SnippetRepetitor> &Repetitor : Repetitors) {
+    for (unsigned IterationRepetitions : MinInstructionCounts) {
+      auto RC = ExitOnErr(Runner.getRunnableConfiguration(
+          Conf, IterationRepetitions, LoopBodySize, *Repetitor));
+      std::optional<StringRef> DumpFile;
+      if (DumpObjectToDisk.getNumOccurrences())
+        DumpFile = DumpObjectToDisk;
+      auto [Err, BenchmarkResult] =
+          Runner.runConfiguration(std::move(RC), DumpFile, BenchmarkCPU);
+      if (Err) {
+        // Errors from executing the snippets are fine.
+        // All other errors are a framework issue and should fail.
+        if (!Err.isA<SnippetExecutionFailure>())
+          ExitOnErr(std::move(Err));
+
+        BenchmarkResult.Error = toString(std::move(Err));
+      }
+      AllResults.push_back(std::move(BenchmarkResult));
+    }
+  }
+
+  Benchmark &Result = AllResults.front();
+
+  // If any of our measurements failed, pretend they all have failed.
+  if (AllResults.size() > 1 &&
+      any_of(AllResults,
+             [](const Benchmark &R) { return R.Measurements.empty(); }))
+    Result.Measurements.clear();
+
+  std::unique_ptr<ResultAggregator> ResultAgg =
+      ResultAggregator::CreateAggregator(RepetitionMode);
+  ResultAgg->AggregateResults(Result,
+                              ArrayRef<Benchmark>(AllResults).drop_front());
+
+  // With dummy counters, measurements are rather meaningless,
+  // so drop them altogether.
+  if (UseDummyPerfCounters)
+    Result.Measurements.clear();
+
+  return std::move(Result);
+}
+
 static void runBenchmarkConfigurations(
     const LLVMState &State, ArrayRef<BenchmarkCode> Configurations,
     ArrayRef<std::unique_ptr<const SnippetRepetitor>> Repetitors,
@@ -411,57 +471,48 @@ static void runBenchmarkConfigurations(
       RepetitionMode == Benchmark::MiddleHalfLoop)
     MinInstructionCounts.push_back(MinInstructions * 2);
 
-  for (const BenchmarkCode &Conf : Configurations) {
-    ProgressMeter<>::ProgressMeterStep MeterStep(Meter ? &*Meter : nullptr);
-    SmallVector<Benchmark, 2> AllResults;
-
-    for (const std::unique_ptr<const SnippetRepetitor> &Repetitor :
-         Repetitors) {
-      for (unsigned IterationRepetitions : MinInstructionCounts) {
-        auto RC = ExitOnErr(Runner.getRunnableConfiguration(
-            Conf, IterationRepetitions, LoopBodySize, *Repetitor));
-        std::optional<StringRef> DumpFile;
-        if (DumpObjectToDisk.getNumOccurrences())
-          DumpFile = DumpObjectToDisk;
-        const std::optional<int> BenchmarkCPU =
-            BenchmarkProcessCPU == -1
-                ? std::nullopt
-                : std::optional(BenchmarkProcessCPU.getValue());
-        auto [Err, BenchmarkResult] =
-            Runner.runConfiguration(std::move(RC), DumpFile, BenchmarkCPU);
-        if (Err) {
-          // Errors from executing the snippets are fine.
-          // All other errors are a framework issue and should fail.
-          if (!Err.isA<SnippetExecutionFailure>())
-            ExitOnErr(std::move(Err));
-
-          BenchmarkResult.Error = toString(std::move(Err));
-        }
-        AllResults.push_back(std::move(BenchmarkResult));
-      }
+  if (BenchmarkProcessCPUs.empty()) {
+    const std::optional<int> BenchmarkCPU =
+        BenchmarkProcessCPU == -1
+            ? std::nullopt
+            : std::optional(BenchmarkProcessCPU.getValue());
+    for (const BenchmarkCode &Conf : Configurations) {
+      ProgressMeter<>::ProgressMeterStep MeterStep(Meter ? &*Meter : nullptr);
+      Benchmark Result = runBenchmarkConfiguration(
+          Conf, Repetitors, MinInstructionCounts, Runner, BenchmarkCPU);
+      ExitOnFileError(BenchmarkFile, Result.writeYamlTo(State, Ostr));
     }
-
-    Benchmark &Result = AllResults.front();
-
-    // If any of our measurements failed, pretend they all have failed.
-    if (AllResults.size() > 1 &&
-        any_of(AllResults, [](const Benchmark &R) {
-          return R.Measurements.empty();
-        }))
-      Result.Measurements.clear();
-
-    std::unique_ptr<ResultAggregator> ResultAgg =
-        ResultAggregator::CreateAggregator(RepetitionMode);
-    ResultAgg->AggregateResults(Result,
-                                ArrayRef<Benchmark>(AllResults).drop_front());
-
-    // With dummy counters, measurements are rather meaningless,
-    // so drop them altogether.
-    if (UseDummyPerfCounters)
-      Result.Measurements.clear();
-
-    ExitOnFileError(BenchmarkFile, Result.writeYamlTo(State, Ostr));
+    return;
   }
+
+  // Each worker takes the next configuration and measures it in a process
+  // pinned to its CPU, with its own counters. The results are written in the
+  // order of the configurations once they are all measured, so that the file
+  // does not depend on the scheduling of the workers.
+  std::vector<std::optional<Benchmark>> Results(Configurations.size());
+  std::atomic<size_t> NextConf = 0;
+  std::mutex MeterMutex;
+  auto Work = [&](int BenchmarkCPU) {
+    for (size_t I = NextConf++; I < Configurations.size(); I = NextConf++) {
+      std::optional<ProgressMeter<>::ProgressMeterStep> MeterStep;
+      {
+        std::lock_guard<std::mutex> Lock(MeterMutex);
+        MeterStep.emplace(Meter ? &*Meter : nullptr);
+      }
+      Results[I] = runBenchmarkConfiguration(
+          Configurations[I], Repetitors, MinInstructionCounts, Runner,
+          BenchmarkCPU);
+      std::lock_guard<std::mutex> Lock(MeterMutex);
+      MeterStep.reset();
+    }
+  };
+  std::vector<std::thread> Workers;
+  for (int BenchmarkCPU : BenchmarkProcessCPUs)
+    Workers.emplace_back(Work, BenchmarkCPU);
+  for (std::thread &Worker : Workers)
+    Worker.join();
+  for (std::optional<Benchmark> &Result : Results)
+    ExitOnFileError(BenchmarkFile, Result->writeYamlTo(State, Ostr));
 }
 
 void benchmarkMain() {
@@ -498,6 +549,16 @@ void benchmarkMain() {
     ExitWithError("Dummy perf counters are not supported in the subprocess "
                   "execution mode.");
 
+  if (!BenchmarkProcessCPUs.empty()) {
+    if (BenchmarkProcessCPU != -1)
+      ExitWithError("--benchmark-process-cpu and --benchmark-process-cpus "
+                    "cannot be used together");
+    // The in-process executor shares its scratch space between snippets.
+    if (ExecutionMode != BenchmarkRunner::ExecutionModeE::SubProcess)
+      ExitWithError("--benchmark-process-cpus is only supported in the "
+                    "subprocess execution mode");
+  }
+
   const std::unique_ptr<BenchmarkRunner> Runner =
       ExitOnErr(State.getExegesisTarget().createBenchmarkRunner(
           BenchmarkMode, State, BenchmarkPhaseSelector, ExecutionMode,
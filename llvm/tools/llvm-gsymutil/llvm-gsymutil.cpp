@@ -23,6 +23,7 @@
 #include "llvm/Support/LLVMDriver.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/Regex.h"
 #include "llvm/Support/Signals.h"
@@ -159,6 +160,10 @@ static void parseArgs(int argc, char **argv) {
                    << "' value invalid for uint argument!\n";
       std::exit(1);
     }
+    // Also limit the threads used by parallel algorithms such as the sort in
+    // GsymCreator::finalize.
+    if (NumThreads)
+      parallel::strategy = hardware_concurrency(NumThreads);
   }
 
   if (const llvm::opt::Arg *A = Args.getLastArg(OPT_segment_size_EQ)) {
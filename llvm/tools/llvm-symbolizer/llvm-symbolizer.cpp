@@ -15,6 +15,8 @@
 //===----------------------------------------------------------------------===//
 
 #include "Opts.inc"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Config/config.h"
@@ -37,13 +39,20 @@
 #include "llvm/Support/LLVMDriver.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/StringSaver.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/WithColor.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/raw_socket_stream.h"
 #include <algorithm>
+#include <atomic>
+#include <csignal>
 #include <cstdio>
 #include <cstring>
 #include <iostream>
+#include <list>
+#include <mutex>
 #include <string>
+#include <thread>
 
 using namespace llvm;
 using namespace symbolize;
@@ -120,15 +129,18 @@ enum class Command {
 
 static void enableDebuginfod(LLVMSymbolizer &Symbolizer,
                              const opt::ArgList &Args) {
-  static bool IsEnabled = false;
-  if (IsEnabled)
+  // The symbolizers of --listen may get here concurrently.
+  static std::mutex Mu;
+  static SmallPtrSet<LLVMSymbolizer *, 4> Enabled;
+  std::lock_guard<std::mutex> Lock(Mu);
+  if (!Enabled.insert(&Symbolizer).second)
     return;
-  IsEnabled = true;
   // Look up symbols using the debuginfod client.
   Symbolizer.setBuildIDFetcher(std::make_unique<DebuginfodFetcher>(
       Args.getAllArgValues(OPT_debug_file_directory_EQ)));
   // The HTTPClient must be initialized for use by the debuginfod client.
-  HTTPClient::initialize();
+  if (Enabled.size() == 1)
+    HTTPClient::initialize();
 }
 
 static StringRef getSpaceDelimitedWord(StringRef &Source) {
@@ -459,6 +471,137 @@ static object::BuildID parseBuildIDArg(const opt::InputArgList &Args, int ID) {
   return BuildID;
 }
 
+using PrinterFactory =
+    function_ref<std::unique_ptr<DIPrinter>(raw_ostream &OS)>;
+
+// A symbolizer and the lock serializing its use.
+struct SymbolizerShard {
+  std::mutex Mu;
+  LLVMSymbolizer *Symbolizer;
+};
+
+// Handle the commands read from \p Conn until the client disconnects.
+static void serveConnection(raw_socket_stream &Conn,
+                            ArrayRef<std::unique_ptr<SymbolizerShard>> Shards,
+                            const opt::InputArgList &Args,
+                            object::BuildIDRef BuildID, uint64_t AdjustVMA,
+                            bool IsAddr2Line, OutputStyle Style,
+                            PrinterFactory MakePrinter) {
+  std::string Pending;
+  char Buf[4096];
+  while (true) {
+    ssize_t N = Conn.read(Buf, sizeof(Buf));
+    if (N <= 0)
+      break;
+    Pending.append(Buf, N);
+    // Answer all the complete commands read so far with one write. Format the
+    // responses into a string so that a slow client doesn't hold up the
+    // others.
+    std::string Output;
+    raw_string_ostream OS(Output);
+    std::unique_ptr<DIPrinter> Printer = MakePrinter(OS);
+    size_t Begin = 0, Pos;
+    while ((Pos = Pending.find('\n', Begin)) != std::string::npos) {
+      std::string Input = Pending.substr(Begin, Pos - Begin);
+      Begin = Pos + 1;
+      llvm::erase_if(Input, [](char c) { return c == '\r'; });
+      // Each module is only loaded by the symbolizer of its shard, so that
+      // commands for different modules run concurrently.
+      size_t ShardIdx = 0;
+      if (Shards.size() > 1) {
+        Command Cmd;
+        std::string ModuleName;
+        object::BuildID ModuleBuildID(BuildID.begin(), BuildID.end());
+        StringRef Symbol;
+        uint64_t Offset;
+        if (!errorToBool(parseCommand(Args.getLastArgValue(OPT_obj_EQ),
+                                      IsAddr2Line, Input, Cmd, ModuleName,
+                                      ModuleBuildID, Symbol, Offset)))
+          ShardIdx = (ModuleBuildID.empty()
+                          ? hash_value(ModuleName)
+                          : hash_value(ArrayRef<uint8_t>(ModuleBuildID))) %
+                     Shards.size();
+      }
+      SymbolizerShard &Shard = *Shards[ShardIdx];
+      std::lock_guard<std::mutex> Lock(Shard.Mu);
+      symbolizeInput(Args, BuildID, AdjustVMA, IsAddr2Line, Style, Input,
+                     *Shard.Symbolizer, *Printer);
+    }
+    Pending.erase(0, Begin);
+    if (Output.empty())
+      continue;
+    Conn << Output;
+    Conn.flush();
+    if (Conn.has_error()) {
+      Conn.clear_error();
+      return;
+    }
+  }
+}
+
+// Accept connections on the UNIX domain socket at \p Path and handle the
+// commands read from each client as if they were read from stdin. All clients
+// share the symbolizers, so that e.g. the sanitized processes on a host don't
+// each start a symbolizer and parse the same debug info. \p Symbolizers each
+// cache a disjoint set of modules. Commands for modules of different
+// symbolizers run concurrently, the others one at a time.
+static int serve(StringRef Path, const opt::InputArgList &Args,
+                 object::BuildIDRef BuildID, uint64_t AdjustVMA,
+                 bool IsAddr2Line, OutputStyle Style,
+                 ArrayRef<LLVMSymbolizer *> Symbolizers,
+                 PrinterFactory MakePrinter) {
+  Expected<ListeningSocket> Socket = ListeningSocket::createUnix(Path);
+  if (!Socket) {
+    WithColor::error(errs(), ToolName)
+        << "cannot listen on '" << Path << "': "
+        << toString(Socket.takeError()) << '\n';
+    return EXIT_FAILURE;
+  }
+#ifndef _WIN32
+  // A client exiting while we write to it must not take the server down.
+  signal(SIGPIPE, SIG_IGN);
+#endif
+  std::vector<std::unique_ptr<SymbolizerShard>> Shards;
+  for (LLVMSymbolizer *Symbolizer : Symbolizers) {
+    Shards.push_back(std::make_unique<SymbolizerShard>());
+    Shards.back()->Symbolizer = Symbolizer;
+  }
+  struct Connection {
+    std::unique_ptr<raw_socket_stream> Stream;
+    std::thread Thread;
+    std::atomic<bool> Done = false;
+  };
+  // The threads use the state of this frame and of the caller, so they are
+  // joined before returning. Finished ones are joined as new clients connect.
+  std::list<Connection> Connections;
+  auto Join = [&](bool All) {
+    for (auto It = Connections.begin(); It != Connections.end();) {
+      if (!All && !It->Done) {
+        ++It;
+        continue;
+      }
+      It->Thread.join();
+      It = Connections.erase(It);
+    }
+  };
+  while (true) {
+    Expected<std::unique_ptr<raw_socket_stream>> Conn = Socket->accept();
+    if (!Conn) {
+      WithColor::error(errs(), ToolName) << toString(Conn.takeError()) << '\n';
+      Join(/*All=*/true);
+      return EXIT_FAILURE;
+    }
+    Join(/*All=*/false);
+    Connection &C = Connections.emplace_back();
+    C.Stream = std::move(*Conn);
+    C.Thread = std::thread([&] {
+      serveConnection(*C.Stream, Shards, Args, BuildID, AdjustVMA, IsAddr2Line,
+                      Style, MakePrinter);
+      C.Done = true;
+    });
+  }
+}
+
 // Symbolize markup from stdin and write the result to stdout.
 static void filterMarkup(const opt::InputArgList &Args, LLVMSymbolizer &Symbolizer) {
   MarkupFilter Filter(outs(), Symbolizer, parseColorArg(Args));
@@ -515,6 +658,14 @@ int llvm_symbolizer_main(int argc, char **argv, const llvm::ToolContext &) {
   Opts.UseSymbolTable = true;
   if (Args.hasArg(OPT_cache_size_EQ))
     parseIntArg(Args, OPT_cache_size_EQ, Opts.MaxCacheSize);
+  unsigned NumSymbolizers = 1;
+  if (Args.hasArg(OPT_listen_EQ) && Args.hasArg(OPT_num_threads_EQ)) {
+    parseIntArg(Args, OPT_num_threads_EQ, NumSymbolizers);
+    if (NumSymbolizers == 0)
+      NumSymbolizers = llvm::hardware_concurrency().compute_thread_count();
+    // The symbolizers share the cache budget.
+    Opts.MaxCacheSize /= NumSymbolizers;
+  }
   Config.PrintAddress = Args.hasArg(OPT_addresses);
   Config.PrintFunctions = Opts.PrintFunctions != FunctionNameKind::None;
   Config.Pretty = Args.hasArg(OPT_pretty_print);
@@ -556,13 +707,14 @@ int llvm_symbolizer_main(int argc, char **argv, const llvm::ToolContext &) {
   }
   object::BuildID BuildID = parseBuildIDArg(Args, OPT_build_id_EQ);
 
-  std::unique_ptr<DIPrinter> Printer;
-  if (Style == OutputStyle::GNU)
-    Printer = std::make_unique<GNUPrinter>(outs(), printError, Config);
-  else if (Style == OutputStyle::JSON)
-    Printer = std::make_unique<JSONPrinter>(outs(), Config);
-  else
-    Printer = std::make_unique<LLVMPrinter>(outs(), printError, Config);
+  auto MakePrinter = [&](raw_ostream &OS) -> std::unique_ptr<DIPrinter> {
+    if (Style == OutputStyle::GNU)
+      return std::make_unique<GNUPrinter>(OS, printError, Config);
+    if (Style == OutputStyle::JSON)
+      return std::make_unique<JSONPrinter>(OS, Config);
+    return std::make_unique<LLVMPrinter>(OS, printError, Config);
+  };
+  std::unique_ptr<DIPrinter> Printer = MakePrinter(outs());
 
   // When an input file is specified, exit immediately if the file cannot be
   // read. If getOrCreateModuleInfo succeeds, symbolizeInput will reuse the
@@ -578,6 +730,19 @@ int llvm_symbolizer_main(int argc, char **argv, const llvm::ToolContext &) {
     }
   }
 
+  if (const opt::Arg *A = Args.getLastArg(OPT_listen_EQ)) {
+    std::vector<std::unique_ptr<LLVMSymbolizer>> ExtraSymbolizers;
+    SmallVector<LLVMSymbolizer *> Symbolizers = {&Symbolizer};
+    for (unsigned I = 1; I < NumSymbolizers; ++I) {
+      ExtraSymbolizers.push_back(std::make_unique<LLVMSymbolizer>(Opts));
+      Symbolizers.push_back(ExtraSymbolizers.back().get());
+      if (Args.hasFlag(OPT_debuginfod, OPT_no_debuginfod, canUseDebuginfod()))
+        enableDebuginfod(*Symbolizers.back(), Args);
+    }
+    return serve(A->getValue(), Args, BuildID, AdjustVMA, IsAddr2Line, Style,
+                 Symbolizers, MakePrinter);
+  }
+
   std::vector<std::string> InputAddresses = Args.getAllArgValues(OPT_INPUT);
   if (InputAddresses.empty()) {
     const int kMaxInputStringLength = 1024;
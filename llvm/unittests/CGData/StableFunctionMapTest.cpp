@@ -82,6 +82,34 @@ TEST(StableFunctionMap, Merge) {
   EXPECT_EQ(Map1.size(StableFunctionMap::SizeType::MergeableFunctionCount), 5u);
 }
 
+TEST(StableFunctionMap, MergeMove) {
+  StableFunctionMap Map1;
+  StableFunction Func1{1, "Func1", "Mod1", 2, {{{0, 1}, 3}}};
+  StableFunction Func2{2, "Func2", "Mod1", 2, {{{1, 1}, 2}}};
+  Map1.insert(Func1);
+  Map1.insert(Func2);
+
+  StableFunctionMap Map2;
+  StableFunction Func3{1, "Func3", "Mod2", 2, {{{0, 1}, 4}}};
+  StableFunction Func4{3, "Func4", "Mod2", 2, {{{1, 1}, 6}}};
+  Map2.insert(Func3);
+  Map2.insert(Func4);
+
+  // Merge two maps, consuming the second one.
+  Map1.merge(std::move(Map2));
+
+  EXPECT_THAT(Map1, SizeIs(3));
+  EXPECT_EQ(Map1.size(StableFunctionMap::SizeType::TotalFunctionCount), 4u);
+  EXPECT_EQ(Map1.size(StableFunctionMap::SizeType::MergeableFunctionCount), 2u);
+
+  // The names of the moved entries refer to the names of the merged map.
+  auto &Funcs = Map1.getFunctionMap().at(3);
+  ASSERT_THAT(Funcs, SizeIs(1));
+  EXPECT_EQ(*Map1.getNameForId(Funcs[0]->FunctionNameId), "Func4");
+  EXPECT_EQ(*Map1.getNameForId(Funcs[0]->ModuleNameId), "Mod2");
+  EXPECT_EQ(Funcs[0]->IndexOperandHashMap->lookup({1, 1}), 6u);
+}
+
 TEST(StableFunctionMap, Finalize1) {
   StableFunctionMap Map;
   StableFunction Func1{1, "Func1", "Mod1", 2, {{{0, 1}, 3}}};
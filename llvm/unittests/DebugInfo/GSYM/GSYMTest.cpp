@@ -1278,6 +1278,25 @@ TEST(GSYMTest, TestGsymLookups) {
   ASSERT_THAT_EXPECTED(LR, Succeeded());
   EXPECT_THAT(LR->Locations,
     testing::ElementsAre(SourceLocation{"main", "/tmp", "main.c", 8, 32}));
+
+  // Batched lookups must match individual lookups, including for addresses
+  // that are not sorted or not in the GSYM.
+  const uint64_t Addrs[] = {0x0FFF, 0x1000, 0x100F, 0x1012, 0x1016,
+                            0x1014, 0x1020, 0x10FF, 0x1100};
+  std::vector<uint64_t> Visited;
+  GR->lookupBatch(Addrs, [&](uint64_t Addr, Expected<LookupResult> BatchLR) {
+    Visited.push_back(Addr);
+    auto SingleLR = GR->lookup(Addr);
+    if (!SingleLR) {
+      consumeError(SingleLR.takeError());
+      EXPECT_THAT_EXPECTED(BatchLR, Failed());
+      return;
+    }
+    ASSERT_THAT_EXPECTED(BatchLR, Succeeded());
+    EXPECT_EQ(SingleLR->FuncRange, BatchLR->FuncRange);
+    EXPECT_EQ(SingleLR->Locations, BatchLR->Locations);
+  });
+  EXPECT_THAT(Visited, testing::ElementsAreArray(Addrs));
 }
 
 
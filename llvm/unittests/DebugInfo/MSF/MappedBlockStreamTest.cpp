@@ -221,6 +221,36 @@ TEST(MappedBlockStreamTest, UnalignedOverlappingRead) {
   EXPECT_EQ(7U, F.Allocator.getBytesAllocated());
 }
 
+// Tests that a read which is contained in several previous cached requests
+// shares the allocation of one of them, even when other requests were cached
+// at offsets in between.
+TEST(MappedBlockStreamTest, OverlappingReadMultipleCachedRequests) {
+  DiscontiguousStream F(BlocksAry, DataAry);
+  auto S = MappedBlockStream::createStream(F.block_size(), F.layout(), F,
+                                           F.Allocator);
+  BinaryStreamReader R(*S);
+  StringRef Str1;
+  StringRef Str2;
+  StringRef Str3;
+  EXPECT_THAT_ERROR(R.readFixedString(Str1, 7), Succeeded());
+  EXPECT_EQ(Str1, StringRef("ABCDEFG"));
+  R.setOffset(4);
+  EXPECT_THAT_ERROR(R.readFixedString(Str2, 5), Succeeded());
+  EXPECT_EQ(Str2, StringRef("EFGHI"));
+  EXPECT_EQ(12U, F.Allocator.getBytesAllocated());
+
+  R.setOffset(5);
+  EXPECT_THAT_ERROR(R.readFixedString(Str3, 2), Succeeded());
+  EXPECT_EQ(Str3, StringRef("FG"));
+  EXPECT_EQ(Str2.data() + 1, Str3.data());
+
+  R.setOffset(1);
+  EXPECT_THAT_ERROR(R.readFixedString(Str3, 5), Succeeded());
+  EXPECT_EQ(Str3, StringRef("BCDEF"));
+  EXPECT_EQ(Str1.data() + 1, Str3.data());
+  EXPECT_EQ(12U, F.Allocator.getBytesAllocated());
+}
+
 // Tests that a read which is not aligned on the same boundary as a previous
 // cached request, but which only partially overlaps a previous cached request,
 // still works correctly and allocates again from the shared pool.
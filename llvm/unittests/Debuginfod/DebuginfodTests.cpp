@@ -67,3 +67,34 @@ TEST(DebuginfodClient, CacheMiss) {
   // A cache miss with no possible URLs should not create the cache directory.
   EXPECT_FALSE(sys::fs::exists(CacheDir));
 }
+
+// Check that batched fetches return a result per build ID, in order.
+TEST(DebuginfodClient, BatchCacheHitAndMiss) {
+  SmallString<32> CacheDir;
+  ASSERT_NO_ERROR(
+      sys::fs::createUniqueDirectory("debuginfod-unittest", CacheDir));
+  setenv("DEBUGINFOD_CACHE_PATH", CacheDir.c_str(), /*replace=*/1);
+  setenv("DEBUGINFOD_URLS", "", /*replace=*/1);
+  HTTPClient::initialize();
+
+  std::vector<object::BuildID> IDs = {{0x01, 0x23}, {0x45, 0x67}, {0x89}};
+  std::vector<std::string> CachedPaths;
+  for (size_t I = 0; I != 2; ++I) {
+    SmallString<64> Path(CacheDir);
+    sys::path::append(Path, "llvmcache-" + getDebuginfodCacheKey(
+                                               getDebuginfodDebuginfoUrlPath(
+                                                   IDs[I])));
+    std::error_code EC;
+    raw_fd_ostream OF(Path, EC);
+    ASSERT_NO_ERROR(EC);
+    OF << "contents\n";
+    CachedPaths.emplace_back(Path);
+  }
+
+  std::vector<Expected<std::string>> Results =
+      getCachedOrDownloadDebuginfos(IDs, /*MaxInFlight=*/2);
+  ASSERT_EQ(3u, Results.size());
+  EXPECT_THAT_EXPECTED(Results[0], HasValue(CachedPaths[0]));
+  EXPECT_THAT_EXPECTED(Results[1], HasValue(CachedPaths[1]));
+  EXPECT_THAT_EXPECTED(Results[2], Failed<StringError>());
+}
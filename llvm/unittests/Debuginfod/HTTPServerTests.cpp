@@ -301,6 +301,37 @@ TEST_F(HTTPClientServerTest, FirstPathMatched) {
   Server.stop();
 }
 
+// Check that an idle persistent connection releases the only request thread
+// once its keep-alive timeout expires, so that another client is served.
+TEST_F(HTTPClientServerTest, IdleConnectionTimeout) {
+  HTTPServer Server;
+  Server.setNumThreads(1);
+  Server.setKeepAlive(100, std::chrono::seconds(1));
+  EXPECT_THAT_ERROR(Server.get(UrlPathPattern, Handler), Succeeded());
+  Expected<unsigned> PortOrErr = Server.bind();
+  EXPECT_THAT_EXPECTED(PortOrErr, Succeeded());
+  unsigned Port = *PortOrErr;
+  DefaultThreadPool Pool(hardware_concurrency(1));
+  Pool.async([&]() { EXPECT_THAT_ERROR(Server.listen(), Succeeded()); });
+  std::string Url = "http://localhost:" + utostr(Port);
+
+  // The first client keeps its connection open after the response.
+  HTTPClient IdleClient;
+  HTTPRequest IdleRequest(Url);
+  StringHTTPResponseHandler IdleHandler;
+  EXPECT_THAT_ERROR(IdleClient.perform(IdleRequest, IdleHandler), Succeeded());
+  EXPECT_EQ(IdleHandler.ResponseBody, Response.Body);
+
+  HTTPClient Client;
+  Client.setTimeout(std::chrono::seconds(10));
+  HTTPRequest Request(Url);
+  StringHTTPResponseHandler Handler;
+  EXPECT_THAT_ERROR(Client.perform(Request, Handler), Succeeded());
+  EXPECT_EQ(Handler.ResponseBody, Response.Body);
+  EXPECT_EQ(Client.responseCode(), Response.Code);
+  Server.stop();
+}
+
 #endif
 
 #else
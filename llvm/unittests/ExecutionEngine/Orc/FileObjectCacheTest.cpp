@@ -0,0 +1,87 @@
+//===------ FileObjectCacheTest.cpp - Unit tests for FileObjectCache ------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/FileObjectCache.h"
+#include "OrcTestCommon.h"
+#include "llvm/ExecutionEngine/ExecutionEngine.h"
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Target/TargetMachine.h"
+#include "llvm/TargetParser/Host.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+using llvm::unittest::TempDir;
+
+namespace {
+
+class CountingFileObjectCache : public FileObjectCache {
+public:
+  using FileObjectCache::FileObjectCache;
+
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override {
+    auto Obj = FileObjectCache::getObject(M);
+    if (Obj)
+      ++Hits;
+    return Obj;
+  }
+
+  unsigned Hits = 0;
+};
+
+// Builds a module defining "int f(int x) { return x * 42; }".
+std::unique_ptr<Module> createModule(LLVMContext &Ctx, StringRef Name,
+                                     const TargetMachine &TM) {
+  auto M = std::make_unique<Module>(Name, Ctx);
+  M->setSourceFileName((Name + ".ll").str());
+  M->setTargetTriple(TM.getTargetTriple());
+  M->setDataLayout(TM.createDataLayout());
+  Type *I32Ty = Type::getInt32Ty(Ctx);
+  Function *F =
+      Function::Create(FunctionType::get(I32Ty, {I32Ty}, false),
+                       GlobalValue::ExternalLinkage, "f", M.get());
+  IRBuilder<> B(BasicBlock::Create(Ctx, "entry", F));
+  B.CreateRet(B.CreateMul(F->getArg(0), B.getInt32(42)));
+  return M;
+}
+
+TEST(FileObjectCacheTest, SimpleCompilerHits) {
+  OrcNativeTarget::initialize();
+  std::unique_ptr<TargetMachine> TM(EngineBuilder().selectTarget(
+      Triple(sys::getProcessTriple()), "", "", SmallVector<std::string, 1>()));
+  if (!TM)
+    GTEST_SKIP();
+
+  TempDir Dir("FileObjectCacheTest", /*Unique=*/true);
+  CountingFileObjectCache Cache(Dir.path("cache").str());
+  SimpleCompiler Compile(*TM, &Cache);
+
+  LLVMContext Ctx;
+  auto Obj = cantFail(Compile(*createModule(Ctx, "first", *TM)));
+  EXPECT_EQ(Cache.Hits, 0u);
+
+  // The same IR from another context, module identifier and source file hits
+  // the entry stored by the first compile.
+  LLVMContext Ctx2;
+  auto CachedObj = cantFail(Compile(*createModule(Ctx2, "second", *TM)));
+  EXPECT_EQ(Cache.Hits, 1u);
+  EXPECT_EQ(CachedObj->getBuffer(), Obj->getBuffer());
+
+  // A different key prefix misses.
+  CountingFileObjectCache OtherCache(Dir.path("cache").str(), "-mcpu=other");
+  SimpleCompiler OtherCompile(*TM, &OtherCache);
+  cantFail(OtherCompile(*createModule(Ctx, "third", *TM)));
+  EXPECT_EQ(OtherCache.Hits, 0u);
+}
+
+} // namespace
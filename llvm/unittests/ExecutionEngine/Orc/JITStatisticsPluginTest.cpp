@@ -0,0 +1,217 @@
+//===- JITStatisticsPluginTest.cpp - Unit tests for JITStatisticsPlugin ---===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/Debugging/JITStatisticsPlugin.h"
+#include "llvm/ExecutionEngine/JITLink/JITLink.h"
+#include "llvm/ExecutionEngine/JITLink/JITLinkMemoryManager.h"
+#include "llvm/ExecutionEngine/JITLink/x86_64.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::jitlink;
+using namespace llvm::orc;
+
+namespace {
+
+const char BlockContentBytes[] = {0x01, 0x02, 0x03, 0x04,
+                                  0x05, 0x06, 0x07, 0x08};
+
+ArrayRef<char> BlockContent(BlockContentBytes);
+
+// Returns an object file named after the module, or fails if asked to.
+class FakeCompiler : public IRCompileLayer::IRCompiler {
+public:
+  explicit FakeCompiler(bool Fail)
+      : IRCompiler(IRSymbolMapper::ManglingOptions()), Fail(Fail) {}
+
+  Expected<std::unique_ptr<MemoryBuffer>> operator()(Module &M) override {
+    if (Fail)
+      return make_error<StringError>("cannot compile",
+                                     inconvertibleErrorCode());
+    return MemoryBuffer::getMemBufferCopy("object", M.getModuleIdentifier());
+  }
+
+private:
+  bool Fail;
+};
+
+class JITStatisticsPluginTest : public testing::Test {
+public:
+  ~JITStatisticsPluginTest() {
+    if (auto Err = ES.endSession())
+      ES.reportError(std::move(Err));
+  }
+
+protected:
+  JITStatisticsPluginTest() { ObjLinkingLayer.addPlugin(Stats); }
+
+  // Adds a graph with the function _f and the data _x.
+  void addGraph() {
+    auto G = std::make_unique<LinkGraph>(
+        "foo", ES.getSymbolStringPool(), Triple("x86_64-apple-darwin"),
+        SubtargetFeatures(), x86_64::getEdgeKindName);
+
+    auto &TextSec = G->createSection("__text", MemProt::Read | MemProt::Exec);
+    auto &TextBlock = G->createContentBlock(TextSec, BlockContent,
+                                            ExecutorAddr(0x1000), 8, 0);
+    G->addDefinedSymbol(TextBlock, 0, "_f", 4, Linkage::Strong, Scope::Default,
+                        /*IsCallable=*/true, /*IsLive=*/false);
+
+    auto &DataSec = G->createSection("__data", MemProt::Read | MemProt::Write);
+    auto &DataBlock = G->createContentBlock(DataSec, BlockContent,
+                                            ExecutorAddr(0x2000), 8, 0);
+    G->addDefinedSymbol(DataBlock, 0, "_x", 8, Linkage::Strong, Scope::Default,
+                        /*IsCallable=*/false, /*IsLive=*/false);
+
+    EXPECT_THAT_ERROR(ObjLinkingLayer.add(JD, std::move(G)), Succeeded());
+  }
+
+  // Creates a module with the definitions f and g, which have one and two
+  // instructions, and the declaration h.
+  std::unique_ptr<Module> createModule() {
+    auto M = std::make_unique<Module>("M", Ctx);
+    auto *FTy = FunctionType::get(Type::getInt32Ty(Ctx), false);
+    IRBuilder<> Builder(Ctx);
+
+    auto *F = Function::Create(FTy, GlobalValue::ExternalLinkage, "f", *M);
+    Builder.SetInsertPoint(BasicBlock::Create(Ctx, "entry", F));
+    Builder.CreateRet(Builder.getInt32(0));
+
+    auto *H = Function::Create(FTy, GlobalValue::ExternalLinkage, "h", *M);
+    auto *G = Function::Create(FTy, GlobalValue::ExternalLinkage, "g", *M);
+    Builder.SetInsertPoint(BasicBlock::Create(Ctx, "entry", G));
+    Builder.CreateRet(Builder.CreateCall(H));
+    return M;
+  }
+
+  ExecutionSession ES{std::make_unique<UnsupportedExecutorProcessControl>()};
+  JITDylib &JD = ES.createBareJITDylib("main");
+  ObjectLinkingLayer ObjLinkingLayer{
+      ES, std::make_unique<InProcessMemoryManager>(4096)};
+  std::shared_ptr<JITStatisticsPlugin> Stats =
+      std::make_shared<JITStatisticsPlugin>();
+  LLVMContext Ctx;
+};
+
+TEST_F(JITStatisticsPluginTest, RecordsCompiles) {
+  auto Compiler = Stats->wrapCompiler(std::make_unique<FakeCompiler>(false));
+  auto M = createModule();
+  auto Obj = (*Compiler)(*M);
+  ASSERT_THAT_EXPECTED(Obj, Succeeded());
+  EXPECT_EQ((*Obj)->getBufferIdentifier(), "M");
+
+  auto Compiles = Stats->getCompileStats();
+  ASSERT_EQ(Compiles.size(), 1U);
+  EXPECT_EQ(Compiles[0].ModuleName, "M");
+  EXPECT_EQ(Compiles[0].NumFunctions, 2U);
+  EXPECT_EQ(Compiles[0].NumInstructions, 3U);
+}
+
+TEST_F(JITStatisticsPluginTest, IgnoresFailedCompiles) {
+  auto Compiler = Stats->wrapCompiler(std::make_unique<FakeCompiler>(true));
+  auto M = createModule();
+  EXPECT_THAT_EXPECTED((*Compiler)(*M), Failed());
+  EXPECT_TRUE(Stats->getCompileStats().empty());
+}
+
+TEST_F(JITStatisticsPluginTest, RecordsLinks) {
+  addGraph();
+  auto F = ES.lookup(&JD, "_f");
+  ASSERT_THAT_EXPECTED(F, Succeeded());
+
+  auto Links = Stats->getLinkStats();
+  ASSERT_EQ(Links.size(), 1U);
+  EXPECT_EQ(Links[0].GraphName, "foo");
+  EXPECT_EQ(Links[0].LinkedSize, 16U);
+  ASSERT_EQ(Links[0].Functions.size(), 1U);
+  EXPECT_EQ(Links[0].Functions[0].Name, "_f");
+  EXPECT_EQ(Links[0].Functions[0].Addr, F->getAddress());
+  EXPECT_EQ(Links[0].Functions[0].CodeSize, 4U);
+}
+
+TEST_F(JITStatisticsPluginTest, IgnoresFailedLinks) {
+  class FailingPlugin : public ObjectLinkingLayer::Plugin {
+  public:
+    void modifyPassConfig(MaterializationResponsibility &MR,
+                          jitlink::LinkGraph &G,
+                          jitlink::PassConfiguration &Config) override {
+      Config.PostAllocationPasses.push_back([](LinkGraph &G) {
+        return make_error<StringError>("Kaboom", inconvertibleErrorCode());
+      });
+    }
+
+    Error notifyFailed(MaterializationResponsibility &MR) override {
+      return Error::success();
+    }
+    Error notifyRemovingResources(JITDylib &JD, ResourceKey K) override {
+      return Error::success();
+    }
+    void notifyTransferringResources(JITDylib &JD, ResourceKey DstKey,
+                                     ResourceKey SrcKey) override {}
+  };
+
+  // We expect this test to generate errors. Consume them so that we don't
+  // add noise to the test logs.
+  ES.setErrorReporter(consumeError);
+
+  ObjLinkingLayer.addPlugin(std::make_unique<FailingPlugin>());
+  addGraph();
+  EXPECT_THAT_EXPECTED(ES.lookup(&JD, "_f"), Failed());
+  EXPECT_TRUE(Stats->getLinkStats().empty());
+}
+
+TEST_F(JITStatisticsPluginTest, PrintJSON) {
+  auto Compiler = Stats->wrapCompiler(std::make_unique<FakeCompiler>(false));
+  auto M = createModule();
+  ASSERT_THAT_EXPECTED((*Compiler)(*M), Succeeded());
+  addGraph();
+  ASSERT_THAT_EXPECTED(ES.lookup(&JD, "_f"), Succeeded());
+
+  std::string Out;
+  raw_string_ostream OS(Out);
+  Stats->printJSON(OS);
+  Expected<json::Value> Value = json::parse(Out);
+  ASSERT_THAT_EXPECTED(Value, Succeeded());
+  json::Object *Root = Value->getAsObject();
+  ASSERT_NE(Root, nullptr);
+
+  json::Array *Compiles = Root->getArray("compiles");
+  ASSERT_NE(Compiles, nullptr);
+  ASSERT_EQ(Compiles->size(), 1U);
+  json::Object *Compile = (*Compiles)[0].getAsObject();
+  ASSERT_NE(Compile, nullptr);
+  EXPECT_EQ(Compile->getString("module"), "M");
+  EXPECT_EQ(Compile->getInteger("functions"), 2);
+  EXPECT_EQ(Compile->getInteger("instructions"), 3);
+  EXPECT_TRUE(Compile->getInteger("compile_us").has_value());
+
+  json::Array *Links = Root->getArray("links");
+  ASSERT_NE(Links, nullptr);
+  ASSERT_EQ(Links->size(), 1U);
+  json::Object *Link = (*Links)[0].getAsObject();
+  ASSERT_NE(Link, nullptr);
+  EXPECT_EQ(Link->getString("graph"), "foo");
+  EXPECT_EQ(Link->getInteger("size"), 16);
+  EXPECT_TRUE(Link->getInteger("link_us").has_value());
+  json::Array *Functions = Link->getArray("functions");
+  ASSERT_NE(Functions, nullptr);
+  ASSERT_EQ(Functions->size(), 1U);
+  json::Object *Func = (*Functions)[0].getAsObject();
+  ASSERT_NE(Func, nullptr);
+  EXPECT_EQ(Func->getString("name"), "_f");
+  EXPECT_EQ(Func->getInteger("size"), 4);
+}
+
+} // namespace
@@ -0,0 +1,91 @@
+//===- SpeculateAnalysesTest.cpp - Unit tests for speculation queries -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/SpeculateAnalyses.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Testing/Support/Error.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+class RecordedOrderQueryTest : public testing::Test {
+protected:
+  // Uses the Mach-O mangling, whose global prefix is '_'.
+  RecordedOrderQueryTest() : M("M", Ctx), DL("m:o") {
+    M.setDataLayout(DL);
+    for (StringRef Name : {"a", "b", "c", "d", "e"})
+      Function::Create(FunctionType::get(Type::getVoidTy(Ctx), false),
+                       GlobalValue::ExternalLinkage, Name, M);
+  }
+
+  // Returns the functions to speculate on the first call of Name.
+  DenseSet<StringRef> speculate(RecordedOrderQuery &Query, StringRef Name) {
+    Function *F = M.getFunction(Name);
+    auto Result = Query(*F);
+    EXPECT_TRUE(Result.has_value());
+    // Every function is instrumented, even with nothing to speculate.
+    EXPECT_EQ(Result->size(), 1U);
+    auto It = Result->find(Name);
+    if (It == Result->end()) {
+      ADD_FAILURE() << Name << " is not instrumented";
+      return {};
+    }
+    return It->second;
+  }
+
+  LLVMContext Ctx;
+  Module M;
+  DataLayout DL;
+};
+
+TEST_F(RecordedOrderQueryTest, SpeculatesTheFollowingFunctions) {
+  RecordedOrderQuery Query({"_b", "_a", "_d", "_c"}, DL, /*Lookahead=*/2);
+
+  EXPECT_EQ(speculate(Query, "b"), (DenseSet<StringRef>{"a", "d"}));
+  EXPECT_EQ(speculate(Query, "a"), (DenseSet<StringRef>{"d", "c"}));
+  EXPECT_EQ(speculate(Query, "d"), (DenseSet<StringRef>{"c"}));
+  EXPECT_TRUE(speculate(Query, "c").empty());
+  // Not called in the recorded run.
+  EXPECT_TRUE(speculate(Query, "e").empty());
+}
+
+TEST_F(RecordedOrderQueryTest, KeepsTheFirstCall) {
+  RecordedOrderQuery Query({"_a", "_b", "_a", "_c", "_b", "_d"}, DL,
+                           /*Lookahead=*/2);
+
+  EXPECT_EQ(speculate(Query, "a"), (DenseSet<StringRef>{"b", "c"}));
+  EXPECT_EQ(speculate(Query, "b"), (DenseSet<StringRef>{"c", "d"}));
+}
+
+TEST_F(RecordedOrderQueryTest, ReadsTheOrderFromAFile) {
+  unittest::TempFile Order("speculation-order", "txt", "_c\n_a\r\n\n_e\n",
+                           /*Unique=*/true);
+  Expected<RecordedOrderQuery> Query =
+      RecordedOrderQuery::fromFile(Order.path(), DL, /*Lookahead=*/8);
+  ASSERT_THAT_EXPECTED(Query, Succeeded());
+
+  EXPECT_EQ(speculate(*Query, "c"), (DenseSet<StringRef>{"a", "e"}));
+  EXPECT_EQ(speculate(*Query, "a"), (DenseSet<StringRef>{"e"}));
+}
+
+TEST_F(RecordedOrderQueryTest, MissingFile) {
+  unittest::TempDir Dir("speculation-order", /*Unique=*/true);
+  SmallString<128> Path(Dir.path());
+  sys::path::append(Path, "missing.txt");
+  EXPECT_THAT_EXPECTED(RecordedOrderQuery::fromFile(Path, DL), Failed());
+}
+
+} // namespace
@@ -0,0 +1,50 @@
+//===- ConcurrentStringSaverTest.cpp --------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/ConcurrentStringSaver.h"
+#include "llvm/Support/Parallel.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+TEST(ConcurrentStringSaverTest, Unique) {
+  ConcurrentUniqueStringSaver Saver;
+  std::string Foo = "foo";
+  StringRef A = Saver.save(Foo);
+  StringRef B = Saver.save(StringRef("foo"));
+  StringRef C = Saver.save(Twine("f") + "oo");
+  EXPECT_EQ("foo", A);
+  EXPECT_NE(Foo.data(), A.data());
+  EXPECT_EQ(A.data(), B.data());
+  EXPECT_EQ(A.data(), C.data());
+  EXPECT_EQ('\0', *A.end());
+  EXPECT_EQ("", Saver.save(""));
+  EXPECT_EQ(2u, Saver.size());
+}
+
+TEST(ConcurrentStringSaverTest, Parallel) {
+  ConcurrentUniqueStringSaver Saver;
+  constexpr size_t N = 10000;
+  std::vector<StringRef> First(N), Second(N);
+  parallelFor(0, N, [&](size_t I) {
+    First[I] = Saver.save("str" + Twine(I % (N / 2)));
+  });
+  parallelFor(0, N, [&](size_t I) {
+    Second[I] = Saver.save("str" + Twine(I % (N / 2)));
+  });
+  EXPECT_EQ(N / 2, Saver.size());
+  for (size_t I = 0; I != N; ++I) {
+    EXPECT_EQ(("str" + Twine(I % (N / 2))).str(), First[I]);
+    EXPECT_EQ(First[I].data(), Second[I].data());
+    EXPECT_EQ(First[I % (N / 2)].data(), First[I].data());
+  }
+}
+
+} // namespace
@@ -36,6 +36,23 @@ TEST(Parallel, sort) {
   ASSERT_TRUE(llvm::is_sorted(array));
 }
 
+TEST(Parallel, StableSort) {
+  std::mt19937 randEngine;
+  std::uniform_int_distribution<uint32_t> dist(0, 1000);
+
+  // Use few distinct keys so that there are many equal elements, and tag each
+  // element with its original position to check stability.
+  std::vector<std::pair<uint32_t, size_t>> V(100000);
+  for (size_t I = 0; I != V.size(); ++I)
+    V[I] = {dist(randEngine), I};
+  auto Expected = V;
+  auto Less = [](const auto &A, const auto &B) { return A.first < B.first; };
+  std::stable_sort(Expected.begin(), Expected.end(), Less);
+
+  parallelStableSort(V, Less);
+  ASSERT_EQ(Expected, V);
+}
+
 TEST(Parallel, parallel_for) {
   // We need to test the case with a TaskSize > 1. We are white-box testing
   // here. The TaskSize is calculated as (End - Begin) / 1024 at the time of
@@ -120,6 +137,16 @@ TEST(Parallel, NestedTaskGroup) {
   });
 }
 
+TEST(Parallel, IsExecutorThread) {
+  EXPECT_FALSE(parallel::isExecutorThread());
+  std::atomic<bool> InExecutor{false};
+  {
+    parallel::TaskGroup tg;
+    tg.spawn([&]() { InExecutor = parallel::isExecutorThread(); });
+  }
+  EXPECT_EQ(InExecutor, parallel::strategy.ThreadsRequested != 1);
+}
+
 TEST(Parallel, ParallelNestedTaskGroup) {
   // This test checks that it is possible to have several TaskGroups
   // run from different threads in Parallel mode.
@@ -12,6 +12,7 @@
 #include "llvm/TargetParser/Triple.h"
 #include "gtest/gtest.h"
 #include <optional>
+#include <vector>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -43,6 +44,16 @@ TEST(ProcessTest, GetRandomNumberTest) {
 #define setenv(name, var, ignore) _putenv_s(name, var)
 #endif
 
+TEST(ProcessTest, GetPeakMemoryUsage) {
+  // The peak never decreases, even after memory is released.
+  size_t before = Process::GetPeakMemoryUsage();
+  {
+    std::vector<char> v(16 << 20, 1);
+    EXPECT_EQ(v.back(), 1);
+  }
+  EXPECT_GE(Process::GetPeakMemoryUsage(), before);
+}
+
 #if HAVE_SETENV || _MSC_VER
 TEST(ProcessTest, Basic) {
   setenv("__LLVM_TEST_ENVIRON_VAR__", "abc", true);
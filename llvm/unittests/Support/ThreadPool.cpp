@@ -285,6 +285,32 @@ TYPED_TEST(ThreadPoolTest, Groups) {
   ASSERT_EQ(1, checked_in2);
 }
 
+// Check that queued tasks of a high priority group run before other tasks.
+TYPED_TEST(ThreadPoolTest, HighPriorityGroups) {
+  CHECK_UNSUPPORTED();
+  DefaultThreadPool Pool(hardware_concurrency(1));
+  typename TestFixture::PhaseResetHelper Helper(this);
+  ThreadPoolTaskGroup Bulk(Pool);
+  ThreadPoolTaskGroup Urgent(Pool, /*HighPriority=*/true);
+
+  std::mutex Lock;
+  std::vector<int> Order;
+  auto Record = [&](int I) {
+    std::lock_guard<std::mutex> Guard(Lock);
+    Order.push_back(I);
+  };
+
+  // Keep the only thread busy until all tasks are queued.
+  Bulk.async([this] { this->waitForMainThread(); });
+  for (int I = 0; I < 3; ++I)
+    Bulk.async([&, I] { Record(I); });
+  for (int I = 3; I < 6; ++I)
+    Urgent.async([&, I] { Record(I); });
+  this->setMainThreadReady();
+  Pool.wait();
+  ASSERT_EQ((std::vector<int>{3, 4, 5, 0, 1, 2}), Order);
+}
+
 // Check recursive tasks.
 TYPED_TEST(ThreadPoolTest, RecursiveGroups) {
   CHECK_UNSUPPORTED();
@@ -96,4 +96,23 @@ TEST(TimeProfiler, Instant_Not_Added_Smoke) {
   ASSERT_TRUE(json.find(R"("detail":"instant detail")") == std::string::npos);
 }
 
+TEST(TimeProfiler, Summary_Only) {
+  timeTraceProfilerInitialize(/*TimeTraceGranularity=*/0, "test",
+                              /*TimeTraceVerbose=*/false,
+                              /*TimeTraceSummaryOnly=*/true);
+
+  bool DetailCalled = false;
+  {
+    TimeTraceScope scope("event", [&] {
+      DetailCalled = true;
+      return std::string("detail");
+    });
+  }
+
+  std::string json = teardownProfiler();
+  ASSERT_FALSE(DetailCalled);
+  ASSERT_TRUE(json.find(R"("name":"event")") == std::string::npos);
+  ASSERT_TRUE(json.find(R"("name":"Total event")") != std::string::npos);
+}
+
 } // namespace
@@ -8,6 +8,7 @@
 
 #include "llvm/Support/xxhash.h"
 #include "gtest/gtest.h"
+#include <vector>
 
 using namespace llvm;
 
@@ -82,6 +83,22 @@ TEST(xxhashTest, xxh3) {
 #undef F
 }
 
+TEST(xxhashTest, xxh3_64bits_records) {
+  constexpr size_t size = 1024;
+  uint8_t a[size];
+  for (size_t i = 0; i < size; ++i)
+    a[i] = uint8_t(i * 37 + 11);
+
+  for (size_t recordSize : {1, 3, 4, 8, 12, 16, 17, 64, 128, 129, 256}) {
+    size_t num = size / recordSize;
+    std::vector<uint64_t> out(num);
+    xxh3_64bits_records(ArrayRef(a, num * recordSize), recordSize, out);
+    for (size_t i = 0; i != num; ++i)
+      EXPECT_EQ(xxh3_64bits(ArrayRef(a + i * recordSize, recordSize)), out[i])
+          << "recordSize " << recordSize << ", record " << i;
+  }
+}
+
 TEST(xxhashTest, xxh3_128bits) {
 #define SANITY_BUFFER_SIZE 2367
   uint8_t sanityBuffer[SANITY_BUFFER_SIZE];
@@ -546,6 +546,51 @@ define void @foo(ptr noalias %ptr0, ptr noalias %ptr1, i8 %v0, i8 %v1) {
   EXPECT_TRUE(RetN->preds(DAG).empty());
 }
 
+TEST_F(DependencyGraphTest, AABudget) {
+  parseIR(C, R"IR(
+define void @foo(ptr noalias %p0, ptr noalias %p1, ptr noalias %p2, i8 %v) {
+  store i8 %v, ptr %p0
+  store i8 %v, ptr %p1
+  store i8 %v, ptr %p2
+  ret void
+}
+)IR");
+  llvm::Function *LLVMF = &*M->getFunction("foo");
+  sandboxir::Context Ctx(C);
+  auto *F = Ctx.createFunction(LLVMF);
+  auto *BB = &*F->begin();
+  sandboxir::DependencyGraph DAG(getAA(*LLVMF), Ctx);
+  // Only the first query reaches AA, the rest are assumed to alias.
+  DAG.setAABudget(1);
+  DAG.extend({&*BB->begin(), BB->getTerminator()});
+  auto It = BB->begin();
+  auto *Store0N = cast<sandboxir::MemDGNode>(
+      DAG.getNode(cast<sandboxir::StoreInst>(&*It++)));
+  auto *Store1N = cast<sandboxir::MemDGNode>(
+      DAG.getNode(cast<sandboxir::StoreInst>(&*It++)));
+  auto *Store2N = cast<sandboxir::MemDGNode>(
+      DAG.getNode(cast<sandboxir::StoreInst>(&*It++)));
+  EXPECT_TRUE(Store0N->memPreds().empty());
+  EXPECT_TRUE(Store1N->memPreds().empty());
+  EXPECT_THAT(Store2N->memPreds(),
+              testing::UnorderedElementsAre(Store0N, Store1N));
+
+  // Clearing the DAG gives it a new budget.
+  DAG.clear();
+  DAG.setAABudget(3);
+  DAG.extend({&*BB->begin(), BB->getTerminator()});
+  It = BB->begin();
+  Store0N = cast<sandboxir::MemDGNode>(
+      DAG.getNode(cast<sandboxir::StoreInst>(&*It++)));
+  Store1N = cast<sandboxir::MemDGNode>(
+      DAG.getNode(cast<sandboxir::StoreInst>(&*It++)));
+  Store2N = cast<sandboxir::MemDGNode>(
+      DAG.getNode(cast<sandboxir::StoreInst>(&*It++)));
+  EXPECT_TRUE(Store0N->memPreds().empty());
+  EXPECT_TRUE(Store1N->memPreds().empty());
+  EXPECT_TRUE(Store2N->memPreds().empty());
+}
+
 TEST_F(DependencyGraphTest, VolatileLoads) {
   parseIR(C, R"IR(
 define void @foo(ptr noalias %ptr0, ptr noalias %ptr1) {
@@ -14,6 +14,7 @@
 #define MLIR_EXECUTIONENGINE_EXECUTIONENGINE_H_
 
 #include "mlir/Support/LLVM.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/ExecutionEngine/Orc/LLJIT.h"
 #include "llvm/ExecutionEngine/SectionMemoryManager.h"
@@ -22,6 +23,7 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 
 namespace llvm {
@@ -37,9 +39,17 @@ namespace mlir {
 
 class Operation;
 
-/// A simple object cache following Lang's LLJITWithObjectCache example.
+/// A simple object cache following Lang's LLJITWithObjectCache example. When
+/// created with a cache directory, the objects are also stored in files of that
+/// directory, named after a hash of the module bitcode and of `targetKey`, and
+/// are loaded from there when an identical module is compiled again, possibly
+/// by another process.
 class SimpleObjectCache : public llvm::ObjectCache {
 public:
+  SimpleObjectCache() = default;
+  SimpleObjectCache(StringRef cacheDir, StringRef targetKey)
+      : cacheDir(cacheDir), targetKey(targetKey) {}
+
   void notifyObjectCompiled(const llvm::Module *m,
                             llvm::MemoryBufferRef objBuffer) override;
   std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *m) override;
@@ -51,7 +61,20 @@ public:
   bool isEmpty();
 
 private:
+  /// Returns the path of the file that holds the object of `m` in the cache
+  /// directory.
+  std::string getCachePath(const llvm::Module *m) const;
+
+  std::string cacheDir;
+  std::string targetKey;
+
+  /// Guards the members below, the modules may be compiled concurrently.
+  std::mutex mutex;
   llvm::StringMap<std::unique_ptr<llvm::MemoryBuffer>> cachedObjects;
+
+  /// Paths of the modules that missed the cache directory, by module, until
+  /// their object is compiled.
+  llvm::DenseMap<const llvm::Module *, std::string> pendingPaths;
 };
 
 struct ExecutionEngineOptions {
@@ -92,6 +115,18 @@ struct ExecutionEngineOptions {
   /// be dumped to a file via the `dumpToObjectFile` method.
   bool enableObjectDump = false;
 
+  /// If `objectCacheDir` is provided, the objects compiled by the engine are
+  /// stored in this directory, which is created if needed, and reused by the
+  /// engines that compile the same LLVM IR for the same target. The IR is
+  /// hashed after `transformer` ran, so only the code generation is saved.
+  StringRef objectCacheDir = {};
+
+  /// If `numCompileThreads` is greater than one, the LLVM module is split into
+  /// as many partitions, which are compiled concurrently when the engine is
+  /// created. This is ignored when `enableObjectDump` is set, since the dump
+  /// needs a single object.
+  unsigned numCompileThreads = 0;
+
   /// If enable `enableGDBNotificationListener` is set, the JIT compiler will
   /// notify the llvm's global GDB notification listener.
   bool enableGDBNotificationListener = true;
@@ -134,10 +134,14 @@ public:
   RefCounted(const RefCounted &) = delete;
   RefCounted &operator=(const RefCounted &) = delete;
 
-  void addRef(int64_t count = 1) { refCount.fetch_add(count); }
+  // A new reference can only be created from an existing one, so adding it
+  // does not need to synchronize with anything.
+  void addRef(int64_t count = 1) {
+    refCount.fetch_add(count, std::memory_order_relaxed);
+  }
 
   void dropRef(int64_t count = 1) {
-    int64_t previous = refCount.fetch_sub(count);
+    int64_t previous = refCount.fetch_sub(count, std::memory_order_acq_rel);
     assert(previous >= count && "reference count should not go below zero");
     if (previous == count)
       destroy();
@@ -222,6 +226,14 @@ struct AsyncGroup : public RefCounted {
   std::vector<std::function<void()>> awaiters;
 };
 
+// Runs the awaiters taken from a token, value or group that became available.
+// Awaiters added after that run immediately, so these run without holding the
+// lock of the object and other threads can keep awaiting it meanwhile.
+static void runAwaiters(std::vector<std::function<void()>> &awaiters) {
+  for (auto &awaiter : awaiters)
+    awaiter();
+}
+
 // Adds references to reference counted runtime object.
 extern "C" void mlirAsyncRuntimeAddRef(RefCountedObjPtr ptr, int64_t count) {
   RefCounted *refCounted = static_cast<RefCounted *>(ptr);
@@ -254,9 +266,6 @@ extern "C" AsyncGroup *mlirAsyncRuntimeCreateGroup(int64_t size) {
 
 extern "C" int64_t mlirAsyncRuntimeAddTokenToGroup(AsyncToken *token,
                                                    AsyncGroup *group) {
-  std::unique_lock<std::mutex> lockToken(token->mu);
-  std::unique_lock<std::mutex> lockGroup(group->mu);
-
   // Get the rank of the token inside the group before we drop the reference.
   int rank = group->rank.fetch_add(1);
 
@@ -269,30 +278,42 @@ extern "C" int64_t mlirAsyncRuntimeAddTokenToGroup(AsyncToken *token,
     // size were added to this group.
     assert(group->pendingTokens > 0 && "wrong group size");
 
-    // Run all group awaiters if it was the last token in the group.
-    if (group->pendingTokens.fetch_sub(1) == 1) {
+    // Only the last token of the group has to take the lock, to wake up the
+    // threads waiting for the group and to take the awaiters that were added
+    // before it.
+    if (group->pendingTokens.fetch_sub(1) != 1)
+      return;
+
+    std::vector<std::function<void()>> awaiters;
+    {
+      std::unique_lock<std::mutex> lockGroup(group->mu);
       group->cv.notify_all();
-      for (auto &awaiter : group->awaiters)
-        awaiter();
+      awaiters = std::move(group->awaiters);
     }
+    runAwaiters(awaiters);
   };
 
+  // The state of a token never changes once it is available, so the lock is
+  // only needed to add an awaiter to an unavailable token.
+  if (State(token->state).isAvailableOrError()) {
+    onTokenReady();
+    return rank;
+  }
+
+  std::unique_lock<std::mutex> lockToken(token->mu);
   if (State(token->state).isAvailableOrError()) {
     // Update group pending tokens immediately and maybe run awaiters.
+    lockToken.unlock();
     onTokenReady();
 
   } else {
     // Update group pending tokens when token will become ready. Because this
     // will happen asynchronously we must ensure that `group` is alive until
-    // then, and re-ackquire the lock.
+    // then.
     group->addRef();
 
     token->awaiters.emplace_back([group, onTokenReady]() {
-      // Make sure that `dropRef` does not destroy the mutex owned by the lock.
-      {
-        std::unique_lock<std::mutex> lockGroup(group->mu);
-        onTokenReady();
-      }
+      onTokenReady();
       group->dropRef();
     });
   }
@@ -306,14 +327,14 @@ static void setTokenState(AsyncToken *token, State state) {
   assert(state.isAvailableOrError() && "must be terminal state");
   assert(State(token->state).isUnavailable() && "token must be unavailable");
 
-  // Make sure that `dropRef` does not destroy the mutex owned by the lock.
+  std::vector<std::function<void()>> awaiters;
   {
     std::unique_lock<std::mutex> lock(token->mu);
     token->state = state;
     token->cv.notify_all();
-    for (auto &awaiter : token->awaiters)
-      awaiter();
+    awaiters = std::move(token->awaiters);
   }
+  runAwaiters(awaiters);
 
   // Async tokens created with a ref count `2` to keep token alive until the
   // async task completes. Drop this reference explicitly when token emplaced.
@@ -324,14 +345,14 @@ static void setValueState(AsyncValue *value, State state) {
   assert(state.isAvailableOrError() && "must be terminal state");
   assert(State(value->state).isUnavailable() && "value must be unavailable");
 
-  // Make sure that `dropRef` does not destroy the mutex owned by the lock.
+  std::vector<std::function<void()>> awaiters;
   {
     std::unique_lock<std::mutex> lock(value->mu);
     value->state = state;
     value->cv.notify_all();
-    for (auto &awaiter : value->awaiters)
-      awaiter();
+    awaiters = std::move(value->awaiters);
   }
+  runAwaiters(awaiters);
 
   // Async values created with a ref count `2` to keep value alive until the
   // async task completes. Drop this reference explicitly when value emplaced.
@@ -367,6 +388,8 @@ extern "C" bool mlirAsyncRuntimeIsGroupError(AsyncGroup *group) {
 }
 
 extern "C" void mlirAsyncRuntimeAwaitToken(AsyncToken *token) {
+  if (State(token->state).isAvailableOrError())
+    return;
   std::unique_lock<std::mutex> lock(token->mu);
   if (!State(token->state).isAvailableOrError())
     token->cv.wait(
@@ -374,6 +397,8 @@ extern "C" void mlirAsyncRuntimeAwaitToken(AsyncToken *token) {
 }
 
 extern "C" void mlirAsyncRuntimeAwaitValue(AsyncValue *value) {
+  if (State(value->state).isAvailableOrError())
+    return;
   std::unique_lock<std::mutex> lock(value->mu);
   if (!State(value->state).isAvailableOrError())
     value->cv.wait(
@@ -381,6 +406,8 @@ extern "C" void mlirAsyncRuntimeAwaitValue(AsyncValue *value) {
 }
 
 extern "C" void mlirAsyncRuntimeAwaitAllInGroup(AsyncGroup *group) {
+  if (group->pendingTokens == 0)
+    return;
   std::unique_lock<std::mutex> lock(group->mu);
   if (group->pendingTokens != 0)
     group->cv.wait(lock, [group] { return group->pendingTokens == 0; });
@@ -401,6 +428,8 @@ extern "C" void mlirAsyncRuntimeAwaitTokenAndExecute(AsyncToken *token,
                                                      CoroHandle handle,
                                                      CoroResume resume) {
   auto execute = [handle, resume]() { (*resume)(handle); };
+  if (State(token->state).isAvailableOrError())
+    return execute();
   std::unique_lock<std::mutex> lock(token->mu);
   if (State(token->state).isAvailableOrError()) {
     lock.unlock();
@@ -414,6 +443,8 @@ extern "C" void mlirAsyncRuntimeAwaitValueAndExecute(AsyncValue *value,
                                                      CoroHandle handle,
                                                      CoroResume resume) {
   auto execute = [handle, resume]() { (*resume)(handle); };
+  if (State(value->state).isAvailableOrError())
+    return execute();
   std::unique_lock<std::mutex> lock(value->mu);
   if (State(value->state).isAvailableOrError()) {
     lock.unlock();
@@ -427,6 +458,8 @@ extern "C" void mlirAsyncRuntimeAwaitAllInGroupAndExecute(AsyncGroup *group,
                                                           CoroHandle handle,
                                                           CoroResume resume) {
   auto execute = [handle, resume]() { (*resume)(handle); };
+  if (group->pendingTokens == 0)
+    return execute();
   std::unique_lock<std::mutex> lock(group->mu);
   if (group->pendingTokens == 0) {
     lock.unlock();
@@ -16,6 +16,9 @@
 #include "mlir/Support/FileUtilities.h"
 #include "mlir/Target/LLVMIR/Export.h"
 
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/ExecutionEngine/JITEventListener.h"
 #include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/ExecutionEngine/Orc/CompileUtils.h"
@@ -28,9 +31,13 @@
 #include "llvm/MC/TargetRegistry.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/TargetParser/Host.h"
 #include "llvm/TargetParser/SubtargetFeature.h"
+#include "llvm/Transforms/Utils/SplitModule.h"
 
 #define DEBUG_TYPE "execution-engine"
 
@@ -46,6 +53,7 @@ using llvm::Module;
 using llvm::SectionMemoryManager;
 using llvm::StringError;
 using llvm::Triple;
+using llvm::orc::ConcurrentIRCompiler;
 using llvm::orc::DynamicLibrarySearchGenerator;
 using llvm::orc::ExecutionSession;
 using llvm::orc::IRCompileLayer;
@@ -62,22 +70,76 @@ static Error makeStringError(const Twine &message) {
                                        llvm::inconvertibleErrorCode());
 }
 
+std::string SimpleObjectCache::getCachePath(const Module *m) const {
+  SmallString<0> bitcode;
+  llvm::raw_svector_ostream os(bitcode);
+  llvm::WriteBitcodeToFile(*m, os);
+
+  // The bitcode carries the triple and data layout, the target key the rest of
+  // the code generation options.
+  llvm::SHA1 hasher;
+  hasher.update(LLVM_VERSION_STRING);
+  hasher.update(targetKey);
+  hasher.update(bitcode);
+  SmallString<256> path(cacheDir);
+  llvm::sys::path::append(path, llvm::toHex(hasher.final(), true) + ".o");
+  return std::string(path);
+}
+
 void SimpleObjectCache::notifyObjectCompiled(const Module *m,
                                              MemoryBufferRef objBuffer) {
-  cachedObjects[m->getModuleIdentifier()] = MemoryBuffer::getMemBufferCopy(
-      objBuffer.getBuffer(), objBuffer.getBufferIdentifier());
+  std::string path;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    cachedObjects[m->getModuleIdentifier()] = MemoryBuffer::getMemBufferCopy(
+        objBuffer.getBuffer(), objBuffer.getBufferIdentifier());
+    auto it = pendingPaths.find(m);
+    if (it == pendingPaths.end())
+      return;
+    path = std::move(it->second);
+    pendingPaths.erase(it);
+  }
+
+  // The object is written to a temporary file that is renamed, so a concurrent
+  // reader never sees a partial object.
+  if (Error err = llvm::writeToOutput(path, [&](llvm::raw_ostream &os) {
+        os << objBuffer.getBuffer();
+        return Error::success();
+      }))
+    errs() << "could not store object of " << m->getModuleIdentifier()
+           << " in cache: " << toString(std::move(err)) << "\n";
 }
 
 std::unique_ptr<MemoryBuffer> SimpleObjectCache::getObject(const Module *m) {
-  auto i = cachedObjects.find(m->getModuleIdentifier());
-  if (i == cachedObjects.end()) {
-    LLVM_DEBUG(dbgs() << "No object for " << m->getModuleIdentifier()
-                      << " in cache. Compiling.\n");
-    return nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto i = cachedObjects.find(m->getModuleIdentifier());
+    if (i != cachedObjects.end()) {
+      LLVM_DEBUG(dbgs() << "Object for " << m->getModuleIdentifier()
+                        << " loaded from cache.\n");
+      return MemoryBuffer::getMemBuffer(i->second->getMemBufferRef());
+    }
   }
-  LLVM_DEBUG(dbgs() << "Object for " << m->getModuleIdentifier()
-                    << " loaded from cache.\n");
-  return MemoryBuffer::getMemBuffer(i->second->getMemBufferRef());
+
+  if (!cacheDir.empty()) {
+    // Hash the module outside of the lock, other modules may be compiling.
+    std::string path = getCachePath(m);
+    auto file = MemoryBuffer::getFile(path, /*IsText=*/false,
+                                      /*RequiresNullTerminator=*/false);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (file) {
+      LLVM_DEBUG(dbgs() << "Object for " << m->getModuleIdentifier()
+                        << " loaded from " << path << ".\n");
+      auto &cachedObject = cachedObjects[m->getModuleIdentifier()];
+      cachedObject = std::move(*file);
+      return MemoryBuffer::getMemBuffer(cachedObject->getMemBufferRef());
+    }
+    pendingPaths[m] = std::move(path);
+  }
+
+  LLVM_DEBUG(dbgs() << "No object for " << m->getModuleIdentifier()
+                    << " in cache. Compiling.\n");
+  return nullptr;
 }
 
 void SimpleObjectCache::dumpToObjectFile(StringRef outputFilename) {
@@ -96,7 +158,10 @@ void SimpleObjectCache::dumpToObjectFile(StringRef outputFilename) {
   file->keep();
 }
 
-bool SimpleObjectCache::isEmpty() { return cachedObjects.empty(); }
+bool SimpleObjectCache::isEmpty() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return cachedObjects.empty();
+}
 
 void ExecutionEngine::dumpToObjectFile(StringRef filename) {
   if (cache == nullptr) {
@@ -264,6 +329,11 @@ ExecutionEngine::create(Operation *m, const ExecutionEngineOptions &options,
     tm = std::move(tmOrError.get());
   }
 
+  // Both the single compiler and the concurrent one, as well as the object
+  // cache key, take their settings from `tm`.
+  if (options.jitCodeGenOptLevel)
+    tm->setOptLevel(*options.jitCodeGenOptLevel);
+
   // TODO: Currently, the LLVM module created above has no triple associated
   // with it. Instead, the triple is extracted from the TargetMachine, which is
   // either based on the host defaults or command line arguments when specified
@@ -274,6 +344,38 @@ ExecutionEngine::create(Operation *m, const ExecutionEngineOptions &options,
 
   auto dataLayout = llvmModule->getDataLayout();
 
+  // Also store the objects on disk, keyed by the options the bitcode of the
+  // module does not record.
+  if (!options.objectCacheDir.empty()) {
+    if (std::error_code ec =
+            llvm::sys::fs::create_directories(options.objectCacheDir))
+      return makeStringError("could not create object cache directory " +
+                             options.objectCacheDir + ": " + ec.message());
+    std::string targetKey;
+    llvm::raw_string_ostream os(targetKey);
+    os << tm->getTargetCPU() << ';' << tm->getTargetFeatureString() << ';'
+       << static_cast<int>(tm->getOptLevel()) << ';'
+       << static_cast<int>(tm->getRelocationModel()) << ';'
+       << static_cast<int>(tm->getCodeModel());
+    engine->cache = std::make_unique<SimpleObjectCache>(options.objectCacheDir,
+                                                        targetKey);
+  }
+
+  // The partitions are compiled concurrently, each with its own target
+  // machine configured like the given one.
+  unsigned numCompileThreads = 0;
+#if LLVM_ENABLE_THREADS
+  if (options.numCompileThreads > 1 && !options.enableObjectDump)
+    numCompileThreads = options.numCompileThreads;
+#endif
+  JITTargetMachineBuilder concurrentTMBuilder(tm->getTargetTriple());
+  concurrentTMBuilder.setCPU(tm->getTargetCPU().str())
+      .setFeatures(tm->getTargetFeatureString())
+      .setOptions(tm->Options)
+      .setRelocationModel(tm->getRelocationModel())
+      .setCodeModel(tm->getCodeModel())
+      .setCodeGenOptLevel(tm->getOptLevel());
+
   // Use absolute library path so that gdb can find the symbol table.
   SmallVector<SmallString<256>, 4> sharedLibPaths;
   transform(
@@ -359,10 +461,11 @@ ExecutionEngine::create(Operation *m, const ExecutionEngineOptions &options,
 
   // Callback to inspect the cache and recompile on demand. This follows Lang's
   // LLJITWithObjectCache example.
-  auto compileFunctionCreator = [&](JITTargetMachineBuilder jtmb)
+  auto compileFunctionCreator = [&](JITTargetMachineBuilder)
       -> Expected<std::unique_ptr<IRCompileLayer::IRCompiler>> {
-    if (options.jitCodeGenOptLevel)
-      jtmb.setCodeGenOptLevel(*options.jitCodeGenOptLevel);
+    if (numCompileThreads)
+      return std::make_unique<ConcurrentIRCompiler>(
+          std::move(concurrentTMBuilder), engine->cache.get());
     return std::make_unique<TMOwningSimpleCompiler>(std::move(tm),
                                                     engine->cache.get());
   };
@@ -373,14 +476,46 @@ ExecutionEngine::create(Operation *m, const ExecutionEngineOptions &options,
                    .setCompileFunctionCreator(compileFunctionCreator)
                    .setObjectLinkingLayerCreator(objectLinkingLayerCreator)
                    .setDataLayout(dataLayout)
+                   .setNumCompileThreads(numCompileThreads)
                    .create());
 
-  // Add a ThreadSafemodule to the engine and return.
-  ThreadSafeModule tsm(std::move(llvmModule), std::move(ctx));
   if (options.transformer)
-    cantFail(tsm.withModuleDo(
-        [&](llvm::Module &module) { return options.transformer(&module); }));
-  cantFail(jit->addIRModule(std::move(tsm)));
+    cantFail(options.transformer(llvmModule.get()));
+
+  // Add a ThreadSafemodule to the engine, or one for each partition of the
+  // module. The partitions are round-tripped through bitcode to give each its
+  // own context, which ORC locks while compiling the module.
+  SmallVector<llvm::orc::SymbolStringPtr> partitionSymbols;
+  if (numCompileThreads) {
+    SmallVector<SmallString<0>> partitions;
+    llvm::SplitModule(*llvmModule, numCompileThreads,
+                      [&](std::unique_ptr<Module> part) {
+                        llvm::raw_svector_ostream os(partitions.emplace_back());
+                        llvm::WriteBitcodeToFile(*part, os);
+                      });
+    for (auto [i, bitcode] : llvm::enumerate(partitions)) {
+      auto partCtx = std::make_unique<LLVMContext>();
+      std::string name =
+          (llvmModule->getModuleIdentifier() + "-" + Twine(i)).str();
+      auto part = llvm::parseBitcodeFile(MemoryBufferRef(bitcode, name),
+                                         *partCtx);
+      if (!part)
+        return part.takeError();
+      // Remember a symbol defined by the partition to compile it below.
+      for (llvm::GlobalValue &value : (*part)->global_values()) {
+        if (!value.isDeclaration() && !value.hasLocalLinkage() &&
+            !value.hasAvailableExternallyLinkage()) {
+          partitionSymbols.push_back(jit->mangleAndIntern(value.getName()));
+          break;
+        }
+      }
+      cantFail(jit->addIRModule(
+          ThreadSafeModule(std::move(*part), std::move(partCtx))));
+    }
+  } else {
+    ThreadSafeModule tsm(std::move(llvmModule), std::move(ctx));
+    cantFail(jit->addIRModule(std::move(tsm)));
+  }
   engine->jit = std::move(jit);
 
   // Resolve symbols that are statically linked in the current process.
@@ -400,6 +535,19 @@ ExecutionEngine::create(Operation *m, const ExecutionEngineOptions &options,
   };
   engine->registerSymbols(runtimeSymbolMap);
 
+  // Compile all partitions now, a single lookup materializes them in parallel.
+  if (!partitionSymbols.empty()) {
+    llvm::orc::SymbolLookupSet symbols;
+    for (llvm::orc::SymbolStringPtr &symbol : partitionSymbols)
+      symbols.add(std::move(symbol));
+    auto result = engine->jit->getExecutionSession().lookup(
+        llvm::orc::makeJITDylibSearchOrder(
+            &mainJD, llvm::orc::JITDylibLookupFlags::MatchAllSymbols),
+        std::move(symbols));
+    if (!result)
+      return result.takeError();
+  }
+
   // Execute the global constructors from the module being processed.
   // TODO: Allow JIT initialize for AArch64. Currently there's a bug causing a
   // crash for AArch64 see related issue #71963.
@@ -102,6 +102,17 @@ struct Options {
       "object-filename",
       llvm::cl::desc("Dump JITted-compiled object to file <input file>.o")};
 
+  llvm::cl::opt<std::string> objectCacheDir{
+      "object-cache-dir",
+      llvm::cl::desc("Reuse the objects compiled by previous runs from this "
+                     "directory")};
+
+  llvm::cl::opt<unsigned> compileThreads{
+      "compile-threads",
+      llvm::cl::desc("Split the module to compile it on this many threads, "
+                     "unless -dump-object-file is set"),
+      llvm::cl::init(0)};
+
   llvm::cl::opt<bool> hostSupportsJit{"host-supports-jit",
                                       llvm::cl::desc("Report host JIT support"),
                                       llvm::cl::Hidden};
@@ -194,7 +205,12 @@ compileAndExecute(Options &options, Operation *module, StringRef entryPoint,
     engineOptions.transformer = config.transformer;
   engineOptions.jitCodeGenOptLevel = jitCodeGenOptLevel;
   engineOptions.sharedLibPaths = sharedLibs;
-  engineOptions.enableObjectDump = true;
+  // The in-memory object cache only serves dumpToObjectFile, so it is only
+  // enabled when the object is dumped. It used to be always on, which would
+  // also prevent -compile-threads from splitting the module.
+  engineOptions.enableObjectDump = options.dumpObjectFile;
+  engineOptions.objectCacheDir = options.objectCacheDir;
+  engineOptions.numCompileThreads = options.compileThreads;
   auto expectedEngine =
       mlir::ExecutionEngine::create(module, engineOptions, std::move(tm));
   if (!expectedEngine)
@@ -18,6 +18,7 @@
 #include "mlir/Support/ToolUtilities.h"
 #include "mlir/Tools/lsp-server-support/Logging.h"
 #include "mlir/Tools/lsp-server-support/SourceMgrUtils.h"
+#include "llvm/ADT/PointerUnion.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/Base64.h"
 #include "llvm/Support/SourceMgr.h"
@@ -261,6 +262,49 @@ struct MLIRDocument {
   MLIRDocument(const MLIRDocument &) = delete;
   MLIRDocument &operator=(const MLIRDocument &) = delete;
 
+  /// Return the source contents of this document.
+  StringRef getContents() const;
+
+  //===--------------------------------------------------------------------===//
+  // Position Index
+  //===--------------------------------------------------------------------===//
+
+  /// An entry of the position index, i.e. a source range of a definition or a
+  /// use of an entity of `asmState`.
+  struct IndexEntry {
+    enum class Kind {
+      Operation,
+      Result,
+      SymbolUse,
+      Block,
+      BlockArgument,
+      AttributeAlias,
+      TypeAlias
+    };
+
+    /// The source range of the definition or use.
+    SMRange range;
+    /// The entity the range refers to.
+    Kind kind;
+    llvm::PointerUnion<const AsmParserState::OperationDefinition *,
+                       const AsmParserState::BlockDefinition *,
+                       const AsmParserState::AttributeAliasDefinition *,
+                       const AsmParserState::TypeAliasDefinition *>
+        def;
+    /// The result group or block argument number, when applicable.
+    unsigned subIndex;
+    /// The order in which the entities were searched before there was an
+    /// index, which breaks the ties between ranges sharing a boundary.
+    unsigned order;
+  };
+
+  /// Return the entry of the index containing the given location, or nullptr
+  /// if there is none. The index is built on the first query.
+  const IndexEntry *lookupPosition(SMLoc loc);
+
+  /// Build the position index from `asmState`.
+  void buildPositionIndex();
+
   //===--------------------------------------------------------------------===//
   // Definitions and References
   //===--------------------------------------------------------------------===//
@@ -342,6 +386,14 @@ struct MLIRDocument {
 
   /// The source manager containing the contents of the input file.
   llvm::SourceMgr sourceMgr;
+
+  /// The entries of `asmState` sorted by the start of their range, built
+  /// lazily as large documents may never be queried.
+  std::vector<IndexEntry> positionIndex;
+  bool positionIndexBuilt = false;
+
+  /// The length of the longest range of `positionIndex`.
+  size_t maxIndexRangeLength = 0;
 };
 } // namespace
 
@@ -371,57 +423,143 @@ MLIRDocument::MLIRDocument(MLIRContext &context, const lsp::URIForFile &uri,
   }
 }
 
+StringRef MLIRDocument::getContents() const {
+  if (sourceMgr.getNumBuffers() == 0)
+    return StringRef();
+  return sourceMgr.getMemoryBuffer(sourceMgr.getMainFileID())->getBuffer();
+}
+
 //===----------------------------------------------------------------------===//
-// MLIRDocument: Definitions and References
+// MLIRDocument: Position Index
 //===----------------------------------------------------------------------===//
 
-void MLIRDocument::getLocationsOf(const lsp::URIForFile &uri,
-                                  const lsp::Position &defPos,
-                                  std::vector<lsp::Location> &locations) {
-  SMLoc posLoc = defPos.getAsSMLoc(sourceMgr);
-
-  // Functor used to check if an SM definition contains the position.
-  auto containsPosition = [&](const AsmParserState::SMDefinition &def) {
-    if (!isDefOrUse(def, posLoc))
-      return false;
-    locations.emplace_back(uri, sourceMgr, def.loc);
-    return true;
+void MLIRDocument::buildPositionIndex() {
+  unsigned order = 0;
+  auto addEntry = [&](SMRange range, IndexEntry::Kind kind, auto *def,
+                      unsigned subIndex = 0) {
+    positionIndex.push_back({range, kind, def, subIndex, order});
+    maxIndexRangeLength =
+        std::max<size_t>(maxIndexRangeLength, range.End.getPointer() -
+                                                  range.Start.getPointer());
+  };
+  auto addSMDef = [&](const AsmParserState::SMDefinition &smDef,
+                      IndexEntry::Kind kind, auto *def, unsigned subIndex) {
+    addEntry(smDef.loc, kind, def, subIndex);
+    for (const SMRange &use : smDef.uses)
+      addEntry(use, kind, def, subIndex);
   };
 
-  // Check all definitions related to operations.
+  // Follow the order in which the queries check the entities.
   for (const AsmParserState::OperationDefinition &op : asmState.getOpDefs()) {
-    if (contains(op.loc, posLoc))
-      return collectLocationsFromLoc(op.op->getLoc(), locations, uri);
-    for (const auto &result : op.resultGroups)
-      if (containsPosition(result.definition))
-        return collectLocationsFromLoc(op.op->getLoc(), locations, uri);
-    for (const auto &symUse : op.symbolUses) {
-      if (contains(symUse, posLoc)) {
-        locations.emplace_back(uri, sourceMgr, op.loc);
-        return collectLocationsFromLoc(op.op->getLoc(), locations, uri);
-      }
+    addEntry(op.loc, IndexEntry::Kind::Operation, &op);
+    ++order;
+    for (const auto &result : llvm::enumerate(op.resultGroups)) {
+      addSMDef(result.value().definition, IndexEntry::Kind::Result, &op,
+               result.index());
+      ++order;
     }
+    for (const SMRange &use : op.symbolUses)
+      addEntry(use, IndexEntry::Kind::SymbolUse, &op);
+    ++order;
   }
-
-  // Check all definitions related to blocks.
   for (const AsmParserState::BlockDefinition &block : asmState.getBlockDefs()) {
-    if (containsPosition(block.definition))
-      return;
-    for (const AsmParserState::SMDefinition &arg : block.arguments)
-      if (containsPosition(arg))
-        return;
+    addSMDef(block.definition, IndexEntry::Kind::Block, &block, 0);
+    ++order;
+    for (const auto &arg : llvm::enumerate(block.arguments)) {
+      addSMDef(arg.value(), IndexEntry::Kind::BlockArgument, &block,
+               arg.index());
+      ++order;
+    }
   }
-
-  // Check all alias definitions.
   for (const AsmParserState::AttributeAliasDefinition &attr :
        asmState.getAttributeAliasDefs()) {
-    if (containsPosition(attr.definition))
-      return;
+    addSMDef(attr.definition, IndexEntry::Kind::AttributeAlias, &attr, 0);
+    ++order;
   }
   for (const AsmParserState::TypeAliasDefinition &type :
        asmState.getTypeAliasDefs()) {
-    if (containsPosition(type.definition))
-      return;
+    addSMDef(type.definition, IndexEntry::Kind::TypeAlias, &type, 0);
+    ++order;
+  }
+
+  llvm::sort(positionIndex, [](const IndexEntry &lhs, const IndexEntry &rhs) {
+    return lhs.range.Start.getPointer() < rhs.range.Start.getPointer();
+  });
+}
+
+const MLIRDocument::IndexEntry *MLIRDocument::lookupPosition(SMLoc loc) {
+  if (!positionIndexBuilt) {
+    buildPositionIndex();
+    positionIndexBuilt = true;
+  }
+
+  // Walk back from the last range starting at or before `loc`, up to the
+  // ranges that are too far to reach it.
+  const char *ptr = loc.getPointer();
+  auto it = llvm::upper_bound(positionIndex, ptr,
+                              [](const char *ptr, const IndexEntry &entry) {
+                                return ptr < entry.range.Start.getPointer();
+                              });
+  const IndexEntry *result = nullptr;
+  while (it != positionIndex.begin()) {
+    const IndexEntry &entry = *--it;
+    if (static_cast<size_t>(ptr - entry.range.Start.getPointer()) >
+        maxIndexRangeLength)
+      break;
+    if (contains(entry.range, loc) && (!result || entry.order < result->order))
+      result = &entry;
+  }
+  return result;
+}
+
+//===----------------------------------------------------------------------===//
+// MLIRDocument: Definitions and References
+//===----------------------------------------------------------------------===//
+
+void MLIRDocument::getLocationsOf(const lsp::URIForFile &uri,
+                                  const lsp::Position &defPos,
+                                  std::vector<lsp::Location> &locations) {
+  SMLoc posLoc = defPos.getAsSMLoc(sourceMgr);
+  const IndexEntry *entry = lookupPosition(posLoc);
+  if (!entry)
+    return;
+
+  using Kind = IndexEntry::Kind;
+  switch (entry->kind) {
+  case Kind::Operation:
+  case Kind::Result:
+  case Kind::SymbolUse: {
+    const auto *op =
+        cast<const AsmParserState::OperationDefinition *>(entry->def);
+    if (entry->kind == Kind::Result)
+      locations.emplace_back(uri, sourceMgr,
+                             op->resultGroups[entry->subIndex].definition.loc);
+    else if (entry->kind == Kind::SymbolUse)
+      locations.emplace_back(uri, sourceMgr, op->loc);
+    return collectLocationsFromLoc(op->op->getLoc(), locations, uri);
+  }
+  case Kind::Block:
+  case Kind::BlockArgument: {
+    const auto *block =
+        cast<const AsmParserState::BlockDefinition *>(entry->def);
+    const AsmParserState::SMDefinition &def =
+        entry->kind == Kind::Block ? block->definition
+                                   : block->arguments[entry->subIndex];
+    locations.emplace_back(uri, sourceMgr, def.loc);
+    return;
+  }
+  case Kind::AttributeAlias:
+    locations.emplace_back(
+        uri, sourceMgr,
+        cast<const AsmParserState::AttributeAliasDefinition *>(entry->def)
+            ->definition.loc);
+    return;
+  case Kind::TypeAlias:
+    locations.emplace_back(
+        uri, sourceMgr,
+        cast<const AsmParserState::TypeAliasDefinition *>(entry->def)
+            ->definition.loc);
+    return;
   }
 }
 
@@ -437,49 +575,48 @@ void MLIRDocument::findReferencesOf(const lsp::URIForFile &uri,
   };
 
   SMLoc posLoc = pos.getAsSMLoc(sourceMgr);
+  const IndexEntry *entry = lookupPosition(posLoc);
+  if (!entry)
+    return;
 
-  // Check all definitions related to operations.
-  for (const AsmParserState::OperationDefinition &op : asmState.getOpDefs()) {
-    if (contains(op.loc, posLoc)) {
-      for (const auto &result : op.resultGroups)
-        appendSMDef(result.definition);
-      for (const auto &symUse : op.symbolUses)
-        if (contains(symUse, posLoc))
-          references.emplace_back(uri, sourceMgr, symUse);
-      return;
-    }
-    for (const auto &result : op.resultGroups)
-      if (isDefOrUse(result.definition, posLoc))
-        return appendSMDef(result.definition);
-    for (const auto &symUse : op.symbolUses) {
-      if (!contains(symUse, posLoc))
-        continue;
-      for (const auto &symUse : op.symbolUses)
+  using Kind = IndexEntry::Kind;
+  switch (entry->kind) {
+  case Kind::Operation: {
+    const auto *op =
+        cast<const AsmParserState::OperationDefinition *>(entry->def);
+    for (const auto &result : op->resultGroups)
+      appendSMDef(result.definition);
+    for (const auto &symUse : op->symbolUses)
+      if (contains(symUse, posLoc))
         references.emplace_back(uri, sourceMgr, symUse);
-      return;
-    }
-  }
-
-  // Check all definitions related to blocks.
-  for (const AsmParserState::BlockDefinition &block : asmState.getBlockDefs()) {
-    if (isDefOrUse(block.definition, posLoc))
-      return appendSMDef(block.definition);
-
-    for (const AsmParserState::SMDefinition &arg : block.arguments)
-      if (isDefOrUse(arg, posLoc))
-        return appendSMDef(arg);
-  }
-
-  // Check all alias definitions.
-  for (const AsmParserState::AttributeAliasDefinition &attr :
-       asmState.getAttributeAliasDefs()) {
-    if (isDefOrUse(attr.definition, posLoc))
-      return appendSMDef(attr.definition);
+    return;
   }
-  for (const AsmParserState::TypeAliasDefinition &type :
-       asmState.getTypeAliasDefs()) {
-    if (isDefOrUse(type.definition, posLoc))
-      return appendSMDef(type.definition);
+  case Kind::Result:
+    return appendSMDef(
+        cast<const AsmParserState::OperationDefinition *>(entry->def)
+            ->resultGroups[entry->subIndex]
+            .definition);
+  case Kind::SymbolUse:
+    for (const auto &symUse :
+         cast<const AsmParserState::OperationDefinition *>(entry->def)
+             ->symbolUses)
+      references.emplace_back(uri, sourceMgr, symUse);
+    return;
+  case Kind::Block:
+    return appendSMDef(
+        cast<const AsmParserState::BlockDefinition *>(entry->def)->definition);
+  case Kind::BlockArgument:
+    return appendSMDef(
+        cast<const AsmParserState::BlockDefinition *>(entry->def)
+            ->arguments[entry->subIndex]);
+  case Kind::AttributeAlias:
+    return appendSMDef(
+        cast<const AsmParserState::AttributeAliasDefinition *>(entry->def)
+            ->definition);
+  case Kind::TypeAlias:
+    return appendSMDef(
+        cast<const AsmParserState::TypeAliasDefinition *>(entry->def)
+            ->definition);
   }
 }
 
@@ -491,60 +628,47 @@ std::optional<lsp::Hover>
 MLIRDocument::findHover(const lsp::URIForFile &uri,
                         const lsp::Position &hoverPos) {
   SMLoc posLoc = hoverPos.getAsSMLoc(sourceMgr);
-  SMRange hoverRange;
-
-  // Check for Hovers on operations and results.
-  for (const AsmParserState::OperationDefinition &op : asmState.getOpDefs()) {
-    // Check if the position points at this operation.
-    if (contains(op.loc, posLoc))
-      return buildHoverForOperation(op.loc, op);
-
-    // Check if the position points at the symbol name.
-    for (auto &use : op.symbolUses)
-      if (contains(use, posLoc))
-        return buildHoverForOperation(use, op);
-
-    // Check if the position points at a result group.
-    for (unsigned i = 0, e = op.resultGroups.size(); i < e; ++i) {
-      const auto &result = op.resultGroups[i];
-      if (!isDefOrUse(result.definition, posLoc, &hoverRange))
-        continue;
-
-      // Get the range of results covered by the over position.
-      unsigned resultStart = result.startIndex;
-      unsigned resultEnd = (i == e - 1) ? op.op->getNumResults()
-                                        : op.resultGroups[i + 1].startIndex;
-      return buildHoverForOperationResult(hoverRange, op.op, resultStart,
-                                          resultEnd, posLoc);
-    }
-  }
-
-  // Check to see if the hover is over a block argument.
-  for (const AsmParserState::BlockDefinition &block : asmState.getBlockDefs()) {
-    if (isDefOrUse(block.definition, posLoc, &hoverRange))
-      return buildHoverForBlock(hoverRange, block);
-
-    for (const auto &arg : llvm::enumerate(block.arguments)) {
-      if (!isDefOrUse(arg.value(), posLoc, &hoverRange))
-        continue;
+  const IndexEntry *entry = lookupPosition(posLoc);
+  if (!entry)
+    return std::nullopt;
 
-      return buildHoverForBlockArgument(
-          hoverRange, block.block->getArgument(arg.index()), block);
-    }
+  using Kind = IndexEntry::Kind;
+  switch (entry->kind) {
+  case Kind::Operation:
+  case Kind::SymbolUse:
+    return buildHoverForOperation(
+        entry->range,
+        *cast<const AsmParserState::OperationDefinition *>(entry->def));
+  case Kind::Result: {
+    // Get the range of results covered by the over position.
+    const auto *op =
+        cast<const AsmParserState::OperationDefinition *>(entry->def);
+    unsigned i = entry->subIndex, e = op->resultGroups.size();
+    unsigned resultStart = op->resultGroups[i].startIndex;
+    unsigned resultEnd = (i == e - 1) ? op->op->getNumResults()
+                                      : op->resultGroups[i + 1].startIndex;
+    return buildHoverForOperationResult(entry->range, op->op, resultStart,
+                                        resultEnd, posLoc);
   }
-
-  // Check to see if the hover is over an alias.
-  for (const AsmParserState::AttributeAliasDefinition &attr :
-       asmState.getAttributeAliasDefs()) {
-    if (isDefOrUse(attr.definition, posLoc, &hoverRange))
-      return buildHoverForAttributeAlias(hoverRange, attr);
+  case Kind::Block:
+    return buildHoverForBlock(
+        entry->range,
+        *cast<const AsmParserState::BlockDefinition *>(entry->def));
+  case Kind::BlockArgument: {
+    const auto *block =
+        cast<const AsmParserState::BlockDefinition *>(entry->def);
+    return buildHoverForBlockArgument(
+        entry->range, block->block->getArgument(entry->subIndex), *block);
   }
-  for (const AsmParserState::TypeAliasDefinition &type :
-       asmState.getTypeAliasDefs()) {
-    if (isDefOrUse(type.definition, posLoc, &hoverRange))
-      return buildHoverForTypeAlias(hoverRange, type);
+  case Kind::AttributeAlias:
+    return buildHoverForAttributeAlias(
+        entry->range,
+        *cast<const AsmParserState::AttributeAliasDefinition *>(entry->def));
+  case Kind::TypeAlias:
+    return buildHoverForTypeAlias(
+        entry->range,
+        *cast<const AsmParserState::TypeAliasDefinition *>(entry->def));
   }
-
   return std::nullopt;
 }
 
@@ -967,10 +1091,27 @@ namespace {
 /// This class represents a single chunk of an MLIR text file.
 struct MLIRTextFileChunk {
   MLIRTextFileChunk(MLIRContext &context, uint64_t lineOffset,
-                    const lsp::URIForFile &uri, StringRef contents,
-                    std::vector<lsp::Diagnostic> &diagnostics)
+                    const lsp::URIForFile &uri, StringRef contents)
       : lineOffset(lineOffset), document(context, uri, contents, diagnostics) {}
 
+  /// Append the diagnostics of this chunk to `fileDiagnostics`, anchored at
+  /// the beginning of the file.
+  void appendDiagnostics(const lsp::URIForFile &uri,
+                         std::vector<lsp::Diagnostic> &fileDiagnostics) {
+    for (const lsp::Diagnostic &diag : diagnostics) {
+      lsp::Diagnostic &fileDiag = fileDiagnostics.emplace_back(diag);
+      if (lineOffset == 0)
+        continue;
+      adjustLocForChunkOffset(fileDiag.range);
+
+      if (!fileDiag.relatedInformation)
+        continue;
+      for (auto &it : *fileDiag.relatedInformation)
+        if (it.location.uri == uri)
+          adjustLocForChunkOffset(it.location.range);
+    }
+  }
+
   /// Adjust the line number of the given range to anchor at the beginning of
   /// the file, instead of the beginning of this chunk.
   void adjustLocForChunkOffset(lsp::Range &range) {
@@ -983,6 +1124,10 @@ struct MLIRTextFileChunk {
 
   /// The line offset of this chunk from the beginning of the file.
   uint64_t lineOffset;
+  /// The diagnostics emitted when parsing this chunk, anchored at the
+  /// beginning of the chunk. They are kept to be published again when the
+  /// chunk is reused by an update of the file.
+  std::vector<lsp::Diagnostic> diagnostics;
   /// The document referred to by this chunk.
   MLIRDocument document;
 };
@@ -1003,6 +1148,12 @@ public:
   /// Return the current version of this text file.
   int64_t getVersion() const { return version; }
 
+  /// Update the file to the new version using the provided set of content
+  /// changes. Returns failure if the update was unsuccessful.
+  LogicalResult update(const lsp::URIForFile &uri, int64_t newVersion,
+                       ArrayRef<lsp::TextDocumentContentChangeEvent> changes,
+                       std::vector<lsp::Diagnostic> &diagnostics);
+
   //===--------------------------------------------------------------------===//
   // LSP Queries
   //===--------------------------------------------------------------------===//
@@ -1022,6 +1173,12 @@ public:
   llvm::Expected<lsp::MLIRConvertBytecodeResult> convertToBytecode();
 
 private:
+  /// Split the file contents into chunks, reusing the chunks of `oldChunks`
+  /// whose contents did not change, and parse the others.
+  void initialize(const lsp::URIForFile &uri,
+                  std::vector<std::unique_ptr<MLIRTextFileChunk>> oldChunks,
+                  std::vector<lsp::Diagnostic> &diagnostics);
+
   /// Find the MLIR document that contains the given position, and update the
   /// position to be anchored at the start of the found chunk instead of the
   /// beginning of the file.
@@ -1051,32 +1208,65 @@ MLIRTextFile::MLIRTextFile(const lsp::URIForFile &uri, StringRef fileContents,
     : context(registry, MLIRContext::Threading::DISABLED),
       contents(fileContents.str()), version(version) {
   context.allowUnregisteredDialects();
+  initialize(uri, /*oldChunks=*/{}, diagnostics);
+}
+
+LogicalResult
+MLIRTextFile::update(const lsp::URIForFile &uri, int64_t newVersion,
+                     ArrayRef<lsp::TextDocumentContentChangeEvent> changes,
+                     std::vector<lsp::Diagnostic> &diagnostics) {
+  if (failed(lsp::TextDocumentContentChangeEvent::applyTo(changes, contents))) {
+    lsp::Logger::error("Failed to update contents of {0}", uri.file());
+    return failure();
+  }
+
+  // If the file contents were properly changed, reinitialize the text file.
+  version = newVersion;
+  initialize(uri, std::move(chunks), diagnostics);
+  return success();
+}
 
+void MLIRTextFile::initialize(
+    const lsp::URIForFile &uri,
+    std::vector<std::unique_ptr<MLIRTextFileChunk>> oldChunks,
+    std::vector<lsp::Diagnostic> &diagnostics) {
   // Split the file into separate MLIR documents.
   SmallVector<StringRef, 8> subContents;
   StringRef(contents).split(subContents, kDefaultSplitMarker);
-  chunks.emplace_back(std::make_unique<MLIRTextFileChunk>(
-      context, /*lineOffset=*/0, uri, subContents.front(), diagnostics));
-
-  uint64_t lineOffset = subContents.front().count('\n');
-  for (StringRef docContents : llvm::drop_begin(subContents)) {
-    unsigned currentNumDiags = diagnostics.size();
-    auto chunk = std::make_unique<MLIRTextFileChunk>(context, lineOffset, uri,
-                                                     docContents, diagnostics);
+
+  // An edit generally only touches a few documents of a large file: reuse the
+  // leading and trailing documents that are unchanged, which keeps their IR
+  // and diagnostics, and only parse the ones in between.
+  size_t numPrefix = 0, numSuffix = 0;
+  while (numPrefix < oldChunks.size() && numPrefix < subContents.size() &&
+         oldChunks[numPrefix]->document.getContents() ==
+             subContents[numPrefix])
+    ++numPrefix;
+  while (numSuffix < oldChunks.size() - numPrefix &&
+         numSuffix < subContents.size() - numPrefix &&
+         oldChunks[oldChunks.size() - numSuffix - 1]->document.getContents() ==
+             subContents[subContents.size() - numSuffix - 1])
+    ++numSuffix;
+
+  chunks.clear();
+  chunks.reserve(subContents.size());
+  uint64_t lineOffset = 0;
+  for (auto [i, docContents] : llvm::enumerate(subContents)) {
+    std::unique_ptr<MLIRTextFileChunk> chunk;
+    if (i < numPrefix) {
+      chunk = std::move(oldChunks[i]);
+    } else if (size_t fromEnd = subContents.size() - i; fromEnd <= numSuffix) {
+      chunk = std::move(oldChunks[oldChunks.size() - fromEnd]);
+    } else {
+      chunk = std::make_unique<MLIRTextFileChunk>(context, lineOffset, uri,
+                                                  docContents);
+    }
+    chunk->lineOffset = lineOffset;
     lineOffset += docContents.count('\n');
 
     // Adjust locations used in diagnostics to account for the offset from the
     // beginning of the file.
-    for (lsp::Diagnostic &diag :
-         llvm::drop_begin(diagnostics, currentNumDiags)) {
-      chunk->adjustLocForChunkOffset(diag.range);
-
-      if (!diag.relatedInformation)
-        continue;
-      for (auto &it : *diag.relatedInformation)
-        if (it.location.uri == uri)
-          chunk->adjustLocForChunkOffset(it.location.range);
-    }
+    chunk->appendDiagnostics(uri, diagnostics);
     chunks.emplace_back(std::move(chunk));
   }
   totalNumLines = lineOffset;
@@ -1281,13 +1471,27 @@ lsp::MLIRServer::MLIRServer(DialectRegistry &registry)
     : impl(std::make_unique<Impl>(registry)) {}
 lsp::MLIRServer::~MLIRServer() = default;
 
-void lsp::MLIRServer::addOrUpdateDocument(
-    const URIForFile &uri, StringRef contents, int64_t version,
-    std::vector<Diagnostic> &diagnostics) {
+void lsp::MLIRServer::addDocument(const URIForFile &uri, StringRef contents,
+                                  int64_t version,
+                                  std::vector<Diagnostic> &diagnostics) {
   impl->files[uri.file()] = std::make_unique<MLIRTextFile>(
       uri, contents, version, impl->registry, diagnostics);
 }
 
+void lsp::MLIRServer::updateDocument(
+    const URIForFile &uri, ArrayRef<TextDocumentContentChangeEvent> changes,
+    int64_t version, std::vector<Diagnostic> &diagnostics) {
+  // Check that we actually have a document for this uri.
+  auto it = impl->files.find(uri.file());
+  if (it == impl->files.end())
+    return;
+
+  // Try to update the document. If we fail, erase the file from the server. A
+  // failed updated generally means we've fallen out of sync somewhere.
+  if (failed(it->second->update(uri, version, changes, diagnostics)))
+    impl->files.erase(it);
+}
+
 std::optional<int64_t> lsp::MLIRServer::removeDocument(const URIForFile &uri) {
   auto it = impl->files.find(uri.file());
   if (it == impl->files.end())
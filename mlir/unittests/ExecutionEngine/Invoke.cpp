@@ -25,6 +25,8 @@
 #include "mlir/Target/LLVMIR/Dialect/Builtin/BuiltinToLLVMIRTranslation.h"
 #include "mlir/Target/LLVMIR/Dialect/LLVMIR/LLVMToLLVMIRTranslation.h"
 #include "mlir/Target/LLVMIR/Export.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -316,4 +318,122 @@ TEST(NativeMemRefJit, MAYBE_JITCallback) {
     ASSERT_EQ(elt, coefficient * count++);
 }
 
+TEST(MLIRExecutionEngine, SKIP_WITHOUT_JIT(ObjectCacheDir)) {
+  std::string moduleStr = R"mlir(
+  func.func @foo(%arg0 : i64) -> i64 attributes { llvm.emit_c_interface } {
+    %res = arith.addi %arg0, %arg0 : i64
+    return %res : i64
+  }
+  )mlir";
+  DialectRegistry registry;
+  registerAllDialects(registry);
+  registerBuiltinDialectTranslation(registry);
+  registerLLVMDialectTranslation(registry);
+  MLIRContext context(registry);
+  OwningOpRef<ModuleOp> module =
+      parseSourceString<ModuleOp>(moduleStr, &context);
+  ASSERT_TRUE(!!module);
+  ASSERT_TRUE(succeeded(lowerToLLVMDialect(*module)));
+
+  SmallString<128> cacheDir;
+  ASSERT_FALSE(
+      llvm::sys::fs::createUniqueDirectory("mlir-object-cache", cacheDir));
+  ExecutionEngineOptions options;
+  options.objectCacheDir = cacheDir;
+
+  // Returns the objects in the cache directory.
+  auto listCache = [&] {
+    std::vector<std::string> paths;
+    std::error_code ec;
+    for (llvm::sys::fs::directory_iterator it(cacheDir, ec), end;
+         !ec && it != end; it.increment(ec))
+      paths.push_back(it->path());
+    return paths;
+  };
+
+  auto runFoo = [&] {
+    auto jitOrError = ExecutionEngine::create(*module, options);
+    ASSERT_TRUE(!!jitOrError);
+    int64_t result = 0;
+    llvm::Error error = (*jitOrError)
+                            ->invoke("foo", int64_t(21),
+                                     ExecutionEngine::Result<int64_t>(result));
+    ASSERT_TRUE(!error);
+    ASSERT_EQ(result, 42);
+  };
+
+  // The first engine compiles the module and stores its object.
+  runFoo();
+  std::vector<std::string> objects = listCache();
+  ASSERT_EQ(objects.size(), 1u);
+  ASSERT_TRUE(StringRef(objects[0]).ends_with(".o"));
+
+  // Backdate the object. A second engine that compiled the module again would
+  // replace it with a new file.
+  llvm::sys::TimePoint<> past = std::chrono::system_clock::from_time_t(86400);
+  int fd;
+  ASSERT_FALSE(llvm::sys::fs::openFileForReadWrite(
+      objects[0], fd, llvm::sys::fs::CD_OpenExisting, llvm::sys::fs::OF_None));
+  ASSERT_FALSE(llvm::sys::fs::setLastAccessAndModificationTime(fd, past));
+  llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+
+  runFoo();
+  EXPECT_EQ(listCache(), objects);
+  llvm::sys::fs::file_status status;
+  ASSERT_FALSE(llvm::sys::fs::status(objects[0], status));
+  EXPECT_EQ(status.getLastModificationTime(), past);
+
+  llvm::sys::fs::remove_directories(cacheDir);
+}
+
+TEST(MLIRExecutionEngine, SKIP_WITHOUT_JIT(CompileThreads)) {
+  std::string moduleStr = R"mlir(
+  func.func @add1(%arg0 : i64) -> i64 attributes { llvm.emit_c_interface } {
+    %c = arith.constant 1 : i64
+    %res = arith.addi %arg0, %c : i64
+    return %res : i64
+  }
+  func.func @add2(%arg0 : i64) -> i64 attributes { llvm.emit_c_interface } {
+    %c = arith.constant 2 : i64
+    %res = arith.addi %arg0, %c : i64
+    return %res : i64
+  }
+  func.func @add3(%arg0 : i64) -> i64 attributes { llvm.emit_c_interface } {
+    %res = call @add2(%arg0) : (i64) -> i64
+    %next = call @add1(%res) : (i64) -> i64
+    return %next : i64
+  }
+  func.func @add4(%arg0 : i64) -> i64 attributes { llvm.emit_c_interface } {
+    %res = call @add2(%arg0) : (i64) -> i64
+    %next = call @add2(%res) : (i64) -> i64
+    return %next : i64
+  }
+  )mlir";
+  DialectRegistry registry;
+  registerAllDialects(registry);
+  registerBuiltinDialectTranslation(registry);
+  registerLLVMDialectTranslation(registry);
+  MLIRContext context(registry);
+  OwningOpRef<ModuleOp> module =
+      parseSourceString<ModuleOp>(moduleStr, &context);
+  ASSERT_TRUE(!!module);
+  ASSERT_TRUE(succeeded(lowerToLLVMDialect(*module)));
+
+  // The partitions call each other's functions.
+  ExecutionEngineOptions options;
+  options.numCompileThreads = 4;
+  options.jitCodeGenOptLevel = llvm::CodeGenOptLevel::None;
+  auto jitOrError = ExecutionEngine::create(*module, options);
+  ASSERT_TRUE(!!jitOrError);
+  std::unique_ptr<ExecutionEngine> jit = std::move(jitOrError.get());
+  for (int64_t i = 1; i <= 4; ++i) {
+    int64_t result = 0;
+    llvm::Error error =
+        jit->invoke(("add" + Twine(i)).str(), int64_t(40),
+                    ExecutionEngine::Result<int64_t>(result));
+    ASSERT_TRUE(!error);
+    ASSERT_EQ(result, 40 + i);
+  }
+}
+
 #endif // _WIN32
@@ -0,0 +1,87 @@
+//===- SparseTensorCOO.cpp --------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/ExecutionEngine/SparseTensor/COO.h"
+
+#include "gmock/gmock.h"
+
+#include <random>
+
+using namespace ::mlir::sparse_tensor;
+using namespace ::testing;
+
+namespace {
+using Coords = std::vector<uint64_t>;
+
+/// Adds `nse` random elements, with many duplicate coordinates, to `coo` and
+/// returns the (coordinates, value) pairs that were added.
+std::vector<std::pair<Coords, double>> addRandom(SparseTensorCOO<double> &coo,
+                                                 uint64_t nse,
+                                                 uint64_t maxCoord) {
+  std::mt19937_64 rng(42);
+  std::vector<std::pair<Coords, double>> added;
+  for (uint64_t i = 0; i < nse; ++i) {
+    Coords coords;
+    for (uint64_t d = 0, rank = coo.getRank(); d < rank; ++d)
+      coords.push_back(rng() % std::min(maxCoord, coo.getDimSizes()[d]));
+    coo.add(coords, static_cast<double>(i));
+    added.emplace_back(std::move(coords), static_cast<double>(i));
+  }
+  return added;
+}
+
+/// Checks that the elements of `coo` are sorted by coordinates and are a
+/// permutation of `added`.
+void expectSortedPermutation(const SparseTensorCOO<double> &coo,
+                             std::vector<std::pair<Coords, double>> added) {
+  const uint64_t rank = coo.getRank();
+  std::vector<std::pair<Coords, double>> sorted;
+  for (const Element<double> &e : coo.getElements())
+    sorted.emplace_back(Coords(e.coords, e.coords + rank), e.value);
+  ASSERT_EQ(sorted.size(), added.size());
+  for (size_t i = 1; i < sorted.size(); ++i)
+    ASSERT_LE(sorted[i - 1].first, sorted[i].first) << "at element " << i;
+
+  // The order of the values of duplicate coordinates is unspecified.
+  std::sort(sorted.begin(), sorted.end());
+  std::sort(added.begin(), added.end());
+  EXPECT_EQ(sorted, added);
+}
+} // namespace
+
+TEST(SparseTensorCOO, SortSmall) {
+  SparseTensorCOO<double> coo({10, 20});
+  auto added = addRandom(coo, 100, 5);
+  coo.sort();
+  expectSortedPermutation(coo, std::move(added));
+}
+
+// Large enough for the radix sort, with coordinates that only span a few of
+// its digits and lots of duplicates.
+TEST(SparseTensorCOO, SortRadix) {
+  SparseTensorCOO<double> coo({300, 7, 1000});
+  auto added = addRandom(coo, 10000, 1000);
+  coo.sort();
+  expectSortedPermutation(coo, std::move(added));
+}
+
+// Coordinates whose row-major linearization spans all 64 bits.
+TEST(SparseTensorCOO, SortRadixFullKey) {
+  SparseTensorCOO<double> coo({uint64_t(1) << 32, (uint64_t(1) << 32) - 1});
+  auto added = addRandom(coo, 5000, std::numeric_limits<uint64_t>::max());
+  coo.sort();
+  expectSortedPermutation(coo, std::move(added));
+}
+
+// The linearized coordinates overflow 64 bits, so std::sort is used.
+TEST(SparseTensorCOO, SortKeyOverflow) {
+  SparseTensorCOO<double> coo({uint64_t(1) << 40, uint64_t(1) << 40});
+  auto added = addRandom(coo, 5000, 64);
+  coo.sort();
+  expectSortedPermutation(coo, std::move(added));
+}
@@ -196,6 +196,12 @@ int32_t __kmpc_nvptx_teams_reduce_nowait_v2(
   uint32_t NumThreads = omp_get_num_threads();
   uint32_t TeamId = omp_get_team_num();
   uint32_t NumTeams = omp_get_num_teams();
+
+  // A single team already holds the result of the teams reduction in the
+  // reduce_data of its master, skip the global buffer and its counters.
+  if (NumTeams == 1)
+    return ThreadId == 0;
+
   [[clang::loader_uninitialized]] static Local<unsigned> Bound;
   [[clang::loader_uninitialized]] static Local<unsigned> ChunkTeamCount;
 
@@ -21,6 +21,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 
 extern "C" {
 
@@ -75,6 +76,17 @@ struct __tgt_async_info {
   /// should be freed after finalization.
   llvm::SmallVector<void *, 2> AssociatedAllocations;
 
+  /// Small host to device transfers to contiguous device memory starting at
+  /// PendingSubmitTgtPtr that are not issued yet. The plugin issues them as a
+  /// single transfer before any other operation on the queue.
+  void *PendingSubmitTgtPtr = nullptr;
+  int64_t PendingSubmitSize = 0;
+  llvm::SmallVector<std::pair<const void *, int64_t>, 4> PendingSubmits;
+
+  /// Host buffers staging coalesced transfers that should be freed after
+  /// finalization.
+  llvm::SmallVector<void *, 2> StagingBuffers;
+
   /// The kernel launch environment used to issue a kernel. Stored here to
   /// ensure it is a valid location while the transfer to the device is
   /// happening.
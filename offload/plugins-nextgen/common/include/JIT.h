@@ -70,6 +70,12 @@ private:
   getOrCreateObjFile(const __tgt_device_image &Image, LLVMContext &Ctx,
                      const std::string &ComputeUnitKind);
 
+  /// Return the path of the device image generated from \p Image for \p
+  /// ComputeUnitKind in the on-disk cache, or an empty string if the image
+  /// must not be cached.
+  std::string getCachePath(const __tgt_device_image &Image,
+                           const std::string &ComputeUnitKind);
+
   /// Run backend, which contains optimization and code generation.
   Expected<std::unique_ptr<MemoryBuffer>>
   backend(Module &M, const std::string &ComputeUnitKind, unsigned OptLevel);
@@ -86,9 +92,6 @@ private:
   const Triple TT;
 
   struct ComputeUnitInfo {
-    /// LLVM Context in which the modules will be constructed.
-    LLVMContext Context;
-
     /// Output images generated from LLVM backend.
     SmallVector<std::unique_ptr<MemoryBuffer>, 4> JITImages;
 
@@ -112,6 +115,7 @@ private:
       StringEnvar("LIBOMPTARGET_JIT_POST_OPT_IR_MODULE");
   UInt32Envar JITOptLevel = UInt32Envar("LIBOMPTARGET_JIT_OPT_LEVEL", 3);
   BoolEnvar JITSkipOpt = BoolEnvar("LIBOMPTARGET_JIT_SKIP_OPT", false);
+  StringEnvar JITCacheDirectory = StringEnvar("LIBOMPTARGET_JIT_CACHE_DIR");
 };
 
 } // namespace target
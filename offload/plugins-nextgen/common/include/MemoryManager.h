@@ -13,7 +13,10 @@
 #ifndef LLVM_OPENMP_LIBOMPTARGET_PLUGINS_COMMON_MEMORYMANAGER_H
 #define LLVM_OPENMP_LIBOMPTARGET_PLUGINS_COMMON_MEMORYMANAGER_H
 
+#include <atomic>
 #include <cassert>
+#include <cinttypes>
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <mutex>
@@ -93,6 +96,16 @@ class MemoryManagerTy {
     return L;
   }
 
+  /// Round \p Size up to its size class. There are four size classes for each
+  /// power of two, so that a released buffer can serve later requests of a
+  /// similar size while at most a fifth of it is left unused.
+  static size_t roundUpToSizeClass(size_t Size) {
+    if (Size <= BucketSize[1])
+      return BucketSize[1];
+    const size_t Step = floorToPowerOfTwo(Size) >> 2;
+    return (Size + Step - 1) & ~(Step - 1);
+  }
+
   /// A structure stores the meta data of a target pointer
   struct NodeTy {
     /// Memory size
@@ -133,6 +146,43 @@ class MemoryManagerTy {
   /// memory manager.
   size_t SizeThreshold = 1U << 13;
 
+  /// The largest amount of memory kept in the free lists. Released buffers
+  /// that do not fit are returned to the device. Zero means no limit.
+  size_t CacheLimit = 0;
+
+public:
+  /// Counters describing how well the memory manager serves the requests.
+  struct StatisticsTy {
+    /// Requests served from the free lists.
+    std::atomic<uint64_t> Hits = 0;
+    /// Requests that allocated a new buffer on the device.
+    std::atomic<uint64_t> Misses = 0;
+    /// Requests larger than the threshold, which are not managed.
+    std::atomic<uint64_t> Unmanaged = 0;
+    /// Bytes requested by the managed requests and bytes of the buffers that
+    /// served them. The difference is lost to the rounding of size classes.
+    std::atomic<uint64_t> RequestedBytes = 0;
+    std::atomic<uint64_t> ServedBytes = 0;
+    /// Bytes currently kept in the free lists, and the most ever kept.
+    std::atomic<uint64_t> CachedBytes = 0;
+    std::atomic<uint64_t> MaxCachedBytes = 0;
+    /// Bytes of released buffers returned to the device because of the cache
+    /// limit or because an allocation on the device failed.
+    std::atomic<uint64_t> TrimmedBytes = 0;
+  };
+
+private:
+  StatisticsTy Statistics;
+
+  /// Account for \p Size bytes added to the free lists.
+  void addCachedBytes(size_t Size) {
+    uint64_t Cached = Statistics.CachedBytes.fetch_add(Size) + Size;
+    uint64_t Max = Statistics.MaxCachedBytes.load();
+    while (Cached > Max && !Statistics.MaxCachedBytes.compare_exchange_weak(
+                               Max, Cached))
+      ;
+  }
+
   /// Request memory from target device
   void *allocateOnDevice(size_t Size, void *HstPtr) const {
     return DeviceAllocator.allocate(Size, HstPtr, TARGET_ALLOC_DEVICE);
@@ -156,6 +206,8 @@ class MemoryManagerTy {
       for (const NodeTy &N : List) {
         deleteOnDevice(N.Ptr);
         RemoveList.push_back(N.Ptr);
+        Statistics.CachedBytes -= N.Size;
+        Statistics.TrimmedBytes += N.Size;
       }
       FreeLists[I].clear();
     }
@@ -194,16 +246,25 @@ class MemoryManagerTy {
 
 public:
   /// Constructor. If \p Threshold is non-zero, then the default threshold will
-  /// be overwritten by \p Threshold.
-  MemoryManagerTy(DeviceAllocatorTy &DeviceAllocator, size_t Threshold = 0)
+  /// be overwritten by \p Threshold. If \p Limit is non-zero, at most \p Limit
+  /// bytes of released memory are kept for reuse.
+  MemoryManagerTy(DeviceAllocatorTy &DeviceAllocator, size_t Threshold = 0,
+                  size_t Limit = 0)
       : FreeLists(NumBuckets), FreeListLocks(NumBuckets),
-        DeviceAllocator(DeviceAllocator) {
+        DeviceAllocator(DeviceAllocator), CacheLimit(Limit) {
     if (Threshold)
       SizeThreshold = Threshold;
   }
 
   /// Destructor
   ~MemoryManagerTy() {
+    DP("MemoryManagerTy: %" PRIu64 " hits, %" PRIu64 " misses, %" PRIu64
+       " unmanaged, %" PRIu64 " of %" PRIu64 " bytes requested, %" PRIu64
+       " bytes cached at most, %" PRIu64 " bytes trimmed.\n",
+       Statistics.Hits.load(), Statistics.Misses.load(),
+       Statistics.Unmanaged.load(), Statistics.RequestedBytes.load(),
+       Statistics.ServedBytes.load(), Statistics.MaxCachedBytes.load(),
+       Statistics.TrimmedBytes.load());
     for (auto Itr = PtrToNodeTable.begin(); Itr != PtrToNodeTable.end();
          ++Itr) {
       assert(Itr->second.Ptr && "nullptr in map table");
@@ -229,12 +290,19 @@ public:
          "device\n",
          Size, SizeThreshold);
       void *TgtPtr = allocateOrFreeAndAllocateOnDevice(Size, HstPtr);
+      ++Statistics.Unmanaged;
 
       DP("Got target pointer " DPxMOD ". Return directly.\n", DPxPTR(TgtPtr));
 
       return TgtPtr;
     }
 
+    // Serve the request with a buffer of its size class, which can be reused by
+    // all the requests of the class once it is released.
+    Statistics.RequestedBytes += Size;
+    Size = roundUpToSizeClass(Size);
+    Statistics.ServedBytes += Size;
+
     NodeTy *NodePtr = nullptr;
 
     // Try to get a node from FreeList
@@ -252,8 +320,13 @@ public:
       }
     }
 
-    if (NodePtr != nullptr)
+    if (NodePtr != nullptr) {
       DP("Find one node " DPxMOD " in the bucket.\n", DPxPTR(NodePtr));
+      ++Statistics.Hits;
+      Statistics.CachedBytes -= Size;
+    } else {
+      ++Statistics.Misses;
+    }
 
     // We cannot find a valid node in FreeLists. Let's allocate on device and
     // create a node for it.
@@ -304,11 +377,26 @@ public:
       return deleteOnDevice(TgtPtr);
     }
 
+    // Return the buffer to the device if keeping it would exceed the limit of
+    // the free lists.
+    if (CacheLimit && Statistics.CachedBytes.load() + P->Size > CacheLimit) {
+      DP("Found its node " DPxMOD ", but the free lists are full. Delete it on "
+         "device.\n",
+         DPxPTR(P));
+      Statistics.TrimmedBytes += P->Size;
+      {
+        std::lock_guard<std::mutex> G(MapTableLock);
+        PtrToNodeTable.erase(TgtPtr);
+      }
+      return deleteOnDevice(TgtPtr);
+    }
+
     // Insert the node to the free list
     const int B = findBucket(P->Size);
 
     DP("Found its node " DPxMOD ". Insert it to bucket %d.\n", DPxPTR(P), B);
 
+    addCachedBytes(P->Size);
     {
       std::lock_guard<std::mutex> G(FreeListLocks[B]);
       FreeLists[B].insert(*P);
@@ -317,6 +405,9 @@ public:
     return OFFLOAD_SUCCESS;
   }
 
+  /// Get the counters describing the use of the memory manager.
+  const StatisticsTy &getStatistics() const { return Statistics; }
+
   /// Get the size threshold from the environment variable
   /// \p LIBOMPTARGET_MEMORY_MANAGER_THRESHOLD . Returns a <tt>
   /// std::pair<size_t, bool> </tt> where the first element represents the
@@ -337,6 +428,15 @@ public:
 
     return std::make_pair(Threshold, true);
   }
+
+  /// Get the most memory, in bytes, that the memory manager keeps for reuse
+  /// from the environment variable \p LIBOMPTARGET_MEMORY_MANAGER_CACHE_LIMIT .
+  /// Returns zero, i.e., no limit, if the user doesn't specify anything.
+  static size_t getCacheLimitFromEnv() {
+    static UInt64Envar MemoryManagerCacheLimit(
+        "LIBOMPTARGET_MEMORY_MANAGER_CACHE_LIMIT", 0);
+    return MemoryManagerCacheLimit.get();
+  }
 };
 
 // GCC still cannot handle the static data member like Clang so we still need
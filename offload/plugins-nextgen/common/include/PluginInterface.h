@@ -809,12 +809,19 @@ struct GenericDeviceTy : public DeviceAllocatorTy {
                                          void *&BaseDevAccessiblePtr,
                                          size_t &BaseSize) const = 0;
 
-  /// Submit data to the device (host to device transfer).
+  /// Submit data to the device (host to device transfer). Small transfers on
+  /// a queue that is already in use may be deferred and coalesced with those
+  /// to the adjacent device memory, see submitPendingData.
   Error dataSubmit(void *TgtPtr, const void *HstPtr, int64_t Size,
                    __tgt_async_info *AsyncInfo);
   virtual Error dataSubmitImpl(void *TgtPtr, const void *HstPtr, int64_t Size,
                                AsyncInfoWrapperTy &AsyncInfoWrapper) = 0;
 
+  /// Issue the transfers deferred by dataSubmit on \p AsyncInfo, if any. The
+  /// data of transfers that are not contiguous in host memory is copied into a
+  /// staging buffer that is freed after synchronization.
+  Error submitPendingData(__tgt_async_info *AsyncInfo);
+
   /// Retrieve data from the device (device to host transfer).
   Error dataRetrieve(void *HstPtr, const void *TgtPtr, int64_t Size,
                      __tgt_async_info *AsyncInfo);
@@ -1042,6 +1049,10 @@ protected:
   UInt32Envar OMPX_InitialNumStreams;
   UInt32Envar OMPX_InitialNumEvents;
 
+  /// Environment variable defining the largest host to device transfer, in
+  /// bytes, that may be coalesced with others. Zero disables the coalescing.
+  UInt32Envar OMPX_CoalesceSubmitSize;
+
   /// Array of images loaded into the device. Images are automatically
   /// deallocated by the allocator.
   llvm::SmallVector<DeviceImageTy *> LoadedImages;
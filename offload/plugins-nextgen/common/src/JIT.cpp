@@ -17,8 +17,10 @@
 #include "omptarget.h"
 
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/CodeGen/CommandFlags.h"
 #include "llvm/CodeGen/MachineModuleInfo.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/LLVMRemarkStreamer.h"
 #include "llvm/IR/LegacyPassManager.h"
@@ -28,11 +30,15 @@
 #include "llvm/Object/IRObjectFile.h"
 #include "llvm/Passes/OptimizationLevel.h"
 #include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/VCSRevision.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Target/TargetOptions.h"
@@ -250,7 +256,7 @@ JITEngine::getOrCreateObjFile(const __tgt_device_image &Image, LLVMContext &Ctx,
     return std::move(*MBOrErr);
   }
 
-  Module *Mod = nullptr;
+  std::unique_ptr<Module> Mod;
   // Check if the user replaces the module at runtime or we read it from the
   // image.
   // TODO: Allow the user to specify images per device (Arch + ComputeUnitKind).
@@ -258,7 +264,7 @@ JITEngine::getOrCreateObjFile(const __tgt_device_image &Image, LLVMContext &Ctx,
     auto ModOrErr = createModuleFromImage(Image, Ctx);
     if (!ModOrErr)
       return ModOrErr.takeError();
-    Mod = ModOrErr->release();
+    Mod = std::move(*ModOrErr);
   } else {
     auto MBOrErr =
         MemoryBuffer::getFileOrSTDIN(ReplacementModuleFileName.get());
@@ -269,40 +275,140 @@ JITEngine::getOrCreateObjFile(const __tgt_device_image &Image, LLVMContext &Ctx,
     auto ModOrErr = createModuleFromMemoryBuffer(MBOrErr.get(), Ctx);
     if (!ModOrErr)
       return ModOrErr.takeError();
-    Mod = ModOrErr->release();
+    Mod = std::move(*ModOrErr);
   }
 
   return backend(*Mod, ComputeUnitKind, JITOptLevel);
 }
 
+std::string JITEngine::getCachePath(const __tgt_device_image &Image,
+                                    const std::string &ComputeUnitKind) {
+  // The cache is bypassed whenever the user replaces or inspects parts of the
+  // pipeline.
+  if (!JITCacheDirectory.isPresent() || JITCacheDirectory.get().empty() ||
+      ReplacementObjectFileName.isPresent() ||
+      ReplacementModuleFileName.isPresent() ||
+      PreOptIRModuleFileName.isPresent() || PostOptIRModuleFileName.isPresent())
+    return "";
+
+  StringRef Binary(reinterpret_cast<const char *>(Image.ImageStart),
+                   utils::getPtrDiff(Image.ImageEnd, Image.ImageStart));
+  uint8_t OptLevel = JITOptLevel;
+  uint8_t SkipOpt = JITSkipOpt;
+
+  // Builds from different commits may share a version string but not a code
+  // generator.
+  SHA1 Hasher;
+  Hasher.update(LLVM_VERSION_STRING);
+#ifdef LLVM_REVISION
+  Hasher.update(LLVM_REVISION);
+#endif
+  Hasher.update(ArrayRef<uint8_t>{0});
+  Hasher.update(TT.str());
+  Hasher.update(ArrayRef<uint8_t>{0});
+  Hasher.update(ComputeUnitKind);
+  Hasher.update(ArrayRef<uint8_t>{0, OptLevel, SkipOpt});
+  Hasher.update(Binary);
+
+  // Entries use the naming of llvm::localCache so that pruneCache can trim the
+  // directory.
+  SmallString<256> Path(JITCacheDirectory.get());
+  sys::path::append(Path, "llvmcache-" + toHex(Hasher.result()));
+  return std::string(Path);
+}
+
+/// Store \p Buffer at \p Path. The buffer is written to a temporary file that
+/// is then renamed, so concurrent processes never read a partial entry.
+static Error writeCacheEntry(StringRef Path, MemoryBufferRef Buffer) {
+  StringRef Directory = sys::path::parent_path(Path);
+  if (std::error_code EC = sys::fs::create_directories(Directory))
+    return createStringError(EC, "cannot create cache directory");
+
+  // The temporary file lacks the llvmcache- prefix so that pruneCache leaves
+  // it alone.
+  SmallString<256> Model(Directory);
+  sys::path::append(Model, "JIT-%%%%%%.tmp");
+  auto TempOrErr = sys::fs::TempFile::create(Model);
+  if (!TempOrErr)
+    return TempOrErr.takeError();
+  {
+    raw_fd_ostream OS(TempOrErr->FD, /*shouldClose=*/false);
+    OS << Buffer.getBuffer();
+    OS.flush();
+    if (OS.has_error()) {
+      std::error_code EC = OS.error();
+      OS.clear_error();
+      return joinErrors(createStringError(EC, "cannot write cache entry"),
+                        TempOrErr->discard());
+    }
+  }
+  return TempOrErr->keep(Path);
+}
+
 Expected<const __tgt_device_image *>
 JITEngine::compile(const __tgt_device_image &Image,
                    const std::string &ComputeUnitKind,
                    PostProcessingFn PostProcessing) {
-  std::lock_guard<std::mutex> Lock(ComputeUnitMapMutex);
-
   // Check if we JITed this image for the given compute unit kind before.
-  ComputeUnitInfo &CUI = ComputeUnitMap[ComputeUnitKind];
-  if (__tgt_device_image *JITedImage = CUI.TgtImageMap.lookup(&Image))
-    return JITedImage;
+  {
+    std::lock_guard<std::mutex> Lock(ComputeUnitMapMutex);
+    ComputeUnitInfo &CUI = ComputeUnitMap[ComputeUnitKind];
+    if (__tgt_device_image *JITedImage = CUI.TgtImageMap.lookup(&Image))
+      return JITedImage;
+  }
+
+  // Look for the image in the on-disk cache. Failing to use the cache is not
+  // an error, the image is compiled instead.
+  std::string CachePath = getCachePath(Image, ComputeUnitKind);
+  std::unique_ptr<MemoryBuffer> ImageMB;
+  if (!CachePath.empty()) {
+    auto MBOrErr = MemoryBuffer::getFile(CachePath, /*IsText=*/false,
+                                         /*RequiresNullTerminator=*/false);
+    if (MBOrErr) {
+      ImageMB = std::move(*MBOrErr);
+      DP("Loaded JITed image for %s from the cache entry %s\n",
+         ComputeUnitKind.c_str(), CachePath.c_str());
+    }
+  }
 
-  auto ObjMBOrErr = getOrCreateObjFile(Image, CUI.Context, ComputeUnitKind);
-  if (!ObjMBOrErr)
-    return ObjMBOrErr.takeError();
+  // The lock is not held while compiling so that images for other devices or
+  // compute units can be processed concurrently. Each compilation uses its own
+  // context.
+  if (!ImageMB) {
+    LLVMContext Ctx;
+    auto ObjMBOrErr = getOrCreateObjFile(Image, Ctx, ComputeUnitKind);
+    if (!ObjMBOrErr)
+      return ObjMBOrErr.takeError();
+
+    auto ImageMBOrErr = PostProcessing(std::move(*ObjMBOrErr));
+    if (!ImageMBOrErr)
+      return ImageMBOrErr.takeError();
+    ImageMB = std::move(*ImageMBOrErr);
+
+    if (!CachePath.empty()) {
+      if (Error Err = writeCacheEntry(CachePath, ImageMB->getMemBufferRef())) {
+        std::string ErrMsg = toString(std::move(Err));
+        DP("Failed to add JITed image to the cache: %s\n", ErrMsg.c_str());
+      }
+    }
+  }
 
-  auto ImageMBOrErr = PostProcessing(std::move(*ObjMBOrErr));
-  if (!ImageMBOrErr)
-    return ImageMBOrErr.takeError();
+  std::lock_guard<std::mutex> Lock(ComputeUnitMapMutex);
+  ComputeUnitInfo &CUI = ComputeUnitMap[ComputeUnitKind];
 
-  CUI.JITImages.push_back(std::move(*ImageMBOrErr));
+  // Another thread may have processed the same image in the meantime.
   __tgt_device_image *&JITedImage = CUI.TgtImageMap[&Image];
+  if (JITedImage)
+    return JITedImage;
+
+  CUI.JITImages.push_back(std::move(ImageMB));
   JITedImage = new __tgt_device_image();
   *JITedImage = Image;
 
-  auto &ImageMB = CUI.JITImages.back();
+  auto &JITImageMB = CUI.JITImages.back();
 
-  JITedImage->ImageStart = const_cast<char *>(ImageMB->getBufferStart());
-  JITedImage->ImageEnd = const_cast<char *>(ImageMB->getBufferEnd());
+  JITedImage->ImageStart = const_cast<char *>(JITImageMB->getBufferStart());
+  JITedImage->ImageEnd = const_cast<char *>(JITImageMB->getBufferEnd());
 
   return JITedImage;
 }
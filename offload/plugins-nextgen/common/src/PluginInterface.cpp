@@ -36,6 +36,8 @@
 #include "llvm/Support/raw_ostream.h"
 
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
 
 using namespace llvm;
@@ -486,9 +488,15 @@ GenericKernelTy::getKernelLaunchEnvironment(
     return reinterpret_cast<KernelLaunchEnvironmentTy *>(~0);
 
   // TODO: Check if the kernel needs a launch environment.
-  auto AllocOrErr = GenericDevice.dataAlloc(sizeof(KernelLaunchEnvironmentTy),
-                                            /*HostPtr=*/nullptr,
-                                            TargetAllocTy::TARGET_ALLOC_DEVICE);
+  // The reduction buffer follows the launch environment in the same
+  // allocation, so that a launch allocates and frees device memory only once.
+  const size_t ReductionBufferOffset =
+      utils::roundUp(sizeof(KernelLaunchEnvironmentTy), size_t(64));
+  auto AllocOrErr = GenericDevice.dataAlloc(
+      ReductionBufferOffset +
+          KernelEnvironment.Configuration.ReductionDataSize *
+              KernelEnvironment.Configuration.ReductionBufferLength,
+      /*HostPtr=*/nullptr, TargetAllocTy::TARGET_ALLOC_DEVICE);
   if (!AllocOrErr)
     return AllocOrErr.takeError();
 
@@ -499,17 +507,8 @@ GenericKernelTy::getKernelLaunchEnvironment(
   /// async data transfer.
   auto &LocalKLE = (*AsyncInfoWrapper).KernelLaunchEnvironment;
   LocalKLE = KernelLaunchEnvironment;
-  {
-    auto AllocOrErr = GenericDevice.dataAlloc(
-        KernelEnvironment.Configuration.ReductionDataSize *
-            KernelEnvironment.Configuration.ReductionBufferLength,
-        /*HostPtr=*/nullptr, TargetAllocTy::TARGET_ALLOC_DEVICE);
-    if (!AllocOrErr)
-      return AllocOrErr.takeError();
-    LocalKLE.ReductionBuffer = *AllocOrErr;
-    // Remember to free the memory later.
-    AsyncInfoWrapper.freeAllocationAfterSynchronization(*AllocOrErr);
-  }
+  LocalKLE.ReductionBuffer =
+      utils::advancePtr(*AllocOrErr, ReductionBufferOffset);
 
   INFO(OMP_INFOTYPE_DATA_TRANSFER, GenericDevice.getDeviceId(),
        "Copying data from host to device, HstPtr=" DPxMOD ", TgtPtr=" DPxMOD
@@ -594,6 +593,11 @@ Error GenericKernelTy::launch(GenericDeviceTy &GenericDevice, void **ArgPtrs,
           printLaunchInfo(GenericDevice, KernelArgs, NumThreads, NumBlocks))
     return Err;
 
+  // The kernel may read the data of deferred transfers, including the one of
+  // its launch environment.
+  if (auto Err = GenericDevice.submitPendingData(AsyncInfoWrapper))
+    return Err;
+
   return launchImpl(GenericDevice, NumThreads, NumBlocks, KernelArgs,
                     LaunchParams, AsyncInfoWrapper);
 }
@@ -744,6 +748,7 @@ GenericDeviceTy::GenericDeviceTy(GenericPluginTy &Plugin, int32_t DeviceId,
       // By default, the initial number of streams and events is 1.
       OMPX_InitialNumStreams("LIBOMPTARGET_NUM_INITIAL_STREAMS", 1),
       OMPX_InitialNumEvents("LIBOMPTARGET_NUM_INITIAL_EVENTS", 1),
+      OMPX_CoalesceSubmitSize("LIBOMPTARGET_COALESCE_SUBMIT_SIZE", 4096),
       DeviceId(DeviceId), GridValues(OMPGridValues),
       PeerAccesses(NumDevices, PeerAccessState::PENDING), PeerAccessesLock(),
       PinnedAllocs(*this), RPCServer(nullptr) {
@@ -811,7 +816,8 @@ Error GenericDeviceTy::init(GenericPluginTy &Plugin) {
   // Enable the memory manager if required.
   auto [ThresholdMM, EnableMM] = MemoryManagerTy::getSizeThresholdFromEnv();
   if (EnableMM)
-    MemoryManager = new MemoryManagerTy(*this, ThresholdMM);
+    MemoryManager = new MemoryManagerTy(*this, ThresholdMM,
+                                        MemoryManagerTy::getCacheLimitFromEnv());
 
   return Plugin::success();
 }
@@ -873,8 +879,20 @@ Error GenericDeviceTy::deinit(GenericPluginTy &Plugin) {
 
   // Delete the memory manager before deinitializing the device. Otherwise,
   // we may delete device allocations after the device is deinitialized.
-  if (MemoryManager)
+  if (MemoryManager) {
+    const MemoryManagerTy::StatisticsTy &Stats = MemoryManager->getStatistics();
+    uint64_t Requested = Stats.RequestedBytes, Served = Stats.ServedBytes;
+    INFO(OMP_INFOTYPE_PLUGIN_KERNEL, DeviceId,
+         "Memory manager served %" PRIu64 " of %" PRIu64
+         " allocations from its free lists, %" PRIu64
+         " were not managed, %.1f%% of the served memory was unused, at "
+         "most %" PRIu64 " bytes were kept for reuse, %" PRIu64
+         " bytes were trimmed\n",
+         Stats.Hits.load(), Stats.Hits + Stats.Misses, Stats.Unmanaged.load(),
+         Served ? 100.0 * (Served - Requested) / Served : 0.0,
+         Stats.MaxCachedBytes.load(), Stats.TrimmedBytes.load());
     delete MemoryManager;
+  }
   MemoryManager = nullptr;
 
   RecordReplayTy &RecordReplay = Plugin.getRecordReplay();
@@ -1313,6 +1331,9 @@ Error GenericDeviceTy::synchronize(__tgt_async_info *AsyncInfo) {
   if (!AsyncInfo || !AsyncInfo->Queue)
     return Plugin::error("Invalid async info queue");
 
+  if (auto Err = submitPendingData(AsyncInfo))
+    return Err;
+
   if (auto Err = synchronizeImpl(*AsyncInfo))
     return Err;
 
@@ -1321,6 +1342,10 @@ Error GenericDeviceTy::synchronize(__tgt_async_info *AsyncInfo) {
       return Err;
   AsyncInfo->AssociatedAllocations.clear();
 
+  for (auto *Ptr : AsyncInfo->StagingBuffers)
+    std::free(Ptr);
+  AsyncInfo->StagingBuffers.clear();
+
   return Plugin::success();
 }
 
@@ -1328,7 +1353,20 @@ Error GenericDeviceTy::queryAsync(__tgt_async_info *AsyncInfo) {
   if (!AsyncInfo || !AsyncInfo->Queue)
     return Plugin::error("Invalid async info queue");
 
-  return queryAsyncImpl(*AsyncInfo);
+  if (auto Err = submitPendingData(AsyncInfo))
+    return Err;
+
+  if (auto Err = queryAsyncImpl(*AsyncInfo))
+    return Err;
+
+  // The plugins reset the queue once its operations completed.
+  if (!AsyncInfo->Queue) {
+    for (auto *Ptr : AsyncInfo->StagingBuffers)
+      std::free(Ptr);
+    AsyncInfo->StagingBuffers.clear();
+  }
+
+  return Plugin::success();
 }
 
 Error GenericDeviceTy::memoryVAMap(void **Addr, void *VAddr, size_t *RSize) {
@@ -1471,6 +1509,78 @@ Error GenericDeviceTy::dataDelete(void *TgtPtr, TargetAllocTy Kind) {
 
 Error GenericDeviceTy::dataSubmit(void *TgtPtr, const void *HstPtr,
                                   int64_t Size, __tgt_async_info *AsyncInfo) {
+  // Small transfers are dominated by the cost of issuing them. Defer those on
+  // a queue that is in use, which the caller must synchronize anyway, so that
+  // transfers to adjacent device memory, e.g., members of a mapped struct, are
+  // issued as one. Without a queue we would not be synchronized.
+  if (AsyncInfo && AsyncInfo->Queue && Size > 0 &&
+      Size <= OMPX_CoalesceSubmitSize &&
+      !Plugin.getRecordReplay().isRecordingOrReplaying()) {
+    if (!AsyncInfo->PendingSubmits.empty() &&
+        TgtPtr != utils::advancePtr(AsyncInfo->PendingSubmitTgtPtr,
+                                    AsyncInfo->PendingSubmitSize))
+      if (auto Err = submitPendingData(AsyncInfo))
+        return Err;
+
+    if (AsyncInfo->PendingSubmits.empty())
+      AsyncInfo->PendingSubmitTgtPtr = TgtPtr;
+    AsyncInfo->PendingSubmits.emplace_back(HstPtr, Size);
+    AsyncInfo->PendingSubmitSize += Size;
+    return Plugin::success();
+  }
+
+  if (auto Err = submitPendingData(AsyncInfo))
+    return Err;
+
+  AsyncInfoWrapperTy AsyncInfoWrapper(*this, AsyncInfo);
+
+  auto Err = dataSubmitImpl(TgtPtr, HstPtr, Size, AsyncInfoWrapper);
+  AsyncInfoWrapper.finalize(Err);
+  return Err;
+}
+
+Error GenericDeviceTy::submitPendingData(__tgt_async_info *AsyncInfo) {
+  if (!AsyncInfo || AsyncInfo->PendingSubmits.empty())
+    return Plugin::success();
+
+  void *TgtPtr = AsyncInfo->PendingSubmitTgtPtr;
+  int64_t Size = AsyncInfo->PendingSubmitSize;
+  const void *HstPtr = AsyncInfo->PendingSubmits.front().first;
+
+  // Copy the data into a staging buffer unless it is contiguous on the host.
+  bool IsContiguous = true;
+  const void *NextHstPtr = HstPtr;
+  for (auto [PendingPtr, PendingSize] : AsyncInfo->PendingSubmits) {
+    if (PendingPtr != NextHstPtr) {
+      IsContiguous = false;
+      break;
+    }
+    NextHstPtr = utils::advancePtr(NextHstPtr, PendingSize);
+  }
+  if (!IsContiguous) {
+    void *StagingPtr = std::malloc(Size);
+    if (!StagingPtr)
+      return Plugin::error("Failed to allocate a staging buffer of %" PRId64
+                           " bytes",
+                           Size);
+    AsyncInfo->StagingBuffers.push_back(StagingPtr);
+
+    void *Ptr = StagingPtr;
+    for (auto [PendingPtr, PendingSize] : AsyncInfo->PendingSubmits) {
+      std::memcpy(Ptr, PendingPtr, PendingSize);
+      Ptr = utils::advancePtr(Ptr, PendingSize);
+    }
+    HstPtr = StagingPtr;
+  }
+
+  DP("Coalesced %zu transfers of %" PRId64 " bytes to " DPxMOD "%s\n",
+     AsyncInfo->PendingSubmits.size(), Size, DPxPTR(TgtPtr),
+     IsContiguous ? "" : " through a staging buffer");
+
+  AsyncInfo->PendingSubmits.clear();
+  AsyncInfo->PendingSubmitTgtPtr = nullptr;
+  AsyncInfo->PendingSubmitSize = 0;
+
   AsyncInfoWrapperTy AsyncInfoWrapper(*this, AsyncInfo);
 
   auto Err = dataSubmitImpl(TgtPtr, HstPtr, Size, AsyncInfoWrapper);
@@ -1480,6 +1590,9 @@ Error GenericDeviceTy::dataSubmit(void *TgtPtr, const void *HstPtr,
 
 Error GenericDeviceTy::dataRetrieve(void *HstPtr, const void *TgtPtr,
                                     int64_t Size, __tgt_async_info *AsyncInfo) {
+  if (auto Err = submitPendingData(AsyncInfo))
+    return Err;
+
   AsyncInfoWrapperTy AsyncInfoWrapper(*this, AsyncInfo);
 
   auto Err = dataRetrieveImpl(HstPtr, TgtPtr, Size, AsyncInfoWrapper);
@@ -1490,6 +1603,9 @@ Error GenericDeviceTy::dataRetrieve(void *HstPtr, const void *TgtPtr,
 Error GenericDeviceTy::dataExchange(const void *SrcPtr, GenericDeviceTy &DstDev,
                                     void *DstPtr, int64_t Size,
                                     __tgt_async_info *AsyncInfo) {
+  if (auto Err = submitPendingData(AsyncInfo))
+    return Err;
+
   AsyncInfoWrapperTy AsyncInfoWrapper(*this, AsyncInfo);
 
   auto Err = dataExchangeImpl(SrcPtr, DstDev, DstPtr, Size, AsyncInfoWrapper);
@@ -1575,6 +1691,9 @@ Error GenericDeviceTy::destroyEvent(void *EventPtr) {
 
 Error GenericDeviceTy::recordEvent(void *EventPtr,
                                    __tgt_async_info *AsyncInfo) {
+  if (auto Err = submitPendingData(AsyncInfo))
+    return Err;
+
   AsyncInfoWrapperTy AsyncInfoWrapper(*this, AsyncInfo);
 
   auto Err = recordEventImpl(EventPtr, AsyncInfoWrapper);
@@ -1583,6 +1702,9 @@ Error GenericDeviceTy::recordEvent(void *EventPtr,
 }
 
 Error GenericDeviceTy::waitEvent(void *EventPtr, __tgt_async_info *AsyncInfo) {
+  if (auto Err = submitPendingData(AsyncInfo))
+    return Err;
+
   AsyncInfoWrapperTy AsyncInfoWrapper(*this, AsyncInfo);
 
   auto Err = waitEventImpl(EventPtr, AsyncInfoWrapper);
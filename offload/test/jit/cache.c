@@ -0,0 +1,36 @@
+// clang-format off
+//
+// RUN: %libomptarget-compileopt-generic -fopenmp-target-jit
+// RUN: rm -rf %t.cache
+// RUN: env LIBOMPTARGET_JIT_CACHE_DIR=%t.cache %libomptarget-run-generic \
+// RUN:   | %fcheck-generic
+// RUN: ls %t.cache | %fcheck-plain-generic %s --check-prefix=CACHE
+// RUN: touch -t 200001010000 %t.cache/llvmcache-*
+// RUN: env LIBOMPTARGET_JIT_CACHE_DIR=%t.cache %libomptarget-run-generic \
+// RUN:   | %fcheck-generic
+// RUN: ls %t.cache | %fcheck-plain-generic %s --check-prefix=CACHE
+// RUN: find %t.cache -name 'llvmcache-*' -not -newermt 2000-01-02 \
+// RUN:   | %fcheck-plain-generic %s --check-prefix=CACHE
+//
+// clang-format on
+
+// REQUIRES: gpu
+
+// Check that the JITed image is written to the cache by the first run and
+// reused by the second one. The entry is backdated in between; a second run
+// that compiled the image again would replace it with a new file.
+//
+// CACHE: llvmcache-{{[0-9a-f]+}}
+// CACHE-NOT: llvmcache-
+
+#include <stdio.h>
+
+int main() {
+  int x = 0;
+#pragma omp target map(tofrom : x)
+  x = 42;
+
+  // CHECK: x = 42
+  printf("x = %d\n", x);
+  return 0;
+}
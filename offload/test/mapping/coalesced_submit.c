@@ -0,0 +1,53 @@
+// RUN: %libomptarget-compile-generic
+// RUN: env LIBOMPTARGET_MAP_FORCE_ATOMIC=false %libomptarget-run-generic \
+// RUN:   | %fcheck-generic
+// RUN: env LIBOMPTARGET_COALESCE_SUBMIT_SIZE=0 %libomptarget-run-generic \
+// RUN:   | %fcheck-generic
+
+// Check that small transfers to adjacent device memory, which the plugins may
+// issue as one, reach the device before the kernel that reads them.
+
+#include <stdio.h>
+
+#define N 64
+
+struct S {
+  int a;
+  int b;
+  double c;
+  int d[N];
+  char e;
+};
+
+int main() {
+  struct S s = {0};
+  int x[N] = {0};
+  int sum = 0;
+
+#pragma omp target data map(alloc : s, x)
+  {
+    for (int r = 1; r <= 4; ++r) {
+      s.a = r;
+      s.b = 2 * r;
+      s.c = 3 * r;
+      for (int i = 0; i < N; ++i) {
+        s.d[i] = r + i;
+        x[i] = r * i;
+      }
+      s.e = r;
+#pragma omp target update to(s.a, s.b, s.c, s.d, s.e)
+#pragma omp target update to(x[0 : N / 2], x[N / 2 : N / 2])
+#pragma omp target map(tofrom : sum)
+      {
+        int ok = s.a == r && s.b == 2 * r && s.c == 3 * r && s.e == r;
+        for (int i = 0; i < N; ++i)
+          ok = ok && s.d[i] == r + i && x[i] == r * i;
+        sum += ok;
+      }
+    }
+  }
+
+  // CHECK: sum = 4
+  printf("sum = %d\n", sum);
+  return 0;
+}
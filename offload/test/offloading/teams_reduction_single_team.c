@@ -0,0 +1,29 @@
+// RUN: %libomptarget-compile-run-and-check-generic
+// RUN: %libomptarget-compileopt-run-and-check-generic
+
+// Check teams reductions with a single team, which do not go through the
+// global reduction buffer, next to ones with several teams.
+
+#include <stdio.h>
+
+int main(int argc, char **argv) {
+  unsigned s1 = 0, s2 = 0;
+  double d = 0;
+  for (int r = 0; r < 4; ++r) {
+#pragma omp target teams distribute parallel for num_teams(1)                  \
+    reduction(+ : s1, d)
+    for (int i = 0; i < 10000; ++i) {
+      s1 += i;
+      d += 0.5;
+    }
+#pragma omp target teams distribute parallel for num_teams(8) reduction(+ : s2)
+    for (int i = 0; i < 10000; ++i)
+      s2 += i;
+  }
+
+#pragma omp target teams num_teams(1) reduction(+ : s2)
+  s2 += 1;
+
+  // CHECK: 199980000 : 199980001 : 20000
+  printf("%u : %u : %.0f\n", s1, s2, d);
+}
@@ -2056,6 +2056,11 @@ typedef struct dispatch_shared_info {
   volatile kmp_int32 doacross_buf_idx; // teamwise index
   volatile kmp_uint32 *doacross_flags; // shared array of iteration flags (0/1)
   kmp_int32 doacross_num_done; // count finished threads
+  // schedule(auto) tuning, see KMP_ADAPTIVE_SCHEDULE in kmp_dispatch.cpp
+  struct kmp_sched_tune *tune; // record of the loop, NULL if not tuned
+  kmp_uint64 tune_start; // ticks when the first thread initialized the loop
+  kmp_uint64 tune_tc; // trip count of the loop
+  volatile kmp_int32 tune_pick; // candidate schedule plus one, 0 if unset
 #if KMP_USE_HIER_SCHED
   void *hier;
 #endif
@@ -2230,6 +2235,9 @@ union KMP_ALIGN_CACHE kmp_barrier_union {
 
 typedef union kmp_barrier_union kmp_balign_t;
 
+/* Patterns KMP_ADAPTIVE_BARRIER chooses from: linear, tree and hyper */
+#define KMP_ADAPTIVE_BARRIER_PATTERNS 3
+
 /* Team barrier needs only non-volatile arrived counter */
 union KMP_ALIGN_CACHE kmp_barrier_team_union {
   double b_align; /* use worst case alignment */
@@ -2244,6 +2252,15 @@ union KMP_ALIGN_CACHE kmp_barrier_team_union {
     kmp_uint b_master_arrived;
     kmp_uint b_team_arrived;
 #endif
+    // Adaptive choice of the barrier pattern (KMP_ADAPTIVE_BARRIER), only
+    // updated by the primary thread once all the threads arrived.
+    kmp_uint64 b_cost[KMP_ADAPTIVE_BARRIER_PATTERNS]; /* fastest gather phase
+                                                         per candidate */
+    kmp_int32 b_nproc; /* team size the candidates were timed for */
+    kmp_uint16 b_samples; /* barriers since the current trial or choice */
+    kmp_uint8 b_trial; /* candidate being timed, or
+                          KMP_ADAPTIVE_BARRIER_PATTERNS once one is chosen */
+    kmp_uint8 b_pattern; /* kmp_bar_pat_e for both phases */
   };
 };
 
@@ -2426,6 +2443,7 @@ extern kmp_tasking_mode_t
     __kmp_tasking_mode; /* determines how/when to execute tasks */
 extern int __kmp_task_stealing_constraint;
 extern int __kmp_enable_task_throttling;
+extern int __kmp_task_stealing_locality;
 extern kmp_int32 __kmp_default_device; // Set via OMP_DEFAULT_DEVICE if
 // specified, defaults to 0 otherwise
 // Set via OMP_MAX_TASK_PRIORITY if specified, defaults to 0 otherwise
@@ -2539,11 +2557,11 @@ struct kmp_depnode_list {
 #define MAX_MTX_DEPS 4
 
 typedef struct kmp_base_depnode {
-  kmp_depnode_list_t *successors; /* used under lock */
-  kmp_task_t *task; /* non-NULL if depnode is active, used under lock */
+  /* claimed with KMP_DEPNODE_LINKING to add to it, see kmp_taskdeps.h */
+  std::atomic<kmp_depnode_list_t *> successors;
+  kmp_task_t *task; /* non-NULL if depnode is active, used under the claim */
   kmp_lock_t *mtx_locks[MAX_MTX_DEPS]; /* lock mutexinoutset dependent tasks */
   kmp_int32 mtx_num_locks; /* number of locks in mtx_locks array */
-  kmp_lock_t lock; /* guards shared fields: task, successors */
 #if KMP_SUPPORT_GRAPH_OUTPUT
   kmp_uint32 id;
 #endif
@@ -2812,6 +2830,7 @@ typedef struct kmp_base_thread_data {
   kmp_int32 td_deque_ntasks; // Number of tasks in deque
   // GEH: shouldn't this be volatile since used in while-spin?
   kmp_int32 td_deque_last_stolen; // Thread number of last successful steal
+  kmp_uint32 td_failed_steals; // Failed steals since the last successful one
 #ifdef BUILD_TIED_TASK_STACK
   kmp_task_stack_t td_susp_tied_tasks; // Stack of suspended tied tasks for task
 // scheduling constraint
@@ -3074,6 +3093,12 @@ typedef struct KMP_ALIGN_CACHE kmp_base_info {
   std::atomic<bool> th_blocking;
 #endif
   kmp_cg_root_t *th_cg_roots; // list of cg_roots associated with this thread
+  // Per-region measurements of KMP_REGION_STATS (see kmp_region_stats.cpp)
+  kmp_uint64 th_region_busy; // ticks spent in the last implicit task
+  kmp_uint64 th_region_wait; // ticks spent in barriers, running total
+  kmp_uint64 th_region_tasks; // explicit tasks executed, running total
+  kmp_uint64 th_region_wait0; // th_region_wait at the start of the region
+  kmp_uint64 th_region_tasks0; // th_region_tasks at the start of the region
 } kmp_base_info_t;
 
 typedef union KMP_ALIGN_CACHE kmp_info {
@@ -3216,6 +3241,11 @@ typedef struct KMP_ALIGN_CACHE kmp_base_team {
 #endif /* USE_ITT_BUILD */
   distributedBarrier *b; // Distributed barrier data associated with team
   kmp_nested_nthreads_t *t_nested_nth;
+  // Per-region measurements of KMP_REGION_STATS (see kmp_region_stats.cpp)
+  void *t_region_key; // outlined function of the region
+  kmp_uint64 t_region_start; // ticks when the region was forked
+  kmp_uint64 t_region_wait0; // th_region_wait0 of the primary thread
+  kmp_uint64 t_region_tasks0; // th_region_tasks0 of the primary thread
 } kmp_base_team_t;
 
 // Assert that the list structure fits and aligns within
@@ -3389,11 +3419,17 @@ extern kmp_uint32 __kmp_barrier_gather_branch_bits[bs_last_barrier];
 extern kmp_uint32 __kmp_barrier_release_branch_bits[bs_last_barrier];
 extern kmp_bar_pat_e __kmp_barrier_gather_pattern[bs_last_barrier];
 extern kmp_bar_pat_e __kmp_barrier_release_pattern[bs_last_barrier];
+extern int __kmp_adaptive_barrier;
 extern char const *__kmp_barrier_branch_bit_env_name[bs_last_barrier];
 extern char const *__kmp_barrier_pattern_env_name[bs_last_barrier];
 extern char const *__kmp_barrier_type_name[bs_last_barrier];
 extern char const *__kmp_barrier_pattern_name[bp_last_bar];
 
+/* Per-region statistics, see kmp_region_stats.cpp */
+extern int __kmp_region_stats; /* KMP_REGION_STATS */
+extern char *__kmp_region_stats_file; /* KMP_REGION_STATS_FILE */
+extern int __kmp_region_stats_signal; /* KMP_REGION_STATS_SIGNAL */
+
 /* Global Locks */
 extern kmp_bootstrap_lock_t __kmp_initz_lock; /* control initialization */
 extern kmp_bootstrap_lock_t __kmp_forkjoin_lock; /* control fork/join access */
@@ -3416,6 +3452,7 @@ extern enum sched_type __kmp_sched; /* default runtime scheduling */
 extern enum sched_type __kmp_static; /* default static scheduling method */
 extern enum sched_type __kmp_guided; /* default guided scheduling method */
 extern enum sched_type __kmp_auto; /* default auto scheduling method */
+extern int __kmp_adaptive_schedule; /* tune schedule(auto) loops */
 extern int __kmp_chunk; /* default runtime chunk size */
 extern int __kmp_force_monotonic; /* whether monotonic scheduling forced */
 
@@ -4076,6 +4113,11 @@ extern void __kmp_join_call(ident_t *loc, int gtid
 extern void __kmp_serialized_parallel(ident_t *id, kmp_int32 gtid);
 extern void __kmp_internal_fork(ident_t *id, int gtid, kmp_team_t *team);
 extern void __kmp_internal_join(ident_t *id, int gtid, kmp_team_t *team);
+extern void __kmp_region_stats_init(void);
+extern void __kmp_region_stats_fork(kmp_info_t *primary, kmp_team_t *team);
+extern void __kmp_region_stats_join(kmp_info_t *primary, kmp_team_t *team,
+                                    kmp_uint64 arrival);
+extern void __kmp_region_stats_fini(void);
 extern int __kmp_invoke_task_func(int gtid);
 extern void __kmp_run_before_invoked_task(int gtid, int tid,
                                           kmp_info_t *this_thr,
@@ -4382,6 +4424,8 @@ KMP_EXPORT void __kmpc_init_nest_lock_with_hint(ident_t *loc, kmp_int32 gtid,
 static inline bool __kmp_tdg_is_recording(kmp_tdg_status_t status) {
   return status == KMP_TDG_RECORDING;
 }
+// __kmp_tdg_record_task: add a task to the nodes of a recording TDG
+extern void __kmp_tdg_record_task(kmp_tdg_info_t *tdg, kmp_task_t *new_task);
 
 KMP_EXPORT kmp_int32 __kmpc_start_record_task(ident_t *loc, kmp_int32 gtid,
                                               kmp_int32 input_flags,
@@ -1756,6 +1756,90 @@ template <> struct is_cancellable<false> {
   constexpr operator bool() const { return false; }
 };
 
+// Adaptive barrier patterns (KMP_ADAPTIVE_BARRIER). The primary thread of a
+// team times the gather phase of its plain and reduction barriers with each
+// candidate pattern in turn and keeps the fastest. It starts over when the
+// team size changes, and every KMP_ADAPTIVE_BARRIER_PERIOD barriers in case
+// the workload changed. The threads read the pattern of a barrier from the
+// team when they arrive, so the primary thread only changes it once they all
+// have, and nested teams of different sizes make their own choices.
+static const kmp_bar_pat_e
+    __kmp_adaptive_barrier_pattern[KMP_ADAPTIVE_BARRIER_PATTERNS] = {
+        bp_linear_bar, bp_tree_bar, bp_hyper_bar};
+// Number of barriers timed per candidate. The fastest is kept, which filters
+// out load imbalance between the threads.
+#define KMP_ADAPTIVE_BARRIER_SAMPLES 16
+#define KMP_ADAPTIVE_BARRIER_PERIOD 4096
+
+static inline bool __kmp_barrier_is_adaptive(enum barrier_type bt) {
+  if (!__kmp_adaptive_barrier || bt == bs_forkjoin_barrier)
+    return false;
+  // The distributed and hierarchical barriers keep state of their own, which
+  // switching patterns would invalidate.
+  kmp_bar_pat_e gather = __kmp_barrier_gather_pattern[bt];
+  kmp_bar_pat_e release = __kmp_barrier_release_pattern[bt];
+  return gather != bp_dist_bar && gather != bp_hierarchical_bar &&
+         release != bp_dist_bar && release != bp_hierarchical_bar;
+}
+
+static inline bool __kmp_adaptive_barrier_usable(enum barrier_type bt,
+                                                 int candidate) {
+  // The tree and hyper barriers need a branching factor
+  return __kmp_adaptive_barrier_pattern[candidate] == bp_linear_bar ||
+         (__kmp_barrier_gather_branch_bits[bt] &&
+          __kmp_barrier_release_branch_bits[bt]);
+}
+
+// Called by the primary thread once all the threads arrived at a barrier that
+// used pattern, with the time the gather phase took. Chooses the pattern of
+// the next barrier of the team.
+static void __kmp_adaptive_barrier_update(kmp_team_t *team,
+                                          enum barrier_type bt,
+                                          kmp_bar_pat_e pattern,
+                                          kmp_uint64 cost) {
+  kmp_balign_team_t *bar = &team->t.t_bar[bt];
+  int trial = bar->b_trial;
+  if (bar->b_nproc != team->t.t_nproc ||
+      (trial == KMP_ADAPTIVE_BARRIER_PATTERNS &&
+       ++bar->b_samples == KMP_ADAPTIVE_BARRIER_PERIOD)) {
+    bar->b_nproc = team->t.t_nproc;
+    bar->b_trial = 0;
+    bar->b_samples = 0;
+    for (int i = 0; i < KMP_ADAPTIVE_BARRIER_PATTERNS; ++i)
+      bar->b_cost[i] = KMP_UINT64_MAX;
+    bar->b_pattern = __kmp_adaptive_barrier_pattern[0];
+    return;
+  }
+  if (trial == KMP_ADAPTIVE_BARRIER_PATTERNS ||
+      pattern != __kmp_adaptive_barrier_pattern[trial])
+    return;
+  if (cost < bar->b_cost[trial])
+    bar->b_cost[trial] = cost;
+  if (++bar->b_samples < KMP_ADAPTIVE_BARRIER_SAMPLES)
+    return;
+
+  bar->b_samples = 0;
+  do {
+    ++trial;
+  } while (trial < KMP_ADAPTIVE_BARRIER_PATTERNS &&
+           !__kmp_adaptive_barrier_usable(bt, trial));
+  bar->b_trial = (kmp_uint8)trial;
+  if (trial == KMP_ADAPTIVE_BARRIER_PATTERNS) {
+    // Done timing, candidates that were not usable kept the maximum cost
+    trial = 0;
+    for (int i = 1; i < KMP_ADAPTIVE_BARRIER_PATTERNS; ++i)
+      if (bar->b_cost[i] < bar->b_cost[trial])
+        trial = i;
+    KA_TRACE(20, ("__kmp_adaptive_barrier_update: team %d chose %s for %s "
+                  "barriers of %d threads\n",
+                  team->t.t_id,
+                  __kmp_barrier_pattern_name[__kmp_adaptive_barrier_pattern
+                                                 [trial]],
+                  __kmp_barrier_type_name[bt], team->t.t_nproc));
+  }
+  bar->b_pattern = __kmp_adaptive_barrier_pattern[trial];
+}
+
 // Internal function to do a barrier.
 /* If is_split is true, do a split barrier, otherwise, do a plain barrier
    If reduce is non-NULL, do a split reduction barrier, otherwise, do a split
@@ -1879,11 +1963,22 @@ static int __kmp_barrier_template(enum barrier_type bt, int gtid, int is_split,
     if (KMP_MASTER_TID(tid) && __kmp_tasking_mode != tskm_immediate_exec)
       __kmp_task_team_setup(this_thr, team);
 
+    kmp_bar_pat_e gather_pattern = __kmp_barrier_gather_pattern[bt];
+    kmp_bar_pat_e release_pattern = __kmp_barrier_release_pattern[bt];
+    bool adaptive = !cancellable && __kmp_barrier_is_adaptive(bt);
+    kmp_uint64 gather_start = 0;
+    if (adaptive) {
+      gather_pattern = release_pattern =
+          (kmp_bar_pat_e)team->t.t_bar[bt].b_pattern;
+      if (KMP_MASTER_TID(tid))
+        gather_start = KMP_NOW();
+    }
+
     if (cancellable) {
       cancelled = __kmp_linear_barrier_gather_cancellable(
           bt, this_thr, gtid, tid, reduce USE_ITT_BUILD_ARG(itt_sync_obj));
     } else {
-      switch (__kmp_barrier_gather_pattern[bt]) {
+      switch (gather_pattern) {
       case bp_dist_bar: {
         __kmp_dist_barrier_gather(bt, this_thr, gtid, tid,
                                   reduce USE_ITT_BUILD_ARG(itt_sync_obj));
@@ -1915,6 +2010,11 @@ static int __kmp_barrier_template(enum barrier_type bt, int gtid, int is_split,
       }
     }
 
+    // A split barrier is released with the pattern in the team later on
+    if (adaptive && KMP_MASTER_TID(tid) && !is_split)
+      __kmp_adaptive_barrier_update(team, bt, gather_pattern,
+                                    KMP_NOW() - gather_start);
+
     KMP_MB();
 
     if (KMP_MASTER_TID(tid)) {
@@ -2001,7 +2101,7 @@ static int __kmp_barrier_template(enum barrier_type bt, int gtid, int is_split,
         cancelled = __kmp_linear_barrier_release_cancellable(
             bt, this_thr, gtid, tid, FALSE USE_ITT_BUILD_ARG(itt_sync_obj));
       } else {
-        switch (__kmp_barrier_release_pattern[bt]) {
+        switch (release_pattern) {
         case bp_dist_bar: {
           KMP_ASSERT(__kmp_barrier_release_branch_bits[bt]);
           __kmp_dist_barrier_release(bt, this_thr, gtid, tid,
@@ -2100,6 +2200,13 @@ static int __kmp_barrier_template(enum barrier_type bt, int gtid, int is_split,
 int __kmp_barrier(enum barrier_type bt, int gtid, int is_split,
                   size_t reduce_size, void *reduce_data,
                   void (*reduce)(void *, void *)) {
+  if (UNLIKELY(__kmp_region_stats)) {
+    kmp_uint64 start = KMP_NOW();
+    int status = __kmp_barrier_template<>(bt, gtid, is_split, reduce_size,
+                                          reduce_data, reduce);
+    __kmp_threads[gtid]->th.th_region_wait += KMP_NOW() - start;
+    return status;
+  }
   return __kmp_barrier_template<>(bt, gtid, is_split, reduce_size, reduce_data,
                                   reduce);
 }
@@ -2138,7 +2245,11 @@ void __kmp_end_split_barrier(enum barrier_type bt, int gtid) {
 
   if (!team->t.t_serialized) {
     if (KMP_MASTER_GTID(gtid)) {
-      switch (__kmp_barrier_release_pattern[bt]) {
+      kmp_bar_pat_e release_pattern =
+          __kmp_barrier_is_adaptive(bt)
+              ? (kmp_bar_pat_e)team->t.t_bar[bt].b_pattern
+              : __kmp_barrier_release_pattern[bt];
+      switch (release_pattern) {
       case bp_dist_bar: {
         __kmp_dist_barrier_release(bt, this_thr, gtid, tid,
                                    FALSE USE_ITT_BUILD_ARG(NULL));
@@ -90,6 +90,164 @@ static inline int __kmp_get_monotonicity(ident_t *loc, enum sched_type schedule,
   return monotonicity;
 }
 
+// KMP_ADAPTIVE_SCHEDULE: tuning of schedule(auto) loops.
+// Loops are told apart by their ident. Each candidate below is used for
+// KMP_SCHED_TUNE_SAMPLES invocations of a loop, then the one with the lowest
+// cost per iteration is used for the next KMP_SCHED_TUNE_PERIOD invocations,
+// after which the candidates are measured again. The first thread to
+// initialize an invocation picks the candidate for the whole team, and the last
+// thread to finish it measures the time in between.
+#define KMP_SCHED_TUNE_SAMPLES 4
+#define KMP_SCHED_TUNE_PERIOD 256
+#define KMP_SCHED_TUNE_SIZE 256 // number of loops that can be tuned
+
+static const struct {
+  enum sched_type schedule;
+  int chunks_per_thread; // 0 keeps the chunk of the loop
+} __kmp_sched_tune_candidates[] = {
+    {kmp_sch_static_balanced, 0},
+    {kmp_sch_guided_analytical_chunked, 0},
+    {kmp_sch_dynamic_chunked, 4},
+    {kmp_sch_dynamic_chunked, 16},
+    {kmp_sch_dynamic_chunked, 64},
+};
+#define KMP_SCHED_TUNE_CANDIDATES                                              \
+  ((int)(sizeof(__kmp_sched_tune_candidates) /                                 \
+         sizeof(__kmp_sched_tune_candidates[0])))
+
+struct kmp_sched_tune {
+  std::atomic<ident_t *> loc;
+  std::atomic<kmp_int32> pick; // candidate for the next invocations
+  std::atomic<kmp_int32> updating; // an invocation is updating the fields below
+  kmp_int32 nproc; // team size the costs were measured with
+  kmp_int32 trial; // candidate being measured, or the number of candidates
+  kmp_int32 samples; // invocations with the current trial or pick
+  kmp_uint64 cost[KMP_SCHED_TUNE_CANDIDATES]; // best ticks per 256 iterations
+};
+
+static kmp_sched_tune __kmp_sched_tune_table[KMP_SCHED_TUNE_SIZE];
+
+// Returns the record of the loop at loc, adding it if needed, or NULL if the
+// table is full.
+static kmp_sched_tune *__kmp_sched_tune_find(ident_t *loc) {
+  kmp_uintptr_t hash = (kmp_uintptr_t)loc >> 3;
+  for (int probe = 0; probe < KMP_SCHED_TUNE_SIZE; ++probe) {
+    kmp_sched_tune *tune =
+        &__kmp_sched_tune_table[(hash + probe) % KMP_SCHED_TUNE_SIZE];
+    ident_t *cur = tune->loc.load(std::memory_order_acquire);
+    // On failure, cur is updated to the loop that took the record
+    if (cur == NULL &&
+        tune->loc.compare_exchange_strong(cur, loc, std::memory_order_acq_rel))
+      return tune;
+    if (cur == loc)
+      return tune;
+  }
+  return NULL;
+}
+
+// Picks the schedule and chunk of an invocation of a schedule(auto) loop by
+// the team. sh must be the buffer of the invocation.
+template <typename T>
+static void
+__kmp_dispatch_tune_init(ident_t *loc, kmp_info_t *th,
+                         dispatch_shared_info_template<T> volatile *sh,
+                         enum sched_type *schedule,
+                         typename traits_t<T>::signed_t *chunk, T lb, T ub,
+                         typename traits_t<T>::signed_t st) {
+  typedef typename traits_t<T>::unsigned_t UT;
+  typedef typename traits_t<T>::signed_t ST;
+  enum sched_type resolved = SCHEDULE_WITHOUT_MODIFIERS(*schedule) ==
+                                     kmp_sch_runtime
+                                 ? th->th.th_team->t.t_sched.r_sched_type
+                                 : *schedule;
+  if (loc == NULL || SCHEDULE_WITHOUT_MODIFIERS(resolved) != kmp_sch_auto)
+    return;
+  kmp_sched_tune *tune = __kmp_sched_tune_find(loc);
+  if (tune == NULL)
+    return;
+
+  UT tc;
+  if (st == 1)
+    tc = ub >= lb ? ub - lb + 1 : 0;
+  else if (st < 0)
+    tc = lb >= ub ? (UT)(lb - ub) / (-st) + 1 : 0;
+  else
+    tc = ub >= lb ? (UT)(ub - lb) / st + 1 : 0;
+
+  kmp_int32 pick = KMP_ATOMIC_LD_RLX(&tune->pick);
+  kmp_int32 claimed = KMP_COMPARE_AND_STORE_RET32(&sh->tune_pick, 0, pick + 1);
+  if (claimed == 0) {
+    sh->tune = tune;
+    sh->tune_tc = tc;
+    sh->tune_start = KMP_NOW();
+  } else {
+    pick = claimed - 1;
+  }
+
+  *schedule = (enum sched_type)(__kmp_sched_tune_candidates[pick].schedule |
+                                SCHEDULE_GET_MODIFIERS(resolved));
+  if (int chunks = __kmp_sched_tune_candidates[pick].chunks_per_thread) {
+    UT n = (UT)th->th.th_team_nproc * chunks;
+    *chunk = tc > n ? (ST)((tc + n - 1) / n) : 1;
+  }
+  KD_TRACE(100, ("__kmp_dispatch_tune_init: T#%d loc %p candidate %d\n",
+                 __kmp_gtid_from_thread(th), loc, pick));
+}
+
+// Adds the invocation of sh to the costs of its loop, called by the last
+// thread to finish it.
+template <typename T>
+static void
+__kmp_dispatch_tune_fini(kmp_info_t *th,
+                         dispatch_shared_info_template<T> volatile *sh) {
+  kmp_sched_tune *tune = sh->tune;
+  kmp_int32 pick = sh->tune_pick - 1;
+  kmp_uint64 cost = (KMP_NOW() - sh->tune_start) * 256 /
+                    (sh->tune_tc ? sh->tune_tc : 1);
+  sh->tune = NULL;
+  sh->tune_pick = 0;
+
+  // Concurrent invocations of the loop by other teams skip their sample
+  if (!__kmp_atomic_compare_store_acq(&tune->updating, 0, 1))
+    return;
+  kmp_int32 nproc = th->th.th_team_nproc;
+  if (tune->nproc != nproc) {
+    tune->nproc = nproc;
+    tune->trial = tune->samples = 0;
+  }
+  if (tune->trial == 0 && tune->samples == 0)
+    for (int i = 0; i < KMP_SCHED_TUNE_CANDIDATES; ++i)
+      tune->cost[i] = ~(kmp_uint64)0;
+
+  if (tune->trial < KMP_SCHED_TUNE_CANDIDATES) {
+    if (pick == tune->trial) {
+      if (cost < tune->cost[pick])
+        tune->cost[pick] = cost;
+      if (++tune->samples == KMP_SCHED_TUNE_SAMPLES) {
+        tune->samples = 0;
+        tune->trial++;
+      }
+    }
+    if (tune->trial < KMP_SCHED_TUNE_CANDIDATES) {
+      pick = tune->trial;
+    } else {
+      pick = 0;
+      for (int i = 1; i < KMP_SCHED_TUNE_CANDIDATES; ++i)
+        if (tune->cost[i] < tune->cost[pick])
+          pick = i;
+      KA_TRACE(20, ("__kmp_dispatch_tune_fini: loc %p nproc %d picks %d\n",
+                    (ident_t *)tune->loc, nproc, pick));
+    }
+  } else if (++tune->samples == KMP_SCHED_TUNE_PERIOD) {
+    tune->trial = tune->samples = 0;
+    pick = 0;
+  } else {
+    pick = KMP_ATOMIC_LD_RLX(&tune->pick);
+  }
+  KMP_ATOMIC_ST_RLX(&tune->pick, pick);
+  KMP_ATOMIC_ST_REL(&tune->updating, 0);
+}
+
 #if KMP_WEIGHTED_ITERATIONS_SUPPORTED
 // Return floating point number rounded to two decimal points
 static inline float __kmp_round_2decimal_val(float num) {
@@ -1080,6 +1238,8 @@ __kmp_dispatch_init(ident_t *loc, int gtid, enum sched_type schedule, T lb,
                      "sh->buffer_index:%d\n",
                      gtid, my_buffer_index, sh->buffer_index));
     }
+    if (__kmp_adaptive_schedule)
+      __kmp_dispatch_tune_init<T>(loc, th, sh, &schedule, &chunk, lb, ub, st);
   }
 
   __kmp_dispatch_init_algorithm(loc, gtid, pr, schedule, lb, ub, st,
@@ -2386,6 +2546,9 @@ static int __kmp_dispatch_next(ident_t *loc, int gtid, kmp_int32 *p_last,
           }
         }
 #endif
+        if (sh->tune)
+          __kmp_dispatch_tune_fini<T>(th, sh);
+
         /* NOTE: release shared buffer to be reused */
 
         KMP_MB(); /* Flush all pending memory write invalidates.  */
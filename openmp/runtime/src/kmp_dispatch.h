@@ -179,6 +179,10 @@ template <typename T> struct dispatch_shared_info_template {
   volatile kmp_int32 doacross_buf_idx; // teamwise index
   kmp_uint32 *doacross_flags; // array of iteration flags (0/1)
   kmp_int32 doacross_num_done; // count finished threads
+  struct kmp_sched_tune *tune;
+  kmp_uint64 tune_start;
+  kmp_uint64 tune_tc;
+  volatile kmp_int32 tune_pick;
 #if KMP_USE_HIER_SCHED
   kmp_hier_t<T> *hier;
 #endif
@@ -91,6 +91,7 @@ kmp_uint32 __kmp_barrier_gather_branch_bits[bs_last_barrier] = {0};
 kmp_uint32 __kmp_barrier_release_branch_bits[bs_last_barrier] = {0};
 kmp_bar_pat_e __kmp_barrier_gather_pattern[bs_last_barrier] = {bp_linear_bar};
 kmp_bar_pat_e __kmp_barrier_release_pattern[bs_last_barrier] = {bp_linear_bar};
+int __kmp_adaptive_barrier = FALSE; /* Time plain and reduction barriers */
 char const *__kmp_barrier_branch_bit_env_name[bs_last_barrier] = {
     "KMP_PLAIN_BARRIER", "KMP_FORKJOIN_BARRIER"
 #if KMP_FAST_REDUCTION_BARRIER
@@ -114,6 +115,10 @@ char const *__kmp_barrier_type_name[bs_last_barrier] = {"plain", "forkjoin"
 char const *__kmp_barrier_pattern_name[bp_last_bar] = {
     "linear", "tree", "hyper", "hierarchical", "dist"};
 
+int __kmp_region_stats = FALSE; /* Aggregate statistics per parallel region */
+char *__kmp_region_stats_file = NULL; /* Defaults to stderr */
+int __kmp_region_stats_signal = 0; /* No signal dumps the statistics */
+
 int __kmp_allThreadsSpecified = 0;
 size_t __kmp_align_alloc = CACHE_LINE;
 
@@ -149,6 +154,7 @@ enum sched_type __kmp_guided =
     kmp_sch_guided_iterative_chunked; /* default guided scheduling method */
 enum sched_type __kmp_auto =
     kmp_sch_guided_analytical_chunked; /* default auto scheduling method */
+int __kmp_adaptive_schedule = FALSE; /* tune schedule(auto) loops */
 #if KMP_USE_HIER_SCHED
 int __kmp_dispatch_hand_threading = 0;
 int __kmp_hier_max_units[kmp_hier_layer_e::LAYER_LAST + 1];
@@ -349,6 +355,7 @@ KMP_BUILD_ASSERT(sizeof(kmp_tasking_flags_t) == 4);
 
 int __kmp_task_stealing_constraint = 1; /* Constrain task stealing by default */
 int __kmp_enable_task_throttling = 1;
+int __kmp_task_stealing_locality = 1; /* Steal from nearby threads first */
 
 #ifdef DEBUG_SUSPEND
 int __kmp_suspend_count = 0;
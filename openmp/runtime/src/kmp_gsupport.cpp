@@ -480,6 +480,9 @@ static void __kmp_GOMP_fork_call(ident_t *loc, int gtid, unsigned num_threads,
 
   if (rc) {
     __kmp_run_before_invoked_task(gtid, tid, thr, team);
+    // Tell the regions apart by their task rather than by the wrapper
+    if (__kmp_region_stats)
+      thr->th.th_team->t.t_region_key = (void *)unwrapped_task;
   }
 
 #if OMPT_SUPPORT
@@ -0,0 +1,263 @@
+/*
+ * kmp_region_stats.cpp -- statistics aggregated per parallel region
+ */
+
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Unlike the statistics of kmp_stats.cpp, these are available in the release
+// runtime. With KMP_REGION_STATS set, the primary thread of each parallel
+// region adds its measurements to the entry of the region when it joins:
+// - the time from the fork to the end of the join barrier,
+// - the time every thread spent in its implicit task, whose spread is the
+//   imbalance of the region,
+// - the time threads spent in plain and reduction barriers inside the region,
+//   and in the join barrier,
+// - the number of explicit tasks threads executed, including those of nested
+//   regions.
+// Regions are identified by their source location and outlined function. The
+// statistics are written as JSON to KMP_REGION_STATS_FILE (stderr by default)
+// at exit, and when a parallel region joins after the process received
+// KMP_REGION_STATS_SIGNAL. Serialized regions and teams constructs are not
+// measured.
+
+#include "kmp.h"
+#include "kmp_lock.h"
+#include "kmp_str.h"
+
+#if KMP_OS_UNIX
+#include <signal.h>
+#endif
+#if KMP_OS_LINUX
+#include <dlfcn.h>
+#endif
+
+// Number of entries of the table, a power of 2. The regions that do not fit
+// are only counted.
+#define KMP_REGION_STATS_SIZE 1024
+
+typedef struct kmp_region_stats_entry {
+  void *key; // outlined function, NULL when the entry is free
+  ident_t *loc;
+  kmp_uint64 calls;
+  kmp_uint64 threads; // sum of the team sizes
+  kmp_uint64 time; // sum of the region times
+  kmp_uint64 time_max;
+  kmp_uint64 work; // sum of the implicit task times of all threads
+  kmp_uint64 work_avg; // sum of the average implicit task time of each call
+  kmp_uint64 work_max; // sum of the longest implicit task time of each call
+  kmp_uint64 barrier_wait;
+  kmp_uint64 join_wait;
+  kmp_uint64 tasks;
+} kmp_region_stats_entry_t;
+
+static kmp_region_stats_entry_t *__kmp_region_stats_table = NULL;
+static kmp_uint64 __kmp_region_stats_dropped = 0;
+static kmp_bootstrap_lock_t __kmp_region_stats_lock =
+    KMP_BOOTSTRAP_LOCK_INITIALIZER(__kmp_region_stats_lock);
+#if KMP_OS_UNIX
+static volatile sig_atomic_t __kmp_region_stats_requested = 0;
+
+static void __kmp_region_stats_handler(int signum) {
+  __kmp_region_stats_requested = 1;
+}
+#endif
+
+// Converts ticks of KMP_NOW() to nanoseconds.
+static kmp_uint64 __kmp_region_stats_nsec(kmp_uint64 ticks) {
+#if KMP_OS_UNIX && (KMP_ARCH_X86 || KMP_ARCH_X86_64)
+  return __kmp_ticks_per_usec ? ticks * 1000 / __kmp_ticks_per_usec : ticks;
+#else
+  return ticks;
+#endif
+}
+
+static void __kmp_region_stats_print_string(FILE *f, char const *str) {
+  fputc('"', f);
+  for (; *str; ++str) {
+    if (*str == '"' || *str == '\\')
+      fprintf(f, "\\%c", *str);
+    else if ((unsigned char)*str < ' ')
+      fprintf(f, "\\u%04x", (unsigned char)*str);
+    else
+      fputc(*str, f);
+  }
+  fputc('"', f);
+}
+
+// Writes the table as JSON. The lock must be held.
+static void __kmp_region_stats_print(void) {
+  kmp_safe_raii_file_t out;
+  if (!__kmp_region_stats_file ||
+      out.try_open(__kmp_region_stats_file, "w") != 0)
+    out.set_stderr();
+  FILE *f = out;
+
+  fprintf(f, "{\n  \"dropped_calls\": %llu,\n  \"regions\": [",
+          (unsigned long long)__kmp_region_stats_dropped);
+  bool first = true;
+  for (int i = 0; i < KMP_REGION_STATS_SIZE; ++i) {
+    kmp_region_stats_entry_t *entry = &__kmp_region_stats_table[i];
+    if (!entry->key)
+      continue;
+    kmp_str_loc_t loc =
+        __kmp_str_loc_init(entry->loc ? entry->loc->psource : NULL, false);
+    char const *func = loc.func;
+    if (func && strcmp(func, "unknown") == 0)
+      func = NULL;
+#if KMP_OS_LINUX
+    Dl_info info;
+    if (!func && dladdr(entry->key, &info) && info.dli_sname)
+      func = info.dli_sname;
+#endif
+    fprintf(f, "%s\n    {\"address\": \"%p\", \"function\": ", first ? "" : ",",
+            entry->key);
+    first = false;
+    if (func)
+      __kmp_region_stats_print_string(f, func);
+    else
+      fprintf(f, "null");
+    fprintf(f, ", \"file\": ");
+    if (loc.file && strcmp(loc.file, "unknown") != 0)
+      __kmp_region_stats_print_string(f, loc.file);
+    else
+      fprintf(f, "null");
+    int line = loc.line;
+    __kmp_str_loc_free(&loc);
+
+    double imbalance =
+        entry->work_max ? 1.0 - (double)entry->work_avg / entry->work_max : 0.0;
+    fprintf(f,
+            ", \"line\": %d, \"calls\": %llu, \"threads\": %llu, "
+            "\"time_ns\": %llu, \"time_max_ns\": %llu, \"work_ns\": %llu, "
+            "\"imbalance\": %.4f, \"barrier_wait_ns\": %llu, "
+            "\"join_wait_ns\": %llu, \"tasks\": %llu}",
+            line, (unsigned long long)entry->calls,
+            (unsigned long long)entry->threads,
+            (unsigned long long)__kmp_region_stats_nsec(entry->time),
+            (unsigned long long)__kmp_region_stats_nsec(entry->time_max),
+            (unsigned long long)__kmp_region_stats_nsec(entry->work), imbalance,
+            (unsigned long long)__kmp_region_stats_nsec(entry->barrier_wait),
+            (unsigned long long)__kmp_region_stats_nsec(entry->join_wait),
+            (unsigned long long)entry->tasks);
+  }
+  fprintf(f, "\n  ]\n}\n");
+  fflush(f);
+}
+
+void __kmp_region_stats_init(void) {
+  KMP_DEBUG_ASSERT(__kmp_region_stats);
+  __kmp_region_stats_table = (kmp_region_stats_entry_t *)__kmp_allocate(
+      KMP_REGION_STATS_SIZE * sizeof(kmp_region_stats_entry_t));
+#if KMP_OS_UNIX
+  if (__kmp_region_stats_signal > 0) {
+    struct sigaction act;
+    memset(&act, 0, sizeof(act));
+    act.sa_handler = __kmp_region_stats_handler;
+    sigemptyset(&act.sa_mask);
+    act.sa_flags = SA_RESTART;
+    sigaction(__kmp_region_stats_signal, &act, NULL);
+  }
+#endif
+}
+
+// Called by the primary thread before it releases the workers of the team.
+void __kmp_region_stats_fork(kmp_info_t *primary, kmp_team_t *team) {
+  team->t.t_region_key = (void *)team->t.t_pkfn;
+  team->t.t_region_start = KMP_NOW();
+  // The primary thread keeps counting for the enclosing region.
+  team->t.t_region_wait0 = primary->th.th_region_wait0;
+  team->t.t_region_tasks0 = primary->th.th_region_tasks0;
+  primary->th.th_region_wait0 = primary->th.th_region_wait;
+  primary->th.th_region_tasks0 = primary->th.th_region_tasks;
+}
+
+// Called by the primary thread after the join barrier, arrival being the time
+// it reached the barrier.
+void __kmp_region_stats_join(kmp_info_t *primary, kmp_team_t *team,
+                             kmp_uint64 arrival) {
+  kmp_uint64 end = KMP_NOW();
+  if (!__kmp_region_stats_table ||
+      team->t.t_pkfn == (microtask_t)__kmp_teams_master) {
+    primary->th.th_region_wait0 = team->t.t_region_wait0;
+    primary->th.th_region_tasks0 = team->t.t_region_tasks0;
+    return;
+  }
+
+  int nproc = team->t.t_nproc;
+  kmp_uint64 time = end - team->t.t_region_start;
+  kmp_uint64 work = arrival - team->t.t_region_start;
+  kmp_uint64 work_max = work;
+  kmp_uint64 barrier_wait = 0;
+  kmp_uint64 tasks = 0;
+  for (int i = 0; i < nproc; ++i) {
+    kmp_info_t *thread = team->t.t_threads[i];
+    if (i > 0) {
+      kmp_uint64 busy = thread->th.th_region_busy;
+      work += busy;
+      if (busy > work_max)
+        work_max = busy;
+    }
+    barrier_wait += thread->th.th_region_wait - thread->th.th_region_wait0;
+    tasks += thread->th.th_region_tasks - thread->th.th_region_tasks0;
+  }
+  kmp_uint64 join_wait = nproc * time > work ? nproc * time - work : 0;
+  primary->th.th_region_wait0 = team->t.t_region_wait0;
+  primary->th.th_region_tasks0 = team->t.t_region_tasks0;
+
+  void *key = team->t.t_region_key;
+  ident_t *loc = team->t.t_ident;
+  kmp_uintptr_t hash = ((kmp_uintptr_t)key >> 4) ^ ((kmp_uintptr_t)loc >> 3);
+  __kmp_acquire_bootstrap_lock(&__kmp_region_stats_lock);
+  kmp_region_stats_entry_t *entry = NULL;
+  for (int probe = 0; probe < KMP_REGION_STATS_SIZE; ++probe) {
+    kmp_region_stats_entry_t *e =
+        &__kmp_region_stats_table[(hash + probe) & (KMP_REGION_STATS_SIZE - 1)];
+    if (!e->key) {
+      e->key = key;
+      e->loc = loc;
+    } else if (e->key != key || e->loc != loc) {
+      continue;
+    }
+    entry = e;
+    break;
+  }
+  if (entry) {
+    entry->calls++;
+    entry->threads += nproc;
+    entry->time += time;
+    if (time > entry->time_max)
+      entry->time_max = time;
+    entry->work += work;
+    entry->work_avg += work / nproc;
+    entry->work_max += work_max;
+    entry->barrier_wait += barrier_wait;
+    entry->join_wait += join_wait;
+    entry->tasks += tasks;
+  } else {
+    __kmp_region_stats_dropped++;
+  }
+#if KMP_OS_UNIX
+  if (__kmp_region_stats_requested) {
+    __kmp_region_stats_requested = 0;
+    __kmp_region_stats_print();
+  }
+#endif
+  __kmp_release_bootstrap_lock(&__kmp_region_stats_lock);
+}
+
+void __kmp_region_stats_fini(void) {
+  if (!__kmp_region_stats_table)
+    return;
+  __kmp_acquire_bootstrap_lock(&__kmp_region_stats_lock);
+  __kmp_region_stats_print();
+  __kmp_free(__kmp_region_stats_table);
+  __kmp_region_stats_table = NULL;
+  __kmp_region_stats_dropped = 0;
+  __kmp_release_bootstrap_lock(&__kmp_region_stats_lock);
+}
@@ -7273,6 +7273,9 @@ static void __kmp_do_serial_initialize(void) {
 
   __kmp_env_initialize(NULL);
 
+  if (__kmp_region_stats)
+    __kmp_region_stats_init();
+
 #if KMP_HAVE_MWAIT || KMP_HAVE_UMWAIT
   __kmp_user_level_mwait_init();
 #endif
@@ -7734,6 +7737,13 @@ int __kmp_invoke_task_func(int gtid) {
   KMP_SET_THREAD_STATE(IMPLICIT_TASK);
 #endif
 
+  kmp_uint64 region_start = 0;
+  if (__kmp_region_stats) {
+    this_thr->th.th_region_wait0 = this_thr->th.th_region_wait;
+    this_thr->th.th_region_tasks0 = this_thr->th.th_region_tasks;
+    region_start = KMP_NOW();
+  }
+
   rc = __kmp_invoke_microtask((microtask_t)TCR_SYNC_PTR(team->t.t_pkfn), gtid,
                               tid, (int)team->t.t_argc, (void **)team->t.t_argv
 #if OMPT_SUPPORT
@@ -7746,6 +7756,9 @@ int __kmp_invoke_task_func(int gtid) {
   this_thr->th.ompt_thread_info.parallel_flags = ompt_parallel_team;
 #endif
 
+  if (__kmp_region_stats)
+    this_thr->th.th_region_busy = KMP_NOW() - region_start;
+
 #if KMP_STATS_ENABLED
   if (previous_state == stats_state_e::TEAMS_REGION) {
     KMP_SET_THREAD_STATE(previous_state);
@@ -8093,6 +8106,9 @@ void __kmp_internal_fork(ident_t *id, int gtid, kmp_team_t *team) {
   }
 #endif /* KMP_DEBUG */
 
+  if (__kmp_region_stats)
+    __kmp_region_stats_fork(this_thr, team);
+
   /* release the worker threads so they may begin working */
   __kmp_fork_barrier(gtid, 0);
 }
@@ -8122,7 +8138,10 @@ void __kmp_internal_join(ident_t *id, int gtid, kmp_team_t *team) {
                    __kmp_threads[gtid]->th.th_team_nproc == team->t.t_nproc);
 #endif /* KMP_DEBUG */
 
+  kmp_uint64 region_arrival = __kmp_region_stats ? KMP_NOW() : 0;
   __kmp_join_barrier(gtid); /* wait for everyone */
+  if (__kmp_region_stats)
+    __kmp_region_stats_join(this_thr, team, region_arrival);
 #if OMPT_SUPPORT
   ompt_state_t ompt_state = this_thr->th.ompt_thread_info.state;
   if (ompt_enabled.enabled &&
@@ -8369,6 +8388,7 @@ void __kmp_cleanup(void) {
 #if KMP_STATS_ENABLED
   __kmp_stats_fini();
 #endif
+  __kmp_region_stats_fini();
 
   KA_TRACE(10, ("__kmp_cleanup: exit\n"));
 }
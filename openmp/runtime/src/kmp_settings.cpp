@@ -1849,6 +1849,19 @@ static void __kmp_stg_print_barrier_pattern(kmp_str_buf_t *buffer,
   }
 } // __kmp_stg_print_barrier_pattern
 
+// ----------------------------------------------------------------------------
+// KMP_ADAPTIVE_BARRIER
+
+static void __kmp_stg_parse_adaptive_barrier(char const *name,
+                                             char const *value, void *data) {
+  __kmp_stg_parse_bool(name, value, &__kmp_adaptive_barrier);
+} // __kmp_stg_parse_adaptive_barrier
+
+static void __kmp_stg_print_adaptive_barrier(kmp_str_buf_t *buffer,
+                                             char const *name, void *data) {
+  __kmp_stg_print_bool(buffer, name, __kmp_adaptive_barrier);
+} // __kmp_stg_print_adaptive_barrier
+
 // -----------------------------------------------------------------------------
 // KMP_ABORT_DELAY
 
@@ -1893,6 +1906,50 @@ static void __kmp_stg_print_cpuinfo_file(kmp_str_buf_t *buffer,
 #endif
 } //__kmp_stg_print_cpuinfo_file
 
+// -----------------------------------------------------------------------------
+// KMP_REGION_STATS, KMP_REGION_STATS_FILE, KMP_REGION_STATS_SIGNAL
+
+static void __kmp_stg_parse_region_stats(char const *name, char const *value,
+                                         void *data) {
+  __kmp_stg_parse_bool(name, value, &__kmp_region_stats);
+} // __kmp_stg_parse_region_stats
+
+static void __kmp_stg_print_region_stats(kmp_str_buf_t *buffer,
+                                         char const *name, void *data) {
+  __kmp_stg_print_bool(buffer, name, __kmp_region_stats);
+} // __kmp_stg_print_region_stats
+
+static void __kmp_stg_parse_region_stats_file(char const *name,
+                                              char const *value, void *data) {
+  __kmp_stg_parse_str(name, value, &__kmp_region_stats_file);
+} // __kmp_stg_parse_region_stats_file
+
+static void __kmp_stg_print_region_stats_file(kmp_str_buf_t *buffer,
+                                              char const *name, void *data) {
+  if (__kmp_env_format) {
+    KMP_STR_BUF_PRINT_NAME;
+  } else {
+    __kmp_str_buf_print(buffer, "   %s", name);
+  }
+  if (__kmp_region_stats_file) {
+    __kmp_str_buf_print(buffer, "='%s'\n", __kmp_region_stats_file);
+  } else {
+    __kmp_str_buf_print(buffer, ": %s\n", KMP_I18N_STR(NotDefined));
+  }
+} // __kmp_stg_print_region_stats_file
+
+#if KMP_OS_UNIX
+static void __kmp_stg_parse_region_stats_signal(char const *name,
+                                                char const *value, void *data) {
+  __kmp_stg_parse_int(name, value, 0, NSIG - 1, &__kmp_region_stats_signal);
+} // __kmp_stg_parse_region_stats_signal
+
+static void __kmp_stg_print_region_stats_signal(kmp_str_buf_t *buffer,
+                                                char const *name, void *data) {
+  __kmp_stg_print_int(buffer, name, __kmp_region_stats_signal);
+} // __kmp_stg_print_region_stats_signal
+#endif // KMP_OS_UNIX
+
 // -----------------------------------------------------------------------------
 // KMP_FORCE_REDUCTION, KMP_DETERMINISTIC_REDUCTION
 
@@ -4479,6 +4536,19 @@ static void __kmp_stg_print_omp_schedule(kmp_str_buf_t *buffer,
   }
 } // __kmp_stg_print_omp_schedule
 
+// -----------------------------------------------------------------------------
+// KMP_ADAPTIVE_SCHEDULE
+
+static void __kmp_stg_parse_adaptive_schedule(char const *name,
+                                              char const *value, void *data) {
+  __kmp_stg_parse_bool(name, value, &__kmp_adaptive_schedule);
+} // __kmp_stg_parse_adaptive_schedule
+
+static void __kmp_stg_print_adaptive_schedule(kmp_str_buf_t *buffer,
+                                              char const *name, void *data) {
+  __kmp_stg_print_bool(buffer, name, __kmp_adaptive_schedule);
+} // __kmp_stg_print_adaptive_schedule
+
 #if KMP_USE_HIER_SCHED
 // -----------------------------------------------------------------------------
 // KMP_DISP_HAND_THREAD
@@ -5354,6 +5424,21 @@ static void __kmp_stg_print_task_throttling(kmp_str_buf_t *buffer,
   __kmp_stg_print_bool(buffer, name, __kmp_enable_task_throttling);
 } // __kmp_stg_print_task_throttling
 
+// -----------------------------------------------------------------------------
+// KMP_TASK_STEALING_LOCALITY
+
+static void __kmp_stg_parse_task_stealing_locality(char const *name,
+                                                   char const *value,
+                                                   void *data) {
+  __kmp_stg_parse_bool(name, value, &__kmp_task_stealing_locality);
+} // __kmp_stg_parse_task_stealing_locality
+
+static void __kmp_stg_print_task_stealing_locality(kmp_str_buf_t *buffer,
+                                                   char const *name,
+                                                   void *data) {
+  __kmp_stg_print_bool(buffer, name, __kmp_task_stealing_locality);
+} // __kmp_stg_print_task_stealing_locality
+
 #if KMP_HAVE_MWAIT || KMP_HAVE_UMWAIT
 // -----------------------------------------------------------------------------
 // KMP_USER_LEVEL_MWAIT
@@ -5635,11 +5720,21 @@ static kmp_setting_t __kmp_stg_table[] = {
     {"KMP_REDUCTION_BARRIER_PATTERN", __kmp_stg_parse_barrier_pattern,
      __kmp_stg_print_barrier_pattern, NULL, 0, 0},
 #endif
+    {"KMP_ADAPTIVE_BARRIER", __kmp_stg_parse_adaptive_barrier,
+     __kmp_stg_print_adaptive_barrier, NULL, 0, 0},
 
     {"KMP_ABORT_DELAY", __kmp_stg_parse_abort_delay,
      __kmp_stg_print_abort_delay, NULL, 0, 0},
     {"KMP_CPUINFO_FILE", __kmp_stg_parse_cpuinfo_file,
      __kmp_stg_print_cpuinfo_file, NULL, 0, 0},
+    {"KMP_REGION_STATS", __kmp_stg_parse_region_stats,
+     __kmp_stg_print_region_stats, NULL, 0, 0},
+    {"KMP_REGION_STATS_FILE", __kmp_stg_parse_region_stats_file,
+     __kmp_stg_print_region_stats_file, NULL, 0, 0},
+#if KMP_OS_UNIX
+    {"KMP_REGION_STATS_SIGNAL", __kmp_stg_parse_region_stats_signal,
+     __kmp_stg_print_region_stats_signal, NULL, 0, 0},
+#endif
     {"KMP_FORCE_REDUCTION", __kmp_stg_parse_force_reduction,
      __kmp_stg_print_force_reduction, NULL, 0, 0},
     {"KMP_DETERMINISTIC_REDUCTION", __kmp_stg_parse_force_reduction,
@@ -5687,6 +5782,8 @@ static kmp_setting_t __kmp_stg_table[] = {
      0, 0},
     {"OMP_SCHEDULE", __kmp_stg_parse_omp_schedule, __kmp_stg_print_omp_schedule,
      NULL, 0, 0},
+    {"KMP_ADAPTIVE_SCHEDULE", __kmp_stg_parse_adaptive_schedule,
+     __kmp_stg_print_adaptive_schedule, NULL, 0, 0},
 #if KMP_USE_HIER_SCHED
     {"KMP_DISP_HAND_THREAD", __kmp_stg_parse_kmp_hand_thread,
      __kmp_stg_print_kmp_hand_thread, NULL, 0, 0},
@@ -5743,6 +5840,8 @@ static kmp_setting_t __kmp_stg_table[] = {
 #endif
     {"KMP_ENABLE_TASK_THROTTLING", __kmp_stg_parse_task_throttling,
      __kmp_stg_print_task_throttling, NULL, 0, 0},
+    {"KMP_TASK_STEALING_LOCALITY", __kmp_stg_parse_task_stealing_locality,
+     __kmp_stg_print_task_stealing_locality, NULL, 0, 0},
 
     {"OMP_DISPLAY_ENV", __kmp_stg_parse_omp_display_env,
      __kmp_stg_print_omp_display_env, NULL, 0, 0},
@@ -162,6 +162,8 @@ enum stats_state_e {
   macro (OMP_task_join_bar, 0, arg)                                            \
   macro (OMP_task_plain_bar, 0, arg)                                           \
   macro (OMP_taskloop_scheduling, 0, arg)                                      \
+  macro (OMP_task_deps, 0, arg)                                                \
+  macro (OMP_task_release_deps, 0, arg)                                        \
   macro (OMP_plain_barrier, stats_flags_e::logEvent, arg)                      \
   macro (OMP_idle, stats_flags_e::logEvent, arg)                               \
   macro (OMP_fork_barrier, stats_flags_e::logEvent, arg)                       \
@@ -181,6 +183,8 @@ enum stats_state_e {
          stats_flags_e::noUnits | stats_flags_e::noTotal, arg)                 \
   macro (OMP_distribute_iterations,                                            \
          stats_flags_e::noUnits | stats_flags_e::noTotal, arg)                 \
+  macro (OMP_task_predecessors,                                                \
+         stats_flags_e::noUnits | stats_flags_e::noTotal, arg)                 \
   KMP_FOREACH_DEVELOPER_TIMER(macro, arg)
 // clang-format on
 
@@ -216,6 +220,10 @@ enum stats_state_e {
 //                           construct
 // OMP_taskloop_scheduling -- Time spent scheduling tasks inside a taskloop
 //                            construct
+// OMP_task_deps          -- Time spent linking a task with dependences to its
+//                           predecessors
+// OMP_task_release_deps  -- Time spent releasing the successors of a finished
+//                           task
 // OMP_plain_barrier      -- Time spent in a #pragma omp barrier construct or
 //                           inside implicit barrier at end of worksharing
 //                           construct
@@ -232,6 +240,8 @@ enum stats_state_e {
 //                               statically scheduled loops
 // OMP_loop_dynamic_iterations -- Number of iterations thread is assigned for
 //                                dynamically scheduled loops
+// OMP_task_predecessors  -- Number of unfinished tasks a task with dependences
+//                           waits for when it is created
 
 #if (KMP_DEVELOPER_STATS)
 // Timers which are of interest to runtime library developers, not end users.
@@ -25,8 +25,6 @@
 // TODO: don't use atomic ref counters for stack-allocated nodes.
 // TODO: find an alternate to atomic refs for heap-allocated nodes?
 // TODO: Finish graph output support
-// TODO: kmp_lock_t seems a tad to big (and heavy weight) for this. Check other
-// runtime locks
 // TODO: Any ITT support needed?
 
 #ifdef KMP_SUPPORT_GRAPH_OUTPUT
@@ -34,13 +32,12 @@ static std::atomic<kmp_int32> kmp_node_id_seed = 0;
 #endif
 
 static void __kmp_init_node(kmp_depnode_t *node, bool on_stack) {
-  node->dn.successors = NULL;
+  KMP_ATOMIC_ST_RLX(&node->dn.successors, (kmp_depnode_list_t *)NULL);
   node->dn.task = NULL; // will point to the right task
   // once dependences have been processed
   for (int i = 0; i < MAX_MTX_DEPS; ++i)
     node->dn.mtx_locks[i] = NULL;
   node->dn.mtx_num_locks = 0;
-  __kmp_init_lock(&node->dn.lock);
   // Init creates the first reference.  Bit 0 indicates that this node
   // resides on the stack.  The refcount is incremented and decremented in
   // steps of two, maintaining use of even numbers for heap nodes and odd
@@ -219,6 +216,28 @@ static kmp_depnode_list_t *__kmp_add_node(kmp_info_t *thread,
   return new_head;
 }
 
+// Claims the successors of dep to link a new one and returns them, or returns
+// KMP_DEPNODE_CLOSED if the task of dep has finished. The claim is released
+// by storing the updated list. Successors are only linked by the thread
+// processing the dependences of the siblings of dep, so this normally races
+// with __kmp_release_deps alone.
+static inline kmp_depnode_list_t *
+__kmp_depnode_claim_successors(kmp_depnode_t *dep) {
+  kmp_depnode_list_t *head = KMP_ATOMIC_LD_RLX(&dep->dn.successors);
+  for (;;) {
+    if (head == KMP_DEPNODE_CLOSED)
+      return head;
+    if (head == KMP_DEPNODE_LINKING) {
+      KMP_CPU_PAUSE();
+      head = KMP_ATOMIC_LD_RLX(&dep->dn.successors);
+    } else if (dep->dn.successors.compare_exchange_weak(
+                   head, KMP_DEPNODE_LINKING, std::memory_order_acquire,
+                   std::memory_order_relaxed)) {
+      return head;
+    }
+  }
+}
+
 static inline void __kmp_track_dependence(kmp_int32 gtid, kmp_depnode_t *source,
                                           kmp_depnode_t *sink,
                                           kmp_task_t *sink_task) {
@@ -247,6 +266,8 @@ static inline void __kmp_track_dependence(kmp_int32 gtid, kmp_depnode_t *source,
         kmp_int32 *old_succ_ids = source_info->successors;
         kmp_int32 *new_succ_ids = (kmp_int32 *)__kmp_allocate(
             source_info->successors_size * sizeof(kmp_int32));
+        KMP_MEMCPY(new_succ_ids, old_succ_ids,
+                   source_info->nsuccessors * sizeof(kmp_int32));
         source_info->successors = new_succ_ids;
         __kmp_free(old_succ_ids);
       }
@@ -296,7 +317,9 @@ kmp_base_depnode_t *__kmpc_task_get_depnode(kmp_task_t *task) {
 
 kmp_depnode_list_t *__kmpc_task_get_successors(kmp_task_t *task) {
   kmp_taskdata_t *td = KMP_TASK_TO_TASKDATA(task);
-  return td->td_depnode->dn.successors;
+  kmp_depnode_list_t *successors =
+      KMP_ATOMIC_LD_ACQ(&td->td_depnode->dn.successors);
+  return successors == KMP_DEPNODE_CLOSED ? NULL : successors;
 }
 
 static inline kmp_int32
@@ -320,22 +343,22 @@ __kmp_depnode_link_successor(kmp_int32 gtid, kmp_info_t *thread,
     }
 #endif
     if (dep->dn.task) {
-      KMP_ACQUIRE_DEPNODE(gtid, dep);
-      if (dep->dn.task) {
-        if (!dep->dn.successors || dep->dn.successors->node != node) {
+      kmp_depnode_list_t *successors = __kmp_depnode_claim_successors(dep);
+      if (successors != KMP_DEPNODE_CLOSED) {
+        if (!successors || successors->node != node) {
 #if OMPX_TASKGRAPH
           if (!(__kmp_tdg_is_recording(tdg_status)) && task)
 #endif
             __kmp_track_dependence(gtid, dep, node, task);
-          dep->dn.successors = __kmp_add_node(thread, dep->dn.successors, node);
+          successors = __kmp_add_node(thread, successors, node);
           KA_TRACE(40, ("__kmp_process_deps: T#%d adding dependence from %p to "
                         "%p\n",
                         gtid, KMP_TASK_TO_TASKDATA(dep->dn.task),
                         KMP_TASK_TO_TASKDATA(task)));
           npredecessors++;
         }
+        KMP_ATOMIC_ST_REL(&dep->dn.successors, successors);
       }
-      KMP_RELEASE_DEPNODE(gtid, dep);
     }
   }
   return npredecessors;
@@ -362,14 +385,14 @@ static inline kmp_int32 __kmp_depnode_link_successor(kmp_int32 gtid,
 #endif
   if (sink->dn.task) {
     // synchronously add source to sink' list of successors
-    KMP_ACQUIRE_DEPNODE(gtid, sink);
-    if (sink->dn.task) {
-      if (!sink->dn.successors || sink->dn.successors->node != source) {
+    kmp_depnode_list_t *successors = __kmp_depnode_claim_successors(sink);
+    if (successors != KMP_DEPNODE_CLOSED) {
+      if (!successors || successors->node != source) {
 #if OMPX_TASKGRAPH
         if (!(__kmp_tdg_is_recording(tdg_status)) && task)
 #endif
           __kmp_track_dependence(gtid, sink, source, task);
-        sink->dn.successors = __kmp_add_node(thread, sink->dn.successors, source);
+        successors = __kmp_add_node(thread, successors, source);
         KA_TRACE(40, ("__kmp_process_deps: T#%d adding dependence from %p to "
                     "%p\n",
                     gtid, KMP_TASK_TO_TASKDATA(sink->dn.task),
@@ -389,8 +412,8 @@ static inline kmp_int32 __kmp_depnode_link_successor(kmp_int32 gtid,
 #endif
       npredecessors++;
       }
+      KMP_ATOMIC_ST_REL(&sink->dn.successors, successors);
     }
-    KMP_RELEASE_DEPNODE(gtid, sink);
   }
   return npredecessors;
 }
@@ -587,6 +610,7 @@ static bool __kmp_check_deps(kmp_int32 gtid, kmp_depnode_t *node,
                 "possibly aliased dependences, %d non-aliased dependences : "
                 "dep_barrier=%d .\n",
                 gtid, taskdata, ndeps, ndeps_noalias, dep_barrier));
+  KMP_TIME_PARTITIONED_BLOCK(OMP_task_deps);
 
   // Filter deps in dep_list
   // TODO: Different algorithm for large dep_list ( > 10 ? )
@@ -642,6 +666,7 @@ static bool __kmp_check_deps(kmp_int32 gtid, kmp_depnode_t *node,
   } else { // omp_all_memory dependence
     npredecessors = __kmp_process_dep_all(gtid, node, *hash, dep_barrier, task);
   }
+  KMP_COUNT_VALUE(OMP_task_predecessors, npredecessors);
 
   node->dn.task = task;
   KMP_MB();
@@ -695,44 +720,8 @@ kmp_int32 __kmpc_omp_task_with_deps(ident_t *loc_ref, kmp_int32 gtid,
 #if OMPX_TASKGRAPH
   // record TDG with deps
   if (new_taskdata->is_taskgraph &&
-      __kmp_tdg_is_recording(new_taskdata->tdg->tdg_status)) {
-    kmp_tdg_info_t *tdg = new_taskdata->tdg;
-    // extend record_map if needed
-    if (new_taskdata->td_task_id >= tdg->map_size) {
-      __kmp_acquire_bootstrap_lock(&tdg->graph_lock);
-      if (new_taskdata->td_task_id >= tdg->map_size) {
-        kmp_uint old_size = tdg->map_size;
-        kmp_uint new_size = old_size * 2;
-        kmp_node_info_t *old_record = tdg->record_map;
-        kmp_node_info_t *new_record = (kmp_node_info_t *)__kmp_allocate(
-            new_size * sizeof(kmp_node_info_t));
-        KMP_MEMCPY(new_record, tdg->record_map,
-                   old_size * sizeof(kmp_node_info_t));
-        tdg->record_map = new_record;
-
-        __kmp_free(old_record);
-
-        for (kmp_int i = old_size; i < new_size; i++) {
-          kmp_int32 *successorsList = (kmp_int32 *)__kmp_allocate(
-              __kmp_successors_size * sizeof(kmp_int32));
-          new_record[i].task = nullptr;
-          new_record[i].successors = successorsList;
-          new_record[i].nsuccessors = 0;
-          new_record[i].npredecessors = 0;
-          new_record[i].successors_size = __kmp_successors_size;
-          KMP_ATOMIC_ST_REL(&new_record[i].npredecessors_counter, 0);
-        }
-        // update the size at the end, so that we avoid other
-        // threads use old_record while map_size is already updated
-        tdg->map_size = new_size;
-      }
-      __kmp_release_bootstrap_lock(&tdg->graph_lock);
-    }
-    tdg->record_map[new_taskdata->td_tdg_task_id].task = new_task;
-    tdg->record_map[new_taskdata->td_tdg_task_id].parent_task =
-        new_taskdata->td_parent;
-    KMP_ATOMIC_INC(&tdg->num_tasks);
-  }
+      __kmp_tdg_is_recording(new_taskdata->tdg->tdg_status))
+    __kmp_tdg_record_task(new_taskdata->tdg, new_task);
 #endif
 #if OMPT_SUPPORT
   if (ompt_enabled.enabled) {
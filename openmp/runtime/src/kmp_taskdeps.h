@@ -14,9 +14,32 @@
 #define KMP_TASKDEPS_H
 
 #include "kmp.h"
-
-#define KMP_ACQUIRE_DEPNODE(gtid, n) __kmp_acquire_lock(&(n)->dn.lock, (gtid))
-#define KMP_RELEASE_DEPNODE(gtid, n) __kmp_release_lock(&(n)->dn.lock, (gtid))
+#include "kmp_stats.h"
+
+// Besides pointing to the list, the successors of a depnode are either closed
+// once its task has finished, so that no more successors are linked to it, or
+// linking while a successor is being added. This takes the place of a lock per
+// depnode, with a single atomic operation on either side when uncontended.
+#define KMP_DEPNODE_CLOSED ((kmp_depnode_list_t *)1)
+#define KMP_DEPNODE_LINKING ((kmp_depnode_list_t *)2)
+
+// Replaces the successors of node with value and returns them, waiting for a
+// successor being linked to be done.
+static inline kmp_depnode_list_t *
+__kmp_depnode_exchange_successors(kmp_depnode_t *node,
+                                  kmp_depnode_list_t *value) {
+  kmp_depnode_list_t *head = KMP_ATOMIC_LD_RLX(&node->dn.successors);
+  for (;;) {
+    if (head == KMP_DEPNODE_LINKING) {
+      KMP_CPU_PAUSE();
+      head = KMP_ATOMIC_LD_RLX(&node->dn.successors);
+    } else if (node->dn.successors.compare_exchange_weak(
+                   head, value, std::memory_order_acq_rel,
+                   std::memory_order_relaxed)) {
+      return head;
+    }
+  }
+}
 
 static inline void __kmp_node_deref(kmp_info_t *thread, kmp_depnode_t *node) {
   if (!node)
@@ -138,19 +161,24 @@ static inline void __kmp_release_deps(kmp_int32 gtid, kmp_taskdata_t *task) {
 
   KA_TRACE(20, ("__kmp_release_deps: T#%d notifying successors of task %p.\n",
                 gtid, task));
+  KMP_TIME_PARTITIONED_BLOCK(OMP_task_release_deps);
 
-  KMP_ACQUIRE_DEPNODE(gtid, node);
+  // Mark this task as finished, so no new dependencies are generated, and take
+  // the successors linked so far.
+  kmp_depnode_list_t *successors;
 #if OMPX_TASKGRAPH
-  if (!task->is_taskgraph ||
-      (task->is_taskgraph && !__kmp_tdg_is_recording(task->tdg->tdg_status)))
+  if (task->is_taskgraph && __kmp_tdg_is_recording(task->tdg->tdg_status))
+    successors = __kmp_depnode_exchange_successors(node, NULL);
+  else
 #endif
-    node->dn.task =
-        NULL; // mark this task as finished, so no new dependencies are generated
-  KMP_RELEASE_DEPNODE(gtid, node);
+  {
+    successors = __kmp_depnode_exchange_successors(node, KMP_DEPNODE_CLOSED);
+    node->dn.task = NULL;
+  }
 
   kmp_depnode_list_t *next;
   kmp_taskdata_t *next_taskdata;
-  for (kmp_depnode_list_t *p = node->dn.successors; p; p = next) {
+  for (kmp_depnode_list_t *p = successors; p; p = next) {
     kmp_depnode_t *successor = p->node;
 #if USE_ITT_BUILD && USE_ITT_NOTIFY
     __itt_sync_releasing(successor);
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "kmp.h"
+#include "kmp_affinity.h"
 #include "kmp_i18n.h"
 #include "kmp_itt.h"
 #include "kmp_stats.h"
@@ -1764,6 +1765,9 @@ __kmp_invoke_task(kmp_int32 gtid, kmp_task_t *task,
     return;
   }
 
+  if (UNLIKELY(__kmp_region_stats))
+    __kmp_threads[gtid]->th.th_region_tasks++;
+
 #if OMPT_SUPPORT
   // For untied tasks, the first task executed only calls __kmpc_omp_task and
   // does not execute code.
@@ -2000,6 +2004,56 @@ kmp_int32 __kmpc_omp_task_parts(ident_t *loc_ref, kmp_int32 gtid,
   return TASK_CURRENT_NOT_QUEUED;
 }
 
+#if OMPX_TASKGRAPH
+// __kmp_tdg_record_task: add a task to the nodes of the TDG being recorded
+// tdg: the TDG being recorded
+// new_task: the task, which the TDG's record_map is extended for if needed
+void __kmp_tdg_record_task(kmp_tdg_info_t *tdg, kmp_task_t *new_task) {
+  kmp_taskdata_t *new_taskdata = KMP_TASK_TO_TASKDATA(new_task);
+  kmp_int32 id = new_taskdata->td_tdg_task_id;
+  if (id >= tdg->map_size) {
+    __kmp_acquire_bootstrap_lock(&tdg->graph_lock);
+    // map_size could have been updated by another thread if recursive
+    // taskloop
+    if (id >= tdg->map_size) {
+      kmp_uint old_size = tdg->map_size;
+      kmp_uint new_size = old_size * 2;
+      while (id >= (kmp_int32)new_size)
+        new_size *= 2;
+      kmp_node_info_t *old_record = tdg->record_map;
+      kmp_node_info_t *new_record = (kmp_node_info_t *)__kmp_allocate(
+          new_size * sizeof(kmp_node_info_t));
+
+      KMP_MEMCPY(new_record, old_record, old_size * sizeof(kmp_node_info_t));
+      tdg->record_map = new_record;
+
+      __kmp_free(old_record);
+
+      for (kmp_int i = old_size; i < new_size; i++) {
+        kmp_int32 *successorsList = (kmp_int32 *)__kmp_allocate(
+            __kmp_successors_size * sizeof(kmp_int32));
+        new_record[i].task = nullptr;
+        new_record[i].successors = successorsList;
+        new_record[i].nsuccessors = 0;
+        new_record[i].npredecessors = 0;
+        new_record[i].successors_size = __kmp_successors_size;
+        KMP_ATOMIC_ST_REL(&new_record[i].npredecessors_counter, 0);
+      }
+      // update the size at the end, so that we avoid other
+      // threads use old_record while map_size is already updated
+      tdg->map_size = new_size;
+    }
+    __kmp_release_bootstrap_lock(&tdg->graph_lock);
+  }
+  // record a task
+  if (tdg->record_map[id].task == nullptr) {
+    tdg->record_map[id].task = new_task;
+    tdg->record_map[id].parent_task = new_taskdata->td_parent;
+    KMP_ATOMIC_INC(&tdg->num_tasks);
+  }
+}
+#endif
+
 // __kmp_omp_task: Schedule a non-thread-switchable task for execution
 //
 // gtid: Global Thread ID of encountering thread
@@ -2017,49 +2071,8 @@ kmp_int32 __kmp_omp_task(kmp_int32 gtid, kmp_task_t *new_task,
 
 #if OMPX_TASKGRAPH
   if (new_taskdata->is_taskgraph &&
-      __kmp_tdg_is_recording(new_taskdata->tdg->tdg_status)) {
-    kmp_tdg_info_t *tdg = new_taskdata->tdg;
-    // extend the record_map if needed
-    if (new_taskdata->td_tdg_task_id >= new_taskdata->tdg->map_size) {
-      __kmp_acquire_bootstrap_lock(&tdg->graph_lock);
-      // map_size could have been updated by another thread if recursive
-      // taskloop
-      if (new_taskdata->td_tdg_task_id >= tdg->map_size) {
-        kmp_uint old_size = tdg->map_size;
-        kmp_uint new_size = old_size * 2;
-        kmp_node_info_t *old_record = tdg->record_map;
-        kmp_node_info_t *new_record = (kmp_node_info_t *)__kmp_allocate(
-            new_size * sizeof(kmp_node_info_t));
-
-        KMP_MEMCPY(new_record, old_record, old_size * sizeof(kmp_node_info_t));
-        tdg->record_map = new_record;
-
-        __kmp_free(old_record);
-
-        for (kmp_int i = old_size; i < new_size; i++) {
-          kmp_int32 *successorsList = (kmp_int32 *)__kmp_allocate(
-              __kmp_successors_size * sizeof(kmp_int32));
-          new_record[i].task = nullptr;
-          new_record[i].successors = successorsList;
-          new_record[i].nsuccessors = 0;
-          new_record[i].npredecessors = 0;
-          new_record[i].successors_size = __kmp_successors_size;
-          KMP_ATOMIC_ST_REL(&new_record[i].npredecessors_counter, 0);
-        }
-        // update the size at the end, so that we avoid other
-        // threads use old_record while map_size is already updated
-        tdg->map_size = new_size;
-      }
-      __kmp_release_bootstrap_lock(&tdg->graph_lock);
-    }
-    // record a task
-    if (tdg->record_map[new_taskdata->td_tdg_task_id].task == nullptr) {
-      tdg->record_map[new_taskdata->td_tdg_task_id].task = new_task;
-      tdg->record_map[new_taskdata->td_tdg_task_id].parent_task =
-          new_taskdata->td_parent;
-      KMP_ATOMIC_INC(&tdg->num_tasks);
-    }
-  }
+      __kmp_tdg_is_recording(new_taskdata->tdg->tdg_status))
+    __kmp_tdg_record_task(new_taskdata->tdg, new_task);
 #endif
 
   /* Should we execute the new task or queue it? For now, let's just always try
@@ -3344,6 +3357,63 @@ static kmp_task_t *__kmp_steal_task(kmp_int32 victim_tid, kmp_int32 gtid,
   return task;
 }
 
+#if KMP_AFFINITY_SUPPORTED
+// __kmp_steal_distance: The number of levels of the machine topology to go up
+// from the hardware threads to reach a unit holding both threads: 1 for the
+// hardware threads of a core, the depth of the topology for threads without a
+// common unit or whose placement is not known.
+static int __kmp_steal_distance(kmp_info_t *thief, kmp_info_t *victim) {
+  int depth = __kmp_topology->get_depth();
+  for (int level = 0; level < depth; ++level) {
+    kmp_hw_t type = __kmp_topology->get_type(level);
+    int id = thief->th.th_topology_ids.ids[type];
+    if (id < 0 || id != victim->th.th_topology_ids.ids[type])
+      return depth - level;
+  }
+  return 0;
+}
+#endif // KMP_AFFINITY_SUPPORTED
+
+// __kmp_get_steal_victim: Pick a random teammate of thread tid to steal tasks
+// from. With KMP_TASK_STEALING_LOCALITY, and threads bound to places, it is
+// picked among the closest teammates in the machine topology: the same core,
+// then the same cache, NUMA node or socket, going one level further away from
+// the thread after each failed steal, so that remote memory is only touched
+// once there is no work nearby.
+static kmp_int32 __kmp_get_steal_victim(kmp_info_t *thread,
+                                        kmp_thread_data_t *threads_data,
+                                        kmp_int32 tid, kmp_int32 nthreads) {
+  // Pick a random thread. Initial plan was to cycle through all the threads,
+  // and only return if we tried to steal from every thread, and failed.  Arch
+  // says that's not such a great idea.
+  kmp_int32 victim_tid = __kmp_get_random(thread) % (nthreads - 1);
+  if (victim_tid >= tid) {
+    ++victim_tid; // Adjusts random distribution to exclude self
+  }
+#if KMP_AFFINITY_SUPPORTED
+  if (!__kmp_task_stealing_locality || !KMP_AFFINITY_CAPABLE() ||
+      __kmp_topology == NULL)
+    return victim_tid;
+  int depth = __kmp_topology->get_depth();
+  // A thread spanning several sockets has no close teammates.
+  if (depth <= 1 ||
+      thread->th.th_topology_ids.ids[__kmp_topology->get_type(0)] < 0)
+    return victim_tid;
+  // Scan the team from the random thread for the first one close enough.
+  int level = 1 + (int)(threads_data[tid].td.td_failed_steals % depth);
+  for (; level < depth; ++level) {
+    for (kmp_int32 i = 0; i < nthreads; ++i) {
+      kmp_int32 candidate = (victim_tid + i) % nthreads;
+      if (candidate != tid &&
+          __kmp_steal_distance(thread, threads_data[candidate].td.td_thr) <=
+              level)
+        return candidate;
+    }
+  }
+#endif // KMP_AFFINITY_SUPPORTED
+  return victim_tid;
+}
+
 // __kmp_execute_tasks_template: Choose and execute tasks until either the
 // condition is statisfied (return true) or there are none left (return false).
 //
@@ -3411,13 +3481,8 @@ static inline int __kmp_execute_tasks_template(
         } else if (!new_victim) { // no recent steals and we haven't already
           // used a new victim; select a random thread
           do { // Find a different thread to steal work from.
-            // Pick a random thread. Initial plan was to cycle through all the
-            // threads, and only return if we tried to steal from every thread,
-            // and failed.  Arch says that's not such a great idea.
-            victim_tid = __kmp_get_random(thread) % (nthreads - 1);
-            if (victim_tid >= tid) {
-              ++victim_tid; // Adjusts random distribution to exclude self
-            }
+            victim_tid =
+                __kmp_get_steal_victim(thread, threads_data, tid, nthreads);
             // Found a potential victim
             other_thread = threads_data[victim_tid].td.td_thr;
             // There is a slight chance that __kmp_enable_tasking() did not wake
@@ -3434,6 +3499,8 @@ static inline int __kmp_execute_tasks_template(
                 (TCR_PTR(CCAST(void *, other_thread->th.th_sleep_loc)) !=
                  NULL)) {
               asleep = 1;
+              // Look further away next time rather than waiting for this one.
+              threads_data[tid].td.td_failed_steals++;
               __kmp_null_resume_wrapper(other_thread);
               // A sleeping thread should not have any tasks on it's queue.
               // There is a slight possibility that it resumes, steals a task
@@ -3452,6 +3519,7 @@ static inline int __kmp_execute_tasks_template(
                                thread_finished, is_constrained);
         }
         if (task != NULL) { // set last stolen to victim
+          KMP_CHECK_UPDATE(threads_data[tid].td.td_failed_steals, 0);
           if (threads_data[tid].td.td_deque_last_stolen != victim_tid) {
             threads_data[tid].td.td_deque_last_stolen = victim_tid;
             // The pre-refactored code did not try more than 1 successful new
@@ -3461,6 +3529,8 @@ static inline int __kmp_execute_tasks_template(
           }
         } else { // No tasks found; unset last_stolen
           KMP_CHECK_UPDATE(threads_data[tid].td.td_deque_last_stolen, -1);
+          if (!asleep)
+            threads_data[tid].td.td_failed_steals++;
           victim_tid = -2; // no successful victim found
         }
       }
@@ -3756,6 +3826,7 @@ static void __kmp_alloc_task_deque(kmp_info_t *thread,
 
   // Initialize last stolen task field to "none"
   thread_data->td.td_deque_last_stolen = -1;
+  thread_data->td.td_failed_steals = 0;
 
   KMP_DEBUG_ASSERT(TCR_4(thread_data->td.td_deque_ntasks) == 0);
   KMP_DEBUG_ASSERT(thread_data->td.td_deque_head == 0);
@@ -5525,30 +5596,27 @@ void __kmp_exec_tdg(kmp_int32 gtid, kmp_tdg_info_t *tdg) {
     __kmpc_taskred_init(gtid, tdg->rec_num_taskred, tdg->rec_taskred_data);
   }
 
+  // All the tasks have the same parent, so its counters are updated once for
+  // the whole TDG rather than once per task.
+  kmp_taskgroup_t *parent_taskgroup = parent_task->td_taskgroup;
   for (kmp_int32 j = 0; j < this_num_tasks; j++) {
     kmp_taskdata_t *td = KMP_TASK_TO_TASKDATA(this_record_map[j].task);
 
     td->td_parent = parent_task;
     this_record_map[j].parent_task = parent_task;
 
-    kmp_taskgroup_t *parent_taskgroup =
-        this_record_map[j].parent_task->td_taskgroup;
-
     KMP_ATOMIC_ST_RLX(&this_record_map[j].npredecessors_counter,
                       this_record_map[j].npredecessors);
-    KMP_ATOMIC_INC(&this_record_map[j].parent_task->td_incomplete_child_tasks);
-
-    if (parent_taskgroup) {
-      KMP_ATOMIC_INC(&parent_taskgroup->count);
-      // The taskgroup is different so we must update it
-      td->td_taskgroup = parent_taskgroup;
-    } else if (td->td_taskgroup != nullptr) {
-      // If the parent doesnt have a taskgroup, remove it from the task
-      td->td_taskgroup = nullptr;
-    }
-    if (this_record_map[j].parent_task->td_flags.tasktype == TASK_EXPLICIT)
-      KMP_ATOMIC_INC(&this_record_map[j].parent_task->td_allocated_child_tasks);
+
+    // The taskgroup may be different, in which case we must update it; if
+    // the parent doesnt have a taskgroup, remove it from the task
+    td->td_taskgroup = parent_taskgroup;
   }
+  KMP_ATOMIC_ADD(&parent_task->td_incomplete_child_tasks, this_num_tasks);
+  if (parent_taskgroup)
+    KMP_ATOMIC_ADD(&parent_taskgroup->count, this_num_tasks);
+  if (parent_task->td_flags.tasktype == TASK_EXPLICIT)
+    KMP_ATOMIC_ADD(&parent_task->td_allocated_child_tasks, this_num_tasks);
 
   for (kmp_int32 j = 0; j < this_num_roots; ++j) {
     __kmp_omp_task(gtid, this_record_map[this_root_tasks[j]].task, true);
@@ -0,0 +1,48 @@
+// RUN: %libomp-compile
+// RUN: env KMP_ADAPTIVE_BARRIER=1 %libomp-run
+// RUN: env KMP_ADAPTIVE_BARRIER=1 KMP_PLAIN_BARRIER=0,0 %libomp-run
+// RUN: env KMP_ADAPTIVE_BARRIER=1 KMP_PLAIN_BARRIER_PATTERN=hierarchical %libomp-run
+// RUN: env KMP_ADAPTIVE_BARRIER=1 KMP_FORKJOIN_BARRIER_PATTERN=dist %libomp-run
+// Checks that barriers and reductions stay correct while the runtime switches
+// the pattern of the plain and reduction barriers of teams of various sizes,
+// including nested ones.
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+
+#define NUM_REGIONS 24
+#define NUM_BARRIERS 1000
+
+int main() {
+  omp_set_max_active_levels(2);
+  for (int r = 0; r < NUM_REGIONS; ++r) {
+    int nthreads = 1 + r % 6;
+    int nested = r % 4 == 0;
+    long sum = 0, count = 0;
+#pragma omp parallel num_threads(nthreads)
+    {
+      for (int i = 0; i < NUM_BARRIERS; ++i) {
+#pragma omp for reduction(+ : sum)
+        for (int j = 0; j < 64; ++j)
+          sum += j;
+#pragma omp barrier
+      }
+      if (nested) {
+#pragma omp parallel num_threads(2)
+        for (int i = 0; i < NUM_BARRIERS; ++i) {
+#pragma omp barrier
+#pragma omp atomic
+          count++;
+        }
+      }
+    }
+    if (sum != NUM_BARRIERS * 2016L ||
+        count != (nested ? 2L * NUM_BARRIERS * nthreads : 0)) {
+      fprintf(stderr, "error: team of %d threads, sum = %ld, count = %ld\n",
+              nthreads, sum, count);
+      return EXIT_FAILURE;
+    }
+  }
+  printf("passed\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,61 @@
+// RUN: %libomp-compile
+// RUN: env KMP_REGION_STATS=1 %libomp-run 2>&1 | FileCheck %s
+// RUN: env KMP_REGION_STATS=1 KMP_REGION_STATS_FILE=%t.json %libomp-run
+// RUN: FileCheck %s < %t.json
+// RUN: env KMP_REGION_STATS=1 %libomp-run signal 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=SIGNAL
+// REQUIRES: linux
+
+// Checks the statistics the runtime aggregates for each parallel region. With
+// an argument, the statistics are also dumped by the last region, which joins
+// after a signal.
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+
+#define NUM_CALLS 10
+#define NUM_TASKS 100
+
+int main(int argc, char **argv) {
+  if (argc > 1) {
+    char signum[16];
+    snprintf(signum, sizeof(signum), "%d", SIGUSR1);
+    setenv("KMP_REGION_STATS_SIGNAL", signum, 1);
+  }
+
+  for (int i = 0; i < NUM_CALLS; ++i) {
+#pragma omp parallel num_threads(4)
+    {
+#pragma omp barrier
+    }
+  }
+
+#pragma omp parallel num_threads(4)
+#pragma omp single
+  for (int i = 0; i < NUM_TASKS; ++i) {
+#pragma omp task
+    {
+    }
+  }
+
+  if (argc > 1) {
+    raise(SIGUSR1);
+#pragma omp parallel num_threads(2)
+    {
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+// CHECK: "dropped_calls": 0,
+// CHECK-DAG: "calls": 10, "threads": 40, {{.*}}, "tasks": 0}
+// CHECK-DAG: "calls": 1, "threads": 4, {{.*}}, "tasks": 100}
+// CHECK: ]
+
+// SIGNAL: "regions": [
+// SIGNAL: "threads": 2,
+// SIGNAL: ]
+// SIGNAL: "regions": [
+// SIGNAL: "threads": 2,
+// SIGNAL: ]
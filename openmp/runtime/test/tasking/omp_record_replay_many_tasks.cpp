@@ -0,0 +1,65 @@
+// REQUIRES: ompx_taskgraph
+// RUN: %libomp-cxx-compile-and-run
+#include <iostream>
+#include <cassert>
+#define NT 20
+#define NTASKS 200
+#define WIDTH 8
+
+// Checks a TDG with more tasks than initially allocated nodes and a task with
+// more successors than initially allocated successor ids.
+int runs, errors;
+int data[NTASKS];
+// Compiler-generated code (emulation)
+typedef struct ident {
+    void* dummy;
+} ident_t;
+
+
+#ifdef __cplusplus
+extern "C" {
+  int __kmpc_global_thread_num(ident_t *);
+  int __kmpc_start_record_task(ident_t *, int, int, int);
+  void __kmpc_end_record_task(ident_t *, int, int, int);
+}
+#endif
+
+void start() {
+  // no atomicity needed, all the other tasks depend on this one
+  runs++;
+}
+
+void check(int i) {
+  if (data[i] + 1 != runs) {
+    #pragma omp atomic
+    errors++;
+  }
+  data[i]++;
+}
+
+int main() {
+  int x, y[WIDTH];
+  #pragma omp parallel
+  #pragma omp single
+  for (int iter = 0; iter < NT; ++iter) {
+    int gtid = __kmpc_global_thread_num(nullptr);
+    int res =  __kmpc_start_record_task(nullptr, gtid, /* kmp_tdg_flags */0, /* tdg_id */0);
+    if (res) {
+      #pragma omp task depend(out:x)
+      start();
+      for (int i = 0; i < NTASKS; ++i) {
+        #pragma omp task depend(in:x) depend(inout:y[i % WIDTH])
+        check(i);
+      }
+    }
+    __kmpc_end_record_task(nullptr, gtid, /* kmp_tdg_flags */0, /* tdg_id */0);
+  }
+  assert(runs == NT);
+  assert(errors == 0);
+  for (int i = 0; i < NTASKS; ++i)
+    assert(data[i] == NT);
+
+  std::cout << "Passed" << std::endl;
+  return 0;
+}
+// CHECK: Passed
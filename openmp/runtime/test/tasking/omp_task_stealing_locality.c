@@ -0,0 +1,42 @@
+// RUN: %libomp-compile
+// RUN: env KMP_TASK_STEALING_LOCALITY=0 %libomp-run
+// RUN: env KMP_TASK_STEALING_LOCALITY=1 %libomp-run
+// RUN: env KMP_TASK_STEALING_LOCALITY=1 OMP_PLACES=threads OMP_PROC_BIND=close %libomp-run
+// RUN: env KMP_TASK_STEALING_LOCALITY=1 OMP_PLACES=cores OMP_PROC_BIND=spread %libomp-run
+
+#include <omp.h>
+#include <stdio.h>
+
+/**
+ * Check that all the tasks of a recursive computation run once, whichever
+ * teammates the idle threads steal them from.
+ */
+
+static long fib(int n) {
+  long x, y;
+  if (n < 2)
+    return n;
+  if (n < 12)
+    return fib(n - 1) + fib(n - 2);
+#pragma omp task shared(x)
+  x = fib(n - 1);
+#pragma omp task shared(y)
+  y = fib(n - 2);
+#pragma omp taskwait
+  return x + y;
+}
+
+int main() {
+  int i;
+  for (i = 0; i < 10; i++) {
+    long result = 0;
+#pragma omp parallel
+#pragma omp single
+    result = fib(27);
+    if (result != 196418) {
+      printf("fib(27) = %ld instead of 196418\n", result);
+      return 1;
+    }
+  }
+  return 0;
+}
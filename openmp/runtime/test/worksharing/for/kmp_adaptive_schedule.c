@@ -0,0 +1,57 @@
+// RUN: %libomp-compile
+// RUN: env KMP_ADAPTIVE_SCHEDULE=1 %libomp-run
+// RUN: env KMP_ADAPTIVE_SCHEDULE=1 OMP_SCHEDULE=auto %libomp-run
+// RUN: env KMP_ADAPTIVE_SCHEDULE=1 OMP_SCHEDULE=auto KMP_DISP_NUM_BUFFERS=2 \
+// RUN:   %libomp-run
+// Checks that every iteration of schedule(auto) loops runs once while the
+// runtime tries and picks schedules for them, for teams of various sizes and
+// loops of various types that do not wait for each other.
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+
+#define N 2000
+#define NUM_CALLS 1200
+
+int hits[N];
+long long hits64[N];
+
+int main() {
+  long long sum = 0;
+  for (int call = 0; call < NUM_CALLS; ++call) {
+    int nthreads = 1 + call / 100 % 4;
+#pragma omp parallel num_threads(nthreads) reduction(+ : sum)
+    {
+#pragma omp for schedule(auto) nowait
+      for (int i = 0; i < N; ++i) {
+        // Imbalanced iterations
+        for (volatile int j = 0; j < i % 64; ++j)
+          ;
+        hits[i]++;
+      }
+#pragma omp for schedule(runtime) nowait
+      for (long long i = N - 1; i >= 0; i -= 3) {
+#pragma omp atomic
+        hits64[i]++;
+      }
+#pragma omp for schedule(auto)
+      for (unsigned i = 0; i < N; i += 2)
+        sum += i;
+    }
+  }
+
+  for (int i = 0; i < N; ++i) {
+    if (hits[i] != NUM_CALLS ||
+        hits64[i] != ((N - 1 - i) % 3 == 0 ? NUM_CALLS : 0)) {
+      fprintf(stderr, "error: iteration %d ran %d and %lld times\n", i,
+              hits[i], hits64[i]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (sum != (long long)NUM_CALLS * (N / 2) * (N - 2) / 2) {
+    fprintf(stderr, "error: sum = %lld\n", sum);
+    return EXIT_FAILURE;
+  }
+  printf("passed\n");
+  return EXIT_SUCCESS;
+}
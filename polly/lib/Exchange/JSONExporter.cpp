@@ -27,6 +27,7 @@
 #include "llvm/Support/raw_ostream.h"
 #include "isl/map.h"
 #include "isl/set.h"
+#include "isl/union_map.h"
 #include <memory>
 #include <string>
 #include <system_error>
@@ -324,15 +325,16 @@ static bool importSchedule(Scop &S, const json::Object &JScop,
     return false;
   }
 
-  auto ScheduleMap = isl::union_map::empty(S.getIslCtx());
+  // Add the statement schedules to a union map we hold the only reference to.
+  // Uniting them one by one would copy the union map for every statement.
+  isl_union_map *ScheduleMap = isl::union_map::empty(S.getIslCtx()).release();
   for (ScopStmt &Stmt : S) {
-    if (NewSchedule.contains(&Stmt))
-      ScheduleMap = ScheduleMap.unite(NewSchedule[&Stmt]);
-    else
-      ScheduleMap = ScheduleMap.unite(Stmt.getSchedule());
+    isl::map StmtSchedule = NewSchedule.contains(&Stmt) ? NewSchedule[&Stmt]
+                                                        : Stmt.getSchedule();
+    ScheduleMap = isl_union_map_add_map(ScheduleMap, StmtSchedule.release());
   }
 
-  S.setSchedule(ScheduleMap);
+  S.setSchedule(isl::manage(ScheduleMap));
 
   return true;
 }